@@ -377,13 +377,14 @@ namespace Anabatic {
     , _rpCount   (0)
     , _diodeCount(0)
     , _sparsity  (0)
+    , _expandeds (0)
     , _flags     ()
     , _noMoveUp  ()
   {
     if (_state and _state->isMixedPreRoute()) return;
 
     Cell* diodeCell = anabatic->getDiodeCell();
-    for ( RoutingPad* rp : _net->getRoutingPads() ) {
+    for ( RoutingPad* rp : _net->getRoutingPadRange() ) {
       _searchArea.merge( rp->getBoundingBox() );
       ++_rpCount;
 
@@ -427,7 +428,7 @@ namespace Anabatic {
     , _netDatas         ()
     , _viewer           (NULL)
     , _flags            (Flags::DestroyBaseContact)
-    , _stamp            (-1)
+    , _vertexStates     ()
     , _routingMode      (DigitalMode)
     , _densityMode      (MaxDensity)
     , _autoSegmentLut   ()
@@ -487,6 +488,14 @@ namespace Anabatic {
   {
     delete _configuration;
     for ( pair<unsigned int,NetData*> data : _netDatas ) delete data.second;
+    for ( VertexStates* states : _vertexStates ) delete states;
+  }
+
+
+  VertexStates* AnabaticEngine::getVertexStates ( size_t slot )
+  {
+    while ( _vertexStates.size() <= slot ) _vertexStates.push_back( new VertexStates() );
+    return _vertexStates[slot];
   }
 
 
@@ -561,6 +570,8 @@ namespace Anabatic {
 
       _destroyAutoSegments();
       _destroyAutoContacts();
+      AutoSegment::releaseArenas();
+      AutoContact::releaseArenas();
 
       _flags |= Flags::DestroyGCell;
 
@@ -682,8 +693,8 @@ namespace Anabatic {
     ostringstream errors;
     errors << "AnabaticEngine::checkPlacement():\n";
 
-    for ( Net* net: getCell()->getNets() ) {
-      for ( RoutingPad* rp : net->getRoutingPads() ) {
+    for ( Net* net: getCell()->getNetRange() ) {
+      for ( RoutingPad* rp : net->getRoutingPadRange() ) {
         Pin* pin = dynamic_cast<Pin*>( rp->getOccurrence().getEntity() );
         if (not pin) continue;
 
@@ -1464,11 +1475,13 @@ namespace Anabatic {
     stopMeasures();
 
     cmess2 << Dots::asSizet("     - Short nets",shortNets) << endl;
+    cmess2 << Dots::asSizet("     - Arenas (Kb)",(AutoSegment::getArenaReserved() + AutoContact::getArenaReserved()) >> 10) << endl;
     
     printMeasures( "load" );
 
     addMeasure<size_t>( "Globals", AutoSegment::getGlobalsCount() );
     addMeasure<size_t>( "Edges"  , AutoSegment::getAllocateds() );
+    addMeasure<size_t>( "ArenaS" , (AutoSegment::getArenaPeak() + AutoContact::getArenaPeak()) >> 20 );
   }
 
 
@@ -153,6 +153,34 @@ namespace Anabatic {
   { return _allocateds; }
 
 
+  size_t  AutoContact::getArenaReserved ()
+  {
+    return AutoContactTerminal::_arena.getReserved()
+         + AutoContactTurn    ::_arena.getReserved()
+         + AutoContactHTee    ::_arena.getReserved()
+         + AutoContactVTee    ::_arena.getReserved();
+  }
+
+
+  size_t  AutoContact::getArenaPeak ()
+  {
+    return AutoContactTerminal::_arena.getPeak()
+         + AutoContactTurn    ::_arena.getPeak()
+         + AutoContactHTee    ::_arena.getPeak()
+         + AutoContactVTee    ::_arena.getPeak();
+  }
+
+
+  bool  AutoContact::releaseArenas ()
+  {
+    bool released = AutoContactTerminal::_arena.clear();
+    released = AutoContactTurn::_arena.clear() and released;
+    released = AutoContactHTee::_arena.clear() and released;
+    released = AutoContactVTee::_arena.clear() and released;
+    return released;
+  }
+
+
   const Name& AutoContact::getStaticName ()
   { return _goName; }
 
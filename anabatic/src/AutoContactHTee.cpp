@@ -47,6 +47,17 @@ namespace Anabatic {
 // Class  :  "Anabatic::AutoContactHTee".
 
 
+  SlabPool<AutoContactHTee>  AutoContactHTee::_arena;
+
+
+  void* AutoContactHTee::operator new ( size_t size )
+  { return _arena.allocate( size ); }
+
+
+  void  AutoContactHTee::operator delete ( void* storage, size_t size )
+  { _arena.release( storage, size ); }
+
+
   AutoContactHTee* AutoContactHTee::create ( GCell* gcell, Net* net, const Layer* layer )
   {
     _preCreate( gcell, net, layer );
@@ -55,6 +55,17 @@ namespace Anabatic {
 // Class  :  "Anabatic::AutoContactTerminal".
 
 
+  SlabPool<AutoContactTerminal>  AutoContactTerminal::_arena;
+
+
+  void* AutoContactTerminal::operator new ( size_t size )
+  { return _arena.allocate( size ); }
+
+
+  void  AutoContactTerminal::operator delete ( void* storage, size_t size )
+  { _arena.release( storage, size ); }
+
+
   AutoContactTerminal* AutoContactTerminal::create ( GCell*       gcell
                                                    , Component*   anchor
                                                    , const Layer* layer
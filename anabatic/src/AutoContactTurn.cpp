@@ -47,6 +47,17 @@ namespace Anabatic {
 // Class  :  "Anabatic::AutoContactTurn".
 
 
+  SlabPool<AutoContactTurn>  AutoContactTurn::_arena;
+
+
+  void* AutoContactTurn::operator new ( size_t size )
+  { return _arena.allocate( size ); }
+
+
+  void  AutoContactTurn::operator delete ( void* storage, size_t size )
+  { _arena.release( storage, size ); }
+
+
   AutoContactTurn* AutoContactTurn::create ( GCell* gcell, Net* net, const Layer* layer )
   {
     _preCreate( gcell, net, layer );
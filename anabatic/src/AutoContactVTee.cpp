@@ -47,6 +47,17 @@ namespace Anabatic {
 // Class  :  "Anabatic::AutoContactVTee".
 
 
+  SlabPool<AutoContactVTee>  AutoContactVTee::_arena;
+
+
+  void* AutoContactVTee::operator new ( size_t size )
+  { return _arena.allocate( size ); }
+
+
+  void  AutoContactVTee::operator delete ( void* storage, size_t size )
+  { _arena.release( storage, size ); }
+
+
   AutoContactVTee* AutoContactVTee::create ( GCell* gcell, Net* net, const Layer* layer )
   {
     _preCreate( gcell, net, layer );
@@ -47,6 +47,17 @@ namespace Anabatic {
 // Class  :  "Anabatic::AutoHorizontal".
 
 
+  SlabPool<AutoHorizontal>  AutoHorizontal::_arena;
+
+
+  void* AutoHorizontal::operator new ( size_t size )
+  { return _arena.allocate( size ); }
+
+
+  void  AutoHorizontal::operator delete ( void* storage, size_t size )
+  { _arena.release( storage, size ); }
+
+
   Segment*    AutoHorizontal::base          ()       { return _horizontal; }
   Segment*    AutoHorizontal::base          () const { return _horizontal; }
   Horizontal* AutoHorizontal::getHorizontal ()       { return _horizontal; }
@@ -447,6 +447,22 @@ namespace Anabatic {
   vector< array<DbU::Unit*,4> >  AutoSegment::_extensionCaps;
 
 
+  size_t  AutoSegment::getArenaReserved ()
+  { return AutoHorizontal::_arena.getReserved() + AutoVertical::_arena.getReserved(); }
+
+
+  size_t  AutoSegment::getArenaPeak ()
+  { return AutoHorizontal::_arena.getPeak() + AutoVertical::_arena.getPeak(); }
+
+
+  bool  AutoSegment::releaseArenas ()
+  {
+    bool released = AutoHorizontal::_arena.clear();
+    released = AutoVertical::_arena.clear() and released;
+    return released;
+  }
+
+
   void  AutoSegment::setAnalogMode   ( bool state ) { _analogMode = state; }
   bool  AutoSegment::getAnalogMode   () { return _analogMode; }
   void  AutoSegment::setShortNetMode ( bool state ) { _shortNetMode = state; }
@@ -41,6 +41,17 @@ namespace Anabatic {
 // Class  :  "Anabatic::AutoVertical".
 
 
+  SlabPool<AutoVertical>  AutoVertical::_arena;
+
+
+  void* AutoVertical::operator new ( size_t size )
+  { return _arena.allocate( size ); }
+
+
+  void  AutoVertical::operator delete ( void* storage, size_t size )
+  { _arena.release( storage, size ); }
+
+
   Segment*   AutoVertical::base         ()       { return _vertical; }
   Segment*   AutoVertical::base         () const { return _vertical; }
   Vertical*  AutoVertical::getVertical  ()       { return _vertical; }
@@ -16,6 +16,8 @@
 
 #include <limits>
 #include <algorithm>
+#include <cstdlib>
+#include <fstream>
 #include "hurricane/Error.h"
 #include "hurricane/Warning.h"
 #include "hurricane/Net.h"
@@ -201,6 +203,13 @@ namespace Anabatic {
     _from2 = NULL;
   }
 
+// -------------------------------------------------------------------
+// Class  :  "Anabatic::VertexStates".
+
+
+  thread_local VertexStates* VertexStates::_bound = NULL;
+
+
 // -------------------------------------------------------------------
 // Class  :  "Anabatic::Vertex".
 
@@ -209,14 +218,8 @@ namespace Anabatic {
   DbU::Unit  Vertex::unreachable  = std::numeric_limits<long>::max()-1;
 
 
-  bool  Vertex::hasValidStamp () const
-  { return _stamp == getAnabatic()->getStamp(); }
-
-  Edge* Vertex::getFrom() const 
-  {
-    if (hasValidStamp()) return _from;
-    else                 return NULL;
-  }
+  VertexStates* Vertex::_getDefaultStates () const
+  { return _gcell->getAnabatic()->getVertexStates( 0 ); }
 
 
   void Vertex::setRestricted () 
@@ -903,11 +906,11 @@ namespace Anabatic {
   {
     if (_adata)  return _adata->getIAxis();
     else {
-      if (_from){
+      if (getStates()->getFrom(_index)){
       //cdebug_log(112,0) << "DbU::Unit Vertex::getIAxis() const: Digital vertex. " <<  endl;
       
         GCell*  gcurr = getGCell();
-        GCell*  gprev = _from->getOpposite(gcurr);
+        GCell*  gprev = getStates()->getFrom(_index)->getOpposite(gcurr);
         Vertex* vprev = gprev->getObserver<Vertex>(GCell::Observable::Vertex);
         if      (isNorth(vprev)||isSouth(vprev)) 
           return calcMidIntersection(gcurr->getXMin(), gcurr->getXMax(), gprev->getXMin(), gprev->getXMax());
@@ -930,10 +933,10 @@ namespace Anabatic {
     if (_adata){
       return _adata->getIMax();
     } else {
-      if (_from){
+      if (getStates()->getFrom(_index)){
       //cdebug_log(112,0) << "DbU::Unit Vertex::getIMax() const: Digital vertex. " <<  endl;
         GCell*  gcurr = getGCell();
-        GCell*  gprev = _from->getOpposite(gcurr);
+        GCell*  gprev = getStates()->getFrom(_index)->getOpposite(gcurr);
         Vertex* vprev = gprev->getObserver<Vertex>(GCell::Observable::Vertex);
         if (isH()){
           if      (isNorth(vprev)||isSouth(vprev)||isWest (vprev)) return getGCell()->getXCenter();
@@ -964,9 +967,9 @@ namespace Anabatic {
     if (_adata){
       return _adata->getIMin();
     } else {
-      if (_from) {
+      if (getStates()->getFrom(_index)) {
         GCell*  gcurr = getGCell();
-        GCell*  gprev = _from->getOpposite(gcurr);
+        GCell*  gprev = getStates()->getFrom(_index)->getOpposite(gcurr);
         Vertex* vprev = gprev->getObserver<Vertex>( GCell::Observable::Vertex );
         if (isH()){
           if      (isNorth(vprev) or isSouth(vprev) or isEast (vprev)) return getGCell()->getXCenter();
@@ -997,9 +1000,9 @@ namespace Anabatic {
       return _adata->getPIAxis();
     } else {
     //cdebug_log(112,0) << "DbU::Unit Vertex::getPIAxis() const: Digital vertex. " <<  endl;
-      if (_from){
+      if (getStates()->getFrom(_index)){
         GCell*  gcurr = getGCell();
-        GCell*  gprev = _from->getOpposite(gcurr);
+        GCell*  gprev = getStates()->getFrom(_index)->getOpposite(gcurr);
         Vertex* vprev = gprev->getObserver<Vertex>(GCell::Observable::Vertex);
 
         if (vprev->isH()){
@@ -1033,9 +1036,9 @@ namespace Anabatic {
       return _adata->getPIMax();
     } else {
     //cdebug_log(112,0) << "DbU::Unit Vertex::getPIMax() const: Digital vertex. " <<  endl;
-      if (_from){
+      if (getStates()->getFrom(_index)){
         GCell*  gcurr = getGCell();
-        GCell*  gprev = _from->getOpposite(gcurr);
+        GCell*  gprev = getStates()->getFrom(_index)->getOpposite(gcurr);
         Vertex* vprev = gprev->getObserver<Vertex>(GCell::Observable::Vertex);
         
         if (vprev->isH()){
@@ -1067,9 +1070,9 @@ namespace Anabatic {
       return _adata->getPIMin();
     } else {
     //cdebug_log(112,0) << "DbU::Unit Vertex::getPIMin() const: Digital vertex. " <<  endl;
-      if (_from){
+      if (getStates()->getFrom(_index)){
         GCell*  gcurr = getGCell();
-        GCell*  gprev = _from->getOpposite(gcurr);
+        GCell*  gprev = getStates()->getFrom(_index)->getOpposite(gcurr);
         Vertex* vprev = gprev->getObserver<Vertex>(GCell::Observable::Vertex);
         
         if (vprev->isH()){
@@ -1254,7 +1257,7 @@ namespace Anabatic {
             return _adata->getFrom2()->getOpposite(getGCell());
           } else {
             cdebug_log(112,0) << "getGPrev:From2Mode:UseFrom1. " <<  endl;
-            if (_from) return getFrom()->getOpposite(getGCell());
+            if (getStates()->getFrom(_index)) return getFrom()->getOpposite(getGCell());
             else       return NULL;
           }
         case Vertex::UseFromFrom2:
@@ -1263,20 +1266,20 @@ namespace Anabatic {
             return _adata->getFrom2()->getOpposite(getGCell());
           } else {
             cdebug_log(112,0) << "getGPrev:UseFromFrom2:UseFrom1. " <<  endl;
-            if (_from) return getFrom()->getOpposite(getGCell());
+            if (getStates()->getFrom(_index)) return getFrom()->getOpposite(getGCell());
             else       return NULL;
           }
         case 0:
           cdebug_log(112,0) << "getGPrev:Default:UseFrom1. " <<  endl;
-          if (_from) return getFrom()->getOpposite(getGCell());
+          if (getStates()->getFrom(_index)) return getFrom()->getOpposite(getGCell());
           else       return NULL;
         default:
           cdebug_log(112,0) << "getGPrev:Default:UseFrom1. " <<  endl;
-          if (_from) return getFrom()->getOpposite(getGCell());
+          if (getStates()->getFrom(_index)) return getFrom()->getOpposite(getGCell());
           else       return NULL;
       }
     } else {
-      if (_from) return getFrom()->getOpposite(getGCell());
+      if (getStates()->getFrom(_index)) return getFrom()->getOpposite(getGCell());
       else       return NULL;
     }
   }
@@ -1325,14 +1328,14 @@ namespace Anabatic {
              +  " " + DbU::getValueString(_gcell->getXMax())
              +  " " + DbU::getValueString(_gcell->getYMax()) + "]"
            //+ " rps:" +  getString(_rpCount)
-             + " deg:" +  getString(_degree)
-             + " connexId:" + ((_connexId >= 0) ? getString(_connexId) : "None")
-             + " d:" + ((_distance == unreached) ? "unreached"
-                                                 : ((_distance == unreachable) ? "unreachable"
-                                                                               : DbU::getValueString(_distance)) )
+             + " deg:" +  getString(getStates()->getDegree(_index))
+             + " connexId:" + ((getStates()->getConnexId(_index) >= 0) ? getString(getStates()->getConnexId(_index)) : "None")
+             + " d:" + ((getStates()->getDistance(_index) == unreached) ? "unreached"
+                                                 : ((getStates()->getDistance(_index) == unreachable) ? "unreachable"
+                                                                               : DbU::getValueString(getStates()->getDistance(_index))) )
            //+   "+" + getString(_branchId)
            //+ " stamp:" + (hasValidStamp() ? "valid" : "outdated")
-             + " from:" + ((_from) ? "set" : "NULL")
+             + " from:" + ((getStates()->getFrom(_index)) ? "set" : "NULL")
            //+ " from2:" + ((_adata) ? _adata->getFrom2() : "NULL")
              + " restricted:"
              + (isNRestricted() ? "N" : "-")
@@ -1381,12 +1384,9 @@ namespace Anabatic {
 // Class  :  "Anabatic::PrioriryQueue::CompareByDistance".
 
   
-  PriorityQueue* PriorityQueue::CompareByDistance::_pqueue = NULL;
-
-
   bool PriorityQueue::CompareByDistance::operator() ( const Vertex* lhs, const Vertex* rhs ) const
   {
-    if (lhs->getDistance() == rhs->getDistance()) {
+    if (lhs->getKey() == rhs->getKey()) {
       if (_pqueue and _pqueue->hasAttractor()) {
         DbU::Unit lhsDistance = _pqueue->getAttractor().manhattanDistance( lhs->getCenter() );
         DbU::Unit rhsDistance = _pqueue->getAttractor().manhattanDistance( rhs->getCenter() );
@@ -1398,7 +1398,51 @@ namespace Anabatic {
       }
       return lhs->getBranchId() > rhs->getBranchId();
     }
-    return lhs->getDistance() < rhs->getDistance();
+    return lhs->getKey() < rhs->getKey();
+  }
+
+
+// -------------------------------------------------------------------
+// Class  :  "Anabatic::PriorityHeap".
+
+
+  PriorityHeap::~PriorityHeap ()
+  {
+    if (_traceStream) delete _traceStream;
+  }
+
+
+  void  PriorityHeap::openTrace ( const std::string& path )
+  {
+    if (_traceStream) delete _traceStream;
+    _traceStream = new std::ofstream ( path, std::ios::out|std::ios::app );
+    if (not (*_traceStream)) {
+      cerr << Warning( "PriorityHeap::openTrace(): Unable to open queue trace file \"%s\"."
+                     , path.c_str() ) << endl;
+      delete _traceStream;
+      _traceStream = NULL;
+    }
+  }
+
+
+  void  PriorityHeap::_trace ( char op, uint32_t i ) const
+  {
+  // One operation per line, keys are recorded on push/decrease so the
+  // trace can be replayed without the database (see benchs/).
+  //   p|d <id> <key> <attractorDistance|-1> <branchId>
+  //   e|o <id>
+  //   c
+    (*_traceStream) << op;
+    if (i != DaryHeap<Traits>::npos) {
+      const Vertex* v = (*_vertexes)[i];
+      (*_traceStream) << ' ' << v->getId();
+      if ((op == 'p') or (op == 'd')) {
+        (*_traceStream) << ' ' << _getKey(i)
+                        << ' ' << ((_hasAttractor) ? _attractor.manhattanDistance(v->getCenter()) : -1)
+                        << ' ' << _getBranchId(i);
+      }
+    }
+    (*_traceStream) << '\n';
   }
 
 
@@ -1419,6 +1463,7 @@ namespace Anabatic {
     string s = "";
     s += (_flags & Standart ) ? 'S' : '-';
     s += (_flags & Monotonic) ? 'M' : '-';
+    s += (_flags & AStar    ) ? 'A' : '-';
 
     return s;
   }
@@ -1457,7 +1502,9 @@ namespace Anabatic {
 
   Dijkstra::Dijkstra ( AnabaticEngine* anabatic )
     : _anabatic      (anabatic)
+    , _master        (NULL)
     , _vertexes      ()
+    , _states        (anabatic->getVertexStates(0))
     , _distanceCb    (_distance)
     , _mode          (Mode::Standart)
     , _net           (NULL)
@@ -1469,12 +1516,58 @@ namespace Anabatic {
     , _connectedsId  (-1)
     , _queue         ()
     , _flags         (0)
+    , _aStarCost     (0.0)
+    , _targetsArea   ()
+    , _expandeds     (0)
   {
     const vector<GCell*>& gcells = _anabatic->getGCells();
+    _states->resize( gcells.size() );
     for ( GCell* gcell : gcells ) {
-      _vertexes.push_back( new Vertex (gcell) );
+      _vertexes.push_back( new Vertex (gcell,_vertexes.size()) );
     }
     _anabatic->getMatrix()->show();
+
+#if not defined(ANABATIC_MULTISET_QUEUE)
+    _queue.setStates( &_vertexes, _states );
+    const char* tracePath = getenv( "ANABATIC_QUEUE_TRACE" );
+    if (tracePath) _queue.openTrace( tracePath );
+#endif
+  }
+
+
+  Dijkstra::Dijkstra ( Dijkstra* master, size_t slot )
+    : _anabatic      (master->_anabatic)
+    , _master        (master)
+    , _vertexes      ()
+    , _states        (master->_anabatic->getVertexStates(slot))
+    , _distanceCb    (master->_distanceCb)
+    , _mode          (Mode::Standart)
+    , _net           (NULL)
+    , _stamp         (-1)
+    , _sources       ()
+    , _targets       ()
+    , _searchArea    ()
+    , _searchAreaHalo(master->_searchAreaHalo)
+    , _connectedsId  (-1)
+    , _queue         ()
+    , _flags         (0)
+    , _aStarCost     (master->_aStarCost)
+    , _targetsArea   ()
+    , _expandeds     (0)
+  {
+  // A worker shares the Vertexes of it's master, which remains the only
+  // owner (Vertexes are GCell observers, there can be only one per GCell).
+  // The search state (queue, sources, targets & search area) is private,
+  // and the Vertex states are those of <slot>. Workers on slot 0 share
+  // the states of the master, so they can run concurrently only on
+  // *disjoint* search areas, and as load() grows the area (GCells under
+  // the terminals, halo, symmetry), it is up to the caller to check the
+  // loaded area with getSearchArea(). A worker on a slot of it's own has
+  // no such restriction as far as the states are concerned.
+    _states->resize( _master->_vertexes.size() );
+#if not defined(ANABATIC_MULTISET_QUEUE)
+    _queue.setStates( &_master->_vertexes, _states );
+#endif
   }
 
 
@@ -1495,7 +1588,7 @@ namespace Anabatic {
     DbU::Unit x   = 0;
     DbU::Unit y   = 0;
     
-    for ( Component* component : _net->getComponents() ) {
+    for ( Component* component : _net->getComponentRange() ) {
       RoutingPad* rp = dynamic_cast<RoutingPad*>( component );
       if (rp) rps.push_back( rp ); 
     }
@@ -1515,7 +1608,7 @@ namespace Anabatic {
     netData->setGlobalRouted( true );
     netData->setGlobalFixed ( true );
 
-    for ( Component* component : net->getComponents() ) {
+    for ( Component* component : net->getComponentRange() ) {
       Horizontal* horizontal = dynamic_cast<Horizontal*>( component );
       if (horizontal) {
         if (not Session::isGLayer(horizontal->getLayer())) {
@@ -1555,8 +1648,14 @@ namespace Anabatic {
   {
     _cleanup();
 
+    VertexStates::Bind bind ( _states );
+
     _net   = net;
-    _stamp = _anabatic->incStamp();
+  // Workers loaded in the same batch on the states of the master share
+  // the current stamp, it is up to the caller to increment it between
+  // two batches.
+    _stamp = (isWorker() and (_states == _master->_states)) ? _states->getGeneration()
+                                                            : _states->incGeneration();
 
     DebugSession::open( _net, 112, 120 );
     cdebug_log(112,1) << "Dijkstra::load() " << _net << endl;
@@ -1758,7 +1857,7 @@ namespace Anabatic {
                                                   ) );
         }
         if (gcell) {
-          _queue.push(gcell->getObserver<Vertex>(GCell::Observable::Vertex));
+          _push(gcell->getObserver<Vertex>(GCell::Observable::Vertex));
         }
         while ( not _queue.empty() ) {
           Vertex* current  = _queue.top();
@@ -1776,7 +1875,7 @@ namespace Anabatic {
               Vertex* vnext = gnext->getObserver<Vertex>(GCell::Observable::Vertex);
               if (  (gnext->getXCenter() == state->getSymAxis()) 
                  && (gnext->getYMin() <= cell->getAbutmentBox().getYMax())
-                 ) _queue.push( vnext );
+                 ) _push( vnext );
             }
           } else if (state->isSymHorizontal()){
           // check East
@@ -1785,7 +1884,7 @@ namespace Anabatic {
               Vertex* vnext = gnext->getObserver<Vertex>(GCell::Observable::Vertex);
               if (  (gnext->getXCenter() == state->getSymAxis())
                  && (gnext->getXMin() <= cell->getAbutmentBox().getXMax())
-                 ) _queue.push( vnext );
+                 ) _push( vnext );
             }
           }   
         }
@@ -1815,7 +1914,7 @@ namespace Anabatic {
                                                   ) );
         }
         if (gcell) {
-          _queue.push(gcell->getObserver<Vertex>(GCell::Observable::Vertex));
+          _push(gcell->getObserver<Vertex>(GCell::Observable::Vertex));
           setFlags(Mode::AxisTarget);
           cdebug_log(112,0) << "Find axis targets: " << endl;
         }
@@ -1841,7 +1940,7 @@ namespace Anabatic {
               if (  ( (state->getSymAxis() >= gnext->getXMin()) && (state->getSymAxis() <= gnext->getXMax()) )
                  && (gnext->getYMin() <= cell->getAbutmentBox().getYMax())
                  ){ 
-                _queue.push( vnext );
+                _push( vnext );
               } else {  cdebug_log(112,0) << "isNOT: " << gnext << endl;
               }
 
@@ -1854,7 +1953,7 @@ namespace Anabatic {
               if (  ( (state->getSymAxis() >= gnext->getYMin()) && (state->getSymAxis() <= gnext->getYMax()) )
                  && (gnext->getXMin() <= cell->getAbutmentBox().getXMax())
                  ) {
-                _queue.push( vnext );
+                _push( vnext );
               } else { cdebug_log(112,0) << "isNOT: " << gnext << endl;
               }
             }
@@ -1954,6 +2053,15 @@ namespace Anabatic {
   }
 
 
+  void  Dijkstra::_updateTargetsArea ()
+  {
+    _targetsArea.makeEmpty();
+    if (not (_mode & Mode::AStar) or needAxisTarget()) return;
+
+    for ( Vertex* target : _targets ) _targetsArea.merge( target->getCenter() );
+  }
+
+
   bool  Dijkstra::_propagate ( Flags enabledSides )
   {
     cdebug_log(112,1) << "Dijkstra::_propagate() " << _net <<  endl;
@@ -1962,22 +2070,41 @@ namespace Anabatic {
                         << " and needaxis? " << needAxisTarget() << endl;
 
       _queue.dump();
-      Vertex* current  = _queue.top();
-      GCell*  gcurrent = current->getGCell();
+    // The search state is read and written directly in <_states>, at the
+    // dense index of the Vertexes. The Vertex itself is only used for
+    // it's GCell (edges, bounding box) and the analog data.
+      Vertex*  current  = _queue.top();
+      uint32_t icurrent = current->getIndex();
+      GCell*   gcurrent = current->getGCell();
+
+      _queue.pop();
+
+    // A*: the targets area only shrinks, so the estimate of a queued
+    // Vertex can only be too low. Re-evaluate it lazily when popped.
+      if (_mode & Mode::AStar) {
+        DbU::Unit estimate = _getEstimate( current );
+        if (estimate > _states->getEstimate(icurrent)) {
+          _states->setEstimate( icurrent, estimate );
+          _queue.push( current );
+          continue;
+        }
+      }
 
       cdebug_log(111,1) << "Current:" << current << endl;
     //cdebug_log(111,0) << "isAxisTarget():" << current->isAxisTarget() << endl;
-      
-      _queue.pop();
 
+      int connexId = _getConnexId( icurrent );
       if      ( current->isAxisTarget() and needAxisTarget()) unsetFlags(Mode::AxisTarget);
-      else if ((current->getConnexId() == _connectedsId) or (current->getConnexId() < 0)) {
+      else if ((connexId == _connectedsId) or (connexId < 0)) {
         cdebug_log(111,0) << "Looking for neighbors:" << endl;
+        ++_expandeds;
 
-        for ( Edge* edge : current->getGCell()->getEdges() ) {
+        Edge* from     = _getFrom    ( icurrent );
+        int   branchId = _getBranchId( icurrent );
+        for ( Edge* edge : gcurrent->getEdges() ) {
           cdebug_log(111,0) << "@ Edge " << edge << endl;
 
-          if (edge == current->getFrom()) {
+          if (edge == from) {
             cdebug_log(111,0) << "> Reject: edge == current->getFrom()" << endl;
             continue;
           }
@@ -1987,12 +2114,13 @@ namespace Anabatic {
             continue;
           }
 
-          Vertex* vneighbor = current->getNeighbor( edge );
+          Vertex*  vneighbor = current->getNeighbor( edge );
+          uint32_t ineighbor = vneighbor->getIndex();
           if (vneighbor->isAnalog()) vneighbor->createAData();
 
           cdebug_log(111,0) << "| Neighbor:" << vneighbor << endl;
 
-          if (vneighbor->getConnexId() == _connectedsId) {
+          if (_getConnexId(ineighbor) == _connectedsId) {
             cdebug_log(111,0) << "> Reject: Neighbor already reached (has connectedsId)" << endl;
             continue;
           }
@@ -2025,26 +2153,32 @@ namespace Anabatic {
 
           bool push = false;
           if (distance != Vertex::unreachable){
-            if (not vneighbor->hasValidStamp()) {
+            if (not _states->isValid(ineighbor)) {
               cdebug_log(111,0) << "> Vertex reached for the first time" << endl;
-              vneighbor->setConnexId( -1 );
-              vneighbor->setStamp   ( _stamp );
-              vneighbor->setDegree  ( 1 );
-              vneighbor->setRpCount ( 0 );
+              _states->setConnexId( ineighbor, -1 );
+              _states->setStamp   ( ineighbor, _stamp );
+              _states->setDegree  ( ineighbor, 1 );
+              _states->setRpCount ( ineighbor, 0 );
               vneighbor->unsetFlags(Vertex::AxisTarget|Vertex::Queued);
               vneighbor->resetIntervals();
               push = true;
             } else {
-              if  (   (distance == vneighbor->getDistance())
+              DbU::Unit ndistance = _states->getDistance( ineighbor );
+              if  (   (distance == ndistance)
                   and (vneighbor->isAnalog()) 
                   and (vneighbor->getFrom2() == NULL) 
                   ) {
                 _pushEqualDistance( distance, isDistance2shorter, current, vneighbor, edge ); // ANALOG
 
-              } else if (distance < vneighbor->getDistance()) {
-                if (vneighbor->getDistance() != Vertex::unreached) _queue.erase( vneighbor );
+              } else if (distance < ndistance) {
+#if defined(ANABATIC_MULTISET_QUEUE)
+              // A multiset cannot be re-keyed in place, the Vertex must be
+              // removed *before* it's distance is modified. With the heap,
+              // the push() below does a decreaseKey().
+                if (ndistance != Vertex::unreached) _queue.erase( vneighbor );
+#endif
                 cdebug_log(111,0) << "> Vertex reached through a shorter path (prev: "
-                                  << DbU::getValueString(vneighbor->getDistance()) << ")" << endl;
+                                  << DbU::getValueString(ndistance) << ")" << endl;
                 push = true;
               } else {
                 cdebug_log(111,0) << "> Reject: Vertex reached through a *longer* path or unreachable:"
@@ -2059,11 +2193,11 @@ namespace Anabatic {
           if (push){
             if (vneighbor->isAnalog()) // Vneighbor only not current gcell
               _updateGRAData( vneighbor, isDistance2shorter, current );
-            vneighbor->setBranchId( current->getBranchId() );
-            vneighbor->setDistance( distance );
+            _states->setBranchId( ineighbor, branchId );
+            _states->setDistance( ineighbor, distance );
             cdebug_log(111,0) << "| setFrom1: " << vneighbor << endl; 
-            vneighbor->setFrom ( edge );
-            _queue.push( vneighbor );
+            _states->setFrom    ( ineighbor, edge );
+            _push( vneighbor );
             cdebug_log(111,0) << "| Push: (size:" << _queue.size() << ") " << vneighbor << ", isFromFrom2: " << vneighbor->isFromFrom2() << endl;
           }
           
@@ -2096,7 +2230,7 @@ namespace Anabatic {
               vneighbor->setFrom ( edge );
               if (gneighbor->isAnalog()) vneighbor->setFrom2( NULL );
 
-              _queue.push( vneighbor );
+              _push( vneighbor );
               cdebug_log(111,0) << "Push: (size:" << _queue.size() << ") " << vneighbor << endl;
             } else {
               if ( (distance < vneighbor->getDistance()) and (distance != Vertex::unreachable) ) {
@@ -2123,7 +2257,7 @@ namespace Anabatic {
                 vneighbor->setFrom ( edge );
                 if (gneighbor->isAnalog()) vneighbor->setFrom2( NULL );
 
-                _queue.push( vneighbor );
+                _push( vneighbor );
                 cdebug_log(111,0) << "Push: (size:" << _queue.size() << ") " << vneighbor << endl;
               } else {
                 cdebug_log(111,0) << "Reject: Vertex reached through a *longer* path or unreachable:"
@@ -2210,7 +2344,7 @@ namespace Anabatic {
         current->setConnexId( _connectedsId );
         current->setBranchId( branchId );
         _sources.insert( current );
-        _queue.push( current );
+        _push( current );
         current = current->getPredecessor();
       }
     }
@@ -2374,13 +2508,27 @@ namespace Anabatic {
     DebugSession::open( _net, 111, 120 );
 
     cdebug_log(112,1) << "Dijkstra::run() on " << _net << " mode:" << mode << endl;
-    _mode = mode;
+    if (search(mode)) commit();
+    
+    cdebug_tabw(112,-1);
+    DebugSession::close();
+  }
+
+
+  bool  Dijkstra::search ( Dijkstra::Mode mode )
+  {
+  // The search part of run(), it only modifies the Vertexes of the
+  // search area and *reads* the Edges. It does not modify the
+  // database so it can be called from a worker thread.
+    VertexStates::Bind bind ( _states );
+
+    _mode      = mode;
+    _expandeds = 0;
 
     _selectFirstSource();
     if (_sources.empty()) {
       cdebug_log(112,0) << "No source to start, not routed." << endl;
-      cdebug_tabw(112,-1);
-      return;
+      return false;
     }
 
     Flags enabledEdges = Flags::AllSides;
@@ -2393,24 +2541,35 @@ namespace Anabatic {
 
     _queue.clear();
     _queue.setAttractor( _searchArea.getCenter() );
+    _updateTargetsArea();
     _connectedsId = (*_sources.begin())->getConnexId();
     for ( Vertex* source : _sources ) {
-      _queue.push( source );
+      _push( source );
       source->setDistance( 0.0 );
       cdebug_log(112,0) << "Push source: (size:" << _queue.size() << ") "
                         << source
                         << " _connectedsId:" << _connectedsId << endl;
     }
-    while ( ((not _targets.empty()) ||  needAxisTarget()) and _propagate(enabledEdges) );
+    while ( ((not _targets.empty()) ||  needAxisTarget()) and _propagate(enabledEdges) )
+      _updateTargetsArea();
       
     _queue.clear();
+    _targetsArea.makeEmpty();
+    return true;
+  }
+
+
+  void  Dijkstra::commit ()
+  {
+  // Create the global routing from the result of search(). Modifies the
+  // database and the Edges occupancies, must *always* be called from
+  // the main thread.
+    VertexStates::Bind bind ( _states );
+
     _materialize();
     unsetAxisTargets();
 
     _anabatic->getNetData( _net )->setGlobalRouted( true );
-    
-    cdebug_tabw(112,-1);
-    DebugSession::close();
   }
 
 
@@ -2423,7 +2582,7 @@ namespace Anabatic {
     source->setDistance( 0.0 );
     _targets.erase ( source );
     _sources.insert( source );
-    _queue.push( source );
+    _push( source );
 
     VertexSet stack;
     stack.insert( source );
@@ -2453,7 +2612,7 @@ namespace Anabatic {
 
         _targets.erase ( vneighbor );
         _sources.insert( vneighbor );
-        _queue.push( vneighbor );
+        _push( vneighbor );
         stack.insert( vneighbor );
       }
     }
@@ -2826,7 +2985,7 @@ namespace Anabatic {
       current->setConnexId( _connectedsId );
       current->setBranchId( branchId );
       _sources.insert( current );
-      _queue.push( current );
+      _push( current );
     } else {
     //cdebug_log(112,0) << "Is first" << endl;
       isfirst = false;
@@ -0,0 +1,240 @@
+// -*- mode: C++; explicit-buffer-name: "DijkstraQueueBench.cpp<anabatic>" -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |     A n a b a t i c  -  Global Routing Toolbox                  |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./DijkstraQueueBench.cpp"                      |
+// +-----------------------------------------------------------------+
+//
+// Replay a Dijkstra priority queue trace on both the multiset and the
+// d-ary heap implementations, check that they pop the Vertexes in the
+// same order and report their run times.
+//
+// To record a trace, run the global router with:
+//
+//     ANABATIC_QUEUE_TRACE=/tmp/queue.trace
+//
+// Usage:  dijkstra-queue-bench <trace> [repeat]
+
+
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <set>
+#include "anabatic/DaryHeap.h"
+
+
+namespace {
+
+  using namespace std;
+  using Anabatic::DaryHeap;
+
+
+  class TraceVertex {
+    public:
+      inline           TraceVertex   ();
+      inline uint32_t  getQueueIndex () const;
+      inline void      setQueueIndex ( uint32_t );
+    public:
+      uint32_t  _id;
+      int64_t   _distance;
+      int64_t   _attractorDistance;
+      int64_t   _branchId;
+      uint32_t  _queueIndex;
+      bool      _queued;
+  };
+
+
+  inline           TraceVertex::TraceVertex   () : _id(0), _distance(0), _attractorDistance(-1), _branchId(0), _queueIndex(UINT32_MAX), _queued(false) { }
+  inline uint32_t  TraceVertex::getQueueIndex () const { return _queueIndex; }
+  inline void      TraceVertex::setQueueIndex ( uint32_t index ) { _queueIndex=index; }
+
+
+  class CompareByDistance {
+    public:
+      inline bool  operator() ( const TraceVertex* lhs, const TraceVertex* rhs ) const
+      {
+        if (lhs->_distance == rhs->_distance) {
+          if (lhs->_attractorDistance != rhs->_attractorDistance)
+            return lhs->_attractorDistance < rhs->_attractorDistance;
+          return lhs->_branchId > rhs->_branchId;
+        }
+        return lhs->_distance < rhs->_distance;
+      }
+  };
+
+
+// The heap works on the dense ids (the rank in the vertexes vector).
+  class HeapTraits {
+    public:
+      inline           HeapTraits    ( vector<TraceVertex>* vertexes=NULL );
+      inline bool      operator()    ( uint32_t lhs, uint32_t rhs ) const;
+      inline uint32_t  getQueueIndex ( uint32_t id ) const;
+      inline void      setQueueIndex ( uint32_t id, uint32_t index ) const;
+    private:
+      vector<TraceVertex>* _vertexes;
+  };
+
+
+  inline           HeapTraits::HeapTraits    ( vector<TraceVertex>* vertexes ) : _vertexes(vertexes) { }
+  inline bool      HeapTraits::operator()    ( uint32_t lhs, uint32_t rhs ) const { return CompareByDistance()( &(*_vertexes)[lhs], &(*_vertexes)[rhs] ); }
+  inline uint32_t  HeapTraits::getQueueIndex ( uint32_t id ) const { return (*_vertexes)[id].getQueueIndex(); }
+  inline void      HeapTraits::setQueueIndex ( uint32_t id, uint32_t index ) const { (*_vertexes)[id].setQueueIndex( index ); }
+
+
+  struct TraceOp {
+    char      _op;
+    uint32_t  _id;
+    int64_t   _distance;
+    int64_t   _attractorDistance;
+    int64_t   _branchId;
+  };
+
+
+  bool  loadTrace ( const char* path, vector<TraceOp>& ops, vector<TraceVertex>& vertexes )
+  {
+    ifstream  in ( path );
+    if (not in) {
+      cerr << "[ERROR] Unable to open trace \"" << path << "\"." << endl;
+      return false;
+    }
+
+    TraceOp op { 0, 0, 0, -1, 0 };
+    while ( in >> op._op ) {
+      switch ( op._op ) {
+        case 'p':
+        case 'd': in >> op._id >> op._distance >> op._attractorDistance >> op._branchId; break;
+        case 'e':
+        case 'o': in >> op._id; break;
+        case 'c': break;
+        default:
+          cerr << "[ERROR] Unknown operation '" << op._op << "' in trace." << endl;
+          return false;
+      }
+      if (op._id >= vertexes.size()) vertexes.resize( op._id+1 );
+      ops.push_back( op );
+    }
+    for ( size_t id=0 ; id<vertexes.size() ; ++id ) vertexes[id]._id = id;
+    return true;
+  }
+
+
+  inline void  setKeys ( TraceVertex& v, const TraceOp& op )
+  {
+    v._distance          = op._distance;
+    v._attractorDistance = op._attractorDistance;
+    v._branchId          = op._branchId;
+  }
+
+
+  size_t  replayMultiset ( const vector<TraceOp>& ops, vector<TraceVertex>& vertexes )
+  {
+    multiset<TraceVertex*,CompareByDistance> queue;
+    size_t mismatches = 0;
+
+    auto erase = [&]( TraceVertex* v ) {
+      if (not v->_queued) return;
+      for ( auto iv=queue.begin() ; iv!=queue.end() ; ++iv ) {
+        if (*iv == v) { queue.erase( iv ); break; }
+      }
+      v->_queued = false;
+    };
+
+    for ( const TraceOp& op : ops ) {
+      TraceVertex* v = &vertexes[op._id];
+      switch ( op._op ) {
+        case 'd': erase( v );  // Fall through: re-insert with the new keys.
+                  [[fallthrough]];
+        case 'p': setKeys( *v, op ); queue.insert( v ); v->_queued = true; break;
+        case 'e': erase( v ); break;
+        case 'o':
+          if ((*queue.begin())->_id != op._id) ++mismatches;
+          (*queue.begin())->_queued = false;
+          queue.erase( queue.begin() );
+          break;
+        case 'c':
+          for ( TraceVertex* qv : queue ) qv->_queued = false;
+          queue.clear();
+          break;
+      }
+    }
+    return mismatches;
+  }
+
+
+  size_t  replayHeap ( const vector<TraceOp>& ops, vector<TraceVertex>& vertexes )
+  {
+    HeapTraits           traits ( &vertexes );
+    DaryHeap<HeapTraits> queue  ( traits );
+    size_t mismatches = 0;
+
+    for ( const TraceOp& op : ops ) {
+      TraceVertex* v = &vertexes[op._id];
+      switch ( op._op ) {
+        case 'p': setKeys( *v, op ); queue.push( op._id ); break;
+        case 'd': setKeys( *v, op ); queue.decreaseKey( op._id ); break;
+        case 'e': queue.erase( op._id ); break;
+        case 'o':
+          if (queue.top() != op._id) ++mismatches;
+          queue.pop();
+          break;
+        case 'c': queue.clear(); break;
+      }
+    }
+    return mismatches;
+  }
+
+
+  template< typename Replay >
+  double  bench ( const char* name, Replay replay, const vector<TraceOp>& ops, vector<TraceVertex>& vertexes, size_t repeat )
+  {
+    typedef std::chrono::steady_clock  Clock;
+
+    size_t            mismatches = 0;
+    Clock::time_point start      = Clock::now();
+    for ( size_t i=0 ; i<repeat ; ++i ) mismatches += replay( ops, vertexes );
+    double seconds = std::chrono::duration<double>( Clock::now() - start ).count();
+
+    cout << "  o  " << name << ": " << (seconds*1000.0/repeat) << " ms/replay";
+    if (mismatches) cout << ", " << (mismatches/repeat) << " pops differ from the trace";
+    cout << endl;
+    return seconds;
+  }
+
+
+}  // Anonymous namespace.
+
+
+int  main ( int argc, char* argv[] )
+{
+  if (argc < 2) {
+    cerr << "Usage: dijkstra-queue-bench <trace> [repeat]" << endl;
+    return 1;
+  }
+  size_t repeat = (argc > 2) ? strtoul( argv[2], NULL, 10 ) : 10;
+  if (not repeat) repeat = 1;
+
+  vector<TraceOp>     ops;
+  vector<TraceVertex> vertexes;
+  if (not loadTrace(argv[1],ops,vertexes)) return 1;
+
+  cout << "Replaying " << ops.size() << " queue operations over "
+       << vertexes.size() << " vertexes, " << repeat << " times." << endl;
+
+  double multisetTime = bench( "std::multiset", replayMultiset, ops, vertexes, repeat );
+  double heapTime     = bench( "DaryHeap<4>  ", replayHeap    , ops, vertexes, repeat );
+  if (heapTime > 0.0)
+    cout << "  o  Speedup: " << (multisetTime/heapTime) << endl;
+
+  return 0;
+}
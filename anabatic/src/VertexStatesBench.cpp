@@ -0,0 +1,429 @@
+// -*- mode: C++; explicit-buffer-name: "VertexStatesBench.cpp<anabatic>" -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |     A n a b a t i c  -  Global Routing Toolbox                  |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./VertexStatesBench.cpp"                       |
+// +-----------------------------------------------------------------+
+//
+// Run the same searches on a regular GCell matrix with the per-search
+// state of the Vertexes stored either in one heap allocated record per
+// Vertex (the former layout) or in the VertexStates arrays, check that
+// both find the same distances and report their run times and, when
+// the hardware counters are readable, their cache misses.
+//
+// The searches are those of the global router: two terminals drawn
+// from a fixed seed, a search area of their bounding box inflated by a
+// halo, the real DaryHeap. The matrix default to the 324x324 tiles of
+// the ISPD 2008 adaptec1 benchmark. The GCells are modeled by heap
+// allocated records holding their neighbors and Edge costs, read the
+// same way by both layouts.
+//
+// Usage:  vertex-states-bench [columns] [rows] [nets] [halo]
+
+
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <algorithm>
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+#include "anabatic/DaryHeap.h"
+#include "anabatic/VertexStates.h"
+
+
+namespace {
+
+  using namespace std;
+  using Anabatic::DaryHeap;
+  using Anabatic::VertexStates;
+  using Anabatic::Edge;
+  typedef int64_t  Unit;
+
+  const Unit  unreached = std::numeric_limits<Unit>::max();
+
+
+// -------------------------------------------------------------------
+// Class  :  "CacheCounter".
+//
+// Hardware cache misses of the calling thread, through perf_event_open.
+// When the counters are not available (no PMU, virtual machine,
+// perf_event_paranoid), isValid() is false and the bench reports
+// run times only.
+
+  class CacheCounter {
+    public:
+                      CacheCounter ();
+                     ~CacheCounter ();
+      inline bool     isValid      () const;
+             void     start        ();
+             uint64_t stop         ();
+    private:
+      int  _fd;
+  };
+
+
+  CacheCounter::CacheCounter ()
+    : _fd(-1)
+  {
+#if defined(__linux__)
+    struct perf_event_attr attr;
+    memset( &attr, 0, sizeof(attr) );
+    attr.size           = sizeof(attr);
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.config         = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled       = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    _fd = syscall( __NR_perf_event_open, &attr, 0, -1, -1, 0 );
+#endif
+  }
+
+
+  CacheCounter::~CacheCounter ()
+  {
+#if defined(__linux__)
+    if (_fd >= 0) close( _fd );
+#endif
+  }
+
+
+  inline bool  CacheCounter::isValid () const { return (_fd >= 0); }
+
+
+  void  CacheCounter::start ()
+  {
+#if defined(__linux__)
+    if (_fd < 0) return;
+    ioctl( _fd, PERF_EVENT_IOC_RESET , 0 );
+    ioctl( _fd, PERF_EVENT_IOC_ENABLE, 0 );
+#endif
+  }
+
+
+  uint64_t  CacheCounter::stop ()
+  {
+    uint64_t count = 0;
+#if defined(__linux__)
+    if (_fd < 0) return 0;
+    ioctl( _fd, PERF_EVENT_IOC_DISABLE, 0 );
+    if (read( _fd, &count, sizeof(count) ) != sizeof(count)) count = 0;
+#endif
+    return count;
+  }
+
+
+// -------------------------------------------------------------------
+// Class  :  "Matrix".
+//
+// One heap allocated record per GCell, like the Anabatic GCells, with
+// the dense id of it's neighbors (East, West, North, South) and the
+// cost of the Edges leading to them.
+
+  class Matrix {
+    public:
+      struct Node {
+        uint32_t  _neighbors[4];
+        Unit      _costs    [4];
+        char      _cold     [96];
+      };
+    public:
+                          Matrix    ( uint32_t columns, uint32_t rows, mt19937& );
+                         ~Matrix    ();
+      inline uint32_t     size      () const;
+      inline uint32_t     getColumns() const;
+      inline uint32_t     getRows   () const;
+      inline const Node*  getNode   ( uint32_t ) const;
+    private:
+      uint32_t       _columns;
+      uint32_t       _rows;
+      vector<Node*>  _nodes;
+  };
+
+
+  Matrix::Matrix ( uint32_t columns, uint32_t rows, mt19937& generator )
+    : _columns(columns), _rows(rows), _nodes()
+  {
+    uniform_int_distribution<Unit> cost ( 100, 400 );
+    for ( uint32_t y=0 ; y<rows ; ++y ) {
+      for ( uint32_t x=0 ; x<columns ; ++x ) {
+        Node* node = new Node ();
+        node->_neighbors[0] = (x+1 < columns) ? y*columns + x+1 : VertexStates::npos;
+        node->_neighbors[1] = (x     > 0    ) ? y*columns + x-1 : VertexStates::npos;
+        node->_neighbors[2] = (y+1 < rows   ) ? (y+1)*columns+x : VertexStates::npos;
+        node->_neighbors[3] = (y     > 0    ) ? (y-1)*columns+x : VertexStates::npos;
+        for ( size_t i=0 ; i<4 ; ++i ) node->_costs[i] = cost( generator );
+        _nodes.push_back( node );
+      }
+    }
+  }
+
+
+  Matrix::~Matrix ()
+  {
+    for ( Node* node : _nodes ) delete node;
+  }
+
+
+  inline uint32_t             Matrix::size       () const { return _nodes.size(); }
+  inline uint32_t             Matrix::getColumns () const { return _columns; }
+  inline uint32_t             Matrix::getRows    () const { return _rows; }
+  inline const Matrix::Node*  Matrix::getNode    ( uint32_t id ) const { return _nodes[id]; }
+
+
+// -------------------------------------------------------------------
+// Class  :  "RecordStates".
+//
+// The former layout: the search state lives in one record per Vertex,
+// allocated in GCell order along with the cold data of the Vertex, and
+// validated by comparing it's stamp to the current one. Same interface
+// as VertexStates, for the fields the search uses.
+
+  class RecordStates {
+    private:
+      struct Record {
+        size_t    _id;
+        void*     _gcell;
+        void*     _observer[2];
+        int       _connexId;
+        int       _branchId;
+        int       _degree  : 8;
+        int       _rpCount : 8;
+        int       _stamp;
+        Unit      _distance;
+        Unit      _estimate;
+        Edge*     _from;
+        uint32_t  _flags;
+        uint32_t  _queueIndex;
+        void*     _adata;
+      };
+    public:
+                        RecordStates   ( size_t );
+                       ~RecordStates   ();
+      inline int        incGeneration  ();
+      inline bool       isValid        ( uint32_t ) const;
+      inline Unit       getDistance    ( uint32_t ) const;
+      inline Unit       getEstimate    ( uint32_t ) const;
+      inline Edge*      getFrom        ( uint32_t ) const;
+      inline uint32_t   getQueueIndex  ( uint32_t ) const;
+      inline void       setStamp       ( uint32_t, int );
+      inline void       setDistance    ( uint32_t, Unit );
+      inline void       setEstimate    ( uint32_t, Unit );
+      inline void       setFrom        ( uint32_t, Edge* );
+      inline void       setQueueIndex  ( uint32_t, uint32_t );
+    private:
+      int              _generation;
+      vector<Record*>  _records;
+  };
+
+
+  RecordStates::RecordStates ( size_t size )
+    : _generation(0), _records()
+  {
+    for ( size_t i=0 ; i<size ; ++i ) {
+      Record* record = new Record ();
+      record->_id         = i;
+      record->_stamp      = -1;
+      record->_queueIndex = VertexStates::npos;
+      _records.push_back( record );
+    }
+  }
+
+
+  RecordStates::~RecordStates ()
+  {
+    for ( Record* record : _records ) delete record;
+  }
+
+
+  inline int       RecordStates::incGeneration () { return ++_generation; }
+  inline bool      RecordStates::isValid       ( uint32_t i ) const { return _records[i]->_stamp == _generation; }
+  inline Unit      RecordStates::getDistance   ( uint32_t i ) const { return _records[i]->_distance; }
+  inline Unit      RecordStates::getEstimate   ( uint32_t i ) const { return _records[i]->_estimate; }
+  inline Edge*     RecordStates::getFrom       ( uint32_t i ) const { return _records[i]->_from; }
+  inline uint32_t  RecordStates::getQueueIndex ( uint32_t i ) const { return _records[i]->_queueIndex; }
+  inline void      RecordStates::setStamp      ( uint32_t i, int       stamp    ) { _records[i]->_stamp = stamp; }
+  inline void      RecordStates::setDistance   ( uint32_t i, Unit      distance ) { _records[i]->_distance = distance; }
+  inline void      RecordStates::setEstimate   ( uint32_t i, Unit      estimate ) { _records[i]->_estimate = estimate; }
+  inline void      RecordStates::setFrom       ( uint32_t i, Edge*     from     ) { _records[i]->_from = from; }
+  inline void      RecordStates::setQueueIndex ( uint32_t i, uint32_t  index    ) { _records[i]->_queueIndex = index; }
+
+
+// -------------------------------------------------------------------
+// Class  :  "HeapTraits".
+
+  template< typename States >
+  class HeapTraits {
+    public:
+      inline           HeapTraits    ( States* states=NULL );
+      inline bool      operator()    ( uint32_t lhs, uint32_t rhs ) const;
+      inline uint32_t  getQueueIndex ( uint32_t ) const;
+      inline void      setQueueIndex ( uint32_t, uint32_t ) const;
+    private:
+      States* _states;
+  };
+
+
+  template< typename States >
+  inline HeapTraits<States>::HeapTraits ( States* states ) : _states(states) { }
+
+  template< typename States >
+  inline bool  HeapTraits<States>::operator() ( uint32_t lhs, uint32_t rhs ) const
+  { return _states->getDistance(lhs) + _states->getEstimate(lhs) < _states->getDistance(rhs) + _states->getEstimate(rhs); }
+
+  template< typename States >
+  inline uint32_t  HeapTraits<States>::getQueueIndex ( uint32_t i ) const { return _states->getQueueIndex(i); }
+
+  template< typename States >
+  inline void  HeapTraits<States>::setQueueIndex ( uint32_t i, uint32_t index ) const { _states->setQueueIndex(i,index); }
+
+
+  struct Net {
+    uint32_t  _source;
+    uint32_t  _target;
+    uint32_t  _xmin;
+    uint32_t  _ymin;
+    uint32_t  _xmax;
+    uint32_t  _ymax;
+  };
+
+
+  vector<Net>  generateNets ( const Matrix& matrix, size_t count, uint32_t halo, mt19937& generator )
+  {
+    uniform_int_distribution<uint32_t> column ( 0, matrix.getColumns()-1 );
+    uniform_int_distribution<uint32_t> row    ( 0, matrix.getRows   ()-1 );
+    uniform_int_distribution<int>      length ( -30, 30 );
+
+    vector<Net> nets;
+    for ( size_t i=0 ; i<count ; ++i ) {
+      int x1 = column( generator );
+      int y1 = row   ( generator );
+      int x2 = std::min( std::max( x1+length(generator), 0 ), (int)matrix.getColumns()-1 );
+      int y2 = std::min( std::max( y1+length(generator), 0 ), (int)matrix.getRows   ()-1 );
+      Net net;
+      net._source = y1*matrix.getColumns() + x1;
+      net._target = y2*matrix.getColumns() + x2;
+      net._xmin   = (uint32_t)std::max( std::min(x1,x2) - (int)halo, 0 );
+      net._ymin   = (uint32_t)std::max( std::min(y1,y2) - (int)halo, 0 );
+      net._xmax   = std::min( (uint32_t)std::max(x1,x2) + halo, matrix.getColumns()-1 );
+      net._ymax   = std::min( (uint32_t)std::max(y1,y2) + halo, matrix.getRows   ()-1 );
+      nets.push_back( net );
+    }
+    return nets;
+  }
+
+
+  template< typename States >
+  Unit  search ( const Matrix& matrix, States& states, DaryHeap< HeapTraits<States> >& queue, const Net& net )
+  {
+    int generation = states.incGeneration();
+    queue.clear();
+
+    states.setStamp   ( net._source, generation );
+    states.setDistance( net._source, 0 );
+    states.setEstimate( net._source, 0 );
+    states.setFrom    ( net._source, NULL );
+    queue.push( net._source );
+
+    while ( not queue.empty() ) {
+      uint32_t current = queue.top();
+      queue.pop();
+      if (current == net._target) return states.getDistance( current );
+
+      const Matrix::Node* node = matrix.getNode( current );
+      for ( size_t i=0 ; i<4 ; ++i ) {
+        uint32_t neighbor = node->_neighbors[i];
+        if (neighbor == VertexStates::npos) continue;
+        uint32_t x = neighbor % matrix.getColumns();
+        uint32_t y = neighbor / matrix.getColumns();
+        if ((x < net._xmin) or (x > net._xmax) or (y < net._ymin) or (y > net._ymax)) continue;
+
+        Unit distance = states.getDistance( current ) + node->_costs[i];
+        if (not states.isValid(neighbor)) {
+          states.setStamp     ( neighbor, generation );
+          states.setDistance  ( neighbor, distance );
+          states.setEstimate  ( neighbor, 0 );
+          states.setFrom      ( neighbor, reinterpret_cast<Edge*>( (uintptr_t)(i+1) ) );
+          states.setQueueIndex( neighbor, VertexStates::npos );
+          queue.push( neighbor );
+        } else if (distance < states.getDistance(neighbor)) {
+          states.setDistance( neighbor, distance );
+          states.setFrom    ( neighbor, reinterpret_cast<Edge*>( (uintptr_t)(i+1) ) );
+          queue.push( neighbor );
+        }
+      }
+    }
+    return unreached;
+  }
+
+
+  template< typename States >
+  Unit  run ( const char* name, const Matrix& matrix, States& states, const vector<Net>& nets )
+  {
+    typedef std::chrono::steady_clock  Clock;
+
+    HeapTraits<States>             traits  ( &states );
+    DaryHeap< HeapTraits<States> > queue   ( traits );
+    CacheCounter                   counter;
+    Unit                           total   = 0;
+
+    counter.start();
+    Clock::time_point start = Clock::now();
+    for ( const Net& net : nets ) total += search( matrix, states, queue, net );
+    double   seconds = std::chrono::duration<double>( Clock::now() - start ).count();
+    uint64_t misses  = counter.stop();
+
+    cout << "  o  " << name << ": " << (seconds*1000.0) << " ms";
+    if (counter.isValid()) cout << ", " << misses << " cache misses";
+    else                   cout << ", cache misses not available";
+    cout << "." << endl;
+    return total;
+  }
+
+
+}  // Anonymous namespace.
+
+
+int  main ( int argc, char* argv[] )
+{
+  uint32_t columns = (argc > 1) ? strtoul( argv[1], NULL, 10 ) : 324;
+  uint32_t rows    = (argc > 2) ? strtoul( argv[2], NULL, 10 ) : 324;
+  size_t   count   = (argc > 3) ? strtoul( argv[3], NULL, 10 ) : 20000;
+  uint32_t halo    = (argc > 4) ? strtoul( argv[4], NULL, 10 ) : 10;
+  if (not columns or not rows) return 1;
+
+  mt19937     generator ( 42 );
+  Matrix      matrix    ( columns, rows, generator );
+  vector<Net> nets      = generateNets( matrix, count, halo, generator );
+
+  cout << "Searching " << nets.size() << " nets on a " << columns << "x" << rows
+       << " matrix, halo " << halo << "." << endl;
+
+  RecordStates recordStates ( matrix.size() );
+  VertexStates vertexStates;
+  vertexStates.resize( matrix.size() );
+
+  Unit recordTotal = run( "Vertex records", matrix, recordStates, nets );
+  Unit statesTotal = run( "VertexStates  ", matrix, vertexStates, nets );
+
+  if (recordTotal != statesTotal) {
+    cerr << "[ERROR] The two layouts do not find the same distances." << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -31,6 +31,7 @@ namespace Hurricane {
 #include "anabatic/AutoContact.h"
 #include "anabatic/AutoSegments.h"
 #include "anabatic/ChipTools.h"
+#include "anabatic/VertexStates.h"
 
 
 namespace Anabatic {
@@ -116,6 +117,7 @@ namespace Anabatic {
       inline       size_t           getRpCount         () const;
       inline       size_t           getDiodeRpCount    () const;
       inline       DbU::Unit        getSparsity        () const;
+      inline       size_t           getExpandedCount   () const;
       inline       void             setNetRoutingState ( NetRoutingState* );
       inline       void             setSearchArea      ( Box );
       inline       void             setGlobalEstimated ( bool );
@@ -124,6 +126,7 @@ namespace Anabatic {
       inline       void             setExcluded        ( bool );
       inline       void             setRpCount         ( size_t );
       inline       void             setNoMoveUp        ( Segment* );
+      inline       void             incExpandedCount   ( size_t );
     private:                                     
                               NetData            ( const NetData& );
              NetData&         operator=          ( const NetData& );
@@ -135,6 +138,7 @@ namespace Anabatic {
       size_t                               _rpCount;
       size_t                               _diodeCount;
       DbU::Unit                            _sparsity;
+      size_t                               _expandeds;
       Flags                                _flags;
       std::set<Segment*,DBo::CompareById>  _noMoveUp;
   };
@@ -155,12 +159,14 @@ namespace Anabatic {
   inline size_t           NetData::getDiodeRpCount    () const { return _diodeCount; }
   inline void             NetData::setNetRoutingState ( NetRoutingState* state ) { _state=state; }
   inline DbU::Unit        NetData::getSparsity        () const { return _sparsity; }
+  inline size_t           NetData::getExpandedCount   () const { return _expandeds; }
   inline void             NetData::setGlobalEstimated ( bool state ) { _flags.set(Flags::GlobalEstimated,state); }
   inline void             NetData::setGlobalRouted    ( bool state ) { _flags.set(Flags::GlobalRouted   ,state); }
   inline void             NetData::setGlobalFixed     ( bool state ) { _flags.set(Flags::GlobalFixed    ,state); }
   inline void             NetData::setExcluded        ( bool state ) { _flags.set(Flags::ExcludeRoute   ,state); }
   inline void             NetData::setRpCount         ( size_t count ) { _rpCount=count; _update(); }
   inline void             NetData::setNoMoveUp        ( Segment* segment ) { _noMoveUp.insert(segment); }
+  inline void             NetData::incExpandedCount   ( size_t count ) { _expandeds+=count; }
 
 
   inline void  NetData::_update ()
@@ -253,6 +259,7 @@ namespace Anabatic {
     // Dijkstra related functions.                            
       inline        int               getStamp                () const;
       inline        int               incStamp                ();
+                    VertexStates*     getVertexStates         ( size_t slot=0 );
                     Contact*          breakAt                 ( Segment*, GCell* );
                     void              ripup                   ( Segment*, Flags );
                     void              ripupAll                ();
@@ -367,7 +374,7 @@ namespace Anabatic {
              NetDatas            _netDatas;
              CellViewer*         _viewer;
              Flags               _flags;
-             int                 _stamp;
+             vector<VertexStates*> _vertexStates;
              uint32_t            _routingMode;
              uint64_t            _densityMode;
              AutoSegmentLut      _autoSegmentLut;
@@ -452,8 +459,8 @@ namespace Anabatic {
       }
   }
 
-  inline       int    AnabaticEngine::getStamp () const { return _stamp; }
-  inline       int    AnabaticEngine::incStamp () { return ++_stamp; }
+  inline       int    AnabaticEngine::getStamp () const { return (_vertexStates.empty()) ? 0 : _vertexStates[0]->getGeneration(); }
+  inline       int    AnabaticEngine::incStamp () { return getVertexStates(0)->incGeneration(); }
 
   inline void  AnabaticEngine::addOv ( Edge* edge ) {
     _ovEdges.push_back(edge);
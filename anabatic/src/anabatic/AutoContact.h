@@ -22,6 +22,7 @@
 #include "hurricane/Contact.h"
 #include "hurricane/ExtensionGo.h"
 #include "anabatic/Constants.h"
+#include "anabatic/SlabPool.h"
 #include "anabatic/AutoSegment.h"
 #include "anabatic/GCell.h"
 
@@ -135,6 +136,9 @@ namespace Anabatic {
     // Accessors.                                        
       inline  Contact*         base                       () const;
       static  size_t           getAllocateds              ();
+      static  size_t           getArenaReserved           ();
+      static  size_t           getArenaPeak               ();
+      static  bool             releaseArenas              ();
       static  const Name&      getStaticName              ();
       virtual const Name&      getName                    () const;
       inline  size_t           getId                      () const;
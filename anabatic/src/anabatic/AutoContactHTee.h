@@ -39,6 +39,8 @@ namespace Anabatic {
     // Constructors & Destructors.
                                AutoContactHTee        ( GCell*, Contact* );
       virtual                 ~AutoContactHTee        ();
+      static  void*            operator new           ( size_t );
+      static  void             operator delete        ( void*, size_t );
       virtual void             _invalidate            ( Flags flags );
     public:
       virtual AutoHorizontal*  getHorizontal1         () const;
@@ -60,6 +62,8 @@ namespace Anabatic {
       AutoHorizontal* _horizontal1;
       AutoHorizontal* _horizontal2;
       AutoVertical*   _vertical1;
+    private:
+      static SlabPool<AutoContactHTee>  _arena;
   };
   
 
@@ -57,6 +57,8 @@ namespace Anabatic {
     // Constructors & Destructors.
                                    AutoContactTerminal    ( GCell*, Contact* );
       virtual                     ~AutoContactTerminal    ();
+      static  void*                operator new           ( size_t );
+      static  void                 operator delete        ( void*, size_t );
       virtual void                 _invalidate            ( Flags flags );
     public:
               bool                 isEndPoint             () const;
@@ -80,6 +82,8 @@ namespace Anabatic {
               AutoContactTerminal& operator=              ( const AutoContactTerminal& );
     protected:
       AutoSegment* _segment;
+    private:
+      static SlabPool<AutoContactTerminal>  _arena;
   };
 
 
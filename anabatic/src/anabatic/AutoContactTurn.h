@@ -38,6 +38,8 @@ namespace Anabatic {
     // Constructors & Destructors.
                                AutoContactTurn        ( GCell*, Contact* );
       virtual                 ~AutoContactTurn        ();
+      static  void*            operator new           ( size_t );
+      static  void             operator delete        ( void*, size_t );
       virtual void             _invalidate            ( Flags flags );
     public:
       virtual AutoHorizontal*  getHorizontal1         () const;
@@ -57,6 +59,8 @@ namespace Anabatic {
     private:
       AutoHorizontal* _horizontal1;
       AutoVertical*   _vertical1;
+    private:
+      static SlabPool<AutoContactTurn>  _arena;
   };
 
   
@@ -36,6 +36,8 @@ namespace Anabatic {
     // Constructors & Destructors.
                                AutoContactVTee        ( GCell*, Contact* );
       virtual                 ~AutoContactVTee        ();
+      static  void*            operator new           ( size_t );
+      static  void             operator delete        ( void*, size_t );
       virtual void             _invalidate            ( Flags flags );
     public:
       virtual AutoHorizontal*  getHorizontal1         () const;
@@ -57,6 +59,8 @@ namespace Anabatic {
       AutoHorizontal* _horizontal1;
       AutoVertical*   _vertical1;
       AutoVertical*   _vertical2;
+    private:
+      static SlabPool<AutoContactVTee>  _arena;
   };
 
 
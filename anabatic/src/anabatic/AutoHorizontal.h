@@ -77,11 +77,15 @@ namespace Anabatic {
     protected:
                               AutoHorizontal         ( Horizontal* );
       virtual                ~AutoHorizontal         ();
+      static  void*           operator new           ( size_t );
+      static  void            operator delete        ( void*, size_t );
       virtual void            _postCreate            ();
       virtual void            _preDestroy            ();
     private:
                               AutoHorizontal         ( const AutoHorizontal& );
               AutoHorizontal& operator=              ( const AutoHorizontal& );
+    private:
+      static SlabPool<AutoHorizontal>  _arena;
   };
 
 
@@ -31,6 +31,7 @@ namespace Hurricane {
 }
 #include "crlcore/RoutingGauge.h"
 #include "anabatic/Constants.h"
+#include "anabatic/SlabPool.h"
 #include "anabatic/GCell.h"
 #include "anabatic/AutoSegments.h"
 #include "anabatic/Session.h"
@@ -494,6 +495,9 @@ namespace Anabatic {
       static inline int           getTerminalCount           ( AutoSegment* seed );
       static inline size_t        getGlobalsCount            ();
       static inline size_t        getAllocateds              ();
+      static size_t               getArenaReserved           ();
+      static size_t               getArenaPeak               ();
+      static bool                 releaseArenas              ();
       static inline unsigned long getMaxId                   ();
   };
 
@@ -77,11 +77,15 @@ namespace Anabatic {
     protected:
                             AutoVertical       ( Vertical* );
       virtual              ~AutoVertical       ();
+      static  void*         operator new       ( size_t );
+      static  void          operator delete    ( void*, size_t );
       virtual void          _postCreate        ();
       virtual void          _preDestroy        ();
     private:
                              AutoVertical      ( const AutoVertical& );
               AutoVertical&  operator=         ( const AutoVertical& );
+    private:
+      static SlabPool<AutoVertical>  _arena;
   };
 
 
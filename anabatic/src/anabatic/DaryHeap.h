@@ -0,0 +1,253 @@
+// -*- mode: C++; explicit-buffer-name: "DaryHeap.h<anabatic>" -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |     A n a b a t i c  -  Global Routing Toolbox                  |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./anabatic/DaryHeap.h"                         |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <algorithm>
+
+
+namespace Anabatic {
+
+
+// -------------------------------------------------------------------
+// Class  :  "Anabatic::DaryHeap".
+//
+// Indexed d-ary min-heap over dense element ids (uint32_t). The heap
+// never touches the elements themselves, everything goes through the
+// <Traits> object, which must provide:
+//
+//     bool      operator()    ( uint32_t lhs, uint32_t rhs ) const;  // lhs < rhs
+//     uint32_t  getQueueIndex ( uint32_t id ) const;
+//     void      setQueueIndex ( uint32_t id, uint32_t index ) const;
+//
+// So the keys and the position of an element inside the heap can be
+// kept in flat arrays indexed by the id. This allows erase() and
+// decreaseKey() in O(log n) without any lookup and without any
+// allocation once the underlying vector has grown.
+//
+// Elements that compare equal are popped in insertion order (FIFO),
+// which is what a std::multiset does. So the heap can be substituted to
+// one without changing the order in which the elements are processed.
+// A decreaseKey() counts as a re-insertion, like erase() + insert() on
+// a multiset.
+
+  template< typename Traits, size_t Arity=4 >
+  class DaryHeap {
+    public:
+      static const uint32_t  npos = std::numeric_limits<uint32_t>::max();
+    private:
+      struct Slot {
+        uint32_t  _id;
+        uint64_t  _order;
+      };
+    public:
+      inline                DaryHeap    ( Traits traits=Traits() );
+      inline       bool     empty       () const;
+      inline       size_t   size        () const;
+      inline       bool     contains    ( uint32_t ) const;
+      inline       uint32_t top         () const;
+      inline       uint32_t operator[]  ( size_t ) const;
+      inline const Traits&  getTraits   () const;
+      inline       Traits&  getTraits   ();
+      inline       void     reserve     ( size_t );
+      inline       void     push        ( uint32_t );
+      inline       void     decreaseKey ( uint32_t );
+      inline       void     erase       ( uint32_t );
+      inline       void     pop         ();
+      inline       void     clear       ();
+    private:
+      inline       bool     _less       ( const Slot&, const Slot& ) const;
+      inline       void     _place      ( size_t index, const Slot& );
+      inline       void     _siftUp     ( size_t index );
+      inline       void     _siftDown   ( size_t index );
+    private:
+      Traits             _traits;
+      std::vector<Slot>  _slots;
+      uint64_t           _order;
+  };
+
+
+  template< typename Traits, size_t Arity >
+  inline DaryHeap<Traits,Arity>::DaryHeap ( Traits traits )
+    : _traits(traits)
+    , _slots ()
+    , _order (0)
+  { }
+
+
+  template< typename Traits, size_t Arity >
+  inline bool  DaryHeap<Traits,Arity>::empty () const
+  { return _slots.empty(); }
+
+
+  template< typename Traits, size_t Arity >
+  inline size_t  DaryHeap<Traits,Arity>::size () const
+  { return _slots.size(); }
+
+
+  template< typename Traits, size_t Arity >
+  inline bool  DaryHeap<Traits,Arity>::contains ( uint32_t id ) const
+  {
+    uint32_t index = _traits.getQueueIndex( id );
+    return (index < _slots.size()) and (_slots[index]._id == id);
+  }
+
+
+  template< typename Traits, size_t Arity >
+  inline uint32_t  DaryHeap<Traits,Arity>::top () const
+  { return (_slots.empty()) ? npos : _slots[0]._id; }
+
+
+  template< typename Traits, size_t Arity >
+  inline uint32_t  DaryHeap<Traits,Arity>::operator[] ( size_t index ) const
+  { return _slots[index]._id; }
+
+
+  template< typename Traits, size_t Arity >
+  inline const Traits& DaryHeap<Traits,Arity>::getTraits () const
+  { return _traits; }
+
+
+  template< typename Traits, size_t Arity >
+  inline Traits& DaryHeap<Traits,Arity>::getTraits ()
+  { return _traits; }
+
+
+  template< typename Traits, size_t Arity >
+  inline void  DaryHeap<Traits,Arity>::reserve ( size_t capacity )
+  { _slots.reserve( capacity ); }
+
+
+  template< typename Traits, size_t Arity >
+  inline void  DaryHeap<Traits,Arity>::push ( uint32_t id )
+  {
+    if (contains(id)) { decreaseKey( id ); return; }
+
+    _slots.push_back( Slot() );
+    _place ( _slots.size()-1, Slot{ id, _order++ } );
+    _siftUp( _slots.size()-1 );
+  }
+
+
+  template< typename Traits, size_t Arity >
+  inline void  DaryHeap<Traits,Arity>::decreaseKey ( uint32_t id )
+  {
+    uint32_t index = _traits.getQueueIndex( id );
+    _slots[index]._order = _order++;
+    _siftUp  ( index );
+    _siftDown( _traits.getQueueIndex(id) );
+  }
+
+
+  template< typename Traits, size_t Arity >
+  inline void  DaryHeap<Traits,Arity>::erase ( uint32_t id )
+  {
+    if (not contains(id)) return;
+
+    size_t index = _traits.getQueueIndex( id );
+    size_t last  = _slots.size() - 1;
+    _traits.setQueueIndex( id, npos );
+    if (index != last) {
+      _place( index, _slots[last] );
+      _slots.pop_back();
+      _siftUp  ( index );
+      _siftDown( _traits.getQueueIndex(_slots[index]._id) );
+    } else
+      _slots.pop_back();
+  }
+
+
+  template< typename Traits, size_t Arity >
+  inline void  DaryHeap<Traits,Arity>::pop ()
+  {
+    if (_slots.empty()) return;
+
+    _traits.setQueueIndex( _slots[0]._id, npos );
+    if (_slots.size() > 1) {
+      _place( 0, _slots.back() );
+      _slots.pop_back();
+      _siftDown( 0 );
+    } else
+      _slots.pop_back();
+  }
+
+
+  template< typename Traits, size_t Arity >
+  inline void  DaryHeap<Traits,Arity>::clear ()
+  {
+    for ( Slot& slot : _slots ) _traits.setQueueIndex( slot._id, npos );
+    _slots.clear();
+    _order = 0;
+  }
+
+
+  template< typename Traits, size_t Arity >
+  inline bool  DaryHeap<Traits,Arity>::_less ( const Slot& lhs, const Slot& rhs ) const
+  {
+    if (_traits(lhs._id,rhs._id)) return true;
+    if (_traits(rhs._id,lhs._id)) return false;
+    return lhs._order < rhs._order;
+  }
+
+
+  template< typename Traits, size_t Arity >
+  inline void  DaryHeap<Traits,Arity>::_place ( size_t index, const Slot& slot )
+  {
+    _slots[index] = slot;
+    _traits.setQueueIndex( slot._id, index );
+  }
+
+
+  template< typename Traits, size_t Arity >
+  inline void  DaryHeap<Traits,Arity>::_siftUp ( size_t index )
+  {
+    Slot slot = _slots[index];
+    while ( index > 0 ) {
+      size_t parent = (index-1) / Arity;
+      if (not _less(slot,_slots[parent])) break;
+      _place( index, _slots[parent] );
+      index = parent;
+    }
+    _place( index, slot );
+  }
+
+
+  template< typename Traits, size_t Arity >
+  inline void  DaryHeap<Traits,Arity>::_siftDown ( size_t index )
+  {
+    Slot   slot = _slots[index];
+    size_t size = _slots.size();
+    while ( true ) {
+      size_t first = index*Arity + 1;
+      if (first >= size) break;
+
+      size_t best = first;
+      size_t last = std::min( first+Arity, size );
+      for ( size_t child=first+1 ; child<last ; ++child ) {
+        if (_less(_slots[child],_slots[best])) best = child;
+      }
+      if (not _less(_slots[best],slot)) break;
+      _place( index, _slots[best] );
+      index = best;
+    }
+    _place( index, slot );
+  }
+
+
+}  // Anabatic namespace.
@@ -16,6 +16,7 @@
 
 #pragma  once
 #include <set>
+#include <cmath>
 #include <iomanip>
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/ordered_index.hpp>
@@ -28,6 +29,8 @@ namespace Hurricane {
   class RoutingPad;
 }
 #include "anabatic/GCell.h"
+#include "anabatic/DaryHeap.h"
+#include "anabatic/VertexStates.h"
 
 
 namespace Anabatic {
@@ -203,7 +206,7 @@ namespace Anabatic {
       static         void            notify            ( Vertex*, unsigned flags );
       static inline  Vertex*         lookup            ( GCell* );
     public:                                            
-             inline                  Vertex            ( GCell* );
+             inline                  Vertex            ( GCell*, uint32_t index );
            //inline                  Vertex            ( size_t id );
              inline                 ~Vertex            ();
              inline  bool            isDriver          () const;
@@ -211,24 +214,30 @@ namespace Anabatic {
              inline  bool            hasDoneAllRps     () const;
              inline  Contact*        hasGContact       ( Net* ) const;
              inline  unsigned int    getId             () const;
+             inline  uint32_t        getIndex          () const;
+             inline  VertexStates*   getStates         () const;
              inline  GCell*          getGCell          () const;
              inline  Box             getBoundingBox    () const;
              inline  Edges           getEdges          ( Flags sides=Flags::AllSides ) const;
              inline  AnabaticEngine* getAnabatic       () const;
              inline  Contact*        getGContact       ( Net* );
-                     bool            hasValidStamp     () const;
+             inline  bool            hasValidStamp     () const;
              inline  Point           getCenter         () const;
              inline  DbU::Unit       getDistance       () const;
+             inline  DbU::Unit       getEstimate       () const;
+             inline  DbU::Unit       getKey            () const;
              inline  int             getStamp          () const;
              inline  int             getBranchId       () const;
              inline  int             getConnexId       () const;
              inline  int             getDegree         () const;
              inline  int             getRpCount        () const;
-                     Edge*           getFrom           () const;
+             inline  uint32_t        getQueueIndex     () const;
+             inline  Edge*           getFrom           () const;
              inline  Vertex*         getPredecessor    () const;
              inline  Vertex*         getNeighbor       ( Edge* ) const;
              inline  void            setDriver         ( bool state );
              inline  void            setDistance       ( DbU::Unit );
+             inline  void            setEstimate       ( DbU::Unit );
              inline  void            setStamp          ( int );
              inline  void            setConnexId       ( int );
              inline  void            setBranchId       ( int );
@@ -236,6 +245,7 @@ namespace Anabatic {
              inline  void            incDegree         ( int delta=1 );
              inline  void            setRpCount        ( int );
              inline  void            incRpCount        ( int delta=1 );
+             inline  void            setQueueIndex     ( uint32_t );
              inline  void            setFrom           ( Edge* );
              inline  void            add               ( RoutingPad* );
              inline  void            clearRps          ();
@@ -305,34 +315,23 @@ namespace Anabatic {
     private:                        
                                      Vertex            ( const Vertex& );
                      Vertex&         operator=         ( const Vertex& );
+                     VertexStates*   _getDefaultStates () const;
     private:
+    // The per-search (hot) data lives in the VertexStates, at <_index>.
       size_t               _id;
       GCell*               _gcell;
       Observer<Vertex>     _observer;
-      int                  _connexId;
-      int                  _branchId;
-      int                  _degree  : 8;
-
-      int                  _rpCount : 8;
-      int                  _stamp;
-      DbU::Unit            _distance;
-      Edge*                _from;
+      uint32_t             _index;
       uint32_t             _flags;
       GRAData*             _adata;
   }; 
 
 
-  inline Vertex::Vertex ( GCell* gcell )
+  inline Vertex::Vertex ( GCell* gcell, uint32_t index )
     : _id      (gcell->getId())
     , _gcell   (gcell)
     , _observer(this)
-    , _connexId(-1)
-    , _branchId( 0)
-    , _degree  ( 0)
-    , _rpCount ( 0)
-    , _stamp   (-1)
-    , _distance(unreached)
-    , _from    (NULL)
+    , _index   (index)
     , _flags   (NoRestriction)
     , _adata   (NULL)
   {
@@ -349,30 +348,41 @@ namespace Anabatic {
   inline Edges           Vertex::getEdges       ( Flags sides ) const { return _gcell->getEdges(sides); }
   inline Contact*        Vertex::hasGContact    ( Net* net ) const { return _gcell->hasGContact(net); }
   inline unsigned int    Vertex::getId          () const { return _id; }
+  inline uint32_t        Vertex::getIndex       () const { return _index; }
+  inline VertexStates*   Vertex::getStates      () const { VertexStates* states = VertexStates::getBound(); return (states) ? states : _getDefaultStates(); }
+  inline bool            Vertex::hasValidStamp  () const { return getStates()->isValid(_index); }
   inline GCell*          Vertex::getGCell       () const { return _gcell; }
   inline AnabaticEngine* Vertex::getAnabatic    () const { return _gcell->getAnabatic(); }
   inline Contact*        Vertex::getGContact    ( Net* net ) { return _gcell->getGContact(net); }
   inline Point           Vertex::getCenter      () const { return _gcell->getBoundingBox().getCenter(); }
-  inline DbU::Unit       Vertex::getDistance    () const { return hasValidStamp() ? _distance : unreached; }
-  inline int             Vertex::getStamp       () const { return _stamp; }
-  inline int             Vertex::getConnexId    () const { return hasValidStamp() ? _connexId : -1; }
-  inline int             Vertex::getBranchId    () const { return hasValidStamp() ? _branchId :  0; }
-  inline int             Vertex::getDegree      () const { return hasValidStamp() ? _degree   :  0; }
-  inline int             Vertex::getRpCount     () const { return hasValidStamp() ? _rpCount  :  0; }
-//inline Edge*           Vertex::getFrom        () const { return _from; }
-  inline void            Vertex::setDistance    ( DbU::Unit distance ) { _distance=distance; }
-  inline void            Vertex::setFrom        ( Edge* from ) { _from=from; }
-  inline void            Vertex::setStamp       ( int stamp ) { _stamp=stamp; }
-  inline void            Vertex::setConnexId    ( int id ) { _connexId=id; }
-  inline void            Vertex::setBranchId    ( int id ) { _branchId=id; }
-  inline void            Vertex::setDegree      ( int degree ) { _degree=degree; }
-  inline void            Vertex::incDegree      ( int delta ) { _degree+=delta; }
-  inline void            Vertex::setRpCount     ( int count ) { _rpCount=count; }
-  inline void            Vertex::incRpCount     ( int delta ) { _rpCount+=delta; }
+  inline DbU::Unit       Vertex::getDistance    () const { VertexStates* s = getStates(); return s->isValid(_index) ? s->getDistance(_index) : unreached; }
+  inline DbU::Unit       Vertex::getEstimate    () const { return getStates()->getEstimate(_index); }
+  inline DbU::Unit       Vertex::getKey         () const { VertexStates* s = getStates(); return s->isValid(_index) ? s->getDistance(_index)+s->getEstimate(_index) : unreached; }
+  inline int             Vertex::getStamp       () const { return getStates()->getStamp(_index); }
+  inline int             Vertex::getConnexId    () const { VertexStates* s = getStates(); return s->isValid(_index) ? s->getConnexId(_index) : -1; }
+  inline int             Vertex::getBranchId    () const { VertexStates* s = getStates(); return s->isValid(_index) ? s->getBranchId(_index) :  0; }
+  inline int             Vertex::getDegree      () const { VertexStates* s = getStates(); return s->isValid(_index) ? s->getDegree  (_index) :  0; }
+  inline int             Vertex::getRpCount     () const { VertexStates* s = getStates(); return s->isValid(_index) ? s->getRpCount (_index) :  0; }
+  inline uint32_t        Vertex::getQueueIndex  () const { return getStates()->getQueueIndex(_index); }
+  inline Edge*           Vertex::getFrom        () const { VertexStates* s = getStates(); return s->isValid(_index) ? s->getFrom(_index) : NULL; }
+  inline void            Vertex::setDistance    ( DbU::Unit distance ) { getStates()->setDistance(_index,distance); }
+  inline void            Vertex::setEstimate    ( DbU::Unit estimate ) { getStates()->setEstimate(_index,estimate); }
+  inline void            Vertex::setFrom        ( Edge* from ) { getStates()->setFrom(_index,from); }
+  inline void            Vertex::setStamp       ( int stamp ) { getStates()->setStamp(_index,stamp); }
+  inline void            Vertex::setConnexId    ( int id ) { getStates()->setConnexId(_index,id); }
+  inline void            Vertex::setBranchId    ( int id ) { getStates()->setBranchId(_index,id); }
+  inline void            Vertex::setDegree      ( int degree ) { getStates()->setDegree(_index,degree); }
+  inline void            Vertex::incDegree      ( int delta ) { VertexStates* s = getStates(); s->setDegree(_index,s->getDegree(_index)+delta); }
+  inline void            Vertex::setRpCount     ( int count ) { getStates()->setRpCount(_index,count); }
+  inline void            Vertex::incRpCount     ( int delta ) { VertexStates* s = getStates(); s->setRpCount(_index,s->getRpCount(_index)+delta); }
+  inline void            Vertex::setQueueIndex  ( uint32_t index ) { getStates()->setQueueIndex(_index,index); }
   inline Contact*        Vertex::breakGoThrough ( Net* net ) { return _gcell->breakGoThrough(net); }
 
   inline Vertex* Vertex::getPredecessor () const
-  { return (hasValidStamp() and _from) ? _from->getOpposite(_gcell)->getObserver<Vertex>(GCell::Observable::Vertex) : NULL; }
+  {
+    Edge* from = getFrom();
+    return (from) ? from->getOpposite(_gcell)->getObserver<Vertex>(GCell::Observable::Vertex) : NULL;
+  }
 
   inline Vertex* Vertex::getNeighbor ( Edge* edge ) const
   {
@@ -524,6 +534,8 @@ namespace Anabatic {
     public:
       inline                PriorityQueue ();
       inline               ~PriorityQueue ();
+                            PriorityQueue ( const PriorityQueue& ) = delete;
+             PriorityQueue& operator=     ( const PriorityQueue& ) = delete;
       inline        bool    empty         () const;
       inline        size_t  size          () const;
       inline        void    push          ( Vertex* );
@@ -536,13 +548,14 @@ namespace Anabatic {
       inline  const Point&  getAttractor  () const;
       inline        bool    hasAttractor  () const;
     private:
+    // The comparison functor keeps a pointer to it's own queue (and not
+    // a static one) so multiple Dijkstra can run concurrently.
       class CompareByDistance {
         public:
-                 inline      CompareByDistance ();
+                 inline      CompareByDistance ( const PriorityQueue* );
                         bool operator()        ( const Vertex* lhs, const Vertex* rhs ) const;
-          static inline void setQueue          ( PriorityQueue* );
         private:
-          static PriorityQueue* _pqueue;
+          const PriorityQueue* _pqueue;
       };
     private:
       bool                                 _hasAttractor;
@@ -551,12 +564,10 @@ namespace Anabatic {
   };
 
 
-  inline      PriorityQueue::CompareByDistance::CompareByDistance () { }
+  inline      PriorityQueue::CompareByDistance::CompareByDistance ( const PriorityQueue* pqueue ) : _pqueue(pqueue) { }
 
-  inline void PriorityQueue::CompareByDistance::setQueue ( PriorityQueue* pqueue ) { _pqueue = pqueue; }
 
-
-  inline               PriorityQueue::PriorityQueue  () : _hasAttractor(false), _attractor(), _queue() { PriorityQueue::CompareByDistance::setQueue(this); }
+  inline               PriorityQueue::PriorityQueue  () : _hasAttractor(false), _attractor(), _queue(CompareByDistance(this)) { }
   inline               PriorityQueue::~PriorityQueue () { }
   inline       bool    PriorityQueue::empty          () const { return _queue.empty(); }
   inline       size_t  PriorityQueue::size           () const { return _queue.size(); }
@@ -612,6 +623,160 @@ namespace Anabatic {
   }
 
 
+// -------------------------------------------------------------------
+// Class  :  "Anabatic::PriorityHeap".
+//
+// Same interface and ordering as PriorityQueue, but built upon an
+// indexed 4-ary heap of dense Vertex indexes. The keys and the heap
+// positions are read directly from the VertexStates of the Dijkstra
+// (see setStates()), the Vertex objects are only looked up to break
+// ties with the attractor. No allocation per operation, erase() and
+// decreaseKey() in O(log n). Pushing an already queued Vertex (after
+// lowering it's distance) is a decreaseKey().
+
+  class PriorityHeap {
+    private:
+      class Traits {
+        public:
+          inline           Traits        ( const PriorityHeap* );
+          inline bool      operator()    ( uint32_t lhs, uint32_t rhs ) const;
+          inline uint32_t  getQueueIndex ( uint32_t ) const;
+          inline void      setQueueIndex ( uint32_t, uint32_t ) const;
+        private:
+          const PriorityHeap* _pqueue;
+      };
+    public:
+      inline                PriorityHeap  ();
+                           ~PriorityHeap  ();
+                            PriorityHeap  ( const PriorityHeap& ) = delete;
+             PriorityHeap&  operator=     ( const PriorityHeap& ) = delete;
+      inline        void    setStates     ( const vector<Vertex*>*, VertexStates* );
+      inline        bool    empty         () const;
+      inline        size_t  size          () const;
+      inline        void    push          ( Vertex* );
+      inline        void    decreaseKey   ( Vertex* );
+      inline        void    erase         ( Vertex* );
+      inline        Vertex* top           ();
+      inline        void    pop           ();
+      inline        void    clear         ();
+      inline        void    dump          () const;
+      inline        void    setAttractor  ( const Point& );
+      inline  const Point&  getAttractor  () const;
+      inline        bool    hasAttractor  () const;
+                    void    openTrace     ( const std::string& path );
+    private:                              
+      inline        DbU::Unit  _getKey      ( uint32_t ) const;
+      inline        int        _getBranchId ( uint32_t ) const;
+                    void       _trace       ( char op, uint32_t ) const;
+    private:
+      const vector<Vertex*>*  _vertexes;
+      VertexStates*           _states;
+      bool                    _hasAttractor;
+      Point                   _attractor;
+      DaryHeap<Traits>        _heap;
+      std::ostream*           _traceStream;
+  };
+
+
+  inline           PriorityHeap::Traits::Traits ( const PriorityHeap* pqueue ) : _pqueue(pqueue) { }
+  inline uint32_t  PriorityHeap::Traits::getQueueIndex ( uint32_t i ) const { return _pqueue->_states->getQueueIndex(i); }
+  inline void      PriorityHeap::Traits::setQueueIndex ( uint32_t i, uint32_t index ) const { _pqueue->_states->setQueueIndex(i,index); }
+
+  inline bool  PriorityHeap::Traits::operator() ( uint32_t lhs, uint32_t rhs ) const
+  {
+    DbU::Unit lhsKey = _pqueue->_getKey( lhs );
+    DbU::Unit rhsKey = _pqueue->_getKey( rhs );
+    if (lhsKey == rhsKey) {
+      if (_pqueue->hasAttractor()) {
+        DbU::Unit lhsDistance = _pqueue->getAttractor().manhattanDistance( (*_pqueue->_vertexes)[lhs]->getCenter() );
+        DbU::Unit rhsDistance = _pqueue->getAttractor().manhattanDistance( (*_pqueue->_vertexes)[rhs]->getCenter() );
+        if (lhsDistance != rhsDistance) return lhsDistance < rhsDistance;
+      }
+      return _pqueue->_getBranchId(lhs) > _pqueue->_getBranchId(rhs);
+    }
+    return lhsKey < rhsKey;
+  }
+
+
+  inline               PriorityHeap::PriorityHeap  () : _vertexes(NULL), _states(NULL), _hasAttractor(false), _attractor(), _heap(Traits(this)), _traceStream(NULL) { }
+  inline       void    PriorityHeap::setStates     ( const vector<Vertex*>* vertexes, VertexStates* states ) { _vertexes=vertexes; _states=states; }
+  inline       bool    PriorityHeap::empty         () const { return _heap.empty(); }
+  inline       size_t  PriorityHeap::size          () const { return _heap.size(); }
+  inline       Vertex* PriorityHeap::top           () { return (_heap.empty()) ? NULL : (*_vertexes)[ _heap.top() ]; }
+  inline       void    PriorityHeap::setAttractor  ( const Point& p ) { _attractor=p;  _hasAttractor=true; }
+  inline       bool    PriorityHeap::hasAttractor  () const { return _hasAttractor; }
+  inline const Point&  PriorityHeap::getAttractor  () const { return _attractor; }
+
+  inline DbU::Unit  PriorityHeap::_getKey ( uint32_t i ) const
+  { return (_states->isValid(i)) ? _states->getDistance(i)+_states->getEstimate(i) : Vertex::unreached; }
+
+  inline int  PriorityHeap::_getBranchId ( uint32_t i ) const
+  { return (_states->isValid(i)) ? _states->getBranchId(i) : 0; }
+
+  inline void  PriorityHeap::push ( Vertex* v )
+  {
+    uint32_t i = v->getIndex();
+    if (_traceStream) _trace( (_heap.contains(i) ? 'd' : 'p'), i );
+    _heap.push( i );
+  }
+
+  inline void  PriorityHeap::decreaseKey ( Vertex* v )
+  {
+    uint32_t i = v->getIndex();
+    if (not _heap.contains(i)) { push( v ); return; }
+    if (_traceStream) _trace( 'd', i );
+    _heap.decreaseKey( i );
+  }
+
+  inline void  PriorityHeap::erase ( Vertex* v )
+  {
+    uint32_t i = v->getIndex();
+    if (not _heap.contains(i)) return;
+    if (_traceStream) _trace( 'e', i );
+    _heap.erase( i );
+  }
+
+  inline void  PriorityHeap::pop ()
+  {
+    if (_heap.empty()) return;
+    cdebug_log(112,0) << "Pop: (size:" << _heap.size() << ") " << (*_vertexes)[_heap.top()] << std::endl;
+    if (_traceStream) _trace( 'o', _heap.top() );
+    _heap.pop();
+  }
+
+  inline void  PriorityHeap::clear ()
+  {
+    if (_traceStream and not _heap.empty()) _trace( 'c', DaryHeap<Traits>::npos );
+    _heap.clear();
+    _hasAttractor = false;
+  }
+
+  inline void  PriorityHeap::dump () const
+  {
+    if (cdebug.enabled(112)) {
+      cdebug_log(112,1) << "PriorityHeap::dump() size:" << size() << std::endl;
+      for ( size_t i=0 ; i<_heap.size() ; ++i )
+        cdebug_log(112,0) << "[" << tsetw(3) << i << "] " << (*_vertexes)[_heap[i]] << std::endl;
+      cdebug_tabw(112,-1);
+    }
+  }
+
+
+// -------------------------------------------------------------------
+// Type  :  "Anabatic::DijkstraQueue".
+//
+// The queue actually used by Dijkstra, selected at build time. The
+// multiset based one is kept as a reference (meson option
+// "anabatic-multiset-queue"). Both process the Vertexes in the very
+// same order.
+
+#if defined(ANABATIC_MULTISET_QUEUE)
+  typedef  PriorityQueue  DijkstraQueue;
+#else
+  typedef  PriorityHeap   DijkstraQueue;
+#endif
+
+
 // -------------------------------------------------------------------
 // Class  :  "Anabatic::Dijkstra".
 
@@ -624,6 +789,7 @@ namespace Anabatic {
                     , Standart   = (1<<0)
                     , Monotonic  = (1<<1)
                     , AxisTarget = (1<<2)
+                    , AStar      = (1<<3)
                     };
         public:
           inline               Mode         ( Flag flags=NoMode );
@@ -636,20 +802,28 @@ namespace Anabatic {
       typedef std::function<DbU::Unit(const Vertex*,const Vertex*,const Edge*)>  distance_t;
     public:
                               Dijkstra                 ( AnabaticEngine* );
+                              Dijkstra                 ( Dijkstra* master, size_t slot=0 );
                              ~Dijkstra                 ();
     public:                                            
+      inline       bool       isWorker                 () const;
       inline       bool       isBipoint                () const;
       inline       bool       isSourceVertex           ( Vertex* ) const;
       inline       Net*       getNet                   () const;
       inline       bool       isTargetVertex           ( Vertex* ) const;
+      inline       VertexStates* getStates             () const;
                    DbU::Unit  getAntennaGateMaxWL      () const;
       inline       DbU::Unit  getSearchAreaHalo        () const;
+      inline const Box&       getSearchArea            () const;
+      inline       size_t     getExpandedCount         () const;
       template<typename DistanceT>                     
       inline       DistanceT* setDistance              ( DistanceT );
       inline       void       setSearchAreaHalo        ( DbU::Unit );
+      inline       void       setAStarCost             ( float unitCost, DbU::Unit minStep );
                    void       load                     ( Net* net ); 
                    void       loadFixedGlobal          ( Net* net ); 
                    void       run                      ( Mode mode=Mode::Standart );
+                   bool       search                   ( Mode mode=Mode::Standart );
+                   void       commit                   ();
       inline const VertexSet& getSources               () const;
     private:                                           
                                Dijkstra                ( const Dijkstra& );
@@ -658,6 +832,13 @@ namespace Anabatic {
                    Point      _getPonderedPoint        () const;
                    void       _cleanup                 ();
                    bool       _propagate               ( Flags enabledSides );
+      inline       void       _push                    ( Vertex* );
+      inline       DbU::Unit  _getDistance             ( uint32_t ) const;
+      inline       int        _getConnexId             ( uint32_t ) const;
+      inline       int        _getBranchId             ( uint32_t ) const;
+      inline       Edge*      _getFrom                 ( uint32_t ) const;
+                   void       _updateTargetsArea       ();
+      inline       DbU::Unit  _getEstimate             ( const Vertex* ) const;
                    void       _traceback               ( Vertex* );
                    void       _materialize             ();
                    void       _selectFirstSource       ();
@@ -685,7 +866,9 @@ namespace Anabatic {
                    void       _updateRealOccupancy     ( Vertex* );
     private:
       AnabaticEngine*  _anabatic;
+      Dijkstra*        _master;
       vector<Vertex*>  _vertexes;
+      VertexStates*    _states;
       distance_t       _distanceCb;
       Mode             _mode;
       Net*             _net;
@@ -695,20 +878,36 @@ namespace Anabatic {
       Box              _searchArea;
       DbU::Unit        _searchAreaHalo;
       int              _connectedsId;
-      PriorityQueue    _queue;
+      DijkstraQueue    _queue;
       Flags            _flags;
+      double           _aStarCost;
+      Box              _targetsArea;
+      size_t           _expandeds;
   };
 
 
   inline Dijkstra::Mode::Mode ( Dijkstra::Mode::Flag flags ) : BaseFlags(flags) { }
   inline Dijkstra::Mode::Mode ( BaseFlags            base  ) : BaseFlags(base)  { }
 
+  inline bool       Dijkstra::isWorker          () const { return (_master != NULL); }
   inline bool       Dijkstra::isBipoint         () const { return _net and (_targets.size()+_sources.size() == 2); }
   inline bool       Dijkstra::isSourceVertex    ( Vertex* v ) const { return (_sources.find(v) != _sources.end()); }
   inline bool       Dijkstra::isTargetVertex    ( Vertex* v ) const { return (_targets.find(v) != _targets.end()); }
   inline Net*       Dijkstra::getNet            () const { return _net; }
+  inline VertexStates* Dijkstra::getStates      () const { return _states; }
   inline DbU::Unit  Dijkstra::getSearchAreaHalo () const { return _searchAreaHalo; }
+  inline const Box& Dijkstra::getSearchArea     () const { return _searchArea; }
+  inline size_t     Dijkstra::getExpandedCount  () const { return _expandeds; }
   inline void       Dijkstra::setSearchAreaHalo ( DbU::Unit halo ) { _searchAreaHalo = halo; }
+  inline void  Dijkstra::setAStarCost ( float unitCost, DbU::Unit minStep )
+  {
+  // The distance callback computes in float and truncates to DbU::Unit
+  // on each step, so the accumulated distance may be below unitCost times
+  // the length: up to one unit per step (at most length/minStep steps),
+  // plus the float rounding. The later is absorbed by scaling down by 1%.
+    _aStarCost = 0.99 * (double)unitCost - 1.0 / (double)std::max( minStep, (DbU::Unit)1 );
+    if (_aStarCost < 0.0) _aStarCost = 0.0;
+  }
 
   template<typename DistanceT>
   inline DistanceT* Dijkstra::setDistance       ( DistanceT cb ) { _distanceCb = cb; return _distanceCb.target<DistanceT>(); }
@@ -718,6 +917,43 @@ namespace Anabatic {
   inline void       Dijkstra::unsetFlags     ( Flags mask ) { _flags &= ~mask; }
   inline const VertexSet& Dijkstra::getSources     () const { return _sources; }
 
+
+  inline DbU::Unit  Dijkstra::_getEstimate ( const Vertex* v ) const
+  {
+  // Admissible lower bound of the remaining distance: the Manhattan
+  // distance to the bounding box of the targets, weighted by the smallest
+  // cost per unit of length the distance callback can give *on either
+  // axis*, see setAStarCost(). Rounded down. This holds only if the
+  // callback never charges less than that per unit of Manhattan length,
+  // the caller must not select AStar otherwise.
+    if (not (_mode & Mode::AStar) or _targetsArea.isEmpty()) return 0;
+
+    Point     center = v->getCenter();
+    DbU::Unit dx     = 0;
+    DbU::Unit dy     = 0;
+    if      (center.getX() < _targetsArea.getXMin()) dx = _targetsArea.getXMin() - center.getX();
+    else if (center.getX() > _targetsArea.getXMax()) dx = center.getX() - _targetsArea.getXMax();
+    if      (center.getY() < _targetsArea.getYMin()) dy = _targetsArea.getYMin() - center.getY();
+    else if (center.getY() > _targetsArea.getYMax()) dy = center.getY() - _targetsArea.getYMax();
+
+    return (DbU::Unit)std::floor( _aStarCost*(double)(dx + dy) );
+  }
+
+
+  inline void  Dijkstra::_push ( Vertex* v )
+  {
+    _states->setEstimate( v->getIndex(), _getEstimate(v) );
+    _queue.push( v );
+  }
+
+
+// Direct accesses to the search state of the Vertex at a dense index,
+// same semantic as the Vertex accessors (stale states read as unset).
+  inline DbU::Unit  Dijkstra::_getDistance ( uint32_t i ) const { return (_states->isValid(i)) ? _states->getDistance(i) : Vertex::unreached; }
+  inline int        Dijkstra::_getConnexId ( uint32_t i ) const { return (_states->isValid(i)) ? _states->getConnexId(i) : -1; }
+  inline int        Dijkstra::_getBranchId ( uint32_t i ) const { return (_states->isValid(i)) ? _states->getBranchId(i) :  0; }
+  inline Edge*      Dijkstra::_getFrom     ( uint32_t i ) const { return (_states->isValid(i)) ? _states->getFrom    (i) : NULL; }
+
 }  // Anabatic namespace.
 
 
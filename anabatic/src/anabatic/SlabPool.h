@@ -0,0 +1,148 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |         A n a b a t i c  -  Routing Toolbox                     |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./anabatic/SlabPool.h"                         |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include <cstddef>
+#include <new>
+#include <vector>
+
+
+namespace Anabatic {
+
+
+// -------------------------------------------------------------------
+// Class  :  "Anabatic::SlabPool".
+//
+// Storage for the objects of one class T, in slabs of SlabSize slots,
+// meant to back the class-level operator new/delete of the routing
+// objects created by the millions (AutoSegments, AutoContacts,
+// TrackSegments). Objects of the same type are thus packed together,
+// freed slots are recycled through a free list threaded in their own
+// storage, and the slabs are all given back at once by clear(), once
+// no object remains (engine gutting).
+//
+// A request whose size is not sizeof(T) (a derived class without it's
+// own pool) is forwarded to the global operator new.
+//
+// Not thread safe: the routing objects are created and destroyed under
+// the Session, which is sequential.
+
+  template< typename T, size_t SlabSize=1024 >
+  class SlabPool {
+    public:
+      inline         SlabPool      ();
+      inline        ~SlabPool      ();
+      inline void*   allocate      ( size_t );
+      inline void    release       ( void*, size_t );
+      inline bool    clear         ();
+      inline size_t  getAllocateds () const;
+      inline size_t  getReserved   () const;
+      inline size_t  getPeak       () const;
+    private:
+      union Slot {
+        Slot*  _next;
+        alignas(T) unsigned char  _storage[ sizeof(T) ];
+      };
+    private:
+                     SlabPool      ( const SlabPool& ) = delete;
+      SlabPool&      operator=     ( const SlabPool& ) = delete;
+    private:
+      std::vector<Slot*>  _slabs;
+      Slot*               _freeList;
+      size_t              _used;
+      size_t              _allocateds;
+      size_t              _peak;
+  };
+
+
+  template< typename T, size_t SlabSize >
+  inline SlabPool<T,SlabSize>::SlabPool ()
+    : _slabs     ()
+    , _freeList  (NULL)
+    , _used      (SlabSize)
+    , _allocateds(0)
+    , _peak      (0)
+  { }
+
+
+  template< typename T, size_t SlabSize >
+  inline SlabPool<T,SlabSize>::~SlabPool ()
+  {
+    for ( Slot* slab : _slabs ) delete [] slab;
+  }
+
+
+  template< typename T, size_t SlabSize >
+  inline size_t  SlabPool<T,SlabSize>::getAllocateds () const
+  { return _allocateds; }
+
+
+  template< typename T, size_t SlabSize >
+  inline size_t  SlabPool<T,SlabSize>::getReserved () const
+  { return _slabs.size() * SlabSize * sizeof(Slot); }
+
+
+  template< typename T, size_t SlabSize >
+  inline size_t  SlabPool<T,SlabSize>::getPeak () const
+  { return _peak; }
+
+
+  template< typename T, size_t SlabSize >
+  inline void* SlabPool<T,SlabSize>::allocate ( size_t size )
+  {
+    if (size != sizeof(T)) return ::operator new( size );
+
+    ++_allocateds;
+    if (_freeList) {
+      Slot* slot = _freeList;
+      _freeList  = slot->_next;
+      return slot;
+    }
+    if (_used == SlabSize) {
+      _slabs.push_back( new Slot [SlabSize] );
+      _used = 0;
+      if (getReserved() > _peak) _peak = getReserved();
+    }
+    return &(_slabs.back()[ _used++ ]);
+  }
+
+
+  template< typename T, size_t SlabSize >
+  inline void  SlabPool<T,SlabSize>::release ( void* storage, size_t size )
+  {
+    if (not storage) return;
+    if (size != sizeof(T)) { ::operator delete( storage ); return; }
+
+    Slot* slot  = static_cast<Slot*>( storage );
+    slot->_next = _freeList;
+    _freeList   = slot;
+    --_allocateds;
+  }
+
+
+  template< typename T, size_t SlabSize >
+  inline bool  SlabPool<T,SlabSize>::clear ()
+  {
+    if (_allocateds) return false;
+    for ( Slot* slab : _slabs ) delete [] slab;
+    _slabs.clear();
+    _freeList = NULL;
+    _used     = SlabSize;
+    return true;
+  }
+
+
+}  // Anabatic namespace.
@@ -0,0 +1,178 @@
+// -*- mode: C++; explicit-buffer-name: "VertexStates.h<anabatic>" -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |     A n a b a t i c  -  Global Routing Toolbox                  |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./anabatic/VertexStates.h"                     |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include "hurricane/DbU.h"
+
+
+namespace Anabatic {
+
+  using Hurricane::DbU;
+  class Edge;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Anabatic::VertexStates".
+//
+// The per-search state of the Dijkstra Vertexes, stored as a structure
+// of arrays indexed by the dense Vertex index (it's rank in the GCell
+// vector of the AnabaticEngine). The hot loop of the search then walks
+// a handful of contiguous arrays instead of Vertex objects scattered
+// on the heap.
+//
+// A state is valid only if it's stamp matches the current generation.
+// Starting a new search is just incrementing the generation, no pass
+// over the arrays is needed (except on the rare wrap-around).
+//
+// The AnabaticEngine owns one VertexStates per slot. A Dijkstra is
+// given a slot when it is created and works directly on those arrays,
+// so each thread can own one. The Vertex only keeps it's dense index
+// and the cold data (GCell, restrictions & analog intervals).
+//
+// The Vertex accessors (used by the distance callbacks and the cold
+// parts of the search) reach the arrays bound to the calling thread,
+// see Bind. When none is bound, they fall back on slot 0.
+
+  class VertexStates {
+    public:
+      static constexpr uint32_t  npos = std::numeric_limits<uint32_t>::max();
+    public:
+      class Bind {
+        public:
+          inline  Bind  ( VertexStates* );
+          inline ~Bind  ();
+                  Bind  ( const Bind& ) = delete;
+          Bind& operator= ( const Bind& ) = delete;
+        private:
+          VertexStates* _previous;
+      };
+    public:
+      static inline VertexStates* getBound ();
+    public:
+      inline             VertexStates     ();
+      inline size_t      size             () const;
+      inline void        resize           ( size_t );
+      inline int         getGeneration    () const;
+      inline int         incGeneration    ();
+      inline bool        isValid          ( uint32_t ) const;
+      inline int         getStamp         ( uint32_t ) const;
+      inline DbU::Unit   getDistance      ( uint32_t ) const;
+      inline DbU::Unit   getEstimate      ( uint32_t ) const;
+      inline Edge*       getFrom          ( uint32_t ) const;
+      inline int         getConnexId      ( uint32_t ) const;
+      inline int         getBranchId      ( uint32_t ) const;
+      inline int         getDegree        ( uint32_t ) const;
+      inline int         getRpCount       ( uint32_t ) const;
+      inline uint32_t    getQueueIndex    ( uint32_t ) const;
+      inline void        setStamp         ( uint32_t, int );
+      inline void        setDistance      ( uint32_t, DbU::Unit );
+      inline void        setEstimate      ( uint32_t, DbU::Unit );
+      inline void        setFrom          ( uint32_t, Edge* );
+      inline void        setConnexId      ( uint32_t, int );
+      inline void        setBranchId      ( uint32_t, int );
+      inline void        setDegree        ( uint32_t, int );
+      inline void        setRpCount       ( uint32_t, int );
+      inline void        setQueueIndex    ( uint32_t, uint32_t );
+    private:
+                         VertexStates     ( const VertexStates& );
+             VertexStates& operator=      ( const VertexStates& );
+    private:
+      static thread_local VertexStates* _bound;
+    private:
+      int                     _generation;
+      std::vector<int>        _stamps;
+      std::vector<DbU::Unit>  _distances;
+      std::vector<DbU::Unit>  _estimates;
+      std::vector<Edge*>      _froms;
+      std::vector<int>        _connexIds;
+      std::vector<int>        _branchIds;
+      std::vector<int8_t>     _degrees;
+      std::vector<int8_t>     _rpCounts;
+      std::vector<uint32_t>   _queueIndexes;
+  };
+
+
+  inline               VertexStates::Bind::Bind  ( VertexStates* states ) : _previous(_bound) { _bound = states; }
+  inline               VertexStates::Bind::~Bind () { _bound = _previous; }
+  inline VertexStates* VertexStates::getBound    () { return _bound; }
+
+
+  inline VertexStates::VertexStates ()
+    : _generation  (0)
+    , _stamps      ()
+    , _distances   ()
+    , _estimates   ()
+    , _froms       ()
+    , _connexIds   ()
+    , _branchIds   ()
+    , _degrees     ()
+    , _rpCounts    ()
+    , _queueIndexes()
+  { }
+
+
+  inline void  VertexStates::resize ( size_t size )
+  {
+    _stamps      .resize( size, -1 );
+    _distances   .resize( size, 0 );
+    _estimates   .resize( size, 0 );
+    _froms       .resize( size, NULL );
+    _connexIds   .resize( size, -1 );
+    _branchIds   .resize( size, 0 );
+    _degrees     .resize( size, 0 );
+    _rpCounts    .resize( size, 0 );
+    _queueIndexes.resize( size, npos );
+  }
+
+
+  inline int  VertexStates::incGeneration ()
+  {
+    if (_generation == std::numeric_limits<int>::max()) {
+      std::fill( _stamps.begin(), _stamps.end(), -1 );
+      _generation = 0;
+    }
+    return ++_generation;
+  }
+
+
+  inline size_t     VertexStates::size          () const { return _stamps.size(); }
+  inline int        VertexStates::getGeneration () const { return _generation; }
+  inline bool       VertexStates::isValid       ( uint32_t i ) const { return _stamps[i] == _generation; }
+  inline int        VertexStates::getStamp      ( uint32_t i ) const { return _stamps[i]; }
+  inline DbU::Unit  VertexStates::getDistance   ( uint32_t i ) const { return _distances[i]; }
+  inline DbU::Unit  VertexStates::getEstimate   ( uint32_t i ) const { return _estimates[i]; }
+  inline Edge*      VertexStates::getFrom       ( uint32_t i ) const { return _froms[i]; }
+  inline int        VertexStates::getConnexId   ( uint32_t i ) const { return _connexIds[i]; }
+  inline int        VertexStates::getBranchId   ( uint32_t i ) const { return _branchIds[i]; }
+  inline int        VertexStates::getDegree     ( uint32_t i ) const { return _degrees[i]; }
+  inline int        VertexStates::getRpCount    ( uint32_t i ) const { return _rpCounts[i]; }
+  inline uint32_t   VertexStates::getQueueIndex ( uint32_t i ) const { return _queueIndexes[i]; }
+  inline void       VertexStates::setStamp      ( uint32_t i, int       stamp    ) { _stamps[i] = stamp; }
+  inline void       VertexStates::setDistance   ( uint32_t i, DbU::Unit distance ) { _distances[i] = distance; }
+  inline void       VertexStates::setEstimate   ( uint32_t i, DbU::Unit estimate ) { _estimates[i] = estimate; }
+  inline void       VertexStates::setFrom       ( uint32_t i, Edge*     from     ) { _froms[i] = from; }
+  inline void       VertexStates::setConnexId   ( uint32_t i, int       id       ) { _connexIds[i] = id; }
+  inline void       VertexStates::setBranchId   ( uint32_t i, int       id       ) { _branchIds[i] = id; }
+  inline void       VertexStates::setDegree     ( uint32_t i, int       degree   ) { _degrees[i] = degree; }
+  inline void       VertexStates::setRpCount    ( uint32_t i, int       count    ) { _rpCounts[i] = count; }
+  inline void       VertexStates::setQueueIndex ( uint32_t i, uint32_t  index    ) { _queueIndexes[i] = index; }
+
+
+}  // Anabatic namespace.
@@ -26,6 +26,7 @@ Cfg.getParamString    ( 'etesian.feedNames'        ).setString    ( 'tie_x0,rowe
 Cfg.getParamString    ( 'etesian.cell.zero'        ).setString    ( 'zero_x0' )
 Cfg.getParamString    ( 'etesian.cell.one'         ).setString    ( 'one_x0' )
 Cfg.getParamString    ( 'etesian.bloat'            ).setString    ( 'disabled' )
+Cfg.getParamInt       ( 'etesian.threads'          ).setInt       ( 1 )
 
 param = Cfg.getParamEnumerate( 'etesian.effort' )
 param.setInt( 2 )
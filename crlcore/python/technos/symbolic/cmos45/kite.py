@@ -60,7 +60,10 @@ p.addValue( "Boundary", 1 )
 p.addValue( "Density" , 2 )
 
 p = Cfg.getParamBool  ( "katana.useGlobalEstimate"    ); p.setBool  ( False ) 
+p = Cfg.getParamBool  ( "katana.useGlobalAStar"       ); p.setBool  ( False ) 
 p = Cfg.getParamInt   ( "katana.searchHalo"           ); p.setInt   ( 1 ) 
+p = Cfg.getParamInt   ( "katana.globalRouterThreads"  ); p.setInt   ( 1 ); p.setMin(0)
+p = Cfg.getParamInt   ( "katana.powerRailsThreads"    ); p.setInt   ( 1 ); p.setMin(0)
 p = Cfg.getParamInt   ( "katana.hTracksReservedLocal" ); p.setInt   ( 3       ); p.setMin(0); p.setMax(20)
 p = Cfg.getParamInt   ( "katana.vTracksReservedLocal" ); p.setInt   ( 3       ); p.setMin(0); p.setMax(20)
 p = Cfg.getParamInt   ( "katana.termSatReservedLocal" ); p.setInt   ( 8       ) 
@@ -15,6 +15,7 @@
 
 #pragma  once
 #include <string>
+#include <set>
 
 
 namespace Hurricane {
@@ -31,20 +32,26 @@ namespace CRL {
 
   class Gds {
     public:
-      static const uint32_t     NoGdsPrefix        = (1<<0);
-      static const uint32_t     Layer_0_IsBoundary = (1<<1);
-      static const uint32_t     NoBlockages        = (1<<2);
-      static       std::string  _topCellName;
+      static const uint32_t               NoGdsPrefix        = (1<<0);
+      static const uint32_t               Layer_0_IsBoundary = (1<<1);
+      static const uint32_t               NoBlockages        = (1<<2);
+      static       std::string            _topCellName;
+      static       std::set<std::string>  _layersFilter;
     public:
-             static bool         save           ( Cell* );
-             static bool         load           ( Library*, std::string gdsPath, uint32_t flags=0 );
-      inline static void         setTopCellName ( std::string );
-      inline static std::string  getTopCellName ();
+             static bool                          save            ( Cell* );
+             static bool                          load            ( Library*, std::string gdsPath, uint32_t flags=0 );
+      inline static void                          setTopCellName  ( std::string );
+      inline static std::string                   getTopCellName  ();
+      inline static void                          setLayersFilter ( const std::set<std::string>& );
+      inline static const std::set<std::string>&  getLayersFilter ();
   };
 
   
   inline void         Gds::setTopCellName ( std::string topCellName ) { _topCellName=topCellName; }
   inline std::string  Gds::getTopCellName () { return _topCellName; }
 
+  inline void                          Gds::setLayersFilter ( const std::set<std::string>& layers ) { _layersFilter=layers; }
+  inline const std::set<std::string>&  Gds::getLayersFilter () { return _layersFilter; }
+
 
 } // CRL namespace.
@@ -3,7 +3,7 @@
 // This file is part of the Coriolis Software.
 // Copyright (c) Sorbonne Université 2018-2021, All Rights Reserved
 //
-// +-----------------------------------------------------------------+ 
+// +-----------------------------------------------------------------+
 // |                   C O R I O L I S                               |
 // |            G D S I I / Hurricane  Interface                     |
 // |                                                                 |
@@ -15,15 +15,22 @@
 
 
 #include <ctime>
+#include <cmath>
 #include <cstdio>
+#include <cstdarg>
 #include <string>
 #include <bitset>
 #include <sstream>
-#include <fstream>
 #include <algorithm>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
+#include <set>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <zlib.h>
 using namespace std;
 
 #include "hurricane/configuration/Configuration.h"
@@ -45,6 +52,7 @@ using namespace std;
 #include "hurricane/Instance.h"
 #include "hurricane/NetExternalComponents.h"
 #include "hurricane/UpdateSession.h"
+#include "hurricane/ThreadPool.h"
 using namespace Hurricane;
 
 #include "crlcore/Utilities.h"
@@ -59,6 +67,10 @@ namespace {
 
 // -------------------------------------------------------------------
 // Class  :  "::GdsRecord".
+//
+// One record, decoded straight from the memory image of the file. The
+// record is bound checked against the end of the range being read, a
+// truncated or corrupted one is returned as an EndOfStream record.
 
   class GdsRecord {
     public:
@@ -129,66 +141,70 @@ namespace {
       static const uint16_t  LIBDIRSIZE      = 0x3900 | TwoByteInteger;
       static const uint16_t  SRFNAME         = 0x3a00 | String;
       static const uint16_t  LIBSECUR        = 0x3b00 | TwoByteInteger;
+      static const uint16_t  EndOfStream     = 0xffff;                   // Reader only.
     public:
                                      GdsRecord      ();
-      inline       bool              isHEADER       () const;   
-      inline       bool              isBGNLIB       () const;   
-      inline       bool              isLIBNAME      () const;   
-      inline       bool              isUNITS        () const;   
-      inline       bool              isENDLIB       () const;   
-      inline       bool              isBGNSTR       () const;   
-      inline       bool              isSTRNAME      () const;   
-      inline       bool              isENDSTR       () const;   
-      inline       bool              isBOUNDARY     () const;   
-      inline       bool              isPATH         () const;   
-      inline       bool              isSREF         () const;   
-      inline       bool              isAREF         () const;   
-      inline       bool              isTEXT         () const;   
-      inline       bool              isLAYER        () const;   
-      inline       bool              isDATATYPE     () const;   
+      inline static uint16_t         peekLength     ( const char* );
+      inline static uint16_t         peekType       ( const char* );
+      inline       bool              isHEADER       () const;
+      inline       bool              isBGNLIB       () const;
+      inline       bool              isLIBNAME      () const;
+      inline       bool              isUNITS        () const;
+      inline       bool              isENDLIB       () const;
+      inline       bool              isBGNSTR       () const;
+      inline       bool              isSTRNAME      () const;
+      inline       bool              isENDSTR       () const;
+      inline       bool              isBOUNDARY     () const;
+      inline       bool              isPATH         () const;
+      inline       bool              isSREF         () const;
+      inline       bool              isAREF         () const;
+      inline       bool              isTEXT         () const;
+      inline       bool              isLAYER        () const;
+      inline       bool              isDATATYPE     () const;
       inline       bool              isWIDTH        () const;
       inline       bool              isXY           () const;
-      inline       bool              isENDEL        () const;   
-      inline       bool              isSNAME        () const;   
-      inline       bool              isCOLROW       () const;   
+      inline       bool              isENDEL        () const;
+      inline       bool              isSNAME        () const;
+      inline       bool              isCOLROW       () const;
       inline       bool              isTEXTNODE     () const;
-      inline       bool              isNODE         () const;   
-      inline       bool              isTEXTTYPE     () const;   
-      inline       bool              isPRESENTATION () const;   
+      inline       bool              isNODE         () const;
+      inline       bool              isTEXTTYPE     () const;
+      inline       bool              isPRESENTATION () const;
       inline       bool              isSPACING      () const;
-      inline       bool              isSTRING       () const;   
-      inline       bool              isSTRANS       () const;   
-      inline       bool              isMAG          () const;   
-      inline       bool              isANGLE        () const;   
-      inline       bool              isREFLIBS      () const;   
-      inline       bool              isFONTS        () const;   
-      inline       bool              isPATHTYPE     () const;   
-      inline       bool              isGENERATIONS  () const;   
-      inline       bool              isATTRTABLE    () const;   
+      inline       bool              isSTRING       () const;
+      inline       bool              isSTRANS       () const;
+      inline       bool              isMAG          () const;
+      inline       bool              isANGLE        () const;
+      inline       bool              isREFLIBS      () const;
+      inline       bool              isFONTS        () const;
+      inline       bool              isPATHTYPE     () const;
+      inline       bool              isGENERATIONS  () const;
+      inline       bool              isATTRTABLE    () const;
       inline       bool              isSTYPTABLE    () const;
       inline       bool              isSTRTYPE      () const;
-      inline       bool              isELFLAGS      () const;   
+      inline       bool              isELFLAGS      () const;
       inline       bool              isELKEY        () const;
       inline       bool              isLINKTYPE     () const;
       inline       bool              isLINKKEYS     () const;
-      inline       bool              isNODETYPE     () const;   
-      inline       bool              isPROPATTR     () const;   
-      inline       bool              isPROPVALUE    () const;   
-      inline       bool              isBOX          () const;   
-      inline       bool              isBOXTYPE      () const;   
+      inline       bool              isNODETYPE     () const;
+      inline       bool              isPROPATTR     () const;
+      inline       bool              isPROPVALUE    () const;
+      inline       bool              isBOX          () const;
+      inline       bool              isBOXTYPE      () const;
       inline       bool              isPLEX         () const;
       inline       bool              isBGNEXTN      () const;
       inline       bool              isENDEXTN      () const;
-      inline       bool              isTAPENUM      () const;   
-      inline       bool              isTAPECODE     () const;   
+      inline       bool              isTAPENUM      () const;
+      inline       bool              isTAPECODE     () const;
       inline       bool              isSTRCLASS     () const;
       inline       bool              isRESERVED     () const;
-      inline       bool              isFORMAT       () const;   
+      inline       bool              isFORMAT       () const;
       inline       bool              isMASK         () const;
       inline       bool              isENDMASKS     () const;
-      inline       bool              isLIBDIRSIZE   () const;   
-      inline       bool              isSRFNAME      () const;   
-      inline       bool              isLIBSECUR     () const;   
+      inline       bool              isLIBDIRSIZE   () const;
+      inline       bool              isSRFNAME      () const;
+      inline       bool              isLIBSECUR     () const;
+      inline       bool              isEndOfStream  () const;
       inline       bool              hasXReflection () const;
       inline       uint16_t          getType        () const;
       inline       uint16_t          getLength      () const;
@@ -196,9 +212,9 @@ namespace {
       inline const vector<int16_t >& getInt16s      () const;
       inline const vector<int32_t >& getInt32s      () const;
       inline const vector<double  >& getDoubles     () const;
-      inline       string            getName        () const;
+      inline const string&           getName        () const;
                    void              clear          ();
-                   void              read           ( istream* );
+                   const char*       read           ( const char* record, const char* end, size_t offset );
                    void              readDummy      ( bool showError );
                    void              readStrans     ();
                    void              readString     ();
@@ -213,14 +229,13 @@ namespace {
                    void              readColrow     ();
                    void              readXy         ();
       static       string            toStrType      ( uint16_t );
-                   GdsRecord&        operator=      ( const GdsRecord& );
     private:
       template< typename IntType> IntType  _readInt    ();
                                   string   _readString ();
                                   double   _readDouble ();
     private:
-      istream*          _stream;
-      uint32_t          _offset;
+      const char*       _data;
+      size_t            _offset;
       uint16_t          _length;
       uint16_t          _count;
       uint16_t          _type;
@@ -230,10 +245,17 @@ namespace {
       vector<int16_t>   _int16s;
       vector<int32_t>   _int32s;
       vector<double>    _doubles;
-      char              _buffer[64];
   };
 
 
+  inline uint16_t  GdsRecord::peekLength ( const char* record )
+  { return ((uint16_t)(uint8_t)record[0] << 8) | (uint16_t)(uint8_t)record[1]; }
+
+
+  inline uint16_t  GdsRecord::peekType ( const char* record )
+  { return ((uint16_t)(uint8_t)record[2] << 8) | (uint16_t)(uint8_t)record[3]; }
+
+
   inline       bool              GdsRecord::isHEADER       () const { return (_type == HEADER      ); }   
   inline       bool              GdsRecord::isBGNLIB       () const { return (_type == BGNLIB      ); }   
   inline       bool              GdsRecord::isLIBNAME      () const { return (_type == LIBNAME     ); }   
@@ -292,18 +314,19 @@ namespace {
   inline       bool              GdsRecord::isLIBDIRSIZE   () const { return (_type == LIBDIRSIZE  ); }   
   inline       bool              GdsRecord::isSRFNAME      () const { return (_type == SRFNAME     ); }   
   inline       bool              GdsRecord::isLIBSECUR     () const { return (_type == LIBSECUR    ); }   
-  inline       bool              GdsRecord::hasXReflection () const { return _xReflection; }   
+  inline       bool              GdsRecord::isEndOfStream  () const { return (_type == EndOfStream ); }
+  inline       bool              GdsRecord::hasXReflection () const { return _xReflection; }
   inline       uint16_t          GdsRecord::getType        () const { return _type; }
   inline       uint16_t          GdsRecord::getLength      () const { return _length; }
   inline const vector<uint16_t>& GdsRecord::getMasks       () const { return _masks; }
   inline const vector<int16_t >& GdsRecord::getInt16s      () const { return _int16s; }
   inline const vector<int32_t >& GdsRecord::getInt32s      () const { return _int32s; }
   inline const vector<double  >& GdsRecord::getDoubles     () const { return _doubles; }
-  inline       string            GdsRecord::getName        () const { return _name; }
+  inline const string&           GdsRecord::getName        () const { return _name; }
 
 
   GdsRecord::GdsRecord ()
-    : _stream     (NULL)
+    : _data       (NULL)
     , _offset     (0)
     , _length     (0)
     , _count      (0)
@@ -318,7 +341,7 @@ namespace {
 
 
   void  GdsRecord::clear ()
-  { _stream      = NULL;
+  { _data        = NULL;
     _length      = 0;
     _count       = 0;
     _type        = 0;
@@ -331,13 +354,25 @@ namespace {
   }
 
 
-  void  GdsRecord::read ( istream* stream )
+  const char* GdsRecord::read ( const char* record, const char* end, size_t offset )
   {
     clear();
 
-    _stream = stream;
-    _length = _readInt<uint16_t>();
-    _type   = _readInt<uint16_t>();
+    _offset = offset;
+    if (end - record < 4) {
+      _type = EndOfStream;
+      return end;
+    }
+
+    _data   = record;
+    _length = peekLength( record );
+    _type   = peekType  ( record );
+    _count  = 4;
+    if ((_length < 4) or (_length > end - record)) {
+      _type   = EndOfStream;
+      _length = 0;
+      return end;
+    }
 
     switch ( _type ) {
       case HEADER:       readDummy( false ); break;
@@ -400,27 +435,16 @@ namespace {
       case LIBSECUR:     readDummy( false ); break;
     }
 
-    ostringstream s;
-    s << " (0x" << std::setfill('0') << std::setw(4) << std::hex << _type << ")";
-    cdebug_log(101,0) << "GdsRecord::read() " << toStrType(_type)
-                      << s.str()
-                      << " _bytes:"  <<  _length
-                      << " (offset:" << (_offset-4) << ")"
-                      << endl;
-  }
-
-
-  GdsRecord& GdsRecord::operator= ( const GdsRecord& other )
-  {
-    _length   = other._length;
-    _count    = other._count;
-    _type     = other._type;
-    _name     = other._name;
-    _masks    = other._masks;
-    _int16s   = other._int16s;
-    _int32s   = other._int32s;
-    _doubles  = other._doubles;
-    return *this;
+    if (cdebug.enabled(101)) {
+      ostringstream s;
+      s << " (0x" << std::setfill('0') << std::setw(4) << std::hex << _type << ")";
+      cdebug_log(101,0) << "GdsRecord::read() " << toStrType(_type)
+                        << s.str()
+                        << " _bytes:"  <<  _length
+                        << " (offset:" << _offset << ")"
+                        << endl;
+    }
+    return record + _length;
   }
 
 
@@ -428,51 +452,35 @@ namespace {
   IntType  GdsRecord::_readInt ()
   {
     const size_t typeSize = sizeof(IntType);
-    
-    union UType {
-        IntType       integer;
-        unsigned char bytes[ typeSize ];
-    };
-
-    unsigned char bytes[typeSize];
-    _stream->read( (char*)(&bytes[0]), typeSize );
-    _count  += typeSize;
-
-    // cdebug_log(101,0) << "GdsRecord::_readInt() " << endl;
-    // for ( size_t i=0 ; i<typeSize ; ++i ) {
-    //   sprintf( _buffer, "0x%02x", bytes[i] );
-    //   cdebug(101,0) << setw(6) << hex << _offset++ << " | " << _buffer << endl; 
-    // }
-
-    UType uvalue;
-  // Little endian (x86).
-    for ( size_t i=0 ; i<typeSize ; ++i ) uvalue.bytes[i] = bytes[typeSize-i-1];
-
-    return uvalue.integer;
+
+    if (_count + typeSize > _length) {
+      _count = _length;
+      return 0;
+    }
+
+  // Big endian in the file, whatever the host is.
+    uint64_t value = 0;
+    for ( size_t i=0 ; i<typeSize ; ++i )
+      value = (value << 8) | (uint8_t)_data[ _count+i ];
+    _count += typeSize;
+
+    return (IntType)value;
   }
 
 
   double  GdsRecord::_readDouble ()
   {
-    union gdsUInt64 {
-        uint64_t      uint64;
-        unsigned char bytes[8];
-    };
+    if (_count + 8 > _length) {
+      _count = _length;
+      return 0.0;
+    }
 
-    char bytes[8];
-    _stream->read( bytes, 8 );
+    const char* bytes = _data + _count;
     _count += 8;
 
-    // cdebug_log(101,0) << "GdsRecord::_readDouble() " << endl;
-    // for ( size_t i=0 ; i<8 ; ++i ) {
-    //   sprintf( _buffer, "0x%02x", bytes[i] );
-    //   cdebug(101,0) << setw(6) << hex << _offset++ << " | " << _buffer << endl; 
-    // }
-
-    gdsUInt64 mantisse;
-    for ( size_t i=0 ; i<7 ; ++i ) mantisse.bytes[i] = bytes[7-i];
-    mantisse.bytes[7] = 0;
-    double value = mantisse.uint64;
+    uint64_t mantisse = 0;
+    for ( size_t i=1 ; i<8 ; ++i ) mantisse = (mantisse << 8) | (uint8_t)bytes[i];
+    double value = mantisse;
 
     if (bytes[0] & 0x80) value = -value;
 
@@ -485,15 +493,10 @@ namespace {
 
   string  GdsRecord::_readString ()
   {
-    cdebug_log(101,0) << "GdsRecord::_readDouble() " << endl;
     string s;
-    char c;
+    s.reserve( _length - _count );
     for ( ; _count<_length ; ++_count ) {
-      _stream->get( c );
-      // sprintf( _buffer, "0x%02x", c );
-      // cdebug_log(101,0) << setw(6) << hex << _offset++ << " | " << _buffer << endl; 
-
-      if (c != (char)0) s.push_back(c);
+      if (_data[_count] != (char)0) s.push_back( _data[_count] );
     }
     cdebug_log(101,0) << "GdsRecord::_readString(): \"" << s << "\"" << endl;
     return s;
@@ -503,12 +506,7 @@ namespace {
   void  GdsRecord::readDummy ( bool showError )
   {
     cdebug_log(101,0) << "GdsRecord::readDummy() " << endl;
-    char c;
-    for ( ; _count<_length ; ++_count ) {
-      _stream->get( c );   
-      sprintf( _buffer, "0x%02x", c );
-      cdebug_log(101,0) << tsetw(6) << hex << _offset++ << " | " << _buffer << endl; 
-    }
+    _count = _length;
     if (showError) {
       cdebug_log(101,0) << Error( "GdsRecord type %s unsupported.", toStrType(_type).c_str() ) << endl;
     }
@@ -520,11 +518,6 @@ namespace {
     const uint16_t XRMask = 0x8000;
           uint16_t flags  = _readInt<uint16_t>();
     _xReflection = (flags & XRMask);
-
-    // cerr << "GdsRecord::readStrans(): length=" << _length
-    //      << " flags:" << bitset<16>(flags)
-    //      << " mask:" << bitset<16>(XRMask)
-    //      << " _xR:" << _xReflection << endl;
   }
 
 
@@ -572,7 +565,10 @@ namespace {
 
 
   void  GdsRecord::readXy ()
-  { while ( _count < _length ) _int32s.push_back( _readInt<int32_t>() ); }
+  {
+    _int32s.reserve( (_length - _count) / 4 );
+    while ( _count < _length ) _int32s.push_back( _readInt<int32_t>() );
+  }
 
 
   string  GdsRecord::toStrType ( uint16_t type )
@@ -636,6 +632,7 @@ namespace {
       case LIBDIRSIZE:  return "LIBDIRSIZE";
       case SRFNAME:     return "SRFNAME";
       case LIBSECUR:    return "LIBSECUR";
+      case EndOfStream: return "EndOfStream";
     }
 
     ostringstream error;
@@ -644,58 +641,228 @@ namespace {
   }
 
 
-  istream& operator>> ( istream& stream, GdsRecord& record )
-  { record.read( &stream ); return stream; }
+// -------------------------------------------------------------------
+// Class  :  "::GdsCursor".
+//
+// Sequential reading of the records of a range of the file image.
+
+  class GdsCursor {
+    public:
+      inline              GdsCursor  ();
+      inline              GdsCursor  ( const char* base, const char* begin, const char* end );
+      inline const char*  getCurrent () const;
+      inline void         seek       ( const char* );
+      inline GdsCursor&   operator>> ( GdsRecord& );
+    private:
+      const char*  _base;
+      const char*  _current;
+      const char*  _end;
+  };
+
+
+  inline GdsCursor::GdsCursor ()
+    : _base(NULL), _current(NULL), _end(NULL)
+  { }
+
+
+  inline GdsCursor::GdsCursor ( const char* base, const char* begin, const char* end )
+    : _base(base), _current(begin), _end(end)
+  { }
+
+
+  inline const char* GdsCursor::getCurrent () const { return _current; }
+  inline void        GdsCursor::seek       ( const char* current ) { _current = current; }
+
+
+  inline GdsCursor& GdsCursor::operator>> ( GdsRecord& record )
+  {
+    _current = record.read( _current, _end, _current - _base );
+    return *this;
+  }
+
+
+// -------------------------------------------------------------------
+// Class  :  "::GdsElement".
+//
+// An element of a STRUCTURE, decoded but not yet turned into Hurricane
+// objects. Coordinates are already scaled and the points are stored in
+// the array of the structure. Messages issued while decoding are kept
+// as elements too, so they are printed in order, when the structure
+// is built.
+
+  class GdsElement {
+    public:
+      enum Type { ErrorMessage   = 0
+                , WarningMessage = 1
+                , AbutmentBox    = 2
+                , Boundary       = 3
+                , Path           = 4
+                , Text           = 5
+                };
+    public:
+      inline  GdsElement ( Type, const Layer*, size_t firstPoint );
+    public:
+      Type          _type;
+      uint16_t      _pathtype;
+      const Layer*  _layer;
+      DbU::Unit     _width;
+      DbU::Unit     _bgnextn;
+      DbU::Unit     _endextn;
+      uint32_t      _firstPoint;
+      uint32_t      _pointCount;
+      string        _text;
+  };
+
+
+  inline GdsElement::GdsElement ( Type type, const Layer* layer, size_t firstPoint )
+    : _type      (type)
+    , _pathtype  (0)
+    , _layer     (layer)
+    , _width     (0)
+    , _bgnextn   (0)
+    , _endextn   (0)
+    , _firstPoint(firstPoint)
+    , _pointCount(0)
+    , _text      ()
+  { }
+
+
+// -------------------------------------------------------------------
+// Class  :  "::DelayedInstance".
+//
+// SREF/AREF are only instanciated once all the STRUCTUREs are built.
+// The master and the index in the instance naming are resolved in the
+// file order, the Instances themselves are created in dependency order.
+
+  class DelayedInstance {
+    public:
+      inline DelayedInstance ( string masterName, const Transformation& );
+    public:
+      string          _masterName;
+      Transformation  _transformation;
+      Cell*           _master;
+      int64_t         _index;
+  };
+
+
+  inline DelayedInstance::DelayedInstance ( string masterName, const Transformation& transf )
+    : _masterName(masterName), _transformation(transf), _master(NULL), _index(-1)
+  { }
+
+
+  class GdsStream;
+
+
+// -------------------------------------------------------------------
+// Class  :  "::GdsStructure".
+//
+// Decoding of one STRUCTURE (BGNSTR/ENDSTR) into GdsElements. Only the
+// read-only state of the GdsStream is accessed (scale, flags, layers
+// table and filter), so the structures can be decoded concurrently.
+// The syntax is checked record by record exactly as the former, fully
+// sequential, parser did.
+
+  class GdsStructure {
+    public:
+                                             GdsStructure         ( const GdsStream*, const char* base, const char* begin, const char* end );
+      inline       bool                      isValidSyntax        () const;
+      inline       bool                      hasName              () const;
+      inline const string&                   getName              () const;
+      inline       Cell*                     getCell              () const;
+      inline       void                      setCell              ( Cell* );
+      inline const vector<GdsElement>&       getElements          () const;
+      inline       vector<DelayedInstance>&  getInstances         ();
+      inline const Point*                    getPoints            ( const GdsElement& ) const;
+                   void                      release              ();
+                   bool                      decode               ();
+             const Layer*                    readLayerAndDatatype ( bool& isBoundary );
+                   bool                      readBoundary         ();
+                   bool                      readPath             ();
+                   bool                      readSref             ();
+                   bool                      readAref             ();
+                   bool                      readNode             ();
+                   bool                      readBox              ();
+                   bool                      readText             ();
+                   bool                      readTextbody         ( uint16_t gdsLayer );
+                   bool                      readStrans           ();
+                   bool                      readProperty         ();
+                   void                      xyToPoints           ();
+                   void                      xyToAbutmentBox      ();
+                   void                      xyToComponent        ( const Layer* );
+                   void                      xyToPath             ( uint16_t pathtype
+                                                                  , const Layer*
+                                                                  , DbU::Unit width
+                                                                  , DbU::Unit bgnextn
+                                                                  , DbU::Unit endextn );
+    private:
+      inline       void                      resetStrans          ();
+      inline       GdsElement&               _addElement          ( GdsElement::Type, const Layer* );
+                   void                      _message             ( GdsElement::Type, const char* format, ... );
+    private:
+      const GdsStream*         _gstream;
+      GdsCursor                _stream;
+      GdsRecord                _record;
+      DbU::Unit                _scale;
+      string                   _name;
+      bool                     _hasName;
+      Cell*                    _cell;
+      double                   _angle;
+      bool                     _xReflection;
+      bool                     _validSyntax;
+      bool                     _skipENDEL;
+      vector<Point>            _points;
+      vector<GdsElement>       _elements;
+      vector<DelayedInstance>  _instances;
+  };
 
 
 // -------------------------------------------------------------------
 // Class  :  "::GdsStream".
+//
+// The GDSII file is mapped in memory (or uncompressed in it, for a
+// ".gz" file). The library header is read first, then a quick pass
+// over the records headers locates all the STRUCTUREs. They are then
+// decoded by batches, in parallel, and each batch is built, in file
+// order and sequentially, as the Hurricane DataBase is not thread safe.
+// Once all the Cells exists, the instances are created, the models
+// before the Cells that instanciate them.
 
   class GdsStream {
+    public:
+      static constexpr size_t  StructuresPerBatch = 256;
     public:
       static const Layer*  gdsToLayer           ( uint16_t gdsLayer, uint16_t datatype );
-    public:                                     
+    public:
       static       void    _staticInit          ();
-                           GdsStream            ( string gdsPath, uint32_t flags );
+                           GdsStream            ( string gdsPath, uint32_t flags, const set<string>& layersFilter );
+                          ~GdsStream            ();
                    Cell*   getCell              ( string cellName, bool create=false );
       inline       bool    useGdsPrefix         () const;
       inline       bool    useLayer0AsBoundary  () const;
+      inline       bool    useBlockages         () const;
       inline       bool    isValidSyntax        () const;
+      inline       bool    isFiltered           ( const Layer* ) const;
+      inline       DbU::Unit  getScale          () const;
                    bool    misplacedRecord      ();
-      inline       void    resetStrans          ();
-                   bool    read                 ( Library* );
+                   bool    read                 ( Library*, size_t threads );
                    bool    readFormatType       ();
-                   bool    readStructure        ();
-             const Layer*  readLayerAndDatatype ( bool& isBoundary );
-                   bool    readBoundary         ();
-                   bool    readPath             ();
-                   bool    readSref             ();
-                   bool    readAref             ();
-                   bool    readNode             ();
-                   bool    readBox              ();
-                   bool    readText             ();
-                   bool    readTextbody         ( uint16_t gdsLayer );
-                   bool    readStrans           ();
-                   bool    readProperty         ();
-                   void    xyToAbutmentBox      ();
-                   void    xyToComponent        ( const Layer* );
-                   void    xyToPath             ( uint16_t pathtype
-                                                , const Layer*
-                                                , DbU::Unit width
-                                                , DbU::Unit bgnextn
-                                                , DbU::Unit endextn );
-                   void    makeInstances        ();
+                   void    indexStructures      ();
+                   void    sortStructures       ( vector<size_t>& order );
+                   void    build                ( GdsStructure& );
+                   void    makeComponent        ( const GdsStructure&, const GdsElement& );
+                   void    makePath             ( const GdsStructure&, const GdsElement& );
+                   void    makeText             ( const GdsStructure&, const GdsElement& );
+                   void    makeInstances        ( GdsStructure& );
                    void    makeExternals        ();
                    Net*    fusedNet             ();
                    void    addNetReference      ( Net*, const Layer*, DbU::Unit x, DbU::Unit y );
     private:
-      struct DelayedInstance {
-          inline DelayedInstance ( Cell* owner, string masterName, const Transformation& );
-
-          Cell*           _owner;
-          string          _masterName;
-          Transformation  _transformation;
-      };
+                   bool    _map                 ();
+                   bool    _uncompress          ();
+                   void    _visit               ( size_t
+                                                , vector<uint8_t>& states
+                                                , const unordered_map< Cell*, vector<size_t> >&
+                                                , vector<size_t>& order );
     private:
       struct PinPoint {
           inline PinPoint ( const Layer*, DbU::Unit x, DbU::Unit y );
@@ -704,260 +871,126 @@ namespace {
       };
     private:
       static map<uint32_t,const Layer*>  _gdsLayerTable;
-             vector<DelayedInstance>     _delayedInstances;
+             vector<GdsStructure>        _structures;
              vector<Cell*>               _cells;
+             set<const Layer*>           _layersFilter;
+             bool                        _useFilter;
              uint32_t                    _flags;
              string                      _gdsPath;
-             ifstream                    _stream;
+             int                         _fd;
+             void*                       _mapped;
+             size_t                      _size;
+             vector<char>                _uncompressed;
+             const char*                 _base;
+             const char*                 _end;
+             GdsCursor                   _stream;
              GdsRecord                   _record;
-             double                      _angle;
-             bool                        _xReflection;
              Library*                    _library;
              Cell*                       _cell;
-             Component*                  _component;
-             string                      _text;
              DbU::Unit                   _scale;
              int64_t                     _SREFCount;
              bool                        _validSyntax;
-             bool                        _skipENDEL;
              map< Net*
                 , vector<PinPoint>
                 , DBo::CompareById >  _netReferences;
   };
 
 
-  inline GdsStream::DelayedInstance::DelayedInstance (       Cell*           owner
-                                                     ,       string          masterName
-                                                     , const Transformation& transf )
-    : _owner(owner), _masterName(masterName), _transformation(transf)
-  { }
-
-
   inline GdsStream::PinPoint::PinPoint ( const Layer* layer, DbU::Unit x, DbU::Unit y )
     : _layer(layer), _position(x,y)
   { }
 
-  
-  map<uint32_t,const Layer*>  GdsStream::_gdsLayerTable;
-
-
-  void  GdsStream::_staticInit ()
-  {
-    for ( const BasicLayer* layer : DataBase::getDB()->getTechnology()->getBasicLayers() ) {
-      if (layer->hasGds()) {
-        uint32_t gdsNumber = (layer->getGds2Layer() << 16) + layer->getGds2Datatype();
-        _gdsLayerTable[gdsNumber] = layer;
-      }
-    }
-  }
-
-
-  inline  void  GdsStream::resetStrans () { _angle = 0.0; _xReflection = false; }
 
-
-  const Layer* GdsStream::gdsToLayer ( uint16_t gdsLayer, uint16_t datatype )
-  {
-    uint32_t gdsIndex = (gdsLayer << 16) + datatype;
-    auto ilayer = _gdsLayerTable.find( gdsIndex );
-    if (ilayer == _gdsLayerTable.end())
-      return NULL;
-    return (*ilayer).second;
-  }
+  inline bool       GdsStream::isValidSyntax       () const { return _validSyntax; }
+  inline bool       GdsStream::useGdsPrefix        () const { return not(_flags & Gds::NoGdsPrefix); }
+  inline bool       GdsStream::useLayer0AsBoundary () const { return    (_flags & Gds::Layer_0_IsBoundary); }
+  inline bool       GdsStream::useBlockages        () const { return not(_flags & Gds::NoBlockages); }
+  inline DbU::Unit  GdsStream::getScale            () const { return _scale; }
 
 
-  inline bool  GdsStream::isValidSyntax       () const { return _validSyntax; }
-  inline bool  GdsStream::useGdsPrefix        () const { return not(_flags & Gds::NoGdsPrefix); }
-  inline bool  GdsStream::useLayer0AsBoundary () const { return    (_flags & Gds::Layer_0_IsBoundary); }
+  inline bool  GdsStream::isFiltered ( const Layer* layer ) const
+  { return _useFilter and layer and not _layersFilter.count(layer); }
 
 
-  GdsStream::GdsStream ( string gdsPath, uint32_t flags )
-    : _delayedInstances()
-    , _cells           ()
-    , _flags           (flags)
-    , _gdsPath         (gdsPath)
-    , _stream          ()
-    , _record          ()
-    , _angle           (0.0)
-    , _xReflection     (false)
-    , _library         (NULL)
-    , _cell            (NULL)
-    , _component       (NULL)
-    , _text            ()
-    , _scale           (1)
-    , _SREFCount       (0)
-    , _validSyntax     (true)
-    , _skipENDEL       (false)
-  {
-    if (_gdsLayerTable.empty()) _staticInit();
-    
-    _stream.open( gdsPath, ios_base::in|ios_base::binary );
-    if (not _stream.is_open()) {
-      cerr << Error( "GdsStream::GdsStream(): Unable to open stream, check path.\n"
-                     "        \"%s\""
-                   , _gdsPath.c_str() ) << endl;
-      _validSyntax = false;
-      return;
-    }
+// -------------------------------------------------------------------
+// Class  :  "::GdsStructure" (implementation).
 
-    _stream >> _record;
-    if (not _record.isHEADER()) {
-      cerr << Error( "GdsStream::GdsStream(): First record is not a HEADER.\n"
-                     "        in \"%s\""
-                   , _gdsPath.c_str() ) << endl;
-      _validSyntax = false;
-      return;
-    }
-    _stream >> _record;
-  }
 
+  GdsStructure::GdsStructure ( const GdsStream* gstream, const char* base, const char* begin, const char* end )
+    : _gstream    (gstream)
+    , _stream     (base,begin,end)
+    , _record     ()
+    , _scale      (gstream->getScale())
+    , _name       ()
+    , _hasName    (false)
+    , _cell       (NULL)
+    , _angle      (0.0)
+    , _xReflection(false)
+    , _validSyntax(true)
+    , _skipENDEL  (false)
+    , _points     ()
+    , _elements   ()
+    , _instances  ()
+  { }
 
-  Cell* GdsStream::getCell ( string cellName, bool create )
-  {
-    if (not _library) return nullptr;
-    Library* workLibrary = _library;
-    Cell*    cell        = workLibrary->getCell( cellName );
-    if (cell) return cell;
 
-    if (not Gds::getTopCellName().empty() and (cellName != Gds::getTopCellName())) {
-      cellName.insert( 0, "." );
-      cellName.insert( 0, Gds::getTopCellName() );
-      workLibrary = _library->getLibrary( Gds::getTopCellName() );
-      if (workLibrary) { 
-        cell = workLibrary->getCell( cellName );
-        if (cell) return cell;
-      } else {
-        if (not create) return nullptr;
-        workLibrary = Library::create( _library, Gds::getTopCellName() );
-      }
-    }
+  inline       bool                      GdsStructure::isValidSyntax () const { return _validSyntax; }
+  inline       bool                      GdsStructure::hasName       () const { return _hasName; }
+  inline const string&                   GdsStructure::getName       () const { return _name; }
+  inline       Cell*                     GdsStructure::getCell       () const { return _cell; }
+  inline       void                      GdsStructure::setCell       ( Cell* cell ) { _cell = cell; }
+  inline const vector<GdsElement>&       GdsStructure::getElements   () const { return _elements; }
+  inline       vector<DelayedInstance>&  GdsStructure::getInstances  () { return _instances; }
+  inline       void                      GdsStructure::resetStrans   () { _angle = 0.0; _xReflection = false; }
 
-    if (not create) return nullptr;
 
-    cparanoid << Warning( "GdsStream::readStructure(): No Cell named \"%s\" in Library \"%s\" (created)."
-                        , cellName.c_str()
-                        , getString(_library).c_str()
-                        ) << endl;
-    _cells.push_back( Cell::create( workLibrary, cellName ));
-    return _cells.back();
-  }
+  inline const Point* GdsStructure::getPoints ( const GdsElement& element ) const
+  { return _points.data() + element._firstPoint; }
 
 
-  bool  GdsStream::misplacedRecord ()
+  inline GdsElement& GdsStructure::_addElement ( GdsElement::Type type, const Layer* layer )
   {
-    cerr << Error( "GdsStream: Misplaced record %s.\n"
-                 "        in \"%s\""
-                 , GdsRecord::toStrType(_record.getType()).c_str()
-                 , _gdsPath.c_str() ) << endl;
-    _validSyntax = false;
-    return _validSyntax;
+    _elements.push_back( GdsElement( type, layer, _points.size() ) );
+    return _elements.back();
   }
 
 
-  bool  GdsStream::read ( Library* library )
+  void  GdsStructure::_message ( GdsElement::Type type, const char* format, ... )
   {
-    cdebug_log(101,1) << "GdsStream::read(Library*)" << endl;
-    
-    _library = library;
-
-    if (not _record.isBGNLIB()) {
-      cerr << Error( "GdsStream::read(Library*): Starting record is not a BGNLIB.\n"
-                     "        in \"%s\""
-                   , _gdsPath.c_str() ) << endl;
-      _validSyntax = false;
-      cdebug_tabw(101,-1);
-      return _validSyntax;
-    }
-    _stream >> _record;
-
-    if (_record.isLIBDIRSIZE ()) { _stream >> _record; }
-    if (_record.isSRFNAME    ()) { _stream >> _record; }
-    if (_record.isLIBSECUR   ()) { _stream >> _record; }
-    if (_record.isLIBNAME    ()) { _stream >> _record; }
-    else {
-      cerr << Error( "GdsStream::read(Library*): Missing LIBNAME record.\n"
-                     "        in \"%s\""
-                   , _gdsPath.c_str() ) << endl;
-      _validSyntax = false;
-      cdebug_tabw(101,-1);
-      return _validSyntax;
-    }
-    if (_record.isREFLIBS    ()) { _stream >> _record; }
-    if (_record.isFONTS      ()) { _stream >> _record; }
-    if (_record.isATTRTABLE  ()) { _stream >> _record; }
-    if (_record.isGENERATIONS()) { _stream >> _record; }
-    if (_record.isFORMAT     ()) {
-      readFormatType();
-      if (not _validSyntax) {
-        cdebug_tabw(101,-1);
-        return _validSyntax;
-      }
-    }
-
-    if (_record.isUNITS()) {
-      _scale = DbU::fromPhysical( _record.getDoubles()[1], DbU::Unity );
-      _stream >> _record;
-    }
-
-    while ( _validSyntax and _record.isBGNSTR() ) {
-      _stream >> _record;
-      readStructure();
-    }
-
-    if (_validSyntax and not _record.isENDLIB()) { misplacedRecord(); }
-
-    if (_validSyntax) {
-      makeInstances();
-      makeExternals();
-    }
+  // Error & Warning formatting constructors use a static buffer.
+    char     formatted [ 8192 ];
+    va_list  args;
 
-    for ( Cell* cell : _cells ) {
-      if (not useLayer0AsBoundary() or cell->getAbutmentBox().isEmpty()) {
-        cell->setAbutmentBox( cell->getBoundingBox() );
-      }
-    }
+    va_start ( args, format );
+    vsnprintf ( formatted, 8191, format, args );
+    va_end ( args );
 
-    _library = NULL;
-    cdebug_log(101,-1) << "    GdsStream::read(Library*) - return:" << _validSyntax << endl;
-    return _validSyntax;
+    _addElement( type, NULL )._text = formatted;
   }
 
 
-  bool  GdsStream::readFormatType ()
+  void  GdsStructure::release ()
   {
-    cdebug_log(101,0) << "GdsStream::readFormatType()" << endl;
-
-    if (_record.isMASK()) {
-      _stream >> _record;
-      while ( _record.isMASK() ) {
-        _stream >> _record;
-      }
-
-      if (_record.isENDMASKS()) { _stream >> _record; }
-      else { _validSyntax = false; return _validSyntax; }
-    }
-
-  //cdebug(101,0) << "GdsStream::readFormatType() - return:" << _validSyntax << endl;
-    return _validSyntax;
+    vector<Point>     ().swap( _points );
+    vector<GdsElement>().swap( _elements );
   }
 
 
-  bool  GdsStream::readStructure ()
+  bool  GdsStructure::decode ()
   {
-    cdebug_log(101,1) << "GdsStream::readStructure()" << endl;
-    
+    cdebug_log(101,1) << "GdsStructure::decode()" << endl;
+
+    _stream >> _record;
     if (_record.isSTRNAME()) {
-      if (_library) {
-        string cellName = _record.getName();
-        _cell = getCell( cellName, true );
-        _stream >> _record;
-      }
+      _name    = _record.getName();
+      _hasName = true;
+      _stream >> _record;
     }
 
     if (_record.isSTRCLASS()) { _stream >> _record; }
 
     while ( not _record.isENDSTR() ) {
-      uint16_t rtype = _record.getType();
-      switch ( rtype ) {
+      switch ( _record.getType() ) {
         case GdsRecord::BOUNDARY:  _stream >> _record; readBoundary(); break;
         case GdsRecord::PATH:      _stream >> _record; readPath    (); break;
         case GdsRecord::SREF:      _stream >> _record; readSref    (); break;
@@ -976,22 +1009,17 @@ namespace {
         }
       } else
         _skipENDEL = false;
-      if (rtype != GdsRecord::BOUNDARY) _component = NULL;
     }
 
-    if (_validSyntax) _stream >> _record;
-
-    _cell = NULL;
-    cdebug_log(101,-1) << "    GdsStream::readStructure() - return:" << _validSyntax << endl;
-
-    return _validSyntax;
-  }
+    cdebug_log(101,-1) << "    GdsStructure::decode() - return:" << _validSyntax << endl;
+    return _validSyntax;
+  }
 
 
-  const Layer* GdsStream::readLayerAndDatatype ( bool& isBoundary )
+  const Layer* GdsStructure::readLayerAndDatatype ( bool& isBoundary )
   {
-    cdebug_log(101,1) << "GdsStream::readLayerAndDatatype()" << endl;
-    
+    cdebug_log(101,1) << "GdsStructure::readLayerAndDatatype()" << endl;
+
     isBoundary = false;
     uint16_t  gdsLayer    = 0;
     uint16_t  gdsDatatype = 0;
@@ -1000,47 +1028,47 @@ namespace {
       gdsLayer = (uint16_t)_record.getInt16s()[0];
       _stream >> _record;
     } else {
-      cerr << Error( "GdsStream::readLayerAndDatatype(): Expecting LAYER record, got %s."
-                   , GdsRecord::toStrType(_record.getType()).c_str()
-                   ) << endl;
+      _message( GdsElement::ErrorMessage
+              , "GdsStream::readLayerAndDatatype(): Expecting LAYER record, got %s."
+              , GdsRecord::toStrType(_record.getType()).c_str() );
       _validSyntax = false;
       cdebug_tabw(101,-1);
-      return NULL;;
+      return NULL;
     }
 
     if (_record.isDATATYPE()) {
       gdsDatatype = (uint16_t)_record.getInt16s()[0];
       _stream >> _record;
     } else {
-      cerr << Error( "GdsStream::readLayerAndDatatype(): Expecting DATATYPE record, got %s."
-                   , GdsRecord::toStrType(_record.getType()).c_str()
-                   ) << endl;
+      _message( GdsElement::ErrorMessage
+              , "GdsStream::readLayerAndDatatype(): Expecting DATATYPE record, got %s."
+              , GdsRecord::toStrType(_record.getType()).c_str() );
       _validSyntax = false;
       cdebug_tabw(101,-1);
-      return NULL;;
+      return NULL;
     }
 
-    const Layer* layer = gdsToLayer( gdsLayer, gdsDatatype );
-    if ((gdsLayer == 0) and not useLayer0AsBoundary()) {
+    const Layer* layer = GdsStream::gdsToLayer( gdsLayer, gdsDatatype );
+    if ((gdsLayer == 0) and not _gstream->useLayer0AsBoundary()) {
       cdebug_log(101,0) << "Layer id+datatype:" << gdsLayer << "+" << gdsDatatype << " " << layer << endl;
       if (not layer) {
-        cerr << Error( "GdsStream::readLayerAndDatatype(): No BasicLayer id:%d+%d in GDS conversion table (skipped)."
-                     , gdsLayer, gdsDatatype
-                     ) << endl;
+        _message( GdsElement::ErrorMessage
+                , "GdsStream::readLayerAndDatatype(): No BasicLayer id:%d+%d in GDS conversion table (skipped)."
+                , gdsLayer, gdsDatatype );
       }
     }
-    isBoundary = (not layer and (gdsLayer == 0) and useLayer0AsBoundary());
+    isBoundary = (not layer and (gdsLayer == 0) and _gstream->useLayer0AsBoundary());
 
     cdebug_tabw(101,-1);
     return layer;
   }
 
 
-  bool  GdsStream::readText ()
+  bool  GdsStructure::readText ()
   {
     uint16_t gdsLayer = 0;
-    
-    cdebug_log(101,1) << "GdsStream::readText()" << endl;
+
+    cdebug_log(101,1) << "GdsStructure::readText()" << endl;
     if (_record.isELFLAGS()) { _stream >> _record; }
     if (_record.isPLEX   ()) { _stream >> _record; }
     if (_record.isLAYER  ()) {
@@ -1054,28 +1082,27 @@ namespace {
 
     readTextbody( gdsLayer );
 
-  //cdebug(101,0) << "GdsStream::readText() - return:" << _validSyntax << endl;
     cdebug_tabw(101,-1);
     return _validSyntax;
   }
 
 
-  bool  GdsStream::readTextbody ( uint16_t gdsLayer )
+  bool  GdsStructure::readTextbody ( uint16_t gdsLayer )
   {
     const Layer* layer = NULL;
-    cdebug_log(101,1) << "GdsStream::readTextbody()" << endl;
+    cdebug_log(101,1) << "GdsStructure::readTextbody()" << endl;
 
     DbU::Unit xpos = 0;
     DbU::Unit ypos = 0;
 
     if (_record.isTEXTTYPE()) {
       uint16_t texttype = (uint16_t)_record.getInt16s()[0];
-      layer = gdsToLayer( gdsLayer, texttype );
+      layer = GdsStream::gdsToLayer( gdsLayer, texttype );
       if (not layer) {
-        cerr << Error( "GdsStream::readText(): No BasicLayer %d:%d in GDS conversion table (skipped)."
-                     , gdsLayer
-                     , texttype
-                     ) << endl;
+        _message( GdsElement::ErrorMessage
+                , "GdsStream::readText(): No BasicLayer %d:%d in GDS conversion table (skipped)."
+                , gdsLayer
+                , texttype );
       }
        _stream >> _record;
     }
@@ -1100,7 +1127,7 @@ namespace {
 
     if (_record.isXY()) {
       cdebug_log(101,0) << "Current record is XY" << endl;
-      vector<int32_t> coordinates = _record.getInt32s();
+      const vector<int32_t>& coordinates = _record.getInt32s();
       if (coordinates.size() != 2) {
         _validSyntax = false;
         cdebug_tabw(101,-1);
@@ -1115,13 +1142,14 @@ namespace {
       return _validSyntax;
     }
 
+    string text;
     if (_record.isSTRING()) {
-      _text = _record.getName();
+      text = _record.getName();
       _stream >> _record;
       if (not layer) {
-        cerr << Error( "GdsStream::readTextbody(): Discarted text is \"%s\"."
-                     , _text.c_str()
-                     ) << endl;
+        _message( GdsElement::ErrorMessage
+                , "GdsStream::readTextbody(): Discarted text is \"%s\"."
+                , text.c_str() );
         cdebug_tabw(101,-1);
         return _validSyntax;
       }
@@ -1133,54 +1161,35 @@ namespace {
       return _validSyntax;
     }
 
-    if (not _text.empty()) {
-      const BasicLayer* basicLayer = static_cast<const BasicLayer*>( layer );
-      if (   (basicLayer->getMaterial() != BasicLayer::Material::other)
-         and (basicLayer->getMaterial() != BasicLayer::Material::info ) ) {
-        Net* net = _cell->getNet( _text );
-        if (not net) {
-          net = Net::create( _cell, _text );
-          net->setExternal( true );
-          if (_text.substr(0,3) == "vdd")     net->setType  ( Net::Type::POWER );
-          if (_text.substr(0,3) == "gnd")     net->setType  ( Net::Type::GROUND );
-          if (_text[ _text.size()-1 ] == '!') net->setGlobal( true );
-        }
-        addNetReference( net, layer, xpos, ypos );
-      } else {
-        DbU::Unit textHeight = _scale * 500;
-        DbU::Unit textWidth  = _scale * 500 * _text.size();
-        Text::create( _cell, layer, Box( xpos
-                                       , ypos
-                                       , xpos + textWidth
-                                       , ypos + textHeight
-                                       ), _text );
-      }
+    if (not text.empty() and _hasName and not _gstream->isFiltered(layer)) {
+      _addElement( GdsElement::Text, layer )._text = text;
+      _elements.back()._pointCount = 1;
+      _points.push_back( Point(xpos,ypos) );
     }
 
-    cdebug_log(101,-1) << "GdsStream::readTextbody() - return:" << _validSyntax << endl;
+    cdebug_log(101,-1) << "GdsStructure::readTextbody() - return:" << _validSyntax << endl;
     return _validSyntax;
   }
 
 
-  bool  GdsStream::readStrans ()
+  bool  GdsStructure::readStrans ()
   {
-    cdebug_log(101,0) << "GdsStream::readStrans()" << endl;
-    
+    cdebug_log(101,0) << "GdsStructure::readStrans()" << endl;
+
     _angle       = 0.0;
     _xReflection = _record.hasXReflection();
     _stream >> _record;
     if (_record.isMAG  ()) { _stream >> _record; }
     if (_record.isANGLE()) { _angle = _record.getDoubles()[0]; _stream >> _record; }
 
-  //cdebug(101,0) << "GdsStream::readStrans() - return:" << _validSyntax << endl;
     return _validSyntax;
   }
 
 
-  bool  GdsStream::readBoundary ()
+  bool  GdsStructure::readBoundary ()
   {
-    cdebug_log(101,1) << "GdsStream::readBoundary()" << endl;
-    
+    cdebug_log(101,1) << "GdsStructure::readBoundary()" << endl;
+
     if (_record.isELFLAGS()) { _stream >> _record; }
     if (_record.isPLEX   ()) { _stream >> _record; }
 
@@ -1192,9 +1201,9 @@ namespace {
     }
 
     if (_record.isXY()) {
-      if (_cell and layer)
+      if (_hasName and layer and not _gstream->isFiltered(layer))
         xyToComponent( layer );
-      else if (not layer and useLayer0AsBoundary()) {
+      else if (not layer and _gstream->useLayer0AsBoundary()) {
         xyToAbutmentBox();
       }
       else
@@ -1205,15 +1214,15 @@ namespace {
       return _validSyntax;
     }
 
-    cdebug_log(101,-1) << "GdsStream::readBoundary() - return:" << _validSyntax << endl;
+    cdebug_log(101,-1) << "GdsStructure::readBoundary() - return:" << _validSyntax << endl;
     return _validSyntax;
   }
 
 
-  bool  GdsStream::readPath ()
+  bool  GdsStructure::readPath ()
   {
-    cdebug_log(101,1) << "GdsStream::readPath()" << endl;
-    
+    cdebug_log(101,1) << "GdsStructure::readPath()" << endl;
+
     DbU::Unit  width    = 0;
     uint16_t   pathtype = 0;
     DbU::Unit  bgnextn  = 0;
@@ -1229,6 +1238,7 @@ namespace {
       cdebug_tabw(101,-1);
       return _validSyntax;
     }
+    if (_gstream->isFiltered(layer)) layer = NULL;
 
     if (_record.isPATHTYPE()) {
       pathtype = _record.getInt16s()[0];
@@ -1248,23 +1258,23 @@ namespace {
     }
 
     if (_record.isXY()) {
-      if (_cell) xyToPath( pathtype, layer, width, bgnextn, endextn );
+      if (_hasName) xyToPath( pathtype, layer, width, bgnextn, endextn );
     } else {
       _validSyntax = false;
       cdebug_tabw(101,-1);
       return _validSyntax;
     }
 
-    cdebug_log(101,-1) << "GdsStream::readPath() - return:" << _validSyntax << endl;
+    cdebug_log(101,-1) << "GdsStructure::readPath() - return:" << _validSyntax << endl;
     return _validSyntax;
   }
 
 
-  bool  GdsStream::readSref ()
+  bool  GdsStructure::readSref ()
   {
-    cdebug_log(101,1) << "GdsStream::readSref()" << endl;
+    cdebug_log(101,1) << "GdsStructure::readSref()" << endl;
     resetStrans();
-    
+
     string    masterName;
     DbU::Unit xpos       = 0;
     DbU::Unit ypos       = 0;
@@ -1283,7 +1293,6 @@ namespace {
 
     if (_record.isSTRANS()) {
       readStrans();
-    //_stream >> _record;
       if (not _validSyntax) {
         cdebug_tabw(101,-1);
         return _validSyntax;
@@ -1297,7 +1306,7 @@ namespace {
         cdebug_tabw(101,-1);
         return _validSyntax;
       }
-      
+
       xpos = coordinates[ 0 ]*_scale;
       ypos = coordinates[ 1 ]*_scale;
 
@@ -1314,8 +1323,9 @@ namespace {
       else if (_angle == 180.0) orient = Transformation::Orientation::R2;
       else if (_angle == 270.0) orient = Transformation::Orientation::R3;
       else if (_angle !=   0.0) {
-        cerr << Warning( "GdsStream::readSref(): Unsupported angle %d.2 for SREF (Instance) of \"%s\""
-                       , _angle, masterName.c_str() ) << endl;
+        _message( GdsElement::WarningMessage
+                , "GdsStream::readSref(): Unsupported angle %.2f for SREF (Instance) of \"%s\""
+                , _angle, masterName.c_str() );
       }
 
       if (_xReflection) {
@@ -1325,30 +1335,25 @@ namespace {
           case Transformation::Orientation::R2: orient = Transformation::Orientation::MX; break;
           case Transformation::Orientation::R3: orient = Transformation::Orientation::XR; break;
           default:
-            cerr << Warning( "GdsStream::readSref(): Unsupported MX+Orientation (%s) combination for SREF (Instance) of \"%s\""
-                           , getString(orient).c_str(), masterName.c_str() ) << endl;
+            _message( GdsElement::WarningMessage
+                    , "GdsStream::readSref(): Unsupported MX+Orientation (%s) combination for SREF (Instance) of \"%s\""
+                    , getString(orient).c_str(), masterName.c_str() );
         }
       }
 
-      // cerr << "Delayed Instance: "  << masterName
-      //      << " XR:" << _xReflection << " angle:" << _angle
-      //      << " " << Transformation(xpos,ypos,orient)
-      //      << " in " << _cell << endl;
-      _delayedInstances.push_back( DelayedInstance( _cell
-                                                  , masterName
-                                                  , Transformation(xpos,ypos,orient)) );
+      _instances.push_back( DelayedInstance( masterName, Transformation(xpos,ypos,orient) ));
     }
 
-    cdebug_log(101,-1) << "GdsStream::readSref() - return:" << _validSyntax << endl;
+    cdebug_log(101,-1) << "GdsStructure::readSref() - return:" << _validSyntax << endl;
     return _validSyntax;
   }
 
 
-  bool  GdsStream::readAref ()
+  bool  GdsStructure::readAref ()
   {
-    cdebug_log(101,1) << "GdsStream::readAref() " << _cell << endl;
+    cdebug_log(101,1) << "GdsStructure::readAref() " << _name << endl;
     resetStrans();
-    
+
     string         masterName;
     uint16_t       columns = 0;
     uint16_t       rows    = 0;
@@ -1382,8 +1387,9 @@ namespace {
       } else if (_angle == 270.0) {
         orient = Transformation::Orientation::R3;
       } else if (_angle !=   0.0) {
-        cerr << Warning( "GdsStream::readAref(): Unsupported angle %d.2 for AREF (Instance) of \"%s\""
-                       , _angle, masterName.c_str() ) << endl;
+        _message( GdsElement::WarningMessage
+                , "GdsStream::readAref(): Unsupported angle %.2f for AREF (Instance) of \"%s\""
+                , _angle, masterName.c_str() );
       }
       if (_xReflection) {
         switch ( orient ) {
@@ -1391,9 +1397,10 @@ namespace {
           case Transformation::Orientation::R1: orient = Transformation::Orientation::XR; break;
           case Transformation::Orientation::R2: orient = Transformation::Orientation::MX; break;
           case Transformation::Orientation::R3: orient = Transformation::Orientation::YR; break;
-          default:  
-            cerr << Warning( "GdsStream::readAref(): Unsupported MX+Orientation (%s) combination for AREF (Instance) of \"%s\""
-                           , getString(orient).c_str(), masterName.c_str() ) << endl;
+          default:
+            _message( GdsElement::WarningMessage
+                    , "GdsStream::readAref(): Unsupported MX+Orientation (%s) combination for AREF (Instance) of \"%s\""
+                    , getString(orient).c_str(), masterName.c_str() );
         }
       }
     }
@@ -1416,9 +1423,9 @@ namespace {
     }
 
     if (_record.isXY()) {
-      if (_cell) {
-        DbU::Unit       oneGrid = DbU::fromGrid( 1 );
-        const vector<int32_t> coordinates = _record.getInt32s();
+      if (_hasName) {
+        DbU::Unit              oneGrid     = DbU::fromGrid( 1 );
+        const vector<int32_t>& coordinates = _record.getInt32s();
         if (coordinates.size() != 6) {
           _validSyntax = false;
           cdebug_tabw(101,-1);
@@ -1427,10 +1434,11 @@ namespace {
         origin.setX(coordinates[0] * _scale);
         origin.setY(coordinates[1] * _scale);
         if ( (origin.getX() % oneGrid) or (origin.getY() % oneGrid) ) {
-          cerr << Error( "GdsStream::readAref(): Offgrid (%s, %s) origin point (foundry grid: %s).\n"
-                       , DbU::getValueString(origin.getX()).c_str()
-                       , DbU::getValueString(origin.getY()).c_str()
-                       , DbU::getValueString(oneGrid).c_str() ) << endl;
+          _message( GdsElement::ErrorMessage
+                  , "GdsStream::readAref(): Offgrid (%s, %s) origin point (foundry grid: %s).\n"
+                  , DbU::getValueString(origin.getX()).c_str()
+                  , DbU::getValueString(origin.getY()).c_str()
+                  , DbU::getValueString(oneGrid).c_str() );
         }
         else {
           cdebug_log(101,0) << "arrayOrigin: " << origin << endl;
@@ -1446,11 +1454,13 @@ namespace {
                           << DbU::getValueString(vy.getX())
                           << DbU::getValueString(vy.getY()) << ")" << endl;
         if (not vx.getX() and not vx.getY() and (columns > 1))
-            cerr << Error( "GdsStream::readAref(): Null dx, but more than one column (%d)."
-                        , columns ) << endl;
+          _message( GdsElement::ErrorMessage
+                  , "GdsStream::readAref(): Null dx, but more than one column (%d)."
+                  , columns );
         if (not vy.getX() and not vy.getY() and (rows > 1))
-            cerr << Error( "GdsStream::readAref(): Null dy, but more than one row (%d)."
-                        , rows ) << endl;
+          _message( GdsElement::ErrorMessage
+                  , "GdsStream::readAref(): Null dy, but more than one row (%d)."
+                  , rows );
       }
       _stream >> _record;
     } else {
@@ -1459,44 +1469,44 @@ namespace {
       return _validSyntax;
     }
 
-    if (_cell) {
+    if (_hasName) {
       for ( uint32_t column=0 ; column < (uint32_t)columns ; ++column ) {
         for ( uint32_t row=0 ; row < (uint32_t)rows ; ++row ) {
           DbU::Unit xpos = origin.getX() + column*vx.getX() + row*vy.getX();
           DbU::Unit ypos = origin.getY() + column*vx.getY() + row*vy.getY();
           Transformation itemTransf = Transformation( xpos, ypos, orient );
-          
+
           cdebug_log(101,0) << "column=" << column
                             << " row="   << row
                             << " x=" << DbU::getValueString(xpos)
                             << " y=" << DbU::getValueString(ypos)
                             << " orient=" << orient
                             << " transf=" << itemTransf << endl;
-          _delayedInstances.push_back( DelayedInstance( _cell, masterName, itemTransf ));
+          _instances.push_back( DelayedInstance( masterName, itemTransf ));
         }
       }
     }
 
-    cdebug_log(101,-1) << "GdsStream::readAref() - return:" << _validSyntax << endl;
+    cdebug_log(101,-1) << "GdsStructure::readAref() - return:" << _validSyntax << endl;
     return _validSyntax;
   }
 
 
-  bool  GdsStream::readNode ()
+  bool  GdsStructure::readNode ()
   {
-    cdebug_log(101,0) << "GdsStream::readNode()" << endl;
-    
+    cdebug_log(101,0) << "GdsStructure::readNode()" << endl;
+
     const Layer* layer = NULL;
 
     if (_record.isELFLAGS()) { _stream >> _record; }
     if (_record.isPLEX   ()) { _stream >> _record; }
 
     if (_record.isLAYER  ()) {
-      layer = gdsToLayer( (uint16_t)_record.getInt16s()[0], 0 );
+      layer = GdsStream::gdsToLayer( (uint16_t)_record.getInt16s()[0], 0 );
       if (not layer) {
-        cerr << Error( "GdsStream::readNode(): No BasicLayer id \"%d\" in GDS conversion table (skipped)."
-                     , _record.getInt16s()[0]
-                     ) << endl;
+        _message( GdsElement::ErrorMessage
+                , "GdsStream::readNode(): No BasicLayer id \"%d\" in GDS conversion table (skipped)."
+                , _record.getInt16s()[0] );
       }
       _stream >> _record;
       cdebug_log(101,0) << layer << endl;
@@ -1510,32 +1520,32 @@ namespace {
     }
 
     if (_record.isXY()) {
-      if (_cell and layer) xyToComponent( layer );
+      if (_hasName and layer and not _gstream->isFiltered(layer)) xyToComponent( layer );
       _stream >> _record;
     } else {
       _validSyntax = false; return _validSyntax;
     }
 
-    cdebug_log(101,0) << "GdsStream::readNode() - return:" << _validSyntax << endl;
+    cdebug_log(101,0) << "GdsStructure::readNode() - return:" << _validSyntax << endl;
     return _validSyntax;
   }
 
 
-  bool  GdsStream::readBox ()
+  bool  GdsStructure::readBox ()
   {
-    cdebug_log(101,0) << "GdsStream::readBox()" << endl;
-    
+    cdebug_log(101,0) << "GdsStructure::readBox()" << endl;
+
     const Layer* layer = NULL;
 
     if (_record.isELFLAGS()) { _stream >> _record; }
     if (_record.isPLEX   ()) { _stream >> _record; }
 
     if (_record.isLAYER  ()) {
-      layer = gdsToLayer( (uint16_t)_record.getInt16s()[0], 0 );
+      layer = GdsStream::gdsToLayer( (uint16_t)_record.getInt16s()[0], 0 );
       if (not layer) {
-        cerr << Error( "GdsStream::readNode(): No BasicLayer id \"%d\" in GDS conversion table (skipped)."
-                     , _record.getInt16s()[0]
-                     ) << endl;
+        _message( GdsElement::ErrorMessage
+                , "GdsStream::readNode(): No BasicLayer id \"%d\" in GDS conversion table (skipped)."
+                , _record.getInt16s()[0] );
       }
       _stream >> _record;
       cdebug_log(101,0) << layer << endl;
@@ -1549,47 +1559,58 @@ namespace {
     }
 
     if (_record.isXY()) {
-      if (_cell and layer) xyToComponent( layer );
+      if (_hasName and layer and not _gstream->isFiltered(layer)) xyToComponent( layer );
       _stream >> _record;
     } else {
       _validSyntax = false; return _validSyntax;
     }
 
-    cdebug_log(101,0) << "GdsStream::readBox() - return:" << _validSyntax << endl;
+    cdebug_log(101,0) << "GdsStructure::readBox() - return:" << _validSyntax << endl;
     return _validSyntax;
   }
 
 
-  bool  GdsStream::readProperty ()
+  bool  GdsStructure::readProperty ()
   {
-    cdebug_log(101,0) << "GdsStream::readProperty()" << endl;
-    
+    cdebug_log(101,0) << "GdsStructure::readProperty()" << endl;
+
     if (_record.isPROPVALUE  ()) { _stream >> _record; }
     else { _validSyntax = false; return _validSyntax; }
 
-    cdebug_log(101,0) << "GdsStream::readProperty() - return:" << _validSyntax << endl;
+    cdebug_log(101,0) << "GdsStructure::readProperty() - return:" << _validSyntax << endl;
     return _validSyntax;
   }
 
 
-  void  GdsStream::xyToAbutmentBox ()
+  void  GdsStructure::xyToPoints ()
+  {
+    const vector<int32_t>& coordinates = _record.getInt32s();
+    for ( size_t i=0 ; i+1<coordinates.size() ; i += 2 ) {
+      _points.push_back( Point( coordinates[i  ]*_scale
+                              , coordinates[i+1]*_scale ) );
+    }
+    _elements.back()._pointCount = _points.size() - _elements.back()._firstPoint;
+  }
+
+
+  void  GdsStructure::xyToAbutmentBox ()
   {
     DbU::Unit oneGrid = DbU::fromGrid( 1 );
-    
-    vector<Point>   points;
-    vector<int32_t> coordinates = _record.getInt32s();
-    vector<size_t>  offgrids;
-    for ( size_t i=0 ; i<coordinates.size() ; i += 2 ) {
-      points.push_back( Point( coordinates[i  ]*_scale
-                             , coordinates[i+1]*_scale ) );
-      if ( (points.back().getX() % oneGrid) or (points.back().getX() % oneGrid) ) {
-        offgrids.push_back( i );
+
+    GdsElement& element = _addElement( GdsElement::AbutmentBox, NULL );
+    xyToPoints();
+
+    const Point*   points = getPoints( element );
+    vector<size_t> offgrids;
+    for ( size_t i=0 ; i<element._pointCount ; ++i ) {
+      if ( (points[i].getX() % oneGrid) or (points[i].getX() % oneGrid) ) {
+        offgrids.push_back( 2*i );
       }
     }
     if (not offgrids.empty()) {
       size_t offgrid = 0;
       ostringstream m;
-      for ( size_t i=0 ; i<points.size() ; ++i ) {
+      for ( size_t i=0 ; i<element._pointCount ; ++i ) {
         if (i) m << "\n";
         m << "        | " << points[i];
         if ((offgrid < offgrids.size()) and (i == offgrid)) {
@@ -1597,63 +1618,63 @@ namespace {
           ++offgrid;
         }
       }
-      cerr << Error( "GdsStream::xyToComponent(): Offgrid points on abutment box (foundry grid: %s).\n"
-                     "%s"
-                   , DbU::getValueString(oneGrid).c_str()
-                   , m.str().c_str() ) << endl;
-    } 
+    // The message must come *before* the element.
+      GdsElement abutmentBox = element;
+      _elements.pop_back();
+      _message( GdsElement::ErrorMessage
+              , "GdsStream::xyToComponent(): Offgrid points on abutment box (foundry grid: %s).\n"
+                "%s"
+              , DbU::getValueString(oneGrid).c_str()
+              , m.str().c_str() );
+      _elements.push_back( abutmentBox );
+    }
 
     _stream >> _record;
 
     if (  (_record.getType() == GdsRecord::ENDEL)
        or (_record.getType() == GdsRecord::STRING)) {
-    //_stream >> _record;
+      _skipENDEL = true;
     } else {
       _validSyntax = false;
+      _points.resize( _elements.back()._firstPoint );
+      _elements.pop_back();
       return;
     }
-    
-    if (_record.getType() == GdsRecord::TEXT) {
-      _stream >> _record;
-      readText();
-    } else
-      _skipENDEL = true;
 
     bool isRectilinear = true;
-    for ( size_t i=1 ; i<points.size() ; ++i ) {
-      if (   (points[i-1].getX() != points[i].getX()) 
+    points = getPoints( _elements.back() );
+    for ( size_t i=1 ; i<_elements.back()._pointCount ; ++i ) {
+      if (   (points[i-1].getX() != points[i].getX())
          and (points[i-1].getY() != points[i].getY()) ) {
         isRectilinear = false;
         break;
       }
     }
-    if (isRectilinear and (points.size() == 5)) {
-      Box ab; 
-      for ( Point p : points ) ab.merge( p );
-      _cell->setAbutmentBox( ab );
-      cdebug_log(101,0) << "| Abutment box =" << ab << endl;
+    if (not isRectilinear or (_elements.back()._pointCount != 5)) {
+      _points.resize( _elements.back()._firstPoint );
+      _elements.pop_back();
     }
   }
 
 
-  void  GdsStream::xyToComponent ( const Layer* layer )
+  void  GdsStructure::xyToComponent ( const Layer* layer )
   {
     DbU::Unit oneGrid = DbU::fromGrid( 1 );
-    
-    vector<Point>   points;
-    vector<int32_t> coordinates = _record.getInt32s();
-    vector<size_t>  offgrids;
-    for ( size_t i=0 ; i<coordinates.size() ; i += 2 ) {
-      points.push_back( Point( coordinates[i  ]*_scale
-                             , coordinates[i+1]*_scale ) );
-      if ( (points.back().getX() % oneGrid) or (points.back().getX() % oneGrid) ) {
-        offgrids.push_back( i );
+
+    GdsElement& element = _addElement( GdsElement::Boundary, layer );
+    xyToPoints();
+
+    const Point*   points = getPoints( element );
+    vector<size_t> offgrids;
+    for ( size_t i=0 ; i<element._pointCount ; ++i ) {
+      if ( (points[i].getX() % oneGrid) or (points[i].getX() % oneGrid) ) {
+        offgrids.push_back( 2*i );
       }
     }
     if (not offgrids.empty()) {
       size_t offgrid = 0;
       ostringstream m;
-      for ( size_t i=0 ; i<points.size() ; ++i ) {
+      for ( size_t i=0 ; i<element._pointCount ; ++i ) {
         if (i) m << "\n";
         m << "        | " << points[i];
         if ((offgrid < offgrids.size()) and (i == offgrid)) {
@@ -1661,112 +1682,486 @@ namespace {
           ++offgrid;
         }
       }
-      cerr << Error( "GdsStream::xyToComponent(): Offgrid points on layer \"%s\" (foundry grid: %s).\n"
-                     "%s"
-                   , getString(layer->getName()).c_str()
-                   , DbU::getValueString(oneGrid).c_str()
-                   , m.str().c_str() ) << endl;
-    } 
+      GdsElement boundary = element;
+      _elements.pop_back();
+      _message( GdsElement::ErrorMessage
+              , "GdsStream::xyToComponent(): Offgrid points on layer \"%s\" (foundry grid: %s).\n"
+                "%s"
+              , getString(layer->getName()).c_str()
+              , DbU::getValueString(oneGrid).c_str()
+              , m.str().c_str() );
+      _elements.push_back( boundary );
+    }
 
     _stream >> _record;
 
     if (  (_record.getType() == GdsRecord::ENDEL)
        or (_record.getType() == GdsRecord::STRING)) {
-    //_stream >> _record;
+      _skipENDEL = true;
     } else {
       _validSyntax = false;
+      _points.resize( _elements.back()._firstPoint );
+      _elements.pop_back();
       return;
     }
-    
-    Net* net = NULL;
-    if (_record.getType() == GdsRecord::TEXT) {
-      _stream >> _record;
-      readText();
-
-      if (not _text.empty()) {
-        net = _cell->getNet( _text );
-        if (not net) {
-          net = Net::create( _cell, _text );
-          net->setExternal( true );
-          if (_text.substr(0,3) == "vdd")     net->setType  ( Net::Type::POWER );
-          if (_text.substr(0,3) == "gnd")     net->setType  ( Net::Type::GROUND );
-          if (_text[ _text.size()-1 ] == '!') net->setGlobal( true );
+
+    if (layer->isBlockage() and not _gstream->useBlockages()) {
+      _points.resize( _elements.back()._firstPoint );
+      _elements.pop_back();
+    }
+  }
+
+
+  void  GdsStructure::xyToPath ( uint16_t     pathtype
+                               , const Layer* layer
+                               , DbU::Unit    width
+                               , DbU::Unit    bgnextn
+                               , DbU::Unit    endextn )
+  {
+    cdebug_log(101,0) << "GdsStructure::xyToPath(): pathtype=" << pathtype
+                      << " layer=" << ((layer) ? layer->getName() : "N/A")
+                      << " width=" << DbU::getValueString(width)
+                      << " bgnextn=" << DbU::getValueString(bgnextn)
+                      << " endextn=" << DbU::getValueString(endextn) << endl;
+    if (bgnextn < 0) {
+      _message( GdsElement::ErrorMessage
+              , "GdsStream::xyToPath(): Negative BGNEXTN not supported yet (%s) layout will be incorrect."
+              , DbU::getValueString(bgnextn).c_str() );
+    }
+    if (endextn < 0) {
+      _message( GdsElement::ErrorMessage
+              , "GdsStream::xyToPath(): Negative ENDEXTN not supported yet (%s) layout will be incorrect."
+              , DbU::getValueString(endextn).c_str() );
+    }
+
+    GdsElement& element = _addElement( GdsElement::Path, layer );
+    element._pathtype = pathtype;
+    element._width    = width;
+    element._bgnextn  = bgnextn;
+    element._endextn  = endextn;
+    xyToPoints();
+
+    _stream >> _record;
+    if ((_record.getType() != GdsRecord::ENDEL) or not layer or (element._pointCount < 2)) {
+      if (_record.getType() != GdsRecord::ENDEL) _validSyntax = false;
+      _points.resize( element._firstPoint );
+      _elements.pop_back();
+    }
+  }
+
+
+// -------------------------------------------------------------------
+// Class  :  "::GdsStream" (implementation).
+
+
+  map<uint32_t,const Layer*>  GdsStream::_gdsLayerTable;
+
+
+  void  GdsStream::_staticInit ()
+  {
+    for ( const BasicLayer* layer : DataBase::getDB()->getTechnology()->getBasicLayers() ) {
+      if (layer->hasGds()) {
+        uint32_t gdsNumber = (layer->getGds2Layer() << 16) + layer->getGds2Datatype();
+        _gdsLayerTable[gdsNumber] = layer;
+      }
+    }
+  }
+
+
+  const Layer* GdsStream::gdsToLayer ( uint16_t gdsLayer, uint16_t datatype )
+  {
+    uint32_t gdsIndex = (gdsLayer << 16) + datatype;
+    auto ilayer = _gdsLayerTable.find( gdsIndex );
+    if (ilayer == _gdsLayerTable.end())
+      return NULL;
+    return (*ilayer).second;
+  }
+
+
+  GdsStream::GdsStream ( string gdsPath, uint32_t flags, const set<string>& layersFilter )
+    : _structures      ()
+    , _cells           ()
+    , _layersFilter    ()
+    , _useFilter       (not layersFilter.empty())
+    , _flags           (flags)
+    , _gdsPath         (gdsPath)
+    , _fd              (-1)
+    , _mapped          (NULL)
+    , _size            (0)
+    , _uncompressed    ()
+    , _base            (NULL)
+    , _end             (NULL)
+    , _stream          ()
+    , _record          ()
+    , _library         (NULL)
+    , _cell            (NULL)
+    , _scale           (1)
+    , _SREFCount       (0)
+    , _validSyntax     (true)
+  {
+    if (_gdsLayerTable.empty()) _staticInit();
+
+    if (_useFilter) {
+      Technology* technology = DataBase::getDB()->getTechnology();
+      for ( const string& name : layersFilter ) {
+        const Layer* layer = technology->getLayer( name );
+        if (not layer) {
+          cerr << Warning( "GdsStream::GdsStream(): No layer \"%s\" in the Technology, ignored in the layers filter."
+                         , name.c_str() ) << endl;
+          continue;
         }
+        for ( const BasicLayer* basicLayer : layer->getBasicLayers() )
+          _layersFilter.insert( basicLayer );
       }
-    } else
-      _skipENDEL = true;
+    // The labels on "<layer>.pin" goes along with "<layer>".
+      for ( auto item : _gdsLayerTable ) {
+        string layerName = getString( item.second->getName() );
+        if ((layerName.size() > 4) and layerName.substr(layerName.size()-4) == ".pin") {
+          const Layer* layer = technology->getLayer( layerName.substr(0,layerName.size()-4) );
+          if (layer and _layersFilter.count(layer)) _layersFilter.insert( item.second );
+        }
+      }
+    }
 
-    if (layer->isBlockage() and (_flags & Gds::NoBlockages))
+    bool compressed = (gdsPath.size() > 3) and (gdsPath.substr(gdsPath.size()-3) == ".gz");
+    if (not ((compressed) ? _uncompress() : _map())) {
+      cerr << Error( "GdsStream::GdsStream(): Unable to open stream, check path.\n"
+                     "        \"%s\""
+                   , _gdsPath.c_str() ) << endl;
+      _validSyntax = false;
       return;
+    }
+
+    _stream = GdsCursor( _base, _base, _end );
+    _stream >> _record;
+    if (not _record.isHEADER()) {
+      cerr << Error( "GdsStream::GdsStream(): First record is not a HEADER.\n"
+                     "        in \"%s\""
+                   , _gdsPath.c_str() ) << endl;
+      _validSyntax = false;
+      return;
+    }
+    _stream >> _record;
+  }
+
+
+  GdsStream::~GdsStream ()
+  {
+    if (_mapped) munmap( _mapped, _size );
+    if (_fd >= 0) close( _fd );
+  }
+
+
+  bool  GdsStream::_map ()
+  {
+    _fd = open( _gdsPath.c_str(), O_RDONLY );
+    if (_fd < 0) return false;
+
+    struct stat status;
+    if ((fstat(_fd,&status) < 0) or (status.st_size == 0)) return false;
+
+    _mapped = mmap( NULL, status.st_size, PROT_READ, MAP_PRIVATE, _fd, 0 );
+    if (_mapped == MAP_FAILED) {
+      _mapped = NULL;
+      return false;
+    }
+    _size = status.st_size;
+    madvise( _mapped, _size, MADV_WILLNEED );
+
+    _base = static_cast<const char*>( _mapped );
+    _end  = _base + _size;
+    return true;
+  }
+
+
+  bool  GdsStream::_uncompress ()
+  {
+    const size_t  chunkSize = 1 << 22;
+
+    gzFile file = gzopen( _gdsPath.c_str(), "rb" );
+    if (not file) return false;
+    gzbuffer( file, 1 << 17 );
+
+    int bytes = 0;
+    do {
+      size_t size = _uncompressed.size();
+      _uncompressed.resize( size + chunkSize );
+      bytes = gzread( file, _uncompressed.data()+size, chunkSize );
+      _uncompressed.resize( size + ((bytes > 0) ? bytes : 0) );
+    } while ( bytes > 0 );
+
+  // A truncated stream is only reported through gzerror().
+    int    gzError = Z_OK;
+    string message = gzerror( file, &gzError );
+    gzclose( file );
+
+    if ((bytes < 0) or (gzError != Z_OK)) {
+      cerr << Error( "GdsStream::_uncompress(): gzip error \"%s\" on \"%s\"."
+                   , message.c_str(), _gdsPath.c_str() ) << endl;
+      return false;
+    }
+
+    _base = _uncompressed.data();
+    _end  = _base + _uncompressed.size();
+    return true;
+  }
+
+
+  Cell* GdsStream::getCell ( string cellName, bool create )
+  {
+    if (not _library) return nullptr;
+    Library* workLibrary = _library;
+    Cell*    cell        = workLibrary->getCell( cellName );
+    if (cell) return cell;
+
+    if (not Gds::getTopCellName().empty() and (cellName != Gds::getTopCellName())) {
+      cellName.insert( 0, "." );
+      cellName.insert( 0, Gds::getTopCellName() );
+      workLibrary = _library->getLibrary( Gds::getTopCellName() );
+      if (workLibrary) {
+        cell = workLibrary->getCell( cellName );
+        if (cell) return cell;
+      } else {
+        if (not create) return nullptr;
+        workLibrary = Library::create( _library, Gds::getTopCellName() );
+      }
+    }
+
+    if (not create) return nullptr;
+
+    cparanoid << Warning( "GdsStream::readStructure(): No Cell named \"%s\" in Library \"%s\" (created)."
+                        , cellName.c_str()
+                        , getString(_library).c_str()
+                        ) << endl;
+    _cells.push_back( Cell::create( workLibrary, cellName ));
+    return _cells.back();
+  }
+
+
+  bool  GdsStream::misplacedRecord ()
+  {
+    cerr << Error( "GdsStream: Misplaced record %s.\n"
+                 "        in \"%s\""
+                 , GdsRecord::toStrType(_record.getType()).c_str()
+                 , _gdsPath.c_str() ) << endl;
+    _validSyntax = false;
+    return _validSyntax;
+  }
+
+
+  bool  GdsStream::read ( Library* library, size_t threads )
+  {
+    cdebug_log(101,1) << "GdsStream::read(Library*)" << endl;
+
+    if (not _validSyntax) {
+      cdebug_tabw(101,-1);
+      return _validSyntax;
+    }
+
+    _library = library;
+
+    if (not _record.isBGNLIB()) {
+      cerr << Error( "GdsStream::read(Library*): Starting record is not a BGNLIB.\n"
+                     "        in \"%s\""
+                   , _gdsPath.c_str() ) << endl;
+      _validSyntax = false;
+      cdebug_tabw(101,-1);
+      return _validSyntax;
+    }
+    _stream >> _record;
 
-    if (not net) net = fusedNet();
-    
-    if (points.size() > 2) {
-      bool isRectilinear = true;
-      for ( size_t i=1 ; i<points.size() ; ++i ) {
-        if (   (points[i-1].getX() != points[i].getX()) 
-           and (points[i-1].getY() != points[i].getY()) ) {
-          isRectilinear = false;
+    if (_record.isLIBDIRSIZE ()) { _stream >> _record; }
+    if (_record.isSRFNAME    ()) { _stream >> _record; }
+    if (_record.isLIBSECUR   ()) { _stream >> _record; }
+    if (_record.isLIBNAME    ()) { _stream >> _record; }
+    else {
+      cerr << Error( "GdsStream::read(Library*): Missing LIBNAME record.\n"
+                     "        in \"%s\""
+                   , _gdsPath.c_str() ) << endl;
+      _validSyntax = false;
+      cdebug_tabw(101,-1);
+      return _validSyntax;
+    }
+    if (_record.isREFLIBS    ()) { _stream >> _record; }
+    if (_record.isFONTS      ()) { _stream >> _record; }
+    if (_record.isATTRTABLE  ()) { _stream >> _record; }
+    if (_record.isGENERATIONS()) { _stream >> _record; }
+    if (_record.isFORMAT     ()) {
+      readFormatType();
+      if (not _validSyntax) {
+        cdebug_tabw(101,-1);
+        return _validSyntax;
+      }
+    }
+
+    if (_record.isUNITS()) {
+      _scale = DbU::fromPhysical( _record.getDoubles()[1], DbU::Unity );
+      _stream >> _record;
+    }
+
+    indexStructures();
+
+    ThreadPool pool  ( threads );
+    size_t     count = 0;
+    for ( size_t batch=0 ; _validSyntax and (batch<_structures.size()) ; batch += StructuresPerBatch ) {
+      size_t batchSize = std::min( _structures.size()-batch, StructuresPerBatch );
+      pool.run( batchSize, [&]( size_t i, size_t ) { _structures[ batch+i ].decode(); } );
+
+      for ( size_t i=batch ; i<batch+batchSize ; ++i ) {
+        build( _structures[i] );
+        ++count;
+        if (not _structures[i].isValidSyntax()) {
+          _validSyntax = false;
           break;
         }
       }
+    }
+    _structures.erase( _structures.begin()+count, _structures.end() );
 
-      if (isRectilinear and (points.size() == 5)) {
-        Box boundingBox; 
-        for ( Point p : points ) boundingBox.merge( p );
-        _component = Pad::create( net, layer, boundingBox );
-      } else {
-        _component = Rectilinear::create( net, layer, points );
+    if (_validSyntax and not _record.isENDLIB()) { misplacedRecord(); }
+
+    if (_validSyntax) {
+      vector<size_t> order;
+      sortStructures( order );
+      for ( size_t i : order ) makeInstances( _structures[i] );
+      makeExternals();
+    }
+
+    for ( Cell* cell : _cells ) {
+      if (not useLayer0AsBoundary() or cell->getAbutmentBox().isEmpty()) {
+        cell->setAbutmentBox( cell->getBoundingBox() );
+      }
+    }
+
+    _library = NULL;
+    cdebug_log(101,-1) << "    GdsStream::read(Library*) - return:" << _validSyntax << endl;
+    return _validSyntax;
+  }
+
+
+  bool  GdsStream::readFormatType ()
+  {
+    cdebug_log(101,0) << "GdsStream::readFormatType()" << endl;
+
+    if (_record.isMASK()) {
+      _stream >> _record;
+      while ( _record.isMASK() ) {
+        _stream >> _record;
       }
-      // cdebug_log(101,0) << "| " << net->getCell() << endl;
-      cdebug_log(101,0) << "| " << _component << endl;
 
-      if (not net->isAutomatic()) NetExternalComponents::setExternal( _component );
+      if (_record.isENDMASKS()) { _stream >> _record; }
+      else { _validSyntax = false; return _validSyntax; }
     }
+
+    return _validSyntax;
   }
 
 
-  void  GdsStream::xyToPath ( uint16_t     pathtype
-                            , const Layer* layer
-                            , DbU::Unit    width
-                            , DbU::Unit    bgnextn
-                            , DbU::Unit    endextn )
+  void  GdsStream::indexStructures ()
   {
-    cdebug_log(101,0) << "GdsStream::xyToPath(): pathtype=" << pathtype
-                      << " layer=" << ((layer) ? layer->getName() : "N/A")
-                      << " width=" << DbU::getValueString(width)
-                      << " bgnextn=" << DbU::getValueString(bgnextn)
-                      << " endextn=" << DbU::getValueString(endextn) << endl;
-    if (bgnextn < 0) {
-      cerr << Error( "GdsStream::xyToPath(): Negative BGNEXTN not supported yet (%s) layout will be incorrect."
-                   , DbU::getValueString(bgnextn).c_str()
-                   ) << endl;
+    cdebug_log(101,1) << "GdsStream::indexStructures()" << endl;
+
+    while ( _record.isBGNSTR() ) {
+      const char* begin = _stream.getCurrent();
+      const char* end   = begin;
+      while ( true ) {
+        if (_end - end < 4) { end = _end; break; }
+        uint16_t length = GdsRecord::peekLength( end );
+        uint16_t type   = GdsRecord::peekType  ( end );
+        if ((length < 4) or (length > _end - end)) { end = _end; break; }
+        end += length;
+        if (type == GdsRecord::ENDSTR) break;
+      }
+      _structures.push_back( GdsStructure( this, _base, begin, end ) );
+      _stream.seek( end );
+      _stream >> _record;
     }
-    if (endextn < 0) {
-      cerr << Error( "GdsStream::xyToPath(): Negative ENDEXTN not supported yet (%s) layout will be incorrect."
-                   , DbU::getValueString(endextn).c_str()
-                   ) << endl;
+
+    cdebug_log(101,-1) << "GdsStream::indexStructures() - " << _structures.size() << " structures." << endl;
+  }
+
+
+  void  GdsStream::build ( GdsStructure& structure )
+  {
+    cdebug_log(101,1) << "GdsStream::build() \"" << structure.getName() << "\"" << endl;
+
+    _cell = NULL;
+    if (structure.hasName()) {
+      _cell = getCell( structure.getName(), true );
+      structure.setCell( _cell );
+    }
+
+    for ( const GdsElement& element : structure.getElements() ) {
+      switch ( element._type ) {
+        case GdsElement::ErrorMessage:   cerr << Error  ( element._text ) << endl; break;
+        case GdsElement::WarningMessage: cerr << Warning( element._text ) << endl; break;
+        case GdsElement::AbutmentBox: {
+          if (not _cell) break;
+          Box          ab;
+          const Point* points = structure.getPoints( element );
+          for ( size_t i=0 ; i<element._pointCount ; ++i ) ab.merge( points[i] );
+          _cell->setAbutmentBox( ab );
+          cdebug_log(101,0) << "| Abutment box =" << ab << endl;
+          break;
+        }
+        case GdsElement::Boundary: makeComponent( structure, element ); break;
+        case GdsElement::Path:     makePath     ( structure, element ); break;
+        case GdsElement::Text:     makeText     ( structure, element ); break;
+      }
     }
+    structure.release();
 
-    vector<Point>   points;
-    vector<int32_t> coordinates = _record.getInt32s();
-    for ( size_t i=0 ; i<coordinates.size() ; i += 2 )
-      points.push_back( Point( coordinates[i  ]*_scale
-                             , coordinates[i+1]*_scale ) );
-    _stream >> _record;
-    if (_record.getType() != GdsRecord::ENDEL) {
-      _validSyntax = false;
-      return;
+    _cell = NULL;
+    cdebug_tabw(101,-1);
+  }
+
+
+  void  GdsStream::makeComponent ( const GdsStructure& structure, const GdsElement& element )
+  {
+    Net* net = fusedNet();
+    if (element._pointCount <= 2) return;
+
+    const Point* points        = structure.getPoints( element );
+    bool         isRectilinear = true;
+    for ( size_t i=1 ; i<element._pointCount ; ++i ) {
+      if (   (points[i-1].getX() != points[i].getX())
+         and (points[i-1].getY() != points[i].getY()) ) {
+        isRectilinear = false;
+        break;
+      }
     }
-    if (not layer) return;
+
+    Component* component = NULL;
+    if (isRectilinear and (element._pointCount == 5)) {
+      Box boundingBox;
+      for ( size_t i=0 ; i<5 ; ++i ) boundingBox.merge( points[i] );
+      component = Pad::create( net, element._layer, boundingBox );
+    } else {
+      component = Rectilinear::create( net
+                                     , element._layer
+                                     , vector<Point>( points, points+element._pointCount ) );
+    }
+    cdebug_log(101,0) << "| " << component << endl;
+  }
+
+
+  void  GdsStream::makePath ( const GdsStructure& structure, const GdsElement& element )
+  {
+    const Layer*  layer    = element._layer;
+    uint16_t      pathtype = element._pathtype;
+    DbU::Unit     width    = element._width;
+    DbU::Unit     bgnextn  = element._bgnextn;
+    DbU::Unit     endextn  = element._endextn;
+    const Point*  points   = structure.getPoints( element );
+    size_t        size     = element._pointCount;
 
     Net* net = fusedNet();
 
     cdebug_log(101,0) << "Points" << endl;
     cdebug_log(101,0) << " 0 | " << points[0] << endl;
-    for ( size_t i=1 ; i<points.size() ; ++i ) {
+    for ( size_t i=1 ; i<size ; ++i ) {
       cdebug_log(101,0) << " " << i << " | " << points[i] << endl;
-      if (   (points[i-1].getX() != points[i].getX()) 
+      if (   (points[i-1].getX() != points[i].getX())
          and (points[i-1].getY() != points[i].getY()) ) {
         cerr << Error( "GdsStream::xyToPath(): Non-rectilinear paths are not supporteds (skipped)."
                      ) << endl;
@@ -1818,12 +2213,12 @@ namespace {
     cdebug_log(101,0) << "+ " << source << endl;
     Contact* target  = NULL;
     Segment* segment = NULL;
-    for ( size_t i=1 ; i<points.size() ; ++i ) {
+    for ( size_t i=1 ; i<size ; ++i ) {
       hWidthCap = width;
       vWidthCap = width;
       xadjust   = 0;
       yadjust   = 0;
-      if (i == points.size()-1) {
+      if (i == size-1) {
         if (pathtype == 0) {
           if (points[i].getX() == points[i-1].getX()) vWidthCap = 0;
           else                                        hWidthCap = 0;
@@ -1876,29 +2271,98 @@ namespace {
                                   , target->getY() );
       }
       cdebug_log(101,0) << "| " << segment << endl;
-      if (not net->isAutomatic()) NetExternalComponents::setExternal( segment );
       source = target;
     }
   }
 
 
-  void  GdsStream::makeInstances ()
+  void  GdsStream::makeText ( const GdsStructure& structure, const GdsElement& element )
   {
-    cdebug_log(101,1) << "GdsStream::makeInstances(): " << endl;
+    if (not _cell) return;
+
+    const string&     text       = element._text;
+    const Point&      position   = structure.getPoints( element )[0];
+    const BasicLayer* basicLayer = static_cast<const BasicLayer*>( element._layer );
+    if (   (basicLayer->getMaterial() != BasicLayer::Material::other)
+       and (basicLayer->getMaterial() != BasicLayer::Material::info ) ) {
+      Net* net = _cell->getNet( text );
+      if (not net) {
+        net = Net::create( _cell, text );
+        net->setExternal( true );
+        if (text.substr(0,3) == "vdd")    net->setType  ( Net::Type::POWER );
+        if (text.substr(0,3) == "gnd")    net->setType  ( Net::Type::GROUND );
+        if (text[ text.size()-1 ] == '!') net->setGlobal( true );
+      }
+      addNetReference( net, element._layer, position.getX(), position.getY() );
+    } else {
+      DbU::Unit textHeight = _scale * 500;
+      DbU::Unit textWidth  = _scale * 500 * text.size();
+      Text::create( _cell, element._layer, Box( position.getX()
+                                              , position.getY()
+                                              , position.getX() + textWidth
+                                              , position.getY() + textHeight
+                                              ), text );
+    }
+  }
 
-    for ( const DelayedInstance& di : _delayedInstances ) {
-      Cell* masterCell = getCell( di._masterName );
 
-      if (masterCell) {
-        string    insName  = "sref_" + getString(_SREFCount++);
+  void  GdsStream::sortStructures ( vector<size_t>& order )
+  {
+    cdebug_log(101,1) << "GdsStream::sortStructures()" << endl;
+
+  // Masters are resolved and instances numbered in file order.
+    unordered_map< Cell*, vector<size_t> >  structuresOf;
+    for ( size_t i=0 ; i<_structures.size() ; ++i ) {
+      if (_structures[i].getCell())
+        structuresOf[ _structures[i].getCell() ].push_back( i );
+      for ( DelayedInstance& di : _structures[i].getInstances() ) {
+        di._master = getCell( di._masterName );
+        if (di._master) di._index = _SREFCount++;
+      }
+    }
+
+    vector<uint8_t> states ( _structures.size(), 0 );
+    for ( size_t i=0 ; i<_structures.size() ; ++i ) _visit( i, states, structuresOf, order );
+
+    cdebug_tabw(101,-1);
+  }
+
+
+  void  GdsStream::_visit ( size_t                                         i
+                          , vector<uint8_t>&                               states
+                          , const unordered_map< Cell*, vector<size_t> >&  structuresOf
+                          , vector<size_t>&                                order )
+  {
+  // Depth first, masters first. A recursive hierarchy is left to
+  // Instance::create() to report.
+    if (states[i]) return;
+    states[i] = 1;
+    for ( const DelayedInstance& di : _structures[i].getInstances() ) {
+      if (not di._master) continue;
+      auto istructures = structuresOf.find( di._master );
+      if (istructures == structuresOf.end()) continue;
+      for ( size_t j : istructures->second ) _visit( j, states, structuresOf, order );
+    }
+    order.push_back( i );
+  }
+
+
+  void  GdsStream::makeInstances ( GdsStructure& structure )
+  {
+    cdebug_log(101,1) << "GdsStream::makeInstances(): " << structure.getName() << endl;
+
+    for ( const DelayedInstance& di : structure.getInstances() ) {
+      if (di._master) {
+        if (not structure.getCell()) continue;
+        string    insName  = "sref_" + getString(di._index);
         Instance* instance =
-          Instance::create( di._owner
+          Instance::create( structure.getCell()
                           , insName
-                          , masterCell
+                          , di._master
                           , di._transformation
                           , Instance::PlacementStatus::FIXED
                           );
-          cdebug_log(101,0) << "| " << instance << " @" << di._transformation << " in " << di._owner << endl;
+          cdebug_log(101,0) << "| " << instance << " @" << di._transformation << " in " << structure.getCell() << endl;
       } else {
         cerr << Error( "GdsStream::makeInstances(): Delayed sub-model (STRUCTURE) \"%s\" not found."
                      , di._masterName.c_str() ) << endl;
@@ -2033,7 +2497,8 @@ namespace CRL {
 // Class  :  "CRL::Gds".
 
 
-  std::string  Gds::_topCellName = "";
+  std::string       Gds::_topCellName  = "";
+  std::set<string>  Gds::_layersFilter;
 
 
   bool  Gds::load ( Library* library, string gdsPath, uint32_t flags )
@@ -2042,9 +2507,12 @@ namespace CRL {
     UpdateSession::open();
     Contact::disableCheckMinSize();
 
-    GdsStream gstream ( gdsPath, flags );
+    size_t threads = std::max( 1, Cfg::getParamInt("gdsParser.threads",1)->asInt() );
+    if (cdebug.enabled(101)) threads = 1;
+
+    GdsStream gstream ( gdsPath, flags, _layersFilter );
 
-    if (not gstream.read( library ))
+    if (not gstream.read( library, threads ))
       cerr << Error( "Gds::load(): An error occurred while reading GDSII stream\n"
                      "        \"%s\"."
                    , gdsPath.c_str()
@@ -2053,6 +2521,7 @@ namespace CRL {
     Contact::enableCheckMinSize();
     UpdateSession::close();
     Gds::setTopCellName( "" );
+    Gds::setLayersFilter( std::set<string>() );
   //DebugSession::close();
 
     return true;
@@ -121,8 +121,10 @@ namespace {
       static int                _dieAreaCbk              ( defrCallbackType_e, defiBox*      , defiUserData );
       static int                _pinCbk                  ( defrCallbackType_e, defiPin*      , defiUserData );
       static int                _viaCbk                  ( defrCallbackType_e, defiVia*      , defiUserData );
+      static int                _componentStartCbk       ( defrCallbackType_e, int           , defiUserData );
       static int                _componentCbk            ( defrCallbackType_e, defiComponent*, defiUserData );
       static int                _componentEndCbk         ( defrCallbackType_e, void*         , defiUserData );
+      static int                _netStartCbk             ( defrCallbackType_e, int           , defiUserData );
       static int                _netCbk                  ( defrCallbackType_e, defiNet*      , defiUserData );
       static int                _netEndCbk               ( defrCallbackType_e, void*         , defiUserData );
       static int                _snetCbk                 ( defrCallbackType_e, defiNet*      , defiUserData );
@@ -168,19 +170,21 @@ namespace {
     , _viasLookup       ()
     , _errors           ()
   {
-    defrInit               ();
-    defrSetUnitsCbk        ( _unitsCbk );
-    defrSetBusBitCbk       ( _busBitCbk );
-    defrSetDesignEndCbk    ( _designEndCbk );
-    defrSetDieAreaCbk      ( _dieAreaCbk );
-    defrSetViaCbk          ( _viaCbk );
-    defrSetPinCbk          ( _pinCbk );
-    defrSetComponentCbk    ( _componentCbk );
-    defrSetComponentEndCbk ( _componentEndCbk );
-    defrSetNetCbk          ( _netCbk );
-    defrSetNetEndCbk       ( _netEndCbk );
-    defrSetSNetCbk         ( _snetCbk );
-    defrSetPathCbk         ( _pathCbk );
+    defrInit                 ();
+    defrSetUnitsCbk          ( _unitsCbk );
+    defrSetBusBitCbk         ( _busBitCbk );
+    defrSetDesignEndCbk      ( _designEndCbk );
+    defrSetDieAreaCbk        ( _dieAreaCbk );
+    defrSetViaCbk            ( _viaCbk );
+    defrSetPinCbk            ( _pinCbk );
+    defrSetComponentStartCbk ( _componentStartCbk );
+    defrSetComponentCbk      ( _componentCbk );
+    defrSetComponentEndCbk   ( _componentEndCbk );
+    defrSetNetStartCbk       ( _netStartCbk );
+    defrSetNetCbk            ( _netCbk );
+    defrSetNetEndCbk         ( _netEndCbk );
+    defrSetSNetCbk           ( _snetCbk );
+    defrSetPathCbk           ( _pathCbk );
 
     if (DataBase::getDB()->getTechnology()->getName() == "Sky130") {
       cmess1 << "     - Enabling SkyWater 130nm harness hacks." << endl;
@@ -619,6 +623,13 @@ namespace {
   }
 
 
+  int  DefParser::_componentStartCbk ( defrCallbackType_e c, int count, lefiUserData ud )
+  {
+    Name::reserve( count );
+    return 0;
+  }
+
+
   int  DefParser::_componentCbk ( defrCallbackType_e c, defiComponent* component, lefiUserData ud )
   {
     DefParser* parser = (DefParser*)ud;
@@ -671,6 +682,13 @@ namespace {
   }
 
 
+  int  DefParser::_netStartCbk ( defrCallbackType_e c, int count, lefiUserData ud )
+  {
+    Name::reserve( count );
+    return 0;
+  }
+
+
   int  DefParser::_netCbk ( defrCallbackType_e c, defiNet* net, lefiUserData ud )
   {
     static size_t netCount = 0;
@@ -121,6 +121,31 @@ extern "C" {
   }
 
 
+  static PyObject* PyGds_setLayersFilter ( PyObject*, PyObject* args )
+  {
+    cdebug_log(30,0) << "PyGds_setLayersFilter()" << endl;
+    HTRY
+      PyObject* pyLayers = NULL;
+      if (not PyArg_ParseTuple( args, "O:Gds.setLayersFilter", &pyLayers ) or not PyList_Check(pyLayers)) {
+        PyErr_SetString( ConstructorError, "Gds.setLayersFilter(): Takes *one* list of str argument only." );
+        return NULL;
+      }
+      std::set<string> layers;
+      for ( Py_ssize_t i=0 ; i<PyList_Size(pyLayers) ; ++i ) {
+        PyObject* item = PyList_GetItem( pyLayers, i );
+        if (not PyString_Check(item)) {
+          string message = "Gds.setLayersFilter(): Item at position " + getString(i) + " is not a str.";
+          PyErr_SetString( ConstructorError, message.c_str() );
+          return NULL;
+        }
+        layers.insert( PyString_AsString(item) );
+      }
+      Gds::setLayersFilter( layers );
+    HCATCH
+    Py_RETURN_NONE;
+  }
+
+
   // Standart Destroy (Attribute).
 
 
@@ -131,6 +156,8 @@ extern "C" {
                               , "Load a Gds layout inside a Cell (cumulative)." }
     , { "setTopCellName"      , (PyCFunction)PyGds_setTopCellName, METH_VARARGS|METH_STATIC
                               , "The name of the main cell from the GDS (not to be renamed)." }
+    , { "setLayersFilter"     , (PyCFunction)PyGds_setLayersFilter, METH_VARARGS|METH_STATIC
+                              , "Restrict the next load to the given layers (names)." }
     , {NULL, NULL, 0, NULL}   /* sentinel */
     };
 
@@ -70,6 +70,7 @@ namespace Etesian {
     , _latchUpDistance  (  Cfg::getParamInt       ("etesian.latchUpDistance",0                 )->asInt() )
     , _antennaGateMaxWL (  Cfg::getParamInt       ("etesian.antennaGateMaxWL"   ,0                 )->asInt() )
     , _antennaDiodeMaxWL(  Cfg::getParamInt       ("etesian.antennaDiodeMaxWL"   ,0                 )->asInt() )
+    , _placeThreads     (  Cfg::getParamInt       ("etesian.threads"        ,1                 )->asInt() )
   {
     string gaugeName = Cfg::getParamString("anabatic.routingGauge","sxlib")->asString();
     if (not cg)
@@ -118,6 +119,7 @@ namespace Etesian {
     , _latchUpDistance  ( other._latchUpDistance )
     , _antennaGateMaxWL ( other._antennaGateMaxWL )
     , _antennaDiodeMaxWL( other._antennaDiodeMaxWL)
+    , _placeThreads     ( other._placeThreads     )
   {
     if (other._rg) _rg = other._rg->getClone();
     if (other._cg) _cg = other._cg->getClone();
@@ -148,6 +150,7 @@ namespace Etesian {
     cmess1 << Dots::asString    ("     - Antenna gate Max. WL" ,DbU::getValueString(_antennaGateMaxWL )) << endl;
     cmess1 << Dots::asString    ("     - Antenna diode Max. WL",DbU::getValueString(_antennaDiodeMaxWL)) << endl;
     cmess1 << Dots::asString    ("     - Latch up Distance",DbU::getValueString(_latchUpDistance)) << endl;
+    cmess1 << Dots::asUInt      ("     - Threads"          ,_placeThreads            ) << endl;
   }
 
 
@@ -183,6 +186,7 @@ namespace Etesian {
     record->add ( DbU::getValueSlot( "_latchUpDistance"  , &_latchUpDistance   ) );
     record->add ( DbU::getValueSlot( "_antennaGateMaxWL" , &_antennaGateMaxWL  ) );
     record->add ( DbU::getValueSlot( "_antennaDiodeMaxWL", &_antennaDiodeMaxWL ) );
+    record->add ( getSlot( "_placeThreads"          ,       _placeThreads    ) );
     return record;
   }
 
@@ -15,6 +15,7 @@
 
 
 
+#include <chrono>
 #include <sstream>
 #include <fstream>
 #include <iomanip>
@@ -39,6 +40,7 @@
 #include "hurricane/RoutingPad.h"
 #include "hurricane/NetExternalComponents.h"
 #include "hurricane/UpdateSession.h"
+#include "hurricane/ThreadPool.h"
 #include "hurricane/viewer/CellWidget.h"
 #include "hurricane/viewer/CellViewer.h"
 #include "crlcore/Utilities.h"
@@ -265,6 +267,8 @@ namespace Etesian {
   using Hurricane::RoutingPad;
   using Hurricane::Net;
   using Hurricane::Occurrence;
+  using Hurricane::FlatOccurrenceTable;
+  using Hurricane::ThreadPool;
   using Hurricane::CellWidget;
   using CRL::ToolEngine;
   using CRL::AllianceFramework;
@@ -320,6 +324,9 @@ namespace Etesian {
     , _diodeCount   (0)
     , _bufferCount  (0)
     , _excludedNets ()
+    , _convertTime  (0.0)
+    , _threadedTime (0.0)
+    , _threadedWork (0.0)
   { }
 
 
@@ -692,6 +699,7 @@ namespace Etesian {
 
   size_t  EtesianEngine::toColoquinte ()
   {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
     clearColoquinte();
     AllianceFramework* af          = AllianceFramework::get();
     DbU::Unit          hpitch      = getSliceHStep();
@@ -764,10 +772,21 @@ namespace Etesian {
                                         , (int)(topAb.getYMax() / vpitch)
                                         );
 
-    for ( Occurrence occurrence : getCell()->getTerminalNetlistInstanceOccurrences(getBlockInstance()) ) {
+  // The flattened occurrences are taken from the Cell table, the bloated
+  // abutment boxes are computed here because BloatCells::getAb() is not
+  // thread safe.
+    FlatOccurrenceTable::Range occurrences = getCell()->getFlatOccurrenceTable().getRange( getBlockInstance() );
+    vector<Box>                bloatedAbs;
+    for ( const FlatOccurrenceTable::Entry& entry : occurrences ) {
+      Occurrence occurrence = entry.getOccurrence();
+      _checkNotAFeed( occurrence );
+      bloatedAbs.push_back( _bloatCells.getAb(occurrence) );
+    }
+
+    for ( size_t i=0 ; i<occurrences.size() ; ++i ) {
       ++instancesNb;
-      Instance* instance   = static_cast<Instance*>(occurrence.getEntity());
-      Box       instanceAb = _bloatCells.getAb( occurrence );
+      Instance* instance   = occurrences[i].getInstance();
+      Box       instanceAb = bloatedAbs[i];
       string    masterName = getString( instance->getMasterCell()->getName() );
       DbU::Unit length = (instanceAb.getHeight() / sliceHeight) * instanceAb.getWidth();
       if (af->isRegister(masterName)) {
@@ -815,6 +834,9 @@ namespace Etesian {
     }
     cout.flush();
 
+    ThreadPool pool ( getPlaceThreads() );
+    cmess1 << ::Dots::asUInt( "     - Placement threads", pool.size() ) << endl;
+
   // Coloquinte circuit description data-structures.
   // One dummy fixed instance at the end
 
@@ -841,6 +863,8 @@ namespace Etesian {
   //getCell()->flattenNets( Cell::Flags::BuildRings|Cell::Flags::NoClockFlatten );
   //getCell()->flattenNets( getBlockInstance(), Cell::Flags::NoClockFlatten );
     getCell()->flattenNets( NULL, _excludedNets, Cell::Flags::NoClockFlatten );
+  // Instances are left untouched, but do not rely on that.
+    occurrences = getCell()->getFlatOccurrenceTable().getRange( getBlockInstance() );
 
     int instanceId       = 0;
     if (getBlockInstance()) {
@@ -873,26 +897,18 @@ namespace Etesian {
       }
     }
 
-    // Translate the placeable instances
-    for ( Occurrence occurrence : getCell()->getTerminalNetlistInstanceOccurrences(getBlockInstance()) )
-    {
-      if (instanceId >= (int) instancesNb) {
-        // This will be an error
-        ++instanceId;
-        continue;
-      }
-      _checkNotAFeed(occurrence);
-
-      Instance* instance     = static_cast<Instance*>(occurrence.getEntity());
-      Cell*     masterCell   = instance->getMasterCell();
+    // Translate the placeable instances. Each occurrence writes only it's
+    // own slot, the bool vectors (bit packed), the lookup tables and the
+    // histogram are filled afterwards, sequentially.
+    int             placedBase = instanceId;
+    vector<uint8_t> isPlaceable ( occurrences.size(), 0 );
+    Name            flexBuffer  ( "buf_x8" );  // Names must not be created inside the threads.
+    pool.run( occurrences.size(), [&]( size_t i, size_t ) {
+      Instance* instance   = occurrences[i].getInstance();
+      Box       instanceAb = bloatedAbs[i];
+      size_t    id         = placedBase + i;
 
-      stdCellSizes.addSample( (float)(masterCell->getAbutmentBox().getWidth() / hpitch), 0 );
-      Box instanceAb = _bloatCells.getAb( occurrence );
-      stdCellSizes.addSample( (float)(instanceAb.getWidth() / hpitch), 1 );
-
-      Transformation instanceTransf = instance->getTransformation();
-      occurrence.getPath().getTransformation().applyOn( instanceTransf );
-      instanceTransf.applyOn( instanceAb );
+      occurrences[i].getTransformation().applyOn( instanceAb );
 
       // Upper rounded
       int xsize = (instanceAb.getWidth () + hpitch - 1) / hpitch;
@@ -902,27 +918,31 @@ namespace Etesian {
       int ypos  = instanceAb.getYMin() / vpitch;
 
       // Huge hack to solve a specific DRC issue in Flexlib
-      string masterName = getString( instance->getMasterCell()->getName() );
-      if (isFlexLib and not instance->isFixed() and (masterName == "buf_x8"))
+      if (isFlexLib and not instance->isFixed()
+         and (instance->getMasterCell()->getName() == flexBuffer))
          ++xsize;
 
-      cellX[instanceId] = xpos;
-      cellY[instanceId] = ypos;
-      cellWidth[instanceId] = xsize;
-      cellHeight[instanceId] = ysize;
+      cellX[id] = xpos;
+      cellY[id] = ypos;
+      cellWidth[id] = xsize;
+      cellHeight[id] = ysize;
 
       int nbRows = ysize / rowHeight;
       if (nbRows % 2 != 1) {
-        cellRowPolarity[instanceId] = CellRowPolarity::NW;
+        cellRowPolarity[id] = CellRowPolarity::NW;
       }
 
-      if ( not instance->isFixed() and instance->isTerminalNetlist() ) {
-        cellIsFixed[instanceId] = false;
-        cellIsObstruction[instanceId] = false;
-      } else {
-        cellIsFixed[instanceId] = true;
-        cellIsObstruction[instanceId] = true;
-      }
+      isPlaceable[i] = (not instance->isFixed() and instance->isTerminalNetlist());
+    } );
+
+    for ( size_t i=0 ; i<occurrences.size() ; ++i ) {
+      Instance* instance = occurrences[i].getInstance();
+
+      stdCellSizes.addSample( (float)(instance->getMasterCell()->getAbutmentBox().getWidth() / hpitch), 0 );
+      stdCellSizes.addSample( (float)(bloatedAbs[i].getWidth() / hpitch), 1 );
+
+      cellIsFixed[instanceId] = not isPlaceable[i];
+      cellIsObstruction[instanceId] = not isPlaceable[i];
 
       _instsToIds.insert( make_pair(instance,instanceId) );
       _idsToInsts.push_back( make_tuple(instance,vector<RoutingPad*>()) );
@@ -947,7 +967,7 @@ namespace Etesian {
 
     dots.finish( Dots::Reset|Dots::FirstDot );
 
-    size_t netsNb = 0;
+    vector<Net*> nets;
     for ( Net* net : getCell()->getNets() )
     {
       const char* excludedType = NULL;
@@ -962,7 +982,7 @@ namespace Etesian {
       }
       if (af->isBLOCKAGE(net->getName())) continue;
 
-      ++netsNb;
+      nets.push_back( net );
     }
     _circuit->setCellX(cellX);
     _circuit->setCellY(cellY);
@@ -973,24 +993,23 @@ namespace Etesian {
     _circuit->setCellIsObstruction(cellIsObstruction);
     _circuit->setCellRowPolarity(cellRowPolarity);
 
-    cmess1 << "     - Converting " << netsNb << " nets" << endl;
-
-    for ( Net* net : getCell()->getNets() )
-    {
-      const char* excludedType = NULL;
-      if (net->getType() == Net::Type::POWER )   excludedType = "POWER";
-      if (net->getType() == Net::Type::GROUND)   excludedType = "GROUND";
-      if (net->getType() == Net::Type::CLOCK )   excludedType = "CLOCK";
-      if (isExcluded(getString(net->getName()))) excludedType = "USER_EXCLUDED";
-      if (excludedType) continue;
-      if (af->isBLOCKAGE(net->getName())) continue;
-
-      dots.dot();
-      
-      string topCellInstancePin = getString(getCell()->getName()) + ":C";
-      vector<int> netCells, pinX, pinY;
-
-      for ( RoutingPad* rp : net->getRoutingPads() ) {
+    cmess1 << "     - Converting " << nets.size() << " nets" << endl;
+
+    // The pins of each net are gathered in parallel, the nets are then
+    // added to the circuit (and the problems reported) in the original
+    // order so the Coloquinte netlist do not depend on the thread count.
+    struct NetPins {
+      vector<int>         netCells;
+      vector<int>         pinX;
+      vector<int>         pinY;
+      vector<RoutingPad*> outsiders;
+      vector<RoutingPad*> unknowns;
+    };
+    vector<NetPins> netsPins ( nets.size() );
+    pool.run( nets.size(), [&]( size_t inet, size_t ) {
+      NetPins& pins = netsPins[inet];
+
+      for ( RoutingPad* rp : nets[inet]->getRoutingPads() ) {
         Path path = rp->getOccurrence().getPath();
         Pin* pin  = dynamic_cast<Pin*>( rp->getOccurrence().getEntity() ); 
         if (pin) {
@@ -999,9 +1018,9 @@ namespace Etesian {
             int xpin = pt.getX() / hpitch;
             int ypin = pt.getY() / vpitch;
           // Dummy last instance
-            pinX.push_back(xpin);
-            pinY.push_back(ypin);
-            netCells.push_back(instanceId);
+            pins.pinX.push_back(xpin);
+            pins.pinY.push_back(ypin);
+            pins.netCells.push_back(instanceId);
           }
           continue;
         }
@@ -1012,13 +1031,7 @@ namespace Etesian {
         // that the RP is placed or is inside a define area (the abutment box of
         // it's own block). No example yet of that case, though.
           if (path.getHeadInstance() != getBlockInstance()) {
-            cerr << Warning( "EtesianEngine::toColoquinte(): Net %s has a RoutingPad that is not rooted at the placed instance.\n"
-                             "          * Placed instance: %s\n"
-                             "          * RoutingPad: %s"
-                           , getString(net).c_str()
-                           , getString(getBlockInstance()).c_str()
-                           , getString(rp->getOccurrence()).c_str()
-                           ) << endl;
+            pins.outsiders.push_back( rp );
             continue;
           }
         }
@@ -1031,17 +1044,34 @@ namespace Etesian {
 
         auto  iid = _instsToIds.find( instance );
         if (iid == _instsToIds.end()) {
-          if (not instance) {
-            string    insName  = extractInstanceName( rp );
-            cerr << Error( "Unable to lookup instance \"%s\".", insName.c_str() ) << endl;
-          }
+          if (not instance) pins.unknowns.push_back( rp );
         } else {
-          pinX.push_back(xpin);
-          pinY.push_back(ypin);
-          netCells.push_back((*iid).second);
+          pins.pinX.push_back(xpin);
+          pins.pinY.push_back(ypin);
+          pins.netCells.push_back((*iid).second);
         }
       }
-      _circuit->addNet(netCells, pinX, pinY);
+    } );
+
+    for ( size_t inet=0 ; inet<nets.size() ; ++inet ) {
+      NetPins& pins = netsPins[inet];
+
+      dots.dot();
+      for ( RoutingPad* rp : pins.outsiders ) {
+        cerr << Warning( "EtesianEngine::toColoquinte(): Net %s has a RoutingPad that is not rooted at the placed instance.\n"
+                         "          * Placed instance: %s\n"
+                         "          * RoutingPad: %s"
+                       , getString(nets[inet]).c_str()
+                       , getString(getBlockInstance()).c_str()
+                       , getString(rp->getOccurrence()).c_str()
+                       ) << endl;
+      }
+      for ( RoutingPad* rp : pins.unknowns ) {
+        string    insName  = extractInstanceName( rp );
+        cerr << Error( "Unable to lookup instance \"%s\".", insName.c_str() ) << endl;
+      }
+      _circuit->addNet(pins.netCells, pins.pinX, pins.pinY);
+      pins = NetPins();
     }
     dots.finish( Dots::Reset );
 
@@ -1061,6 +1091,15 @@ namespace Etesian {
     _placementLB = new coloquinte::PlacementSolution ();
     _placementUB = new coloquinte::PlacementSolution ( *_placementLB );
 
+  // Wall time of the threaded loops and the work done inside them (the
+  // sum over the threads), to report their share in place().
+    _convertTime  = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+    _threadedTime = pool.getWallTime();
+    _threadedWork = 0.0;
+    for ( size_t ithread=0 ; ithread<pool.size() ; ++ithread )
+      _threadedWork += pool.getBusyTime( ithread );
+    cmess1 << ::Dots::asString( "     - Threads utilization", pool.getStringUtilization() ) << endl;
+
     return instancesNb-fixedNb;
   }
 
@@ -1181,11 +1220,16 @@ namespace Etesian {
 
     cmess1 << _circuit->report() << std::endl;
 
+    typedef std::chrono::steady_clock  Clock;
     cmess1 << "  o  Global placement (effort " << getPlaceEffort() << ")" << endl;
+    Clock::time_point start = Clock::now();
     globalPlace();
+    double globalTime = std::chrono::duration<double>( Clock::now() - start ).count();
 
     cmess1 << "  o  Detailed Placement (effort " << getPlaceEffort() << ")" << endl;
+    start = Clock::now();
     detailedPlace();
+    double detailedTime = std::chrono::duration<double>( Clock::now() - start ).count();
 
   //toHurricane();
   //addFeeds();
@@ -1195,9 +1239,23 @@ namespace Etesian {
     printMeasures();
     addMeasure<double>( "placeT", getTimer().getCombTime() );
 
+  // Share of the (single thread equivalent) placement time spent in the
+  // threaded loops of toColoquinte(), and how much of it was recovered.
+    double sequentialTime = _convertTime - _threadedTime + _threadedWork + globalTime + detailedTime;
+    cmess1 << "  o  Placement wall times." << endl;
+    cmess1 << ::Dots::asDouble( "     - Conversion (s)"        , _convertTime ) << endl;
+    cmess1 << ::Dots::asDouble( "     - Global placement (s)"  , globalTime   ) << endl;
+    cmess1 << ::Dots::asDouble( "     - Detailed placement (s)", detailedTime ) << endl;
+    if (sequentialTime > 0.0) {
+      cmess1 << ::Dots::asPercentage( "     - Threaded part"
+                                    , (float)(_threadedWork/sequentialTime) ) << endl;
+      cmess1 << ::Dots::asPercentage( "     - Recovered by threads"
+                                    , (float)((_threadedWork - _threadedTime)/sequentialTime) ) << endl;
+    }
+
     UpdateSession::open();
-    for ( Net* net : getCell()->getNets() ) {
-      for ( RoutingPad* rp : net->getComponents().getSubSet<RoutingPad*>() ) {
+    for ( Net* net : getCell()->getNetRange() ) {
+      for ( RoutingPad* rp : net->getRoutingPadRange() ) {
         rp->invalidate();
       }
     }
@@ -1223,8 +1281,13 @@ namespace Etesian {
     DbU::Unit diodeWidth = (_diodeCell) ? _diodeCell->getAbutmentBox().getWidth() : 0;
     vector< tuple<RoutingPad*,Transformation> > diodeInsts;
 
-    for ( Occurrence occurrence : getCell()->getTerminalNetlistInstanceOccurrences(getBlockInstance()) )
+  // Work on a copy of the flattened occurrences as moving the instances
+  // discards the table of the Cell.
+    FlatOccurrenceTable::Range         range   = getCell()->getFlatOccurrenceTable().getRange( getBlockInstance() );
+    vector<FlatOccurrenceTable::Entry> entries ( range.begin(), range.end() );
+    for ( const FlatOccurrenceTable::Entry& entry : entries )
     {
+      Occurrence occurrence     = entry.getOccurrence();
       DbU::Unit hpitch          = getSliceHStep();
       DbU::Unit vpitch          = getSliceVStep();
       DbU::Unit sliceHeight     = getSliceHeight();
@@ -43,6 +43,7 @@ namespace Etesian {
   using Hurricane::Warning;
   using Hurricane::Breakpoint;
   using Hurricane::Path;
+  using Hurricane::FlatOccurrenceTable;
   using Hurricane::Transformation;
   using Hurricane::DataBase;
   using Hurricane::Library;
@@ -1019,9 +1020,10 @@ namespace Etesian {
       }
     }
 
-    for ( Occurrence occurrence : getBlockCell()->getTerminalNetlistInstanceOccurrences() )
+    for ( const FlatOccurrenceTable::Entry& entry : getBlockCell()->getFlatOccurrenceTable() )
     {
-      Instance* instance     = static_cast<Instance*>( occurrence.getEntity() );
+      Occurrence occurrence   = entry.getOccurrence();
+      Instance*  instance     = entry.getInstance();
       Cell*     masterCell   = instance->getMasterCell();
 
       if (CatalogExtension::isFeed(masterCell)) {
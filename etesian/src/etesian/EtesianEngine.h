@@ -98,6 +98,7 @@ namespace Etesian {
       inline  double                  getAspectRatio            () const;
       inline  DbU::Unit               getAntennaGateMaxWL       () const;
       inline  DbU::Unit               getAntennaDiodeMaxWL      () const;
+      inline  uint32_t                getPlaceThreads           () const;
       inline  DbU::Unit               getLatchUpDistance        () const;
       inline  const FeedCells&        getFeedCells              () const;
       inline  const BufferCells&      getBufferCells            () const;
@@ -177,6 +178,9 @@ namespace Etesian {
              uint32_t                             _diodeCount;
              uint32_t                             _bufferCount;
              NetNameSet                           _excludedNets;
+             double                               _convertTime;
+             double                               _threadedTime;
+             double                               _threadedWork;
 
     protected:
     // Constructors & Destructors.
@@ -219,6 +223,7 @@ namespace Etesian {
   inline  double                 EtesianEngine::getAspectRatio            () const { return getConfiguration()->getAspectRatio(); }
   inline  DbU::Unit              EtesianEngine::getAntennaGateMaxWL       () const { return getConfiguration()->getAntennaGateMaxWL(); }
   inline  DbU::Unit              EtesianEngine::getAntennaDiodeMaxWL      () const { return getConfiguration()->getAntennaDiodeMaxWL(); }
+  inline  uint32_t               EtesianEngine::getPlaceThreads           () const { return getConfiguration()->getPlaceThreads(); }
   inline  DbU::Unit              EtesianEngine::getLatchUpDistance        () const { return getConfiguration()->getLatchUpDistance(); }
   inline  void                   EtesianEngine::useFeed                   ( Cell* cell ) { _feedCells.useFeed(cell); }
   inline  const FeedCells&       EtesianEngine::getFeedCells              () const { return _feedCells; }
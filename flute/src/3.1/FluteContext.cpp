@@ -0,0 +1,200 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |       F l u t e  -  Steiner Tree Service                        |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./FluteContext.cpp"                            |
+// +-----------------------------------------------------------------+
+
+
+#include <cstdlib>
+#include <functional>
+#include <algorithm>
+#include <mutex>
+#include "hurricane/ThreadPool.h"
+#include "FluteContext.h"
+
+
+namespace Flute {
+
+  using std::vector;
+  using std::pair;
+  using Hurricane::ThreadPool;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Flute::Context".
+
+
+  size_t  Context::KeyHash::operator() ( const Key& key ) const
+  {
+    size_t hash = key.size();
+    for ( DTYPE value : key )
+      hash ^= std::hash<DTYPE>()( value ) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    return hash;
+  }
+
+
+  void  Context::freeTree ( Tree& tree )
+  {
+    free( tree.branch );
+    tree.branch = NULL;
+  }
+
+
+  Context::Context ( int accuracy, int cacheDegree, size_t cacheLimit )
+    : _accuracy   (accuracy)
+    , _cacheDegree(cacheDegree)
+    , _cacheLimit (cacheLimit)
+    , _mutex      ()
+    , _cache      ()
+    , _hits       (0)
+    , _misses     (0)
+  { }
+
+
+  size_t  Context::getCacheSize () const
+  {
+    std::shared_lock<std::shared_mutex> guard ( _mutex );
+    return _cache.size();
+  }
+
+
+  void  Context::clearCache ()
+  {
+    std::unique_lock<std::shared_mutex> guard ( _mutex );
+    _cache.clear();
+    _hits   = 0;
+    _misses = 0;
+  }
+
+
+  void  Context::_normalize ( const Pins& pins, Key& key, DTYPE& xmin, DTYPE& ymin )
+  {
+    static thread_local vector< pair<DTYPE,DTYPE> >  points;
+
+    xmin = *std::min_element( pins._xs.begin(), pins._xs.end() );
+    ymin = *std::min_element( pins._ys.begin(), pins._ys.end() );
+
+    points.clear();
+    for ( size_t i=0 ; i<pins._xs.size() ; ++i )
+      points.push_back( std::make_pair( pins._xs[i] - xmin, pins._ys[i] - ymin ) );
+    std::sort( points.begin(), points.end() );
+
+    key.clear();
+    for ( const auto& point : points ) {
+      key.push_back( point.first  );
+      key.push_back( point.second );
+    }
+  }
+
+
+  Tree  Context::_restore ( const Entry& entry, DTYPE xmin, DTYPE ymin, bool wirelengthOnly )
+  {
+    Tree tree;
+    tree.deg    = (entry._branches.size() + 2) / 2;
+    tree.length = entry._length;
+    tree.branch = NULL;
+    if (wirelengthOnly) return tree;
+
+    tree.branch = (Branch*)malloc( entry._branches.size()*sizeof(Branch) );
+    for ( size_t i=0 ; i<entry._branches.size() ; ++i ) {
+      tree.branch[i].x = entry._branches[i].x + xmin;
+      tree.branch[i].y = entry._branches[i].y + ymin;
+      tree.branch[i].n = entry._branches[i].n;
+    }
+    return tree;
+  }
+
+
+  Tree  Context::_getTree ( const Pins& pins, bool wirelengthOnly )
+  {
+    static thread_local Key            key;
+    static thread_local vector<DTYPE>  xs;
+    static thread_local vector<DTYPE>  ys;
+
+    Tree tree;
+    tree.deg    = pins.size();
+    tree.length = 0;
+    tree.branch = NULL;
+    if (tree.deg < 2) return tree;
+
+    if (tree.deg > _cacheDegree) {
+    // flute() & flute_wl() only read the coordinates.
+      DTYPE* x = const_cast<DTYPE*>( pins._xs.data() );
+      DTYPE* y = const_cast<DTYPE*>( pins._ys.data() );
+      if (wirelengthOnly) {
+        tree.length = flute_wl( tree.deg, x, y, _accuracy );
+        return tree;
+      }
+      return flute( tree.deg, x, y, _accuracy );
+    }
+
+    DTYPE xmin = 0;
+    DTYPE ymin = 0;
+    _normalize( pins, key, xmin, ymin );
+    {
+      std::shared_lock<std::shared_mutex> guard ( _mutex );
+      auto ientry = _cache.find( key );
+      if (ientry != _cache.end()) {
+        ++_hits;
+        return _restore( ientry->second, xmin, ymin, wirelengthOnly );
+      }
+    }
+    ++_misses;
+
+    xs.resize( tree.deg );
+    ys.resize( tree.deg );
+    for ( int i=0 ; i<tree.deg ; ++i ) {
+      xs[i] = key[2*i  ];
+      ys[i] = key[2*i+1];
+    }
+    Tree normalized = flute( tree.deg, xs.data(), ys.data(), _accuracy );
+
+    Entry entry;
+    entry._length = normalized.length;
+    entry._branches.assign( normalized.branch, normalized.branch + 2*normalized.deg - 2 );
+    freeTree( normalized );
+
+    tree = _restore( entry, xmin, ymin, wirelengthOnly );
+    {
+      std::unique_lock<std::shared_mutex> guard ( _mutex );
+      if (_cache.size() < _cacheLimit)
+        _cache.emplace( key, std::move(entry) );
+    }
+    return tree;
+  }
+
+
+  Tree  Context::getTree ( const Pins& pins )
+  { return _getTree( pins, false ); }
+
+
+  DTYPE  Context::getWirelength ( const Pins& pins )
+  { return _getTree( pins, true ).length; }
+
+
+  void  Context::getTrees ( const vector<Pins>& nets, vector<Tree>& trees, size_t threads )
+  {
+    trees.resize( nets.size() );
+    ThreadPool pool ( threads );
+    pool.run( nets.size(), [&]( size_t i, size_t ) { trees[i] = _getTree( nets[i], false ); } );
+  }
+
+
+  void  Context::getWirelengths ( const vector<Pins>& nets, vector<DTYPE>& lengths, size_t threads )
+  {
+    lengths.resize( nets.size() );
+    ThreadPool pool ( threads );
+    pool.run( nets.size(), [&]( size_t i, size_t ) { lengths[i] = _getTree( nets[i], true ).length; } );
+  }
+
+
+}  // Flute namespace.
@@ -0,0 +1,115 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |       F l u t e  -  Steiner Tree Service                        |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./FluteContext.h"                              |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include <cstdint>
+#include <vector>
+#include <atomic>
+#include <shared_mutex>
+#include <unordered_map>
+#include "flute.h"
+
+
+namespace Flute {
+
+
+// -------------------------------------------------------------------
+// Class  :  "Flute::Context".
+//
+// Reentrant front-end to flute(), usable from any number of threads
+// once the LUT has been loaded (readLUT()). The trees of the nets up
+// to <cacheDegree> pins are memoized: a net is normalized by moving
+// it's lower left corner to the origin and sorting it's pins, which
+// gives the key. Nets of identical shape (frequent on the GCell grid)
+// are computed only once. As the tree of a net depends on the actual
+// distances between the pins, and not only on their ranks, the key
+// is the whole normalized pin set.
+//
+// The returned trees are always owned by the caller and must be
+// released with freeTree().
+
+  class Context {
+    public:
+      class Pins {
+        public:
+          inline void  clear ();
+          inline void  add   ( DTYPE x, DTYPE y );
+          inline int   size  () const;
+        public:
+          std::vector<DTYPE>  _xs;
+          std::vector<DTYPE>  _ys;
+      };
+    private:
+      class Entry {
+        public:
+          DTYPE                _length;
+          std::vector<Branch>  _branches;
+      };
+      typedef  std::vector<DTYPE>  Key;
+      class KeyHash {
+        public:
+          size_t  operator() ( const Key& ) const;
+      };
+      typedef  std::unordered_map<Key,Entry,KeyHash>  Cache;
+    public:
+      static  void    freeTree       ( Tree& );
+    public:
+                      Context        ( int accuracy=ACCURACY, int cacheDegree=DPARAM, size_t cacheLimit=1<<20 );
+      inline  int     getAccuracy    () const;
+      inline  int     getCacheDegree () const;
+      inline  size_t  getHits        () const;
+      inline  size_t  getMisses      () const;
+              size_t  getCacheSize   () const;
+              Tree    getTree        ( const Pins& );
+              DTYPE   getWirelength  ( const Pins& );
+              void    getTrees       ( const std::vector<Pins>&, std::vector<Tree>& , size_t threads );
+              void    getWirelengths ( const std::vector<Pins>&, std::vector<DTYPE>&, size_t threads );
+              void    clearCache     ();
+    private:
+      static  void    _normalize     ( const Pins&, Key&, DTYPE& xmin, DTYPE& ymin );
+      static  Tree    _restore       ( const Entry&, DTYPE xmin, DTYPE ymin, bool wirelengthOnly );
+              Tree    _getTree       ( const Pins&, bool wirelengthOnly );
+    private:
+                      Context        ( const Context& ) = delete;
+              Context& operator=     ( const Context& ) = delete;
+    private:
+      int                        _accuracy;
+      int                        _cacheDegree;
+      size_t                     _cacheLimit;
+      mutable std::shared_mutex  _mutex;
+      Cache                      _cache;
+      std::atomic<size_t>        _hits;
+      std::atomic<size_t>        _misses;
+  };
+
+
+  inline void  Context::Pins::clear () { _xs.clear(); _ys.clear(); }
+  inline int   Context::Pins::size  () const { return _xs.size(); }
+
+  inline void  Context::Pins::add ( DTYPE x, DTYPE y )
+  {
+    _xs.push_back( x );
+    _ys.push_back( y );
+  }
+
+
+  inline int     Context::getAccuracy    () const { return _accuracy; }
+  inline int     Context::getCacheDegree () const { return _cacheDegree; }
+  inline size_t  Context::getHits        () const { return _hits.load(); }
+  inline size_t  Context::getMisses      () const { return _misses.load(); }
+
+
+}  // Flute namespace.
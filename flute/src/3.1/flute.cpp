@@ -3,6 +3,9 @@
 #include <limits.h>
 #include <math.h>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
 using std::min;
 using std::max;
 
@@ -32,6 +35,10 @@ struct csoln
 struct csoln *LUT[DPARAM+1][MGROUP];  // storing 4 .. D
 int numsoln[DPARAM+1][MGROUP];
 
+// The LUT is loaded only once, then shared read-only by all threads.
+std::mutex        lutMutex;
+std::atomic<bool> lutLoaded ( false );
+
 struct point
 {
     DTYPE x, y;
@@ -39,6 +46,7 @@ struct point
 };
 
 void readLUT(string directory);
+bool isLUTLoaded();
 DTYPE flute_wl(int d, DTYPE x[], DTYPE y[], int acc);
 DTYPE flutes_wl_LD(int d, DTYPE xs[], DTYPE ys[], int s[]);
 DTYPE flutes_wl_MD(int d, DTYPE xs[], DTYPE ys[], int s[], int acc);
@@ -62,6 +70,9 @@ void readLUT( string directory )
     struct csoln *p;
     int d, i, j, k, kk, ns, nn;
 
+    std::lock_guard<std::mutex> guard ( lutMutex );
+    if (lutLoaded.load()) return;
+
     init_param();
     
     for (i=0; i<=255; i++) {
@@ -140,6 +151,17 @@ void readLUT( string directory )
             }
         }
     }
+
+    fclose(fpwv);
+#if ROUTING==1
+    fclose(fprt);
+#endif
+    lutLoaded.store( true );
+}
+
+bool isLUTLoaded()
+{
+    return lutLoaded.load();
 }
 
 DTYPE flute_wl(int d, DTYPE x[], DTYPE y[], int acc)
@@ -587,6 +609,12 @@ Tree flute(int d, DTYPE x[], DTYPE y[], int acc)
     int i, j, k, minidx;
     struct point *pt, **ptp, *tmpp;
     Tree t;
+    // Per-thread scratch buffers, kept from one call to the next.
+    static thread_local std::vector<DTYPE>          xsBuffer;
+    static thread_local std::vector<DTYPE>          ysBuffer;
+    static thread_local std::vector<int>            sBuffer;
+    static thread_local std::vector<struct point>   ptBuffer;
+    static thread_local std::vector<struct point*>  ptpBuffer;
     
     if (d==2) {
         t.deg = 2;
@@ -600,11 +628,18 @@ Tree flute(int d, DTYPE x[], DTYPE y[], int acc)
         t.branch[1].n = 1;
     }
     else {
-        xs = (DTYPE *)malloc(sizeof(DTYPE)*(d));
-        ys = (DTYPE *)malloc(sizeof(DTYPE)*(d));
-        s = (int *)malloc(sizeof(int)*(d));
-        pt = (struct point *)malloc(sizeof(struct point)*(d+1));
-        ptp = (struct point **)malloc(sizeof(struct point*)*(d+1));
+        if ((int)xsBuffer.size() < d+1) {
+            xsBuffer .resize(d+1);
+            ysBuffer .resize(d+1);
+            sBuffer  .resize(d+1);
+            ptBuffer .resize(d+1);
+            ptpBuffer.resize(d+1);
+        }
+        xs = xsBuffer.data();
+        ys = ysBuffer.data();
+        s = sBuffer.data();
+        pt = ptBuffer.data();
+        ptp = ptpBuffer.data();
 
         for (i=0; i<d; i++) {
             pt[i].x = x[i];
@@ -676,12 +711,6 @@ Tree flute(int d, DTYPE x[], DTYPE y[], int acc)
         }
         
         t = flutes(d, xs, ys, s, acc);
-
-        free(xs);
-        free(ys);
-        free(s);
-        free(pt);
-        free(ptp);
     }
 
     return t;
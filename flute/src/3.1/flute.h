@@ -27,6 +27,7 @@ namespace Flute {
 /*  User-Callable Functions  */
 /*****************************/
 // void readLUT(string);
+// bool isLUTLoaded();
 // DTYPE flute_wl(int d, DTYPE x[], DTYPE y[], int acc);
 // DTYPE flutes_wl(int d, DTYPE xs[], DTYPE ys[], int s[], int acc);
 // Tree flute(int d, DTYPE x[], DTYPE y[], int acc);
@@ -61,6 +62,7 @@ struct Tree
 
 // User-Callable Functions
 extern void readLUT(string directory);
+extern bool isLUTLoaded();
 extern DTYPE flute_wl(int d, DTYPE x[], DTYPE y[], int acc);
 //Macro: DTYPE flutes_wl(int d, DTYPE xs[], DTYPE ys[], int s[], int acc);
 extern Tree flute(int d, DTYPE x[], DTYPE y[], int acc);
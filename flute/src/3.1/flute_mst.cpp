@@ -5,6 +5,7 @@
 #include <string.h>
 #include <assert.h>
 #include <algorithm>
+#include <mutex>
 using std::min;
 using std::max;
 
@@ -1072,10 +1073,15 @@ Tree flute_am(int d, DTYPE *xs, DTYPE *ys, int *s, int acc,
   return t;
 }
 
+// The high degree nets rely on the global heap & hash tables above,
+// so they are serialized. Recursive, as flute_am() may come back here.
+std::recursive_mutex hdMutex;
+
 Tree flutes_HD(int d, DTYPE *xs, DTYPE *ys, int *s, int acc)
 {
   int i, A, orig_D3;
   Tree t;
+  std::lock_guard<std::recursive_mutex> guard ( hdMutex );
   //DTYPE *dist[MAXD], *dist_base;
   DTYPE **dist, *dist_base;
   DTYPE threshold, threshold_x, threshold_y;
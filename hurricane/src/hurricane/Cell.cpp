@@ -547,7 +547,9 @@ Cell::Cell(Library* library, const Name& name)
     _nextOfSymbolCellSet(NULL),
     _slaveEntityMap(),
     _observers(),
-    _flags(Flags::NoFlags)
+    _flags(Flags::NoFlags),
+    _flatOccurrenceTable(NULL),
+    _flatOccurrencesInvalidated(false)
 {
   if (!_library)
     throw Error("Can't create " + _TName("Cell") + " : null library");
@@ -789,10 +791,39 @@ void Cell::_setAbutmentBox(const Box& abutmentBox)
       _unfit( _abutmentBox );
     _abutmentBox = abutmentBox;
     _fit( _abutmentBox );
+    _invalidateFlatOccurrenceTable();
   }
 }
 
 
+const FlatOccurrenceTable& Cell::getFlatOccurrenceTable() const
+// *************************************************************
+{
+  if (not _flatOccurrenceTable)
+    _flatOccurrenceTable = new FlatOccurrenceTable( this );
+  return *_flatOccurrenceTable;
+}
+
+
+void Cell::_invalidateFlatOccurrenceTable()
+// ****************************************
+{
+// When set, the flag ensure that all the tables built over this Cell
+// (it's own and the ones of the Cells instanciating it, recursively)
+// are already discarded, so we can stop here. It is reset by the
+// tables builds.
+  if (_flatOccurrencesInvalidated) return;
+  _flatOccurrencesInvalidated = true;
+
+  if (_flatOccurrenceTable) {
+    delete _flatOccurrenceTable;
+    _flatOccurrenceTable = NULL;
+  }
+  for ( Instance* slave : getSlaveInstances() )
+    slave->getCell()->_invalidateFlatOccurrenceTable();
+}
+
+
 DeepNet* Cell::getDeepNet ( Path path, const Net* leafNet ) const
 // **************************************************************
 {
@@ -1131,9 +1162,23 @@ void Cell::materialize()
   for ( Net*    net    : getNets   () ) net   ->materialize();
   for ( Marker* marker : getMarkers() ) marker->materialize();
 
+  if (isRTreeIndexed()) {
+    _quadTree->_flushRTree();
+    for ( Slice* slice : getSlices() ) slice->_getQuadTree()->_flushRTree();
+  }
+
   cdebug_tabw(18,-1);
 }
 
+void Cell::setRTreeIndex(bool state)
+// *********************************
+{
+  _flags.set( Flags::RTreeIndex, state );
+
+  _quadTree->_setRTreeIndex( state );
+  for ( Slice* slice : getSlices() ) slice->_getQuadTree()->_setRTreeIndex( state );
+}
+
 void Cell::unmaterialize()
 // ***********************
 {
@@ -1216,6 +1261,9 @@ void Cell::_preDestroy()
 {
   notify( Flags::CellDestroyed );
 
+  delete _flatOccurrenceTable;
+  _flatOccurrenceTable = NULL;
+
   while ( _slaveEntityMap.size() ) {
     _slaveEntityMap.begin()->second->destroy();
   }
@@ -1276,6 +1324,7 @@ Record* Cell::_getRecord() const
         record->add( getSlot("_abutmentBox"    , &_abutmentBox     ) );
         record->add( getSlot("_boundingBox"    , &_boundingBox     ) );
         record->add( getSlot("_flags"          , &_flags           ) );
+        record->add( getSlot("_flatOccurrenceTable", _flatOccurrenceTable) );
     }
     return record;
 }
@@ -1410,6 +1459,7 @@ void Cell::_toJsonCollections(JsonWriter* writer) const
     if (_flags & AbstractedSupply) { if (s.size() > 1) s += "|"; s += "AbstractedSupply"; }
     if (_flags & SlavedAb        ) { if (s.size() > 1) s += "|"; s += "SlavedAb"; }
     if (_flags & Materialized    ) { if (s.size() > 1) s += "|"; s += "Materialized"; }
+    if (_flags & RTreeIndex      ) { if (s.size() > 1) s += "|"; s += "RTreeIndex"; }
     s += ">";
 
     return s;
@@ -0,0 +1,1385 @@
+// -*- C++ -*-
+//
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// This file is part of Hurricane.
+//
+// Hurricane is free software: you can redistribute it  and/or  modify
+// it under the terms of the GNU  Lesser  General  Public  License  as
+// published by the Free Software Foundation, either version 3 of  the
+// License, or (at your option) any later version.
+//
+// Hurricane is distributed in the hope that it will  be  useful,  but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHAN-
+// TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See  the  Lesser  GNU
+// General Public License for more details.
+//
+// You should have received a copy of the Lesser  GNU  General  Public
+// License along with Hurricane. If not, see
+//                                     <http://www.gnu.org/licenses/>.
+//
+// +-----------------------------------------------------------------+
+// |                  H U R R I C A N E                              |
+// |     V L S I   B a c k e n d   D a t a - B a s e                 |
+// |                                                                 |
+// |  Author      :                    Jean-Paul Chaput              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./Checkpoint.cpp"                              |
+// +-----------------------------------------------------------------+
+
+
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+#include <set>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "hurricane/Error.h"
+#include "hurricane/Warning.h"
+#include "hurricane/DbU.h"
+#include "hurricane/DataBase.h"
+#include "hurricane/Technology.h"
+#include "hurricane/Layer.h"
+#include "hurricane/Library.h"
+#include "hurricane/Cell.h"
+#include "hurricane/CellsSort.h"
+#include "hurricane/Instance.h"
+#include "hurricane/Net.h"
+#include "hurricane/DeepNet.h"
+#include "hurricane/HyperNet.h"
+#include "hurricane/NetAlias.h"
+#include "hurricane/NetExternalComponents.h"
+#include "hurricane/Plug.h"
+#include "hurricane/Contact.h"
+#include "hurricane/Pin.h"
+#include "hurricane/Horizontal.h"
+#include "hurricane/Vertical.h"
+#include "hurricane/Pad.h"
+#include "hurricane/Diagonal.h"
+#include "hurricane/Rectilinear.h"
+#include "hurricane/Polygon.h"
+#include "hurricane/RoutingPad.h"
+#include "hurricane/Reference.h"
+#include "hurricane/Occurrence.h"
+#include "hurricane/Path.h"
+#include "hurricane/UpdateSession.h"
+#include "hurricane/Checkpoint.h"
+
+
+namespace {
+
+  using namespace std;
+  using namespace Hurricane;
+
+
+// -------------------------------------------------------------------
+// On disk format (version 1).
+//
+// A header, followed by the sections, each one being a flat array of
+// fixed size records, aligned on 8 bytes. All the integers are stored
+// in the native byte order, which is checked through the endian tag.
+// The indexes of the nets, instances & components are relative to the
+// ones of their owner Cell. A hook is designated by the index of it's
+// component, shifted by two bits, plus it's slot (0 for the body hook,
+// 1 for the anchor or source hook and 2 for the target hook).
+
+  const uint32_t  NoIndex   = 0xffffffff;
+  const char      Magic[8]  = { 'H', 'U', 'R', 'C', 'K', 'P', 'T', '\0' };
+  const uint32_t  EndianTag = 0x01020304;
+
+  enum SectionKind { StringsSection     =  0
+                   , CharsSection       =  1
+                   , LayersSection      =  2
+                   , LibrariesSection   =  3
+                   , CellsSection       =  4
+                   , InstancesSection   =  5
+                   , NetsSection        =  6
+                   , AliasesSection     =  7
+                   , ComponentsSection  =  8
+                   , PointsSection      =  9
+                   , OccurrencesSection = 10
+                   , PathsSection       = 11
+                   , ReferencesSection  = 12
+                   , SectionCount       = 13
+                   };
+
+  enum ComponentKind { ContactKind     =  1
+                     , PinKind         =  2
+                     , HorizontalKind  =  3
+                     , VerticalKind    =  4
+                     , PadKind         =  5
+                     , DiagonalKind    =  6
+                     , RectilinearKind =  7
+                     , PolygonKind     =  8
+                     , RoutingPadKind  =  9
+                     , PlugKind        = 10
+                     };
+
+  enum EntityKind { ComponentEntity = 1
+                  , PlugEntity      = 2
+                  };
+
+  const uint32_t  ExternalComponent = (1 << 0);
+
+  const uint32_t  GlobalNet         = (1 << 0);
+  const uint32_t  ExternalNet       = (1 << 1);
+  const uint32_t  AutomaticNet      = (1 << 2);
+  const uint32_t  DeepNetFlag       = (1 << 3);
+
+  const uint64_t  SavedCellFlags    = Cell::Flags::TerminalNetlist
+                                    | Cell::Flags::Pad
+                                    | Cell::Flags::Feed
+                                    | Cell::Flags::Diode
+                                    | Cell::Flags::PowerFeed
+                                    | Cell::Flags::FlattenedNets
+                                    | Cell::Flags::AbstractedSupply
+                                    | Cell::Flags::Placed
+                                    | Cell::Flags::Routed
+                                    | Cell::Flags::NoExtractConsistent;
+
+
+  struct FileSection {
+    uint64_t  _offset;
+    uint32_t  _count;
+    uint32_t  _recordSize;
+  };
+
+
+  struct FileHeader {
+    char         _magic[8];
+    uint32_t     _version;
+    uint32_t     _endianTag;
+    uint64_t     _fileSize;
+    uint32_t     _precision;
+    uint32_t     _topCell;
+    double       _gridsPerLambda;
+    double       _physicalsPerGrid;
+    FileSection  _sections[ SectionCount ];
+  };
+
+
+  struct StringRecord {
+    uint32_t  _offset;
+    uint32_t  _length;
+  };
+
+
+  struct LayerRecord {
+    uint32_t  _name;
+  };
+
+
+  struct LibraryRecord {
+    uint32_t  _name;
+    uint32_t  _parent;
+  };
+
+
+  struct CellRecord {
+    uint32_t  _name;
+    uint32_t  _library;
+    uint64_t  _flags;
+    int64_t   _abutmentBox[4];
+    uint32_t  _firstInstance;
+    uint32_t  _instanceCount;
+    uint32_t  _firstNet;
+    uint32_t  _netCount;
+    uint32_t  _firstComponent;
+    uint32_t  _componentCount;
+    uint32_t  _firstReference;
+    uint32_t  _referenceCount;
+  };
+
+
+  struct InstanceRecord {
+    uint32_t  _name;
+    uint32_t  _master;
+    int64_t   _tx;
+    int64_t   _ty;
+    uint32_t  _orientation;
+    uint32_t  _placementStatus;
+  };
+
+
+  struct NetRecord {
+    uint32_t  _name;
+    uint32_t  _flags;
+    uint32_t  _firstComponent;
+    uint32_t  _componentCount;
+    uint32_t  _firstAlias;
+    uint32_t  _aliasCount;
+    uint32_t  _type;
+    uint32_t  _direction;
+    uint32_t  _rootPathFirst;
+    uint32_t  _rootPathLength;
+    uint32_t  _rootNetName;
+    uint32_t  _reserved;
+  };
+
+
+  struct AliasRecord {
+    uint32_t  _name;
+    uint32_t  _isExternal;
+  };
+
+
+// The meaning of _extras & _values depends on the kind:
+//   Contact     : dx, dy, width, height.
+//   Pin         : idem, _extras = { name, accessDirection|placementStatus<<8 }.
+//   Horizontal  : y, width, dxSource, dxTarget.
+//   Vertical    : x, width, dySource, dyTarget.
+//   Pad         : the bounding box.
+//   Diagonal    : source x & y, target x & y, width.
+//   Rectilinear : _extras = { first point, number of points }.
+//   Polygon     : idem.
+//   RoutingPad  : user center x & y, _extras = { occurrence, flags }.
+//   Plug        : _extras = { instance, master net name }.
+
+  struct ComponentRecord {
+    uint8_t   _kind;
+    uint8_t   _flags;
+    uint16_t  _reserved;
+    uint32_t  _layer;
+    uint32_t  _extras[2];
+    uint32_t  _hooks[3];
+    uint32_t  _padding;
+    int64_t   _values[5];
+  };
+
+
+  struct PointRecord {
+    int64_t  _x;
+    int64_t  _y;
+  };
+
+
+// Entity designated through the name of it's net (and the bounding box
+// & layer, to find it back in a Cell which is not rebuilt from the file)
+// or through the instance and the master net name, for a Plug.
+
+  struct OccurrenceRecord {
+    uint32_t  _pathFirst;
+    uint32_t  _pathLength;
+    uint32_t  _entityKind;
+    uint32_t  _entityCell;
+    uint32_t  _entityIndex;
+    uint32_t  _names[2];
+    uint32_t  _layer;
+    int64_t   _box[4];
+  };
+
+
+  struct PathRecord {
+    uint32_t  _instance;
+  };
+
+
+  struct ReferenceRecord {
+    uint32_t  _name;
+    uint32_t  _type;
+    int64_t   _x;
+    int64_t   _y;
+  };
+
+
+  const uint32_t  RecordSizes[ SectionCount ] = { sizeof(StringRecord)
+                                                , sizeof(char)
+                                                , sizeof(LayerRecord)
+                                                , sizeof(LibraryRecord)
+                                                , sizeof(CellRecord)
+                                                , sizeof(InstanceRecord)
+                                                , sizeof(NetRecord)
+                                                , sizeof(AliasRecord)
+                                                , sizeof(ComponentRecord)
+                                                , sizeof(PointRecord)
+                                                , sizeof(OccurrenceRecord)
+                                                , sizeof(PathRecord)
+                                                , sizeof(ReferenceRecord)
+                                                };
+
+
+  inline uint64_t  align8 ( uint64_t size ) { return (size + 7) & ~(uint64_t)7; }
+
+
+  void  boxToRecord ( const Box& box, int64_t* values )
+  {
+    if (box.isEmpty()) {
+      values[0] = 1; values[1] = 1; values[2] = -1; values[3] = -1;
+      return;
+    }
+    values[0] = box.getXMin(); values[1] = box.getYMin();
+    values[2] = box.getXMax(); values[3] = box.getYMax();
+  }
+
+
+  Box  boxFromRecord ( const int64_t* values )
+  {
+    if ((values[0] > values[2]) or (values[1] > values[3])) return Box();
+    return Box( values[0], values[1], values[2], values[3] );
+  }
+
+
+  uint8_t  getComponentKind ( const Component* component )
+  {
+    if (dynamic_cast<const Plug*       >(component)) return PlugKind;
+    if (dynamic_cast<const RoutingPad* >(component)) return RoutingPadKind;
+    if (dynamic_cast<const Pin*        >(component)) return PinKind;
+    if (dynamic_cast<const Contact*    >(component)) return ContactKind;
+    if (dynamic_cast<const Horizontal* >(component)) return HorizontalKind;
+    if (dynamic_cast<const Vertical*   >(component)) return VerticalKind;
+    if (dynamic_cast<const Pad*        >(component)) return PadKind;
+    if (dynamic_cast<const Diagonal*   >(component)) return DiagonalKind;
+    if (dynamic_cast<const Rectilinear*>(component)) return RectilinearKind;
+    if (dynamic_cast<const Polygon*    >(component)) return PolygonKind;
+    return 0;
+  }
+
+
+  Hook* getComponentHook ( Component* component, uint8_t kind, uint32_t slot )
+  {
+    if (not component) return NULL;
+    if (slot == 0) return component->getBodyHook();
+    switch ( kind ) {
+      case ContactKind:
+      case PinKind:
+        if (slot == 1) return static_cast<Contact*>( component )->getAnchorHook();
+        break;
+      case HorizontalKind:
+      case VerticalKind:
+        if (slot == 1) return static_cast<Segment*>( component )->getSourceHook();
+        if (slot == 2) return static_cast<Segment*>( component )->getTargetHook();
+        break;
+    }
+    return NULL;
+  }
+
+
+// -------------------------------------------------------------------
+// Class  :  "CheckpointWriter".
+
+  class CheckpointWriter {
+    public:
+                CheckpointWriter ( Cell* topCell );
+      void      write            ( const string& path );
+    private:
+      uint32_t  _addString       ( const string& );
+      uint32_t  _addName         ( const Name& );
+      uint32_t  _addLayer        ( const Layer* );
+      void      _addLibrary      ( Library*, uint32_t parent );
+      void      _addCell         ( Cell* );
+      void      _addPath         ( Path, uint32_t& first, uint32_t& length );
+      uint32_t  _addOccurrence   ( Cell*, const Occurrence&, const unordered_map<const Component*,uint32_t>& );
+      template< typename T >
+      void      _writeSection    ( FILE*, const vector<T>& );
+    private:
+      Cell*                                     _topCell;
+      vector<StringRecord>                      _strings;
+      vector<char>                              _chars;
+      unordered_map<string,uint32_t>            _stringIds;
+      vector<LayerRecord>                       _layers;
+      unordered_map<const Layer*,uint32_t>      _layerIds;
+      vector<LibraryRecord>                     _libraries;
+      unordered_map<const Library*,uint32_t>    _libraryIds;
+      vector<CellRecord>                        _cells;
+      unordered_map<const Cell*,uint32_t>       _cellIds;
+      vector<InstanceRecord>                    _instances;
+      vector<NetRecord>                         _nets;
+      vector<AliasRecord>                       _aliases;
+      vector<ComponentRecord>                   _components;
+      vector<PointRecord>                       _points;
+      vector<OccurrenceRecord>                  _occurrences;
+      vector<PathRecord>                        _paths;
+      vector<ReferenceRecord>                   _references;
+      unordered_map<const Component*,uint32_t>  _masterComponents;
+      set<string>                               _unsupporteds;
+  };
+
+
+  CheckpointWriter::CheckpointWriter ( Cell* topCell )
+    : _topCell(topCell)
+  {
+    DataBase* db = DataBase::getDB();
+    if (not db or not db->getRootLibrary())
+      throw Error( "Checkpoint::save(): The DataBase is empty." );
+
+    _addLibrary( db->getRootLibrary(), NoIndex );
+
+  // Cells are stored bottom-up, so the components of the master Cells
+  // are already numbered when an occurrence refers to them.
+    CellsSort cellsSort;
+    cellsSort.addLibrary( db->getRootLibrary() );
+    cellsSort.sort();
+    const vector<Cell*>& sorteds = cellsSort.getSortedCells();
+    for ( auto icell = sorteds.rbegin() ; icell != sorteds.rend() ; ++icell ) {
+      _cellIds[ *icell ] = _cellIds.size();
+    }
+    for ( auto icell = sorteds.rbegin() ; icell != sorteds.rend() ; ++icell ) {
+      _addCell( *icell );
+    }
+  }
+
+
+  uint32_t  CheckpointWriter::_addString ( const string& s )
+  {
+    auto istring = _stringIds.find( s );
+    if (istring != _stringIds.end()) return istring->second;
+
+    uint32_t id = _strings.size();
+    _strings.push_back( { (uint32_t)_chars.size(), (uint32_t)s.size() } );
+    _chars.insert( _chars.end(), s.begin(), s.end() );
+    _stringIds.insert( make_pair(s,id) );
+    return id;
+  }
+
+
+  uint32_t  CheckpointWriter::_addName ( const Name& name )
+  { return _addString( getString(name) ); }
+
+
+  uint32_t  CheckpointWriter::_addLayer ( const Layer* layer )
+  {
+    if (not layer) return NoIndex;
+
+    auto ilayer = _layerIds.find( layer );
+    if (ilayer != _layerIds.end()) return ilayer->second;
+
+    uint32_t id = _layers.size();
+    _layers.push_back( { _addName(layer->getName()) } );
+    _layerIds.insert( make_pair(layer,id) );
+    return id;
+  }
+
+
+  void  CheckpointWriter::_addLibrary ( Library* library, uint32_t parent )
+  {
+    uint32_t id = _libraries.size();
+    _libraries.push_back( { _addName(library->getName()), parent } );
+    _libraryIds.insert( make_pair(library,id) );
+
+    for ( Library* child : library->getLibraries() ) _addLibrary( child, id );
+  }
+
+
+  void  CheckpointWriter::_addPath ( Path path, uint32_t& first, uint32_t& length )
+  {
+    first  = _paths.size();
+    length = 0;
+    while ( not path.isEmpty() ) {
+      _paths.push_back( { _addName(path.getHeadInstance()->getName()) } );
+      path = path.getTailPath();
+      ++length;
+    }
+  }
+
+
+  uint32_t  CheckpointWriter::_addOccurrence ( Cell*                                           cell
+                                             , const Occurrence&                               occurrence
+                                             , const unordered_map<const Component*,uint32_t>& locals )
+  {
+    OccurrenceRecord record;
+    memset( &record, 0, sizeof(OccurrenceRecord) );
+    _addPath( occurrence.getPath(), record._pathFirst, record._pathLength );
+
+    Plug*      plug      = dynamic_cast<Plug*>( occurrence.getEntity() );
+    Component* component = dynamic_cast<Component*>( occurrence.getEntity() );
+    if (plug) {
+      record._entityKind  = PlugEntity;
+      record._entityCell  = _cellIds[ plug->getCell() ];
+      record._entityIndex = NoIndex;
+      record._names[0]    = _addName( plug->getInstance()->getName() );
+      record._names[1]    = _addName( plug->getMasterNet()->getName() );
+      record._layer       = NoIndex;
+    } else if (component) {
+      record._entityKind  = ComponentEntity;
+      record._entityCell  = _cellIds[ component->getCell() ];
+      record._entityIndex = NoIndex;
+      const unordered_map<const Component*,uint32_t>& indexes
+        = (component->getCell() == cell) ? locals : _masterComponents;
+      auto icomponent = indexes.find( component );
+      if (icomponent != indexes.end()) record._entityIndex = icomponent->second;
+      record._names[0]    = _addName( component->getNet()->getName() );
+      record._names[1]    = NoIndex;
+      record._layer       = _addLayer( component->getLayer() );
+      boxToRecord( component->getBoundingBox(), record._box );
+    } else {
+      cerr << Warning( "Checkpoint::save(): Unsupported occurrence %s in %s."
+                     , getString(occurrence).c_str()
+                     , getString(cell).c_str() ) << endl;
+      return NoIndex;
+    }
+
+    _occurrences.push_back( record );
+    return _occurrences.size() - 1;
+  }
+
+
+  void  CheckpointWriter::_addCell ( Cell* cell )
+  {
+    CellRecord record;
+    memset( &record, 0, sizeof(CellRecord) );
+    record._name    = _addName( cell->getName() );
+    record._library = _libraryIds[ cell->getLibrary() ];
+    record._flags   = cell->getFlags().value() & SavedCellFlags;
+    if (cell->isRTreeIndexed()) record._flags |= Cell::Flags::RTreeIndex;
+    boxToRecord( cell->getAbutmentBox(), record._abutmentBox );
+
+    unordered_map<const Instance*,uint32_t>  instanceIds;
+    record._firstInstance = _instances.size();
+    for ( Instance* instance : cell->getInstances() ) {
+      const Transformation& transf = instance->getTransformation();
+      instanceIds.insert( make_pair(instance,instanceIds.size()) );
+      _instances.push_back( { _addName( instance->getName() )
+                            , _cellIds[ instance->getMasterCell() ]
+                            , transf.getTx()
+                            , transf.getTy()
+                            , (uint32_t)transf.getOrientation().getCode()
+                            , (uint32_t)instance->getPlacementStatus().getCode()
+                            } );
+    }
+    record._instanceCount = instanceIds.size();
+
+  // First pass: number the components & their hooks.
+    vector< pair<Component*,uint8_t> >         components;
+    unordered_map<const Component*,uint32_t>   componentIds;
+    unordered_map<const Hook*,uint32_t>        hookIds;
+    vector<Net*>                               nets;
+
+    record._firstNet       = _nets.size();
+    record._firstComponent = _components.size();
+    for ( Net* net : cell->getNets() ) {
+      NetRecord netRecord;
+      memset( &netRecord, 0, sizeof(NetRecord) );
+      netRecord._name           = _addName( net->getName() );
+      netRecord._firstComponent = components.size();
+      netRecord._type           = net->getType().getCode();
+      netRecord._direction      = net->getDirection().getCode();
+      netRecord._rootPathFirst  = NoIndex;
+      netRecord._rootNetName    = NoIndex;
+      if (net->isGlobal   ()) netRecord._flags |= GlobalNet;
+      if (net->isExternal ()) netRecord._flags |= ExternalNet;
+      if (net->isAutomatic()) netRecord._flags |= AutomaticNet;
+
+      DeepNet* deepNet = dynamic_cast<DeepNet*>( net );
+      if (deepNet) {
+        Occurrence rootNetOccurrence = deepNet->getRootNetOccurrence();
+        Net*       rootNet           = dynamic_cast<Net*>( rootNetOccurrence.getEntity() );
+        if (rootNet) {
+          netRecord._flags      |= DeepNetFlag;
+          netRecord._rootNetName = _addName( rootNet->getName() );
+          _addPath( rootNetOccurrence.getPath(), netRecord._rootPathFirst, netRecord._rootPathLength );
+        }
+      }
+
+      netRecord._firstAlias = _aliases.size();
+      for ( NetAliasHook* alias : net->getAliases() ) {
+        _aliases.push_back( { _addName(alias->getName()), (uint32_t)alias->isExternal() } );
+      }
+      netRecord._aliasCount = _aliases.size() - netRecord._firstAlias;
+
+      for ( Component* component : net->getComponents() ) {
+        uint8_t kind = getComponentKind( component );
+        if (not kind) {
+          _unsupporteds.insert( component->_getTypeName() );
+          continue;
+        }
+        uint32_t id = components.size();
+        components.push_back( make_pair(component,kind) );
+        componentIds.insert( make_pair(component,id) );
+        for ( uint32_t slot=0 ; slot<3 ; ++slot ) {
+          Hook* hook = getComponentHook( component, kind, slot );
+          if (hook) hookIds.insert( make_pair(hook,(id << 2) + slot) );
+        }
+      }
+      netRecord._componentCount = components.size() - netRecord._firstComponent;
+
+      nets.push_back( net );
+      _nets.push_back( netRecord );
+    }
+    record._netCount       = nets.size();
+    record._componentCount = components.size();
+
+  // Second pass: the components themselves, with their hook rings. A
+  // component of an unsupported type is skipped in the rings.
+    for ( auto& item : components ) {
+      Component*      component = item.first;
+      ComponentRecord crecord;
+      memset( &crecord, 0, sizeof(ComponentRecord) );
+      crecord._kind  = item.second;
+      crecord._layer = _addLayer( component->getLayer() );
+      if (NetExternalComponents::isExternal(component)) crecord._flags |= ExternalComponent;
+
+      for ( uint32_t slot=0 ; slot<3 ; ++slot ) {
+        crecord._hooks[slot] = NoIndex;
+        Hook* hook = getComponentHook( component, item.second, slot );
+        if (not hook) continue;
+        for ( Hook* next = hook->getNextHook() ; next != hook ; next = next->getNextHook() ) {
+          auto ihook = hookIds.find( next );
+          if (ihook != hookIds.end()) { crecord._hooks[slot] = ihook->second; break; }
+        }
+      }
+
+      switch ( item.second ) {
+        case PinKind: {
+          Pin* pin = static_cast<Pin*>( component );
+          crecord._extras[0] = _addName( pin->getName() );
+          crecord._extras[1] = pin->getAccessDirection().getCode()
+                             | (pin->getPlacementStatus().getCode() << 8);
+        }
+        // Falltrough.
+        case ContactKind: {
+          Contact* contact = static_cast<Contact*>( component );
+          crecord._values[0] = contact->getDx();
+          crecord._values[1] = contact->getDy();
+          crecord._values[2] = contact->getWidth();
+          crecord._values[3] = contact->getHeight();
+          break;
+        }
+        case HorizontalKind: {
+          Horizontal* horizontal = static_cast<Horizontal*>( component );
+          crecord._values[0] = horizontal->getY();
+          crecord._values[1] = horizontal->getWidth();
+          crecord._values[2] = horizontal->getDxSource();
+          crecord._values[3] = horizontal->getDxTarget();
+          break;
+        }
+        case VerticalKind: {
+          Vertical* vertical = static_cast<Vertical*>( component );
+          crecord._values[0] = vertical->getX();
+          crecord._values[1] = vertical->getWidth();
+          crecord._values[2] = vertical->getDySource();
+          crecord._values[3] = vertical->getDyTarget();
+          break;
+        }
+        case PadKind:
+          boxToRecord( component->getBoundingBox(), crecord._values );
+          break;
+        case DiagonalKind: {
+          Diagonal* diagonal = static_cast<Diagonal*>( component );
+          crecord._values[0] = diagonal->getSourceX();
+          crecord._values[1] = diagonal->getSourceY();
+          crecord._values[2] = diagonal->getTargetX();
+          crecord._values[3] = diagonal->getTargetY();
+          crecord._values[4] = diagonal->getWidth();
+          break;
+        }
+        case RectilinearKind:
+        case PolygonKind: {
+          const vector<Point>& points = (item.second == RectilinearKind)
+                                      ? static_cast<Rectilinear*>( component )->getPoints()
+                                      : static_cast<Polygon*    >( component )->getPoints();
+          crecord._extras[0] = _points.size();
+          crecord._extras[1] = points.size();
+          for ( const Point& point : points ) _points.push_back( { point.getX(), point.getY() } );
+          break;
+        }
+        case RoutingPadKind: {
+          RoutingPad* rp = static_cast<RoutingPad*>( component );
+          crecord._extras[0] = _addOccurrence( cell, rp->getOccurrence(), componentIds );
+          crecord._extras[1] = rp->getFlags();
+          if (rp->hasUserCenter()) {
+            crecord._values[0] = rp->getUserCenter().getX();
+            crecord._values[1] = rp->getUserCenter().getY();
+          }
+          break;
+        }
+        case PlugKind: {
+          Plug* plug = static_cast<Plug*>( component );
+          crecord._extras[0] = instanceIds[ plug->getInstance() ];
+          crecord._extras[1] = _addName( plug->getMasterNet()->getName() );
+          break;
+        }
+      }
+      _components.push_back( crecord );
+    }
+
+    if (cell->getSlaveInstances().getFirst()) {
+      for ( auto& item : componentIds ) _masterComponents.insert( item );
+    }
+
+    record._firstReference = _references.size();
+    for ( Reference* reference : cell->getReferences() ) {
+      _references.push_back( { _addName( reference->getName() )
+                             , (uint32_t)reference->getType()
+                             , reference->getPoint().getX()
+                             , reference->getPoint().getY()
+                             } );
+    }
+    record._referenceCount = _references.size() - record._firstReference;
+
+    _cells.push_back( record );
+  }
+
+
+  template< typename T >
+  void  CheckpointWriter::_writeSection ( FILE* file, const vector<T>& records )
+  {
+    static const char zeros[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+    size_t size = records.size() * sizeof(T);
+    if (size) fwrite( records.data(), 1, size, file );
+    fwrite( zeros, 1, align8(size) - size, file );
+  }
+
+
+  void  CheckpointWriter::write ( const string& path )
+  {
+    for ( const string& tname : _unsupporteds ) {
+      cerr << Warning( "Checkpoint::save(): Components of type %s are not saved.", tname.c_str() ) << endl;
+    }
+
+    FileHeader header;
+    memset( &header, 0, sizeof(FileHeader) );
+    memcpy( header._magic, Magic, sizeof(Magic) );
+    header._version          = Checkpoint::Version;
+    header._endianTag        = EndianTag;
+    header._precision        = DbU::getPrecision();
+    header._gridsPerLambda   = DbU::getGridsPerLambda();
+    header._physicalsPerGrid = DbU::getPhysicalsPerGrid();
+    header._topCell          = NoIndex;
+    if (_topCell) {
+      auto icell = _cellIds.find( _topCell );
+      if (icell != _cellIds.end()) header._topCell = icell->second;
+    }
+
+    const size_t counts[ SectionCount ] = { _strings    .size()
+                                          , _chars      .size()
+                                          , _layers     .size()
+                                          , _libraries  .size()
+                                          , _cells      .size()
+                                          , _instances  .size()
+                                          , _nets       .size()
+                                          , _aliases    .size()
+                                          , _components .size()
+                                          , _points     .size()
+                                          , _occurrences.size()
+                                          , _paths      .size()
+                                          , _references .size()
+                                          };
+    uint64_t offset = align8( sizeof(FileHeader) );
+    for ( size_t kind=0 ; kind<SectionCount ; ++kind ) {
+      if (counts[kind] >= NoIndex)
+        throw Error( "Checkpoint::save(): Too many records (%zu) in section %zu.", counts[kind], kind );
+      header._sections[kind]._offset     = offset;
+      header._sections[kind]._count      = counts[kind];
+      header._sections[kind]._recordSize = RecordSizes[kind];
+      offset += align8( counts[kind] * RecordSizes[kind] );
+    }
+    header._fileSize = offset;
+
+    FILE* file = fopen( path.c_str(), "wb" );
+    if (not file)
+      throw Error( "Checkpoint::save(): Cannot open file \"%s\" for writing.", path.c_str() );
+
+    fwrite( &header, 1, sizeof(FileHeader), file );
+    fwrite( Magic, 1, align8(sizeof(FileHeader)) - sizeof(FileHeader), file );
+    _writeSection( file, _strings     );
+    _writeSection( file, _chars       );
+    _writeSection( file, _layers      );
+    _writeSection( file, _libraries   );
+    _writeSection( file, _cells       );
+    _writeSection( file, _instances   );
+    _writeSection( file, _nets        );
+    _writeSection( file, _aliases     );
+    _writeSection( file, _components  );
+    _writeSection( file, _points      );
+    _writeSection( file, _occurrences );
+    _writeSection( file, _paths       );
+    _writeSection( file, _references  );
+
+    bool failed = ferror( file );
+    if (fclose(file) or failed)
+      throw Error( "Checkpoint::save(): Error while writing \"%s\".", path.c_str() );
+  }
+
+
+}  // Anonymous namespace.
+
+
+namespace Hurricane {
+
+
+// -------------------------------------------------------------------
+// Class  :  "Hurricane::Checkpoint".
+
+
+  const uint32_t  Checkpoint::Version  = 1;
+  Checkpoint*     Checkpoint::_current = NULL;
+
+
+  void  Checkpoint::save ( const string& path, Cell* topCell )
+  {
+    CheckpointWriter writer ( topCell );
+    writer.write( path );
+  }
+
+
+  Checkpoint* Checkpoint::open ( const string& path )
+  {
+    Checkpoint* checkpoint = new Checkpoint ( path );
+    try {
+      checkpoint->_map();
+      checkpoint->_loadLayers();
+      checkpoint->_loadLibraries();
+    } catch ( ... ) {
+      delete checkpoint;
+      throw;
+    }
+    return checkpoint;
+  }
+
+
+  Cell* Checkpoint::load ( const string& path )
+  {
+    close();
+    _current = open( path );
+    return _current->getTopCell();
+  }
+
+
+  Checkpoint* Checkpoint::getCurrent ()
+  { return _current; }
+
+
+  void  Checkpoint::close ()
+  {
+    delete _current;
+    _current = NULL;
+  }
+
+
+  Checkpoint::Checkpoint ( const string& path )
+    : _path       (path)
+    , _fd         (-1)
+    , _base       (NULL)
+    , _size       (0)
+    , _sections   ()
+    , _layers     ()
+    , _libraries  ()
+    , _cells      ()
+    , _rebuilts   ()
+    , _pendings   ()
+    , _masters    ()
+    , _cellsByName()
+    , _components ()
+    , _topCell    (NoIndex)
+  { }
+
+
+  Checkpoint::~Checkpoint ()
+  {
+    if (_base) munmap( const_cast<char*>(_base), _size );
+    if (_fd >= 0) ::close( _fd );
+    if (_current == this) _current = NULL;
+  }
+
+
+  void  Checkpoint::_map ()
+  {
+    _fd = ::open( _path.c_str(), O_RDONLY );
+    if (_fd < 0)
+      throw Error( "Checkpoint::open(): Cannot open file \"%s\".", _path.c_str() );
+
+    struct stat status;
+    if (fstat(_fd,&status) or ((size_t)status.st_size < sizeof(FileHeader)))
+      throw Error( "Checkpoint::open(): \"%s\" is not a checkpoint (too short).", _path.c_str() );
+    _size = status.st_size;
+
+    void* base = mmap( NULL, _size, PROT_READ, MAP_PRIVATE, _fd, 0 );
+    if (base == MAP_FAILED)
+      throw Error( "Checkpoint::open(): Cannot map file \"%s\".", _path.c_str() );
+    _base = static_cast<const char*>( base );
+
+    const FileHeader* header = reinterpret_cast<const FileHeader*>( _base );
+    if (memcmp(header->_magic,Magic,sizeof(Magic)))
+      throw Error( "Checkpoint::open(): \"%s\" is not a checkpoint (bad magic).", _path.c_str() );
+    if (header->_endianTag != EndianTag)
+      throw Error( "Checkpoint::open(): \"%s\" has been saved on a machine of different endianness."
+                 , _path.c_str() );
+    if (header->_version != Version)
+      throw Error( "Checkpoint::open(): \"%s\" is in version %u, only version %u is supported."
+                 , _path.c_str(), header->_version, Version );
+    if (header->_fileSize != _size)
+      throw Error( "Checkpoint::open(): \"%s\" is truncated (%zu bytes instead of %zu)."
+                 , _path.c_str(), _size, (size_t)header->_fileSize );
+    if (   (header->_precision        != DbU::getPrecision())
+        or (header->_gridsPerLambda   != DbU::getGridsPerLambda())
+        or (header->_physicalsPerGrid != DbU::getPhysicalsPerGrid()) )
+      throw Error( "Checkpoint::open(): \"%s\" has been saved with different DbU settings\n"
+                   "        (precision:%u, grids per lambda:%g, physicals per grid:%g)."
+                 , _path.c_str()
+                 , header->_precision
+                 , header->_gridsPerLambda
+                 , header->_physicalsPerGrid );
+
+    for ( size_t kind=0 ; kind<SectionCount ; ++kind ) {
+      const FileSection& section = header->_sections[kind];
+      if (   (section._recordSize != RecordSizes[kind])
+          or (section._offset % 8)
+          or (section._offset + (uint64_t)section._count * section._recordSize > _size) )
+        throw Error( "Checkpoint::open(): \"%s\" is corrupted (section %zu).", _path.c_str(), kind );
+      _sections.push_back( { _base + section._offset, section._count } );
+    }
+    _topCell = header->_topCell;
+
+    _cells   .resize( _sections[CellsSection]._count, NULL  );
+    _rebuilts.resize( _sections[CellsSection]._count, false );
+    _pendings.resize( _sections[CellsSection]._count, false );
+    _masters .resize( _sections[CellsSection]._count, false );
+    for ( uint32_t i=0 ; i<_sections[InstancesSection]._count ; ++i ) {
+      _masters[ _checkIndex(CellsSection, _get<InstanceRecord>(InstancesSection,i)->_master) ] = true;
+    }
+    for ( uint32_t i=0 ; i<_sections[CellsSection]._count ; ++i ) {
+      _cellsByName.insert( make_pair( _getName(_get<CellRecord>(CellsSection,i)->_name), i ) );
+    }
+  }
+
+
+  uint32_t  Checkpoint::_checkIndex ( size_t kind, uint32_t index ) const
+  {
+    if (index >= _sections[kind]._count)
+      throw Error( "Checkpoint::_checkIndex(): \"%s\" is corrupted (index %u out of bounds in section %zu)."
+                 , _path.c_str(), index, kind );
+    return index;
+  }
+
+
+  Name  Checkpoint::_getName ( uint32_t index ) const
+  {
+    if (index == NoIndex) return Name();
+
+    const StringRecord* record = _get<StringRecord>( StringsSection, _checkIndex(StringsSection,index) );
+    if ((uint64_t)record->_offset + record->_length > _sections[CharsSection]._count)
+      throw Error( "Checkpoint::_getName(): \"%s\" is corrupted (string %u).", _path.c_str(), index );
+    return Name( string_view( _sections[CharsSection]._data + record->_offset, record->_length ) );
+  }
+
+
+  void  Checkpoint::_loadLayers ()
+  {
+    DataBase*   db     = DataBase::getDB();
+    Technology* techno = (db) ? db->getTechnology() : NULL;
+    if (not techno)
+      throw Error( "Checkpoint::open(): The Technology must be loaded before opening \"%s\"."
+                 , _path.c_str() );
+
+    string missings;
+    for ( uint32_t i=0 ; i<_sections[LayersSection]._count ; ++i ) {
+      Name   name  = _getName( _get<LayerRecord>(LayersSection,i)->_name );
+      Layer* layer = techno->getLayer( name );
+      if (not layer) missings += " " + getString(name);
+      _layers.push_back( layer );
+    }
+    if (not missings.empty())
+      throw Error( "Checkpoint::open(): Layers used in \"%s\" are missing from the Technology:\n"
+                   "       %s"
+                 , _path.c_str(), missings.c_str() );
+  }
+
+
+  void  Checkpoint::_loadLibraries ()
+  {
+    DataBase* db = DataBase::getDB();
+
+    for ( uint32_t i=0 ; i<_sections[LibrariesSection]._count ; ++i ) {
+      const LibraryRecord* record  = _get<LibraryRecord>( LibrariesSection, i );
+      Name                 name    = _getName( record->_name );
+      Library*             library = NULL;
+
+      if (record->_parent == NoIndex) {
+        library = db->getRootLibrary();
+        if (not library) library = Library::create( db, name );
+      } else {
+        if (record->_parent >= i)
+          throw Error( "Checkpoint::open(): \"%s\" is corrupted (library %u).", _path.c_str(), i );
+        Library* parent = _libraries[ record->_parent ];
+        library = parent->getLibrary( name );
+        if (not library) library = Library::create( parent, name );
+      }
+      _libraries.push_back( library );
+    }
+  }
+
+
+  size_t  Checkpoint::getCellsSize () const
+  { return _cells.size(); }
+
+
+  size_t  Checkpoint::getMaterializeds () const
+  {
+    size_t count = 0;
+    for ( Cell* cell : _cells ) if (cell) ++count;
+    return count;
+  }
+
+
+  Cell* Checkpoint::getTopCell ()
+  {
+    if (_topCell == NoIndex) return NULL;
+    return _materialize( _checkIndex(CellsSection,_topCell) );
+  }
+
+
+  Cell* Checkpoint::getCell ( const Name& name )
+  {
+    auto icell = _cellsByName.find( name );
+    if (icell == _cellsByName.end()) return NULL;
+    return _materialize( icell->second );
+  }
+
+
+  void  Checkpoint::materializeAll ()
+  {
+    for ( uint32_t i=0 ; i<_cells.size() ; ++i ) _materialize( i );
+  }
+
+
+  Path  Checkpoint::_getPath ( Cell* cell, uint32_t first, uint32_t length, Cell*& leaf ) const
+  {
+    vector<Instance*> instances;
+    leaf = cell;
+    for ( uint32_t i=0 ; i<length ; ++i ) {
+      Name      name     = _getName( _get<PathRecord>(PathsSection,_checkIndex(PathsSection,first+i))->_instance );
+      Instance* instance = leaf->getInstance( name );
+      if (not instance)
+        throw Error( "Checkpoint::_getPath(): No instance \"%s\" in %s (\"%s\")."
+                   , getString(name).c_str(), getString(leaf).c_str(), _path.c_str() );
+      instances.push_back( instance );
+      leaf = instance->getMasterCell();
+    }
+
+    Path path;
+    for ( auto iinstance = instances.rbegin() ; iinstance != instances.rend() ; ++iinstance )
+      path = Path( *iinstance, path );
+    return path;
+  }
+
+
+  Component* Checkpoint::_findComponent ( Cell* leaf, const void* data ) const
+  {
+    const OccurrenceRecord* record = static_cast<const OccurrenceRecord*>( data );
+
+    Net* net = leaf->getNet( _getName(record->_names[0]) );
+    if (not net) return NULL;
+
+    const Layer* layer = (record->_layer == NoIndex) ? NULL : _layers[ _checkIndex(LayersSection,record->_layer) ];
+    Box          box   = boxFromRecord( record->_box );
+    for ( Component* component : net->getComponents() ) {
+      if ((component->getLayer() == layer) and (component->getBoundingBox() == box))
+        return component;
+    }
+    return NULL;
+  }
+
+
+  Occurrence  Checkpoint::_getOccurrence ( Cell* cell, uint32_t index, const vector<Component*>& locals ) const
+  {
+    const OccurrenceRecord* record = _get<OccurrenceRecord>( OccurrencesSection, _checkIndex(OccurrencesSection,index) );
+
+    Cell* leaf = NULL;
+    Path  path = _getPath( cell, record->_pathFirst, record->_pathLength, leaf );
+
+    Entity* entity = NULL;
+    if (record->_entityKind == PlugEntity) {
+      Instance* instance = leaf->getInstance( _getName(record->_names[0]) );
+      if (instance) {
+        Net* masterNet = instance->getMasterCell()->getNet( _getName(record->_names[1]) );
+        if (masterNet) entity = instance->getPlug( masterNet );
+      }
+    } else {
+      if (record->_entityIndex != NoIndex) {
+        if (leaf == cell) {
+          if (record->_entityIndex < locals.size()) entity = locals[ record->_entityIndex ];
+        } else {
+          auto icomponents = _components.find( record->_entityCell );
+          if (    (icomponents != _components.end())
+              and (_cells[record->_entityCell] == leaf)
+              and (record->_entityIndex < icomponents->second.size()) )
+            entity = icomponents->second[ record->_entityIndex ];
+        }
+      }
+      if (not entity) entity = _findComponent( leaf, record );
+    }
+
+    if (not entity) return Occurrence();
+    return Occurrence( entity, path );
+  }
+
+
+  Cell* Checkpoint::_materialize ( uint32_t index )
+  {
+    if (_cells[index]) return _cells[index];
+
+    const CellRecord* record  = _get<CellRecord>( CellsSection, index );
+    if (   ((uint64_t)record->_firstInstance  + record->_instanceCount  > _sections[InstancesSection ]._count)
+        or ((uint64_t)record->_firstNet       + record->_netCount       > _sections[NetsSection      ]._count)
+        or ((uint64_t)record->_firstComponent + record->_componentCount > _sections[ComponentsSection]._count)
+        or ((uint64_t)record->_firstReference + record->_referenceCount > _sections[ReferencesSection]._count) )
+      throw Error( "Checkpoint::_materialize(): \"%s\" is corrupted (cell %u).", _path.c_str(), index );
+    Library*          library = _libraries[ _checkIndex(LibrariesSection,record->_library) ];
+    Name              name    = _getName( record->_name );
+
+    Cell* cell = library->getCell( name );
+    if (cell) {
+      _cells[index] = cell;
+      return cell;
+    }
+
+  // A Cell still pending when reached again is part of an instanciation
+  // loop (A -> B -> A), which a valid hierarchy cannot have.
+    if (_pendings[index])
+      throw Error( "Checkpoint::_materialize(): \"%s\" is corrupted (cell %u is part of an instanciation loop)."
+                 , _path.c_str(), index );
+
+    vector<Cell*> masters;
+    _pendings[index] = true;
+    try {
+      for ( uint32_t i=0 ; i<record->_instanceCount ; ++i ) {
+        const InstanceRecord* instance = _get<InstanceRecord>( InstancesSection
+                                                             , _checkIndex(InstancesSection,record->_firstInstance+i) );
+        masters.push_back( _materialize( _checkIndex(CellsSection,instance->_master) ) );
+      }
+    } catch ( ... ) {
+      _pendings[index] = false;
+      throw;
+    }
+    _pendings[index] = false;
+
+    bool autoMaterialize = not Go::autoMaterializationIsDisabled();
+    Go::disableAutoMaterialization();
+    UpdateSession::open();
+
+    vector<Component*> components ( record->_componentCount, NULL );
+    try {
+      cell = Cell::create( library, name );
+      _cells   [index] = cell;
+      _rebuilts[index] = true;
+      cell->getFlags().set( record->_flags & SavedCellFlags );
+      if (record->_flags & Cell::Flags::RTreeIndex) cell->setRTreeIndex( true );
+      cell->setAbutmentBox( boxFromRecord(record->_abutmentBox) );
+
+      vector<Instance*> instances;
+      for ( uint32_t i=0 ; i<record->_instanceCount ; ++i ) {
+        const InstanceRecord* irecord = _get<InstanceRecord>( InstancesSection, record->_firstInstance+i );
+        if (   (irecord->_orientation     > Transformation::Orientation::YR)
+            or (irecord->_placementStatus > Instance::PlacementStatus::FIXED) )
+          throw Error( "Checkpoint::_materialize(): \"%s\" is corrupted (instance %u of %s)."
+                     , _path.c_str(), i, getString(name).c_str() );
+        instances.push_back( Instance::create
+                               ( cell
+                               , _getName(irecord->_name)
+                               , masters[i]
+                               , Transformation( irecord->_tx
+                                               , irecord->_ty
+                                               , Transformation::Orientation
+                                                   ((Transformation::Orientation::Code)irecord->_orientation) )
+                               , Instance::PlacementStatus
+                                   ((Instance::PlacementStatus::Code)irecord->_placementStatus)
+                               ) );
+      }
+
+      vector<Net*>  nets ( record->_componentCount, NULL );
+      for ( uint32_t i=0 ; i<record->_netCount ; ++i ) {
+        const NetRecord* nrecord = _get<NetRecord>( NetsSection, _checkIndex(NetsSection,record->_firstNet+i) );
+        Name             netName = _getName( nrecord->_name );
+        Net*             net     = NULL;
+
+        if (nrecord->_flags & DeepNetFlag) {
+          Cell* leaf      = NULL;
+          Path  path      = _getPath( cell, nrecord->_rootPathFirst, nrecord->_rootPathLength, leaf );
+          Net*  masterNet = leaf->getNet( _getName(nrecord->_rootNetName) );
+          if (masterNet) {
+            HyperNet hyperNet ( Occurrence(masterNet,path) );
+            net = DeepNet::create( hyperNet );
+          }
+        }
+        if (not net) net = Net::create( cell, netName );
+        net->setType     ( Net::Type     ((Net::Type     ::Code)nrecord->_type     ) );
+        net->setDirection( Net::Direction((Net::Direction::Code)nrecord->_direction) );
+        net->setGlobal   ( nrecord->_flags & GlobalNet    );
+        net->setExternal ( nrecord->_flags & ExternalNet  );
+        net->setAutomatic( nrecord->_flags & AutomaticNet );
+        for ( uint32_t j=0 ; j<nrecord->_aliasCount ; ++j ) {
+          const AliasRecord* arecord = _get<AliasRecord>( AliasesSection
+                                                        , _checkIndex(AliasesSection,nrecord->_firstAlias+j) );
+          net->addAlias( _getName(arecord->_name), arecord->_isExternal );
+        }
+
+        if ((uint64_t)nrecord->_firstComponent + nrecord->_componentCount > record->_componentCount)
+          throw Error( "Checkpoint::_materialize(): \"%s\" is corrupted (net %s)."
+                     , _path.c_str(), getString(netName).c_str() );
+        for ( uint32_t j=0 ; j<nrecord->_componentCount ; ++j )
+          nets[ nrecord->_firstComponent+j ] = net;
+      }
+
+    // RoutingPads are created last, as they may refer to the components
+    // of the Cell itself.
+      for ( size_t pass=0 ; pass<2 ; ++pass ) {
+        for ( uint32_t i=0 ; i<record->_componentCount ; ++i ) {
+          const ComponentRecord* crecord = _get<ComponentRecord>
+            ( ComponentsSection, _checkIndex(ComponentsSection,record->_firstComponent+i) );
+          if ((crecord->_kind == RoutingPadKind) xor (pass == 1)) continue;
+
+          Net*         net     = nets[i];
+          const Layer* layer   = NULL;
+          const auto*  values  = crecord->_values;
+          if (not net)
+            throw Error( "Checkpoint::_materialize(): \"%s\" is corrupted (component %u of %s)."
+                       , _path.c_str(), i, getString(name).c_str() );
+          if (crecord->_layer != NoIndex) layer = _layers[ _checkIndex(LayersSection,crecord->_layer) ];
+
+          switch ( crecord->_kind ) {
+            case ContactKind:
+              components[i] = Contact::create( net, layer, values[0], values[1], values[2], values[3] );
+              break;
+            case PinKind:
+              components[i] = Pin::create( net
+                                         , _getName( crecord->_extras[0] )
+                                         , Pin::AccessDirection( (Pin::AccessDirection::Code)(crecord->_extras[1] & 0xff) )
+                                         , Pin::PlacementStatus( (Pin::PlacementStatus::Code)(crecord->_extras[1] >> 8) )
+                                         , layer, values[0], values[1], values[2], values[3] );
+              break;
+            case HorizontalKind:
+              components[i] = Horizontal::create( net, layer, values[0], values[1], values[2], values[3] );
+              break;
+            case VerticalKind:
+              components[i] = Vertical::create( net, layer, values[0], values[1], values[2], values[3] );
+              break;
+            case PadKind:
+              components[i] = Pad::create( net, layer, boxFromRecord(values) );
+              break;
+            case DiagonalKind:
+              components[i] = Diagonal::create( net, layer
+                                              , Point(values[0],values[1])
+                                              , Point(values[2],values[3])
+                                              , values[4] );
+              break;
+            case RectilinearKind:
+            case PolygonKind: {
+              vector<Point> points;
+              for ( uint32_t j=0 ; j<crecord->_extras[1] ; ++j ) {
+                const PointRecord* point = _get<PointRecord>( PointsSection
+                                                            , _checkIndex(PointsSection,crecord->_extras[0]+j) );
+                points.push_back( Point(point->_x,point->_y) );
+              }
+              if (crecord->_kind == RectilinearKind)
+                components[i] = Rectilinear::create( net, layer, points );
+              else
+                components[i] = Polygon::create( net, layer, points );
+              break;
+            }
+            case RoutingPadKind: {
+              if (crecord->_extras[0] == NoIndex) break;
+              Occurrence occurrence = _getOccurrence( cell, crecord->_extras[0], components );
+              if (not occurrence.isValid()) {
+                cerr << Error( "Checkpoint::_materialize(): Cannot find back the occurrence of a RoutingPad\n"
+                               "        on %s in %s (\"%s\")."
+                             , getString(net->getName()).c_str()
+                             , getString(name).c_str()
+                             , _path.c_str() ) << endl;
+                break;
+              }
+              RoutingPad* rp = RoutingPad::create( net, occurrence );
+              if (crecord->_extras[1] & RoutingPad::UserCenter)
+                rp->setUserCenter( Point(values[0],values[1]) );
+              rp->setFlags( crecord->_extras[1] & ~RoutingPad::UserCenter );
+              components[i] = rp;
+              break;
+            }
+            case PlugKind: {
+              if (crecord->_extras[0] >= instances.size())
+                throw Error( "Checkpoint::_materialize(): \"%s\" is corrupted (plug %u of %s)."
+                           , _path.c_str(), i, getString(name).c_str() );
+              Instance* instance  = instances[ crecord->_extras[0] ];
+              Net*      masterNet = instance->getMasterCell()->getNet( _getName(crecord->_extras[1]) );
+              Plug*     plug      = (masterNet) ? instance->getPlug( masterNet ) : NULL;
+              if (not plug) {
+                cerr << Error( "Checkpoint::_materialize(): No plug of %s on %s (\"%s\")."
+                             , getString(instance).c_str()
+                             , getString(_getName(crecord->_extras[1])).c_str()
+                             , _path.c_str() ) << endl;
+                break;
+              }
+              plug->setNet( net );
+              components[i] = plug;
+              break;
+            }
+            default:
+              throw Error( "Checkpoint::_materialize(): \"%s\" is corrupted (unknown component kind %u)."
+                         , _path.c_str(), (uint32_t)crecord->_kind );
+          }
+          if (components[i] and (crecord->_flags & ExternalComponent))
+            NetExternalComponents::setExternal( components[i] );
+        }
+      }
+
+    // Rebuild the hook rings, as in JsonNet.
+      for ( uint32_t i=0 ; i<record->_componentCount ; ++i ) {
+        const ComponentRecord* crecord = _get<ComponentRecord>( ComponentsSection, record->_firstComponent+i );
+        for ( uint32_t slot=0 ; slot<3 ; ++slot ) {
+          uint32_t link = crecord->_hooks[slot];
+          if (link == NoIndex) continue;
+          if ((link >> 2) >= components.size()) {
+            cerr << Error( "Checkpoint::_materialize(): \"%s\" is corrupted (hook of component %u in %s)."
+                         , _path.c_str(), i, getString(name).c_str() ) << endl;
+            continue;
+          }
+
+          const ComponentRecord* nrecord = _get<ComponentRecord>( ComponentsSection
+                                                                , record->_firstComponent + (link >> 2) );
+          Hook* hook = getComponentHook( components[i], crecord->_kind, slot );
+          Hook* next = getComponentHook( components[link >> 2], nrecord->_kind, link & 0x3 );
+          if (hook and next) hook->_setNextHook( next );
+        }
+      }
+
+      for ( uint32_t i=0 ; i<record->_referenceCount ; ++i ) {
+        const ReferenceRecord* rrecord = _get<ReferenceRecord>
+          ( ReferencesSection, _checkIndex(ReferencesSection,record->_firstReference+i) );
+        Reference::create( cell
+                         , _getName( rrecord->_name )
+                         , rrecord->_x
+                         , rrecord->_y
+                         , (Reference::Type)rrecord->_type );
+      }
+    } catch ( ... ) {
+    // Do not leave a half built Cell behind, a later load would take it
+    // as already present in the Library.
+      if (_cells[index]) {
+        _cells[index]->destroy();
+        _cells   [index] = NULL;
+        _rebuilts[index] = false;
+      }
+      UpdateSession::close();
+      if (autoMaterialize) Go::enableAutoMaterialization();
+      throw;
+    }
+
+    UpdateSession::close();
+    if (autoMaterialize) {
+      Go::enableAutoMaterialization();
+      cell->materialize();
+    }
+
+    if (_masters[index]) _components[index].swap( components );
+    return cell;
+  }
+
+
+  string  Checkpoint::_getTypeName () const
+  { return "Checkpoint"; }
+
+
+  string  Checkpoint::_getString () const
+  {
+    string s = "<" + _getTypeName()
+             + " \"" + _path + "\" "
+             + getString(getMaterializeds()) + "/" + getString(getCellsSize()) + " cells>";
+    return s;
+  }
+
+
+}  // Hurricane namespace.
@@ -0,0 +1,347 @@
+// -*- C++ -*-
+//
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// This file is part of Hurricane.
+//
+// Hurricane is free software: you can redistribute it  and/or  modify
+// it under the terms of the GNU  Lesser  General  Public  License  as
+// published by the Free Software Foundation, either version 3 of  the
+// License, or (at your option) any later version.
+//
+// Hurricane is distributed in the hope that it will  be  useful,  but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHAN-
+// TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See  the  Lesser  GNU
+// General Public License for more details.
+//
+// You should have received a copy of the Lesser  GNU  General  Public
+// License along with Hurricane. If not, see
+//                                     <http://www.gnu.org/licenses/>.
+//
+// +-----------------------------------------------------------------+
+// |                  H U R R I C A N E                              |
+// |     V L S I   B a c k e n d   D a t a - B a s e                 |
+// |                                                                 |
+// |  Author      :                    Jean-Paul Chaput              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./CheckpointBench.cpp"                         |
+// +-----------------------------------------------------------------+
+//
+// Build a synthetic two levels design (a row of placed instances of a
+// leaf Cell, chained by routed nets with RoutingPads), then save it
+// both as a binary Checkpoint and as a JSON blob (the DataBase part of
+// a DesignBlob). Reload each of them in an empty DataBase, check that
+// the design is rebuilt identically and report save & load times.
+//
+// Usage:  checkpoint-bench [instances] [directory]
+
+
+#include <cstdlib>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+#include "hurricane/DataBase.h"
+#include "hurricane/Technology.h"
+#include "hurricane/BasicLayer.h"
+#include "hurricane/Library.h"
+#include "hurricane/Cell.h"
+#include "hurricane/Instance.h"
+#include "hurricane/Net.h"
+#include "hurricane/NetExternalComponents.h"
+#include "hurricane/Plug.h"
+#include "hurricane/Contact.h"
+#include "hurricane/Pin.h"
+#include "hurricane/Horizontal.h"
+#include "hurricane/Vertical.h"
+#include "hurricane/RoutingPad.h"
+#include "hurricane/Reference.h"
+#include "hurricane/UpdateSession.h"
+#include "hurricane/JsonWriter.h"
+#include "hurricane/JsonReader.h"
+#include "hurricane/Checkpoint.h"
+
+
+namespace {
+
+  using namespace std;
+  using namespace Hurricane;
+
+  typedef std::chrono::steady_clock  Clock;
+
+
+  double  elapsed ( Clock::time_point start )
+  { return std::chrono::duration<double>( Clock::now() - start ).count() * 1000.0; }
+
+
+  void  buildTechnology ()
+  {
+    DataBase*   db   = DataBase::create();
+    Technology* tech = Technology::create( db, "bench" );
+    BasicLayer::create( tech, "METAL1", BasicLayer::Material::metal );
+    BasicLayer::create( tech, "METAL2", BasicLayer::Material::metal );
+  }
+
+
+  Cell* buildLeaf ( Library* library )
+  {
+    Technology* tech   = DataBase::getDB()->getTechnology();
+    Layer*      metal1 = tech->getLayer( "METAL1" );
+    Layer*      metal2 = tech->getLayer( "METAL2" );
+    Cell*       leaf   = Cell::create( library, "leaf" );
+    leaf->setAbutmentBox( Box( 0, 0, DbU::fromLambda(20.0), DbU::fromLambda(50.0) ) );
+
+    const char* names[2] = { "i", "q" };
+    for ( size_t i=0 ; i<2 ; ++i ) {
+      Net* net = Net::create( leaf, names[i] );
+      net->setExternal ( true );
+      net->setDirection( (i) ? Net::Direction::OUT : Net::Direction::IN );
+      DbU::Unit x = DbU::fromLambda( 5.0 + 10.0*i );
+
+      Contact*  bottom = Contact::create( net, metal1, x, DbU::fromLambda(10.0), DbU::fromLambda(2.0), DbU::fromLambda(2.0) );
+      Contact*  top    = Contact::create( net, metal1, x, DbU::fromLambda(40.0), DbU::fromLambda(2.0), DbU::fromLambda(2.0) );
+      Vertical* wire   = Vertical::create( bottom, top, metal1, x, DbU::fromLambda(2.0) );
+      NetExternalComponents::setExternal( wire );
+      Pin::create( net
+                 , string(names[i]) + ".0"
+                 , Pin::AccessDirection::NORTH
+                 , Pin::PlacementStatus::FIXED
+                 , metal2
+                 , x
+                 , DbU::fromLambda(50.0)
+                 , DbU::fromLambda(2.0)
+                 , DbU::fromLambda(2.0) );
+    }
+
+    Net* vdd = Net::create( leaf, "vdd" );
+    vdd->setExternal( true );
+    vdd->setGlobal  ( true );
+    vdd->setType    ( Net::Type::POWER );
+    vdd->addAlias   ( "vdd!", true );
+    Horizontal* rail = Horizontal::create( vdd, metal1, DbU::fromLambda(48.0), DbU::fromLambda(4.0)
+                                         , 0, DbU::fromLambda(20.0) );
+    NetExternalComponents::setExternal( rail );
+
+    leaf->setTerminalNetlist( true );
+    return leaf;
+  }
+
+
+  Cell* buildDesign ( size_t instanceCount )
+  {
+    buildTechnology();
+
+    DataBase* db      = DataBase::getDB();
+    Library*  root    = Library::create( db, "root" );
+    Library*  library = Library::create( root, "bench" );
+    Layer*    metal2  = db->getTechnology()->getLayer( "METAL2" );
+
+    UpdateSession::open();
+    Cell* leaf = buildLeaf( library );
+    Cell* top  = Cell::create( library, "top" );
+    top->setAbutmentBox( Box( 0, 0, DbU::fromLambda(20.0*instanceCount), DbU::fromLambda(50.0) ) );
+
+    vector<Instance*> instances;
+    for ( size_t i=0 ; i<instanceCount ; ++i ) {
+      instances.push_back( Instance::create
+                             ( top
+                             , "leaf_" + getString(i)
+                             , leaf
+                             , Transformation( DbU::fromLambda(20.0*i)
+                                             , 0
+                                             , (i % 2) ? Transformation::Orientation::MX
+                                                       : Transformation::Orientation::ID )
+                             , Instance::PlacementStatus::PLACED ) );
+    }
+
+    Net* vdd = Net::create( top, "vdd" );
+    vdd->setExternal( true );
+    vdd->setGlobal  ( true );
+    vdd->setType    ( Net::Type::POWER );
+    for ( Instance* instance : instances )
+      instance->getPlug( leaf->getNet("vdd") )->setNet( vdd );
+
+    Component* wire = NULL;
+    for ( Component* component : leaf->getNet("i")->getComponents() ) {
+      if (dynamic_cast<Vertical*>(component)) wire = component;
+    }
+
+    for ( size_t i=0 ; i+1<instanceCount ; ++i ) {
+      Net* net = Net::create( top, "n_" + getString(i) );
+      Plug* source = instances[i  ]->getPlug( leaf->getNet("q") );
+      Plug* target = instances[i+1]->getPlug( leaf->getNet("i") );
+      source->setNet( net );
+      target->setNet( net );
+
+      RoutingPad* rpSource = RoutingPad::create( net, Occurrence(source) );
+    // The target side is connected on the leaf wire itself.
+      RoutingPad* rpTarget = RoutingPad::create( net, Occurrence(wire,Path(instances[i+1])) );
+      DbU::Unit   y        = DbU::fromLambda( 25.0 + (i % 5) );
+      Contact*    left     = Contact::create( rpSource, metal2, 0, 0 );
+      Contact*    right    = Contact::create( rpTarget, metal2, 0, 0 );
+      Horizontal::create( left, right, metal2, y, DbU::fromLambda(2.0) );
+    }
+    top->updatePlacedFlag();
+    Reference::create( top, "origin", 0, 0, Reference::Type::Position );
+    UpdateSession::close();
+
+    return top;
+  }
+
+
+// Dump the design below topCell as a sorted list of lines, which do
+// not depend on the object ids, so two designs can be compared.
+
+  void  signature ( Cell* cell, vector<string>& lines )
+  {
+    string prefix = getString(cell->getName()) + ":";
+    lines.push_back( prefix + " flags=" + getString(cell->getFlags().value() & ~(uint64_t)Cell::Flags::Materialized)
+                   + " ab=" + getString(cell->getAbutmentBox()) );
+
+    for ( Instance* instance : cell->getInstances() ) {
+      lines.push_back( prefix + " instance " + getString(instance->getName())
+                     + " " + getString(instance->getMasterCell()->getName())
+                     + " " + getString(instance->getTransformation())
+                     + " " + getString(instance->getPlacementStatus().getCode()) );
+      for ( Plug* plug : instance->getConnectedPlugs() )
+        lines.push_back( prefix + " plug " + getString(instance->getName())
+                       + "." + getString(plug->getMasterNet()->getName())
+                       + " -> " + getString(plug->getNet()->getName()) );
+    }
+
+    for ( Net* net : cell->getNets() ) {
+      string netPrefix = prefix + " net " + getString(net->getName());
+      lines.push_back( netPrefix
+                     + " " + getString(net->getType())
+                     + " " + getString(net->getDirection())
+                     + " global="   + getString(net->isGlobal())
+                     + " external=" + getString(net->isExternal()) );
+      for ( NetAliasHook* alias : net->getAliases() )
+        lines.push_back( netPrefix + " alias " + getString(alias->getName()) );
+
+      for ( Component* component : net->getComponents() ) {
+        if (dynamic_cast<Plug*>(component)) continue;
+        string line = netPrefix + " " + component->_getTypeName()
+                    + " " + ((component->getLayer()) ? getString(component->getLayer()->getName()) : "-")
+                    + " " + getString(component->getBoundingBox())
+                    + " external=" + getString(NetExternalComponents::isExternal(component));
+        Segment* segment = dynamic_cast<Segment*>( component );
+        if (segment) {
+          line += " source=" + ((segment->getSource()) ? getString(segment->getSource()->getPosition()) : "-");
+          line += " target=" + ((segment->getTarget()) ? getString(segment->getTarget()->getPosition()) : "-");
+        }
+        Contact* contact = dynamic_cast<Contact*>( component );
+        if (contact and contact->getAnchor())
+          line += " anchor=" + getString(contact->getAnchor()->getPosition());
+        RoutingPad* rp = dynamic_cast<RoutingPad*>( component );
+        if (rp)
+          line += " occurrence=" + rp->getOccurrence().getPath().getName()
+                + ":" + getString(rp->getOccurrence().getEntity()->getBoundingBox());
+        lines.push_back( line );
+      }
+    }
+
+    for ( Reference* reference : cell->getReferences() )
+      lines.push_back( prefix + " reference " + getString(reference->getName())
+                     + " " + getString(reference->getPoint()) );
+  }
+
+
+  vector<string>  signature ( Cell* topCell )
+  {
+    vector<string> lines;
+    if (not topCell) return lines;
+
+    signature( topCell, lines );
+    vector<Cell*> masters;
+    for ( Instance* instance : topCell->getInstances() ) {
+      if (find(masters.begin(),masters.end(),instance->getMasterCell()) == masters.end())
+        masters.push_back( instance->getMasterCell() );
+    }
+    for ( Cell* master : masters ) signature( master, lines );
+    sort( lines.begin(), lines.end() );
+    return lines;
+  }
+
+
+  bool  compare ( const char* name, const vector<string>& reference, const vector<string>& loaded )
+  {
+    if (reference == loaded) {
+      cout << "  o  " << name << ": identical (" << loaded.size() << " lines)." << endl;
+      return true;
+    }
+
+    cerr << "[ERROR] " << name << ": rebuilt design differs from the original one." << endl;
+    size_t shown = 0;
+    for ( size_t i=0 ; (i < max(reference.size(),loaded.size())) and (shown < 10) ; ++i ) {
+      string lhs = (i < reference.size()) ? reference[i] : "<none>";
+      string rhs = (i < loaded   .size()) ? loaded   [i] : "<none>";
+      if (lhs == rhs) continue;
+      cerr << "      - " << lhs << "\n      + " << rhs << endl;
+      ++shown;
+    }
+    return false;
+  }
+
+
+}  // Anonymous namespace.
+
+
+int  main ( int argc, char* argv[] )
+{
+  size_t instanceCount = (argc > 1) ? strtoul( argv[1], NULL, 10 ) : 20000;
+  string directory     = (argc > 2) ? argv[2] : ".";
+  string checkpointPath = directory + "/bench.ckpt";
+  string blobPath       = directory + "/bench.blob.json";
+  int    status         = 0;
+
+  if (instanceCount < 2) instanceCount = 2;
+
+  try {
+    cout << "Building a design of " << instanceCount << " instances." << endl;
+    Cell*          topCell   = buildDesign( instanceCount );
+    vector<string> reference = signature( topCell );
+
+    cout << "Saving." << endl;
+    Clock::time_point start = Clock::now();
+    Checkpoint::save( checkpointPath, topCell );
+    cout << "  o  Checkpoint: " << elapsed(start) << " ms." << endl;
+
+    start = Clock::now();
+    {
+      JsonWriter writer ( blobPath );
+      writer.setFlags( JsonWriter::DesignBlobMode );
+      jsonWrite( &writer, DataBase::getDB() );
+    }
+    cout << "  o  JSON blob:  " << elapsed(start) << " ms." << endl;
+
+    cout << "Loading." << endl;
+    DataBase::getDB()->destroy();
+    buildTechnology();
+    start = Clock::now();
+    Cell* loaded = Checkpoint::load( checkpointPath );
+    cout << "  o  Checkpoint (top cell): " << elapsed(start) << " ms." << endl;
+    if (not compare( "Checkpoint", reference, signature(loaded) )) status = 1;
+    Checkpoint::close();
+
+    DataBase::getDB()->destroy();
+    DataBase::create();
+    start = Clock::now();
+    UpdateSession::open();
+    {
+      JsonReader reader ( JsonWriter::DesignBlobMode );
+      reader.parse( blobPath );
+    }
+    UpdateSession::close();
+    cout << "  o  JSON blob:             " << elapsed(start) << " ms." << endl;
+    loaded = NULL;
+    Library* root = DataBase::getDB()->getRootLibrary();
+    if (root and root->getLibrary("bench")) loaded = root->getLibrary("bench")->getCell( "top" );
+    if (not compare( "JSON blob ", reference, signature(loaded) )) status = 1;
+  } catch ( Error& e ) {
+    cerr << e.what() << endl;
+    status = 1;
+  }
+
+  return status;
+}
@@ -0,0 +1,174 @@
+// -*- C++ -*-
+//
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// This file is part of Hurricane.
+//
+// Hurricane is free software: you can redistribute it  and/or  modify
+// it under the terms of the GNU  Lesser  General  Public  License  as
+// published by the Free Software Foundation, either version 3 of  the
+// License, or (at your option) any later version.
+//
+// Hurricane is distributed in the hope that it will  be  useful,  but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHAN-
+// TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See  the  Lesser  GNU
+// General Public License for more details.
+//
+// You should have received a copy of the Lesser  GNU  General  Public
+// License along with Hurricane. If not, see
+//                                     <http://www.gnu.org/licenses/>.
+//
+// +-----------------------------------------------------------------+
+// |                  H U R R I C A N E                              |
+// |     V L S I   B a c k e n d   D a t a - B a s e                 |
+// |                                                                 |
+// |  Author      :                    Jean-Paul Chaput              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./CollectionBench.cpp"                         |
+// +-----------------------------------------------------------------+
+//
+// Build a large synthetic Cell, then walk the components & routing
+// pads of all it's nets, once through the Collection/Locator API and
+// once through the Ranges. Check that both visit the same elements and
+// report their run times.
+//
+// Usage:  collection-bench [nets] [components/net] [repeat]
+
+
+#include <cstdlib>
+#include <chrono>
+#include <iostream>
+#include "hurricane/DataBase.h"
+#include "hurricane/Technology.h"
+#include "hurricane/BasicLayer.h"
+#include "hurricane/Library.h"
+#include "hurricane/Cell.h"
+#include "hurricane/Net.h"
+#include "hurricane/Contact.h"
+#include "hurricane/RoutingPad.h"
+#include "hurricane/UpdateSession.h"
+
+
+namespace {
+
+  using namespace std;
+  using namespace Hurricane;
+
+
+  Cell* buildCell ( size_t netCount, size_t componentCount )
+  {
+    DataBase*   db      = DataBase::create();
+    Technology* tech    = Technology::create( db, "bench" );
+    BasicLayer* metal1  = BasicLayer::create( tech, "METAL1", BasicLayer::Material::metal );
+    Library*    library = Library::create( db, "bench" );
+    Cell*       cell    = Cell::create( library, "bench" );
+
+    UpdateSession::open();
+    for ( size_t inet=0 ; inet<netCount ; ++inet ) {
+      Net* net = Net::create( cell, "net_" + getString(inet) );
+      for ( size_t icomp=0 ; icomp<componentCount ; ++icomp ) {
+        Contact* contact = Contact::create( net
+                                          , metal1
+                                          , DbU::fromLambda( (double)icomp )
+                                          , DbU::fromLambda( (double)inet )
+                                          , DbU::fromLambda( 1.0 )
+                                          , DbU::fromLambda( 1.0 ) );
+      // One contact out of four gets a RoutingPad.
+        if (icomp % 4 == 0) RoutingPad::create( net, Occurrence(contact) );
+      }
+    }
+    UpdateSession::close();
+    return cell;
+  }
+
+
+  template< typename Walk >
+  void  bench ( const char* name, Walk walk, const Cell* cell, size_t repeat, size_t& checksum )
+  {
+    typedef std::chrono::steady_clock  Clock;
+
+    checksum = 0;
+    Clock::time_point start = Clock::now();
+    for ( size_t i=0 ; i<repeat ; ++i ) checksum += walk( cell );
+    double seconds = std::chrono::duration<double>( Clock::now() - start ).count();
+
+    cout << "  o  " << name << ": " << (seconds*1000.0/repeat) << " ms/walk" << endl;
+  }
+
+
+  size_t  componentsByCollection ( const Cell* cell )
+  {
+    size_t count = 0;
+    for ( Net* net : cell->getNets() ) {
+      for ( Component* component : net->getComponents() ) count += (size_t)component & 0xff;
+    }
+    return count;
+  }
+
+
+  size_t  componentsByRange ( const Cell* cell )
+  {
+    size_t count = 0;
+    for ( Net* net : cell->getNetRange() ) {
+      for ( Component* component : net->getComponentRange() ) count += (size_t)component & 0xff;
+    }
+    return count;
+  }
+
+
+  size_t  routingPadsByCollection ( const Cell* cell )
+  {
+    size_t count = 0;
+    for ( Net* net : cell->getNets() ) {
+      for ( RoutingPad* rp : net->getRoutingPads() ) count += (size_t)rp & 0xff;
+    }
+    return count;
+  }
+
+
+  size_t  routingPadsByRange ( const Cell* cell )
+  {
+    size_t count = 0;
+    for ( Net* net : cell->getNetRange() ) {
+      for ( RoutingPad* rp : net->getRoutingPadRange() ) count += (size_t)rp & 0xff;
+    }
+    return count;
+  }
+
+
+}  // Anonymous namespace.
+
+
+int  main ( int argc, char* argv[] )
+{
+  size_t netCount       = (argc > 1) ? strtoul( argv[1], NULL, 10 ) : 20000;
+  size_t componentCount = (argc > 2) ? strtoul( argv[2], NULL, 10 ) : 40;
+  size_t repeat         = (argc > 3) ? strtoul( argv[3], NULL, 10 ) : 10;
+  if (not repeat) repeat = 1;
+
+  cout << "Building a Cell of " << netCount << " nets of " << componentCount << " contacts." << endl;
+  Cell* cell = buildCell( netCount, componentCount );
+
+  size_t collectionSum = 0;
+  size_t rangeSum      = 0;
+  int    status        = 0;
+
+  cout << "Net::getComponents(), " << repeat << " walks." << endl;
+  bench( "Collection", componentsByCollection, cell, repeat, collectionSum );
+  bench( "Range     ", componentsByRange     , cell, repeat, rangeSum );
+  if (collectionSum != rangeSum) {
+    cerr << "[ERROR] Components walks differ." << endl;
+    status = 1;
+  }
+
+  cout << "Net::getRoutingPads(), " << repeat << " walks." << endl;
+  bench( "Collection", routingPadsByCollection, cell, repeat, collectionSum );
+  bench( "Range     ", routingPadsByRange     , cell, repeat, rangeSum );
+  if (collectionSum != rangeSum) {
+    cerr << "[ERROR] RoutingPads walks differ." << endl;
+    status = 1;
+  }
+
+  return status;
+}
@@ -37,6 +37,7 @@
 #include "hurricane/Quark.h"
 #include "hurricane/Error.h"
 #include "hurricane/Warning.h"
+#include "hurricane/ParallelQuery.h"
 
 #include <limits>
 
@@ -170,6 +171,7 @@ namespace Hurricane {
   void  DBo::_postCreate ()
   {
     cdebug_log(0,0) << "DBo::_postCreate() " << this << endl;
+    ParallelQuery::checkReadOnly( "DBo::_postCreate()" );
   }
 
 
@@ -181,6 +183,7 @@ namespace Hurricane {
 
   void DBo::destroy ()
   {
+    ParallelQuery::checkReadOnly( "DBo::destroy()" );
     cdebug_log(0,1) << "DBo::destroy() " << getId() << " " << this << endl;
     _preDestroy();
     cdebug_tabw(0,-1);
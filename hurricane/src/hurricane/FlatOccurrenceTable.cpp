@@ -0,0 +1,139 @@
+// -*- C++ -*-
+//
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// This file is part of Hurricane.
+//
+// Hurricane is free software: you can redistribute it  and/or  modify
+// it under the terms of the GNU  Lesser  General  Public  License  as
+// published by the Free Software Foundation, either version 3 of  the
+// License, or (at your option) any later version.
+//
+// Hurricane is distributed in the hope that it will  be  useful,  but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHAN-
+// TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See  the  Lesser  GNU
+// General Public License for more details.
+//
+// You should have received a copy of the Lesser  GNU  General  Public
+// License along with Hurricane. If not, see
+//                                     <http://www.gnu.org/licenses/>.
+//
+// +-----------------------------------------------------------------+
+// |                  H U R R I C A N E                              |
+// |     V L S I   B a c k e n d   D a t a - B a s e                 |
+// |                                                                 |
+// |  Author      :                    Jean-Paul Chaput              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./FlatOccurrenceTable.cpp"                     |
+// +-----------------------------------------------------------------+
+
+
+#include "hurricane/FlatOccurrenceTable.h"
+#include "hurricane/Instance.h"
+#include "hurricane/Cell.h"
+
+
+namespace Hurricane {
+
+  using std::string;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Hurricane::FlatOccurrenceTable::Entry".
+
+  Occurrence  FlatOccurrenceTable::Entry::getOccurrence () const
+  { return Occurrence( _instance, Path(_sharedPath) ); }
+
+
+// -------------------------------------------------------------------
+// Class  :  "Hurricane::FlatOccurrenceTable".
+
+  FlatOccurrenceTable::FlatOccurrenceTable ( const Cell* cell )
+    : _cell        (cell)
+    , _entries     ()
+    , _terminalsEnd(0)
+    , _spans       ()
+  { _build(); }
+
+
+  void  FlatOccurrenceTable::_build ()
+  {
+  // Must follow exactly the walk of Cell_TerminalNetlistInstanceOccurrences:
+  // first the terminal netlist instances of the Cell, then, for each non
+  // terminal one, all the occurrences of it's master (recursively).
+    for ( Instance* instance : _cell->getTerminalNetlistInstances() ) {
+      instance->getMasterCell()->_setFlatOccurrencesCleared();
+      _entries.push_back( Entry( instance
+                               , NULL
+                               , instance->getTransformation()
+                               , instance->getAbutmentBox() ) );
+    }
+    _terminalsEnd = _entries.size();
+    _cell->_setFlatOccurrencesCleared();
+
+    for ( Instance* instance : _cell->getNonTerminalNetlistInstances() ) {
+      size_t begin = _entries.size();
+      _expand( Path(instance), instance->getTransformation(), instance->getMasterCell() );
+      _spans.insert( std::make_pair( instance, Span(begin,_entries.size()) ) );
+    }
+  }
+
+
+  void  FlatOccurrenceTable::_expand ( const Path& path, const Transformation& transformation, const Cell* master )
+  {
+    master->_setFlatOccurrencesCleared();
+
+    for ( Instance* instance : master->getTerminalNetlistInstances() ) {
+      instance->getMasterCell()->_setFlatOccurrencesCleared();
+
+      Transformation instanceTransf = instance->getTransformation();
+      transformation.applyOn( instanceTransf );
+      _entries.push_back( Entry( instance
+                               , path._getSharedPath()
+                               , instanceTransf
+                               , transformation.getBox(instance->getAbutmentBox()) ) );
+    }
+
+    for ( Instance* instance : master->getNonTerminalNetlistInstances() ) {
+      Transformation instanceTransf = instance->getTransformation();
+      transformation.applyOn( instanceTransf );
+      _expand( Path(path,instance), instanceTransf, instance->getMasterCell() );
+    }
+  }
+
+
+  FlatOccurrenceTable::Range  FlatOccurrenceTable::getRange ( const Instance* topInstance ) const
+  {
+    if (not topInstance) return Range( _entries.begin(), _entries.end() );
+
+    auto ispan = _spans.find( topInstance );
+    if (ispan == _spans.end()) return Range( _entries.end(), _entries.end() );
+    return Range( _entries.begin() + ispan->second.first
+                , _entries.begin() + ispan->second.second );
+  }
+
+
+  string  FlatOccurrenceTable::_getTypeName () const
+  { return "FlatOccurrenceTable"; }
+
+
+  string  FlatOccurrenceTable::_getString () const
+  {
+    string s = "<" + _getTypeName()
+             + " " + getString(_cell->getName())
+             + " " + getString(_entries.size()) + ">";
+    return s;
+  }
+
+
+  Record* FlatOccurrenceTable::_getRecord () const
+  {
+    Record* record = new Record ( _getString() );
+    record->add( getSlot("_cell"        , _cell        ) );
+    record->add( getSlot("_terminalsEnd", _terminalsEnd) );
+    return record;
+  }
+
+
+}  // Hurricane namespace.
@@ -393,6 +393,7 @@ void Instance::invalidate(bool propagateFlag)
 // ******************************************
 {
     Inherit::invalidate(false);
+    _cell->_invalidateFlatOccurrenceTable();
 
     if (propagateFlag) {
         for_each_plug(plug, getConnectedPlugs()) {
@@ -427,6 +428,7 @@ void Instance::setName(const Name& name)
         _cell->_getInstanceMap()._remove(this);
         _name = name;
         _cell->_getInstanceMap()._insert(this);
+        _cell->_invalidateFlatOccurrenceTable();
     }
 }
 
@@ -599,6 +601,7 @@ void Instance::_postCreate()
 {
     _cell->_getInstanceMap()._insert(this);
     _masterCell->_getSlaveInstanceSet()._insert(this);
+    _cell->_invalidateFlatOccurrenceTable();
 
     for_each_net(externalNet, _masterCell->getExternalNets()) {
         Plug::_create(this, externalNet);
@@ -628,6 +631,7 @@ void Instance::_preDestroy()
 
   _masterCell->_getSlaveInstanceSet()._remove(this);
   _cell->_getInstanceMap()._remove(this);
+  _cell->_invalidateFlatOccurrenceTable();
 
   if (_masterCell->isUniquified()) _masterCell->destroy();
 }
@@ -34,64 +34,32 @@ namespace Hurricane {
 
 Name::Name()
 // *********
-:  _sharedName(NULL)
-{
-    string s = "";
-    if (!SharedName::_SHARED_NAME_MAP)
-        _sharedName = new SharedName(s);
-    else {
-        SharedName::SharedNameMap::iterator iterator =
-            SharedName::_SHARED_NAME_MAP->find(&(string&)s);
-        if (iterator != SharedName::_SHARED_NAME_MAP->end())
-            _sharedName = (*iterator).second;
-        else
-            _sharedName = new SharedName(s);
-    }
-
-    assert(_sharedName);
-
-    _sharedName->capture();
+:  _sharedName(SharedName::intern(std::string_view()))
+{
 }
 
 Name::Name(const char* c)
 // **********************
-:  _sharedName(NULL)
-{
-    string s = c;
-    if (!SharedName::_SHARED_NAME_MAP)
-        _sharedName = new SharedName(s);
-    else {
-        SharedName::SharedNameMap::iterator iterator =
-            SharedName::_SHARED_NAME_MAP->find(&(string&)s);
-        if (iterator != SharedName::_SHARED_NAME_MAP->end())
-            _sharedName = (*iterator).second;
-        else
-            _sharedName = new SharedName(s);
-    }
-
-    assert(_sharedName);
-
-    _sharedName->capture();
+:  _sharedName(SharedName::intern(c))
+{
 }
 
 Name::Name(const string& s)
 // ************************
-:  _sharedName(NULL)
-{
-    if (!SharedName::_SHARED_NAME_MAP)
-        _sharedName = new SharedName(s);
-    else {
-        SharedName::SharedNameMap::iterator iterator =
-            SharedName::_SHARED_NAME_MAP->find(&(string&)s);
-        if (iterator != SharedName::_SHARED_NAME_MAP->end())
-            _sharedName = (*iterator).second;
-        else
-            _sharedName = new SharedName(s);
-    }
+:  _sharedName(SharedName::intern(s))
+{
+}
 
-    assert(_sharedName);
+Name::Name(std::string_view s)
+// ***************************
+:  _sharedName(SharedName::intern(s))
+{
+}
 
-    _sharedName->capture();
+void Name::reserve(size_t count)
+// *****************************
+{
+    SharedName::reserve(count);
 }
 
 Name::Name(const Name& name)
@@ -0,0 +1,402 @@
+// -*- C++ -*-
+//
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// This file is part of Hurricane.
+//
+// Hurricane is free software: you can redistribute it  and/or  modify
+// it under the terms of the GNU  Lesser  General  Public  License  as
+// published by the Free Software Foundation, either version 3 of  the
+// License, or (at your option) any later version.
+//
+// Hurricane is distributed in the hope that it will  be  useful,  but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHAN-
+// TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See  the  Lesser  GNU
+// General Public License for more details.
+//
+// You should have received a copy of the Lesser  GNU  General  Public
+// License along with Hurricane. If not, see
+//                                     <http://www.gnu.org/licenses/>.
+//
+// +-----------------------------------------------------------------+
+// |                  H U R R I C A N E                              |
+// |     V L S I   B a c k e n d   D a t a - B a s e                 |
+// |                                                                 |
+// |  Author      :                    Jean-Paul Chaput              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./PackedRTree.cpp"                             |
+// +-----------------------------------------------------------------+
+
+
+#include <algorithm>
+#include "hurricane/PackedRTree.h"
+#include "hurricane/Go.h"
+#include "hurricane/Error.h"
+
+
+namespace {
+
+  using namespace std;
+
+
+// Index along a Hilbert curve of order 16 of the point (x,y), both
+// coordinates being in [0:65535].
+  uint64_t  hilbertIndex ( uint32_t x, uint32_t y )
+  {
+    const uint32_t side  = 1 << 16;
+    uint64_t       index = 0;
+
+    for ( uint32_t s=side/2 ; s>0 ; s/=2 ) {
+      uint32_t rx = (x & s) ? 1 : 0;
+      uint32_t ry = (y & s) ? 1 : 0;
+      index += (uint64_t)s * (uint64_t)s * ((3*rx) ^ ry);
+      if (ry == 0) {
+        if (rx == 1) {
+          x = side-1 - x;
+          y = side-1 - y;
+        }
+        std::swap( x, y );
+      }
+    }
+    return index;
+  }
+
+
+}  // Anonymous namespace.
+
+
+namespace Hurricane {
+
+  using std::string;
+  using std::vector;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Hurricane::PackedRTree_GosUnder".
+
+  class PackedRTree_GosUnder : public Collection<Go*> {
+    public:
+      typedef Collection<Go*> Inherit;
+    public:
+      class Locator : public Hurricane::Locator<Go*> {
+        public:
+          typedef Hurricane::Locator<Go*> Inherit;
+        public:
+                                             Locator     ( const PackedRTree*, const Box& area, DbU::Unit threshold );
+                                             Locator     ( const Locator& );
+          virtual Go*                        getElement  () const;
+          virtual Hurricane::Locator<Go*>*   getClone    () const;
+          virtual bool                       isValid     () const;
+          virtual void                       progress    ();
+          virtual string                     _getString  () const;
+        private:
+          inline  bool                       _accept     ( const Box& ) const;
+        private:
+          const PackedRTree*  _rtree;
+          Box                 _area;
+          DbU::Unit           _threshold;
+          vector<uint32_t>    _stack;
+          size_t              _itemIndex;
+          size_t              _itemEnd;
+          size_t              _bufferIndex;
+          Go*                 _element;
+      };
+    public:
+                                         PackedRTree_GosUnder ( const PackedRTree*, const Box& area, DbU::Unit threshold );
+                                         PackedRTree_GosUnder ( const PackedRTree_GosUnder& );
+      virtual Collection<Go*>*           getClone             () const;
+      virtual Hurricane::Locator<Go*>*   getLocator           () const;
+      virtual string                     _getString           () const;
+    private:
+      const PackedRTree*  _rtree;
+      Box                 _area;
+      DbU::Unit           _threshold;
+  };
+
+
+  PackedRTree_GosUnder::PackedRTree_GosUnder ( const PackedRTree* rtree, const Box& area, DbU::Unit threshold )
+    : Inherit()
+    , _rtree    (rtree)
+    , _area     (area)
+    , _threshold(threshold)
+  { }
+
+
+  PackedRTree_GosUnder::PackedRTree_GosUnder ( const PackedRTree_GosUnder& other )
+    : Inherit()
+    , _rtree    (other._rtree)
+    , _area     (other._area)
+    , _threshold(other._threshold)
+  { }
+
+
+  Collection<Go*>* PackedRTree_GosUnder::getClone () const
+  { return new PackedRTree_GosUnder(*this); }
+
+
+  Locator<Go*>* PackedRTree_GosUnder::getLocator () const
+  { return new Locator( _rtree, _area, _threshold ); }
+
+
+  string  PackedRTree_GosUnder::_getString () const
+  {
+    string s = "<" + _TName("PackedRTree::GosUnder")
+             + " " + getString(_area)
+             + " " + DbU::getValueString(_threshold) + ">";
+    return s;
+  }
+
+
+  PackedRTree_GosUnder::Locator::Locator ( const PackedRTree* rtree, const Box& area, DbU::Unit threshold )
+    : Inherit()
+    , _rtree      (rtree)
+    , _area       (area)
+    , _threshold  (threshold)
+    , _stack      ()
+    , _itemIndex  (0)
+    , _itemEnd    (0)
+    , _bufferIndex(0)
+    , _element    (NULL)
+  {
+    if (not _rtree->_nodes.empty()) _stack.push_back( _rtree->_nodes.size()-1 );
+    progress();
+  }
+
+
+  PackedRTree_GosUnder::Locator::Locator ( const Locator& other )
+    : Inherit()
+    , _rtree      (other._rtree)
+    , _area       (other._area)
+    , _threshold  (other._threshold)
+    , _stack      (other._stack)
+    , _itemIndex  (other._itemIndex)
+    , _itemEnd    (other._itemEnd)
+    , _bufferIndex(other._bufferIndex)
+    , _element    (other._element)
+  { }
+
+
+  Go* PackedRTree_GosUnder::Locator::getElement () const
+  { return _element; }
+
+
+  Locator<Go*>* PackedRTree_GosUnder::Locator::getClone () const
+  { return new Locator(*this); }
+
+
+  bool  PackedRTree_GosUnder::Locator::isValid () const
+  { return _element != NULL; }
+
+
+// Same selection as the QuadTree: the box must intersect the area and
+// not be smaller than the threshold in both directions. As a node box
+// encloses all it's descendants, the test also prunes the nodes.
+  inline bool  PackedRTree_GosUnder::Locator::_accept ( const Box& box ) const
+  {
+    if (not box.intersect(_area)) return false;
+    return (_threshold <= 0) or (box.getWidth() >= _threshold) or (box.getHeight() >= _threshold);
+  }
+
+
+  void  PackedRTree_GosUnder::Locator::progress ()
+  {
+    while ( true ) {
+      if (_itemIndex < _itemEnd) {
+        const PackedRTree::Item& item = _rtree->_items[ _itemIndex++ ];
+        if (not _accept(item._box)) continue;
+        if (not _rtree->_removeds.empty() and _rtree->_removeds.count(item._go)) continue;
+        _element = item._go;
+        return;
+      }
+
+      if (not _stack.empty()) {
+        uint32_t                 inode = _stack.back();
+        const PackedRTree::Node& node  = _rtree->_nodes[ inode ];
+        _stack.pop_back();
+        if (not _accept(node._box)) continue;
+
+        if (inode < _rtree->_leafCount) {
+          _itemIndex = node._first;
+          _itemEnd   = node._first + node._count;
+        } else {
+          for ( uint32_t ichild=node._first+node._count ; ichild > node._first ; --ichild )
+            _stack.push_back( ichild-1 );
+        }
+        continue;
+      }
+
+      if (_bufferIndex < _rtree->_inserteds.size()) {
+        const PackedRTree::Item& item = _rtree->_inserteds[ _bufferIndex++ ];
+        if (not _accept(item._box)) continue;
+        _element = item._go;
+        return;
+      }
+
+      _element = NULL;
+      return;
+    }
+  }
+
+
+  string  PackedRTree_GosUnder::Locator::_getString () const
+  {
+    string s = "<" + _TName("PackedRTree::GosUnder::Locator")
+             + " " + getString(_element) + ">";
+    return s;
+  }
+
+
+// -------------------------------------------------------------------
+// Class  :  "Hurricane::PackedRTree".
+
+
+  PackedRTree::PackedRTree ()
+    : _items          ()
+    , _nodes          ()
+    , _leafCount      (0)
+    , _removeds       ()
+    , _inserteds      ()
+    , _insertedIndexes()
+  { }
+
+
+  Gos  PackedRTree::getGosUnder ( const Box& area, DbU::Unit threshold ) const
+  { return PackedRTree_GosUnder( this, area, threshold ); }
+
+
+  void  PackedRTree::build ( const vector<Go*>& gos )
+  {
+    vector<Item> items;
+    items.reserve( gos.size() );
+    for ( Go* go : gos ) items.push_back( Item{ go->getBoundingBox(), go } );
+    _pack( items );
+  }
+
+
+  void  PackedRTree::insert ( Go* go, const Box& boundingBox )
+  {
+  // A Go removed then re-inserted keeps it's packed entry marked as
+  // dead (it's box may be stale), the live one is in the buffer.
+    if (_insertedIndexes.count(go)) return;
+    _insertedIndexes.insert( std::make_pair(go,_inserteds.size()) );
+    _inserteds.push_back( Item{ boundingBox, go } );
+  }
+
+
+  void  PackedRTree::remove ( Go* go )
+  {
+    auto iindex = _insertedIndexes.find( go );
+    if (iindex != _insertedIndexes.end()) {
+      size_t index = iindex->second;
+      _insertedIndexes.erase( iindex );
+      if (index+1 != _inserteds.size()) {
+        _inserteds[index] = _inserteds.back();
+        _insertedIndexes[ _inserteds[index]._go ] = index;
+      }
+      _inserteds.pop_back();
+      return;
+    }
+    _removeds.insert( go );
+  }
+
+
+  void  PackedRTree::flush ()
+  {
+    if (_inserteds.empty() and _removeds.empty()) return;
+
+    vector<Item> items;
+    items.reserve( size() );
+    for ( const Item& item : _items ) {
+      if (not _removeds.count(item._go)) items.push_back( item );
+    }
+    items.insert( items.end(), _inserteds.begin(), _inserteds.end() );
+    _pack( items );
+  }
+
+
+  void  PackedRTree::clear ()
+  {
+    _items          .clear();
+    _nodes          .clear();
+    _removeds       .clear();
+    _inserteds      .clear();
+    _insertedIndexes.clear();
+    _leafCount = 0;
+  }
+
+
+  void  PackedRTree::_pack ( vector<Item>& items )
+  {
+    clear();
+    if (items.empty()) return;
+
+    Box bounds;
+    for ( const Item& item : items ) bounds.merge( item._box );
+
+    double xscale = (bounds.getWidth () > 0) ? 65535.0 / (double)bounds.getWidth () : 0.0;
+    double yscale = (bounds.getHeight() > 0) ? 65535.0 / (double)bounds.getHeight() : 0.0;
+
+    vector< std::pair<uint64_t,uint32_t> > keys;
+    keys.reserve( items.size() );
+    for ( size_t i=0 ; i<items.size() ; ++i ) {
+      const Box& box = items[i]._box;
+      uint32_t   x   = 0;
+      uint32_t   y   = 0;
+      if (not box.isEmpty()) {
+        x = (uint32_t)( (double)(box.getXCenter() - bounds.getXMin()) * xscale );
+        y = (uint32_t)( (double)(box.getYCenter() - bounds.getYMin()) * yscale );
+      }
+      keys.push_back( std::make_pair(hilbertIndex(x,y),(uint32_t)i) );
+    }
+    std::sort( keys.begin(), keys.end() );
+
+    _items.reserve( items.size() );
+    for ( auto& key : keys ) _items.push_back( items[key.second] );
+
+    const size_t capacity = NodeCapacity;
+    for ( size_t first=0 ; first<_items.size() ; first+=capacity ) {
+      Node node { Box(), (uint32_t)first, (uint32_t)std::min( capacity, _items.size()-first ) };
+      for ( size_t i=first ; i<first+node._count ; ++i ) node._box.merge( _items[i]._box );
+      _nodes.push_back( node );
+    }
+    _leafCount = _nodes.size();
+
+    size_t levelBegin = 0;
+    size_t levelEnd   = _nodes.size();
+    while ( levelEnd - levelBegin > 1 ) {
+      for ( size_t first=levelBegin ; first<levelEnd ; first+=capacity ) {
+        Node node { Box(), (uint32_t)first, (uint32_t)std::min( capacity, levelEnd-first ) };
+        for ( size_t i=first ; i<first+node._count ; ++i ) node._box.merge( _nodes[i]._box );
+        _nodes.push_back( node );
+      }
+      levelBegin = levelEnd;
+      levelEnd   = _nodes.size();
+    }
+  }
+
+
+  string  PackedRTree::_getTypeName () const
+  { return "PackedRTree"; }
+
+
+  string  PackedRTree::_getString () const
+  {
+    string s = "<" + _getTypeName()
+             + " " + getString(_items.size())
+             + " +" + getString(_inserteds.size())
+             + " -" + getString(_removeds.size()) + ">";
+    return s;
+  }
+
+
+  Record* PackedRTree::_getRecord () const
+  {
+    Record* record = new Record ( _getString() );
+    record->add( getSlot("_leafCount", _leafCount   ) );
+    record->add( getSlot("_nodes"    , _nodes.size()) );
+    return record;
+  }
+
+
+}  // Hurricane namespace.
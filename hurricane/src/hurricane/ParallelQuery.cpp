@@ -0,0 +1,239 @@
+// -*- C++ -*-
+//
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// This file is part of Hurricane.
+//
+// Hurricane is free software: you can redistribute it  and/or  modify
+// it under the terms of the GNU  Lesser  General  Public  License  as
+// published by the Free Software Foundation, either version 3 of  the
+// License, or (at your option) any later version.
+//
+// Hurricane is distributed in the hope that it will  be  useful,  but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHAN-
+// TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See  the  Lesser  GNU
+// General Public License for more details.
+//
+// You should have received a copy of the Lesser  GNU  General  Public
+// License along with Hurricane. If not, see
+//                                     <http://www.gnu.org/licenses/>.
+//
+// +-----------------------------------------------------------------+
+// |                  H U R R I C A N E                              |
+// |     V L S I   B a c k e n d   D a t a - B a s e                 |
+// |                                                                 |
+// |  Author      :                    Jean-Paul Chaput              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./ParallelQuery.cpp"                           |
+// +-----------------------------------------------------------------+
+
+
+#include <set>
+#include "hurricane/Error.h"
+#include "hurricane/Slice.h"
+#include "hurricane/ExtensionSlice.h"
+#include "hurricane/ThreadPool.h"
+#include "hurricane/ParallelQuery.h"
+
+
+namespace Hurricane {
+
+  using std::vector;
+  using std::set;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Hurricane::ParallelQuery".
+
+
+  std::atomic<unsigned int>  ParallelQuery::_running ( 0 );
+
+
+  bool  ParallelQuery::isRunning ()
+  { return _running.load(std::memory_order_relaxed) > 0; }
+
+
+  void  ParallelQuery::checkReadOnly ( const char* where )
+  {
+    if (isRunning())
+      throw Error( "%s: Database modification while a ParallelQuery is running.", where );
+  }
+
+
+  std::mutex& ParallelQuery::getPathMutex ( const Instance* instance )
+  {
+    static const size_t  stripes = 256;
+    static std::mutex    pathMutexes [ stripes ];
+    return pathMutexes[ instance->getId() % stripes ];
+  }
+
+
+  ParallelQuery::ParallelQuery ( size_t threads )
+    : _threads       (threads)
+    , _columns       (1)
+    , _rows          (1)
+    , _cell          (NULL)
+    , _area          ()
+    , _transformation()
+    , _basicLayer    (NULL)
+    , _extensionMask (0)
+    , _filter        (Query::DoAll)
+    , _threshold     (0)
+    , _startLevel    (0)
+    , _stopLevel     (std::numeric_limits<unsigned int>::max())
+    , _stopCellFlags (Cell::Flags::NoFlags)
+  { }
+
+
+  ParallelQuery::~ParallelQuery ()
+  { }
+
+
+  void  ParallelQuery::setQuery ( Cell*                 cell
+                                , const Box&            area
+                                , const Transformation& transformation
+                                , const BasicLayer*     basicLayer
+                                , ExtensionSlice::Mask  extensionMask
+                                , Mask                  filter
+                                , DbU::Unit             threshold
+                                )
+  {
+    _cell           = cell;
+    _area           = area;
+    _transformation = transformation;
+    _basicLayer     = basicLayer;
+    _extensionMask  = extensionMask;
+    _filter         = filter;
+    _threshold      = threshold;
+  }
+
+
+// Compute, serially, all the lazily cached data that a Query may read:
+// bounding boxes of the Cells & QuadTrees, pending R-tree updates.
+  void  ParallelQuery::freeze ( Cell* top )
+  {
+    set<Cell*>    visiteds;
+    vector<Cell*> stack;
+    stack.push_back( top );
+    visiteds.insert( top );
+
+    while ( not stack.empty() ) {
+      Cell* cell = stack.back();
+      stack.pop_back();
+
+      cell->_getQuadTree()->_freeze();
+      for ( Slice* slice : cell->getSlices() ) slice->_getQuadTree()->_freeze();
+      for ( ExtensionSlice* slice : cell->getExtensionSlices() ) slice->_getQuadTree()->_freeze();
+      cell->getBoundingBox();
+
+      for ( Instance* instance : cell->getInstances() ) {
+        Cell* master = instance->getMasterCell();
+        if (visiteds.insert(master).second) stack.push_back( master );
+      }
+    }
+  }
+
+
+  void  ParallelQuery::_setupWorker ( Query*                worker
+                                    , Cell*                 cell
+                                    , const Box&            area
+                                    , const Transformation& transformation
+                                    , const Path&           path )
+  {
+    worker->setQuery( cell, area, transformation, _basicLayer, _extensionMask, _filter, _threshold );
+    worker->setTopPath      ( path );
+    worker->setStopCellFlags( _stopCellFlags );
+  }
+
+
+  void  ParallelQuery::doQuery ()
+  {
+    if (_area.isEmpty() or not _cell) return;
+
+    freeze( _cell );
+
+  // Top level instances, in the order a plain Query walks them.
+    vector<Instance*> instances;
+    vector<Path>      paths;
+    if ( (_stopLevel > 0) and not _cell->getFlags().isset(_stopCellFlags) ) {
+      for ( Instance* instance : _cell->getInstancesUnder(_area,_threshold) ) {
+        instances.push_back( instance );
+        paths    .push_back( Path(instance) );
+      }
+    }
+
+    ThreadPool pool      ( _threads );
+    size_t     chunkSize = std::max( (size_t)1, instances.size() / (pool.size()*8) );
+    size_t     chunks    = (instances.size() + chunkSize - 1) / chunkSize;
+    size_t     tiles     = (_startLevel == 0) ? getTiles() : 0;
+
+    vector<Query*> workers ( chunks + tiles, NULL );
+    for ( size_t i=0 ; i<workers.size() ; ++i ) workers[i] = newWorker();
+
+    DbU::Unit tileWidth  = _area.getWidth () / _columns;
+    DbU::Unit tileHeight = _area.getHeight() / _rows;
+    Mask      tileFilter = _filter;
+    tileFilter.unset( Query::DoMasterCells );
+
+    try {
+      ReadOnlyScope readOnly;
+      pool.run( workers.size(), [&]( size_t itask, size_t ) {
+        Query* worker = workers[itask];
+
+        if (itask < chunks) {
+          size_t begin = itask*chunkSize;
+          size_t end   = std::min( begin+chunkSize, instances.size() );
+          for ( size_t i=begin ; i<end ; ++i ) {
+            Instance*      instance       = instances[i];
+            Transformation transformation = instance->getTransformation();
+            Box            area           = _area;
+            instance->getTransformation().getInvert().applyOn( area );
+            _transformation.applyOn( transformation );
+
+            _setupWorker( worker, instance->getMasterCell(), area, transformation, paths[i] );
+            worker->setStartLevel( (_startLevel) ? _startLevel-1 : 0 );
+            worker->setStopLevel ( _stopLevel-1 );
+            worker->doQuery();
+          }
+          return;
+        }
+
+        size_t itile  = itask - chunks;
+        size_t column = itile % _columns;
+        size_t row    = itile / _columns;
+        Box    tile   = _area;
+        if (tiles > 1) {
+          DbU::Unit xmin = _area.getXMin() + column*tileWidth;
+          DbU::Unit ymin = _area.getYMin() + row   *tileHeight;
+          DbU::Unit xmax = (column+1 == _columns) ? _area.getXMax() : xmin + tileWidth;
+          DbU::Unit ymax = (row   +1 == _rows   ) ? _area.getYMax() : ymin + tileHeight;
+          tile = Box( xmin, ymin, xmax, ymax );
+        }
+
+      // The tiles and the bounding boxes checked by Query::_isOwned() are
+      // both in the top Cell coordinates, _transformation being applied
+      // only on the reported objects.
+        _setupWorker( worker, _cell, tile, _transformation, Path() );
+        worker->setStartLevel( 0 );
+        worker->setStopLevel ( 0 );
+        if (itile > 0) worker->setFilter( tileFilter );
+        if (tiles > 1) worker->_setTile( _area, tile );
+        worker->doQuery();
+      } );
+    } catch ( ... ) {
+      for ( Query* worker : workers ) delete worker;
+      throw;
+    }
+
+  // A plain Query reports the objects of the top Cell before going down
+  // the instances, so merge the tiles first.
+    for ( size_t i=0 ; i<workers.size() ; ++i ) {
+      Query* worker = workers[ (i < tiles) ? chunks+i : i-tiles ];
+      mergeWorker( worker );
+      delete worker;
+    }
+  }
+
+
+}  // Hurricane namespace.
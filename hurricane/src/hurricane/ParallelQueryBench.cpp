@@ -0,0 +1,287 @@
+// -*- C++ -*-
+//
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// This file is part of Hurricane.
+//
+// Hurricane is free software: you can redistribute it  and/or  modify
+// it under the terms of the GNU  Lesser  General  Public  License  as
+// published by the Free Software Foundation, either version 3 of  the
+// License, or (at your option) any later version.
+//
+// Hurricane is distributed in the hope that it will  be  useful,  but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHAN-
+// TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See  the  Lesser  GNU
+// General Public License for more details.
+//
+// You should have received a copy of the Lesser  GNU  General  Public
+// License along with Hurricane. If not, see
+//                                     <http://www.gnu.org/licenses/>.
+//
+// +-----------------------------------------------------------------+
+// |                  H U R R I C A N E                              |
+// |     V L S I   B a c k e n d   D a t a - B a s e                 |
+// |                                                                 |
+// |  Author      :                    Jean-Paul Chaput              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./ParallelQueryBench.cpp"                      |
+// +-----------------------------------------------------------------+
+//
+// Build a synthetic three levels hierarchy (leaf cells of wires and
+// contacts, placed in blocks, placed in the top Cell along with some
+// long top level wires), then run the same Query plainly and through
+// a ParallelQuery. Check that:
+//
+// 1. With one tile, the parallel query reports exactly the same
+//    (Go, Path, bounding box) in exactly the same order.
+// 2. With several tiles, it reports the same set, each object once.
+//
+// The process exits with a non zero status on any mismatch.
+//
+// Usage:  parallel-query-bench [columns] [rows] [threads]
+
+
+#include <cstdlib>
+#include <chrono>
+#include <tuple>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include "hurricane/DataBase.h"
+#include "hurricane/Technology.h"
+#include "hurricane/BasicLayer.h"
+#include "hurricane/Library.h"
+#include "hurricane/Cell.h"
+#include "hurricane/Net.h"
+#include "hurricane/Contact.h"
+#include "hurricane/Horizontal.h"
+#include "hurricane/Vertical.h"
+#include "hurricane/Instance.h"
+#include "hurricane/UpdateSession.h"
+#include "hurricane/ParallelQuery.h"
+
+
+namespace {
+
+  using namespace std;
+  using namespace Hurricane;
+
+  typedef std::chrono::steady_clock  Clock;
+
+  inline DbU::Unit  l ( double v ) { return DbU::fromLambda(v); }
+
+
+// -------------------------------------------------------------------
+// Class  :  "Hit".
+
+  class Hit {
+    public:
+      inline       Hit        ( Go*, const Path&, const Box& );
+      inline bool  operator== ( const Hit& ) const;
+      inline bool  operator<  ( const Hit& ) const;
+    public:
+      Go*   _go;
+      Path  _path;
+      Box   _box;
+  };
+
+
+  inline  Hit::Hit ( Go* go, const Path& path, const Box& box )
+    : _go(go), _path(path), _box(box)
+  { }
+
+  inline bool  Hit::operator== ( const Hit& other ) const
+  { return (_go == other._go) and (_path == other._path) and (_box == other._box); }
+
+  inline bool  Hit::operator< ( const Hit& other ) const
+  {
+    return std::make_tuple( (_go) ? _go->getId() : 0, _path.getName(), _box.getXMin(), _box.getYMin() )
+         < std::make_tuple( (other._go) ? other._go->getId() : 0, other._path.getName()
+                          , other._box.getXMin(), other._box.getYMin() );
+  }
+
+
+// -------------------------------------------------------------------
+// Class  :  "HitQuery".
+//
+// Record every callback, master cells included, to check the order.
+
+  class HitQuery : public Query {
+    public:
+                            HitQuery            ();
+      virtual bool          hasMasterCellCallback () const;
+      virtual void          goCallback          ( Go* );
+      virtual void          extensionGoCallback ( Go* );
+      virtual void          masterCellCallback  ();
+      inline  vector<Hit>&  getHits             ();
+    private:
+      vector<Hit>  _hits;
+  };
+
+
+  HitQuery::HitQuery ()
+    : Query(), _hits()
+  { }
+
+  bool  HitQuery::hasMasterCellCallback () const
+  { return true; }
+
+  void  HitQuery::goCallback ( Go* go )
+  { _hits.push_back( Hit( go, getPath(), getTransformation().getBox(go->getBoundingBox()) ) ); }
+
+  void  HitQuery::extensionGoCallback ( Go* )
+  { }
+
+  void  HitQuery::masterCellCallback ()
+  { _hits.push_back( Hit( NULL, getPath(), Box() ) ); }
+
+  inline vector<Hit>& HitQuery::getHits () { return _hits; }
+
+
+// -------------------------------------------------------------------
+// Class  :  "ParallelHitQuery".
+
+  class ParallelHitQuery : public ParallelQuery {
+    public:
+                            ParallelHitQuery ( size_t threads );
+      virtual Query*        newWorker        ();
+      virtual void          mergeWorker      ( Query* );
+      inline  vector<Hit>&  getHits          ();
+    private:
+      vector<Hit>  _hits;
+  };
+
+
+  ParallelHitQuery::ParallelHitQuery ( size_t threads )
+    : ParallelQuery(threads), _hits()
+  { }
+
+  Query* ParallelHitQuery::newWorker ()
+  { return new HitQuery(); }
+
+  void  ParallelHitQuery::mergeWorker ( Query* worker )
+  {
+    vector<Hit>& hits = static_cast<HitQuery*>( worker )->getHits();
+    _hits.insert( _hits.end(), hits.begin(), hits.end() );
+  }
+
+  inline vector<Hit>& ParallelHitQuery::getHits () { return _hits; }
+
+
+  Cell* buildDesign ( size_t columns, size_t rows, const BasicLayer*& layer )
+  {
+    DataBase*   db      = DataBase::create();
+    Technology* tech    = Technology::create( db, "bench" );
+    BasicLayer* metal1  = BasicLayer::create( tech, "METAL1", BasicLayer::Material::metal );
+    Library*    library = Library::create( db, "bench" );
+    Cell*       leaf    = Cell::create( library, "leaf" );
+    Cell*       block   = Cell::create( library, "block" );
+    Cell*       top     = Cell::create( library, "top" );
+
+    layer = metal1;
+    UpdateSession::open();
+    Net* net = Net::create( leaf, "leaf" );
+    for ( size_t i=0 ; i<8 ; ++i ) {
+      Contact   ::create( net, metal1, l(5.0*i+2.5), l(2.5), l(2.0), l(2.0) );
+      Horizontal::create( net, metal1, l(5.0*i+5.0), l(1.0), l(0.0), l(40.0) );
+    }
+    leaf->setAbutmentBox( Box( l(0.0), l(0.0), l(40.0), l(50.0) ) );
+
+    for ( size_t row=0 ; row<4 ; ++row ) {
+      for ( size_t column=0 ; column<4 ; ++column ) {
+        Instance::create( block
+                        , "leaf_" + getString(row) + "_" + getString(column)
+                        , leaf
+                        , Transformation( l(40.0*column), l(50.0*(row + row%2))
+                                        , (row % 2) ? Transformation::Orientation::MY
+                                                    : Transformation::Orientation::ID )
+                        , Instance::PlacementStatus::PLACED );
+      }
+    }
+    block->setAbutmentBox( Box( l(0.0), l(0.0), l(160.0), l(200.0) ) );
+
+    for ( size_t row=0 ; row<rows ; ++row ) {
+      for ( size_t column=0 ; column<columns ; ++column ) {
+        Instance::create( top
+                        , "block_" + getString(row) + "_" + getString(column)
+                        , block
+                        , Transformation( l(160.0*column), l(200.0*row) )
+                        , Instance::PlacementStatus::PLACED );
+      }
+    }
+    DbU::Unit width  = l(160.0*columns);
+    DbU::Unit height = l(200.0*rows);
+    net = Net::create( top, "top" );
+    for ( size_t row=0 ; row<rows ; ++row )
+      Horizontal::create( net, metal1, l(200.0*row+100.0), l(2.0), 0, width );
+    for ( size_t column=0 ; column<columns ; ++column )
+      Vertical::create( net, metal1, l(160.0*column+80.0), l(2.0), 0, height );
+    top->setAbutmentBox( Box( 0, 0, width, height ) );
+    UpdateSession::close();
+    return top;
+  }
+
+
+  bool  check ( const char* name, vector<Hit> reference, vector<Hit> hits, bool ordered )
+  {
+    if (not ordered) {
+      sort( reference.begin(), reference.end() );
+      sort( hits     .begin(), hits     .end() );
+    }
+    if (hits.size() != reference.size()) {
+      cerr << "[ERROR] " << name << ": " << hits.size() << " hits, "
+           << reference.size() << " expected." << endl;
+      return false;
+    }
+    for ( size_t i=0 ; i<hits.size() ; ++i ) {
+      if (not (hits[i] == reference[i])) {
+        cerr << "[ERROR] " << name << ": first mismatch at hit " << i << ", "
+             << hits[i]._path << " vs. " << reference[i]._path << "." << endl;
+        return false;
+      }
+    }
+    return true;
+  }
+
+
+}  // Anonymous namespace.
+
+
+int  main ( int argc, char* argv[] )
+{
+  size_t columns = (argc > 1) ? strtoul( argv[1], NULL, 10 ) : 40;
+  size_t rows    = (argc > 2) ? strtoul( argv[2], NULL, 10 ) : 40;
+  size_t threads = (argc > 3) ? strtoul( argv[3], NULL, 10 ) : 4;
+
+  cout << "Building a design of " << columns << "x" << rows << " blocks." << endl;
+  const BasicLayer* layer = NULL;
+  Cell*             top   = buildDesign( columns, rows, layer );
+  Box               area  = top->getAbutmentBox();
+  Query::Mask       mask  = Query::DoComponents|Query::DoMasterCells|Query::DoTerminalCells;
+
+  HitQuery          plain;
+  plain.setQuery( top, area, Transformation(), layer, 0, mask );
+  Clock::time_point start = Clock::now();
+  plain.doQuery();
+  double seconds = std::chrono::duration<double>( Clock::now() - start ).count();
+  cout << "  o  Plain Query: " << seconds*1000.0 << " ms, "
+       << plain.getHits().size() << " hits." << endl;
+
+  int status = 0;
+  for ( unsigned int tiles : { 1, 4 } ) {
+    ParallelHitQuery parallel ( threads );
+    parallel.setQuery( top, area, Transformation(), layer, 0, mask );
+    parallel.setTiles( tiles, tiles );
+    start = Clock::now();
+    parallel.doQuery();
+    seconds = std::chrono::duration<double>( Clock::now() - start ).count();
+    cout << "  o  ParallelQuery, " << threads << " threads, " << tiles << "x" << tiles << " tiles: "
+         << seconds*1000.0 << " ms, " << parallel.getHits().size() << " hits." << endl;
+
+    if (not check( "ParallelQuery", plain.getHits(), parallel.getHits(), (tiles == 1) ))
+      status = 1;
+  }
+
+  return status;
+}
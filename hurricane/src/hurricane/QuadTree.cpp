@@ -18,6 +18,7 @@
 // ****************************************************************************************************
 
 #include "hurricane/QuadTree.h"
+#include "hurricane/PackedRTree.h"
 #include "hurricane/Go.h"
 #include "hurricane/Instance.h"
 #include "hurricane/Error.h"
@@ -199,7 +200,8 @@ QuadTree::QuadTree()
     _ulChild(NULL),
     _urChild(NULL),
     _llChild(NULL),
-    _lrChild(NULL)
+    _lrChild(NULL),
+    _rtree(NULL)
 {
 }
 
@@ -214,7 +216,8 @@ QuadTree::QuadTree(QuadTree* parent)
     _ulChild(NULL),
     _urChild(NULL),
     _llChild(NULL),
-    _lrChild(NULL)
+    _lrChild(NULL),
+    _rtree(NULL)
 {
 }
 
@@ -225,6 +228,7 @@ QuadTree::~QuadTree()
     if (_urChild) delete _urChild;
     if (_llChild) delete _llChild;
     if (_lrChild) delete _lrChild;
+    if (_rtree) delete _rtree;
 }
 
 //size_t  QuadTree::getLocatorAllocateds ()
@@ -257,6 +261,10 @@ Gos QuadTree::getGos() const
 Gos QuadTree::getGosUnder(const Box& area, DbU::Unit threshold) const
 // ******************************************************************
 {
+  if (_rtree) {
+    if (_rtree->isDirty()) _rtree->flush();
+    return _rtree->getGosUnder(area, threshold);
+  }
   return QuadTree_GosUnder(this, area, threshold);
 }
 
@@ -268,6 +276,14 @@ void QuadTree::insert(Go* go)
 
     if (!go->isMaterialized()) {
         Box boundingBox = go->getBoundingBox();
+        if (_rtree) {
+            _goSet._insert(go);
+            go->_quadTree = this;
+            _size++;
+            if (!_boundingBox.isEmpty()) _boundingBox.merge(boundingBox);
+            _rtree->insert(go, boundingBox);
+            return;
+        }
         QuadTree* child = _getDeepestChild(boundingBox);
         child->_goSet._insert(go);
         go->_quadTree = child;
@@ -291,6 +307,14 @@ void QuadTree::remove(Go* go)
 
     if (go->isMaterialized()) {
         Box boundingBox = go->getBoundingBox();
+        if (_rtree) {
+            _goSet._remove(go);
+            go->_quadTree = NULL;
+            _size--;
+            if (_boundingBox.isConstrainedBy(boundingBox)) _boundingBox = Box();
+            _rtree->remove(go);
+            return;
+        }
         QuadTree* child = go->_quadTree;
         child->_goSet._remove(go);
         go->_quadTree = NULL;
@@ -339,6 +363,7 @@ Record* QuadTree::_getRecord() const
     record->add( getSlot("_urChild"    ,  _urChild    ) );
     record->add( getSlot("_llChild"    ,  _llChild    ) );
     record->add( getSlot("_lrChild"    ,  _lrChild    ) );
+    record->add( getSlot("_rtree"      ,  _rtree      ) );
   }
   return record;
 }
@@ -527,6 +552,60 @@ void QuadTree::_implode()
 }
 
 
+void QuadTree::_setRTreeIndex(bool state)
+// **************************************
+{
+    if (_parent)
+        throw Error("Can't set R-tree index : not a root QuadTree");
+
+    if (state == (_rtree != NULL)) return;
+
+    if (state) {
+    // Pull all the Gos back into the root GoSet, then bulk load them.
+        _implode();
+        vector<Go*> gos;
+        gos.reserve(_size);
+        for ( Go* go : _goSet.getElements() ) gos.push_back(go);
+        _rtree = new PackedRTree();
+        _rtree->build(gos);
+    } else {
+    // Re-insert all the Gos through the regular QuadTree algorithm.
+        delete _rtree;
+        _rtree = NULL;
+        vector<Go*> gos;
+        gos.reserve(_size);
+        for ( Go* go : _goSet.getElements() ) gos.push_back(go);
+        for ( Go* go : gos ) {
+            _goSet._remove(go);
+            go->_quadTree = NULL;
+        }
+        _size = 0;
+        _boundingBox = Box();
+        for ( Go* go : gos ) insert(go);
+    }
+}
+
+void QuadTree::_flushRTree()
+// *************************
+{
+    if (_rtree) _rtree->flush();
+}
+
+void QuadTree::_freeze()
+// *********************
+{
+// Compute all the lazily updated data, so the tree can then be queried
+// from concurrent threads without any hidden write.
+    if (_hasBeenExploded()) {
+        _ulChild->_freeze();
+        _urChild->_freeze();
+        _llChild->_freeze();
+        _lrChild->_freeze();
+    }
+    getBoundingBox();
+    _flushRTree();
+}
+
 
 // ****************************************************************************************************
 // QuadTree::GoSet implementation
@@ -49,6 +49,7 @@ namespace Hurricane {
     , _topArea           ()
     , _threshold         (0)
     , _topTransformation ()
+    , _topPath           ()
     , _startLevel        (0)
     , _stopLevel         (std::numeric_limits<unsigned int>::max())
     , _stopCellFlags     (Cell::Flags::NoFlags)
@@ -70,6 +71,8 @@ namespace Hurricane {
     : _stack()
     , _basicLayer(NULL)
     , _filter(DoAll)
+    , _tiledArea()
+    , _tile()
   { }
 
 
@@ -131,21 +134,24 @@ namespace Hurricane {
               if (not slice->getLayer()->contains(getBasicLayer())) continue;
               if (not slice->getBoundingBox().intersect(getArea())) continue;
         
-              for ( Go* go : slice->getGosUnder(_stack.getArea(),_stack.getThreshold()) )
-                goCallback( go );
+              for ( Go* go : slice->getGosUnder(_stack.getArea(),_stack.getThreshold()) ) {
+                if (_isOwned(go)) goCallback( go );
+              }
             }
           }
         }
         
         if ( (not getMasterCell()->isTerminal() or (_filter.isSet(DoTerminalCells)))
            and _filter.isSet(DoMarkers) ) {
-          for ( Marker* marker : getMasterCell()->getMarkersUnder(_stack.getArea()) )
-            markerCallback( marker );
+          for ( Marker* marker : getMasterCell()->getMarkersUnder(_stack.getArea()) ) {
+            if (_isOwned(marker)) markerCallback( marker );
+          }
         }
         
         if ( not getMasterCell()->isTerminal() and (_filter.isSet(DoRubbers)) ) {
-          for ( Rubber* rubber : getMasterCell()->getRubbersUnder(_stack.getArea()) )
-            rubberCallback( rubber );
+          for ( Rubber* rubber : getMasterCell()->getRubbersUnder(_stack.getArea()) ) {
+            if (_isOwned(rubber)) rubberCallback( rubber );
+          }
         }
         
         if ( hasExtensionGoCallback() and (_filter.isSet(DoExtensionGos)) ) {
@@ -155,7 +161,7 @@ namespace Hurricane {
               if ( not slice->getBoundingBox().intersect(getArea()) ) continue;
         
               for ( Go* go : slice->getGosUnder(_stack.getArea(),_stack.getThreshold()) ) {
-                extensionGoCallback( go );
+                if (_isOwned(go)) extensionGoCallback( go );
               }
             }
           }
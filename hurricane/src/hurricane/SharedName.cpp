@@ -18,6 +18,9 @@
 // ****************************************************************************************************
 
 #include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
 #include "hurricane/Error.h"
 #include "hurricane/SharedName.h"
 
@@ -25,23 +28,201 @@ namespace Hurricane {
 
 
 
+// ****************************************************************************************************
+// SharedName::Table implementation
+// ****************************************************************************************************
+
+  class SharedName::Table {
+    public:
+                                 Table     ();
+      inline std::shared_mutex&  getMutex  () const;
+      inline size_t              size      () const;
+      inline size_t              capacity  () const;
+      inline SharedName*         getBucket ( size_t ) const;
+      static inline bool         isLive    ( const SharedName* );
+             SharedName*         find      ( std::string_view, unsigned long hash ) const;
+             void                insert    ( SharedName* );
+             void                erase     ( SharedName* );
+             void                reserve   ( size_t count );
+    private:
+      inline size_t              _slot     ( unsigned long hash ) const;
+             void                _rehash   ( size_t capacity );
+    private:
+      static SharedName* const   Tombstone;
+      static const size_t        MinCapacity = 1024;
+      mutable std::shared_mutex  _mutex;
+      std::vector<SharedName*>   _buckets;
+      size_t                     _size;
+      size_t                     _tombstones;
+  };
+
+
+  SharedName* const  SharedName::Table::Tombstone = reinterpret_cast<SharedName*>( 1 );
+
+
+  SharedName::Table::Table ()
+    : _mutex     ()
+    , _buckets   (MinCapacity,NULL)
+    , _size      (0)
+    , _tombstones(0)
+  { }
+
+
+  inline std::shared_mutex& SharedName::Table::getMutex  () const { return _mutex; }
+  inline size_t             SharedName::Table::size      () const { return _size; }
+  inline size_t             SharedName::Table::capacity  () const { return _buckets.size(); }
+  inline SharedName*        SharedName::Table::getBucket ( size_t i ) const { return _buckets[i]; }
+  inline bool               SharedName::Table::isLive    ( const SharedName* bucket ) { return bucket and (bucket != Tombstone); }
+
+
+// The multiplicative hash of the SharedName is kept as is (it is used by
+// the IntrusiveMaps), so it's bits are mixed before masking.
+  inline size_t  SharedName::Table::_slot ( unsigned long hash ) const
+  {
+    uint64_t h = hash;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h & (_buckets.size() - 1);
+  }
+
+
+  SharedName* SharedName::Table::find ( std::string_view s, unsigned long hash ) const
+  {
+    size_t mask = _buckets.size() - 1;
+    for ( size_t i=_slot(hash) ; _buckets[i] ; i=(i+1) & mask ) {
+      SharedName* bucket = _buckets[i];
+      if (bucket == Tombstone) continue;
+      if ((bucket->_hash == hash) and (bucket->_string == s)) return bucket;
+    }
+    return NULL;
+  }
+
+
+  void  SharedName::Table::insert ( SharedName* sharedName )
+  {
+    if ((_size + _tombstones + 1) * 4 > _buckets.size() * 3) {
+      size_t capacity = _buckets.size();
+      while ( (_size + 1) * 2 > capacity ) capacity *= 2;
+      _rehash( capacity );
+    }
+
+    size_t mask = _buckets.size() - 1;
+    size_t i    = _slot( sharedName->_hash );
+    while ( isLive(_buckets[i]) ) i = (i+1) & mask;
+    if (_buckets[i] == Tombstone) --_tombstones;
+    _buckets[i] = sharedName;
+    ++_size;
+  }
+
+
+  void  SharedName::Table::erase ( SharedName* sharedName )
+  {
+    size_t mask = _buckets.size() - 1;
+    for ( size_t i=_slot(sharedName->_hash) ; _buckets[i] ; i=(i+1) & mask ) {
+      if (_buckets[i] == sharedName) {
+        _buckets[i] = Tombstone;
+        --_size;
+        ++_tombstones;
+        return;
+      }
+    }
+  }
+
+
+  void  SharedName::Table::reserve ( size_t count )
+  {
+    size_t capacity = _buckets.size();
+    while ( count * 4 > capacity * 3 ) capacity *= 2;
+    if (capacity > _buckets.size()) _rehash( capacity );
+  }
+
+
+  void  SharedName::Table::_rehash ( size_t capacity )
+  {
+    std::vector<SharedName*> buckets ( capacity, NULL );
+    buckets.swap( _buckets );
+    _tombstones = 0;
+
+    size_t mask = _buckets.size() - 1;
+    for ( SharedName* bucket : buckets ) {
+      if (not isLive(bucket)) continue;
+      size_t i = _slot( bucket->_hash );
+      while ( _buckets[i] ) i = (i+1) & mask;
+      _buckets[i] = bucket;
+    }
+  }
+
+
+// Never destroyed, as Names may still be released by the static
+// destructors of other modules.
+  SharedName::Table& SharedName::_getTable ()
+  {
+    static Table* table = new Table ();
+    return *table;
+  }
+
+
+
 // ****************************************************************************************************
 // SharedName implementation
 // ****************************************************************************************************
 
-  SharedName::SharedNameMap* SharedName::_SHARED_NAME_MAP = NULL;
+
+  unsigned long  SharedName::computeHash ( std::string_view s )
+  {
+    unsigned long hash = 0;
+    for ( char c : s ) hash = 131 * hash + int(c);
+    return hash;
+  }
+
+
+  SharedName* SharedName::intern ( std::string_view s )
+  {
+    Table&        table      = _getTable();
+    unsigned long hash       = computeHash( s );
+    SharedName*   sharedName = NULL;
+    {
+      std::shared_lock<std::shared_mutex> lock ( table.getMutex() );
+      sharedName = table.find( s, hash );
+      if (sharedName) {
+        sharedName->capture();
+        return sharedName;
+      }
+    }
+
+    std::unique_lock<std::shared_mutex> lock ( table.getMutex() );
+    sharedName = table.find( s, hash );
+    if (not sharedName) {
+      sharedName = new SharedName ( s, hash );
+      table.insert( sharedName );
+    }
+    sharedName->capture();
+    return sharedName;
+  }
+
+
+  void  SharedName::reserve ( size_t count )
+  {
+    Table& table = _getTable();
+    std::unique_lock<std::shared_mutex> lock ( table.getMutex() );
+    table.reserve( table.size() + count );
+  }
+
+
+  size_t  SharedName::getCount ()
+  {
+    Table& table = _getTable();
+    std::shared_lock<std::shared_mutex> lock ( table.getMutex() );
+    return table.size();
+  }
 
 
-  SharedName::SharedName ( const string& name )
-    : _hash  (0)
+  SharedName::SharedName ( std::string_view name, unsigned long hash )
+    : _hash  (hash)
     , _count (0)
     , _string(name)
 {
-    if (!_SHARED_NAME_MAP) _SHARED_NAME_MAP = new SharedNameMap();
-    (*_SHARED_NAME_MAP)[&_string] = this;
-
-    for ( char c : _string ) _hash = 131 * _hash + int(c);
-
     // if (_idCounter == std::numeric_limits<unsigned long>::max()) {
     //   throw Error( "SharedName::SharedName(): Identifier counter has reached it's limit (%d bits)."
     //              , std::numeric_limits<unsigned long>::digits );
@@ -52,33 +233,42 @@ namespace Hurricane {
 
 SharedName::~SharedName()
 // **********************
-{
-    _SHARED_NAME_MAP->erase(&_string);
-}
+{ }
 
 void SharedName::capture()
 // ***********************
 {
-    _count++;
+    _count.fetch_add( 1, std::memory_order_relaxed );
 }
 
 void SharedName::release()
 // ***********************
 {
-    if (!--_count) delete this;
+  // Only the last reference is dropped under the table lock.
+    int count = _count.load( std::memory_order_relaxed );
+    while ( count > 1 ) {
+      if (_count.compare_exchange_weak( count, count-1, std::memory_order_acq_rel )) return;
+    }
+
+    Table& table = _getTable();
+    std::unique_lock<std::shared_mutex> lock ( table.getMutex() );
+    if (--_count) return;
+    table.erase( this );
+    lock.unlock();
+    delete this;
 }
 
 string SharedName::_getString() const
 // **********************************
 {
-  return "<" + _TName("SharedName") + " " + getString(_count) + " hash:" + getString(_hash) + " " + _string + ">";
+  return "<" + _TName("SharedName") + " " + getString(_count.load()) + " hash:" + getString(_hash) + " " + _string + ">";
 }
 
 Record* SharedName::_getRecord() const
 // *****************************
 {
     Record* record = new Record(getString(this));
-    record->add(getSlot("_count", &_count));
+    record->add(getSlot("_count", _count.load()));
     record->add(getSlot("_string", &_string));
     return record;
 }
@@ -86,21 +276,15 @@ Record* SharedName::_getRecord() const
 void  SharedName::dump ()
 // **********************
 {
-  cerr << "_SHARED_NAME_MAP contents:" << endl;
-  for ( auto item : *_SHARED_NAME_MAP ) {
-    cerr << "- [" << item.first << "] = " << item.second << endl;
-  }
-}
-
+  Table& table = _getTable();
+  std::shared_lock<std::shared_mutex> lock ( table.getMutex() );
 
-// ****************************************************************************************************
-// SharedName::SharedNameMapComparator
-// ****************************************************************************************************
-
-bool SharedName::SharedNameMapComparator::operator()(string* s1, string* s2) const
-// *******************************************************************************
-{
-    return (*s1) < (*s2);
+  cerr << "SharedName table contents (" << table.size() << "/" << table.capacity() << "):" << endl;
+  for ( size_t i=0 ; i<table.capacity() ; ++i ) {
+    SharedName* bucket = table.getBucket( i );
+    if (not Table::isLive(bucket)) continue;
+    cerr << "- [" << i << "] = " << bucket << endl;
+  }
 }
 
 
@@ -23,6 +23,7 @@
 #include "hurricane/Cell.h"
 #include "hurricane/Quark.h"
 #include "hurricane/Error.h"
+#include "hurricane/ParallelQuery.h"
 
 namespace Hurricane {
 
@@ -152,13 +153,16 @@ SharedPath* SharedPath::getHeadSharedPath() const
 {
     if (!_tailSharedPath) return NULL;
 
-    SharedPath* tailSharedPath = _tailSharedPath->getHeadSharedPath();
-
-    SharedPath* headSharedPath = _headInstance->_getSharedPath(tailSharedPath);
-
-    if (!headSharedPath) headSharedPath = new SharedPath(_headInstance, tailSharedPath);
+    return _getOrCreate(_headInstance, _tailSharedPath->getHeadSharedPath());
+}
 
-    return headSharedPath;
+SharedPath* SharedPath::_getOrCreate(Instance* headInstance, SharedPath* tailSharedPath)
+// *************************************************************************************
+{
+    ParallelQuery::PathLock lock(headInstance);
+    SharedPath* sharedPath = headInstance->_getSharedPath(tailSharedPath);
+    if (!sharedPath) sharedPath = new SharedPath(headInstance, tailSharedPath);
+    return sharedPath;
 }
 
 Instance* SharedPath::getTailInstance() const
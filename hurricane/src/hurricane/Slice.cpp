@@ -49,6 +49,7 @@ Slice::Slice(Cell* cell, const Layer* layer)
         throw Error("Can't create " + _TName("Slice") + " : already exists");
 
     _cell->_getSliceMap()->_insert(this);
+    if (_cell->isRTreeIndexed()) _quadTree._setRTreeIndex(true);
 }
 
 Slice::~Slice()
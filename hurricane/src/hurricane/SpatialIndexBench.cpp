@@ -0,0 +1,153 @@
+// -*- C++ -*-
+//
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// This file is part of Hurricane.
+//
+// Hurricane is free software: you can redistribute it  and/or  modify
+// it under the terms of the GNU  Lesser  General  Public  License  as
+// published by the Free Software Foundation, either version 3 of  the
+// License, or (at your option) any later version.
+//
+// Hurricane is distributed in the hope that it will  be  useful,  but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHAN-
+// TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See  the  Lesser  GNU
+// General Public License for more details.
+//
+// You should have received a copy of the Lesser  GNU  General  Public
+// License along with Hurricane. If not, see
+//                                     <http://www.gnu.org/licenses/>.
+//
+// +-----------------------------------------------------------------+
+// |                  H U R R I C A N E                              |
+// |     V L S I   B a c k e n d   D a t a - B a s e                 |
+// |                                                                 |
+// |  Author      :                    Jean-Paul Chaput              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./SpatialIndexBench.cpp"                      |
+// +-----------------------------------------------------------------+
+//
+// Build a dense synthetic Cell (a grid of contacts on one layer, like
+// the metal1 of a standard cell row), then run the same random area
+// queries through Slice::getComponentsUnder(), with the QuadTree and
+// with the packed R-tree index. Check that both return the same number
+// of components and report the query throughput.
+//
+// Usage:  spatial-index-bench [columns] [rows] [queries]
+
+
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <iostream>
+#include "hurricane/DataBase.h"
+#include "hurricane/Technology.h"
+#include "hurricane/BasicLayer.h"
+#include "hurricane/Library.h"
+#include "hurricane/Cell.h"
+#include "hurricane/Net.h"
+#include "hurricane/Contact.h"
+#include "hurricane/Slice.h"
+#include "hurricane/UpdateSession.h"
+
+
+namespace {
+
+  using namespace std;
+  using namespace Hurricane;
+
+  typedef std::chrono::steady_clock  Clock;
+
+
+  Cell* buildCell ( size_t columns, size_t rows, const Layer*& layer )
+  {
+    DataBase*   db      = DataBase::create();
+    Technology* tech    = Technology::create( db, "bench" );
+    BasicLayer* metal1  = BasicLayer::create( tech, "METAL1", BasicLayer::Material::metal );
+    Library*    library = Library::create( db, "bench" );
+    Cell*       cell    = Cell::create( library, "bench" );
+    Net*        net     = Net::create( cell, "bench" );
+
+    layer = metal1;
+    UpdateSession::open();
+    for ( size_t row=0 ; row<rows ; ++row ) {
+      for ( size_t column=0 ; column<columns ; ++column ) {
+        Contact::create( net
+                       , metal1
+                       , DbU::fromLambda( (double)column*5.0 )
+                       , DbU::fromLambda( (double)row*50.0 )
+                       , DbU::fromLambda( 2.0 )
+                       , DbU::fromLambda( (column % 3) ? 2.0 : 40.0 ) );
+      }
+    }
+    UpdateSession::close();
+    return cell;
+  }
+
+
+  size_t  runQueries ( const char* name, const Slice* slice, const vector<Box>& areas, DbU::Unit threshold )
+  {
+    size_t            found = 0;
+    Clock::time_point start = Clock::now();
+    for ( const Box& area : areas ) {
+      for ( Component* component : slice->getComponentsUnder(area,threshold) ) {
+        if (component) ++found;
+      }
+    }
+    double seconds = std::chrono::duration<double>( Clock::now() - start ).count();
+
+    cout << "  o  " << name << ": " << (double)areas.size()/seconds << " queries/s, "
+         << found << " components found." << endl;
+    return found;
+  }
+
+
+}  // Anonymous namespace.
+
+
+int  main ( int argc, char* argv[] )
+{
+  size_t columns = (argc > 1) ? strtoul( argv[1], NULL, 10 ) : 2000;
+  size_t rows    = (argc > 2) ? strtoul( argv[2], NULL, 10 ) : 500;
+  size_t queries = (argc > 3) ? strtoul( argv[3], NULL, 10 ) : 20000;
+
+  cout << "Building a Cell of " << columns << "x" << rows << " contacts." << endl;
+  const Layer* layer = NULL;
+  Cell*        cell  = buildCell( columns, rows, layer );
+  Slice*       slice = cell->getSlice( layer );
+  Box          ab    = slice->getBoundingBox();
+
+  std::mt19937                        generator ( 42 );
+  std::uniform_real_distribution<>    position  ( 0.0, 1.0 );
+  std::uniform_real_distribution<>    extent    ( 0.001, 0.02 );
+  vector<Box>                         areas;
+  for ( size_t i=0 ; i<queries ; ++i ) {
+    DbU::Unit x = ab.getXMin() + (DbU::Unit)( position(generator) * (double)ab.getWidth () );
+    DbU::Unit y = ab.getYMin() + (DbU::Unit)( position(generator) * (double)ab.getHeight() );
+    DbU::Unit w = (DbU::Unit)( extent(generator) * (double)ab.getWidth () );
+    DbU::Unit h = (DbU::Unit)( extent(generator) * (double)ab.getHeight() );
+    areas.push_back( Box( x, y, x+w, y+h ) );
+  }
+
+  int status = 0;
+  for ( DbU::Unit threshold : { (DbU::Unit)0, DbU::fromLambda(10.0) } ) {
+    cout << "Area queries, threshold " << DbU::getValueString(threshold) << "." << endl;
+    cell->setRTreeIndex( false );
+    size_t quadTreeFound = runQueries( "QuadTree   ", slice, areas, threshold );
+
+    Clock::time_point start = Clock::now();
+    cell->setRTreeIndex( true );
+    double seconds = std::chrono::duration<double>( Clock::now() - start ).count();
+    cout << "  o  Packed R-tree bulk load: " << seconds*1000.0 << " ms." << endl;
+
+    size_t rtreeFound = runQueries( "Packed RTree", slice, areas, threshold );
+    if (quadTreeFound != rtreeFound) {
+      cerr << "[ERROR] Both indexes do not return the same components." << endl;
+      status = 1;
+    }
+  }
+
+  return status;
+}
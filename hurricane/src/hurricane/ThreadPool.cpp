@@ -0,0 +1,210 @@
+// -*- C++ -*-
+//
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// This file is part of Hurricane.
+//
+// Hurricane is free software: you can redistribute it  and/or  modify
+// it under the terms of the GNU  Lesser  General  Public  License  as
+// published by the Free Software Foundation, either version 3 of  the
+// License, or (at your option) any later version.
+//
+// Hurricane is distributed in the hope that it will  be  useful,  but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHAN-
+// TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See  the  Lesser  GNU
+// General Public License for more details.
+//
+// You should have received a copy of the Lesser  GNU  General  Public
+// License along with Hurricane. If not, see
+//                                     <http://www.gnu.org/licenses/>.
+//
+// +-----------------------------------------------------------------+
+// |                  H U R R I C A N E                              |
+// |     V L S I   B a c k e n d   D a t a - B a s e                 |
+// |                                                                 |
+// |  Author      :                    Jean-Paul Chaput              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./ThreadPool.cpp"                              |
+// +-----------------------------------------------------------------+
+
+
+#include <chrono>
+#include <sstream>
+#include <iomanip>
+#include "hurricane/ThreadPool.h"
+
+
+namespace {
+
+  typedef  std::chrono::steady_clock  Clock;
+
+
+  inline double  elapsed ( Clock::time_point start )
+  { return std::chrono::duration<double>( Clock::now() - start ).count(); }
+
+
+}  // Anonymous namespace.
+
+
+namespace Hurricane {
+
+
+// -------------------------------------------------------------------
+// Class  :  "Hurricane::ThreadPool".
+
+
+  size_t  ThreadPool::getHardwareThreads ()
+  {
+    size_t threads = std::thread::hardware_concurrency();
+    return (threads) ? threads : 1;
+  }
+
+
+  ThreadPool::ThreadPool ( size_t threads )
+    : _threads   ()
+    , _mutex     ()
+    , _wakeup    ()
+    , _done      ()
+    , _task      ()
+    , _count     (0)
+    , _next      (0)
+    , _running   (0)
+    , _generation(0)
+    , _terminate (false)
+    , _exception ()
+    , _busyTimes ()
+    , _wallTime  (0.0)
+  {
+    if (not threads) threads = getHardwareThreads();
+    _busyTimes.resize( threads, 0.0 );
+
+    for ( size_t ithread=1 ; ithread<threads ; ++ithread )
+      _threads.emplace_back( &ThreadPool::_work, this, ithread );
+  }
+
+
+  ThreadPool::~ThreadPool ()
+  {
+    {
+      std::lock_guard<std::mutex> lock ( _mutex );
+      _terminate = true;
+    }
+    _wakeup.notify_all();
+    for ( std::thread& thread : _threads ) thread.join();
+  }
+
+
+  void  ThreadPool::run ( size_t count, Task task )
+  {
+    if (not count) return;
+
+    Clock::time_point start = Clock::now();
+
+    if (_threads.empty() or (count == 1)) {
+      for ( size_t index=0 ; index<count ; ++index ) task( index, 0 );
+      double duration = elapsed( start );
+      _busyTimes[0] += duration;
+      _wallTime     += duration;
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock ( _mutex );
+      _task      = task;
+      _count     = count;
+      _next      = 0;
+      _running   = _threads.size();
+      _exception = nullptr;
+      ++_generation;
+    }
+    _wakeup.notify_all();
+
+    _drain( 0 );
+
+    std::unique_lock<std::mutex> lock ( _mutex );
+    _done.wait( lock, [this]{ return _running == 0; } );
+    _task = Task();
+    _wallTime += elapsed( start );
+
+    if (_exception) {
+      std::exception_ptr exception = _exception;
+      _exception = nullptr;
+      std::rethrow_exception( exception );
+    }
+  }
+
+
+  void  ThreadPool::_drain ( size_t thread )
+  {
+    Clock::time_point start = Clock::now();
+
+    while ( true ) {
+      size_t index = _next.fetch_add( 1 );
+      if (index >= _count) break;
+
+      try {
+        _task( index, thread );
+      } catch ( ... ) {
+        std::lock_guard<std::mutex> lock ( _mutex );
+        if (not _exception) _exception = std::current_exception();
+        _next = _count;
+      }
+    }
+
+    _busyTimes[thread] += elapsed( start );
+  }
+
+
+  void  ThreadPool::_work ( size_t thread )
+  {
+    uint64_t generation = 0;
+
+    while ( true ) {
+      {
+        std::unique_lock<std::mutex> lock ( _mutex );
+        _wakeup.wait( lock, [&]{ return _terminate or (_generation != generation); } );
+        if (_terminate) return;
+        generation = _generation;
+      }
+
+      _drain( thread );
+
+      {
+        std::lock_guard<std::mutex> lock ( _mutex );
+        --_running;
+      }
+      _done.notify_one();
+    }
+  }
+
+
+  double  ThreadPool::getUtilization ( size_t thread ) const
+  {
+    if (_wallTime <= 0.0) return 0.0;
+    return getBusyTime(thread) / _wallTime;
+  }
+
+
+  void  ThreadPool::resetStats ()
+  {
+    for ( double& busyTime : _busyTimes ) busyTime = 0.0;
+    _wallTime = 0.0;
+  }
+
+
+  std::string  ThreadPool::getStringUtilization () const
+  {
+    std::ostringstream os;
+
+    os << "[";
+    for ( size_t ithread=0 ; ithread<size() ; ++ithread ) {
+      if (ithread) os << " ";
+      os << std::setw(3) << (unsigned int)(getUtilization(ithread)*100.0 + 0.5);
+    }
+    os << "]%";
+    return os.str();
+  }
+
+
+}  // Hurricane namespace.
@@ -22,6 +22,7 @@
 #include "hurricane/Cell.h"
 #include "hurricane/Instance.h"
 #include "hurricane/Error.h"
+#include "hurricane/ParallelQuery.h"
 
 namespace Hurricane {
 
@@ -147,6 +148,7 @@ void UpdateSession::onNotOwned()
 void Go::invalidate(bool propagateFlag)
 // ************************************
 {
+  ParallelQuery::checkReadOnly( "Go::invalidate()" );
   cdebug_log(18,1) << "Go::invalidate(" << this << ") " << endl;
 
   if (not UPDATOR_STACK or UPDATOR_STACK->empty())
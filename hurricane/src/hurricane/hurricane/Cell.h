@@ -41,6 +41,8 @@
 #include "hurricane/Transformation.h"
 #include "hurricane/Layer.h"
 #include "hurricane/QuadTree.h"
+#include "hurricane/FlatOccurrenceTable.h"
+#include "hurricane/Ranges.h"
 //#include "hurricane/IntrusiveMap.h"
 #include "hurricane/IntrusiveSet.h"
 #include "hurricane/MapCollection.h"
@@ -85,6 +87,7 @@ class Cell : public Entity {
                   , CellChanged             = (1 << 11)
                   , CellDestroyed           = (1 << 12)
                   // Cell states
+                  , RTreeIndex              = (1 << 19)
                   , TerminalNetlist         = (1 << 20)
                   , Pad                     = (1 << 21)
                   , Feed                    = (1 << 22)
@@ -279,6 +282,9 @@ class Cell : public Entity {
 
     };
 
+    public: typedef IntrusiveRange<InstanceMap> InstanceRange;
+    public: typedef IntrusiveRange<NetMap> NetRange;
+
     class PinMap : public IntrusiveMap<Name, Pin> {
     // *******************************************
 
@@ -342,6 +348,8 @@ class Cell : public Entity {
     private: AliasNameSet _netAliasSet;
     private: Observable _observers;
     private: Flags _flags;
+    private: mutable FlatOccurrenceTable* _flatOccurrenceTable;
+    private: mutable bool _flatOccurrencesInvalidated;
 
 // Constructors
 // ************
@@ -392,6 +400,8 @@ class Cell : public Entity {
     public: void _slaveAbutmentBox(Cell*);
     public: void _setShuntedPath(Path path) { _shuntedPath=path; }
     protected: void _setAbutmentBox(const Box& abutmentBox);
+    public: void _invalidateFlatOccurrenceTable();
+    public: void _setFlatOccurrencesCleared() const { _flatOccurrencesInvalidated = false; }
 
     public: virtual void _toJson(JsonWriter*) const;
     public: virtual void _toJsonCollections(JsonWriter*) const;
@@ -416,6 +426,7 @@ class Cell : public Entity {
     public: Entity* getEntity(const Signature&) const;
     public: Instance* getInstance(const Name& name) const {return _instanceMap.getElement(name);};
     public: Instances getInstances() const {return _instanceMap.getElements();};
+    public: InstanceRange getInstanceRange() const {return InstanceRange(_instanceMap);};
     public: Instances getPlacedInstances() const;
     public: Instances getFixedInstances() const;
     public: Instances getUnplacedInstances() const;
@@ -437,6 +448,7 @@ class Cell : public Entity {
     public: Net* getNet(const Name& name, bool useAlias=true) const;
     public: DeepNet* getDeepNet( Path, const Net* ) const;
     public: Nets getNets() const {return _netMap.getElements();};
+    public: NetRange getNetRange() const {return NetRange(_netMap);};
     public: Nets getGlobalNets() const;
     public: Nets getExternalNets() const;
     public: Nets getInternalNets() const;
@@ -464,6 +476,7 @@ class Cell : public Entity {
     public: Occurrences getTerminalNetlistInstanceOccurrences( const Instance* topInstance=NULL ) const;
     public: Occurrences getTerminalNetlistInstanceOccurrencesUnder(const Box& area) const;
     public: Occurrences getNonTerminalNetlistInstanceOccurrences( const Instance* topInstance=NULL ) const;
+    public: const FlatOccurrenceTable& getFlatOccurrenceTable() const;
     public: Occurrences getComponentOccurrences(const Layer::Mask& mask = Layer::Mask::FFFF) const;
     public: Occurrences getComponentOccurrencesUnder(const Box& area, const Layer::Mask& mask = Layer::Mask::FFFF) const;
     public: Occurrences getHyperNetRootNetOccurrences() const;
@@ -496,6 +509,7 @@ class Cell : public Entity {
     public: bool isPlaced() const {return _flags.isset(Flags::Placed);};
     public: bool isRouted() const {return _flags.isset(Flags::Routed);};
     public: bool isExtractConsistent() const {return not _flags.isset(Flags::NoExtractConsistent);};
+    public: bool isRTreeIndexed() const {return _flags.isset(Flags::RTreeIndex);};
     public: bool isNetAlias(const Name& name) const;
 
 // Updators
@@ -505,7 +519,7 @@ class Cell : public Entity {
     public: void setAbutmentBox(const Box& abutmentBox);
     public: void slaveAbutmentBox(Cell*);
     public: void unslaveAbutmentBox(Cell*);
-    public: void setTerminalNetlist(bool state) { _flags.set(Flags::TerminalNetlist,state); };
+    public: void setTerminalNetlist(bool state) { _flags.set(Flags::TerminalNetlist,state); _invalidateFlatOccurrenceTable(); };
     public: void setPad(bool state) {_flags.set(Flags::Pad,state);};
     public: void setFeed(bool state) {_flags.set(Flags::Feed,state);};
     public: void setDiode(bool state) {_flags.set(Flags::Diode,state);};
@@ -513,6 +527,7 @@ class Cell : public Entity {
     public: void setRouted(bool state) {_flags.set(Flags::Routed,state);};
     public: void setAbstractedSupply(bool state) { _flags.set(Flags::AbstractedSupply,state); };
     public: void setNoExtractConsistent(bool state) { _flags.set(Flags::NoExtractConsistent,state); };
+    public: void setRTreeIndex(bool state);
     public: void flattenNets(uint64_t flags=Flags::BuildRings);
     public: void flattenNets(const Instance* instance, uint64_t flags=Flags::BuildRings);
     public: void flattenNets(const Instance* instance, const std::set<std::string>& excludeds, uint64_t flags=Flags::BuildRings);
@@ -0,0 +1,144 @@
+// -*- C++ -*-
+//
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// This file is part of Hurricane.
+//
+// Hurricane is free software: you can redistribute it  and/or  modify
+// it under the terms of the GNU  Lesser  General  Public  License  as
+// published by the Free Software Foundation, either version 3 of  the
+// License, or (at your option) any later version.
+//
+// Hurricane is distributed in the hope that it will  be  useful,  but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHAN-
+// TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See  the  Lesser  GNU
+// General Public License for more details.
+//
+// You should have received a copy of the Lesser  GNU  General  Public
+// License along with Hurricane. If not, see
+//                                     <http://www.gnu.org/licenses/>.
+//
+// +-----------------------------------------------------------------+
+// |                  H U R R I C A N E                              |
+// |     V L S I   B a c k e n d   D a t a - B a s e                 |
+// |                                                                 |
+// |  Author      :                    Jean-Paul Chaput              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./hurricane/Checkpoint.h"                      |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include "hurricane/Name.h"
+
+
+namespace Hurricane {
+
+  class Layer;
+  class Library;
+  class Cell;
+  class Net;
+  class Component;
+  class Occurrence;
+  class Path;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Hurricane::Checkpoint".
+//
+// Native binary snapshot of the DataBase: the library tree and all
+// the Cells, with their instances, nets and components (and the hook
+// rings linking them). The file is a set of flat arrays, one per kind
+// of object. All the names are indexes in one string table and the
+// references between objects are indexes relative to their owner Cell,
+// so any Cell can be rebuilt on it's own.
+//
+// A checkpoint is opened through mmap(). Only the libraries are created
+// at once, the Cells are materialized on demand (getCell()), along with
+// the master Cells of their instances. A Cell which already exists in
+// the DataBase is kept as is, and not rebuilt.
+//
+// The Technology is *not* saved, it must be loaded beforehand and must
+// supply all the layers used in the checkpoint. The DbU settings must
+// be the same as when it was saved. Entity ids, Properties and Rubbers
+// are not saved.
+
+  class Checkpoint {
+    public:
+      static const uint32_t  Version;
+    public:
+      static void                 save             ( const std::string& path, Cell* topCell=NULL );
+      static Checkpoint*          open             ( const std::string& path );
+      static Cell*                load             ( const std::string& path );
+      static Checkpoint*          getCurrent       ();
+      static void                 close            ();
+    public:
+                                 ~Checkpoint       ();
+      inline const std::string&   getPath          () const;
+      inline size_t               getFileSize      () const;
+             size_t               getCellsSize     () const;
+             size_t               getMaterializeds () const;
+             Cell*                getTopCell       ();
+             Cell*                getCell          ( const Name& );
+             void                 materializeAll   ();
+             std::string          _getTypeName     () const;
+             std::string          _getString       () const;
+    private:
+      class Section {
+        public:
+          const char*  _data;
+          uint32_t     _count;
+      };
+    private:
+                                  Checkpoint       ( const std::string& path );
+                                  Checkpoint       ( const Checkpoint& ) = delete;
+             Checkpoint&          operator=        ( const Checkpoint& ) = delete;
+             void                 _map             ();
+             void                 _loadLayers      ();
+             void                 _loadLibraries   ();
+             uint32_t             _checkIndex      ( size_t kind, uint32_t index ) const;
+             Name                 _getName         ( uint32_t ) const;
+             Cell*                _materialize     ( uint32_t );
+             Path                 _getPath         ( Cell*, uint32_t first, uint32_t length, Cell*& leaf ) const;
+             Occurrence           _getOccurrence   ( Cell*, uint32_t, const std::vector<Component*>& ) const;
+             Component*           _findComponent   ( Cell* leaf, const void* record ) const;
+      template< typename T >
+      inline const T*             _get             ( size_t kind, uint32_t index ) const;
+    private:
+      static Checkpoint*                     _current;
+             std::string                     _path;
+             int                             _fd;
+             const char*                     _base;
+             size_t                          _size;
+             std::vector<Section>            _sections;
+             std::vector<const Layer*>       _layers;
+             std::vector<Library*>           _libraries;
+             std::vector<Cell*>              _cells;
+             std::vector<bool>               _rebuilts;
+             std::vector<bool>               _pendings;
+             std::vector<bool>               _masters;
+             std::map<Name,uint32_t>         _cellsByName;
+             std::map< uint32_t, std::vector<Component*> >  _components;
+             uint32_t                        _topCell;
+  };
+
+
+  inline const std::string&  Checkpoint::getPath     () const { return _path; }
+  inline size_t              Checkpoint::getFileSize () const { return _size; }
+
+
+  template< typename T >
+  inline const T* Checkpoint::_get ( size_t kind, uint32_t index ) const
+  { return reinterpret_cast<const T*>( _sections[kind]._data ) + index; }
+
+
+}  // Hurricane namespace.
+
+
+GETSTRING_POINTER_SUPPORT(Hurricane::Checkpoint);
+IOSTREAM_POINTER_SUPPORT(Hurricane::Checkpoint);
@@ -0,0 +1,160 @@
+// -*- C++ -*-
+//
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// This file is part of Hurricane.
+//
+// Hurricane is free software: you can redistribute it  and/or  modify
+// it under the terms of the GNU  Lesser  General  Public  License  as
+// published by the Free Software Foundation, either version 3 of  the
+// License, or (at your option) any later version.
+//
+// Hurricane is distributed in the hope that it will  be  useful,  but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHAN-
+// TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See  the  Lesser  GNU
+// General Public License for more details.
+//
+// You should have received a copy of the Lesser  GNU  General  Public
+// License along with Hurricane. If not, see
+//                                     <http://www.gnu.org/licenses/>.
+//
+// +-----------------------------------------------------------------+
+// |                  H U R R I C A N E                              |
+// |     V L S I   B a c k e n d   D a t a - B a s e                 |
+// |                                                                 |
+// |  Author      :                    Jean-Paul Chaput              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./hurricane/FlatOccurrenceTable.h"             |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include <cstddef>
+#include <vector>
+#include <unordered_map>
+#include "hurricane/Box.h"
+#include "hurricane/Transformation.h"
+#include "hurricane/Path.h"
+#include "hurricane/Occurrence.h"
+
+
+namespace Hurricane {
+
+  class Cell;
+  class Instance;
+  class SharedPath;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Hurricane::FlatOccurrenceTable".
+//
+// Flattened snapshot of Cell::getTerminalNetlistInstanceOccurrences(),
+// stored in a contiguous array, in the very same order. Each entry
+// holds the instance, the SharedPath of it's occurrence and the
+// transformation & abutment box expressed in the owner Cell.
+//
+// The table is owned by the Cell and built on the first call to
+// Cell::getFlatOccurrenceTable(). Any change of the hierarchy below
+// the Cell (instance creation/deletion, transformation, placement or
+// master change, terminal netlist state or abutment box of a master)
+// discards it, it is then rebuilt on the next request.
+//
+// Once built, the table is read-only and can be shared between
+// threads. The build itself creates SharedPaths, it must be done
+// before going parallel.
+
+  class FlatOccurrenceTable {
+    public:
+      class Entry {
+        public:
+          inline                         Entry             ( Instance*, SharedPath*, const Transformation&, const Box& );
+          inline Instance*               getInstance       () const;
+          inline SharedPath*             getSharedPath     () const;
+          inline Path                    getPath           () const;
+                 Occurrence              getOccurrence     () const;
+          inline const Transformation&   getTransformation () const;
+          inline const Box&              getAbutmentBox    () const;
+        private:
+          Instance*       _instance;
+          SharedPath*     _sharedPath;
+          Transformation  _transformation;
+          Box             _abutmentBox;
+      };
+    public:
+      typedef  std::vector<Entry>::const_iterator  iterator;
+    public:
+      class Range {
+        public:
+          inline               Range      ( iterator begin, iterator end );
+          inline iterator      begin      () const;
+          inline iterator      end        () const;
+          inline bool          empty      () const;
+          inline size_t        size       () const;
+          inline const Entry&  operator[] ( size_t ) const;
+        private:
+          iterator  _begin;
+          iterator  _end;
+      };
+    public:
+                           FlatOccurrenceTable ( const Cell* );
+      inline const Cell*   getCell             () const;
+      inline size_t        size                () const;
+      inline iterator      begin               () const;
+      inline iterator      end                 () const;
+      inline const Entry&  operator[]          ( size_t ) const;
+             Range         getRange            ( const Instance* topInstance=NULL ) const;
+             std::string   _getTypeName        () const;
+             std::string   _getString          () const;
+             Record*       _getRecord          () const;
+    private:
+                           FlatOccurrenceTable ( const FlatOccurrenceTable& );
+      FlatOccurrenceTable& operator=           ( const FlatOccurrenceTable& );
+             void          _build              ();
+             void          _expand             ( const Path&, const Transformation&, const Cell* );
+    private:
+      typedef  std::pair<size_t,size_t>  Span;
+    private:
+      const Cell*                                  _cell;
+      std::vector<Entry>                           _entries;
+      size_t                                       _terminalsEnd;
+      std::unordered_map<const Instance*,Span>     _spans;
+  };
+
+
+  inline FlatOccurrenceTable::Entry::Entry ( Instance*             instance
+                                           , SharedPath*           sharedPath
+                                           , const Transformation& transformation
+                                           , const Box&            abutmentBox )
+    : _instance      (instance)
+    , _sharedPath    (sharedPath)
+    , _transformation(transformation)
+    , _abutmentBox   (abutmentBox)
+  { }
+
+  inline Instance*             FlatOccurrenceTable::Entry::getInstance       () const { return _instance; }
+  inline SharedPath*           FlatOccurrenceTable::Entry::getSharedPath     () const { return _sharedPath; }
+  inline Path                  FlatOccurrenceTable::Entry::getPath           () const { return Path(_sharedPath); }
+  inline const Transformation& FlatOccurrenceTable::Entry::getTransformation () const { return _transformation; }
+  inline const Box&            FlatOccurrenceTable::Entry::getAbutmentBox    () const { return _abutmentBox; }
+
+  inline FlatOccurrenceTable::Range::Range ( iterator begin, iterator end ) : _begin(begin), _end(end) { }
+  inline FlatOccurrenceTable::iterator  FlatOccurrenceTable::Range::begin      () const { return _begin; }
+  inline FlatOccurrenceTable::iterator  FlatOccurrenceTable::Range::end        () const { return _end; }
+  inline bool                           FlatOccurrenceTable::Range::empty      () const { return _begin == _end; }
+  inline size_t                         FlatOccurrenceTable::Range::size       () const { return _end - _begin; }
+  inline const FlatOccurrenceTable::Entry&
+                                        FlatOccurrenceTable::Range::operator[] ( size_t i ) const { return *(_begin+i); }
+
+  inline const Cell*                    FlatOccurrenceTable::getCell    () const { return _cell; }
+  inline size_t                         FlatOccurrenceTable::size       () const { return _entries.size(); }
+  inline FlatOccurrenceTable::iterator  FlatOccurrenceTable::begin      () const { return _entries.begin(); }
+  inline FlatOccurrenceTable::iterator  FlatOccurrenceTable::end        () const { return _entries.end(); }
+  inline const FlatOccurrenceTable::Entry&
+                                        FlatOccurrenceTable::operator[] ( size_t i ) const { return _entries[i]; }
+
+
+}  // Hurricane namespace.
+
+
+INSPECTOR_P_SUPPORT(Hurricane::FlatOccurrenceTable);
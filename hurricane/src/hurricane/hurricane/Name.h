@@ -19,6 +19,7 @@
 
 
 #pragma  once
+#include <string_view>
 #include "hurricane/Commons.h"
 #include "hurricane/Names.h"
 
@@ -37,6 +38,7 @@ class Name {
 
     private: static const Name _emptyName;
     public: static const Name& emptyName () { return _emptyName; };
+    public: static void reserve ( size_t count );
 
 // Attributes
 // **********
@@ -50,6 +52,7 @@ class Name {
 
     public: Name(const char* c);
     public: Name(const string& s);
+    public: Name(std::string_view s);
 
     public: Name(const Name& name);
 
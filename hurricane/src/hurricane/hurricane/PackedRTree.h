@@ -0,0 +1,120 @@
+// -*- C++ -*-
+//
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// This file is part of Hurricane.
+//
+// Hurricane is free software: you can redistribute it  and/or  modify
+// it under the terms of the GNU  Lesser  General  Public  License  as
+// published by the Free Software Foundation, either version 3 of  the
+// License, or (at your option) any later version.
+//
+// Hurricane is distributed in the hope that it will  be  useful,  but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHAN-
+// TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See  the  Lesser  GNU
+// General Public License for more details.
+//
+// You should have received a copy of the Lesser  GNU  General  Public
+// License along with Hurricane. If not, see
+//                                     <http://www.gnu.org/licenses/>.
+//
+// +-----------------------------------------------------------------+
+// |                  H U R R I C A N E                              |
+// |     V L S I   B a c k e n d   D a t a - B a s e                 |
+// |                                                                 |
+// |  Author      :                    Jean-Paul Chaput              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./hurricane/PackedRTree.h"                     |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include <cstdint>
+#include <vector>
+#include <unordered_set>
+#include <unordered_map>
+#include "hurricane/Box.h"
+#include "hurricane/Gos.h"
+
+
+namespace Hurricane {
+
+  class PackedRTree_GosUnder;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Hurricane::PackedRTree".
+//
+// Static R-tree packed along the Hilbert curve of the centers of the
+// Gos bounding boxes. All the nodes are stored in one array, level by
+// level, leaves first, so an area query only walks contiguous memory.
+//
+// The packed part is immutable. Insertions go into a small buffer,
+// scanned linearly by the queries, and removals are recorded in a set
+// of dead entries. When the buffers grow too large relative to the
+// packed part, flush() repacks the whole tree. So, loading a Cell only
+// fills the insertion buffer, and the bulk load is done once, on the
+// first query (or on Cell::materialize()).
+//
+// Used by a root QuadTree in place of it's own hierarchy when the owner
+// Cell is flagged Cell::Flags::RTreeIndex.
+
+  class PackedRTree {
+      friend class PackedRTree_GosUnder;
+    public:
+      static const size_t  NodeCapacity = 16;
+      static const size_t  MinBuffer    = 256;
+    public:
+                           PackedRTree  ();
+      inline size_t        size         () const;
+      inline bool          isEmpty      () const;
+      inline bool          isDirty      () const;
+             Gos           getGosUnder  ( const Box& area, DbU::Unit threshold=0 ) const;
+             void          build        ( const std::vector<Go*>& );
+             void          insert       ( Go*, const Box& );
+             void          remove       ( Go* );
+             void          flush        ();
+             void          clear        ();
+             std::string   _getTypeName () const;
+             std::string   _getString   () const;
+             Record*       _getRecord   () const;
+    private:
+      struct Item {
+        Box  _box;
+        Go*  _go;
+      };
+      struct Node {
+        Box       _box;
+        uint32_t  _first;
+        uint32_t  _count;
+      };
+    private:
+                           PackedRTree  ( const PackedRTree& );
+             PackedRTree&  operator=    ( const PackedRTree& );
+             void          _pack        ( std::vector<Item>& );
+    private:
+      std::vector<Item>                _items;
+      std::vector<Node>                _nodes;
+      size_t                           _leafCount;
+      std::unordered_set<Go*>          _removeds;
+      std::vector<Item>                _inserteds;
+      std::unordered_map<Go*,size_t>   _insertedIndexes;
+  };
+
+
+  inline size_t  PackedRTree::size    () const { return _items.size() - _removeds.size() + _inserteds.size(); }
+  inline bool    PackedRTree::isEmpty () const { return size() == 0; }
+
+  inline bool  PackedRTree::isDirty () const
+  {
+    size_t limit = _items.size() / 8;
+    if (limit < MinBuffer) limit = MinBuffer;
+    return (_inserteds.size() > limit) or (_removeds.size() > limit);
+  }
+
+
+}  // Hurricane namespace.
+
+
+INSPECTOR_P_SUPPORT(Hurricane::PackedRTree);
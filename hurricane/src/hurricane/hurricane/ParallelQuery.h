@@ -0,0 +1,175 @@
+// -*- C++ -*-
+//
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// This file is part of Hurricane.
+//
+// Hurricane is free software: you can redistribute it  and/or  modify
+// it under the terms of the GNU  Lesser  General  Public  License  as
+// published by the Free Software Foundation, either version 3 of  the
+// License, or (at your option) any later version.
+//
+// Hurricane is distributed in the hope that it will  be  useful,  but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHAN-
+// TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See  the  Lesser  GNU
+// General Public License for more details.
+//
+// You should have received a copy of the Lesser  GNU  General  Public
+// License along with Hurricane. If not, see
+//                                     <http://www.gnu.org/licenses/>.
+//
+// +-----------------------------------------------------------------+
+// |                  H U R R I C A N E                              |
+// |     V L S I   B a c k e n d   D a t a - B a s e                 |
+// |                                                                 |
+// |  Author      :                    Jean-Paul Chaput              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./hurricane/ParallelQuery.h"                   |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include <atomic>
+#include <mutex>
+#include <limits>
+#include "hurricane/Query.h"
+
+
+namespace Hurricane {
+
+
+// -------------------------------------------------------------------
+// Class  :  "Hurricane::ParallelQuery".
+//
+// Read-only Query spread over a ThreadPool. The work is split into
+// independent tasks, each one run by it's own worker Query (hence it's
+// own QueryStack):
+//
+// 1. The objects of the top Cell itself, the area being possibly cut
+//    in tiles (setTiles()). An object overlapping several tiles is
+//    reported by one tile only.
+// 2. The sub-trees of the top level instances under the area, grouped
+//    in chunks of consecutive instances.
+//
+// The workers are supplied by newWorker(), which must return a fresh
+// Query holding it's own (thread local) result storage. Once all the
+// tasks are done, mergeWorker() is called on each worker, serially and
+// always in the same order: the tiles, then the instance chunks. With
+// one tile, this is the very order in which a plain Query would have
+// called the callbacks.
+//
+// Inside a worker, getPath() is the full path from the top Cell, but
+// getDepth() is counted from the top level instance.
+//
+// While a ParallelQuery is running, the database is read-only: any
+// creation, destruction or geometrical change of an object throws an
+// Error. The SharedPaths, which are only a cache, may still be created:
+// the lookup & creation in the SharedPathMap of an Instance is guarded
+// by a lock on that Instance only (striped over a fixed pool of mutexes),
+// so workers walking different instances never wait on each other.
+//
+// Other threaded readers of the database may use freeze() and a
+// ReadOnlyScope to get the same guarantees without a ParallelQuery.
+
+  class ParallelQuery {
+    public:
+      typedef Query::Mask  Mask;
+    public:
+    // Scoped lock on the SharedPathMap of one Instance, taken only while running.
+      class PathLock {
+        public:
+          inline  PathLock  ( const Instance* );
+          inline ~PathLock  ();
+        private:
+                  PathLock  ( const PathLock& );
+          PathLock& operator= ( const PathLock& );
+        private:
+          std::mutex* _mutex;
+      };
+    // Scoped read-only state, for threaded readers not using doQuery().
+      class ReadOnlyScope {
+        public:
+          inline  ReadOnlyScope  ();
+          inline ~ReadOnlyScope  ();
+        private:
+                  ReadOnlyScope  ( const ReadOnlyScope& );
+          ReadOnlyScope& operator= ( const ReadOnlyScope& );
+      };
+    public:
+      static  bool                  isRunning              ();
+      static  void                  checkReadOnly          ( const char* where );
+      static  std::mutex&           getPathMutex           ( const Instance* );
+      static  void                  freeze                 ( Cell* );
+    public:
+                                    ParallelQuery          ( size_t threads=1 );
+      virtual                      ~ParallelQuery          ();
+      inline  size_t                getThreads             () const;
+      inline  unsigned int          getTiles               () const;
+      virtual Query*                newWorker              () = 0;
+      virtual void                  mergeWorker            ( Query* ) = 0;
+              void                  setQuery               ( Cell*                 cell
+                                                           , const Box&            area
+                                                           , const Transformation& transformation
+                                                           , const BasicLayer*     basicLayer
+                                                           , ExtensionSlice::Mask  extensionMask
+                                                           , Mask                  filter
+                                                           , DbU::Unit             threshold=0
+                                                           );
+      inline  void                  setThreads             ( size_t );
+      inline  void                  setTiles               ( unsigned int columns, unsigned int rows );
+      inline  void                  setStartLevel          ( unsigned int level );
+      inline  void                  setStopLevel           ( unsigned int level );
+      inline  void                  setStopCellFlags       ( Cell::Flags );
+              void                  doQuery                ();
+    private:
+              void                  _setupWorker           ( Query*, Cell*, const Box&, const Transformation&, const Path& );
+    private:
+                                    ParallelQuery          ( const ParallelQuery& );
+              ParallelQuery&        operator=              ( const ParallelQuery& );
+    private:
+      static  std::atomic<unsigned int>  _running;
+    private:
+              size_t                _threads;
+              unsigned int          _columns;
+              unsigned int          _rows;
+              Cell*                 _cell;
+              Box                   _area;
+              Transformation        _transformation;
+              const BasicLayer*     _basicLayer;
+              ExtensionSlice::Mask  _extensionMask;
+              Mask                  _filter;
+              DbU::Unit             _threshold;
+              unsigned int          _startLevel;
+              unsigned int          _stopLevel;
+              Cell::Flags           _stopCellFlags;
+  };
+
+
+  inline ParallelQuery::PathLock::PathLock ( const Instance* instance )
+    : _mutex( (ParallelQuery::isRunning()) ? &ParallelQuery::getPathMutex(instance) : NULL )
+  { if (_mutex) _mutex->lock(); }
+
+  inline ParallelQuery::PathLock::~PathLock ()
+  { if (_mutex) _mutex->unlock(); }
+
+
+  inline ParallelQuery::ReadOnlyScope::ReadOnlyScope  () { ++ParallelQuery::_running; }
+  inline ParallelQuery::ReadOnlyScope::~ReadOnlyScope () { --ParallelQuery::_running; }
+
+
+  inline size_t        ParallelQuery::getThreads       () const { return _threads; }
+  inline unsigned int  ParallelQuery::getTiles         () const { return _columns*_rows; }
+  inline void          ParallelQuery::setThreads       ( size_t threads ) { _threads = threads; }
+  inline void          ParallelQuery::setStartLevel    ( unsigned int level ) { _startLevel = level; }
+  inline void          ParallelQuery::setStopLevel     ( unsigned int level ) { _stopLevel = level; }
+  inline void          ParallelQuery::setStopCellFlags ( Cell::Flags flags ) { _stopCellFlags = flags; }
+
+  inline void  ParallelQuery::setTiles ( unsigned int columns, unsigned int rows )
+  {
+    _columns = (columns) ? columns : 1;
+    _rows    = (rows   ) ? rows    : 1;
+  }
+
+
+}  // Hurricane namespace.
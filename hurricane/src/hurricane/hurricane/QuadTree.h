@@ -24,6 +24,8 @@
 
 namespace Hurricane {
 
+class PackedRTree;
+
 
 
 // ****************************************************************************************************
@@ -60,6 +62,7 @@ class QuadTree {
     private: QuadTree* _urChild; // Upper Right Child
     private: QuadTree* _llChild; // Lower Left Child
     private: QuadTree* _lrChild; // Lower Right Child
+    private: PackedRTree* _rtree; // Replaces the hierarchy (root only)
 
 // Constructors
 // ************
@@ -114,6 +117,10 @@ class QuadTree {
     public: QuadTree* _getNextQuadTree(const Box& area);
 
     public: bool _hasBeenExploded() const {return (_ulChild != NULL);};
+    public: PackedRTree* _getRTree() const {return _rtree;};
+    public: void _setRTreeIndex(bool state);
+    public: void _flushRTree();
+    public: void _freeze();
 
     public: void _explode();
     public: void _implode();
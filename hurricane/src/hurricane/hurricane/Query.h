@@ -112,6 +112,7 @@ namespace Hurricane {
       inline  Cell*                 getTopCell           ();
       inline  const Box&            getTopArea           () const;
       inline  const Transformation& getTopTransformation () const;
+      inline  const Path&           getTopPath           () const;
       inline  unsigned int          getStartLevel        () const;
       inline  unsigned int          getStopLevel         () const;
       inline  Cell::Flags           getStopCellFlags     () const;
@@ -126,6 +127,7 @@ namespace Hurricane {
       inline  void                  setTopCell           ( Cell*                 cell );
       inline  void                  setTopArea           ( const Box&            area );
       inline  void                  setTopTransformation ( const Transformation& transformation );
+      inline  void                  setTopPath           ( const Path&           path );
       inline  void                  setThreshold         ( DbU::Unit             threshold );
       inline  void                  setStartLevel        ( unsigned int          level );
       inline  void                  setStopLevel         ( unsigned int          level );
@@ -147,6 +149,7 @@ namespace Hurricane {
               Box                   _topArea;
               DbU::Unit             _threshold;
               Transformation        _topTransformation;
+              Path                  _topPath;
               unsigned int          _startLevel;
               unsigned int          _stopLevel;
               Cell::Flags           _stopCellFlags;
@@ -165,6 +168,7 @@ namespace Hurricane {
   inline  Cell*                 QueryStack::getTopCell           () { return _topCell; }
   inline  const Box&            QueryStack::getTopArea           () const { return _topArea; }
   inline  const Transformation& QueryStack::getTopTransformation () const { return _topTransformation; }
+  inline  const Path&           QueryStack::getTopPath           () const { return _topPath; }
   inline  DbU::Unit             QueryStack::getThreshold         () const { return _threshold; }
   inline  unsigned int          QueryStack::getStartLevel        () const { return _startLevel; }
   inline  unsigned int          QueryStack::getStopLevel         () const { return _stopLevel; }
@@ -194,6 +198,7 @@ namespace Hurricane {
   inline  void  QueryStack::setTopCell           ( Cell*                 cell )           { _topCell = cell; }
   inline  void  QueryStack::setTopArea           ( const Box&            area )           { _topArea = area; }
   inline  void  QueryStack::setTopTransformation ( const Transformation& transformation ) { _topTransformation = transformation; }
+  inline  void  QueryStack::setTopPath           ( const Path&           path )           { _topPath = path; }
   inline  void  QueryStack::setThreshold         ( DbU::Unit             threshold )      { _threshold = threshold; }
   inline  void  QueryStack::setStartLevel        ( unsigned int          level )          { _startLevel = level; }
   inline  void  QueryStack::setStopLevel         ( unsigned int          level )          { _stopLevel = level; }
@@ -206,7 +211,7 @@ namespace Hurricane {
     _instanceCount = 0;
     while (not empty()) levelUp();
 
-    push_back( new QueryState(NULL,_topArea,_topTransformation,Path()) );
+    push_back( new QueryState(NULL,_topArea,_topTransformation,_topPath) );
   //_tab++;
 
     progress( true );
@@ -369,6 +374,7 @@ namespace Hurricane {
       inline  void                  setArea                ( const Box&            area );
       inline  void                  setThreshold           ( DbU::Unit             threshold );
       inline  void                  setTransformation      ( const Transformation& transformation );
+      inline  void                  setTopPath             ( const Path&           path );
       virtual void                  setBasicLayer          ( const BasicLayer*     basicLayer );
       inline  void                  setExtensionMask       ( ExtensionSlice::Mask  mode );
       inline  void                  setFilter              ( Mask                  mode );
@@ -377,6 +383,9 @@ namespace Hurricane {
       inline  void                  setStopCellFlags       ( Cell::Flags );
       inline  void                  unsetStopCellFlags     ( Cell::Flags );
       virtual void                  doQuery                ();
+      inline  void                  _setTile               ( const Box& tiledArea, const Box& tile );
+    protected:
+      inline  bool                  _isOwned               ( const Go* ) const;
 
     protected:
     // Internal: Attributes.
@@ -384,6 +393,8 @@ namespace Hurricane {
               const BasicLayer*     _basicLayer;
               ExtensionSlice::Mask  _extensionMask;
               Mask                  _filter;
+              Box                   _tiledArea;
+              Box                   _tile;
   };
 
 
@@ -393,6 +404,8 @@ namespace Hurricane {
   inline  void  Query::setArea            ( const Box&            area )           { _stack.setTopArea(area); }
   inline  void  Query::setThreshold       ( DbU::Unit             threshold )      { _stack.setThreshold(threshold); }
   inline  void  Query::setTransformation  ( const Transformation& transformation ) { _stack.setTopTransformation(transformation); }
+  inline  void  Query::setTopPath         ( const Path&           path )           { _stack.setTopPath(path); }
+  inline  void  Query::_setTile           ( const Box& tiledArea, const Box& tile ) { _tiledArea = tiledArea; _tile = tile; }
   inline  void  Query::setFilter          ( Mask                  filter )         { _filter = filter; }
   inline  void  Query::setExtensionMask   ( ExtensionSlice::Mask  mask )           { _extensionMask = mask; }
   inline  void  Query::setStartLevel      ( unsigned int          level )          { _stack.setStartLevel(level); }
@@ -412,6 +425,25 @@ namespace Hurricane {
   inline  Cell*                 Query::getMasterCell      () { return _stack.getMasterCell(); }
   inline  Instance*             Query::getInstance        () { return _stack.getInstance(); }
 //inline const Tabulation&      Query::getTab             () const { return _stack.getTab(); }
+
+
+// When the top area is split in tiles (see ParallelQuery), an object
+// overlapping more than one tile belongs only to the one containing the
+// lower left corner of it's intersection with the whole area. The tiles
+// are half open, except on the right & top sides of the area.
+
+  inline bool  Query::_isOwned ( const Go* go ) const
+  {
+    if (_tile.isEmpty()) return true;
+
+    Box       bb = go->getBoundingBox();
+    DbU::Unit x = std::max( bb.getXMin(), _tiledArea.getXMin() );
+    DbU::Unit y = std::max( bb.getYMin(), _tiledArea.getYMin() );
+    if ((x < _tile.getXMin()) or (y < _tile.getYMin())) return false;
+    if ((x >= _tile.getXMax()) and (_tile.getXMax() < _tiledArea.getXMax())) return false;
+    if ((y >= _tile.getYMax()) and (_tile.getYMax() < _tiledArea.getYMax())) return false;
+    return true;
+  }
   
 
 } // Hurricane namespace.
@@ -0,0 +1,397 @@
+// -*- C++ -*-
+//
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// This file is part of Hurricane.
+//
+// Hurricane is free software: you can redistribute it  and/or  modify
+// it under the terms of the GNU  Lesser  General  Public  License  as
+// published by the Free Software Foundation, either version 3 of  the
+// License, or (at your option) any later version.
+//
+// Hurricane is distributed in the hope that it will  be  useful,  but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHAN-
+// TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See  the  Lesser  GNU
+// General Public License for more details.
+//
+// You should have received a copy of the Lesser  GNU  General  Public
+// License along with Hurricane. If not, see
+//                                     <http://www.gnu.org/licenses/>.
+//
+// +-----------------------------------------------------------------+
+// |                  H U R R I C A N E                              |
+// |     V L S I   B a c k e n d   D a t a - B a s e                 |
+// |                                                                 |
+// |  Author      :                    Jean-Paul Chaput              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./hurricane/Ranges.h"                          |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "hurricane/QuadTree.h"
+
+
+namespace Hurricane {
+
+
+// -------------------------------------------------------------------
+// Ranges.
+//
+// Lightweight, non-virtual alternative to the Collection/Locator pair
+// for range-for loops over the intrusive containers. The iterators are
+// plain values living on the stack: no Locator is allocated, cloned or
+// called through the vtable. The Collection API is left untouched, the
+// ranges are only offered side by side by the owners of the containers
+// (Cell::getNetRange(), Net::getComponentRange(), ...).
+//
+// The same restriction than for the Locators applies: the underlying
+// container must not be modified while it is walked.
+
+
+// -------------------------------------------------------------------
+// Class  :  "Hurricane::IntrusiveRange".
+//
+// Walks the buckets of an IntrusiveMap, IntrusiveMapConst or IntrusiveSet.
+// <Set> must be the *concrete* container type, so the link to the next
+// element of a bucket is obtained through a qualified, hence direct,
+// call to Set::_getNextElement().
+
+  template< typename Set >
+  class IntrusiveRange {
+    public:
+      typedef  typename std::remove_reference<decltype(std::declval<const Set&>()._getArray()[0])>::type  value_type;
+    public:
+      class iterator {
+        public:
+          inline             iterator   ( const Set* );
+          inline value_type  operator*  () const;
+          inline iterator&   operator++ ();
+          inline bool        operator== ( const iterator& ) const;
+          inline bool        operator!= ( const iterator& ) const;
+        private:
+          inline void        _nextBucket ();
+        private:
+          const Set*  _set;
+          unsigned    _index;
+          value_type  _element;
+      };
+    public:
+      inline           IntrusiveRange ( const Set& );
+      inline iterator  begin          () const;
+      inline iterator  end            () const;
+      inline bool      empty          () const;
+    private:
+      const Set* _set;
+  };
+
+
+  template< typename Set >
+  inline IntrusiveRange<Set>::iterator::iterator ( const Set* set )
+    : _set    (set)
+    , _index  (0)
+    , _element(NULL)
+  { if (_set) _nextBucket(); }
+
+
+  template< typename Set >
+  inline void  IntrusiveRange<Set>::iterator::_nextBucket ()
+  {
+    unsigned    length = _set->_getLength();
+    value_type* array  = _set->_getArray();
+    while ( not _element and (_index < length) ) _element = array[_index++];
+  }
+
+
+  template< typename Set >
+  inline typename IntrusiveRange<Set>::value_type  IntrusiveRange<Set>::iterator::operator* () const
+  { return _element; }
+
+
+  template< typename Set >
+  inline typename IntrusiveRange<Set>::iterator& IntrusiveRange<Set>::iterator::operator++ ()
+  {
+    _element = _set->Set::_getNextElement( _element );
+    if (not _element) _nextBucket();
+    return *this;
+  }
+
+
+  template< typename Set >
+  inline bool  IntrusiveRange<Set>::iterator::operator== ( const iterator& other ) const
+  { return _element == other._element; }
+
+
+  template< typename Set >
+  inline bool  IntrusiveRange<Set>::iterator::operator!= ( const iterator& other ) const
+  { return _element != other._element; }
+
+
+  template< typename Set >
+  inline IntrusiveRange<Set>::IntrusiveRange ( const Set& set ) : _set(&set) { }
+
+  template< typename Set >
+  inline typename IntrusiveRange<Set>::iterator  IntrusiveRange<Set>::begin () const { return iterator(_set); }
+
+  template< typename Set >
+  inline typename IntrusiveRange<Set>::iterator  IntrusiveRange<Set>::end () const { return iterator(NULL); }
+
+  template< typename Set >
+  inline bool  IntrusiveRange<Set>::empty () const { return _set->isEmpty(); }
+
+
+// -------------------------------------------------------------------
+// Class  :  "Hurricane::QuadTreeRange".
+//
+// Walks all the Gos of a QuadTree, node after node, in the same order
+// than QuadTree::getGos().
+
+  class QuadTreeRange {
+    public:
+      typedef  Go*                            value_type;
+      typedef  IntrusiveRange<QuadTree::GoSet>  GoRange;
+    public:
+      class iterator {
+        public:
+          inline             iterator   ( QuadTree* );
+          inline Go*         operator*  () const;
+          inline iterator&   operator++ ();
+          inline bool        operator== ( const iterator& ) const;
+          inline bool        operator!= ( const iterator& ) const;
+        private:
+          QuadTree*          _quadTree;
+          GoRange::iterator  _goIterator;
+      };
+    public:
+      inline           QuadTreeRange ( const QuadTree& );
+      inline iterator  begin         () const;
+      inline iterator  end           () const;
+      inline bool      empty         () const;
+    private:
+      const QuadTree* _root;
+  };
+
+
+  inline QuadTreeRange::iterator::iterator ( QuadTree* quadTree )
+    : _quadTree  (quadTree)
+    , _goIterator(quadTree ? &quadTree->_getGoSet() : NULL)
+  { }
+
+
+  inline Go* QuadTreeRange::iterator::operator* () const
+  { return *_goIterator; }
+
+
+  inline QuadTreeRange::iterator& QuadTreeRange::iterator::operator++ ()
+  {
+    ++_goIterator;
+    if (not *_goIterator) {
+      _quadTree = _quadTree->_getNextQuadTree();
+      if (_quadTree) _goIterator = GoRange::iterator( &_quadTree->_getGoSet() );
+    }
+    return *this;
+  }
+
+
+  inline bool  QuadTreeRange::iterator::operator== ( const iterator& other ) const
+  { return *_goIterator == *other._goIterator; }
+
+
+  inline bool  QuadTreeRange::iterator::operator!= ( const iterator& other ) const
+  { return *_goIterator != *other._goIterator; }
+
+
+  inline                          QuadTreeRange::QuadTreeRange ( const QuadTree& root ) : _root(&root) { }
+  inline QuadTreeRange::iterator  QuadTreeRange::begin         () const { return iterator(_root->_getFirstQuadTree()); }
+  inline QuadTreeRange::iterator  QuadTreeRange::end           () const { return iterator(NULL); }
+  inline bool                     QuadTreeRange::empty         () const { return _root->isEmpty(); }
+
+
+// -------------------------------------------------------------------
+// Class  :  "Hurricane::FilteredRange".
+//
+// Skips the elements of <Range> for which <Predicate> returns false.
+// Counterpart of Collection::getSubSet(Filter).
+
+  template< typename Range, typename Predicate >
+  class FilteredRange {
+    public:
+      typedef  typename Range::value_type  value_type;
+      typedef  typename Range::iterator    BaseIterator;
+    public:
+      class iterator {
+        public:
+          inline             iterator   ( BaseIterator, BaseIterator, const Predicate* );
+          inline value_type  operator*  () const;
+          inline iterator&   operator++ ();
+          inline bool        operator== ( const iterator& ) const;
+          inline bool        operator!= ( const iterator& ) const;
+        private:
+          inline void        _skip      ();
+        private:
+          BaseIterator      _current;
+          BaseIterator      _end;
+          const Predicate*  _predicate;
+      };
+    public:
+      inline           FilteredRange ( const Range&, Predicate );
+      inline iterator  begin         () const;
+      inline iterator  end           () const;
+    private:
+      Range      _range;
+      Predicate  _predicate;
+  };
+
+
+  template< typename Range, typename Predicate >
+  inline FilteredRange<Range,Predicate>::iterator::iterator ( BaseIterator current, BaseIterator end, const Predicate* predicate )
+    : _current  (current)
+    , _end      (end)
+    , _predicate(predicate)
+  { _skip(); }
+
+
+  template< typename Range, typename Predicate >
+  inline void  FilteredRange<Range,Predicate>::iterator::_skip ()
+  { while ( (_current != _end) and not (*_predicate)(*_current) ) ++_current; }
+
+
+  template< typename Range, typename Predicate >
+  inline typename FilteredRange<Range,Predicate>::value_type  FilteredRange<Range,Predicate>::iterator::operator* () const
+  { return *_current; }
+
+
+  template< typename Range, typename Predicate >
+  inline typename FilteredRange<Range,Predicate>::iterator& FilteredRange<Range,Predicate>::iterator::operator++ ()
+  { ++_current; _skip(); return *this; }
+
+
+  template< typename Range, typename Predicate >
+  inline bool  FilteredRange<Range,Predicate>::iterator::operator== ( const iterator& other ) const
+  { return _current == other._current; }
+
+
+  template< typename Range, typename Predicate >
+  inline bool  FilteredRange<Range,Predicate>::iterator::operator!= ( const iterator& other ) const
+  { return _current != other._current; }
+
+
+  template< typename Range, typename Predicate >
+  inline FilteredRange<Range,Predicate>::FilteredRange ( const Range& range, Predicate predicate )
+    : _range    (range)
+    , _predicate(predicate)
+  { }
+
+
+  template< typename Range, typename Predicate >
+  inline typename FilteredRange<Range,Predicate>::iterator  FilteredRange<Range,Predicate>::begin () const
+  { return iterator( _range.begin(), _range.end(), &_predicate ); }
+
+
+  template< typename Range, typename Predicate >
+  inline typename FilteredRange<Range,Predicate>::iterator  FilteredRange<Range,Predicate>::end () const
+  { return iterator( _range.end(), _range.end(), &_predicate ); }
+
+
+  template< typename Range, typename Predicate >
+  inline FilteredRange<Range,Predicate>  filter ( const Range& range, Predicate predicate )
+  { return FilteredRange<Range,Predicate>( range, predicate ); }
+
+
+// -------------------------------------------------------------------
+// Class  :  "Hurricane::SubTypeRange".
+//
+// Only the elements of <Range> that are of type <SubType> (a pointer
+// type), already casted. Counterpart of SubTypeCollection.
+
+  template< typename SubType, typename Range >
+  class SubTypeRange {
+    public:
+      typedef  SubType                   value_type;
+      typedef  typename Range::iterator  BaseIterator;
+    public:
+      class iterator {
+        public:
+          inline             iterator   ( BaseIterator, BaseIterator );
+          inline SubType     operator*  () const;
+          inline iterator&   operator++ ();
+          inline bool        operator== ( const iterator& ) const;
+          inline bool        operator!= ( const iterator& ) const;
+        private:
+          inline void        _skip      ();
+        private:
+          BaseIterator  _current;
+          BaseIterator  _end;
+          SubType       _element;
+      };
+    public:
+      inline           SubTypeRange ( const Range& );
+      inline iterator  begin        () const;
+      inline iterator  end          () const;
+    private:
+      Range  _range;
+  };
+
+
+  template< typename SubType, typename Range >
+  inline SubTypeRange<SubType,Range>::iterator::iterator ( BaseIterator current, BaseIterator end )
+    : _current(current)
+    , _end    (end)
+    , _element(NULL)
+  { _skip(); }
+
+
+  template< typename SubType, typename Range >
+  inline void  SubTypeRange<SubType,Range>::iterator::_skip ()
+  {
+    _element = NULL;
+    while ( _current != _end ) {
+      _element = dynamic_cast<SubType>( *_current );
+      if (_element) break;
+      ++_current;
+    }
+  }
+
+
+  template< typename SubType, typename Range >
+  inline SubType  SubTypeRange<SubType,Range>::iterator::operator* () const
+  { return _element; }
+
+
+  template< typename SubType, typename Range >
+  inline typename SubTypeRange<SubType,Range>::iterator& SubTypeRange<SubType,Range>::iterator::operator++ ()
+  { ++_current; _skip(); return *this; }
+
+
+  template< typename SubType, typename Range >
+  inline bool  SubTypeRange<SubType,Range>::iterator::operator== ( const iterator& other ) const
+  { return _current == other._current; }
+
+
+  template< typename SubType, typename Range >
+  inline bool  SubTypeRange<SubType,Range>::iterator::operator!= ( const iterator& other ) const
+  { return _current != other._current; }
+
+
+  template< typename SubType, typename Range >
+  inline SubTypeRange<SubType,Range>::SubTypeRange ( const Range& range ) : _range(range) { }
+
+  template< typename SubType, typename Range >
+  inline typename SubTypeRange<SubType,Range>::iterator  SubTypeRange<SubType,Range>::begin () const
+  { return iterator( _range.begin(), _range.end() ); }
+
+  template< typename SubType, typename Range >
+  inline typename SubTypeRange<SubType,Range>::iterator  SubTypeRange<SubType,Range>::end () const
+  { return iterator( _range.end(), _range.end() ); }
+
+
+  template< typename SubType, typename Range >
+  inline SubTypeRange<SubType,Range>  subType ( const Range& range )
+  { return SubTypeRange<SubType,Range>( range ); }
+
+
+}  // Hurricane namespace.
@@ -20,6 +20,8 @@
 #ifndef HURRICANE_SHARED_NAME
 #define HURRICANE_SHARED_NAME
 
+#include <atomic>
+#include <string_view>
 #include "hurricane/Commons.h"
 
 namespace Hurricane {
@@ -27,12 +29,25 @@ namespace Hurricane {
 
 // -------------------------------------------------------------------
 // Class  :  "Hurricane::SharedName".
+//
+// The interned strings of the Names, reference counted. They are kept
+// in one open-addressing hash table, looked up by std::string_view, so
+// no string is built to find an existing name. The table is guarded by
+// a shared mutex: lookups of existing names run concurrently, only the
+// creation of a new name or the destruction of the last reference to
+// one takes the exclusive lock. The last reference is always dropped
+// under that lock, so a concurrent lookup cannot revive a dying name.
+//
+// Importers may call reserve() with the number of names they are about
+// to create, to avoid the successive rehashes of the table.
 
 
   class SharedName {
       friend class Name;
     public:
       static void           dump         ();
+      static void           reserve      ( size_t count );
+      static size_t         getCount     ();
     public:
       inline unsigned long  getHash      () const;
              const string&  _getSString  () const { return _string; };
@@ -40,7 +55,9 @@ namespace Hurricane {
              string         _getString   () const;
              Record*        _getRecord   () const;
     private:               
-                            SharedName   ( const string& );
+      static SharedName*    intern       ( std::string_view );
+      static unsigned long  computeHash  ( std::string_view );
+                            SharedName   ( std::string_view, unsigned long hash );
                             SharedName   ( const SharedName& );
                            ~SharedName   ();
              SharedName&    operator=    ( const SharedName& );
@@ -48,16 +65,13 @@ namespace Hurricane {
              void           release      ();
 
     private:
-      struct SharedNameMapComparator {
-          bool operator() ( string* lhs, string* rhs ) const;
-      };
-      typedef  map<string*, SharedName*, SharedNameMapComparator>  SharedNameMap;
+      class Table;
+      static Table&         _getTable    ();
 
     private:
-      static SharedNameMap* _SHARED_NAME_MAP;
-             unsigned long  _hash;
-             int            _count;
-             string         _string;
+             unsigned long     _hash;
+             std::atomic<int>  _count;
+             string            _string;
   };
 
 
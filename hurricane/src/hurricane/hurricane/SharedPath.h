@@ -81,6 +81,7 @@ namespace Hurricane {
              Instances      getInstances      () const;
              Transformation getTransformation ( const Transformation& transformation=Transformation() ) const;
     public:
+      static SharedPath*    _getOrCreate                    ( Instance* headInstance, SharedPath* tailSharedPath );
              std::string    _getTypeName                    () const;
              std::string    _getString                      () const;
              Record*        _getRecord                      () const;
@@ -19,6 +19,7 @@
 
 #pragma  once
 #include "hurricane/QuadTree.h"
+#include "hurricane/Ranges.h"
 #include "hurricane/Components.h"
 #include "hurricane/Markers.h"
 #include "hurricane/Transformation.h"
@@ -72,6 +73,7 @@ class Slice {
     public: Gos getGos() const {return _quadTree.getGos();};
     public: Gos getGosUnder(const Box& area, DbU::Unit threshold=0) const {return _quadTree.getGosUnder(area,threshold);};
     public: Components getComponents() const;
+    public: SubTypeRange<Component*,QuadTreeRange> getComponentRange() const {return SubTypeRange<Component*,QuadTreeRange>(QuadTreeRange(_quadTree));};
     public: Components getComponentsUnder(const Box& area, DbU::Unit threshold=0) const;
     public: Markers getMarkers() const;
     public: Markers getMarkersUnder(const Box& area) const;
@@ -0,0 +1,104 @@
+// -*- C++ -*-
+//
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// This file is part of Hurricane.
+//
+// Hurricane is free software: you can redistribute it  and/or  modify
+// it under the terms of the GNU  Lesser  General  Public  License  as
+// published by the Free Software Foundation, either version 3 of  the
+// License, or (at your option) any later version.
+//
+// Hurricane is distributed in the hope that it will  be  useful,  but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHAN-
+// TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See  the  Lesser  GNU
+// General Public License for more details.
+//
+// You should have received a copy of the Lesser  GNU  General  Public
+// License along with Hurricane. If not, see
+//                                     <http://www.gnu.org/licenses/>.
+//
+// +-----------------------------------------------------------------+
+// |                  H U R R I C A N E                              |
+// |     V L S I   B a c k e n d   D a t a - B a s e                 |
+// |                                                                 |
+// |  Author      :                    Jean-Paul Chaput              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./hurricane/ThreadPool.h"                      |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <string>
+
+
+namespace Hurricane {
+
+
+// -------------------------------------------------------------------
+// Class  :  "Hurricane::ThreadPool".
+//
+// Minimal fixed size pool of worker threads. The only supported work
+// pattern is a blocking "parallel for" over a range of indexes, which
+// is what all the engines need. The calling thread participates as
+// worker zero, so a pool of size one spawns no thread at all and runs
+// strictly sequentially.
+//
+// The pool is *not* a license to touch the database concurrently: the
+// callers are responsible of only doing read-only or disjoint accesses
+// inside <run()>.
+
+  class ThreadPool {
+    public:
+      typedef std::function< void(size_t index, size_t thread) >  Task;
+    public:
+      static        size_t       getHardwareThreads ();
+    public:
+                                 ThreadPool         ( size_t threads=1 );
+                                ~ThreadPool         ();
+      inline        size_t       size               () const;
+                    void         run                ( size_t count, Task );
+      inline        double       getBusyTime        ( size_t thread ) const;
+      inline        double       getWallTime        () const;
+                    double       getUtilization     ( size_t thread ) const;
+                    void         resetStats         ();
+                    std::string  getStringUtilization () const;
+    private:
+                    void         _work              ( size_t thread );
+                    void         _drain             ( size_t thread );
+    private:
+                                 ThreadPool         ( const ThreadPool& );
+                    ThreadPool&  operator=          ( const ThreadPool& );
+    private:
+      std::vector<std::thread>  _threads;
+      std::mutex                _mutex;
+      std::condition_variable   _wakeup;
+      std::condition_variable   _done;
+      Task                      _task;
+      size_t                    _count;
+      std::atomic<size_t>       _next;
+      size_t                    _running;
+      uint64_t                  _generation;
+      bool                      _terminate;
+      std::exception_ptr        _exception;
+      std::vector<double>       _busyTimes;
+      double                    _wallTime;
+  };
+
+
+  inline size_t  ThreadPool::size        () const { return _threads.size() + 1; }
+  inline double  ThreadPool::getBusyTime ( size_t thread ) const { return (thread < _busyTimes.size()) ? _busyTimes[thread] : 0.0; }
+  inline double  ThreadPool::getWallTime () const { return _wallTime; }
+
+
+}  // Hurricane namespace.
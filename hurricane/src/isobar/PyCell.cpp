@@ -809,6 +809,7 @@ extern "C" {
   DirectGetBoolAttribute(PyCell_isFeed             , isFeed             ,PyCell,Cell)
   DirectGetBoolAttribute(PyCell_isDiode            , isDiode            ,PyCell,Cell)
   DirectGetBoolAttribute(PyCell_isPowerFeed        , isPowerFeed        ,PyCell,Cell)
+  DirectGetBoolAttribute(PyCell_isRTreeIndexed     , isRTreeIndexed     ,PyCell,Cell)
   DirectGetBoolAttribute(PyCell_updatePlacedFlag   , updatePlacedFlag   ,PyCell,Cell)
 //DirectGetLongAttribute(PyCell_getFlags           , getFlags           ,PyCell,Cell)
   DirectSetBoolAttribute(PyCell_setRouted          , setRouted          ,PyCell,Cell)
@@ -816,6 +817,7 @@ extern "C" {
   DirectSetBoolAttribute(PyCell_setFeed            , setFeed            ,PyCell,Cell)
   DirectSetBoolAttribute(PyCell_setDiode           , setDiode           ,PyCell,Cell)
   DirectSetBoolAttribute(PyCell_setPowerFeed       , setPowerFeed       ,PyCell,Cell)
+  DirectSetBoolAttribute(PyCell_setRTreeIndex      , setRTreeIndex      ,PyCell,Cell)
   DirectSetLongAttribute(PyCell_setFlags           , setFlags           ,PyCell,Cell)
   DirectSetLongAttribute(PyCell_resetFlags         , resetFlags         ,PyCell,Cell)
                                                    
@@ -864,6 +866,7 @@ extern "C" {
     , { "isFeed"              , (PyCFunction)PyCell_isFeed              , METH_NOARGS , "Returns true if the cell is flagged as feed (filler cell)." }
     , { "isDiode"             , (PyCFunction)PyCell_isDiode             , METH_NOARGS , "Returns true if the cell is flagged as diode." }
     , { "isPowerFeed"         , (PyCFunction)PyCell_isPowerFeed         , METH_NOARGS , "Returns true if the cell is flagged as power rail element." }
+    , { "isRTreeIndexed"      , (PyCFunction)PyCell_isRTreeIndexed      , METH_NOARGS , "Returns true if the cell spatial index is a packed R-tree." }
     , { "isBound"             , (PyCFunction)PyCell_isPyBound           , METH_NOARGS , "Returns true if the cell is bounded to the hurricane cell" }    
     , { "setFlags"            , (PyCFunction)PyCell_setFlags            , METH_VARARGS, "Set state flags." }
     , { "resetFlags"          , (PyCFunction)PyCell_resetFlags          , METH_VARARGS, "Reset state flags." }
@@ -877,6 +880,7 @@ extern "C" {
     , { "setFeed"             , (PyCFunction)PyCell_setFeed             , METH_VARARGS, "Sets/reset the cell feed (filler cell) flag." }
     , { "setDiode"            , (PyCFunction)PyCell_setDiode            , METH_VARARGS, "Sets/reset the cell diode flag." }
     , { "setPowerFeed"        , (PyCFunction)PyCell_setPowerFeed        , METH_VARARGS, "Sets/reset the cell power rail element flag." }
+    , { "setRTreeIndex"       , (PyCFunction)PyCell_setRTreeIndex       , METH_VARARGS, "Use a packed R-tree instead of the QuadTree as spatial index." }
     , { "uniquify"            , (PyCFunction)PyCell_uniquify            , METH_VARARGS, "Uniquify the Cell and it's instances up to <depth>." }
     , { "getClone"            , (PyCFunction)PyCell_getClone            , METH_NOARGS , "Return a copy of the Cell (placement only)." }
     , { "flattenNets"         , (PyCFunction)PyCell_flattenNets         , METH_VARARGS, "Perform a virtual flatten, possibly limited to one instance." }
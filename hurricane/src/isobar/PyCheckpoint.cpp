@@ -0,0 +1,171 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |    I s o b a r  -  Hurricane / Python Interface                 |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :       "./PyCheckpoint.cpp"                       |
+// +-----------------------------------------------------------------+
+
+
+#include "hurricane/isobar/PyCheckpoint.h"
+#include "hurricane/isobar/PyCell.h"
+
+
+namespace  Isobar {
+
+using namespace Hurricane;
+
+extern "C" {
+
+
+#define  METHOD_HEAD(function)  GENERIC_METHOD_HEAD(Checkpoint,checkpoint,function)
+
+
+// +=================================================================+
+// |             "PyCheckpoint" Python Module Code Part              |
+// +=================================================================+
+
+#if defined(__PYTHON_MODULE__)
+
+
+  static void PyCheckpoint_DeAlloc ( PyCheckpoint* self )
+  {
+    cdebug_log(20,0) << "PyCheckpoint_DeAlloc(" << hex << self << ")" << endl;
+  }
+
+
+  static PyObject* PyCheckpoint_save ( PyObject*, PyObject* args )
+  {
+    cdebug_log(20,0) << "PyCheckpoint_save()" << endl;
+
+    HTRY
+    char*     path   = NULL;
+    PyObject* pyCell = NULL;
+    if (not PyArg_ParseTuple(args,"s|O:Checkpoint.save",&path,&pyCell)) {
+      PyErr_SetString( ConstructorError, "Bad parameters given to Checkpoint.save()." );
+      return NULL;
+    }
+    Cell* topCell = NULL;
+    if (pyCell and (pyCell != Py_None)) {
+      if (not IsPyCell(pyCell)) {
+        PyErr_SetString( ConstructorError, "Checkpoint.save(): Second argument is not a Cell." );
+        return NULL;
+      }
+      topCell = PYCELL_O( pyCell );
+    }
+    Checkpoint::save( path, topCell );
+    HCATCH
+
+    Py_RETURN_NONE;
+  }
+
+
+  static PyObject* PyCheckpoint_load ( PyObject*, PyObject* args )
+  {
+    cdebug_log(20,0) << "PyCheckpoint_load()" << endl;
+
+    Cell* topCell = NULL;
+    HTRY
+    char* path = NULL;
+    if (not PyArg_ParseTuple(args,"s:Checkpoint.load",&path)) {
+      PyErr_SetString( ConstructorError, "Bad parameters given to Checkpoint.load()." );
+      return NULL;
+    }
+    topCell = Checkpoint::load( path );
+    HCATCH
+
+    return PyCell_Link( topCell );
+  }
+
+
+  static PyObject* PyCheckpoint_getCell ( PyObject*, PyObject* args )
+  {
+    cdebug_log(20,0) << "PyCheckpoint_getCell()" << endl;
+
+    Cell* cell = NULL;
+    HTRY
+    char* name = NULL;
+    if (not PyArg_ParseTuple(args,"s:Checkpoint.getCell",&name)) {
+      PyErr_SetString( ConstructorError, "Bad parameters given to Checkpoint.getCell()." );
+      return NULL;
+    }
+    Checkpoint* checkpoint = Checkpoint::getCurrent();
+    if (not checkpoint) {
+      PyErr_SetString( HurricaneError, "Checkpoint.getCell(): No checkpoint is loaded." );
+      return NULL;
+    }
+    cell = checkpoint->getCell( name );
+    HCATCH
+
+    return PyCell_Link( cell );
+  }
+
+
+  static PyObject* PyCheckpoint_materializeAll ( PyObject* )
+  {
+    cdebug_log(20,0) << "PyCheckpoint_materializeAll()" << endl;
+
+    HTRY
+    Checkpoint* checkpoint = Checkpoint::getCurrent();
+    if (checkpoint) checkpoint->materializeAll();
+    HCATCH
+
+    Py_RETURN_NONE;
+  }
+
+
+  static PyObject* PyCheckpoint_close ( PyObject* )
+  {
+    cdebug_log(20,0) << "PyCheckpoint_close()" << endl;
+
+    HTRY
+    Checkpoint::close();
+    HCATCH
+
+    Py_RETURN_NONE;
+  }
+
+
+  PyMethodDef PyCheckpoint_Methods[] =
+    { { "save"          , (PyCFunction)PyCheckpoint_save          , METH_VARARGS|METH_CLASS
+                        , "Save the whole DataBase in a binary checkpoint (path [,topCell])." }
+    , { "load"          , (PyCFunction)PyCheckpoint_load          , METH_VARARGS|METH_CLASS
+                        , "Map a checkpoint and return it's top Cell (other Cells are loaded on demand)." }
+    , { "getCell"       , (PyCFunction)PyCheckpoint_getCell       , METH_VARARGS|METH_CLASS
+                        , "Return (and materialize) a Cell of the currently loaded checkpoint." }
+    , { "materializeAll", (PyCFunction)PyCheckpoint_materializeAll, METH_NOARGS|METH_CLASS
+                        , "Materialize all the Cells of the currently loaded checkpoint." }
+    , { "close"         , (PyCFunction)PyCheckpoint_close         , METH_NOARGS|METH_CLASS
+                        , "Unmap the currently loaded checkpoint (the Cells are kept)." }
+    , {NULL, NULL, 0, NULL}  /* sentinel */
+    };
+
+
+  PyTypeObjectLinkPyTypeWithoutObject(Checkpoint,Checkpoint)
+
+
+#else  // End of Python Module Code Part.
+
+
+// +=================================================================+
+// |             "PyCheckpoint" Shared Library Code Part             |
+// +=================================================================+
+
+
+  PyTypeObjectDefinitions(Checkpoint)
+
+
+# endif  // End of Shared Library Code Part.
+
+
+}  // End of extern "C".
+
+
+}  // End of Isobar namespace.
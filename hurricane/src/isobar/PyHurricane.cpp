@@ -18,6 +18,7 @@
 #include "hurricane/isobar/PyBreakpoint.h"
 #include "hurricane/isobar/PyDebugSession.h"
 #include "hurricane/isobar/PyUpdateSession.h"
+#include "hurricane/isobar/PyCheckpoint.h"
 #include "hurricane/isobar/PyDbU.h"
 #include "hurricane/isobar/PyPoint.h"
 #include "hurricane/isobar/PyPointCollection.h"
@@ -540,6 +541,7 @@ extern "C" {
 
     PyDebugSession_LinkPyType ();
     PyUpdateSession_LinkPyType ();
+    PyCheckpoint_LinkPyType ();
     PyDbU_LinkPyType ();
     PyPoint_LinkPyType ();
     PyPointCollection_LinkPyType ();
@@ -620,6 +622,7 @@ extern "C" {
     PYTYPE_READY( DebugSession                  )
     PYTYPE_READY( DebugSession                  )
     PYTYPE_READY( UpdateSession                 )
+    PYTYPE_READY( Checkpoint                    )
     PYTYPE_READY( DbU                           )
     PYTYPE_READY( Point                         )
     PYTYPE_READY( PointCollection               )
@@ -846,6 +849,8 @@ extern "C" {
     PyModule_AddObject ( module, "DebugSession"         , (PyObject*)&PyTypeDebugSession );
     Py_INCREF ( &PyTypeUpdateSession );
     PyModule_AddObject ( module, "UpdateSession"        , (PyObject*)&PyTypeUpdateSession );
+    Py_INCREF ( &PyTypeCheckpoint );
+    PyModule_AddObject ( module, "Checkpoint"           , (PyObject*)&PyTypeCheckpoint );
     Py_INCREF ( &PyTypeBreakpoint );
     PyModule_AddObject ( module, "Breakpoint"           , (PyObject*)&PyTypeBreakpoint );
     Py_INCREF ( &PyTypeQuery );
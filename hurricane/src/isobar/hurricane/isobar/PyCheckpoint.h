@@ -0,0 +1,49 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |    I s o b a r  -  Hurricane / Python Interface                 |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./hurricane/isobar/PyCheckpoint.h"             |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include "hurricane/isobar/PyHurricane.h"
+#include "hurricane/Checkpoint.h"
+
+
+namespace  Isobar {
+
+  extern "C" {
+
+// -------------------------------------------------------------------
+// Python Object  :  "PyCheckpoint".
+
+    typedef struct {
+        PyObject_HEAD
+    } PyCheckpoint;
+
+
+// -------------------------------------------------------------------
+// Functions & Types exported to "PyHurricane.cpp".
+
+    extern PyTypeObject  PyTypeCheckpoint;
+    extern PyMethodDef   PyCheckpoint_Methods[];
+
+    extern void  PyCheckpoint_LinkPyType  ();
+
+
+#define IsPyCheckpoint(v)   ( (v)->ob_type == &PyTypeCheckpoint )
+#define PYCHECKPOINT(v)     ( (PyCheckpoint*)(v) )
+
+
+  }  // extern "C".
+
+}  // Isobar namespace.
@@ -37,6 +37,7 @@
 #include "hurricane/DataBase.h"
 #include "hurricane/Library.h"
 #include "hurricane/Cell.h"
+#include "hurricane/Checkpoint.h"
 //#include  "MapView.h"
 #include "hurricane/isobar/PyCell.h"
 #include "hurricane/isobar/Script.h"
@@ -456,6 +457,20 @@ namespace Hurricane {
                       , QIcon(":/images/stock_save.png")
                       );
     connect( action, SIGNAL(triggered()), this, SLOT(saveDesignBlob()) );
+    action = addToMenu( "file.openCheckpoint"
+                      , tr("Open &Checkpoint")
+                      , tr("Map a binary checkpoint of the Hurricane DataBase (Cells loaded on demand)")
+                      , QKeySequence()
+                      , QIcon(":/images/stock_open.png")
+                      );
+    connect( action, SIGNAL(triggered()), this, SLOT(openCheckpoint()) );
+    action = addToMenu( "file.saveCheckpoint"
+                      , tr("Save C&heckpoint")
+                      , tr("Save the whole Hurricane DataBase in a binary checkpoint")
+                      , QKeySequence()
+                      , QIcon(":/images/stock_save.png")
+                      );
+    connect( action, SIGNAL(triggered()), this, SLOT(saveCheckpoint()) );
     addToMenu( "file.========" );
 
     action = addToMenu( "file.importCell"
@@ -849,6 +864,31 @@ namespace Hurricane {
   }
 
 
+  void  CellViewer::openCheckpoint ()
+  {
+    QString checkpointName;
+    if (OpenBlobDialog::runDialog(this,checkpointName)) {
+      string fileName = checkpointName.toStdString() + ".ckpt";
+      Cell*  topCell  = NULL;
+
+      ExceptionWidget::catchAllWrapper( [&]() { topCell = Checkpoint::load( fileName ); } );
+
+      setCell ( topCell );
+      emit cellLoadedFromDisk( topCell );
+    }
+  }
+
+
+  void  CellViewer::saveCheckpoint ()
+  {
+    Cell* cell = getCell();
+    if (not cell) return;
+
+    string fileName = getString(cell->getName()) + ".ckpt";
+    ExceptionWidget::catchAllWrapper( [&]() { Checkpoint::save( fileName, cell ); } );
+  }
+
+
   void  CellViewer::select ( Occurrence& occurrence )
   { if ( _cellWidget ) _cellWidget->select ( occurrence ); }
 
@@ -152,6 +152,8 @@ namespace Hurricane {
               void                  openHistoryCell           ();
               void                  openDesignBlob            ();
               void                  saveDesignBlob            ();
+              void                  openCheckpoint            ();
+              void                  saveCheckpoint            ();
               void                  printDisplay              ();
               void                  print                     ( QPrinter* );
               void                  imageDisplay              ();
@@ -42,6 +42,8 @@ namespace Katana {
     , _postEventCb         ()
     , _bloat               (Cfg::getParamString("etesian.bloat"               ,"disabled")->asString() )
     , _searchHalo          (Cfg::getParamInt   ("katana.searchHalo"           ,      1)->asInt())
+    , _globalRouterThreads (Cfg::getParamInt   ("katana.globalRouterThreads"  ,      1)->asInt())
+    , _powerRailsThreads   (Cfg::getParamInt   ("katana.powerRailsThreads"    ,      1)->asInt())
     , _longWireUpThreshold1(Cfg::getParamInt   ("katana.longWireUpThreshold1" ,     60)->asInt())
     , _longWireUpReserve1  (Cfg::getParamDouble("katana.longWireUpReserve1"   ,    1.0)->asDouble())
     , _hTracksReservedLocal(Cfg::getParamInt   ("katana.hTracksReservedLocal" ,      3)->asInt())
@@ -55,6 +57,7 @@ namespace Katana {
     , _eventsLimit         (Cfg::getParamInt   ("katana.eventsLimit"          ,4000000)->asInt())
     , _bloatOverloadAdd    (Cfg::getParamInt   ("katana.bloatOverloadAdd"     ,      4)->asInt())
     , _trackFill           (Cfg::getParamInt   ("katana.trackFill"            ,      0)->asInt())
+    , _negociateRegionSize (Cfg::getParamInt   ("katana.negociateRegionSize"  ,      0)->asInt())
     , _flags               (0)
     , _profileEventCosts   (Cfg::getParamBool  ("katana.profileEventCosts"    ,false  )->asBool())
     , _runRealignStage     (Cfg::getParamBool  ("katana.runRealignStage"      ,true   )->asBool())
@@ -68,6 +71,7 @@ namespace Katana {
     _ripupLimits[NonPrefRipupLimit]    = Cfg::getParamInt("katana.nonPrefRipupLimit"    , 7)->asInt();
 
     if (Cfg::getParamBool("katana.useGlobalEstimate"    ,false)->asBool()) _flags |= UseGlobalEstimate;
+    if (Cfg::getParamBool("katana.useGlobalAStar"       ,false)->asBool()) _flags |= UseGlobalAStar;
     if (Cfg::getParamBool("katana.useStaticBloatProfile",true )->asBool()) _flags |= UseStaticBloatProfile;
 
     // for ( size_t i=0 ; i<MaxMetalDepth ; ++i ) {
@@ -96,6 +100,8 @@ namespace Katana {
     , _postEventCb         (other._postEventCb)
     , _bloat               (other._bloat)
     , _searchHalo          (other._searchHalo)
+    , _globalRouterThreads (other._globalRouterThreads)
+    , _powerRailsThreads   (other._powerRailsThreads)
     , _longWireUpThreshold1(other._longWireUpThreshold1)
     , _longWireUpReserve1  (other._longWireUpReserve1)
     , _hTracksReservedLocal(other._hTracksReservedLocal)
@@ -109,6 +115,7 @@ namespace Katana {
     , _eventsLimit         (other._eventsLimit)
     , _bloatOverloadAdd    (other._bloatOverloadAdd)
     , _trackFill           (other._trackFill)
+    , _negociateRegionSize (other._negociateRegionSize)
     , _flags               (other._flags)
     , _profileEventCosts   (other._profileEventCosts)
     , _runRealignStage     (other._runRealignStage)
@@ -189,7 +196,10 @@ namespace Katana {
     cout << Dots::asString("     - Net builder style"                  ,getNetBuilderStyle()) << endl;
     cout << Dots::asString("     - Routing style"                      ,getRoutingStyle().asString()) << endl;
     cout << Dots::asUInt  ("     - Dijkstra GR search halo"            ,getSearchHalo()) << endl;
+    cout << Dots::asUInt  ("     - Dijkstra GR threads"                ,getGlobalRouterThreads()) << endl;
+    cout << Dots::asUInt  ("     - Power rails merging threads"        ,getPowerRailsThreads()) << endl;
     cout << Dots::asBool  ("     - Use GR density estimate"            ,useGlobalEstimate()) << endl;
+    cout << Dots::asBool  ("     - Use GR A* search"                   ,useGlobalAStar()) << endl;
     cout << Dots::asBool  ("     - Use static bloat profile"           ,useStaticBloatProfile()) << endl;
     cout << Dots::asInt   ("     - GCell terminal(RP) saturate number" ,getSaturateRp()) << endl;
     cout << Dots::asDouble("     - GCell saturate ratio (LA)"          ,getSaturateRatio()) << endl;
@@ -208,6 +218,7 @@ namespace Katana {
     cout << Dots::asUInt  ("     - Ripup limit, long globals"          ,_ripupLimits[LongGlobalRipupLimit]) << endl;
     cout << Dots::asUInt  ("     - Bloat overload additional penalty"  ,_bloatOverloadAdd) << endl;
     cout << Dots::asUInt  ("     - Fill every nth track"               ,_trackFill) << endl;
+    cout << Dots::asUInt  ("     - Negociate region size (GCells)"     ,_negociateRegionSize) << endl;
 
     Super::print( cell );
   }
@@ -233,6 +244,8 @@ namespace Katana {
     if ( record ) {
       record->add ( getSlot("_bloat"                ,_bloat                ) );
       record->add ( getSlot("_searchHalo"           ,_searchHalo           ) );
+      record->add ( getSlot("_globalRouterThreads"  ,_globalRouterThreads  ) );
+      record->add ( getSlot("_powerRailsThreads"    ,_powerRailsThreads    ) );
       record->add ( getSlot("_longWireUpThreshold1" ,_longWireUpThreshold1 ) );
       record->add ( getSlot("_longWireUpReserved1"  ,_longWireUpReserve1   ) );
       record->add ( getSlot("_hTracksReservedLocal" ,_hTracksReservedLocal ) );
@@ -241,6 +254,7 @@ namespace Katana {
       record->add ( getSlot("_vTracksReservedMin"   ,_vTracksReservedMin   ) );
       record->add ( getSlot("_ripupCost"            ,_ripupCost            ) );
       record->add ( getSlot("_eventsLimit"          ,_eventsLimit          ) );
+      record->add ( getSlot("_negociateRegionSize"  ,_negociateRegionSize  ) );
 
       record->add ( getSlot("_ripupLimits[StrapRipupLimit]"      ,_ripupLimits[StrapRipupLimit]     ) );
       record->add ( getSlot("_ripupLimits[LocalRipupLimit]"      ,_ripupLimits[LocalRipupLimit]     ) );
@@ -15,11 +15,13 @@
 
 
 #include "flute.h"
+#include "FluteContext.h"
 #include "hurricane/utilities/Dots.h"
 #include "hurricane/Warning.h"
 #include "hurricane/Breakpoint.h"
 #include "hurricane/RoutingPad.h"
 #include "hurricane/Cell.h"
+#include "hurricane/ThreadPool.h"
 #include "hurricane/viewer/CellViewer.h"
 #include "crlcore/Utilities.h"
 #include "crlcore/Histogram.h"
@@ -41,11 +43,19 @@ namespace {
   using std::left;
   using std::right;
   using std::set;
+  using std::vector;
+  using Hurricane::Error;
+  using Hurricane::Warning;
   using Hurricane::DbU;
+  using Hurricane::Point;
+  using Hurricane::Component;
+  using Hurricane::RoutingPad;
   using Hurricane::Interval;
   using Hurricane::DBo;
   using Hurricane::Net;
   using Hurricane::Segment;
+  using Hurricane::NetRoutingState;
+  using Hurricane::ThreadPool;
   using Utilities::Dots;
   using Anabatic::Flags;
   using Anabatic::Edge;
@@ -53,6 +63,8 @@ namespace {
   using Anabatic::Vertex;
   using Anabatic::EdgeCapacity;
   using Anabatic::AnabaticEngine;
+  using Anabatic::NetData;
+  using Anabatic::Dijkstra;
   using Etesian::BloatExtension;
   using namespace Katana;
 
@@ -61,6 +73,7 @@ namespace {
     public:
       inline            DigitalDistance ( float h, float k, float gcellAspectRatio, float hScaling );
       inline void       setNet          ( Net* );
+      inline float      getMinCost      () const;
              DbU::Unit  operator()      ( const Vertex* source ,const Vertex* target,const Edge* edge ) const;
     private:
     // For an explanation of h & k parameters, see:
@@ -85,6 +98,14 @@ namespace {
   { }
   inline void  DigitalDistance::setNet ( Net* net ) { _net = net; }
 
+// Smallest cost per unit of length of an Edge, that is, with no
+// congestion, no historic cost and no via. Edge::getDistance() is the
+// dx+dy between the GCells centers, all of it scaled by hScaling on
+// horizontal Edges, so a unit of length on either axis may cost as
+// little as min(hScaling,1). Used as the A* lower bound. Only valid
+// outside of channel style, see operator().
+  inline float  DigitalDistance::getMinCost () const { return std::min( _hScaling, 1.0f ); }
+
 
   DbU::Unit  DigitalDistance::operator() ( const Vertex* source, const Vertex* target, const Edge* edge ) const
   {
@@ -201,8 +222,323 @@ namespace {
       }
     }
   }
+
+
+  void  loadEstimateTargets ( KatanaEngine*         katana
+                            , NetData*              netData
+                            , vector<GCell*>&       targets
+                            , Flute::Context::Pins& pins )
+  {
+    for ( Component* component : netData->getNet()->getComponents() ) {
+      RoutingPad* rp = dynamic_cast<RoutingPad*>( component );
+      if (rp) {
+        if (not katana->getConfiguration()->selectRpComponent(rp))
+          cerr << Warning( "KatanaEngine::updateEstimateDensity(): %s has no components on grid.", getString(rp).c_str() ) << endl;
+
+        Point  center = rp->getBoundingBox().getCenter();
+        GCell* gcell  = katana->getGCellUnder( center );
+
+        targets.push_back( gcell );
+      }
+    }
+
+    if (targets.size() < 3) return;
+    for ( GCell* gcell : targets ) {
+      Point center = gcell->getCenter();
+      pins.add( center.getX(), center.getY() );
+    }
+  }
+
+
+  void  updateEstimateDensityOfTree ( KatanaEngine* katana, NetData* netData, const Flute::Tree& tree, double weight )
+  {
+    for ( size_t i=0 ; (int)i < 2*tree.deg - 2 ; ++i ) {
+      size_t j = tree.branch[i].n;
+      GCell* source = katana->getGCellUnder( tree.branch[i].x, tree.branch[i].y );
+      GCell* target = katana->getGCellUnder( tree.branch[j].x, tree.branch[j].y );
+
+      if (not source) {
+        cerr << Error( "KatanaEngine::updateEstimateDensity(): No GCell under (%s,%s) for %s."
+                     , DbU::getValueString((DbU::Unit)tree.branch[i].x).c_str()
+                     , DbU::getValueString((DbU::Unit)tree.branch[i].y).c_str()
+                     , getString(netData->getNet()).c_str()
+                     ) << endl;
+        continue;
+      }
+      if (not target) {
+        cerr << Error( "KatanaEngine::updateEstimateDensity(): No GCell under (%s,%s) for %s."
+                     , DbU::getValueString((DbU::Unit)tree.branch[j].x).c_str()
+                     , DbU::getValueString((DbU::Unit)tree.branch[j].y).c_str()
+                     , getString(netData->getNet()).c_str()
+                     ) << endl;
+        continue;
+      }
+
+      updateEstimateDensityOfPath( katana, source, target, weight );
+    }
+  }
   
 
+// -------------------------------------------------------------------
+// Class  :  "ParallelGlobalRouter".
+//
+// Route batches of nets whose search areas do not overlap concurrently.
+// Each net of a batch gets it's own worker Dijkstra (sharing the
+// Vertexes of the master one), the searches are run on the thread pool,
+// then the results are committed sequentially, in net ordering.
+//
+// A net is added to the current batch only if it's footprint do not
+// intersect the one of any net already in the batch *or* skipped before
+// it. So every net sees exactly the same Edge occupancies and historic
+// costs as in the sequential algorithm, and the routing is identical
+// whatever the number of threads.
+//
+// The footprint of a net is it's RoutingPads bounding box inflated by
+// the search halo plus two matrix GCell sides: one to reach the border of
+// the GCell under the terminal, one for the GCells merely touching the
+// search area. This assumes a regular matrix of GCells, so the channel
+// routing style is always done sequentially.
+
+  class ParallelGlobalRouter {
+    public:
+                    ParallelGlobalRouter ( KatanaEngine*, Dijkstra* master, Dijkstra::Mode, size_t threads );
+                   ~ParallelGlobalRouter ();
+      inline const ThreadPool& getPool   () const;
+      inline void   resetStats           ();
+             void   setSearchAreaHalo    ( DbU::Unit );
+             size_t route                ( bool& globalEstimated, size_t& expandeds );
+    private:                             
+             Box    _getFootprint        ( const NetData* ) const;
+             Box    _getSearchArea       ( const NetData* ) const;
+             bool   _isSequential        ( const NetData* ) const;
+             bool   _triggersEstimate    ( const NetData*, bool globalEstimated ) const;
+             size_t _routeBatch          ( vector<NetData*>& batch, const vector<Box>& footprints );
+    private:
+      KatanaEngine*             _katana;
+      Dijkstra*                 _master;
+      Dijkstra::Mode            _mode;
+      ThreadPool                _pool;
+      size_t                    _batchMax;
+      size_t                    _lookahead;
+      vector<Dijkstra*>         _workers;
+      vector<DigitalDistance*>  _distances;
+      vector<char>              _searcheds;
+  };
+
+
+  ParallelGlobalRouter::ParallelGlobalRouter ( KatanaEngine* katana, Dijkstra* master, Dijkstra::Mode mode, size_t threads )
+    : _katana   (katana)
+    , _master   (master)
+    , _mode     (mode)
+    , _pool     (threads)
+    , _batchMax (8*_pool.size())
+    , _lookahead(4*_batchMax)
+    , _workers  ()
+    , _distances()
+    , _searcheds()
+  {
+  // The workers stay on the Vertex states of the master (slot 0). They are
+  // loaded from the main thread and their footprints are disjoint, and a
+  // slot per worker would cost one copy of the states per batch entry.
+    for ( size_t i=0 ; i<_batchMax ; ++i ) {
+      Dijkstra* worker = new Dijkstra ( _master );
+      _workers  .push_back( worker );
+      _distances.push_back( worker->setDistance( DigitalDistance( katana->getConfiguration()->getEdgeCostH()
+                                                                , katana->getConfiguration()->getEdgeCostK()
+                                                                , katana->getConfiguration()->getGCellAspectRatio()
+                                                                , katana->getConfiguration()->getEdgeHScaling() )));
+    }
+    _searcheds.resize( _batchMax, false );
+  }
+
+
+  ParallelGlobalRouter::~ParallelGlobalRouter ()
+  {
+    for ( Dijkstra* worker : _workers ) delete worker;
+  }
+
+
+  inline const ThreadPool& ParallelGlobalRouter::getPool    () const { return _pool; }
+  inline void              ParallelGlobalRouter::resetStats () { _pool.resetStats(); }
+
+
+  void  ParallelGlobalRouter::setSearchAreaHalo ( DbU::Unit halo )
+  {
+    for ( Dijkstra* worker : _workers ) worker->setSearchAreaHalo( halo );
+  }
+
+
+  bool  ParallelGlobalRouter::_isSequential ( const NetData* netData ) const
+  {
+    if (netData->getSearchArea().isEmpty()) return true;
+
+    NetRoutingState* state = netData->getNetRoutingState();
+    if (state and (state->isSymmetric() or state->isSelfSym())) return true;
+
+    return false;
+  }
+
+
+  bool  ParallelGlobalRouter::_triggersEstimate ( const NetData* netData, bool globalEstimated ) const
+  {
+    return _katana->useGlobalEstimate() and not globalEstimated and (netData->getRpCount() < 11);
+  }
+
+
+  Box  ParallelGlobalRouter::_getFootprint ( const NetData* netData ) const
+  {
+    Box footprint = netData->getSearchArea();
+    return footprint.inflate( _workers[0]->getSearchAreaHalo() + 2*GCell::getMatrixHSide()
+                            , _workers[0]->getSearchAreaHalo() + 2*GCell::getMatrixVSide() );
+  }
+
+
+  Box  ParallelGlobalRouter::_getSearchArea ( const NetData* netData ) const
+  {
+  // Same search area as Dijkstra::load(), without touching the database.
+  // Symmetric nets are never batched, so the symmetry cases are ignored.
+    Box    searchArea;
+    size_t rpCount = 0;
+    for ( Component* component : netData->getNet()->getComponents() ) {
+      RoutingPad* rp = dynamic_cast<RoutingPad*>( component );
+      if (not rp) continue;
+      ++rpCount;
+      GCell* gcell = _katana->getGCellUnder( rp->getUserCenter() );
+      if (gcell) searchArea.merge( gcell->getBoundingBox() );
+    }
+    if (rpCount < 2) return Box();
+    return searchArea.inflate( _workers[0]->getSearchAreaHalo() );
+  }
+
+
+  size_t  ParallelGlobalRouter::_routeBatch ( vector<NetData*>& batch, const vector<Box>& footprints )
+  {
+  // Check the search areas against the footprints *before* loading, as
+  // loading modifies the database (GContacts, RoutingPads). The batch is
+  // cut before the first overflowing net, the dropped ones are after all
+  // the kept ones in net ordering so they will simply come again in a
+  // later batch.
+    if (batch.size() > 1) {
+      for ( size_t i=0 ; i<batch.size() ; ++i ) {
+        Box searchArea = _getSearchArea( batch[i] );
+        if (searchArea.isEmpty()) continue;
+        searchArea.inflate( GCell::getMatrixHSide(), GCell::getMatrixVSide() );
+        if (not footprints[i].contains(searchArea)) {
+          cdebug_log(112,0) << "ParallelGlobalRouter::_routeBatch(): Search area out of footprint for "
+                            << batch[i]->getNet() << ", batch cut to " << std::max(i,(size_t)1) << " nets." << endl;
+          batch.resize( std::max(i,(size_t)1) );
+          break;
+        }
+      }
+    }
+
+  // Sequential part: loading modifies the database (GContacts, RoutingPads).
+    _katana->incStamp();
+    for ( size_t i=0 ; i<batch.size() ; ++i ) {
+      _distances[i]->setNet( batch[i]->getNet() );
+      _workers  [i]->load( batch[i]->getNet() );
+    }
+
+    for ( NetData* netData : batch ) {
+      if (netData->isGlobalEstimated()) {
+        _katana->updateEstimateDensity( netData, -1.0 );
+        netData->setGlobalEstimated( false );
+      }
+    }
+
+    _pool.run( batch.size()
+             , [&]( size_t i, size_t ) { _searcheds[i] = _workers[i]->search( _mode ); } );
+
+  // Deterministic commit, in net ordering.
+    size_t expandeds = 0;
+    for ( size_t i=0 ; i<batch.size() ; ++i ) {
+      if (_searcheds[i]) _workers[i]->commit();
+      batch[i]->setGlobalRouted( true );
+      batch[i]->incExpandedCount( _workers[i]->getExpandedCount() );
+      expandeds += _workers[i]->getExpandedCount();
+    }
+    return expandeds;
+  }
+
+
+  size_t  ParallelGlobalRouter::route ( bool& globalEstimated, size_t& expandeds )
+  {
+    vector<NetData*> pendings;
+    for ( NetData* netData : _katana->getNetOrdering() ) {
+      if (netData->isGlobalRouted() or netData->isExcluded()) continue;
+      pendings.push_back( netData );
+    }
+
+    vector<NetData*> batch;
+    vector<Box>      footprints;
+    vector<Box>      blockers;
+    size_t           netCount = 0;
+    size_t           ipending = 0;
+
+    while ( ipending < pendings.size() ) {
+      batch     .clear();
+      footprints.clear();
+      blockers  .clear();
+
+      for ( size_t i=ipending ; (i<pendings.size()) and (i<ipending+_lookahead) ; ++i ) {
+        NetData* netData = pendings[i];
+        if (netData->isGlobalRouted()) continue;
+
+        if (_isSequential(netData)) {
+          if (batch.empty()) batch.push_back( netData );
+          break;
+        }
+
+        Box  footprint = _getFootprint( netData );
+        bool conflict  = false;
+        for ( const Box& other : footprints ) {
+          if (footprint.intersect(other)) { conflict = true; break; }
+        }
+        for ( const Box& other : blockers ) {
+          if (conflict) break;
+          if (footprint.intersect(other)) conflict = true;
+        }
+
+        bool trigger = _triggersEstimate( netData, globalEstimated );
+        if (conflict) {
+        // Nets after a skipped estimate trigger must see the estimate.
+          if (trigger) break;
+          blockers.push_back( footprint );
+          continue;
+        }
+      // The estimate must only be run once all the previous nets are
+      // routed, so wait for the skipped ones.
+        if (trigger and not blockers.empty()) break;
+
+        batch     .push_back( netData );
+        footprints.push_back( footprint );
+        if (trigger or (batch.size() >= _batchMax)) break;
+      }
+
+      expandeds += _routeBatch( batch, footprints );
+      netCount  += batch.size();
+
+    // Same as the sequential version: once we reach nets of less than
+    // 11 terminals, estimate the density of all the remaining ones.
+    // By construction, only the last net of a batch can trigger it.
+      if (_triggersEstimate(batch.back(),globalEstimated)) {
+        vector<NetData*> estimateds;
+        for ( NetData* netData2 : _katana->getNetOrdering() ) {
+          if (netData2->isGlobalRouted() or netData2->isExcluded()) continue;
+          estimateds.push_back( netData2 );
+        }
+        _katana->updateEstimateDensities( estimateds, 1.0 );
+        for ( NetData* netData2 : estimateds ) netData2->setGlobalEstimated( true );
+        globalEstimated = true;
+      }
+
+      while ( (ipending < pendings.size()) and pendings[ipending]->isGlobalRouted() ) ++ipending;
+    }
+
+    return netCount;
+  }
+
+
   void  selectNets ( KatanaEngine* katana, set<const Net*,Net::CompareByName>& nets )
   {
     if (katana->getViewer()) {
@@ -451,19 +787,9 @@ namespace Katana {
     //    and (netData->getNet()->getName() != "ra(0)")
     //    and (netData->getNet()->getName() != "iram.oa2a22_x2_11_sig")) return;
 
-    vector<GCell*> targets;
-    for ( Component* component : netData->getNet()->getComponents() ) {
-      RoutingPad* rp = dynamic_cast<RoutingPad*>( component );
-      if (rp) {
-        if (not getConfiguration()->selectRpComponent(rp))
-          cerr << Warning( "KatanaEngine::updateEstimateDensity(): %s has no components on grid.", getString(rp).c_str() ) << endl;
-
-        Point  center = rp->getBoundingBox().getCenter();
-        GCell* gcell  = getGCellUnder( center );
-
-        targets.push_back( gcell );
-      }
-    }
+    vector<GCell*>       targets;
+    Flute::Context::Pins pins;
+    loadEstimateTargets( this, netData, targets, pins );
 
     switch ( targets.size() ) {
       case 0:
@@ -473,44 +799,36 @@ namespace Katana {
         updateEstimateDensityOfPath( this, targets[0], targets[1], weight );
         return;
       default:
-        { int      accuracy = 3;
-          int64_t* xs       = new int64_t [targets.size()];
-          int64_t* ys       = new int64_t [targets.size()];
-
-          for ( size_t itarget=0 ; itarget<targets.size() ; ++itarget ) {
-            Point center =  targets[itarget]->getCenter();
-            xs[ itarget ] = center.getX();
-            ys[ itarget ] = center.getY();
-          }
+        { Flute::Tree tree = _flute->getTree( pins );
+          updateEstimateDensityOfTree( this, netData, tree, weight );
+          Flute::Context::freeTree( tree );
+        }
+        return;
+    }
+  }
 
-          Flute::Tree tree = Flute::flute( targets.size(), xs, ys, accuracy );
 
-          for ( size_t i=0 ; (int)i < 2*tree.deg - 2 ; ++i ) {
-            size_t j = tree.branch[i].n;
-            GCell* source = getGCellUnder( tree.branch[i].x, tree.branch[i].y );
-            GCell* target = getGCellUnder( tree.branch[j].x, tree.branch[j].y );
+  void  KatanaEngine::updateEstimateDensities ( const vector<NetData*>& netDatas, double weight )
+  {
+  // Loading the targets may select the RoutingPads components, and the
+  // Edges are updated in net order: only the trees are computed in parallel.
+    vector< vector<GCell*> >      targets ( netDatas.size() );
+    vector<Flute::Context::Pins>  pins    ( netDatas.size() );
+    vector<Flute::Tree>           trees;
+
+    for ( size_t i=0 ; i<netDatas.size() ; ++i ) {
+      loadEstimateTargets( this, netDatas[i], targets[i], pins[i] );
+      if (targets[i].size() < 3) pins[i].clear();
+    }
 
-            if (not source) {
-              cerr << Error( "KatanaEngine::updateEstimateDensity(): No GCell under (%s,%s) for %s."
-                           , DbU::getValueString((DbU::Unit)tree.branch[i].x).c_str()
-                           , DbU::getValueString((DbU::Unit)tree.branch[i].y).c_str()
-                           , getString(netData->getNet()).c_str()
-                           ) << endl;
-              continue;
-            }
-            if (not target) {
-              cerr << Error( "KatanaEngine::updateEstimateDensity(): No GCell under (%s,%s) for %s."
-                           , DbU::getValueString((DbU::Unit)tree.branch[j].x).c_str()
-                           , DbU::getValueString((DbU::Unit)tree.branch[j].y).c_str()
-                           , getString(netData->getNet()).c_str()
-                           ) << endl;
-              continue;
-            }
+    _flute->getTrees( pins, trees, getConfiguration()->getGlobalRouterThreads() );
 
-            updateEstimateDensityOfPath( this, source, target, weight );
-          }
-        }
-        return;
+    for ( size_t i=0 ; i<netDatas.size() ; ++i ) {
+      if (targets[i].size() == 2)
+        updateEstimateDensityOfPath( this, targets[i][0], targets[i][1], weight );
+      else if (targets[i].size() > 2)
+        updateEstimateDensityOfTree( this, netDatas[i], trees[i], weight );
+      Flute::Context::freeTree( trees[i] );
     }
   }
 
@@ -559,6 +877,30 @@ namespace Katana {
     else
       dijkstra->setSearchAreaHalo( Session::getSliceHeight()*getSearchHalo() );
 
+  // A* needs a distance that never decreases along a path. In channel
+  // style, DigitalDistance returns 0 to enter an already connected
+  // standard cell row, which would make A* settle a Vertex through a
+  // path the plain search does not choose. So it is not used there.
+    Dijkstra::Mode mode = Dijkstra::Mode::Standart;
+    if (useGlobalAStar()) {
+      if (isChannelStyle()) {
+        cerr << Warning( "KatanaEngine::runGlobalRouter(): A* search is not supported in channel style, ignored." ) << endl;
+      } else {
+        mode |= Dijkstra::Mode::AStar;
+        dijkstra->setAStarCost( distance->getMinCost()
+                              , std::min( GCell::getMatrixHSide(), GCell::getMatrixVSide() ));
+      }
+    }
+
+  // Dijkstra::search() traces through cdebug, which is not thread safe.
+    size_t                threads  = getConfiguration()->getGlobalRouterThreads();
+    ParallelGlobalRouter* parallel = NULL;
+    if (cdebug.enabled(112)) threads = 1;
+    if ((threads != 1) and not isChannelStyle()) {
+      parallel = new ParallelGlobalRouter ( this, dijkstra, mode, threads );
+      cmess1 << ::Dots::asUInt( "     - Global router threads", parallel->getPool().size() ) << endl;
+    }
+
     bool     globalEstimated = false;
     size_t   iteration       = 0;
     size_t   netCount        = 0;
@@ -568,43 +910,52 @@ namespace Katana {
 
       long   wireLength = 0;
       long   viaCount   = 0;
+      size_t expandeds  = 0;
 
       netCount = 0;
-      for ( NetData* netData : getNetOrdering() ) {
-        if (netData->isGlobalRouted() or netData->isExcluded()) continue;
-        if (netData->isGlobalEstimated()) {
-          updateEstimateDensity( netData, -1.0 );
-          netData->setGlobalEstimated( false );
-        }
+      if (parallel) {
+        netCount = parallel->route( globalEstimated, expandeds );
+      } else {
+        for ( NetData* netData : getNetOrdering() ) {
+          if (netData->isGlobalRouted() or netData->isExcluded()) continue;
+          if (netData->isGlobalEstimated()) {
+            updateEstimateDensity( netData, -1.0 );
+            netData->setGlobalEstimated( false );
+          }
 
-        distance->setNet( netData->getNet() );
-        dijkstra->load( netData->getNet() );
-        dijkstra->run();
-        netData->setGlobalRouted( true );
-        ++netCount;
-
-        // if (netData->getNet()->getName() == Name("mips_r3000_1m_dp_shift32_rshift_se_msb")) {
-        //   Session::close();
-        //   Breakpoint::stop( 1, "After global routing of \"mips_r3000_1m_dp_shift32_rshift_se_msb\"." );
-        //   openSession();
-        // }
-
-        if (useGlobalEstimate()) {
-        // Triggers the global routing when we reach nets of less than 11 terminals.
-        // High degree nets are routed straight (without taking account the smalls).
-        // See the SparsityOrder comparison function.
-          if ( (netData->getRpCount() < 11) and not globalEstimated ) {
-            for ( NetData* netData2 : getNetOrdering() ) {
-              if (netData2->isGlobalRouted() or netData2->isExcluded()) continue;
-
-              updateEstimateDensity( netData2, 1.0 );
-              netData2->setGlobalEstimated( true );
+          distance->setNet( netData->getNet() );
+          dijkstra->load( netData->getNet() );
+          dijkstra->run( mode );
+          netData->setGlobalRouted( true );
+          netData->incExpandedCount( dijkstra->getExpandedCount() );
+          expandeds += dijkstra->getExpandedCount();
+          ++netCount;
+
+          // if (netData->getNet()->getName() == Name("mips_r3000_1m_dp_shift32_rshift_se_msb")) {
+          //   Session::close();
+          //   Breakpoint::stop( 1, "After global routing of \"mips_r3000_1m_dp_shift32_rshift_se_msb\"." );
+          //   openSession();
+          // }
+
+          if (useGlobalEstimate()) {
+          // Triggers the global routing when we reach nets of less than 11 terminals.
+          // High degree nets are routed straight (without taking account the smalls).
+          // See the SparsityOrder comparison function.
+            if ( (netData->getRpCount() < 11) and not globalEstimated ) {
+              vector<NetData*> estimateds;
+              for ( NetData* netData2 : getNetOrdering() ) {
+                if (netData2->isGlobalRouted() or netData2->isExcluded()) continue;
+                estimateds.push_back( netData2 );
+              }
+              updateEstimateDensities( estimateds, 1.0 );
+              for ( NetData* netData2 : estimateds ) netData2->setGlobalEstimated( true );
+              globalEstimated = true;
             }
-            globalEstimated = true;
           }
         }
       }
       cmess2 << left << setw(6) << netCount;
+      cmess2 << " exp:" << setw(8) << expandeds;
 
       computeGlobalWireLength( wireLength, viaCount );
       cmess2 <<  " nWL:" << setw(7) << (wireLength /*+ viaCount*3*/);
@@ -643,11 +994,16 @@ namespace Katana {
         }
 
         dijkstra->setSearchAreaHalo( (getSearchHalo() + 3*(iteration/3)) * Session::getSliceHeight() );
+        if (parallel) parallel->setSearchAreaHalo( dijkstra->getSearchAreaHalo() );
       }
 
       cmess2 << " ovE:" << setw(4) << overflow << " ovWL:" << setw(5) << edgeOverflowWL;
 
       cmess2 << " ripup:" << setw(4) << netCount << right;
+      if (parallel) {
+        cmess2 << " thr:" << parallel->getPool().getStringUtilization();
+        parallel->resetStats();
+      }
       suspendMeasures();
       cmess2 << " " << setw(7) << Timer::getStringMemory(getTimer().getIncrease())
              << " " << setw(6) << Timer::getStringTime  (getTimer().getCombTime()) << endl;
@@ -739,6 +1095,7 @@ namespace Katana {
       _resizeMatrix();
     }
 
+    if (parallel) delete parallel;
     delete dijkstra;
 
     Session::close();
@@ -15,10 +15,12 @@
 
 
 #include <Python.h>
+#include <cstdlib>
 #include <sstream>
 #include <fstream>
 #include <iomanip>
 #include "flute.h"
+#include "FluteContext.h"
 #include "hurricane/utilities/Path.h"
 #include "hurricane/DebugSession.h"
 #include "hurricane/UpdateSession.h"
@@ -45,6 +47,7 @@
 #include "katana/RoutingPlane.h"
 #include "katana/Session.h"
 #include "katana/TrackSegment.h"
+#include "katana/TrackCost.h"
 #include "katana/NegociateWindow.h"
 #include "katana/KatanaEngine.h"
 #include "katana/PyKatanaEngine.h"
@@ -214,6 +217,7 @@ namespace Katana {
     , _blocks         ()
     , _routingPlanes  ()
     , _negociateWindow(NULL)
+    , _flute          (NULL)
     , _minimumWL      (0.0)
     , _shortDoglegs   ()
     , _symmetrics     ()
@@ -235,7 +239,11 @@ namespace Katana {
 
   // Flute: load POWV9.dat & POST9.dat
     Flute::readLUT( System::getPath( "coriolis_top" ).toString() );
+    _flute = new Flute::Context ();
     rsetNoExtractFlag( getCell() );
+
+    const char* tracePath = getenv( "KATANA_TRACKCOST_TRACE" );
+    if (tracePath) TrackCost::openTrace( tracePath );
   }
 
 
@@ -361,6 +369,11 @@ namespace Katana {
 
     _gutKatana();
     Super::_preDestroy();
+    TrackSegment::releaseArenas();
+
+    delete _flute;
+    _flute = NULL;
+    TrackCost::closeTrace();
 
     cmess2 << "     - RoutingEvents := " << RoutingEvent::getAllocateds() << endl;
 
@@ -785,6 +798,7 @@ namespace Katana {
     addMeasure<uint64_t>( "DWL"    , totalWireLength                  , 12 );
     addMeasure<uint64_t>( "fWL"    , totalWireLength-routedWireLength , 12 );
     addMeasure<double>  ( "WLER(%)", expandRatio );
+    addMeasure<size_t>  ( "TArenaS", TrackSegment::getArenaPeak() >> 20 );
   }
 
 
@@ -929,6 +943,7 @@ namespace Katana {
       }
 
       Session::close();
+      TrackSegment::releaseArenas();
     }
 
     cdebug_tabw(155,-1);
@@ -196,13 +196,13 @@ namespace {
     RoutingGauge*      rg   = nw->getKatanaEngine()->getConfiguration()->getRoutingGauge();
   //bool               isVH = rg->isVH();
 
-    for( Net* net : nw->getCell()->getNets() ) {
+    for( Net* net : nw->getCell()->getNetRange() ) {
       if (net->getType() == Net::Type::POWER ) continue;
       if (net->getType() == Net::Type::GROUND) continue;
     //if (net->getType() == Net::Type::CLOCK ) continue;
       if (af->isBLOCKAGE(net->getName())) continue;
 
-      for( RoutingPad* rp : net->getRoutingPads() ) {
+      for( RoutingPad* rp : net->getRoutingPadRange() ) {
         size_t depth   = rg->getLayerDepth(rp->getLayer());
         size_t rlDepth = depth - rg->getFirstRoutingLayer();
         if (rlDepth == 0) {
@@ -292,6 +292,7 @@ namespace Katana {
     , _gcells      ()
     , _segments    ()
     , _eventQueue  ()
+    , _activeQueue (&_eventQueue)
     , _eventHistory()
     , _eventLoop   (10,70)
   { }
@@ -336,7 +337,7 @@ namespace Katana {
   {
     DataNegociate* data = segment->getDataNegociate();
     if (not data or not data->hasRoutingEvent())
-      _eventQueue.add( segment, level );
+      _activeQueue->add( segment, level );
     else
       cerr << Bug( "NegociateWidow::addRoutingEvent(): Try to adds twice the same TrackElement event."
                    "\n       %p:%s."
@@ -640,6 +641,106 @@ namespace Katana {
   }
 
 
+  void  NegociateWindow::_negociateRegions ()
+  {
+    DbU::Unit regionSide = (DbU::Unit)_katana->getNegociateRegionSize() * Session::getSliceHeight();
+    Box       area       = getCell()->getAbutmentBox();
+    if (not regionSide or area.isEmpty()) return;
+
+    size_t columns = std::max( (DbU::Unit)1, (area.getWidth () + regionSide - 1) / regionSide );
+    size_t rows    = std::max( (DbU::Unit)1, (area.getHeight() + regionSide - 1) / regionSide );
+    if (columns*rows < 2) return;
+
+    auto regionOf = [&]( DbU::Unit x, DbU::Unit y ) -> size_t {
+      DbU::Unit column = std::max( (DbU::Unit)0, (x - area.getXMin()) / regionSide );
+      DbU::Unit row    = std::max( (DbU::Unit)0, (y - area.getYMin()) / regionSide );
+      return std::min( (size_t)row, rows-1 )*columns + std::min( (size_t)column, columns-1 );
+    };
+
+    cmess1 << "     o  Negociation Stage, by regions (" << columns << "x" << rows << ")." << endl;
+
+  // A segment belongs to a region if both it's source and target GCells
+  // are fully inside. The others are left for the final, global, pass.
+    vector< vector<TrackElement*> > regionSegments ( columns*rows );
+    vector<Statistics>              regionStatistics ( columns*rows );
+    for ( GCell* gcell : _gcells ) {
+      const Box& bb = gcell->getBoundingBox();
+      regionStatistics[ regionOf(bb.getXMin(),bb.getYMin()) ].incGCellCount( 1 );
+    }
+    for ( TrackElement* segment : _segments ) {
+      AutoSegment* autoSegment = segment->base();
+      if (not autoSegment) continue;
+
+      Box bb = autoSegment->getAutoSource()->getGCell()->getBoundingBox();
+      bb.merge( autoSegment->getAutoTarget()->getGCell()->getBoundingBox() );
+      size_t region = regionOf( bb.getXMin(), bb.getYMin() );
+      if (region != regionOf(bb.getXMax()-1,bb.getYMax()-1)) continue;
+      regionSegments[region].push_back( segment );
+    }
+
+    uint64_t limit = _katana->getEventsLimit();
+    for ( size_t region=0 ; (region < regionSegments.size()) and not isInterrupted() ; ++region ) {
+      Statistics&           statistics = regionStatistics[region];
+      vector<TrackElement*> loadeds;
+      for ( TrackElement* segment : regionSegments[region] ) {
+        if (segment->getDataNegociate()->getRoutingEvent()) continue;
+        if (segment->getTrack()) continue;
+        loadeds.push_back( segment );
+      }
+      statistics.setSegmentsCount( regionSegments[region].size() );
+
+    // Per region event state: queue, history and loop detector. The
+    // Session is revalidated at the region boundaries, so each region
+    // starts from, and leaves, a settled database.
+      RoutingEventQueue   queue;
+      RoutingEventHistory history;
+      RoutingEventLoop    loop       ( 10, 70 );
+      size_t              processeds = RoutingEvent::getProcesseds();
+
+      Session::revalidate();
+
+      queue.load( loadeds );
+      statistics.setLoadedEventsCount( queue.size() );
+      _activeQueue = &queue;
+
+      while ( not queue.empty() and not isInterrupted() ) {
+        RoutingEvent* event = queue.pop();
+
+        if (tty::enabled()) {
+          cmess2 << "        <region:" << region << " event:" << tty::bold << right << setw(8) << setfill('0')
+                 << RoutingEvent::getProcesseds() << tty::reset
+                 << " remains:" << right << setw(8) << setfill('0')
+                 << queue.size()
+                 << setfill(' ') << tty::reset << ">" << tty::cr;
+          cmess2.flush ();
+        } else {
+          cmess2 << "        <region:" << region << " event:" << right << setw(8) << setfill('0')
+                 << RoutingEvent::getProcesseds() << setfill(' ') << " "
+                 << event->getEventLevel() << ":" << event->getPriority()
+                 << ":" << DbU::getValueString(event->getSegment()->getLength()) << "> "
+                 << event->getSegment()
+                 << endl;
+          cmess2.flush();
+        }
+
+        event->process( queue, history, loop );
+        if (RoutingEvent::getProcesseds() >= limit) setInterrupt( true );
+      }
+
+      Session::revalidate();
+      _activeQueue = &_eventQueue;
+      statistics.setProcessedEventsCount( RoutingEvent::getProcesseds() - processeds );
+      statistics.setEventsCount( history.size() );
+      queue.clear();
+      _eventHistory.append( history );
+    }
+    if (cmess2.enabled() and tty::enabled()) cmess1 << endl;
+
+    for ( const Statistics& statistics : regionStatistics )
+      _statistics.addRegion( statistics );
+  }
+
+
   size_t  NegociateWindow::_negociate ()
   {
     cdebug_log(9000,0) << "Deter| NegociateWindow::_negociate()" << endl;
@@ -654,13 +755,31 @@ namespace Katana {
     if (profiling) ofprofile.open( "katana.profile.txt" );
 
     _eventHistory.clear();
-    _eventQueue.load( _segments );
-    cmess2 << "        <queue:" <<  right << setw(8) << setfill('0') << _eventQueue.size() << ">" << endl;
+    _katana->setStage( StageNegociate );
+
+    size_t regionLoadeds = 0;
+    if (_katana->getNegociateRegionSize()) {
+      _negociateRegions();
+
+    // Segments crossing the region boundaries, sequential reconciliation.
+      vector<TrackElement*> deferreds;
+      for ( TrackElement* segment : _segments ) {
+        if (segment->getDataNegociate()->getRoutingEvent()) continue;
+        if (segment->getTrack()) continue;
+        deferreds.push_back( segment );
+      }
+      for ( const Statistics& region : _statistics.getRegions() )
+        regionLoadeds += region.getLoadedEventsCount();
+      _eventQueue.load( deferreds );
+      cmess2 << "        <deferred.queue:" <<  right << setw(8) << setfill('0') << _eventQueue.size() << ">" << endl;
+    } else {
+      _eventQueue.load( _segments );
+      cmess2 << "        <queue:" <<  right << setw(8) << setfill('0') << _eventQueue.size() << ">" << endl;
+    }
     if (cdebug.enabled(9000)) _eventQueue.dump();
-    _statistics.setLoadedEventsCount( _eventQueue.size() );
+    _statistics.setLoadedEventsCount( regionLoadeds + _eventQueue.size() );
 
     size_t count = 0;
-    _katana->setStage( StageNegociate );
     while ( not _eventQueue.empty() and not isInterrupted() ) {
       RoutingEvent* event = _eventQueue.pop();
 
@@ -906,6 +1025,16 @@ namespace Katana {
     cmess1 << Dots::asSizet ( "     - Unique Events Total"
                            ,(RoutingEvent::getProcesseds() - RoutingEvent::getCloneds())) << endl;
     cmess1 << Dots::asSizet("     - # of GCells",_statistics.getGCellsCount()) << endl;
+    const vector<Statistics>& regions = _statistics.getRegions();
+    for ( size_t i=0 ; i<regions.size() ; ++i ) {
+      ostringstream title;
+      title << "     - Region [" << i << "] GCells/segments/events";
+      ostringstream counts;
+      counts << regions[i].getGCellsCount()
+             << "/" << regions[i].getSegmentsCount()
+             << "/" << regions[i].getProcessedEventsCount();
+      cmess2 << Dots::asString( title.str(), counts.str() ) << endl;
+    }
     _katana->printCompletion();
 
     _katana->addMeasure<size_t>( "Events" , RoutingEvent::getProcesseds(), 12 );
@@ -34,7 +34,11 @@
 #include "hurricane/Plug.h"
 #include "hurricane/Path.h"
 #include "hurricane/Query.h"
+#include "hurricane/Slice.h"
+#include "hurricane/Timer.h"
+#include "hurricane/ThreadPool.h"
 #include "crlcore/AllianceFramework.h"
+#include "crlcore/Measures.h"
 #include "anabatic/GCell.h"
 #include "katana/RoutingPlane.h"
 #include "katana/TrackFixedSegment.h"
@@ -66,6 +70,9 @@ namespace {
   using Hurricane::Plug;
   using Hurricane::Path;
   using Hurricane::Query;
+  using Hurricane::Slice;
+  using Hurricane::Timer;
+  using Hurricane::ThreadPool;
   using Hurricane::Go;
   using Hurricane::Rubber;
   using Hurricane::Layer;
@@ -348,6 +355,16 @@ namespace {
       class Plane {
         public:
           typedef  map<Net*,Rails*,Net::CompareById>  RailsMap;
+        private:
+          class Request {
+            public:
+              inline       Request    ( const Box&, Net*, uint32_t rank );
+              inline bool  operator<  ( const Request& ) const;
+            public:
+              Box       _bb;
+              Net*      _net;
+              uint32_t  _rank;
+          };
         public:
                                Plane             ( const Layer*, RoutingPlane* );
                               ~Plane             ();
@@ -355,14 +372,18 @@ namespace {
           inline RoutingPlane* getRoutingPlane   ();
           inline Flags         getDirection      () const;
           inline Flags         getPowerDirection () const;
+          inline size_t        getRequestCount   () const;
+          inline void          addRequest        ( const Box&, Net*, uint32_t rank );
                  void          merge             ( const Box&, Net* );
+                 void          mergeRequests     ();
                  void          doLayout          ();
         private:
-          const Layer*  _layer;
-          RoutingPlane* _routingPlane;
-          RailsMap      _horizontalRails;
-          RailsMap      _verticalRails;
-          Flags         _powerDirection;
+          const Layer*     _layer;
+          RoutingPlane*    _routingPlane;
+          RailsMap         _horizontalRails;
+          RailsMap         _verticalRails;
+          Flags            _powerDirection;
+          vector<Request>  _requests;
       };
 
     public:
@@ -373,10 +394,11 @@ namespace {
       inline Net*   getRootNet             ( Net*, Path );
       inline bool   isCoreClockNetRouted   ( const Net* ) const;
              bool   hasPlane               ( const BasicLayer* );
-             bool   setActivePlane         ( const BasicLayer* );
+             bool   setActivePlane         ( const BasicLayer*, uint32_t rank );
       inline Plane* getActivePlane         () const;
       inline Plane* getActiveBlockagePlane () const;
              void   merge                  ( const Box&, Net* );
+             void   mergeRequests          ( size_t threads );
              void   doLayout               ();
     private:
       KatanaEngine*   _katana;
@@ -384,6 +406,7 @@ namespace {
       PlanesMap       _planes;
       Plane*          _activePlane;
       Plane*          _activeBlockagePlane;
+      uint32_t        _activeRank;
   };
 
 
@@ -716,6 +739,7 @@ namespace {
     , _horizontalRails      ()
     , _verticalRails        ()
     , _powerDirection       (routingPlane->getDirection())
+    , _requests             ()
   {
     cdebug_log(159,0) << "New Plane " << _layer->getName() << " " << _routingPlane << endl;
 
@@ -741,6 +765,22 @@ namespace {
   inline RoutingPlane* PowerRailsPlanes::Plane::getRoutingPlane   () { return _routingPlane; }
   inline Flags         PowerRailsPlanes::Plane::getDirection      () const { return _routingPlane->getDirection(); }
   inline Flags         PowerRailsPlanes::Plane::getPowerDirection () const { return _powerDirection; }
+  inline size_t        PowerRailsPlanes::Plane::getRequestCount   () const { return _requests.size(); }
+
+
+  inline  PowerRailsPlanes::Plane::Request::Request ( const Box& bb, Net* net, uint32_t rank )
+    : _bb  (bb)
+    , _net (net)
+    , _rank(rank)
+  { }
+
+
+  inline bool  PowerRailsPlanes::Plane::Request::operator< ( const Request& other ) const
+  { return _rank < other._rank; }
+
+
+  inline void  PowerRailsPlanes::Plane::addRequest ( const Box& bb, Net* net, uint32_t rank )
+  { _requests.push_back( Request(bb,net,rank) ); }
 
 
   void  PowerRailsPlanes::Plane::merge ( const Box& bb, Net* net )
@@ -776,6 +816,18 @@ namespace {
   }
 
 
+  void  PowerRailsPlanes::Plane::mergeRequests ()
+  {
+  // Requests are issued in traversal order, which interleaves the layers
+  // feeding this plane (a metal and its blockage). Replay them in layer
+  // order, so the rails are built exactly as with one query per layer.
+    stable_sort( _requests.begin(), _requests.end() );
+    for ( const Request& request : _requests )
+      merge( request._bb, request._net );
+    vector<Request>().swap( _requests );
+  }
+
+
   void  PowerRailsPlanes::Plane::doLayout ()
   {
     cdebug_log(159,0) << "Doing layout of plane: " << _layer->getName() << endl;
@@ -797,6 +849,7 @@ namespace {
     , _planes             ()
     , _activePlane        (NULL)
     , _activeBlockagePlane(NULL)
+    , _activeRank         (0)
   {
     _globalNets.setBlockage( katana->getBlockageNet() );
 
@@ -845,11 +898,12 @@ namespace {
   { return (_planes.find(layer) != _planes.end()); }
 
 
-  bool  PowerRailsPlanes::setActivePlane ( const BasicLayer* layer )
+  bool  PowerRailsPlanes::setActivePlane ( const BasicLayer* layer, uint32_t rank )
   {
     PlanesMap::iterator iplane = _planes.find(layer);
     if (iplane == _planes.end()) return false;
 
+    _activeRank          = rank;
     _activePlane         = iplane->second;
     _activeBlockagePlane = NULL;
     if (layer->getMaterial() != BasicLayer::Material::blockage) {
@@ -881,9 +935,24 @@ namespace {
     }
 
     if ( (topGlobalNet == _globalNets.getBlockage()) and (_activeBlockagePlane != NULL) )
-      _activeBlockagePlane->merge( bb, topGlobalNet );
+      _activeBlockagePlane->addRequest( bb, topGlobalNet, _activeRank );
     else
-      _activePlane->merge( bb, topGlobalNet );
+      _activePlane->addRequest( bb, topGlobalNet, _activeRank );
+  }
+
+
+  void  PowerRailsPlanes::mergeRequests ( size_t threads )
+  {
+  // Planes share nothing, merge them concurrently. Debug traces are
+  // not thread safe.
+    vector<Plane*> planes;
+    for ( auto iplane : _planes ) {
+      if (iplane.second->getRequestCount()) planes.push_back( iplane.second );
+    }
+    if (cdebug.enabled(159)) threads = 1;
+
+    ThreadPool pool ( std::min( threads, std::max(planes.size(),(size_t)1) ) );
+    pool.run( planes.size(), [&]( size_t i, size_t ) { planes[i]->mergeRequests(); } );
   }
 
 
@@ -904,11 +973,13 @@ namespace {
                             QueryPowerRails     ( KatanaEngine* );
       virtual bool          hasGoCallback       () const;
       virtual void          setBasicLayer       ( const BasicLayer* );
+              void          setBasicLayer       ( const BasicLayer*, uint32_t rank );
       virtual bool          hasBasicLayer       ( const BasicLayer* );
       virtual void          goCallback          ( Go*     );
       virtual void          rubberCallback      ( Rubber* );
       virtual void          extensionGoCallback ( Go*     );
       virtual void          masterCellCallback  ();
+              void          addBasicLayer       ( const BasicLayer* );
               void          addToPowerRail      ( const Go*              go
                                                 , const BasicLayer*      basicLayer
                                                 , const Box&             area
@@ -916,19 +987,21 @@ namespace {
                                                 );
               void          ringAddToPowerRails ();
       virtual void          doQuery             ();
+      inline  void          mergeRequests       ( size_t threads );
       inline  void          doLayout            ();
       inline  uint32_t      getGoMatchCount     () const;
       inline  RoutingGauge* getRoutingGauge     () const;
     private:
-      AllianceFramework*      _framework;
-      KatanaEngine*           _katana;
-      RoutingGauge*           _routingGauge;
-      const ChipTools&        _chipTools;
-      PowerRailsPlanes        _powerRailsPlanes;
-      bool                    _isBlockagePlane;
-      vector<const Segment*>  _hRingSegments;
-      vector<const Segment*>  _vRingSegments;
-      uint32_t                _goMatchCount;
+      AllianceFramework*         _framework;
+      KatanaEngine*              _katana;
+      RoutingGauge*              _routingGauge;
+      const ChipTools&           _chipTools;
+      PowerRailsPlanes           _powerRailsPlanes;
+      bool                       _isBlockagePlane;
+      vector<const BasicLayer*>  _basicLayers;
+      vector<const Segment*>     _hRingSegments;
+      vector<const Segment*>     _vRingSegments;
+      uint32_t                   _goMatchCount;
   };
 
 
@@ -940,6 +1013,7 @@ namespace {
     , _chipTools       (katana->getChipTools())
     , _powerRailsPlanes(katana)
     , _isBlockagePlane (false)
+    , _basicLayers     ()
     , _hRingSegments   ()
     , _vRingSegments   ()
     , _goMatchCount    (0)
@@ -957,6 +1031,10 @@ namespace {
   { return _goMatchCount; }
 
 
+  inline  void  QueryPowerRails::mergeRequests ( size_t threads )
+  { _powerRailsPlanes.mergeRequests( threads ); }
+
+
   inline  void  QueryPowerRails::doLayout ()
   { return _powerRailsPlanes.doLayout(); }
 
@@ -969,28 +1047,77 @@ namespace {
   { return _powerRailsPlanes.hasPlane ( basicLayer ); }
 
 
+  void  QueryPowerRails::addBasicLayer ( const BasicLayer* basicLayer )
+  {
+    if (not hasBasicLayer(basicLayer)) return;
+    _basicLayers.push_back( basicLayer );
+  }
+
+
   void  QueryPowerRails::setBasicLayer ( const BasicLayer* basicLayer )
   {
+    uint32_t rank = 0;
+    for ( ; rank<_basicLayers.size() ; ++rank ) {
+      if (_basicLayers[rank] == basicLayer) break;
+    }
+    setBasicLayer( basicLayer, rank );
+  }
+
+
+  void  QueryPowerRails::setBasicLayer ( const BasicLayer* basicLayer, uint32_t rank )
+  {
+  // The rank orders the merges inside the planes, see Plane::mergeRequests().
     _isBlockagePlane = (basicLayer) and (basicLayer->getMaterial() == BasicLayer::Material::blockage);
-    _powerRailsPlanes.setActivePlane ( basicLayer );
+    _powerRailsPlanes.setActivePlane ( basicLayer, rank );
     Query::setBasicLayer ( basicLayer );
   }
 
 
   void  QueryPowerRails::doQuery ()
   {
-    PowerRailsPlanes::Plane* activePlane = _powerRailsPlanes.getActivePlane();
-
-    if (not activePlane) return;
-
-    cmess1 << "     - PowerRails in " << activePlane->getLayer()->getName() << " ..." << endl;
-    if (static_cast<const BasicLayer*>(activePlane->getLayer())->getMaterial()
-       != BasicLayer::Material::blockage)
-      setStopCellFlags( Cell::Flags::AbstractedSupply );
-    else
-      unsetStopCellFlags( Cell::Flags::AbstractedSupply );
+  // Walk the hierarchy once for all the layers, instead of one full
+  // Query::doQuery() per layer. Supplies of AbstractedSupply cells are
+  // not looked into (metal layers), but their blockages are, so the
+  // walk goes through them and only filters the metals underneath.
+    if (_basicLayers.empty()) return;
+    if (_stack.getTopArea().isEmpty() or not _stack.getTopCell()) return;
+
+    cmess1 << "     - PowerRails in";
+    for ( const BasicLayer* layer : _basicLayers ) cmess1 << " " << layer->getName();
+    cmess1 << " ..." << endl;
+
+    unsetStopCellFlags( Cell::Flags::AbstractedSupply );
+
+    vector<bool> isAbstracted;
+    vector<bool> isUnderAbstracted;
+    _stack.init();
+
+    while ( not _stack.empty() ) {
+      size_t depth = _stack.size();
+      isAbstracted     .resize( depth );
+      isUnderAbstracted.resize( depth );
+      isAbstracted[ depth-1 ] = getMasterCell()->getFlags().isset( Cell::Flags::AbstractedSupply );
+      isUnderAbstracted[ depth-1 ] = (depth > 1)
+                                     and (isUnderAbstracted[ depth-2 ] or isAbstracted[ depth-2 ]);
+
+      for ( Slice* slice : getMasterCell()->getSlices() ) {
+        if (not slice->getBoundingBox().intersect(getArea())) continue;
+
+        for ( uint32_t rank=0 ; rank<_basicLayers.size() ; ++rank ) {
+          const BasicLayer* layer = _basicLayers[rank];
+          if (not slice->getLayer()->contains(layer)) continue;
+          if (   isUnderAbstracted[ depth-1 ]
+             and (layer->getMaterial() != BasicLayer::Material::blockage) ) continue;
+
+          setBasicLayer( layer, rank );
+          for ( Go* go : slice->getGosUnder(_stack.getArea(),_stack.getThreshold()) ) {
+            if (_isOwned(go)) goCallback( go );
+          }
+        }
+      }
 
-    Query::doQuery();
+      _stack.progress();
+    }
   }
 
 
@@ -1148,7 +1275,7 @@ namespace {
   {
     if ( not _hRingSegments.empty() ) {
       const RegularLayer* layer = dynamic_cast<const RegularLayer*>(_routingGauge->getRoutingLayer(3));
-      setBasicLayer ( layer->getBasicLayer() );
+      setBasicLayer ( layer->getBasicLayer(), _basicLayers.size() );
 
       DbU::Unit   xmin = DbU::Max;
       DbU::Unit   xmax = DbU::Min;
@@ -1168,7 +1295,7 @@ namespace {
 
     if ( not _vRingSegments.empty() ) {
       const RegularLayer* layer = dynamic_cast<const RegularLayer*>(_routingGauge->getRoutingLayer(2));
-      setBasicLayer ( layer->getBasicLayer() );
+      setBasicLayer ( layer->getBasicLayer(), _basicLayers.size() );
 
       DbU::Unit   ymin = DbU::Max;
       DbU::Unit   ymax = DbU::Min;
@@ -1225,22 +1352,41 @@ namespace Katana {
       state->getNetRoutingState()->setFlags( NetRoutingState::Fixed );
     }
 
-    QueryPowerRails query ( this );
+    QueryPowerRails query      ( this );
     Technology*     technology = DataBase::getDB()->getTechnology();
+    Timer           queryTimer;
+    Timer           mergeTimer;
+    Timer           layoutTimer;
 
     for ( BasicLayer* layer : technology->getBasicLayers() ) {
       if (   (layer->getMaterial() != BasicLayer::Material::metal)
          and (layer->getMaterial() != BasicLayer::Material::blockage) )
         continue;
       if (getConfiguration()->isGMetal(layer)) continue;
-      if (not query.hasBasicLayer(layer)) continue;
 
-      query.setBasicLayer( layer );
-      query.doQuery      ();
+      query.addBasicLayer( layer );
     }
+
+    queryTimer.start();
+    query.doQuery();
     query.ringAddToPowerRails();
+    queryTimer.stop();
+
+    mergeTimer.start();
+    query.mergeRequests( getConfiguration()->getPowerRailsThreads() );
+    mergeTimer.stop();
+
+    layoutTimer.start();
     query.doLayout();
+    layoutTimer.stop();
+
     cmess1 << "     - " << query.getGoMatchCount() << " power rails elements found." << endl;
+    cmess2 << "     - Query:"  << Timer::getStringTime(queryTimer .getCombTime())
+           <<      " merge:"   << Timer::getStringTime(mergeTimer .getCombTime())
+           <<      " layout:"  << Timer::getStringTime(layoutTimer.getCombTime()) << endl;
+    addMeasure<double>( "PwrQueryT" , queryTimer .getCombTime() );
+    addMeasure<double>( "PwrMergeT" , mergeTimer .getCombTime() );
+    addMeasure<double>( "PwrLayoutT", layoutTimer.getCombTime() );
 
     const vector<GCell*>& gcells = getGCells();
     for ( auto gcell : gcells ) {
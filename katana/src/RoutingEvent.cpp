@@ -14,6 +14,7 @@
 // +-----------------------------------------------------------------+
 
 
+#include <new>
 #include <cstdlib>
 #include <cmath>
 #include <sstream>
@@ -168,10 +169,83 @@ namespace Katana {
   }
 
 
+// -------------------------------------------------------------------
+// Class  :  "RoutingEvent::Pool".
+//
+// Slab allocator for the RoutingEvents. Freed events are recycled
+// through a free list threaded in their own storage, and the slabs
+// are given back all at once by releasePool(), when the history is
+// cleared and no event remains.
+
+  class RoutingEvent::Pool {
+    public:
+      static const size_t  SlabSize = 4096;
+    public:
+                    Pool     ();
+                   ~Pool     ();
+             void*  allocate ();
+             void   release  ( void* );
+             void   clear    ();
+    private:
+      union Slot {
+        Slot*  _next;
+        alignas(RoutingEvent) unsigned char  _storage[ sizeof(RoutingEvent) ];
+      };
+    private:
+      vector<Slot*>  _slabs;
+      Slot*          _freeList;
+      size_t         _used;
+  };
+
+
+  RoutingEvent::Pool::Pool ()
+    : _slabs   ()
+    , _freeList(NULL)
+    , _used    (SlabSize)
+  { }
+
+
+  RoutingEvent::Pool::~Pool ()
+  { clear(); }
+
+
+  void* RoutingEvent::Pool::allocate ()
+  {
+    if (_freeList) {
+      Slot* slot = _freeList;
+      _freeList  = slot->_next;
+      return slot;
+    }
+    if (_used == SlabSize) {
+      _slabs.push_back( new Slot [SlabSize] );
+      _used = 0;
+    }
+    return &(_slabs.back()[ _used++ ]);
+  }
+
+
+  void  RoutingEvent::Pool::release ( void* storage )
+  {
+    Slot* slot  = static_cast<Slot*>( storage );
+    slot->_next = _freeList;
+    _freeList   = slot;
+  }
+
+
+  void  RoutingEvent::Pool::clear ()
+  {
+    for ( Slot* slab : _slabs ) delete [] slab;
+    _slabs.clear();
+    _freeList = NULL;
+    _used     = SlabSize;
+  }
+
+
 // -------------------------------------------------------------------
 // Class  :  "RoutingEvent".
 
 
+  RoutingEvent::Pool  RoutingEvent::_pool;
   uint32_t  RoutingEvent::_idCounter  = 0;
   uint32_t  RoutingEvent::_allocateds = 0;
   uint32_t  RoutingEvent::_processeds = 0;
@@ -185,6 +259,13 @@ namespace Katana {
   void      RoutingEvent::resetProcesseds () { _processeds = 0; }
 
 
+  void  RoutingEvent::releasePool ()
+  {
+    if (_allocateds) return;
+    _pool.clear();
+  }
+
+
   RoutingEvent::RoutingEvent ( TrackElement* segment )
     : _cloned              (false)
     , _processed           (false)
@@ -206,6 +287,8 @@ namespace Katana {
     , _rippleState         (0)
     , _eventLevel          (0)
     , _key                 (this)
+    , _queueStamp          (0)
+    , _pushRequested       (false)
   {
     if (_idCounter == std::numeric_limits<uint32_t>::max()) {
       throw Error( "RoutingEvent::RoutingEvent(): Identifier counter has reached it's limit (%d bits)."
@@ -234,7 +317,7 @@ namespace Katana {
     //                ) << endl;
     // }
 
-    RoutingEvent* event = new RoutingEvent ( segment  );
+    RoutingEvent* event = new ( _pool.allocate() ) RoutingEvent ( segment );
     ++_allocateds;
 
     return event;
@@ -245,13 +328,15 @@ namespace Katana {
   {
     _cloned = true;
 
-    RoutingEvent* clone = new RoutingEvent ( *this );
+    RoutingEvent* clone = new ( _pool.allocate() ) RoutingEvent ( *this );
     ++_allocateds;
     ++_cloneds;
 
-    clone->_cloned     = false;
-    clone->_disabled   = false;
-    clone->_eventLevel = 0;
+    clone->_cloned        = false;
+    clone->_disabled      = false;
+    clone->_eventLevel    = 0;
+    clone->_queueStamp    = 0;
+    clone->_pushRequested = false;
 
     cdebug_log(159,0) << "RoutingEvent::clone() " << clone
                 << " (from: " << ")" <<  endl;
@@ -275,7 +360,8 @@ namespace Katana {
     cdebug_log(159,0) << "RoutingEvent::destroy() " << this << endl;
     if (_allocateds > 0) --_allocateds;
 
-    delete this;
+    this->~RoutingEvent();
+    _pool.release( this );
   }
 
 
@@ -74,11 +74,21 @@ namespace Katana {
   { _events.push_back(event); }
 
 
+// Move the events of other at the end of this history, other is left
+// empty and the events are not destroyed.
+  void  RoutingEventHistory::append ( RoutingEventHistory& other )
+  {
+    _events.insert( _events.end(), other._events.begin(), other._events.end() );
+    other._events.clear();
+  }
+
+
   void  RoutingEventHistory::clear ()
   {
     for ( size_t i=0 ; i < _events.size() ; i++ )
       _events[i]->destroy();
     _events.clear ();
+    RoutingEvent::releasePool();
   }
 
 
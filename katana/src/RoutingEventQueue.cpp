@@ -34,6 +34,8 @@ namespace Katana {
   using std::make_heap;
   using std::push_heap;
   using std::pop_heap;
+  using std::is_heap;
+  using std::sort;
 
   using Hurricane::tab;
   using Hurricane::Bug;
@@ -47,7 +49,10 @@ namespace Katana {
   RoutingEventQueue::RoutingEventQueue ()
     : _topEventLevel (0)
     , _pushRequests  ()
-    , _events        ()
+    , _buckets       (1)
+    , _topBucket     (0)
+    , _size          (0)
+    , _stamp         (0)
   { }
 
 
@@ -55,6 +60,19 @@ namespace Katana {
   { clear (); }
 
 
+  void  RoutingEventQueue::_insert ( RoutingEvent* event )
+  {
+    uint32_t level = event->getKey().getEventLevel();
+    if (level >= _buckets.size()) _buckets.resize( level+1 );
+    if (level >  _topBucket     ) _topBucket = level;
+
+    event->_queueStamp = ++_stamp;
+    _buckets[level].push_back( Entry(event,_stamp) );
+    push_heap( _buckets[level].begin(), _buckets[level].end(), EntryCompare() );
+    ++_size;
+  }
+
+
   void  RoutingEventQueue::load ( const vector<TrackElement*>& segments )
   {
     for ( size_t i=0 ; i<segments.size() ; i++ ) {
@@ -68,7 +86,7 @@ namespace Katana {
       }
       RoutingEvent* event = RoutingEvent::create( segments[i] );
       event->updateKey();
-      _events.insert( event );
+      _insert( event );
     }
   }
 
@@ -91,27 +109,20 @@ namespace Katana {
   {
     cdebug_log(159,1) << "RoutingEventQueue::commit()" << endl;
 
-    size_t addeds = _pushRequests.size();
-    size_t before = _events.size();
-
-    RoutingEventSet::iterator ipushEvent = _pushRequests.begin();
-    for ( ; ipushEvent != _pushRequests.end() ; ipushEvent++ ) {
-      (*ipushEvent)->updateKey();
+    sort( _pushRequests.begin(), _pushRequests.end(), RoutingEvent::CompareById() );
+    for ( RoutingEvent* event : _pushRequests ) {
+      event->_pushRequested = false;
+      event->updateKey();
 
-      _topEventLevel = max( _topEventLevel, (*ipushEvent)->getEventLevel() );
-      _events.insert( (*ipushEvent) );
+      _topEventLevel = max( _topEventLevel, event->getEventLevel() );
+      _insert( event );
 
-      cdebug_log(159,0) << "| " << (*ipushEvent) << endl;
+      cdebug_log(159,0) << "| " << event << endl;
     }
     _pushRequests.clear();
 #if defined(CHECK_ROUTINGEVENT_QUEUE)
     _keyCheck();
 #endif
-    size_t after = _events.size();
-    if (after-before != addeds) {
-      cerr << Bug( "RoutingEventQueue::commit(): less than %d events pusheds (%d)."
-                 , addeds,(after-before) ) << endl;
-    }
 
     cdebug_tabw(159,-1);
   }
@@ -119,30 +130,34 @@ namespace Katana {
 
   RoutingEvent* RoutingEventQueue::pop ()
   {
-    multiset<RoutingEvent*,RoutingEvent::Compare>::iterator ievent;
-    RoutingEvent* event = NULL;
-
 #if defined(CHECK_ROUTINGEVENT_QUEUE)
     _keyCheck ();
 #endif
 
-    if (not _events.empty()) {
-      size_t beforeSize = _events.size();
-
-      ievent = _events.end();
-      ievent--;
-      event  = (*ievent);
-      _events.erase( ievent );
+    while ( _size ) {
+      vector<Entry>& bucket = _buckets[ _topBucket ];
+      if (bucket.empty()) {
+        if (not _topBucket) {
+          cerr << Bug( "RoutingEventQueue::pop(): %d events lost.", _size ) << endl;
+          _size = 0;
+          break;
+        }
+        --_topBucket;
+        continue;
+      }
 
-      size_t afterSize = _events.size();
+      pop_heap( bucket.begin(), bucket.end(), EntryCompare() );
+      RoutingEvent* event = bucket.back()._event;
+      uint64_t      stamp = bucket.back()._stamp;
+      bucket.pop_back();
+      if (event->_queueStamp != stamp) continue;
 
-      if (afterSize+1 != beforeSize) {
-        cerr << Bug( "RoutingEventQueue::pop(): more than one event popped: %d."
-                   , (beforeSize-afterSize) ) << endl;
-      }
+      event->_queueStamp = 0;
+      --_size;
+      return event;
     }
 
-    return event;
+    return NULL;
   }
 
 
@@ -152,17 +167,10 @@ namespace Katana {
     _keyCheck ();
 #endif
 
-    multiset<RoutingEvent*,RoutingEvent::Compare>::iterator ievent = _events.find(event);
-    size_t count = _events.count(event);
-    if (count > 1) {
-      cerr << Bug( "RoutingEventQueue::repush(): %d events matches key %p.", count, event ) << endl;
-#if defined(CHECK_ROUTINGEVENT_QUEUE)
-      _keyCheck ();
-#endif
-    }
-
-    if (ievent != _events.end()) {
-      _events.erase( ievent );
+  // The entry already in the queue, if any, becomes stale.
+    if (event->_queueStamp) {
+      event->_queueStamp = 0;
+      --_size;
     }
     push ( event );
   }
@@ -191,64 +199,85 @@ namespace Katana {
   }
 
 
-  void  RoutingEventQueue::prepareRepair ()
+// Live events, in increasing order (the former multiset order).
+  void  RoutingEventQueue::_getSorteds ( vector<RoutingEvent*>& events ) const
   {
-    multiset<RoutingEvent*,RoutingEvent::Compare>::const_iterator ievent = _events.begin ();
-    for ( ; ievent != _events.end(); ++ievent ) {
-      (*ievent)->getSegment()->base()->toOptimalAxis();
+    vector<const Entry*> entries;
+    for ( const vector<Entry>& bucket : _buckets ) {
+      for ( const Entry& entry : bucket ) {
+        if (entry._event->_queueStamp == entry._stamp) entries.push_back( &entry );
+      }
     }
+    sort( entries.begin(), entries.end()
+        , []( const Entry* lhs, const Entry* rhs ) { return EntryCompare()( *lhs, *rhs ); } );
+
+    events.clear();
+    for ( const Entry* entry : entries ) events.push_back( entry->_event );
+  }
+
+
+  void  RoutingEventQueue::prepareRepair ()
+  {
+    vector<RoutingEvent*> events;
+    _getSorteds( events );
+    for ( RoutingEvent* event : events )
+      event->getSegment()->base()->toOptimalAxis();
   }
 
 
   void  RoutingEventQueue::clear ()
   {
-    if (not _events.empty()) {
+    if (_size) {
       cerr << Bug("RoutingEvent queue is not empty, %d events remains."
-                 ,_events.size()) << endl;
+                 ,_size) << endl;
     }
-    _events.clear();
+  // Do not dereference the events, they may already be destroyeds.
+    _buckets.clear();
+    _buckets.resize( 1 );
+    _topBucket = 0;
+    _size      = 0;
   }
 
 
   void  RoutingEventQueue::dump () const
   {
-    multiset<RoutingEvent*,RoutingEvent::Compare>::const_iterator ievent = _events.begin ();
-    for ( ; ievent != _events.end(); ievent++ ) {
+    vector<RoutingEvent*> events;
+    _getSorteds( events );
+    for ( RoutingEvent* event : events ) {
       cerr << "Deter| Queue:"
-           <<         (*ievent)->getEventLevel()
-           << ","  << setw(6) << (*ievent)->getPriority()
-           << " "  << setw(6) << DbU::getValueString((*ievent)->getSegment()->getLength())
-           << " "             << (*ievent)->getSegment()->isHorizontal()
-           << " "  << setw(6) << DbU::getValueString((*ievent)->getSegment()->getAxis())
-           << " "  << setw(6) << DbU::getValueString((*ievent)->getSegment()->getSourceU())
-           << ": " << (*ievent)->getSegment() << endl;
+           <<         event->getEventLevel()
+           << ","  << setw(6) << event->getPriority()
+           << " "  << setw(6) << DbU::getValueString(event->getSegment()->getLength())
+           << " "             << event->getSegment()->isHorizontal()
+           << " "  << setw(6) << DbU::getValueString(event->getSegment()->getAxis())
+           << " "  << setw(6) << DbU::getValueString(event->getSegment()->getSourceU())
+           << ": " << event->getSegment() << endl;
     }
   }
 
 
   void  RoutingEventQueue::_keyCheck () const
   {
-    multiset<RoutingEvent*,RoutingEvent::Compare>::const_iterator ievent = _events.begin ();
-    for ( ; ievent != _events.end(); ievent++ ) {
-      multiset<RoutingEvent*,RoutingEvent::Compare>::const_iterator ieventByKey
-        = _events.find ( *ievent );
-      
-      if ( ieventByKey != ievent ) {
-        if ( ieventByKey == _events.end() ) {
-          cerr << Bug("Key mismatch in RoutingEvent Queue:\n"
-                      "      %p:%s wasn't found by key."
-                     ,*ievent,getString(*ievent).c_str()
-                     ) << endl;
-        } else {
-          cerr << Bug("Key mismatch in RoutingEvent Queue:\n"
-                      "      %p:%s has same key of\n"
-                      "      %p:%s"
-                     ,*ievent,getString(*ievent).c_str()
-                     ,*ieventByKey,getString(*ieventByKey).c_str()
+    size_t lives = 0;
+    for ( size_t level=0 ; level<_buckets.size() ; ++level ) {
+      const vector<Entry>& bucket = _buckets[level];
+      if (not is_heap( bucket.begin(), bucket.end(), EntryCompare() ))
+        cerr << Bug( "RoutingEventQueue::_keyCheck(): Bucket %d is not a heap.", level ) << endl;
+      if (bucket.size() and (level > _topBucket))
+        cerr << Bug( "RoutingEventQueue::_keyCheck(): Bucket %d above top bucket %d."
+                   , level, _topBucket ) << endl;
+      for ( const Entry& entry : bucket ) {
+        if (entry._key.getEventLevel() != level)
+          cerr << Bug( "RoutingEventQueue::_keyCheck(): Level mismatch in bucket %d:\n"
+                       "      %p:%s"
+                     , level, entry._event, getString(entry._event).c_str()
                      ) << endl;
-        }
+        if (entry._event->_queueStamp == entry._stamp) ++lives;
       }
     }
+    if (lives != _size)
+      cerr << Bug( "RoutingEventQueue::_keyCheck(): Size mismatch %d vs. %d live events."
+                 , _size, lives ) << endl;
   }
 
 
@@ -266,7 +295,9 @@ namespace Katana {
   Record* RoutingEventQueue::_getRecord () const
   {
     Record* record = new Record ( getString(this) );
-    record->add ( getSlot ( "_events", &_events ) );
+    record->add ( getSlot ( "_topEventLevel", _topEventLevel ) );
+    record->add ( getSlot ( "_size"         , _size          ) );
+    record->add ( getSlot ( "_pushRequests" , &_pushRequests ) );
                                      
     return record;
   }
@@ -458,6 +458,7 @@ namespace Katana {
     , _constraint  ()
     , _optimal     ()
     , _costs       ()
+    , _costsMark   (TrackCost::getStack().mark())
     , _actions     ()
     , _fullBlocked (true)
     , _sameAxis    (false)
@@ -563,7 +564,7 @@ namespace Katana {
 
       for ( Track* ptrack : Tracks_Range::get(perpPlane,_constraint) ) {
         cdebug_log(155,0) << "Align on (top) preferred: " << ptrack << endl;
-        _costs.push_back( new TrackCost(segment1,NULL,baseTrack,NULL,ptrack->getAxis(),0) );
+        _costs.push_back( TrackCost::push(segment1,NULL,baseTrack,NULL,ptrack->getAxis(),0) );
       
         cdebug_log(155,0) << "AxisWeight:" << DbU::getValueString(_costs.back()->getRefCandidateAxis())
                           << " sum:" << DbU::getValueString(_costs.back()->getAxisWeight())
@@ -575,7 +576,7 @@ namespace Katana {
         cdebug_log(155,0) << "| " << _costs.back() << ((_fullBlocked)?" FB ": " -- ") << ptrack << endl;
       }
       if (_costs.empty()) {
-        _costs.push_back( new TrackCost(segment1,NULL,baseTrack,NULL,segment1->getAxis(),0) );
+        _costs.push_back( TrackCost::push(segment1,NULL,baseTrack,NULL,segment1->getAxis(),0) );
         if ( _fullBlocked and (not _costs.back()->isBlockage() and not _costs.back()->isFixed()) ) 
           _fullBlocked = false;
       }
@@ -596,7 +597,7 @@ namespace Katana {
           cdebug_log(155,0) << "plus segment2:" << DbU::getValueString( segment2->getSymmetricAxis(symData->getSymmetrical(track1->getAxis())) ) << endl;
         }
 
-        _costs.push_back( new TrackCost(segment1,segment2,track1,track2,track1->getAxis(),symAxis) );
+        _costs.push_back( TrackCost::push(segment1,segment2,track1,track2,track1->getAxis(),symAxis) );
         cdebug_log(155,0) << "Same Ripup:" << _data1->getSameRipup() << endl;
         if ((_data1->getSameRipup() > 10) and (track1->getAxis() == segment1->getAxis())) {
           cdebug_log(155,0) << "Track blacklisted" << endl;
@@ -648,6 +649,7 @@ namespace Katana {
 
   // FOR ANALOG ONLY.
   //flags |= TrackCost::IgnoreSharedLength;
+    if (TrackCost::hasTrace()) TrackCost::trace( _costs, flags, (int)Session::getRipupCost() );
     sort( _costs.begin(), _costs.end(), TrackCost::Compare(flags) );
 
     size_t i=0;
@@ -670,7 +672,7 @@ namespace Katana {
 
   SegmentFsm::~SegmentFsm ()
   {
-    for ( TrackCost* cost : _costs ) delete cost;
+    TrackCost::getStack().release( _costsMark );
   }
 
 
@@ -16,7 +16,9 @@
 
 #include <cstdlib>
 #include <sstream>
+#include <fstream>
 #include <iostream>
+#include "hurricane/Warning.h"
 #include "katana/Track.h"
 #include "katana/TrackCost.h"
 #include "katana/TrackElement.h"
@@ -28,41 +30,115 @@ namespace Katana {
   using std::cerr;
   using std::endl;
   using Hurricane::Error;
+  using Hurricane::Warning;
 
 
 // -------------------------------------------------------------------
 // Class  :  "TrackCost".
 
-  TrackCost::TrackCost ( TrackElement* refSegment
-                       , TrackElement* symSegment
-                       , Track*        refTrack
-                       , Track*        symTrack
-                       , DbU::Unit     refCandidateAxis
-                       , DbU::Unit     symCandidateAxis
-                       )
-    : _flags           ((symSegment) ? Symmetric : NoFlags)
-    , _span            (refSegment->getTrackSpan())
-    , _refCandidateAxis(refCandidateAxis)
-    , _symCandidateAxis(symCandidateAxis)
-    , _tracks          ( _span * ((symSegment) ? 2 : 1)
-                       , std::tuple<Track*,size_t,size_t>(NULL,Track::npos,Track::npos) )
-    , _segment1        (refSegment)
-    , _segment2        (symSegment)
-    , _interval1       (refSegment->getCanonicalInterval())
-    , _interval2       ((symSegment) ? symSegment->getCanonicalInterval() : Interval())
+  TrackCost::TrackCost ()
+    : _flags           (NoFlags)
+    , _span            (0)
+    , _refCandidateAxis(0)
+    , _symCandidateAxis(0)
+    , _trackAxis       (0)
+    , _tracks          ()
+    , _segment1        (NULL)
+    , _segment2        (NULL)
+    , _interval1       ()
+    , _interval2       ()
     , _terminals       (0)
-    , _delta           (-_interval1.getSize() -_interval2.getSize())
+    , _delta           (0)
     , _deltaShared     (0)
     , _deltaPerpand    (0)
     , _axisWeight      (0)
-    , _distanceToFixed (2*Session::getSliceHeight())
+    , _distanceToFixed (0)
     , _longuestOverlap (0)
     , _freeLength      (DbU::Max)
     , _dataState       (0)
     , _ripupCount      (0)
     , _selectFlags     (NoFlags)
     , _selectIndex     (0)
+  { }
+
+
+  TrackCost::TrackCost ( TrackElement* refSegment
+                       , TrackElement* symSegment
+                       , Track*        refTrack
+                       , Track*        symTrack
+                       , DbU::Unit     refCandidateAxis
+                       , DbU::Unit     symCandidateAxis
+                       )
+    : TrackCost()
+  {
+    _init( refSegment, symSegment, refTrack, symTrack, refCandidateAxis, symCandidateAxis );
+  }
+
+
+  std::ostream* TrackCost::_traceStream = NULL;
+
+
+// Per thread stack of reusable TrackCost, the records (and their track
+// vectors) are recycled from one SegmentFsm to the next.
+  TrackCost::Stack& TrackCost::getStack ()
+  {
+    static thread_local Stack  stack;
+    return stack;
+  }
+
+
+  TrackCost* TrackCost::push ( TrackElement* refSegment
+                             , TrackElement* symSegment
+                             , Track*        refTrack
+                             , Track*        symTrack
+                             , DbU::Unit     refCandidateAxis
+                             , DbU::Unit     symCandidateAxis
+                             )
+  {
+    Stack&     stack = getStack();
+    size_t     mark  = stack.mark();
+    TrackCost* cost  = stack.allocate();
+    try {
+      cost->_init( refSegment, symSegment, refTrack, symTrack, refCandidateAxis, symCandidateAxis );
+    } catch ( ... ) {
+      stack.release( mark );
+      throw;
+    }
+    return cost;
+  }
+
+
+  void  TrackCost::_init ( TrackElement* refSegment
+                         , TrackElement* symSegment
+                         , Track*        refTrack
+                         , Track*        symTrack
+                         , DbU::Unit     refCandidateAxis
+                         , DbU::Unit     symCandidateAxis
+                         )
   {
+    _flags            = (symSegment) ? Symmetric : NoFlags;
+    _span             = refSegment->getTrackSpan();
+    _refCandidateAxis = refCandidateAxis;
+    _symCandidateAxis = symCandidateAxis;
+    _tracks.assign( _span * ((symSegment) ? 2 : 1)
+                  , std::tuple<Track*,size_t,size_t>(NULL,Track::npos,Track::npos) );
+    _segment1         = refSegment;
+    _segment2         = symSegment;
+    _interval1        = refSegment->getCanonicalInterval();
+    _interval2        = (symSegment) ? symSegment->getCanonicalInterval() : Interval();
+    _terminals        = 0;
+    _delta            = -_interval1.getSize() -_interval2.getSize();
+    _deltaShared      = 0;
+    _deltaPerpand     = 0;
+    _axisWeight       = 0;
+    _distanceToFixed  = 2*Session::getSliceHeight();
+    _longuestOverlap  = 0;
+    _freeLength       = DbU::Max;
+    _dataState        = 0;
+    _ripupCount       = 0;
+    _selectFlags      = NoFlags;
+    _selectIndex      = 0;
+
     if (Session::getStage() == StageRealign) _flags |= IgnoreShort;
     
     if (refSegment->isNonPref()) {
@@ -83,6 +159,7 @@ namespace Katana {
     cdebug_log(159,0) << "  interval1: " << _interval1 << endl;
     
     std::get<0>( _tracks[0] ) = refTrack;
+    _trackAxis = refTrack->getAxis();
     _segment1->addOverlapCost( *this );
 
     if (symTrack) {
@@ -108,6 +185,18 @@ namespace Katana {
   }
 
 
+  TrackCost::Compare::Compare ( uint32_t flags )
+    : _flags    (flags)
+    , _ripupCost((int)Session::getRipupCost())
+  { }
+
+
+  TrackCost::Compare::Compare ( uint32_t flags, int ripupCost )
+    : _flags    (flags)
+    , _ripupCost(ripupCost)
+  { }
+
+
   bool  TrackCost::Compare::operator() ( const TrackCost* lhs, const TrackCost* rhs )
   {
     if (lhs->isInfinite    () xor rhs->isInfinite    ()) return rhs->isInfinite();
@@ -120,8 +209,8 @@ namespace Katana {
 
     if (lhs->isHardOverlap() xor rhs->isHardOverlap()) return rhs->isHardOverlap();
 
-    if (lhs->_ripupCount + (int)Session::getRipupCost() < rhs->_ripupCount) return true;
-    if (lhs->_ripupCount > (int)Session::getRipupCost() + rhs->_ripupCount) return false;
+    if (lhs->_ripupCount + _ripupCost < rhs->_ripupCount) return true;
+    if (lhs->_ripupCount > _ripupCost + rhs->_ripupCount) return false;
 
   //int lhsRipupCost = (lhs->_dataState<<2) + lhs->_ripupCount;
   //int rhsRipupCost = (rhs->_dataState<<2) + rhs->_ripupCount;
@@ -177,7 +266,8 @@ namespace Katana {
     if (lhs->_distanceToFixed > rhs->_distanceToFixed) return true;
     if (lhs->_distanceToFixed < rhs->_distanceToFixed) return false;
 
-    return lhs->getTrack(0)->getAxis() < rhs->getTrack(0)->getAxis();
+  // Axis of the first track, cached at init (same as getTrack(0)->getAxis()).
+    return lhs->_trackAxis < rhs->_trackAxis;
   }
 
 
@@ -256,6 +346,53 @@ namespace Katana {
   }
 
 
+  void  TrackCost::openTrace ( const string& path )
+  {
+    closeTrace();
+    _traceStream = new std::ofstream ( path, std::ios::out|std::ios::app );
+    if (not (*_traceStream)) {
+      cerr << Warning( "TrackCost::openTrace(): Unable to open TrackCost trace file \"%s\"."
+                     , path.c_str() ) << endl;
+      closeTrace();
+    }
+  }
+
+
+  void  TrackCost::closeTrace ()
+  {
+    if (_traceStream) delete _traceStream;
+    _traceStream = NULL;
+  }
+
+
+  void  TrackCost::trace ( const std::vector<TrackCost*>& costs, uint32_t flags, int ripupCost )
+  {
+  // One SegmentFsm sort per block, with all the fields read by Compare,
+  // so it can be replayed without the database (see TrackCostBench).
+  //   F <flags> <ripupCost> <count>
+  //   <flags> <ripupCount> <terminals> <delta> <axisWeight> <deltaPerpand>
+  //           <distanceToFixed> <trackAxis> <tracks>      (count times)
+    if (not _traceStream) return;
+    (*_traceStream) << "F " << flags << ' ' << ripupCost << ' ' << costs.size() << '\n';
+    for ( const TrackCost* cost : costs ) cost->_trace( *_traceStream );
+  }
+
+
+  void  TrackCost::_trace ( std::ostream& o ) const
+  {
+    o <<        _flags
+      << ' ' << _ripupCount
+      << ' ' << _terminals
+      << ' ' << _delta
+      << ' ' << _axisWeight
+      << ' ' << _deltaPerpand
+      << ' ' << _distanceToFixed
+      << ' ' << _trackAxis
+      << ' ' << _tracks.size()
+      << '\n';
+  }
+
+
   string  TrackCost::_getString () const
   {
     string s = "<" + _getTypeName();
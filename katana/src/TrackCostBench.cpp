@@ -0,0 +1,298 @@
+// -*- mode: C++; explicit-buffer-name: "TrackCostBench.cpp<katana>" -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |      K a t a n a  -  D e t a i l e d   R o u t e r              |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./TrackCostBench.cpp"                          |
+// +-----------------------------------------------------------------+
+//
+// Replay the TrackCost sets a SegmentFsm gives to the sort, once with
+// one heap allocated record per candidate (the former behavior) and once
+// with the records recycled through the TrackCost RecordStack, check
+// that both sort the candidates in the same order and report their run
+// times. The records are real TrackCost, sorted by TrackCost::Compare,
+// only the fields read by the comparison are filled.
+//
+// The sets are either read from a trace recorded by running the
+// detailed router with:
+//
+//     KATANA_TRACKCOST_TRACE=/tmp/trackcost.trace
+//
+// or, when a number of SegmentFsm is given instead, drawn from a fixed
+// seed, so runs are comparable.
+//
+// Usage:  trackcost-bench [<trace>|<fsms>] [repeat]
+
+
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <random>
+#include <tuple>
+#include <vector>
+#include <algorithm>
+#include "katana/Track.h"
+#include "katana/TrackCost.h"
+
+
+namespace {
+
+  using namespace std;
+
+
+  struct TraceCost {
+    uint32_t  _flags;
+    int       _ripupCount;
+    uint32_t  _terminals;
+    int64_t   _delta;
+    int64_t   _axisWeight;
+    int64_t   _deltaPerpand;
+    int64_t   _distanceToFixed;
+    int64_t   _axis;
+    size_t    _tracksSize;
+  };
+
+
+  struct TraceFsm {
+    uint32_t  _flags;
+    int       _ripupCost;
+    size_t    _begin;
+    size_t    _end;
+  };
+
+
+}  // Anonymous namespace.
+
+
+namespace Katana {
+
+// Fills a TrackCost from a trace record, as TrackCost::_init() would
+// (the tracks vector is re-assigned). The trace index is kept in the
+// reference candidate axis, which is not used by the comparison.
+  class TrackCostBench {
+    public:
+      static inline TrackCost* create ();
+      static inline void       init   ( TrackCost*, const TraceCost&, size_t index );
+      static inline size_t     index  ( const TrackCost* );
+  };
+
+
+  inline TrackCost* TrackCostBench::create () { return new TrackCost (); }
+  inline size_t     TrackCostBench::index  ( const TrackCost* cost ) { return cost->_refCandidateAxis; }
+
+
+  inline void  TrackCostBench::init ( TrackCost* cost, const TraceCost& data, size_t index )
+  {
+    cost->_flags            = data._flags;
+    cost->_span             = (data._flags & TrackCost::Symmetric) ? data._tracksSize/2 : data._tracksSize;
+    cost->_refCandidateAxis = index;
+    cost->_trackAxis        = data._axis;
+    cost->_tracks.assign( data._tracksSize, std::tuple<Track*,size_t,size_t>(NULL,Track::npos,Track::npos) );
+    cost->_terminals        = data._terminals;
+    cost->_delta            = data._delta;
+    cost->_axisWeight       = data._axisWeight;
+    cost->_deltaPerpand     = data._deltaPerpand;
+    cost->_distanceToFixed  = data._distanceToFixed;
+    cost->_ripupCount       = data._ripupCount;
+  }
+
+
+}  // Katana namespace.
+
+
+namespace {
+
+  using Katana::TrackCost;
+  using Katana::TrackCostBench;
+
+
+  bool  loadTrace ( const char* path, vector<TraceFsm>& fsms, vector<TraceCost>& costs )
+  {
+    ifstream  in ( path );
+    if (not in) {
+      cerr << "[ERROR] Unable to open trace \"" << path << "\"." << endl;
+      return false;
+    }
+
+    string  tag;
+    while ( in >> tag ) {
+      if (tag != "F") {
+        cerr << "[ERROR] Unexpected \"" << tag << "\" in trace (SegmentFsm " << fsms.size() << ")." << endl;
+        return false;
+      }
+      TraceFsm fsm { 0, 0, costs.size(), 0 };
+      size_t   count = 0;
+      in >> fsm._flags >> fsm._ripupCost >> count;
+      for ( size_t i=0 ; (i<count) and in ; ++i ) {
+        TraceCost cost;
+        in >> cost._flags >> cost._ripupCount >> cost._terminals
+           >> cost._delta >> cost._axisWeight >> cost._deltaPerpand
+           >> cost._distanceToFixed >> cost._axis >> cost._tracksSize;
+        costs.push_back( cost );
+      }
+      if (not in) {
+        cerr << "[ERROR] Truncated trace (SegmentFsm " << fsms.size() << ")." << endl;
+        return false;
+      }
+      fsm._end = costs.size();
+      fsms.push_back( fsm );
+    }
+    return true;
+  }
+
+
+  void  generateTrace ( size_t count, vector<TraceFsm>& fsms, vector<TraceCost>& costs )
+  {
+    static const uint32_t  fsmFlags[]  = { TrackCost::IgnoreAxisWeight
+                                         , TrackCost::DiscardGlobals
+                                         , TrackCost::IgnoreSharedLength
+                                         , TrackCost::IgnoreTerminals };
+    static const uint32_t  costFlags[] = { TrackCost::ForGlobal
+                                         , TrackCost::Blockage
+                                         , TrackCost::Fixed
+                                         , TrackCost::Infinite
+                                         , TrackCost::HardOverlap
+                                         , TrackCost::Overlap
+                                         , TrackCost::LeftOverlap
+                                         , TrackCost::RightOverlap
+                                         , TrackCost::OverlapGlobal
+                                         , TrackCost::GlobalEnclosed
+                                         , TrackCost::AtRipupLimit };
+
+    std::mt19937                      generator ( 42 );
+    std::uniform_int_distribution<>   candidates( 4, 28 );
+    std::uniform_int_distribution<>   small     ( 0, 3 );
+    std::uniform_int_distribution<>   length    ( 0, 20 );
+    std::bernoulli_distribution       rare      ( 0.08 );
+    std::bernoulli_distribution       half      ( 0.5 );
+
+  // Small value ranges on purpose: the candidates of a real SegmentFsm
+  // often tie on most criteria, down to the last (axis) tie-break.
+    for ( size_t ifsm=0 ; ifsm<count ; ++ifsm ) {
+      TraceFsm fsm { 0, 3, costs.size(), 0 };
+      for ( uint32_t flag : fsmFlags ) if (rare(generator)) fsm._flags |= flag;
+
+      size_t    size = candidates( generator );
+      int64_t   axis = 0;
+      for ( size_t i=0 ; i<size ; ++i ) {
+        TraceCost cost { 0, 0, 0, 0, 0, 0, 0, 0, 1 };
+        for ( uint32_t flag : costFlags ) if (rare(generator)) cost._flags |= flag;
+        cost._ripupCount      = small( generator );
+        cost._terminals       = (half(generator)) ? 0 : small( generator );
+        cost._delta           = length( generator ) * 5;
+        cost._axisWeight      = small ( generator ) * 5;
+        cost._deltaPerpand    = (half(generator)) ? 0 : length( generator ) * 5;
+        cost._distanceToFixed = (rare(generator)) ? length( generator ) * 5 : 1000;
+        cost._axis            = (axis += 5);
+        costs.push_back( cost );
+      }
+      fsm._end = costs.size();
+      fsms.push_back( fsm );
+    }
+  }
+
+
+  void  replayHeap ( const vector<TraceFsm>& fsms, const vector<TraceCost>& costs, vector<size_t>& order )
+  {
+    vector<TrackCost*> sorteds;
+    for ( const TraceFsm& fsm : fsms ) {
+      sorteds.clear();
+      for ( size_t i=fsm._begin ; i<fsm._end ; ++i ) {
+        TrackCost* cost = TrackCostBench::create();
+        TrackCostBench::init( cost, costs[i], i );
+        sorteds.push_back( cost );
+      }
+      sort( sorteds.begin(), sorteds.end(), TrackCost::Compare(fsm._flags,fsm._ripupCost) );
+      for ( TrackCost* cost : sorteds ) {
+        order.push_back( TrackCostBench::index(cost) );
+        delete cost;
+      }
+    }
+  }
+
+
+  void  replayStack ( const vector<TraceFsm>& fsms, const vector<TraceCost>& costs, vector<size_t>& order )
+  {
+    TrackCost::Stack& stack = TrackCost::getStack();
+
+    vector<TrackCost*> sorteds;
+    for ( const TraceFsm& fsm : fsms ) {
+      size_t mark = stack.mark();
+      sorteds.clear();
+      for ( size_t i=fsm._begin ; i<fsm._end ; ++i ) {
+        TrackCost* cost = stack.allocate();
+        TrackCostBench::init( cost, costs[i], i );
+        sorteds.push_back( cost );
+      }
+      sort( sorteds.begin(), sorteds.end(), TrackCost::Compare(fsm._flags,fsm._ripupCost) );
+      for ( TrackCost* cost : sorteds ) order.push_back( TrackCostBench::index(cost) );
+      stack.release( mark );
+    }
+  }
+
+
+  template< typename Replay >
+  double  bench ( const char*              name
+                , Replay                   replay
+                , const vector<TraceFsm>&  fsms
+                , const vector<TraceCost>& costs
+                , vector<size_t>&          order
+                , size_t                   repeat )
+  {
+    typedef std::chrono::steady_clock  Clock;
+
+    Clock::time_point start = Clock::now();
+    for ( size_t i=0 ; i<repeat ; ++i ) {
+      order.clear();
+      replay( fsms, costs, order );
+    }
+    double seconds = std::chrono::duration<double>( Clock::now() - start ).count();
+
+    cout << "  o  " << name << ": " << (seconds*1000.0/repeat) << " ms/replay" << endl;
+    return seconds;
+  }
+
+
+}  // Anonymous namespace.
+
+
+int  main ( int argc, char* argv[] )
+{
+  size_t repeat = (argc > 2) ? strtoul( argv[2], NULL, 10 ) : 10;
+  if (not repeat) repeat = 1;
+
+  vector<TraceFsm>  fsms;
+  vector<TraceCost> costs;
+  char*             end   = NULL;
+  size_t            count = (argc > 1) ? strtoul( argv[1], &end, 10 ) : 20000;
+  if ((argc > 1) and (*end != '\0')) {
+    if (not loadTrace( argv[1], fsms, costs )) return 1;
+  } else
+    generateTrace( count, fsms, costs );
+
+  cout << "Replaying " << fsms.size() << " SegmentFsm with "
+       << costs.size() << " TrackCosts, " << repeat << " times." << endl;
+
+  vector<size_t> heapOrder;
+  vector<size_t> stackOrder;
+  double heapTime  = bench( "new/delete  ", replayHeap , fsms, costs, heapOrder , repeat );
+  double stackTime = bench( "RecordStack ", replayStack, fsms, costs, stackOrder, repeat );
+  if (stackTime > 0.0)
+    cout << "  o  Speedup: " << (heapTime/stackTime) << endl;
+
+  if (heapOrder != stackOrder) {
+    cerr << "[ERROR] The candidates are not sorted in the same order." << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -63,6 +63,31 @@ namespace Katana {
   { return _allocateds; }
 
 
+  size_t  TrackSegment::getArenaReserved ()
+  {
+    return TrackSegmentRegular::_arena.getReserved()
+         + TrackSegmentWide   ::_arena.getReserved()
+         + TrackSegmentNonPref::_arena.getReserved();
+  }
+
+
+  size_t  TrackSegment::getArenaPeak ()
+  {
+    return TrackSegmentRegular::_arena.getPeak()
+         + TrackSegmentWide   ::_arena.getPeak()
+         + TrackSegmentNonPref::_arena.getPeak();
+  }
+
+
+  bool  TrackSegment::releaseArenas ()
+  {
+    bool released = TrackSegmentRegular::_arena.clear();
+    released = TrackSegmentWide   ::_arena.clear() and released;
+    released = TrackSegmentNonPref::_arena.clear() and released;
+    return released;
+  }
+
+
   TrackSegment::TrackSegment ( AutoSegment* segment, Track* track )
     : TrackElement  (track)
     , _base         (segment)
@@ -55,6 +55,17 @@ namespace Katana {
 // Class  :  "TrackSegmentNonPref".
 
 
+  SlabPool<TrackSegmentNonPref>  TrackSegmentNonPref::_arena;
+
+
+  void* TrackSegmentNonPref::operator new ( size_t size )
+  { return _arena.allocate( size ); }
+
+
+  void  TrackSegmentNonPref::operator delete ( void* storage, size_t size )
+  { _arena.release( storage, size ); }
+
+
   TrackSegmentNonPref::TrackSegmentNonPref ( AutoSegment* segment )
     : Super(segment,NULL)
     , _trackSpan (0)
@@ -51,6 +51,17 @@ namespace Katana {
 // Class  :  "TrackSegmentRegular".
 
 
+  SlabPool<TrackSegmentRegular>  TrackSegmentRegular::_arena;
+
+
+  void* TrackSegmentRegular::operator new ( size_t size )
+  { return _arena.allocate( size ); }
+
+
+  void  TrackSegmentRegular::operator delete ( void* storage, size_t size )
+  { _arena.release( storage, size ); }
+
+
   TrackSegmentRegular::TrackSegmentRegular ( AutoSegment* segment, Track* track )
     : Super(segment,track)
   {
@@ -52,6 +52,17 @@ namespace Katana {
 // Class  :  "TrackSegmentWide".
 
 
+  SlabPool<TrackSegmentWide>  TrackSegmentWide::_arena;
+
+
+  void* TrackSegmentWide::operator new ( size_t size )
+  { return _arena.allocate( size ); }
+
+
+  void  TrackSegmentWide::operator delete ( void* storage, size_t size )
+  { _arena.release( storage, size ); }
+
+
   TrackSegmentWide::TrackSegmentWide ( AutoSegment* segment, Track* track, size_t trackSpan )
     : Super(segment,track)
     , _trackSpan (trackSpan)
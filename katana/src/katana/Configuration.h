@@ -55,6 +55,7 @@ namespace Katana {
       enum Flag        { UseClockTree          = (1 << 0)
                        , UseGlobalEstimate     = (1 << 1)
                        , UseStaticBloatProfile = (1 << 2)
+                       , UseGlobalAStar        = (1 << 3)
                        };
     public:
     // Constructor & Destructor.
@@ -64,6 +65,7 @@ namespace Katana {
     // Decorateds.                                               
       inline        bool                       useClockTree            () const;
       inline        bool                       useGlobalEstimate       () const;
+      inline        bool                       useGlobalAStar          () const;
       inline        bool                       useStaticBloatProfile   () const;
       inline        bool                       profileEventCosts       () const;
       inline        bool                       runRealignStage         () const;
@@ -77,6 +79,8 @@ namespace Katana {
       inline        uint32_t                   getRipupCost            () const;
                     uint32_t                   getRipupLimit           ( uint32_t type ) const;
       inline        uint32_t                   getSearchHalo           () const;
+      inline        uint32_t                   getGlobalRouterThreads  () const;
+      inline        uint32_t                   getPowerRailsThreads    () const;
       inline        uint32_t                   getBloatOverloadAdd     () const;
       inline        uint32_t                   getLongWireUpThreshold1 () const;
       inline        double                     getLongWireUpReserve1   () const;
@@ -87,11 +91,15 @@ namespace Katana {
       inline        uint32_t                   getVTracksReservedMin   () const;
       inline        uint32_t                   getTermSatThreshold     () const;
       inline        uint32_t                   getTrackFill            () const;
+      inline        uint32_t                   getNegociateRegionSize  () const;
       inline        void                       setEventsLimit          ( uint64_t );
       inline        void                       setRipupCost            ( uint32_t );
                     void                       setRipupLimit           ( uint32_t limit, uint32_t type );
       inline        void                       setPostEventCb          ( PostEventCb_t );
       inline        void                       setBloatOverloadAdd     ( uint32_t );
+      inline        void                       setGlobalRouterThreads  ( uint32_t );
+      inline        void                       setNegociateRegionSize  ( uint32_t );
+      inline        void                       setPowerRailsThreads    ( uint32_t );
                     void                       setHTracksReservedLocal ( uint32_t );
                     void                       setVTracksReservedLocal ( uint32_t );
                     void                       setHTracksReservedMin   ( uint32_t );
@@ -109,6 +117,8 @@ namespace Katana {
              PostEventCb_t  _postEventCb;
              std::string    _bloat;
              uint32_t       _searchHalo;
+             uint32_t       _globalRouterThreads;
+             uint32_t       _powerRailsThreads;
              uint32_t       _longWireUpThreshold1;
              double         _longWireUpReserve1;
              uint32_t       _hTracksReservedLocal;
@@ -122,6 +132,7 @@ namespace Katana {
              uint64_t       _eventsLimit;
              uint32_t       _bloatOverloadAdd;
              uint32_t       _trackFill;
+             uint32_t       _negociateRegionSize;
              unsigned int   _flags;
              bool           _profileEventCosts;
              bool           _runRealignStage;
@@ -139,6 +150,8 @@ namespace Katana {
   inline       std::string                   Configuration::getBloat                () const { return _bloat; }
   inline       uint64_t                      Configuration::getEventsLimit          () const { return _eventsLimit; }
   inline       uint32_t                      Configuration::getSearchHalo           () const { return _searchHalo; }
+  inline       uint32_t                      Configuration::getGlobalRouterThreads  () const { return _globalRouterThreads; }
+  inline       uint32_t                      Configuration::getPowerRailsThreads    () const { return _powerRailsThreads; }
   inline       uint32_t                      Configuration::getRipupCost            () const { return _ripupCost; }
   inline       uint32_t                      Configuration::getBloatOverloadAdd     () const { return _bloatOverloadAdd; }
   inline       uint32_t                      Configuration::getLongWireUpThreshold1 () const { return _longWireUpThreshold1; }
@@ -150,12 +163,17 @@ namespace Katana {
   inline       uint32_t                      Configuration::getVTracksReservedMin   () const { return _vTracksReservedMin; }
   inline       uint32_t                      Configuration::getTermSatThreshold     () const { return _termSatThreshold; }
   inline       uint32_t                      Configuration::getTrackFill            () const { return _trackFill; }
+  inline       uint32_t                      Configuration::getNegociateRegionSize  () const { return _negociateRegionSize; }
   inline       void                          Configuration::setBloatOverloadAdd     ( uint32_t add ) { _bloatOverloadAdd = add; }
+  inline       void                          Configuration::setGlobalRouterThreads  ( uint32_t threads ) { _globalRouterThreads = threads; }
+  inline       void                          Configuration::setNegociateRegionSize  ( uint32_t size ) { _negociateRegionSize = size; }
+  inline       void                          Configuration::setPowerRailsThreads    ( uint32_t threads ) { _powerRailsThreads = threads; }
   inline       void                          Configuration::setRipupCost            ( uint32_t cost ) { _ripupCost = cost; }
   inline       void                          Configuration::setPostEventCb          ( PostEventCb_t cb ) { _postEventCb = cb; }
   inline       void                          Configuration::setEventsLimit          ( uint64_t limit ) { _eventsLimit = limit; }
   inline       bool                          Configuration::useClockTree            () const { return _flags & UseClockTree; }
   inline       bool                          Configuration::useGlobalEstimate       () const { return _flags & UseGlobalEstimate; }
+  inline       bool                          Configuration::useGlobalAStar          () const { return _flags & UseGlobalAStar; }
   inline       bool                          Configuration::useStaticBloatProfile   () const { return _flags & UseStaticBloatProfile; }
   inline       bool                          Configuration::profileEventCosts       () const { return _profileEventCosts; }
   inline       bool                          Configuration::runRealignStage         () const { return _runRealignStage; }
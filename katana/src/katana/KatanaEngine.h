@@ -24,6 +24,9 @@ namespace Hurricane {
   class Cell;
   class CellViewer;
 }
+namespace Flute {
+  class Context;
+}
 
 #include "crlcore/RoutingGauge.h"
 #include "anabatic/AnabaticEngine.h"
@@ -68,6 +71,7 @@ namespace Katana {
       inline  bool                     isDetailedRoutingSuccess   () const;
       inline  bool                     useClockTree               () const;
       inline  bool                     useGlobalEstimate          () const;
+      inline  bool                     useGlobalAStar             () const;
       inline  bool                     useStaticBloatProfile      () const;
       inline  CellViewer*              getViewer                  () const;
       inline  AnabaticEngine*          base                       ();
@@ -86,6 +90,7 @@ namespace Katana {
       inline  uint32_t                 getTermSatReservedLocal    () const;
       inline  uint32_t                 getTermSatThreshold        () const;
       inline  uint32_t                 getTrackFill               () const;
+      inline  uint32_t                 getNegociateRegionSize     () const;
       inline  bool                     profileEventCosts          () const;
       virtual const Name&              getName                    () const;
       inline  Configuration::PostEventCb_t&
@@ -133,6 +138,7 @@ namespace Katana {
               void                     analogInit                 ();
               void                     pairSymmetrics             ();
               void                     updateEstimateDensity      ( NetData*, double weight );
+              void                     updateEstimateDensities    ( const vector<NetData*>&, double weight );
               void                     runNegociate               ( Flags flags=Flags::NoFlags );
               void                     runGlobalRouter            ( Flags flags=Flags::NoFlags );
               void                     computeGlobalWireLength    ( long& wireLength, long& viaCount );
@@ -160,6 +166,7 @@ namespace Katana {
               vector<Block*>           _blocks;
               vector<RoutingPlane*>    _routingPlanes;
               NegociateWindow*         _negociateWindow;
+              Flute::Context*          _flute;
               double                   _minimumWL;
               TrackElementPairing      _shortDoglegs;
               DataSymmetricMap         _symmetrics;
@@ -182,6 +189,7 @@ namespace Katana {
   inline  bool                          KatanaEngine::isDetailedRoutingSuccess() const { return (_successState & DetailedRoutingSuccess); }
   inline  bool                          KatanaEngine::useClockTree            () const { return getConfiguration()->useClockTree(); }
   inline  bool                          KatanaEngine::useGlobalEstimate       () const { return getConfiguration()->useGlobalEstimate(); }
+  inline  bool                          KatanaEngine::useGlobalAStar          () const { return getConfiguration()->useGlobalAStar(); }
   inline  bool                          KatanaEngine::useStaticBloatProfile   () const { return getConfiguration()->useStaticBloatProfile(); }
   inline  CellViewer*                   KatanaEngine::getViewer               () const { return _viewer; }
   inline  AnabaticEngine*               KatanaEngine::base                    () { return static_cast<AnabaticEngine*>(this); }
@@ -198,6 +206,7 @@ namespace Katana {
   inline  uint32_t                      KatanaEngine::getTermSatThreshold     () const { return getConfiguration()->getTermSatThreshold(); }
   inline  uint32_t                      KatanaEngine::getRipupLimit           ( uint32_t type ) const { return getConfiguration()->getRipupLimit(type); }
   inline  uint32_t                      KatanaEngine::getTrackFill            () const { return getConfiguration()->getTrackFill(); }
+  inline  uint32_t                      KatanaEngine::getNegociateRegionSize  () const { return getConfiguration()->getNegociateRegionSize(); }
   inline  bool                          KatanaEngine::profileEventCosts       () const { return getConfiguration()->profileEventCosts(); }
   inline  const DataSymmetricMap&       KatanaEngine::getSymmetrics           () const { return _symmetrics; }
   inline  Block*                        KatanaEngine::getBlock                ( size_t i ) const { return (i < _blocks.size()) ? _blocks[i] : NULL; }
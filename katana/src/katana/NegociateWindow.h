@@ -54,13 +54,17 @@ namespace Katana {
       inline void        incGCellCount           ( size_t );
       inline void        incSegmentsCount        ( size_t );
       inline void        incEventsCount          ( size_t );
+      inline const std::vector<Statistics>&
+                         getRegions              () const;
+      inline void        addRegion               ( const Statistics& );
       inline Statistics& operator+=              ( const Statistics& );
     private:
-      size_t  _gcellsCount;
-      size_t  _segmentsCount;
-      size_t  _eventsCount;
-      size_t  _loadedEventsCount;
-      size_t  _processedEventsCount;
+      size_t                   _gcellsCount;
+      size_t                   _segmentsCount;
+      size_t                   _eventsCount;
+      size_t                   _loadedEventsCount;
+      size_t                   _processedEventsCount;
+      std::vector<Statistics>  _regions;
   };
 
 
@@ -70,6 +74,7 @@ namespace Katana {
     , _eventsCount         (0)
     , _loadedEventsCount   (0)
     , _processedEventsCount(0)
+    , _regions             ()
   { }
 
   inline size_t  Statistics::getGCellsCount          () const { return _gcellsCount; }
@@ -86,6 +91,8 @@ namespace Katana {
   inline void    Statistics::incGCellCount           ( size_t count ) { _gcellsCount += count; }
   inline void    Statistics::incSegmentsCount        ( size_t count ) { _segmentsCount += count; }
   inline void    Statistics::incEventsCount          ( size_t count ) { _eventsCount += count; }
+  inline const std::vector<Statistics>& Statistics::getRegions () const { return _regions; }
+  inline void    Statistics::addRegion               ( const Statistics& region ) { _regions.push_back( region ); }
 
   inline Statistics& Statistics::operator+= ( const Statistics& other )
   {
@@ -122,6 +129,7 @@ namespace Katana {
              void                          _computePriorities   ();
              void                          _associateSymmetrics ();
              void                          _pack                ( size_t& count, bool last );
+             void                          _negociateRegions    ();
              size_t                        _negociate           ();
              void                          _negociateRepair     ();
              Hurricane::Record*            _getRecord           () const;
@@ -136,6 +144,7 @@ namespace Katana {
       vector<GCell*>              _gcells;
       std::vector<TrackElement*>  _segments;
       RoutingEventQueue           _eventQueue;
+      RoutingEventQueue*          _activeQueue;
       RoutingEventHistory         _eventHistory;
       RoutingEventLoop            _eventLoop;
       Statistics                  _statistics;
@@ -157,7 +166,7 @@ namespace Katana {
   inline RoutingEventQueue&    NegociateWindow::getEventQueue   () { return _eventQueue; }
   inline RoutingEventHistory&  NegociateWindow::getEventHistory () { return _eventHistory; }
   inline void                  NegociateWindow::setInterrupt    ( bool state ) { _interrupt = state; }
-  inline void                  NegociateWindow::rescheduleEvent ( RoutingEvent* event, uint32_t level ) { event->reschedule(_eventQueue,level); }
+  inline void                  NegociateWindow::rescheduleEvent ( RoutingEvent* event, uint32_t level ) { event->reschedule(*_activeQueue,level); }
   inline std::string           NegociateWindow::_getTypeName    () const { return "NegociateWindow"; }
 
 
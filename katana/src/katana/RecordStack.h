@@ -0,0 +1,97 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |      K a t a n a  -  D e t a i l e d   R o u t e r              |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./katana/RecordStack.h"                        |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include <cstddef>
+#include <vector>
+
+
+namespace Katana {
+
+
+// -------------------------------------------------------------------
+// Class  :  "Katana::RecordStack".
+//
+// A stack of reusable records, stored in contiguous chunks of
+// ChunkSize elements. The records are default constructed once, when
+// their chunk is allocated, and never destroyed until the stack itself
+// is: a released record keeps it's own buffers (vectors) for the next
+// user, which must fully re-initialize it. The chunks never move, so
+// the addresses of the records remain valid until they are released.
+//
+// The users must release in LIFO order: get a mark() before pushing
+// their records and release(mark) when done with them.
+
+  template< typename T, size_t ChunkSize=128 >
+  class RecordStack {
+    public:
+      inline         RecordStack  ();
+      inline        ~RecordStack  ();
+      inline size_t  mark         () const;
+      inline size_t  getCapacity  () const;
+      inline T*      allocate     ();
+      inline void    release      ( size_t mark );
+    private:
+                     RecordStack  ( const RecordStack& ) = delete;
+      RecordStack&   operator=    ( const RecordStack& ) = delete;
+    private:
+      std::vector<T*>  _chunks;
+      size_t           _size;
+  };
+
+
+  template< typename T, size_t ChunkSize >
+  inline RecordStack<T,ChunkSize>::RecordStack ()
+    : _chunks()
+    , _size  (0)
+  { }
+
+
+  template< typename T, size_t ChunkSize >
+  inline RecordStack<T,ChunkSize>::~RecordStack ()
+  {
+    for ( T* chunk : _chunks ) delete [] chunk;
+  }
+
+
+  template< typename T, size_t ChunkSize >
+  inline size_t  RecordStack<T,ChunkSize>::mark () const
+  { return _size; }
+
+
+  template< typename T, size_t ChunkSize >
+  inline size_t  RecordStack<T,ChunkSize>::getCapacity () const
+  { return _chunks.size() * ChunkSize; }
+
+
+  template< typename T, size_t ChunkSize >
+  inline T* RecordStack<T,ChunkSize>::allocate ()
+  {
+    if (_size == getCapacity()) _chunks.push_back( new T [ChunkSize] );
+    T* record = &(_chunks[ _size / ChunkSize ][ _size % ChunkSize ]);
+    ++_size;
+    return record;
+  }
+
+
+  template< typename T, size_t ChunkSize >
+  inline void  RecordStack<T,ChunkSize>::release ( size_t mark )
+  {
+    if (mark < _size) _size = mark;
+  }
+
+
+}  // Katana namespace.
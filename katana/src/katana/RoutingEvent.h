@@ -61,8 +61,9 @@ namespace Katana {
           };
 
         public:
-                Key    ( const RoutingEvent* );
-          void  update ( const RoutingEvent* );
+                            Key           ( const RoutingEvent* );
+                  void      update        ( const RoutingEvent* );
+          inline  uint32_t  getEventLevel () const;
         private:
           unsigned int  _tracksNb  :16;
           unsigned int  _rpDistance: 4;
@@ -90,6 +91,7 @@ namespace Katana {
           inline bool  operator() ( const RoutingEvent* lhs, const RoutingEvent* rhs ) const;
       };
     friend class Compare;
+    friend class RoutingEventQueue;
 
     public:
       static  uint32_t                     getStage              ();
@@ -97,6 +99,7 @@ namespace Katana {
       static  uint32_t                     getProcesseds         ();
       static  uint32_t                     getCloneds            ();
       static  void                         resetProcesseds       ();
+      static  void                         releasePool           ();
     public:                                                      
       static  RoutingEvent*                create                ( TrackElement* );
               RoutingEvent*                clone                 () const;
@@ -167,6 +170,8 @@ namespace Katana {
 
     protected:
     // Attributes.
+      class Pool;
+      static Pool           _pool;
       static uint32_t       _idCounter;
       static uint32_t       _stage;
       static uint32_t       _allocateds;
@@ -195,10 +200,13 @@ namespace Katana {
       uint32_t              _eventLevel;
     //vector<TrackElement*> _perpandiculars;
       Key                   _key;
+      uint64_t              _queueStamp;
+      bool                  _pushRequested;
   };
 
 
 // Inline Functions.
+  inline uint32_t                      RoutingEvent::Key::getEventLevel      () const { return _eventLevel; }
   inline bool                          RoutingEvent::isCloned                () const { return _cloned; }
   inline bool                          RoutingEvent::isProcessed             () const { return _processed; }
   inline bool                          RoutingEvent::isDisabled              () const { return _disabled; }
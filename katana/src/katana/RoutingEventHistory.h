@@ -42,6 +42,7 @@ namespace Katana {
               RoutingEvent* getNth              ( size_t ) const;
               RoutingEvent* getRNth             ( size_t ) const;
               void          push                ( RoutingEvent* );
+              void          append              ( RoutingEventHistory& );
               void          clear               ();
               void          dump                ( ostream&, size_t depth=10 ) const;
               Record*       _getRecord          () const;
@@ -31,8 +31,29 @@ namespace Katana {
 
 // -------------------------------------------------------------------
 // Class  :  "RoutingEventQueue".
+//
+// The events are bucketed by event level, each bucket being a binary
+// heap ordered by RoutingEvent::Key::Compare. A copy of the key is
+// stored along with the event, so an event can be re-keyed while still
+// in the queue: it's entry is only invalidated (the event stamp no
+// longer matches) and lazily discarded by pop(). Equal keys are ordered
+// by insertion, the latest first, so the pop order is the one of the
+// former multiset.
 
   class RoutingEventQueue {
+    private:
+      class Entry {
+        public:
+          inline  Entry ( RoutingEvent*, uint64_t stamp );
+        public:
+          RoutingEvent::Key  _key;
+          RoutingEvent*      _event;
+          uint64_t           _stamp;
+      };
+      class EntryCompare {
+        public:
+          inline bool  operator() ( const Entry& lhs, const Entry& rhs ) const;
+      };
 
     public:
                             RoutingEventQueue  ();
@@ -51,15 +72,22 @@ namespace Katana {
               void          clear              ();
               void          dump               () const;
               void          _keyCheck          () const;
+              void          _getSorteds        ( vector<RoutingEvent*>& ) const;
               Record*       _getRecord         () const;
               string        _getString         () const;
       inline  string        _getTypeName       () const;
 
+    protected:
+              void          _insert            ( RoutingEvent* );
+
     protected:
     // Attributes.
-      uint32_t                                       _topEventLevel;
-      RoutingEventSet                                _pushRequests;
-      multiset<RoutingEvent*,RoutingEvent::Compare>  _events;
+      uint32_t                 _topEventLevel;
+      vector<RoutingEvent*>    _pushRequests;
+      vector< vector<Entry> >  _buckets;
+      uint32_t                 _topBucket;
+      size_t                   _size;
+      uint64_t                 _stamp;
 
     private:
               RoutingEventQueue& operator=         ( const RoutingEventQueue& );
@@ -69,11 +97,31 @@ namespace Katana {
 
 
 // Inline Functions.
-  inline bool      RoutingEventQueue::empty            () const { return _events.empty(); }
-  inline size_t    RoutingEventQueue::size             () const { return _events.size(); }
+  inline RoutingEventQueue::Entry::Entry ( RoutingEvent* event, uint64_t stamp )
+    : _key  (event->getKey())
+    , _event(event)
+    , _stamp(stamp)
+  { }
+
+  inline bool  RoutingEventQueue::EntryCompare::operator() ( const Entry& lhs, const Entry& rhs ) const
+  {
+    static RoutingEvent::Key::Compare  keyCompare;
+    if (keyCompare( lhs._key, rhs._key )) return true;
+    if (keyCompare( rhs._key, lhs._key )) return false;
+    return lhs._stamp < rhs._stamp;
+  }
+
+  inline bool      RoutingEventQueue::empty            () const { return _size == 0; }
+  inline size_t    RoutingEventQueue::size             () const { return _size; }
   inline uint32_t  RoutingEventQueue::getTopEventLevel () const { return _topEventLevel; }
   inline string    RoutingEventQueue::_getTypeName     () const { return "EventQueue"; }
-  inline void      RoutingEventQueue::push             ( RoutingEvent* event ) { _pushRequests.insert( event ); }
+
+  inline void  RoutingEventQueue::push ( RoutingEvent* event )
+  {
+    if (event->_pushRequested) return;
+    event->_pushRequested = true;
+    _pushRequests.push_back( event );
+  }
 
 
 }  // Katana namespace.
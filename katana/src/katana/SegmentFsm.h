@@ -187,6 +187,7 @@ namespace Katana {
       Interval                      _constraint;
       Interval                      _optimal;
       vector<TrackCost*>            _costs;
+      size_t                        _costsMark;
       vector<SegmentAction>         _actions;
       bool                          _fullBlocked;
       bool                          _sameAxis;
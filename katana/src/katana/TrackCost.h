@@ -17,7 +17,10 @@
 #pragma  once
 #include <string>
 #include <tuple>
+#include <vector>
+#include <iosfwd>
 #include "hurricane/Interval.h"
+#include "katana/RecordStack.h"
 namespace Hurricane {
   class Net;
 }
@@ -75,13 +78,28 @@ namespace Katana {
       };
       class Compare {
         public:
-          inline       Compare    ( uint32_t flags=0 );
+                       Compare    ( uint32_t flags=0 );
+                       Compare    ( uint32_t flags, int ripupCost );
                  bool  operator() ( const TrackCost* lhs, const TrackCost* rhs );
         private:
           uint32_t _flags;
+          int      _ripupCost;
       };
+      typedef  RecordStack<TrackCost>  Stack;
 
     public:
+      static       Stack&        getStack            ();
+      static       void          openTrace           ( const string& path );
+      static       void          closeTrace          ();
+      static inline bool         hasTrace            ();
+      static       void          trace               ( const std::vector<TrackCost*>&, uint32_t flags, int ripupCost );
+      static       TrackCost*    push                ( TrackElement* refSegment
+                                                     , TrackElement* symSegment
+                                                     , Track*        refTrack
+                                                     , Track*        symTrack
+                                                     , DbU::Unit     refCandidateAxis
+                                                     , DbU::Unit     symCandidateAxis
+                                                     );
                                  TrackCost           ( TrackElement* refSegment
                                                      , TrackElement* symSegment
                                                      , Track*        refTrack
@@ -168,14 +186,27 @@ namespace Katana {
                    string        _getString          () const;
       inline       string        _getTypeName        () const;
     private:                                         
+                                 TrackCost           ();
+                   void          _init               ( TrackElement* refSegment
+                                                     , TrackElement* symSegment
+                                                     , Track*        refTrack
+                                                     , Track*        symTrack
+                                                     , DbU::Unit     refCandidateAxis
+                                                     , DbU::Unit     symCandidateAxis
+                                                     );
                                  TrackCost           ( const TrackCost& ) = delete;
                    TrackCost&    operator=           ( const TrackCost& ) = delete;
+                   void          _trace              ( std::ostream& ) const;
+      template< typename, size_t > friend class RecordStack;
+      friend class TrackCostBench;
     // Attributes.
     private:
+      static std::ostream* _traceStream;
       uint32_t      _flags;
       size_t        _span;
       DbU::Unit     _refCandidateAxis;
       DbU::Unit     _symCandidateAxis;
+      DbU::Unit     _trackAxis;
       std::vector< std::tuple<Track*,size_t,size_t> >
                     _tracks;
       TrackElement* _segment1;
@@ -198,6 +229,7 @@ namespace Katana {
 
 
 // Inline Functions.
+  inline       bool          TrackCost::hasTrace            () { return (_traceStream != NULL); }
   inline       bool          TrackCost::isForGlobal         () const { return _flags & ForGlobal; }
   inline       bool          TrackCost::isBlockage          () const { return _flags & Blockage; }
   inline       bool          TrackCost::isAnalog            () const { return _flags & Analog; }
@@ -262,9 +294,6 @@ namespace Katana {
   inline       string        TrackCost::_getTypeName        () const { return "TrackCost"; }
 
 
-  inline  TrackCost::Compare::Compare ( uint32_t flags ) : _flags(flags) { }
-
-
   inline  Track* TrackCost::getTrack () const
   {
     // cdebug_log( 55,0) << "TrackCost::getTrack() _index:" << _selectIndex
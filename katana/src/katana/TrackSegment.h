@@ -17,6 +17,7 @@
 #pragma  once
 #include <set>
 #include <functional>
+#include "anabatic/SlabPool.h"
 #include "katana/TrackElement.h"
 
 
@@ -32,6 +33,7 @@ namespace Katana {
   using Hurricane::Net;
   using Hurricane::Layer;
   using Anabatic::AutoSegment;
+  using Anabatic::SlabPool;
 
   class DataNegociate;
   class Track;
@@ -56,6 +58,9 @@ namespace Katana {
     public:
       static  TrackElement*         create                 ( AutoSegment*, Track*, bool& created );
       static  size_t                getAllocateds          ();
+      static  size_t                getArenaReserved       ();
+      static  size_t                getArenaPeak           ();
+      static  bool                  releaseArenas          ();
     public:                                                
     // Wrapped AutoSegment Functions (when applicable).
       virtual AutoSegment*          base                   () const;
@@ -50,6 +50,8 @@ namespace Katana {
     protected:
                                    TrackSegmentNonPref ( AutoSegment* ) ;
       virtual                     ~TrackSegmentNonPref ();
+      static  void*                operator new        ( size_t );
+      static  void                 operator delete     ( void*, size_t );
       virtual void                 _postCreate         ();
       virtual void                 _preDestroy         ();
       virtual bool                 isNonPref           () const;
@@ -65,6 +67,8 @@ namespace Katana {
     private:
       size_t    _trackSpan;
       uint32_t  _trackCount;
+    private:
+      static SlabPool<TrackSegmentNonPref>  _arena;
   };
 
 
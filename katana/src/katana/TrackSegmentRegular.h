@@ -50,6 +50,8 @@ namespace Katana {
     protected:
                                    TrackSegmentRegular ( AutoSegment*, Track* ) ;
       virtual                     ~TrackSegmentRegular ();
+      static  void*                operator new        ( size_t );
+      static  void                 operator delete     ( void*, size_t );
       virtual void                 _postCreate         ();
       virtual void                 _preDestroy         ();
       virtual size_t               getTrackSpan        () const;
@@ -57,6 +59,8 @@ namespace Katana {
     private:
                                    TrackSegmentRegular ( const TrackSegmentRegular& ) = delete;
               TrackSegmentRegular& operator=           ( const TrackSegmentRegular& ) = delete;
+    private:
+      static SlabPool<TrackSegmentRegular>  _arena;
   };
 
 
@@ -50,6 +50,8 @@ namespace Katana {
     protected:
                                 TrackSegmentWide ( AutoSegment*, Track*, size_t trackSpan=0 ) ;
       virtual                  ~TrackSegmentWide ();
+      static  void*             operator new     ( size_t );
+      static  void              operator delete  ( void*, size_t );
       virtual void              _postCreate      ();
       virtual void              _preDestroy      ();
       virtual size_t            getTrackSpan     () const;
@@ -62,6 +64,8 @@ namespace Katana {
     private:
       size_t    _trackSpan;
       uint32_t  _trackCount;
+    private:
+      static SlabPool<TrackSegmentWide>  _arena;
   };
 
 
@@ -0,0 +1,117 @@
+// -*- mode: C++; explicit-buffer-name: "Configuration.cpp<sirocco>" -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024.
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |         S i r o c c o  -  Static Timing Analysis                |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :       "./Configuration.cpp"                      |
+// +-----------------------------------------------------------------+
+
+
+#include <iostream>
+#include <iomanip>
+#include "hurricane/configuration/Configuration.h"
+#include "hurricane/Cell.h"
+#include "crlcore/Utilities.h"
+#include "sirocco/Configuration.h"
+
+
+namespace Sirocco {
+
+  using  std::cout;
+  using  std::endl;
+  using  std::ostringstream;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Sirocco::Configuration".
+
+  Configuration::Configuration ()
+    : _libertyFile    ( Cfg::getParamString("sirocco.libertyFile"    ,    "")->asString() )
+    , _clockPeriod    ( Cfg::getParamDouble("sirocco.clockPeriod"    ,  10.0)->asDouble() * 1e-9  )
+    , _clockSlew      ( Cfg::getParamDouble("sirocco.clockSlew"      ,  0.05)->asDouble() * 1e-9  )
+    , _inputSlew      ( Cfg::getParamDouble("sirocco.inputSlew"      ,  0.05)->asDouble() * 1e-9  )
+    , _inputDelay     ( Cfg::getParamDouble("sirocco.inputDelay"     ,   0.0)->asDouble() * 1e-9  )
+    , _outputDelay    ( Cfg::getParamDouble("sirocco.outputDelay"    ,   0.0)->asDouble() * 1e-9  )
+    , _outputLoad     ( Cfg::getParamDouble("sirocco.outputLoad"     ,  10.0)->asDouble() * 1e-15 )
+    , _wireResistance ( Cfg::getParamDouble("sirocco.wireResistance" ,   0.1)->asDouble()         )
+    , _wireCapacitance( Cfg::getParamDouble("sirocco.wireCapacitance",   0.2)->asDouble() * 1e-15 )
+    , _threads        ( Cfg::getParamInt   ("sirocco.threads"        ,     1)->asInt   ()         )
+  { }
+
+
+  Configuration::Configuration ( const Configuration& other )
+    : _libertyFile    ( other._libertyFile     )
+    , _clockPeriod    ( other._clockPeriod     )
+    , _clockSlew      ( other._clockSlew       )
+    , _inputSlew      ( other._inputSlew       )
+    , _inputDelay     ( other._inputDelay      )
+    , _outputDelay    ( other._outputDelay     )
+    , _outputLoad     ( other._outputLoad      )
+    , _wireResistance ( other._wireResistance  )
+    , _wireCapacitance( other._wireCapacitance )
+    , _threads        ( other._threads         )
+  { }
+
+
+  Configuration::~Configuration ()
+  { }
+
+
+  Configuration* Configuration::clone () const { return new Configuration(*this); }
+
+
+  void  Configuration::print ( Cell* cell ) const
+  {
+    cmess1 << "  o  Configuration of ToolEngine<Sirocco> for Cell <" << cell->getName() << ">" << endl;
+    cmess1 << Dots::asString( "     - Liberty file"               ,_libertyFile            ) << endl;
+    cmess1 << Dots::asDouble( "     - Clock period (ns)"          ,_clockPeriod    *1e+9   ) << endl;
+    cmess1 << Dots::asDouble( "     - Clock slew (ns)"            ,_clockSlew      *1e+9   ) << endl;
+    cmess1 << Dots::asDouble( "     - Input slew (ns)"            ,_inputSlew      *1e+9   ) << endl;
+    cmess1 << Dots::asDouble( "     - Input delay (ns)"           ,_inputDelay     *1e+9   ) << endl;
+    cmess1 << Dots::asDouble( "     - Output delay (ns)"          ,_outputDelay    *1e+9   ) << endl;
+    cmess1 << Dots::asDouble( "     - Output load (fF)"           ,_outputLoad     *1e+15  ) << endl;
+    cmess1 << Dots::asDouble( "     - Wire resistance (Ohm/um)"   ,_wireResistance         ) << endl;
+    cmess1 << Dots::asDouble( "     - Wire capacitance (fF/um)"   ,_wireCapacitance*1e+15  ) << endl;
+    cmess1 << Dots::asUInt  ( "     - Threads"                    ,_threads                ) << endl;
+  }
+
+
+  string  Configuration::_getTypeName () const
+  { return "Sirocco::Configuration"; }
+
+
+  string  Configuration::_getString () const
+  {
+    ostringstream  os;
+
+    os << "<" << _getTypeName() << ">";
+
+    return os.str();
+  }
+
+
+  Record* Configuration::_getRecord () const
+  {
+    Record* record = new Record ( _getString() );
+    record->add( getSlot( "_libertyFile"    , _libertyFile     ) );
+    record->add( getSlot( "_clockPeriod"    , _clockPeriod     ) );
+    record->add( getSlot( "_clockSlew"      , _clockSlew       ) );
+    record->add( getSlot( "_inputSlew"      , _inputSlew       ) );
+    record->add( getSlot( "_inputDelay"     , _inputDelay      ) );
+    record->add( getSlot( "_outputDelay"    , _outputDelay     ) );
+    record->add( getSlot( "_outputLoad"     , _outputLoad      ) );
+    record->add( getSlot( "_wireResistance" , _wireResistance  ) );
+    record->add( getSlot( "_wireCapacitance", _wireCapacitance ) );
+    record->add( getSlot( "_threads"        , _threads         ) );
+    return record;
+  }
+
+
+}  // Sirocco namespace.
@@ -0,0 +1,555 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |         S i r o c c o  -  Static Timing Analysis                |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./IncrementalBench.cpp"                        |
+// +-----------------------------------------------------------------+
+//
+// Build a synthetic placed design (random netlist of inverters, nands,
+// buffers & flip-flops with a generated Liberty library), then apply
+// random edits as an optimization loop would (inverter resizing,
+// buffer insertion on a net, re-routing of a net), querying the timing
+// after each one. Report the incremental update times against the
+// full propagations run at each check point, and check that the
+// incremental results are identical to the full recompute ones.
+//
+// Usage:  incremental-timing-bench [instances] [edits] [seed]
+
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <unistd.h>
+#include "hurricane/Error.h"
+#include "hurricane/DataBase.h"
+#include "hurricane/Technology.h"
+#include "hurricane/BasicLayer.h"
+#include "hurricane/Library.h"
+#include "hurricane/Cell.h"
+#include "hurricane/Instance.h"
+#include "hurricane/Net.h"
+#include "hurricane/NetExternalComponents.h"
+#include "hurricane/Plug.h"
+#include "hurricane/Contact.h"
+#include "hurricane/Horizontal.h"
+#include "hurricane/Vertical.h"
+#include "hurricane/RoutingPad.h"
+#include "hurricane/UpdateSession.h"
+#include "sirocco/Configuration.h"
+#include "sirocco/Liberty.h"
+#include "sirocco/TimingGraph.h"
+
+
+namespace {
+
+  using namespace std;
+  using namespace Hurricane;
+  using Sirocco::Configuration;
+  using Sirocco::Liberty;
+  using Sirocco::TimingGraph;
+
+  typedef std::chrono::steady_clock  Clock;
+
+
+  double  elapsed ( Clock::time_point start )
+  { return std::chrono::duration<double>( Clock::now() - start ).count() * 1000.0; }
+
+
+// Two sizes of inverter with the same pins (resizing keeps the nodes),
+// a buffer, a nand and a flip-flop. Tables are 2x2, slew x load.
+  const char* libertySource =
+    "library (bench) {\n"
+    "  time_unit : \"1ns\" ;\n"
+    "  capacitive_load_unit (1,pf) ;\n"
+    "  lu_table_template (delay_2x2) {\n"
+    "    variable_1 : input_net_transition ;\n"
+    "    variable_2 : total_output_net_capacitance ;\n"
+    "    index_1 (\"0.01, 0.5\") ;\n"
+    "    index_2 (\"0.001, 0.1\") ;\n"
+    "  }\n"
+    "  lu_table_template (setup_2x2) {\n"
+    "    variable_1 : constrained_pin_transition ;\n"
+    "    variable_2 : related_pin_transition ;\n"
+    "    index_1 (\"0.01, 0.5\") ;\n"
+    "    index_2 (\"0.01, 0.5\") ;\n"
+    "  }\n"
+    "%CELLS%"
+    "}\n";
+
+
+  string  timingGroup ( const string& related, const string& sense, double k )
+  {
+    auto table = [&]( const char* name, double base, double slope ) {
+                   char buffer[256];
+                   snprintf( buffer, 256
+                           , "        %s (delay_2x2) { values (\"%.4f, %.4f\", \"%.4f, %.4f\") ; }\n"
+                           , name
+                           , base*k        , (base+slope)*k
+                           , (base+0.05)*k , (base+0.05+slope)*k );
+                   return string( buffer );
+                 };
+    return "      timing () {\n"
+           "        related_pin : \"" + related + "\" ;\n"
+           "        timing_sense : " + sense + " ;\n"
+         + table( "cell_rise"      , 0.020, 1.2 )
+         + table( "cell_fall"      , 0.015, 1.0 )
+         + table( "rise_transition", 0.010, 2.0 )
+         + table( "fall_transition", 0.008, 1.6 )
+         + "      }\n";
+  }
+
+
+  string  writeLiberty ()
+  {
+    string cells;
+    auto inverter = [&]( const string& name, double capacitance, double k ) {
+                      cells += "  cell (" + name + ") {\n"
+                               "    pin (i)  { direction : input ; capacitance : " + to_string(capacitance) + " ; }\n"
+                               "    pin (nq) { direction : output ;\n"
+                             + timingGroup( "i", "negative_unate", k )
+                             + "    }\n  }\n";
+                    };
+    inverter( "inv_x1", 0.002, 1.0  );
+    inverter( "inv_x4", 0.006, 0.35 );
+    cells += "  cell (buf_x2) {\n"
+             "    pin (i) { direction : input ; capacitance : 0.002 ; }\n"
+             "    pin (q) { direction : output ;\n"
+           + timingGroup( "i", "positive_unate", 0.6 )
+           + "    }\n  }\n";
+    cells += "  cell (na2_x1) {\n"
+             "    pin (i0) { direction : input ; capacitance : 0.0025 ; }\n"
+             "    pin (i1) { direction : input ; capacitance : 0.0025 ; }\n"
+             "    pin (nq) { direction : output ;\n"
+           + timingGroup( "i0", "negative_unate", 1.2 )
+           + timingGroup( "i1", "negative_unate", 1.3 )
+           + "    }\n  }\n";
+    string edge = timingGroup( "ck", "non_unate", 1.5 );
+    edge.insert( edge.find("timing_sense"), "timing_type : rising_edge ;\n        " );
+    cells += "  cell (sff1_x4) {\n"
+             "    ff (IQ,IQN) { next_state : \"i\" ; clocked_on : \"ck\" ; }\n"
+             "    pin (ck) { direction : input ; clock : true ; capacitance : 0.003 ; }\n"
+             "    pin (i)  { direction : input ; capacitance : 0.002 ;\n"
+             "      timing () {\n"
+             "        related_pin : \"ck\" ;\n"
+             "        timing_type : setup_rising ;\n"
+             "        rise_constraint (setup_2x2) { values (\"0.05, 0.08\", \"0.09, 0.12\") ; }\n"
+             "        fall_constraint (setup_2x2) { values (\"0.06, 0.09\", \"0.10, 0.13\") ; }\n"
+             "      }\n"
+             "    }\n"
+             "    pin (q)  { direction : output ;\n"
+           + edge
+           + "    }\n  }\n";
+
+    string source = libertySource;
+    source.replace( source.find("%CELLS%"), 7, cells );
+
+    char path[] = "/tmp/incremental-bench-XXXXXX";
+    int  fd     = mkstemp( path );
+    if (fd < 0) throw Error( "writeLiberty(): Cannot create a temporary file." );
+    close( fd );
+    ofstream( path ) << source;
+    return path;
+  }
+
+
+  class Design {
+    public:
+                   Design         ( size_t instanceCount, unsigned int seed );
+      Instance*    getInstance    ();
+      Net*         getNet         ();
+      void         connect        ( Plug*, Net* );
+      void         resize         ( Instance* );
+      Instance*    insertBuffer   ( Net* );
+      void         reroute        ( Net* );
+    private:
+      Cell*        buildLeaf      ( const char* name, vector<const char*> inputs, vector<const char*> outputs );
+      Net*         getOutput      ( Instance* );
+    public:
+      std::mt19937       _random;
+      Library*           _library;
+      Cell*              _top;
+      Net*               _clock;
+      Layer*             _metal1;
+      Layer*             _metal2;
+      vector<Cell*>      _leafs;
+      vector<Instance*>  _instances;
+      vector<Net*>       _nets;
+      size_t             _columns;
+  };
+
+
+  Design::Design ( size_t instanceCount, unsigned int seed )
+    : _random   (seed)
+    , _library  (NULL)
+    , _top      (NULL)
+    , _clock    (NULL)
+    , _metal1   (NULL)
+    , _metal2   (NULL)
+    , _leafs    ()
+    , _instances()
+    , _nets     ()
+    , _columns  (std::max( (size_t)1, (size_t)std::sqrt(instanceCount*2.5) ))
+  {
+  // One lambda is 0.09um, a cell is then 1.8um x 4.5um.
+    DbU::setPhysicalsPerGrid( 0.005, DbU::Micro );
+    DbU::setGridsPerLambda  ( 18.0 , DbU::NoTechnoUpdate );
+
+    DataBase*   db   = DataBase::create();
+    Technology* tech = Technology::create( db, "bench" );
+    _metal1 = BasicLayer::create( tech, "METAL1", BasicLayer::Material::metal );
+    _metal2 = BasicLayer::create( tech, "METAL2", BasicLayer::Material::metal );
+    _library = Library::create( Library::create(db,"root"), "bench" );
+
+    UpdateSession::open();
+    _leafs.push_back( buildLeaf( "inv_x1" , { "i" }       , { "nq" } ));
+    _leafs.push_back( buildLeaf( "inv_x4" , { "i" }       , { "nq" } ));
+    _leafs.push_back( buildLeaf( "buf_x2" , { "i" }       , { "q"  } ));
+    _leafs.push_back( buildLeaf( "na2_x1" , { "i0", "i1" }, { "nq" } ));
+    _leafs.push_back( buildLeaf( "sff1_x4", { "ck", "i" } , { "q"  } ));
+
+    _top   = Cell::create( _library, "top" );
+    _clock = Net::create( _top, "ck" );
+    _clock->setExternal( true );
+    _clock->setType    ( Net::Type::CLOCK );
+
+    vector<Net*> inputs;
+    for ( size_t i=0 ; i<32 ; ++i ) {
+      inputs.push_back( Net::create( _top, "in_" + getString(i) ));
+      inputs.back()->setExternal( true );
+    }
+
+  // Each instance reads nets driven by one of the 200 previous ones (or
+  // a primary input), so the netlist is mostly local and, thanks to the
+  // flip-flops, the logic depth stays reasonable.
+    std::discrete_distribution<size_t> kinds ( { 50, 10, 10, 20, 10 } );
+    for ( size_t i=0 ; i<instanceCount ; ++i ) {
+      Cell*     master   = _leafs[ kinds(_random) ];
+      Instance* instance = Instance::create( _top
+                                           , "i_" + getString(i)
+                                           , master
+                                           , Transformation( DbU::fromLambda(20.0*(i % _columns))
+                                                           , DbU::fromLambda(50.0*(i / _columns)) )
+                                           , Instance::PlacementStatus::PLACED );
+      for ( Net* masterNet : master->getNets() ) {
+        Plug* plug = instance->getPlug( masterNet );
+        if (masterNet->getDirection() & Net::Direction::OUT) {
+          Net* net = Net::create( _top, "n_" + getString(i) );
+          _nets.push_back( net );
+          connect( plug, net );
+          continue;
+        }
+        if (masterNet->getName() == "ck") { plug->setNet( _clock ); continue; }
+        size_t window = std::min( _instances.size(), (size_t)200 );
+        if (not window or (_random() % 20 == 0)) {
+          connect( plug, inputs[ _random() % inputs.size() ] );
+          continue;
+        }
+        connect( plug, getOutput( _instances[ _instances.size() - 1 - (_random() % window) ] ));
+      }
+      _instances.push_back( instance );
+    }
+    for ( size_t i=0 ; i<std::min(instanceCount,(size_t)64) ; ++i )
+      getOutput( _instances[_instances.size()-1-i] )->setExternal( true );
+    UpdateSession::close();
+  }
+
+
+  Cell* Design::buildLeaf ( const char* name, vector<const char*> inputs, vector<const char*> outputs )
+  {
+    Cell* leaf = Cell::create( _library, name );
+    leaf->setAbutmentBox( Box( 0, 0, DbU::fromLambda(20.0), DbU::fromLambda(50.0) ) );
+
+    size_t count = 0;
+    for ( auto names : { &inputs, &outputs } ) {
+      for ( const char* pinName : *names ) {
+        Net* net = Net::create( leaf, pinName );
+        net->setExternal ( true );
+        net->setDirection( (names == &outputs) ? Net::Direction::OUT : Net::Direction::IN );
+        DbU::Unit x      = DbU::fromLambda( 3.0 + 5.0*count++ );
+        Contact*  bottom = Contact::create( net, _metal1, x, DbU::fromLambda(10.0), DbU::fromLambda(2.0), DbU::fromLambda(2.0) );
+        Contact*  top    = Contact::create( net, _metal1, x, DbU::fromLambda(40.0), DbU::fromLambda(2.0), DbU::fromLambda(2.0) );
+        NetExternalComponents::setExternal( Vertical::create( bottom, top, _metal1, x, DbU::fromLambda(2.0) ));
+      }
+    }
+    leaf->setTerminalNetlist( true );
+    return leaf;
+  }
+
+
+  Net* Design::getOutput ( Instance* instance )
+  {
+    for ( Plug* plug : instance->getConnectedPlugs() ) {
+      if (plug->getMasterNet()->getDirection() & Net::Direction::OUT) return plug->getNet();
+    }
+    return NULL;
+  }
+
+
+  void  Design::connect ( Plug* plug, Net* net )
+  {
+    plug->setNet( net );
+    RoutingPad::create( net, Occurrence(plug), RoutingPad::BiggestArea );
+  }
+
+
+  Instance* Design::getInstance ()
+  { return _instances[ _random() % _instances.size() ]; }
+
+
+  Net* Design::getNet ()
+  { return _nets[ _random() % _nets.size() ]; }
+
+
+// Swap inv_x1 & inv_x4, the RoutingPads are moved on the new master.
+  void  Design::resize ( Instance* instance )
+  {
+    Cell* master = instance->getMasterCell();
+    if      (master == _leafs[0]) master = _leafs[1];
+    else if (master == _leafs[1]) master = _leafs[0];
+    else return;
+
+    UpdateSession::open();
+    vector<Plug*> plugs;
+    for ( Plug* plug : instance->getConnectedPlugs() ) plugs.push_back( plug );
+    for ( Plug* plug : plugs ) {
+      vector<RoutingPad*> rps;
+      for ( RoutingPad* rp : plug->getNet()->getRoutingPads() ) {
+        if (rp->getOccurrence().getPath().getTailInstance() == instance) rps.push_back( rp );
+      }
+      for ( RoutingPad* rp : rps ) rp->destroy();
+    }
+    instance->setMasterCell( master );
+    for ( Plug* plug : plugs ) {
+      if (plug->getNet() != _clock)
+        RoutingPad::create( plug->getNet(), Occurrence(plug), RoutingPad::BiggestArea );
+    }
+    UpdateSession::close();
+  }
+
+
+// Split the sinks of net in two halves, the second one being driven
+// through a new buffer placed over the driver.
+  Instance* Design::insertBuffer ( Net* net )
+  {
+    vector<Plug*> sinks;
+    Instance*     driver = NULL;
+    for ( Plug* plug : net->getPlugs() ) {
+      if (plug->getMasterNet()->getDirection() & Net::Direction::OUT) driver = plug->getInstance();
+      else sinks.push_back( plug );
+    }
+    if (not driver or (sinks.size() < 2)) return NULL;
+
+    UpdateSession::open();
+    string    name   = "buf_" + getString( _instances.size() );
+    Instance* buffer = Instance::create( _top, name, _leafs[2], driver->getTransformation()
+                                       , Instance::PlacementStatus::PLACED );
+    Net*      output = Net::create( _top, name + "_q" );
+    connect( buffer->getPlug( _leafs[2]->getNet("i") ), net    );
+    connect( buffer->getPlug( _leafs[2]->getNet("q") ), output );
+    for ( size_t i=sinks.size()/2 ; i<sinks.size() ; ++i ) {
+      vector<RoutingPad*> rps;
+      for ( RoutingPad* rp : net->getRoutingPads() ) {
+        if (rp->getOccurrence().getPath().getTailInstance() == sinks[i]->getInstance()) rps.push_back( rp );
+      }
+      for ( RoutingPad* rp : rps ) rp->destroy();
+      connect( sinks[i], output );
+    }
+    UpdateSession::close();
+
+    _instances.push_back( buffer );
+    _nets.push_back( output );
+    return buffer;
+  }
+
+
+// Replace the wiring of the net by a single segment of random length.
+  void  Design::reroute ( Net* net )
+  {
+    UpdateSession::open();
+    vector<Component*> segments;
+    for ( Component* component : net->getComponents() ) {
+      if (dynamic_cast<Horizontal*>(component)) segments.push_back( component );
+    }
+    for ( Component* segment : segments ) segment->destroy();
+    Horizontal::create( net, _metal2, 0, DbU::fromLambda(2.0), 0, DbU::fromLambda( 10.0 + (_random() % 2000) ));
+    UpdateSession::close();
+  }
+
+
+// Compare all the times of the graph against a full propagation,
+// whose duration is returned in fullTime.
+  size_t  checkFull ( TimingGraph& graph, double& fullTime )
+  {
+    size_t         count = graph.getNodesCount();
+    vector<double> values;
+    values.reserve( 6*count );
+    for ( uint32_t node=0 ; node<count ; ++node ) {
+      for ( auto edge : { TimingGraph::Rise, TimingGraph::Fall } ) {
+        values.push_back( graph.getArrival (node,edge) );
+        values.push_back( graph.getSlew    (node,edge) );
+        values.push_back( graph.getRequired(node,edge) );
+      }
+    }
+    Clock::time_point start = Clock::now();
+    graph.propagate();
+    fullTime = elapsed( start );
+
+    size_t mismatches = 0;
+    size_t i          = 0;
+    for ( uint32_t node=0 ; node<count ; ++node ) {
+      for ( auto edge : { TimingGraph::Rise, TimingGraph::Fall } ) {
+        if (values[i++] != graph.getArrival (node,edge)) ++mismatches;
+        if (values[i++] != graph.getSlew    (node,edge)) ++mismatches;
+        if (values[i++] != graph.getRequired(node,edge)) ++mismatches;
+      }
+    }
+    return mismatches;
+  }
+
+
+  double  getWorstSlack ( TimingGraph& graph )
+  {
+    graph.update();
+    double worst = std::numeric_limits<double>::infinity();
+    for ( uint32_t node : graph.getEndPoints() ) worst = std::min( worst, graph.getSlack(node) );
+    return worst;
+  }
+
+
+}  // Anonymous namespace.
+
+
+int main ( int argc, char* argv[] )
+{
+  size_t       instanceCount = (argc > 1) ? strtoul( argv[1], NULL, 10 ) : 200000;
+  size_t       editCount     = (argc > 2) ? strtoul( argv[2], NULL, 10 ) : 10000;
+  unsigned int seed          = (argc > 3) ? strtoul( argv[3], NULL, 10 ) : 1;
+  int          status        = 0;
+
+  try {
+    string   libertyPath = writeLiberty();
+    Liberty* liberty     = Liberty::load( libertyPath );
+    unlink( libertyPath.c_str() );
+    if (not liberty) return 1;
+
+    cout << "Building a design of " << instanceCount << " instances." << endl;
+    Design        design ( instanceCount, seed );
+    Configuration configuration;
+    configuration.setClockPeriod( 2e-9 );
+
+    Clock::time_point start = Clock::now();
+    TimingGraph* graph = new TimingGraph ( design._top, &configuration );
+    graph->build( liberty );
+    cout << "  o  Build:            " << elapsed(start) << " ms ("
+         << graph->getNodesCount() << " nodes, " << graph->getLevelsCount() << " levels)." << endl;
+
+    start = Clock::now();
+    graph->propagate();
+    double fullTime = elapsed( start );
+    cout << "  o  Full propagation: " << fullTime << " ms, WNS "
+         << getWorstSlack(*graph)*1e+9 << " ns." << endl;
+
+    cout << "Applying " << editCount << " random edits." << endl;
+    size_t counts[3]  = { 0, 0, 0 };
+    double editTime   = 0.0;
+    double notifyTime = 0.0;
+    double updateTime = 0.0;
+    double checkTime  = 0.0;
+    size_t checks     = 0;
+    size_t mismatches = 0;
+    size_t done       = 0;
+    while (done < editCount) {
+      size_t            kind      = design._random() % 3;
+      Net*              queried   = NULL;
+      Instance*         instance  = NULL;
+      Clock::time_point editStart = Clock::now();
+      if (kind == 0) {
+        instance = design.getInstance();
+        Cell* master = instance->getMasterCell();
+        if ((master != design._leafs[0]) and (master != design._leafs[1])) continue;
+        design.resize( instance );
+        queried = instance->getPlug( instance->getMasterCell()->getNet("nq") )->getNet();
+      } else if (kind == 1) {
+        queried  = design.getNet();
+        instance = design.insertBuffer( queried );
+        if (not instance) continue;
+      } else {
+        queried = design.getNet();
+        design.reroute( queried );
+      }
+      editTime += elapsed( editStart );
+
+    // Tell the graph. The instance update also reconnects it's nets (for
+    // a buffer, the split net and the new output one).
+      Clock::time_point notifyStart = Clock::now();
+      if (instance) graph->updateInstance( instance, liberty );
+      else          graph->updateNet( queried );
+      notifyTime += elapsed( notifyStart );
+      ++counts[kind];
+      ++done;
+
+    // The query triggers the incremental update.
+      Clock::time_point updateStart = Clock::now();
+      graph->update();
+      uint32_t driver = graph->getNetNode( graph->getNetIndex(queried) );
+      if (driver != TimingGraph::NoIndex) graph->getSlack( driver );
+      updateTime += elapsed( updateStart );
+
+      if (done % std::max( (size_t)1, editCount/10 ) == 0) {
+        double checkFullTime = 0.0;
+        size_t errors        = checkFull( *graph, checkFullTime );
+        mismatches += errors;
+        checkTime  += checkFullTime;
+        ++checks;
+        cout << "     - " << done << " edits, WNS " << getWorstSlack(*graph)*1e+9 << " ns, "
+             << errors << " mismatches against full propagation." << endl;
+      }
+    }
+    cout << "  o  Resizes " << counts[0] << ", buffer insertions " << counts[1]
+         << ", re-routes " << counts[2] << "." << endl;
+    cout << "  o  Edits (database):   " << editTime   << " ms." << endl;
+    cout << "  o  Graph edits:        " << notifyTime << " ms, "
+         << (notifyTime / editCount) << " ms/edit." << endl;
+    cout << "  o  Incremental update: " << updateTime << " ms, "
+         << (updateTime / editCount) << " ms/edit." << endl;
+    if (checks)
+      cout << "  o  Full propagation:   " << (checkTime / checks) << " ms (mean of the "
+           << checks << " check points)." << endl;
+
+    double wns = getWorstSlack( *graph );
+    delete graph;
+    graph = new TimingGraph ( design._top, &configuration );
+    graph->build( liberty );
+    graph->propagate();
+    double rebuiltWns = getWorstSlack( *graph );
+    cout << "  o  Rebuilt graph WNS " << rebuiltWns*1e+9 << " ns (incremental " << wns*1e+9 << " ns)." << endl;
+    if (rebuiltWns != wns) {
+      cerr << "[ERROR] The rebuilt graph WNS differs." << endl;
+      status = 1;
+    }
+    if (mismatches) {
+      cerr << "[ERROR] " << mismatches << " incremental values differ from the full propagation." << endl;
+      status = 1;
+    }
+    delete graph;
+    delete liberty;
+  } catch ( Error& e ) {
+    cerr << e.what() << endl;
+    status = 1;
+  }
+
+  return status;
+}
@@ -0,0 +1,847 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |         S i r o c c o  -  Static Timing Analysis                |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./Liberty.cpp"                                 |
+// +-----------------------------------------------------------------+
+
+
+#include <cstdlib>
+#include <cctype>
+#include <sstream>
+#include <fstream>
+#include "hurricane/Error.h"
+#include "hurricane/Warning.h"
+#include "sirocco/Liberty.h"
+
+
+namespace {
+
+  using std::string;
+  using std::vector;
+  using std::map;
+  using std::cerr;
+  using std::endl;
+  using Hurricane::Error;
+  using Hurricane::Warning;
+  using Sirocco::LuTable;
+
+
+// -------------------------------------------------------------------
+// Class  :  "LibertyGroup".
+//
+// Generic syntax tree of a Liberty file. Simple attributes
+// ("name : value ;") and complex ones ("name ( v1, v2 ) ;") are both
+// stored as a name with a list of values.
+
+  class LibertyGroup {
+    public:
+      class Attribute {
+        public:
+          string          _name;
+          vector<string>  _values;
+          unsigned int    _line;
+      };
+    public:
+                               LibertyGroup ( const string& type, unsigned int line );
+                              ~LibertyGroup ();
+      const Attribute*         getAttribute ( const string& ) const;
+      const string&            getValue     ( const string&, const string& defaultValue ) const;
+    public:
+      string                 _type;
+      vector<string>         _arguments;
+      vector<Attribute>      _attributes;
+      vector<LibertyGroup*>  _groups;
+      unsigned int           _line;
+  };
+
+
+  LibertyGroup::LibertyGroup ( const string& type, unsigned int line )
+    : _type      (type)
+    , _arguments ()
+    , _attributes()
+    , _groups    ()
+    , _line      (line)
+  { }
+
+
+  LibertyGroup::~LibertyGroup ()
+  { for ( LibertyGroup* group : _groups ) delete group; }
+
+
+  const LibertyGroup::Attribute* LibertyGroup::getAttribute ( const string& name ) const
+  {
+    for ( const Attribute& attribute : _attributes )
+      if (attribute._name == name) return &attribute;
+    return NULL;
+  }
+
+
+  const string& LibertyGroup::getValue ( const string& name, const string& defaultValue ) const
+  {
+    const Attribute* attribute = getAttribute( name );
+    if (not attribute or attribute->_values.empty()) return defaultValue;
+    return attribute->_values[0];
+  }
+
+
+// -------------------------------------------------------------------
+// Class  :  "LibertyParser".
+
+  class LibertyParser {
+    public:
+      enum Token { Eof=0, Word, String, LParen, RParen, LBrace, RBrace, Colon, SemiColon, Comma };
+    public:
+                     LibertyParser ( const string& path );
+      LibertyGroup*  parse         ();
+    private:
+      Token          _lex          ( string& );
+      Token          _peek         ();
+      Token          _next         ();
+      void           _expect       ( Token, const char* );
+      void           _statement    ( LibertyGroup* );
+      void           _error        ( const char* ) const;
+    private:
+      string        _path;
+      string        _buffer;
+      size_t        _offset;
+      unsigned int  _line;
+      Token         _token;
+      string        _text;
+      unsigned int  _tokenLine;
+      bool          _peeked;
+  };
+
+
+  LibertyParser::LibertyParser ( const string& path )
+    : _path     (path)
+    , _buffer   ()
+    , _offset   (0)
+    , _line     (1)
+    , _token    (Eof)
+    , _text     ()
+    , _tokenLine(1)
+    , _peeked   (false)
+  {
+    std::ifstream      file ( path );
+    std::ostringstream content;
+    if (not file.good())
+      throw Error( "Liberty::load(): Unable to open \"%s\".", path.c_str() );
+    content << file.rdbuf();
+    _buffer = content.str();
+  }
+
+
+  void  LibertyParser::_error ( const char* message ) const
+  {
+    throw Error( "Liberty::load(): %s, in \"%s\" at line %u."
+               , message, _path.c_str(), _tokenLine );
+  }
+
+
+  LibertyParser::Token  LibertyParser::_lex ( string& text )
+  {
+    text.clear();
+    while (_offset < _buffer.size()) {
+      char c = _buffer[_offset];
+      if (c == '\n') { ++_line; ++_offset; continue; }
+      if (isspace(c)) { ++_offset; continue; }
+      if ((c == '\\') and (_offset+1 < _buffer.size()) and isspace(_buffer[_offset+1])) {
+        ++_offset; continue;
+      }
+      if ((c == '/') and (_offset+1 < _buffer.size()) and (_buffer[_offset+1] == '*')) {
+        size_t end = _buffer.find( "*/", _offset+2 );
+        if (end == string::npos) end = _buffer.size();
+        for ( size_t i=_offset ; i<end ; ++i ) if (_buffer[i] == '\n') ++_line;
+        _offset = end + 2;
+        continue;
+      }
+      if ((c == '/') and (_offset+1 < _buffer.size()) and (_buffer[_offset+1] == '/')) {
+        while ((_offset < _buffer.size()) and (_buffer[_offset] != '\n')) ++_offset;
+        continue;
+      }
+      break;
+    }
+    _tokenLine = _line;
+    if (_offset >= _buffer.size()) return Eof;
+
+    char c = _buffer[_offset++];
+    switch ( c ) {
+      case '(': return LParen;
+      case ')': return RParen;
+      case '{': return LBrace;
+      case '}': return RBrace;
+      case ':': return Colon;
+      case ';': return SemiColon;
+      case ',': return Comma;
+      case '"':
+        while ((_offset < _buffer.size()) and (_buffer[_offset] != '"')) {
+          if (_buffer[_offset] == '\\') {
+            if ((_offset+1 < _buffer.size()) and (_buffer[_offset+1] == '\n')) ++_line;
+            _offset += 2;
+            continue;
+          }
+          if (_buffer[_offset] == '\n') ++_line;
+          text += _buffer[_offset++];
+        }
+        ++_offset;
+        return String;
+    }
+    text += c;
+    while (_offset < _buffer.size()) {
+      c = _buffer[_offset];
+      if (isspace(c) or (string("(){}:;,\"").find(c) != string::npos)) break;
+      text += c;
+      ++_offset;
+    }
+    return Word;
+  }
+
+
+  LibertyParser::Token  LibertyParser::_peek ()
+  {
+    if (not _peeked) {
+      _token  = _lex( _text );
+      _peeked = true;
+    }
+    return _token;
+  }
+
+
+  LibertyParser::Token  LibertyParser::_next ()
+  {
+    Token token = _peek();
+    _peeked = false;
+    return token;
+  }
+
+
+  void  LibertyParser::_expect ( Token token, const char* what )
+  {
+    if (_next() != token) {
+      string message = string("Expected ") + what;
+      _error( message.c_str() );
+    }
+  }
+
+
+// Parse one attribute or one group (recursively) into parent. The
+// semicolon ending an attribute is optional, a simple attribute value
+// ends with the line.
+  void  LibertyParser::_statement ( LibertyGroup* parent )
+  {
+    if (_next() != Word) _error( "Expected an attribute or group name" );
+    string       name = _text;
+    unsigned int line = _tokenLine;
+
+    if (_peek() == Colon) {
+      _next();
+      LibertyGroup::Attribute attribute;
+      attribute._name = name;
+      attribute._line = line;
+      while (true) {
+        Token token = _peek();
+        if ((token == SemiColon) or (token == RBrace) or (token == Eof)) break;
+        if ((token != Word) and (token != String)) _error( "Invalid simple attribute value" );
+        if (not attribute._values.empty() and (_tokenLine != line)) break;
+        _next();
+        attribute._values.push_back( _text );
+      }
+      if (_peek() == SemiColon) _next();
+      parent->_attributes.push_back( attribute );
+      return;
+    }
+
+    _expect( LParen, "'('" );
+    vector<string> arguments;
+    while (_peek() != RParen) {
+      Token token = _next();
+      if (token == Comma) continue;
+      if ((token != Word) and (token != String)) _error( "Invalid argument" );
+      arguments.push_back( _text );
+    }
+    _next();
+
+    if (_peek() == LBrace) {
+      _next();
+      LibertyGroup* group = new LibertyGroup ( name, line );
+      group->_arguments = arguments;
+      parent->_groups.push_back( group );
+      while (_peek() != RBrace) {
+        if (_peek() == Eof) _error( "Unterminated group" );
+        if (_peek() == SemiColon) { _next(); continue; }
+        _statement( group );
+      }
+      _next();
+      return;
+    }
+    if (_peek() == SemiColon) _next();
+
+    LibertyGroup::Attribute attribute;
+    attribute._name   = name;
+    attribute._values = arguments;
+    attribute._line   = line;
+    parent->_attributes.push_back( attribute );
+  }
+
+
+  LibertyGroup* LibertyParser::parse ()
+  {
+    LibertyGroup* root = new LibertyGroup ( "<root>", 0 );
+    try {
+      while (_peek() != Eof) _statement( root );
+    } catch ( ... ) {
+      delete root;
+      throw;
+    }
+    return root;
+  }
+
+
+// -------------------------------------------------------------------
+// Conversion helpers.
+
+  double  toUnit ( const string& text, const string& suffix, double defaultValue )
+  {
+    static const map<string,double> scales = { {"f", 1e-15}, {"p", 1e-12}, {"n", 1e-9}
+                                             , {"u", 1e-6 }, {"m", 1e-3 }, {"" , 1.0 } };
+    char*  end   = NULL;
+    double value = strtod( text.c_str(), &end );
+    if (end == text.c_str()) value = 1.0;
+    string unit  = end;
+    for ( char& c : unit ) c = tolower(c);
+    if ((unit.size() < suffix.size()) or (unit.substr(unit.size()-suffix.size()) != suffix))
+      return defaultValue;
+    auto iscale = scales.find( unit.substr(0,unit.size()-suffix.size()) );
+    if (iscale == scales.end()) return defaultValue;
+    return value * iscale->second;
+  }
+
+
+  vector<double>  toNumbers ( const vector<string>& texts, double scale )
+  {
+    vector<double> numbers;
+    for ( const string& text : texts ) {
+      const char* begin = text.c_str();
+      while (*begin) {
+        if (isspace(*begin) or (*begin == ',')) { ++begin; continue; }
+        char*  end   = NULL;
+        double value = strtod( begin, &end );
+        if (end == begin) break;
+        numbers.push_back( value * scale );
+        begin = end;
+      }
+    }
+    return numbers;
+  }
+
+
+  LuTable::Variable  toVariable ( const string& name )
+  {
+    if (name == "input_net_transition"        ) return LuTable::InputTransition;
+    if (name == "total_output_net_capacitance") return LuTable::OutputLoad;
+    if (name == "constrained_pin_transition"  ) return LuTable::ConstrainedTransition;
+    if (name == "related_pin_transition"      ) return LuTable::RelatedTransition;
+    return LuTable::Constant;
+  }
+
+
+}  // Anonymous namespace.
+
+
+namespace Sirocco {
+
+  using std::string;
+  using std::vector;
+  using std::map;
+  using std::make_pair;
+  using std::cerr;
+  using std::endl;
+  using std::ostringstream;
+  using Hurricane::Error;
+  using Hurricane::Warning;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Sirocco::LuTable".
+
+  LuTable::LuTable ()
+    : _variables{Constant,Constant}
+    , _indexes  ()
+    , _values   ()
+  { }
+
+
+  void  LuTable::setIndex ( size_t i, const vector<double>& index )
+  { _indexes[i] = index; }
+
+
+  void  LuTable::setValues ( const vector<double>& values )
+  { _values = values; }
+
+
+  bool  LuTable::check () const
+  {
+    size_t size = 1;
+    for ( size_t i=0 ; i<2 ; ++i ) {
+      if (_indexes[i].empty()) continue;
+      for ( size_t j=1 ; j<_indexes[i].size() ; ++j )
+        if (_indexes[i][j] <= _indexes[i][j-1]) return false;
+      size *= _indexes[i].size();
+    }
+    return (_values.size() == size);
+  }
+
+
+// Find the segment [index[i], index[i+1]] to interpolate (or extrapolate)
+// from, and the position of x relative to it.
+  void  LuTable::_bracket ( const vector<double>& index, double x, size_t& i, double& t )
+  {
+    i = 0;
+    t = 0.0;
+    if (index.size() < 2) return;
+    while ((i+2 < index.size()) and (x > index[i+1])) ++i;
+    t = (x - index[i]) / (index[i+1] - index[i]);
+  }
+
+
+  double  LuTable::getValue ( double transition, double other ) const
+  {
+    if (_values.empty()) return 0.0;
+    if (_values.size() == 1) return _values[0];
+
+    double x[2];
+    for ( size_t i=0 ; i<2 ; ++i ) {
+      switch ( _variables[i] ) {
+        case InputTransition:
+        case ConstrainedTransition: x[i] = transition; break;
+        case OutputLoad:
+        case RelatedTransition:     x[i] = other; break;
+        default:                    x[i] = (_indexes[i].empty()) ? 0.0 : _indexes[i][0];
+      }
+    }
+
+    size_t i1 = 0;
+    size_t i2 = 0;
+    double t1 = 0.0;
+    double t2 = 0.0;
+    _bracket( _indexes[0], x[0], i1, t1 );
+    _bracket( _indexes[1], x[1], i2, t2 );
+
+    size_t width = (_indexes[1].empty()) ? 1 : _indexes[1].size();
+    size_t j1    = (_indexes[0].size() < 2) ? i1 : i1+1;
+    size_t j2    = (_indexes[1].size() < 2) ? i2 : i2+1;
+    double v00   = _values[ i1*width + i2 ];
+    double v01   = _values[ i1*width + j2 ];
+    double v10   = _values[ j1*width + i2 ];
+    double v11   = _values[ j1*width + j2 ];
+    double v0    = v00 + t2 * (v01 - v00);
+    double v1    = v10 + t2 * (v11 - v10);
+    return v0 + t1 * (v1 - v0);
+  }
+
+
+  string  LuTable::_getTypeName () const
+  { return "Sirocco::LuTable"; }
+
+
+  string  LuTable::_getString () const
+  {
+    ostringstream  os;
+    os << "<LuTable " << _indexes[0].size() << "x" << _indexes[1].size()
+       << " vars:" << _variables[0] << "," << _variables[1] << ">";
+    return os.str();
+  }
+
+
+  Record* LuTable::_getRecord () const
+  {
+    Record* record = new Record ( _getString() );
+    if (record) {
+      record->add( getSlot( "_indexes[0]", &_indexes[0] ) );
+      record->add( getSlot( "_indexes[1]", &_indexes[1] ) );
+      record->add( getSlot( "_values"    , &_values     ) );
+    }
+    return record;
+  }
+
+
+// -------------------------------------------------------------------
+// Class  :  "Sirocco::LibArc".
+
+  LibArc::LibArc ()
+    : _relatedName ()
+    , _pinIndex    (LibCell::NoPin)
+    , _relatedIndex(LibCell::NoPin)
+    , _sense       (NonUnate)
+    , _type        (Combinational)
+    , _tables      ()
+  { }
+
+
+  double  LibArc::getDelay ( bool outRise, double slew, double load, double& outSlew ) const
+  {
+    const LuTable& delay = _tables[ (outRise) ? CellRise       : CellFall       ];
+    const LuTable& trans = _tables[ (outRise) ? RiseTransition : FallTransition ];
+    outSlew = trans.getValue( slew, load );
+    return delay.getValue( slew, load );
+  }
+
+
+  double  LibArc::getSetup ( bool dataRise, double dataSlew, double clockSlew ) const
+  { return _tables[ (dataRise) ? RiseConstraint : FallConstraint ].getValue( dataSlew, clockSlew ); }
+
+
+  string  LibArc::_getTypeName () const
+  { return "Sirocco::LibArc"; }
+
+
+  string  LibArc::_getString () const
+  {
+    ostringstream  os;
+    os << "<LibArc " << _relatedName << " -> #" << _pinIndex
+       << " type:" << _type << " sense:" << _sense << ">";
+    return os.str();
+  }
+
+
+  Record* LibArc::_getRecord () const
+  {
+    Record* record = new Record ( _getString() );
+    if (record) {
+      record->add( getSlot( "_relatedName" , &_relatedName       ) );
+      record->add( getSlot( "_relatedIndex",  _relatedIndex      ) );
+      record->add( getSlot( "_cellRise"    , &_tables[CellRise]  ) );
+      record->add( getSlot( "_cellFall"    , &_tables[CellFall]  ) );
+    }
+    return record;
+  }
+
+
+// -------------------------------------------------------------------
+// Class  :  "Sirocco::LibPin".
+
+  LibPin::LibPin ( const Name& name, uint32_t index )
+    : _name       (name)
+    , _index      (index)
+    , _direction  (Input)
+    , _capacitance(0.0)
+    , _isClock    (false)
+    , _arcs       ()
+    , _fanouts    ()
+  { }
+
+
+  string  LibPin::_getTypeName () const
+  { return "Sirocco::LibPin"; }
+
+
+  string  LibPin::_getString () const
+  {
+    ostringstream  os;
+    os << "<LibPin " << _name << " dir:" << _direction << " arcs:" << _arcs.size() << ">";
+    return os.str();
+  }
+
+
+  Record* LibPin::_getRecord () const
+  {
+    Record* record = new Record ( _getString() );
+    if (record) {
+      record->add( getSlot( "_name"       , &_name        ) );
+      record->add( getSlot( "_capacitance",  _capacitance ) );
+      record->add( getSlot( "_isClock"    ,  _isClock     ) );
+      record->add( getSlot( "_arcs"       , &_arcs        ) );
+    }
+    return record;
+  }
+
+
+// -------------------------------------------------------------------
+// Class  :  "Sirocco::LibCell".
+
+  LibCell::LibCell ( const Name& name )
+    : _name        (name)
+    , _isSequential(false)
+    , _pins        ()
+    , _pinIndexes  ()
+  { }
+
+
+  LibCell::~LibCell ()
+  {
+    for ( LibPin* pin : _pins ) {
+      for ( LibArc* arc : pin->_arcs ) delete arc;
+      delete pin;
+    }
+  }
+
+
+  uint32_t  LibCell::getPinIndex ( const Name& name ) const
+  {
+    auto ipin = _pinIndexes.find( name );
+    return (ipin != _pinIndexes.end()) ? ipin->second : NoPin;
+  }
+
+
+  LibPin* LibCell::addPin ( const Name& name )
+  {
+    uint32_t index = getPinIndex( name );
+    if (index != NoPin) return _pins[index];
+
+    LibPin* pin = new LibPin ( name, _pins.size() );
+    _pinIndexes.insert( make_pair(name,pin->getIndex()) );
+    _pins.push_back( pin );
+    return pin;
+  }
+
+
+// Resolve the related pins of the arcs, and build the reverse lists of
+// the delay arcs (the fanouts of the related pins). Arcs with an unknown
+// related pin are dropped.
+  void  LibCell::link ()
+  {
+    for ( LibPin* pin : _pins ) {
+      for ( size_t i=0 ; i<pin->_arcs.size() ; ) {
+        LibArc* arc = pin->_arcs[i];
+        arc->_pinIndex     = pin->getIndex();
+        arc->_relatedIndex = getPinIndex( Name(arc->_relatedName) );
+        if ((arc->_relatedIndex == NoPin) or (arc->_type == LibArc::Ignored)) {
+          delete arc;
+          pin->_arcs.erase( pin->_arcs.begin()+i );
+          continue;
+        }
+        if (arc->isEdge()) {
+          _isSequential = true;
+          _pins[ arc->_relatedIndex ]->_isClock = true;
+        }
+        if (arc->isDelay() and not arc->isEdge() and pin->isOutput())
+          _pins[ arc->_relatedIndex ]->_fanouts.push_back( arc );
+        ++i;
+      }
+    }
+  }
+
+
+  string  LibCell::_getTypeName () const
+  { return "Sirocco::LibCell"; }
+
+
+  string  LibCell::_getString () const
+  {
+    ostringstream  os;
+    os << "<LibCell " << _name << " pins:" << _pins.size() << ">";
+    return os.str();
+  }
+
+
+  Record* LibCell::_getRecord () const
+  {
+    Record* record = new Record ( _getString() );
+    if (record) {
+      record->add( getSlot( "_name"        , &_name         ) );
+      record->add( getSlot( "_isSequential",  _isSequential ) );
+      record->add( getSlot( "_pins"        , &_pins         ) );
+    }
+    return record;
+  }
+
+
+// -------------------------------------------------------------------
+// Class  :  "Sirocco::Liberty".
+
+  Liberty::Liberty ( const string& path )
+    : _name           ()
+    , _path           (path)
+    , _timeUnit       (1e-9)
+    , _capacitanceUnit(1e-12)
+    , _cells          ()
+  { }
+
+
+  Liberty::~Liberty ()
+  { for ( auto item : _cells ) delete item.second; }
+
+
+  const LibCell* Liberty::getCell ( const Name& name ) const
+  {
+    auto icell = _cells.find( name );
+    return (icell != _cells.end()) ? icell->second : NULL;
+  }
+
+
+  Liberty* Liberty::load ( const string& path )
+  {
+    LibertyGroup* root    = NULL;
+    Liberty*      liberty = NULL;
+    try {
+      LibertyParser parser ( path );
+      root = parser.parse();
+    } catch ( Error& e ) {
+      cerr << e << endl;
+      return NULL;
+    }
+
+    const LibertyGroup* library = NULL;
+    for ( const LibertyGroup* group : root->_groups )
+      if (group->_type == "library") { library = group; break; }
+    if (not library) {
+      cerr << Error( "Liberty::load(): No \"library\" group in \"%s\".", path.c_str() ) << endl;
+      delete root;
+      return NULL;
+    }
+
+    liberty = new Liberty ( path );
+    if (not library->_arguments.empty()) liberty->_name = library->_arguments[0];
+    liberty->_timeUnit = toUnit( library->getValue("time_unit","1ns"), "s", 1e-9 );
+    const LibertyGroup::Attribute* capUnit = library->getAttribute( "capacitive_load_unit" );
+    if (capUnit and (capUnit->_values.size() == 2))
+      liberty->_capacitanceUnit = toUnit( capUnit->_values[0]+capUnit->_values[1], "f", 1e-12 );
+
+    double timeUnit = liberty->_timeUnit;
+    double capUnit2 = liberty->_capacitanceUnit;
+    auto   scaleOf  = [&]( LuTable::Variable variable ) {
+                        return (variable == LuTable::OutputLoad) ? capUnit2 : timeUnit;
+                      };
+
+    map<string,LuTable> templates;
+    for ( const LibertyGroup* group : library->_groups ) {
+      if (group->_type != "lu_table_template") continue;
+      if (group->_arguments.empty()) continue;
+      LuTable table;
+      for ( size_t i=0 ; i<2 ; ++i ) {
+        string index = std::to_string( i+1 );
+        table.setVariable( i, toVariable( group->getValue( "variable_"+index, "" )));
+        const LibertyGroup::Attribute* values = group->getAttribute( "index_"+index );
+        if (values) table.setIndex( i, toNumbers( values->_values, scaleOf(table.getVariable(i)) ));
+      }
+      templates[ group->_arguments[0] ] = table;
+    }
+
+    size_t skippedBuses = 0;
+    for ( const LibertyGroup* cellGroup : library->_groups ) {
+      if (cellGroup->_type != "cell") continue;
+      if (cellGroup->_arguments.empty()) continue;
+
+      LibCell* cell = new LibCell ( Name(cellGroup->_arguments[0]) );
+      for ( const LibertyGroup* pinGroup : cellGroup->_groups ) {
+        if ((pinGroup->_type == "ff") or (pinGroup->_type == "latch"))
+          cell->_isSequential = true;
+        if ((pinGroup->_type == "bus") or (pinGroup->_type == "bundle")) ++skippedBuses;
+        if (pinGroup->_type != "pin") continue;
+
+        for ( const string& pinName : pinGroup->_arguments ) {
+          LibPin* pin = cell->addPin( Name(pinName) );
+          const string& direction = pinGroup->getValue( "direction", "input" );
+          if      (direction == "output"  ) pin->_direction = LibPin::Output;
+          else if (direction == "inout"   ) pin->_direction = LibPin::InOut;
+          else if (direction == "internal") pin->_direction = LibPin::Internal;
+          pin->_capacitance = atof( pinGroup->getValue("capacitance","0").c_str() ) * liberty->_capacitanceUnit;
+          pin->_isClock     = (pinGroup->getValue("clock","false") == "true");
+
+          for ( const LibertyGroup* timing : pinGroup->_groups ) {
+            if (timing->_type != "timing") continue;
+
+            LibArc model;
+            const string& sense = timing->getValue( "timing_sense", "non_unate" );
+            if      (sense == "positive_unate") model._sense = LibArc::PositiveUnate;
+            else if (sense == "negative_unate") model._sense = LibArc::NegativeUnate;
+            const string& type = timing->getValue( "timing_type", "combinational" );
+            if      (type.substr(0,13) == "combinational") model._type = LibArc::Combinational;
+            else if (type == "rising_edge"  ) model._type = LibArc::RisingEdge;
+            else if (type == "falling_edge" ) model._type = LibArc::FallingEdge;
+            else if (type == "setup_rising" ) model._type = LibArc::SetupRising;
+            else if (type == "setup_falling") model._type = LibArc::SetupFalling;
+            else                              model._type = LibArc::Ignored;
+
+            static const char* tableNames[LibArc::TableCount] =
+              { "cell_rise", "cell_fall", "rise_transition", "fall_transition"
+              , "rise_constraint", "fall_constraint" };
+            for ( const LibertyGroup* tableGroup : timing->_groups ) {
+              size_t itable = 0;
+              while ((itable < LibArc::TableCount) and (tableGroup->_type != tableNames[itable])) ++itable;
+              if (itable == LibArc::TableCount) continue;
+
+              LuTable table;
+              if (not tableGroup->_arguments.empty()) {
+                auto itemplate = templates.find( tableGroup->_arguments[0] );
+                if (itemplate != templates.end()) table = itemplate->second;
+              }
+              for ( size_t i=0 ; i<2 ; ++i ) {
+                const LibertyGroup::Attribute* values
+                  = tableGroup->getAttribute( "index_"+std::to_string(i+1) );
+                if (values) table.setIndex( i, toNumbers( values->_values, scaleOf(table.getVariable(i)) ));
+              }
+              const LibertyGroup::Attribute* values = tableGroup->getAttribute( "values" );
+              if (values) table.setValues( toNumbers( values->_values, timeUnit ));
+              if (not table.check()) {
+                cerr << Warning( "Liberty::load(): Inconsistent table %s, in \"%s\" at line %u (ignored)."
+                               , tableNames[itable], path.c_str(), tableGroup->_line ) << endl;
+                continue;
+              }
+              model._tables[itable] = table;
+            }
+
+            std::istringstream relateds ( timing->getValue("related_pin","") );
+            string             related;
+            while (relateds >> related) {
+              LibArc* arc = new LibArc ( model );
+              arc->_relatedName = related;
+              pin->_arcs.push_back( arc );
+            }
+          }
+        }
+      }
+      cell->link();
+      if (liberty->_cells.find(cell->getName()) != liberty->_cells.end()) {
+        cerr << Warning( "Liberty::load(): Duplicated cell \"%s\", in \"%s\" (ignored)."
+                       , getString(cell->getName()).c_str(), path.c_str() ) << endl;
+        delete cell;
+        continue;
+      }
+      liberty->_cells.insert( make_pair(cell->getName(),cell) );
+    }
+
+    if (skippedBuses)
+      cerr << Warning( "Liberty::load(): %u bus or bundle groups skipped in \"%s\"."
+                     , (unsigned int)skippedBuses, path.c_str() ) << endl;
+    delete root;
+    return liberty;
+  }
+
+
+  string  Liberty::_getTypeName () const
+  { return "Sirocco::Liberty"; }
+
+
+  string  Liberty::_getString () const
+  {
+    ostringstream  os;
+    os << "<Liberty \"" << _name << "\" cells:" << _cells.size() << ">";
+    return os.str();
+  }
+
+
+  Record* Liberty::_getRecord () const
+  {
+    Record* record = new Record ( _getString() );
+    if (record) {
+      record->add( getSlot( "_name"           , &_name            ) );
+      record->add( getSlot( "_path"           , &_path            ) );
+      record->add( getSlot( "_timeUnit"       ,  _timeUnit        ) );
+      record->add( getSlot( "_capacitanceUnit",  _capacitanceUnit ) );
+      record->add( getSlot( "_cells"          , &_cells           ) );
+    }
+    return record;
+  }
+
+
+}  // Sirocco namespace.
@@ -0,0 +1,95 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |         S i r o c c o  -  Static Timing Analysis                |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./PySirocco.cpp"                               |
+// +-----------------------------------------------------------------+
+
+
+#include "hurricane/isobar/PyHurricane.h"
+#include "hurricane/isobar/PyCell.h"
+#include "sirocco/PySiroccoEngine.h"
+
+
+namespace Sirocco {
+
+  using std::cerr;
+  using std::endl;
+  using Hurricane::tab;
+  using Isobar::getPyHash;
+  using Isobar::__cs;
+  using CRL::PyTypeToolEngine;
+
+
+#if !defined(__PYTHON_MODULE__)
+
+// +=================================================================+
+// |              "PySirocco" Shared Library Code Part               |
+// +=================================================================+
+
+
+# else // End of PyHurricane Shared Library Code Part.
+
+
+// +=================================================================+
+// |               "PySirocco" Python Module Code Part               |
+// +=================================================================+
+
+
+extern "C" {
+
+
+  static PyMethodDef PySirocco_Methods[] =
+    { {NULL, NULL, 0, NULL}     /* sentinel */
+    };
+
+
+  static PyModuleDef  PySirocco_ModuleDef =
+    { PyModuleDef_HEAD_INIT
+    , .m_name    = "Sirocco"
+    , .m_doc     = "Static timing analysis."
+    , .m_size    = -1
+    , .m_methods = PySirocco_Methods
+    };
+
+
+  // ---------------------------------------------------------------
+  // Module Initialization  :  "PyInit_Sirocco ()"
+
+  PyMODINIT_FUNC PyInit_Sirocco ( void )
+  {
+    cdebug_log(40,0) << "PyInit_Sirocco()" << endl;
+
+    PySiroccoEngine_LinkPyType();
+
+    PYTYPE_READY_SUB( SiroccoEngine, ToolEngine );
+
+    PyObject* module = PyModule_Create( &PySirocco_ModuleDef );
+    if (module == NULL) {
+      cerr << "[ERROR]\n"
+           << "  Failed to initialize Sirocco module." << endl;
+      return NULL;
+    }
+
+    Py_INCREF( &PyTypeSiroccoEngine );
+    PyModule_AddObject( module, "SiroccoEngine", (PyObject*)&PyTypeSiroccoEngine );
+
+    return module;
+  }
+
+  
+} // End of extern "C".
+
+
+#endif // End of Python Module Code Part.
+
+
+}  // End of Sirocco namespace.
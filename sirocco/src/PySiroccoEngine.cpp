@@ -0,0 +1,323 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |         S i r o c c o  -  Static Timing Analysis                |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./PySiroccoEngine.cpp"                         |
+// +-----------------------------------------------------------------+
+
+
+#include "hurricane/isobar/PyNet.h"
+#include "hurricane/isobar/PyInstance.h"
+#include "hurricane/isobar/PyCell.h"
+#include "hurricane/Cell.h"
+#include "crlcore/Utilities.h"
+#include "sirocco/PySiroccoEngine.h"
+
+# undef   ACCESS_OBJECT
+# undef   ACCESS_CLASS
+# define  ACCESS_OBJECT            _baseObject._object
+# define  ACCESS_CLASS(_pyObject)  &(_pyObject->_baseObject)
+#define   METHOD_HEAD(function)    GENERIC_METHOD_HEAD(SiroccoEngine,sirocco,function)
+
+
+namespace  Sirocco {
+
+  using std::cerr;
+  using std::endl;
+  using std::hex;
+  using std::ostringstream;
+  using Hurricane::tab;
+  using Hurricane::Exception;
+  using Hurricane::Bug;
+  using Hurricane::Error;
+  using Hurricane::Warning;
+  using Isobar::__cs;
+  using Isobar::Converter;
+  using Isobar::ProxyProperty;
+  using Isobar::ProxyError;
+  using Isobar::ConstructorError;
+  using Isobar::HurricaneError;
+  using Isobar::HurricaneWarning;
+  using Isobar::getPyHash;
+  using Isobar::ParseOneArg;
+  using Isobar::ParseTwoArg;
+  using Isobar::PyNet;
+  using Isobar::PyTypeNet;
+  using Isobar::PyInstance;
+  using Isobar::PyTypeInstance;
+  using Isobar::PyCell;
+  using Isobar::PyCell_Link;
+  using CRL::PyToolEngine;
+
+
+extern "C" {
+
+#if defined(__PYTHON_MODULE__)
+
+
+// +=================================================================+
+// |           "PySiroccoEngine" Python Module Code Part             |
+// +=================================================================+
+
+
+  static PyObject* PySiroccoEngine_get ( PyObject*, PyObject* args )
+  {
+    cdebug_log(40,0) << "PySiroccoEngine_get()" << endl;
+    SiroccoEngine* sirocco = NULL;
+    HTRY
+      PyObject* arg0;
+      if (not ParseOneArg("Sirocco.get", args, CELL_ARG, &arg0)) return NULL;
+      sirocco = SiroccoEngine::get(PYCELL_O(arg0));
+    HCATCH
+    return PySiroccoEngine_Link(sirocco);
+  }
+
+
+  static PyObject* PySiroccoEngine_create ( PyObject*, PyObject* args )
+  {
+    cdebug_log(40,0) << "PySiroccoEngine_create()" << endl;
+    SiroccoEngine* sirocco = NULL;
+    HTRY
+      PyObject* arg0;
+      if (not ParseOneArg("Sirocco.create", args, CELL_ARG, &arg0)) return NULL;
+      Cell* cell = PYCELL_O(arg0);
+      sirocco = SiroccoEngine::get(cell);
+      if (sirocco == NULL) {
+        sirocco = SiroccoEngine::create(cell);
+      } else
+        cerr << Warning("%s already has a Sirocco engine.",getString(cell).c_str()) << endl;
+    HCATCH
+    return PySiroccoEngine_Link(sirocco);
+  }
+
+
+  static PyObject* PySiroccoEngine_loadLiberty ( PySiroccoEngine* self, PyObject* args )
+  {
+    cdebug_log(40,0) << "PySiroccoEngine_loadLiberty()" << endl;
+    bool loaded = false;
+    HTRY
+      METHOD_HEAD( "SiroccoEngine.loadLiberty()" )
+      char* path = NULL;
+      if (not PyArg_ParseTuple(args,"s:SiroccoEngine.loadLiberty()",&path)) {
+        PyErr_SetString( ConstructorError, "SiroccoEngine.loadLiberty(): Argument must be a file path." );
+        return NULL;
+      }
+      loaded = sirocco->loadLiberty( path );
+    HCATCH
+    if (loaded) Py_RETURN_TRUE;
+    Py_RETURN_FALSE;
+  }
+
+
+  static PyObject* PySiroccoEngine_report ( PySiroccoEngine* self, PyObject* args )
+  {
+    cdebug_log(40,0) << "PySiroccoEngine_report()" << endl;
+    HTRY
+      METHOD_HEAD( "SiroccoEngine.report()" )
+      unsigned int paths = 1;
+      if (not PyArg_ParseTuple(args,"|I:SiroccoEngine.report()",&paths)) {
+        PyErr_SetString( ConstructorError, "SiroccoEngine.report(): Argument must be a number of paths." );
+        return NULL;
+      }
+      sirocco->report( paths );
+    HCATCH
+    Py_RETURN_NONE;
+  }
+
+
+  static PyObject* PySiroccoEngine_getViolationsCount ( PySiroccoEngine* self )
+  {
+    cdebug_log(40,0) << "PySiroccoEngine_getViolationsCount()" << endl;
+    PyObject* rvalue = NULL;
+    HTRY
+      METHOD_HEAD( "SiroccoEngine.getViolationsCount()" )
+      rvalue = PyLong_FromSize_t( sirocco->getViolationsCount() );
+    HCATCH
+    return rvalue;
+  }
+
+
+  static PyObject* PySiroccoEngine_getNetSlack ( PySiroccoEngine* self, PyObject* args )
+  {
+    cdebug_log(40,0) << "PySiroccoEngine_getNetSlack()" << endl;
+    PyObject* rvalue = NULL;
+    HTRY
+      METHOD_HEAD( "SiroccoEngine.getNetSlack()" )
+      PyObject* pyNet = NULL;
+      if (not PyArg_ParseTuple(args,"O:SiroccoEngine.getNetSlack()",&pyNet) or not IsPyNet(pyNet)) {
+        PyErr_SetString( ConstructorError, "SiroccoEngine.getNetSlack(): Argument must be a Net." );
+        return NULL;
+      }
+      rvalue = PyFloat_FromDouble( sirocco->getNetSlack( PYNET_O(pyNet) ));
+    HCATCH
+    return rvalue;
+  }
+
+
+  static PyObject* PySiroccoEngine_getNetArrival ( PySiroccoEngine* self, PyObject* args )
+  {
+    cdebug_log(40,0) << "PySiroccoEngine_getNetArrival()" << endl;
+    PyObject* rvalue = NULL;
+    HTRY
+      METHOD_HEAD( "SiroccoEngine.getNetArrival()" )
+      PyObject* pyNet = NULL;
+      if (not PyArg_ParseTuple(args,"O:SiroccoEngine.getNetArrival()",&pyNet) or not IsPyNet(pyNet)) {
+        PyErr_SetString( ConstructorError, "SiroccoEngine.getNetArrival(): Argument must be a Net." );
+        return NULL;
+      }
+      rvalue = PyFloat_FromDouble( sirocco->getNetArrival( PYNET_O(pyNet) ));
+    HCATCH
+    return rvalue;
+  }
+
+
+  static PyObject* PySiroccoEngine_updateInstance ( PySiroccoEngine* self, PyObject* args )
+  {
+    cdebug_log(40,0) << "PySiroccoEngine_updateInstance()" << endl;
+    HTRY
+      METHOD_HEAD( "SiroccoEngine.updateInstance()" )
+      PyObject* pyInstance = NULL;
+      if (not PyArg_ParseTuple(args,"O:SiroccoEngine.updateInstance()",&pyInstance) or not IsPyInstance(pyInstance)) {
+        PyErr_SetString( ConstructorError, "SiroccoEngine.updateInstance(): Argument must be an Instance." );
+        return NULL;
+      }
+      sirocco->updateInstance( PYINSTANCE_O(pyInstance) );
+    HCATCH
+    Py_RETURN_NONE;
+  }
+
+
+  static PyObject* PySiroccoEngine_removeInstance ( PySiroccoEngine* self, PyObject* args )
+  {
+    cdebug_log(40,0) << "PySiroccoEngine_removeInstance()" << endl;
+    HTRY
+      METHOD_HEAD( "SiroccoEngine.removeInstance()" )
+      PyObject* pyInstance = NULL;
+      if (not PyArg_ParseTuple(args,"O:SiroccoEngine.removeInstance()",&pyInstance) or not IsPyInstance(pyInstance)) {
+        PyErr_SetString( ConstructorError, "SiroccoEngine.removeInstance(): Argument must be an Instance." );
+        return NULL;
+      }
+      sirocco->removeInstance( PYINSTANCE_O(pyInstance) );
+    HCATCH
+    Py_RETURN_NONE;
+  }
+
+
+  static PyObject* PySiroccoEngine_updateNet ( PySiroccoEngine* self, PyObject* args )
+  {
+    cdebug_log(40,0) << "PySiroccoEngine_updateNet()" << endl;
+    HTRY
+      METHOD_HEAD( "SiroccoEngine.updateNet()" )
+      PyObject* pyNet = NULL;
+      if (not PyArg_ParseTuple(args,"O:SiroccoEngine.updateNet()",&pyNet) or not IsPyNet(pyNet)) {
+        PyErr_SetString( ConstructorError, "SiroccoEngine.updateNet(): Argument must be a Net." );
+        return NULL;
+      }
+      sirocco->updateNet( PYNET_O(pyNet) );
+    HCATCH
+    Py_RETURN_NONE;
+  }
+
+
+  static PyObject* PySiroccoEngine_removeNet ( PySiroccoEngine* self, PyObject* args )
+  {
+    cdebug_log(40,0) << "PySiroccoEngine_removeNet()" << endl;
+    HTRY
+      METHOD_HEAD( "SiroccoEngine.removeNet()" )
+      PyObject* pyNet = NULL;
+      if (not PyArg_ParseTuple(args,"O:SiroccoEngine.removeNet()",&pyNet) or not IsPyNet(pyNet)) {
+        PyErr_SetString( ConstructorError, "SiroccoEngine.removeNet(): Argument must be a Net." );
+        return NULL;
+      }
+      sirocco->removeNet( PYNET_O(pyNet) );
+    HCATCH
+    Py_RETURN_NONE;
+  }
+
+
+  // Standart Accessors (Attributes).
+  DirectVoidMethod(SiroccoEngine,sirocco,buildGraph)
+  DirectVoidMethod(SiroccoEngine,sirocco,analyze)
+  DirectVoidMethod(SiroccoEngine,sirocco,updateTiming)
+  DirectVoidMethod(SiroccoEngine,sirocco,printConfiguration)
+  DirectVoidMethod(SiroccoEngine,sirocco,printSummary)
+  DirectGetDoubleAttribute(PySiroccoEngine_getWorstSlack        ,getWorstSlack        ,PySiroccoEngine,SiroccoEngine)
+  DirectGetDoubleAttribute(PySiroccoEngine_getTotalNegativeSlack,getTotalNegativeSlack,PySiroccoEngine,SiroccoEngine)
+
+  // Standart Destroy (Attribute).
+  DBoDestroyAttribute(PySiroccoEngine_destroy,PySiroccoEngine)
+
+
+  PyMethodDef PySiroccoEngine_Methods[] =
+    { { "get"                      , (PyCFunction)PySiroccoEngine_get                     , METH_VARARGS|METH_STATIC
+                                   , "Returns the Sirocco engine attached to the Cell, None if there isnt't." }
+    , { "create"                   , (PyCFunction)PySiroccoEngine_create                  , METH_VARARGS|METH_STATIC
+                                   , "Create a Sirocco engine on this cell." }
+    , { "destroy"                  , (PyCFunction)PySiroccoEngine_destroy                 , METH_NOARGS
+                                   , "Destroy a Sirocco engine." }
+    , { "loadLiberty"              , (PyCFunction)PySiroccoEngine_loadLiberty             , METH_VARARGS
+                                   , "Load the Liberty library giving the cells timing models." }
+    , { "buildGraph"               , (PyCFunction)PySiroccoEngine_buildGraph              , METH_NOARGS
+                                   , "(Re)build the timing graph from the netlist and the wires." }
+    , { "analyze"                  , (PyCFunction)PySiroccoEngine_analyze                 , METH_NOARGS
+                                   , "Compute the arrival, required times and slacks." }
+    , { "updateInstance"           , (PyCFunction)PySiroccoEngine_updateInstance          , METH_VARARGS
+                                   , "Take into account a new instance or a change of it's master cell." }
+    , { "removeInstance"           , (PyCFunction)PySiroccoEngine_removeInstance          , METH_VARARGS
+                                   , "Remove an instance from the timing graph (before destroying it)." }
+    , { "updateNet"                , (PyCFunction)PySiroccoEngine_updateNet               , METH_VARARGS
+                                   , "Take into account a new net or a change of it's connexions or wiring." }
+    , { "removeNet"                , (PyCFunction)PySiroccoEngine_removeNet               , METH_VARARGS
+                                   , "Remove a net from the timing graph (before destroying it)." }
+    , { "updateTiming"             , (PyCFunction)PySiroccoEngine_updateTiming            , METH_NOARGS
+                                   , "Recompute the times of the cones modified since the last query." }
+    , { "report"                   , (PyCFunction)PySiroccoEngine_report                  , METH_VARARGS
+                                   , "Display the critical paths of the N worst endpoints." }
+    , { "getWorstSlack"            , (PyCFunction)PySiroccoEngine_getWorstSlack           , METH_NOARGS
+                                   , "Returns the worst slack over all the endpoints (seconds)." }
+    , { "getTotalNegativeSlack"    , (PyCFunction)PySiroccoEngine_getTotalNegativeSlack   , METH_NOARGS
+                                   , "Returns the sum of the negative slacks of the endpoints (seconds)." }
+    , { "getViolationsCount"       , (PyCFunction)PySiroccoEngine_getViolationsCount      , METH_NOARGS
+                                   , "Returns the number of endpoints with a negative slack." }
+    , { "getNetSlack"              , (PyCFunction)PySiroccoEngine_getNetSlack             , METH_VARARGS
+                                   , "Returns the slack of the driver of a net (seconds)." }
+    , { "getNetArrival"            , (PyCFunction)PySiroccoEngine_getNetArrival           , METH_VARARGS
+                                   , "Returns the latest arrival time at the driver of a net (seconds)." }
+    , { "printConfiguration"       , (PyCFunction)PySiroccoEngine_printConfiguration      , METH_NOARGS
+                                   , "Display the timing analysis parameters." }
+    , { "printSummary"             , (PyCFunction)PySiroccoEngine_printSummary            , METH_NOARGS
+                                   , "Report the worst & total negative slacks." }
+    , {NULL, NULL, 0, NULL}        /* sentinel */
+    };
+
+
+  DBoDeleteMethod(SiroccoEngine)
+  PyTypeObjectLinkPyType(SiroccoEngine)
+
+
+#else  // End of Python Module Code Part.
+
+
+// +=================================================================+
+// |            "PySiroccoEngine" Shared Library Code Part           |
+// +=================================================================+
+
+
+  // Link/Creation Method.
+  PyTypeInheritedObjectDefinitions(SiroccoEngine,PyToolEngine)
+  DBoLinkCreateMethod(SiroccoEngine)
+
+
+#endif  // Shared Library Code Part.
+
+}  // extern "C".
+
+}  // Sirocco namespace.
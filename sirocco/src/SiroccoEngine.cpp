@@ -0,0 +1,327 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |         S i r o c c o  -  Static Timing Analysis                |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./SiroccoEngine.cpp"                           |
+// +-----------------------------------------------------------------+
+
+
+#include <set>
+#include <limits>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include "hurricane/Error.h"
+#include "hurricane/Warning.h"
+#include "hurricane/Net.h"
+#include "hurricane/Cell.h"
+#include "crlcore/Utilities.h"
+#include "sirocco/SiroccoEngine.h"
+
+
+namespace Sirocco {
+
+  using std::cout;
+  using std::cerr;
+  using std::endl;
+  using std::setw;
+  using std::left;
+  using std::right;
+  using std::fixed;
+  using std::setprecision;
+  using std::string;
+  using std::vector;
+  using std::pair;
+  using std::ostringstream;
+  using Hurricane::Error;
+  using Hurricane::Warning;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Sirocco::SiroccoEngine".
+
+  Name  SiroccoEngine::_toolName = "Sirocco";
+
+
+  const Name& SiroccoEngine::staticGetName ()
+  { return _toolName; }
+
+
+  SiroccoEngine* SiroccoEngine::get ( const Cell* cell )
+  { return static_cast<SiroccoEngine*>(ToolEngine::get(cell,staticGetName())); }
+
+
+  SiroccoEngine::SiroccoEngine ( Cell* cell )
+    : Super          (cell)
+    , _configuration (new Configuration())
+    , _liberty       (NULL)
+    , _timingGraph   (NULL)
+  { }
+
+
+  void  SiroccoEngine::_postCreate ()
+  {
+    Super::_postCreate();
+  }
+
+
+  SiroccoEngine* SiroccoEngine::create ( Cell* cell )
+  {
+    SiroccoEngine* sirocco = new SiroccoEngine ( cell );
+
+    sirocco->_postCreate();
+
+    return sirocco;
+  }
+
+
+  void  SiroccoEngine::_preDestroy ()
+  {
+    cmess1 << "  o  Deleting ToolEngine<" << getName() << "> from Cell <"
+           << _cell->getName() << ">" << endl;
+    Super::_preDestroy();
+  }
+
+
+  SiroccoEngine::~SiroccoEngine ()
+  {
+    if (_timingGraph) delete _timingGraph;
+    if (_liberty    ) delete _liberty;
+    delete _configuration;
+  }
+
+
+  const Name& SiroccoEngine::getName () const
+  { return _toolName; }
+
+
+  bool  SiroccoEngine::loadLiberty ( const string& path )
+  {
+    Liberty* liberty = Liberty::load( path );
+    if (not liberty) return false;
+
+    if (_timingGraph) delete _timingGraph;
+    if (_liberty    ) delete _liberty;
+    _timingGraph = NULL;
+    _liberty     = liberty;
+    _configuration->setLibertyFile( path );
+
+    cmess1 << "  o  Loaded Liberty library <" << _liberty->getName() << ">" << endl;
+    cmess2 << Dots::asSizet( "     - Cells", _liberty->getCellsCount() ) << endl;
+    return true;
+  }
+
+
+  void  SiroccoEngine::buildGraph ()
+  {
+    if (not _liberty) {
+      const string& path = _configuration->getLibertyFile();
+      if (path.empty() or not loadLiberty(path))
+        throw Error( "SiroccoEngine::buildGraph(): No Liberty library loaded for \"%s\"."
+                   , getString(getCell()->getName()).c_str() );
+    }
+
+    cmess1 << "  o  Building timing graph of " << getCell() << endl;
+    getCell()->flattenNets( NULL, std::set<string>(), Cell::Flags::NoClockFlatten );
+
+    if (_timingGraph) delete _timingGraph;
+    _timingGraph = new TimingGraph ( getCell(), _configuration );
+    _timingGraph->build( _liberty );
+
+    cmess2 << Dots::asSizet( "     - Instances", _timingGraph->getInstancesCount() ) << endl;
+    cmess2 << Dots::asSizet( "     - Nets"     , _timingGraph->getNetsCount()      ) << endl;
+    cmess2 << Dots::asSizet( "     - Pins"     , _timingGraph->getNodesCount()     ) << endl;
+    cmess2 << Dots::asSizet( "     - Levels"   , _timingGraph->getLevelsCount()    ) << endl;
+  }
+
+
+  void  SiroccoEngine::analyze ()
+  {
+    startMeasures();
+    if (not _timingGraph) buildGraph();
+
+    cmess1 << "  o  Propagating arrival & required times." << endl;
+    _timingGraph->propagate();
+
+    stopMeasures();
+    printSummary();
+    printMeasures();
+  }
+
+
+  void  SiroccoEngine::updateInstance ( Instance* instance )
+  { if (_timingGraph) _timingGraph->updateInstance( instance, _liberty ); }
+
+
+  void  SiroccoEngine::removeInstance ( Instance* instance )
+  { if (_timingGraph) _timingGraph->removeInstance( instance ); }
+
+
+  void  SiroccoEngine::updateNet ( Net* net )
+  { if (_timingGraph) _timingGraph->updateNet( net ); }
+
+
+  void  SiroccoEngine::removeNet ( Net* net )
+  { if (_timingGraph) _timingGraph->removeNet( net ); }
+
+
+  void  SiroccoEngine::updateTiming ()
+  { if (_timingGraph) _timingGraph->update(); }
+
+
+  double  SiroccoEngine::getWorstSlack () const
+  {
+    double worst = std::numeric_limits<double>::infinity();
+    if (not _timingGraph) return worst;
+    _timingGraph->update();
+    for ( uint32_t node : _timingGraph->getEndPoints() )
+      worst = std::min( worst, _timingGraph->getSlack(node) );
+    return worst;
+  }
+
+
+  double  SiroccoEngine::getTotalNegativeSlack () const
+  {
+    double total = 0.0;
+    if (not _timingGraph) return total;
+    _timingGraph->update();
+    for ( uint32_t node : _timingGraph->getEndPoints() ) {
+      double slack = _timingGraph->getSlack( node );
+      if (slack < 0.0) total += slack;
+    }
+    return total;
+  }
+
+
+  size_t  SiroccoEngine::getViolationsCount () const
+  {
+    size_t count = 0;
+    if (not _timingGraph) return count;
+    _timingGraph->update();
+    for ( uint32_t node : _timingGraph->getEndPoints() ) {
+      if (_timingGraph->getSlack(node) < 0.0) ++count;
+    }
+    return count;
+  }
+
+
+  double  SiroccoEngine::getNetSlack ( const Net* net ) const
+  {
+    if (not _timingGraph) return std::numeric_limits<double>::infinity();
+    _timingGraph->update();
+    uint32_t node = _timingGraph->getNetNode( _timingGraph->getNetIndex(net) );
+    if (node == TimingGraph::NoIndex) return std::numeric_limits<double>::infinity();
+    return _timingGraph->getSlack( node );
+  }
+
+
+  double  SiroccoEngine::getNetArrival ( const Net* net ) const
+  {
+    if (not _timingGraph) return -std::numeric_limits<double>::infinity();
+    _timingGraph->update();
+    uint32_t node = _timingGraph->getNetNode( _timingGraph->getNetIndex(net) );
+    if (node == TimingGraph::NoIndex) return -std::numeric_limits<double>::infinity();
+    return std::max( _timingGraph->getArrival(node,TimingGraph::Rise)
+                   , _timingGraph->getArrival(node,TimingGraph::Fall) );
+  }
+
+
+// Report the critical path of the paths worst endpoints.
+  void  SiroccoEngine::report ( size_t paths ) const
+  {
+    if (not _timingGraph) {
+      cerr << Warning( "SiroccoEngine::report(): No timing analysis done on \"%s\"."
+                     , getString(getCell()->getName()).c_str() ) << endl;
+      return;
+    }
+    _timingGraph->update();
+
+    vector< pair<double,uint32_t> > endPoints;
+    for ( uint32_t node : _timingGraph->getEndPoints() ) {
+      double slack = _timingGraph->getSlack( node );
+      if (slack != std::numeric_limits<double>::infinity())
+        endPoints.push_back( std::make_pair(slack,node) );
+    }
+    paths = std::min( paths, endPoints.size() );
+    std::partial_sort( endPoints.begin(), endPoints.begin()+paths, endPoints.end() );
+
+    vector< pair<uint32_t,TimingGraph::Edge> > path;
+    for ( size_t i=0 ; i<paths ; ++i ) {
+      uint32_t          node  = endPoints[i].second;
+      TimingGraph::Edge edge  = (_timingGraph->getSlack(node,TimingGraph::Rise) <= _timingGraph->getSlack(node,TimingGraph::Fall))
+                              ? TimingGraph::Rise : TimingGraph::Fall;
+      _timingGraph->getCriticalPath( node, edge, path );
+
+      cmess1 << "  o  Path #" << (i+1) << ", slack " << fixed << setprecision(3)
+             << (endPoints[i].first*1e+9) << " ns, to " << _timingGraph->getNodeName(node) << endl;
+      cmess1 << "     " << right << setw(10) << "Arrival" << setw(10) << "Slew"
+             << "  Edge  Pin" << endl;
+      for ( auto item : path ) {
+        double arrival = _timingGraph->getArrival( item.first, item.second );
+        cmess1 << "     " << right << fixed << setprecision(3);
+        if (arrival == -std::numeric_limits<double>::infinity())
+          cmess1 << setw(10) << "clock";
+        else
+          cmess1 << setw(10) << (arrival*1e+9);
+        cmess1 << setw(10) << (_timingGraph->getSlew(item.first,item.second)*1e+9)
+               << "  " << ((item.second == TimingGraph::Rise) ? "R   " : "F   ")
+               << "  " << left << _timingGraph->getNodeName(item.first) << endl;
+      }
+      cmess1 << "     " << right << setw(10)
+             << (_timingGraph->getRequired(node,edge)*1e+9) << "  required" << endl;
+    }
+  }
+
+
+  void  SiroccoEngine::printSummary () const
+  {
+    if (not _timingGraph) return;
+    _timingGraph->update();
+
+    double worst = getWorstSlack();
+    cmess1 << "  o  Timing summary of " << getCell() << endl;
+    cmess1 << Dots::asSizet ( "     - Endpoints"           , _timingGraph->getEndPoints().size() ) << endl;
+    if (worst != std::numeric_limits<double>::infinity())
+      cmess1 << Dots::asDouble( "     - Worst slack (ns)"  , worst*1e+9 ) << endl;
+    cmess1 << Dots::asDouble( "     - Total negative slack (ns)", getTotalNegativeSlack()*1e+9 ) << endl;
+    cmess1 << Dots::asSizet ( "     - Violations"          , getViolationsCount() ) << endl;
+    if (_timingGraph->getLoopsCount())
+      cmess1 << Dots::asSizet( "     - Pins in loops (untimed)", _timingGraph->getLoopsCount() ) << endl;
+    if (_timingGraph->getUnknownsCount())
+      cmess1 << Dots::asSizet( "     - Instances without model", _timingGraph->getUnknownsCount() ) << endl;
+  }
+
+
+  string  SiroccoEngine::_getTypeName () const
+  { return "Sirocco::SiroccoEngine"; }
+
+
+  string  SiroccoEngine::_getString () const
+  {
+    ostringstream  os;
+    os << "<" << "SiroccoEngine " << _cell->getName() << ">";
+    return os.str();
+  }
+
+
+  Record* SiroccoEngine::_getRecord () const
+  {
+    Record* record = Super::_getRecord();
+    if (record) {
+      record->add( getSlot( "_configuration", _configuration ) );
+      record->add( getSlot( "_liberty"      , _liberty       ) );
+      record->add( getSlot( "_timingGraph"  , _timingGraph   ) );
+    }
+    return record;
+  }
+
+
+}  // Sirocco namespace.
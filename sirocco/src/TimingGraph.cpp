@@ -0,0 +1,1076 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |         S i r o c c o  -  Static Timing Analysis                |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./TimingGraph.cpp"                             |
+// +-----------------------------------------------------------------+
+
+
+#include <cmath>
+#include <map>
+#include <queue>
+#include <sstream>
+#include <algorithm>
+#include "hurricane/Error.h"
+#include "hurricane/Warning.h"
+#include "hurricane/Path.h"
+#include "hurricane/Pin.h"
+#include "hurricane/Plug.h"
+#include "hurricane/Net.h"
+#include "hurricane/Segment.h"
+#include "hurricane/RoutingPad.h"
+#include "hurricane/Instance.h"
+#include "hurricane/Cell.h"
+#include "hurricane/FlatOccurrenceTable.h"
+#include "hurricane/ThreadPool.h"
+#include "sirocco/Configuration.h"
+#include "sirocco/TimingGraph.h"
+
+
+namespace {
+
+  using Sirocco::LibArc;
+
+
+  const double  Infinity = std::numeric_limits<double>::infinity();
+  const double  Ln9      = 2.1972245773362196;
+
+
+// Tells if an input transition gives the output one through an arc.
+  inline bool  propagates ( LibArc::Sense sense, unsigned int inEdge, unsigned int outEdge )
+  {
+    switch ( sense ) {
+      case LibArc::PositiveUnate: return (inEdge == outEdge);
+      case LibArc::NegativeUnate: return (inEdge != outEdge);
+      default: break;
+    }
+    return true;
+  }
+
+
+  inline const Sirocco::LuTable& getDelayTable ( const LibArc* arc, unsigned int outEdge )
+  { return arc->getTable( (outEdge == 0) ? LibArc::CellRise : LibArc::CellFall ); }
+
+
+// Tells if two cells have the same pins, in the same order, so the
+// nodes of an instance can be kept when swapping it's master.
+  bool  hasSamePins ( const Sirocco::LibCell* lhs, const Sirocco::LibCell* rhs )
+  {
+    if (lhs->getPinsCount() != rhs->getPinsCount()) return false;
+    for ( uint32_t ipin=0 ; ipin<lhs->getPinsCount() ; ++ipin ) {
+      if (lhs->getPin(ipin)->getName() != rhs->getPin(ipin)->getName()) return false;
+    }
+    return true;
+  }
+
+
+}  // Anonymous namespace.
+
+
+namespace Sirocco {
+
+  using std::string;
+  using std::vector;
+  using std::map;
+  using std::pair;
+  using std::make_pair;
+  using std::min;
+  using std::max;
+  using std::cerr;
+  using std::endl;
+  using std::ostringstream;
+  using Hurricane::Error;
+  using Hurricane::Warning;
+  using Hurricane::DbU;
+  using Hurricane::Box;
+  using Hurricane::Point;
+  using Hurricane::Path;
+  using Hurricane::Pin;
+  using Hurricane::Plug;
+  using Hurricane::Component;
+  using Hurricane::Segment;
+  using Hurricane::Occurrence;
+  using Hurricane::FlatOccurrenceTable;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Sirocco::TimingGraph".
+
+  TimingGraph::TimingGraph ( Cell* cell, const Configuration* configuration )
+    : _cell         (cell)
+    , _configuration(configuration)
+    , _pool         (new ThreadPool( max( 1u, configuration->getThreads() )))
+    , _instances    ()
+    , _instanceMap  ()
+    , _occurrences  ()
+    , _nets         ()
+    , _netMap       ()
+    , _nodeInstances()
+    , _nodePins     ()
+    , _nodeNets     ()
+    , _nodeFlags    ()
+    , _nodeLevels   ()
+    , _wireDelays   ()
+    , _arrivals     ()
+    , _slews        ()
+    , _requireds    ()
+    , _levelStarts  ()
+    , _levelNodes   ()
+    , _endPoints    ()
+    , _dirtyArrivals ()
+    , _dirtyRequireds()
+    , _dirtyLevels   ()
+    , _staleEndPoints(0)
+    , _loopsCount   (0)
+    , _unknownsCount(0)
+    , _levelBucketsValid(false)
+    , _fullUpdate   (false)
+  { }
+
+
+  TimingGraph::~TimingGraph ()
+  { delete _pool; }
+
+
+  double  TimingGraph::getSlack ( uint32_t node, Edge edge ) const
+  {
+    double arrival  = _arrivals [2*node+edge];
+    double required = _requireds[2*node+edge];
+    if ((arrival == -Infinity) or (required == Infinity)) return Infinity;
+    return required - arrival;
+  }
+
+
+  double  TimingGraph::getSlack ( uint32_t node ) const
+  { return min( getSlack(node,Rise), getSlack(node,Fall) ); }
+
+
+  uint32_t  TimingGraph::getNetIndex ( const Net* net ) const
+  {
+    auto inet = _netMap.find( net );
+    return (inet != _netMap.end()) ? inet->second : NoIndex;
+  }
+
+
+  uint32_t  TimingGraph::getNetNode ( uint32_t net ) const
+  { return (net != NoIndex) ? _nets[net]._driver : NoIndex; }
+
+
+  string  TimingGraph::getNodeName ( uint32_t node ) const
+  {
+    uint32_t iinstance = _nodeInstances[node];
+    if (iinstance == NoIndex) {
+      uint32_t inet = _nodeNets[node];
+      if ((inet == NoIndex) or not _nets[inet]._net) return "(detached)";
+      return getString( _nets[inet]._net->getName() );
+    }
+
+    const InstanceData& data = _instances[iinstance];
+    Path path ( Path(data._path), data._instance );
+    return path.getName() + "." + getString( _nodePins[node]->getName() );
+  }
+
+
+  uint32_t  TimingGraph::_getFirstNode ( uint32_t node ) const
+  { return _instances[ _nodeInstances[node] ]._firstNode; }
+
+
+  bool  TimingGraph::_isSink ( uint32_t node ) const
+  {
+    uint32_t inet = _nodeNets[node];
+    return (inet != NoIndex) and (_nets[inet]._driver != node);
+  }
+
+
+// Map a RoutingPad of a flattened net to the node of the terminal
+// instance pin it stands for. The RoutingPad occurrence is either the
+// Plug itself or a component of the master net.
+  uint32_t  TimingGraph::_getNode ( RoutingPad* rp ) const
+  {
+    Occurrence  occurrence = rp->getOccurrence();
+    Instance*   instance   = NULL;
+    SharedPath* path       = NULL;
+    const Net*  masterNet  = NULL;
+
+    Plug* plug = dynamic_cast<Plug*>( occurrence.getEntity() );
+    if (plug) {
+      instance  = plug->getInstance();
+      path      = occurrence.getPath()._getSharedPath();
+      masterNet = plug->getMasterNet();
+    } else {
+      Component* component = dynamic_cast<Component*>( occurrence.getEntity() );
+      if (not component) return NoIndex;
+      instance  = occurrence.getPath().getTailInstance();
+      path      = occurrence.getPath().getHeadPath()._getSharedPath();
+      masterNet = component->getNet();
+    }
+
+    auto iinstance = _instanceMap.find( PathKey(path,instance) );
+    if (iinstance == _instanceMap.end()) return NoIndex;
+    const InstanceData& data = _instances[ iinstance->second ];
+    if (not data._libCell) return NoIndex;
+    uint32_t ipin = data._libCell->getPinIndex( masterNet->getName() );
+    if (ipin == LibCell::NoPin) return NoIndex;
+    return data._firstNode + ipin;
+  }
+
+
+  uint32_t  TimingGraph::_addNode ( uint32_t iinstance, const LibPin* pin )
+  {
+    _nodeInstances.push_back( iinstance );
+    _nodePins     .push_back( pin );
+    _nodeNets     .push_back( NoIndex );
+    _nodeFlags    .push_back( 0 );
+    _nodeLevels   .push_back( 0 );
+    _wireDelays   .push_back( 0.0 );
+    for ( unsigned int edge=0 ; edge<2 ; ++edge ) {
+      _arrivals .push_back( -Infinity );
+      _slews    .push_back( 0.0 );
+      _requireds.push_back(  Infinity );
+    }
+    return (uint32_t)(_nodePins.size() - 1);
+  }
+
+
+  uint32_t  TimingGraph::_addInstance ( Instance* instance, SharedPath* path, const LibCell* libCell )
+  {
+    uint32_t iinstance = _instances.size();
+    uint32_t first     = NoIndex;
+    if (libCell) {
+      first = _nodePins.size();
+      for ( uint32_t ipin=0 ; ipin<libCell->getPinsCount() ; ++ipin )
+        _addNode( iinstance, libCell->getPin(ipin) );
+    }
+    _instanceMap.insert( make_pair( PathKey(path,instance), iinstance ));
+    _occurrences.insert( make_pair( instance, iinstance ));
+    _instances.push_back( InstanceData( instance, path, libCell, first ));
+    return iinstance;
+  }
+
+
+// Kill the nodes of an instance occurrence. They are left on their
+// nets, which are returned to be reconnected by the caller.
+  void  TimingGraph::_retireNodes ( uint32_t iinstance, vector<uint32_t>& nets )
+  {
+    const InstanceData& data = _instances[iinstance];
+    if (not data._libCell) return;
+    for ( uint32_t ipin=0 ; ipin<data._libCell->getPinsCount() ; ++ipin ) {
+      uint32_t node = data._firstNode + ipin;
+      _touch( node );
+      if (_nodeNets[node] != NoIndex) nets.push_back( _nodeNets[node] );
+      _nodeFlags[node] |= Dead;
+    }
+  }
+
+
+// Collect the driver & the sinks of a net from it's RoutingPads, plus
+// the IO node of an external net. With steal, the pins still attached
+// to another net are moved to this one and the other net is
+// reconnected afterwards. Returns the number of ignored extra drivers.
+  size_t  TimingGraph::_connectNet ( uint32_t inet, bool steal )
+  {
+    Net*             net          = _nets[inet]._net;
+    size_t           multiDrivers = 0;
+    vector<uint32_t> owners;
+
+    for ( RoutingPad* rp : net->getRoutingPads() ) {
+      if (dynamic_cast<Pin*>(rp->getOccurrence().getEntity())) continue;
+      uint32_t node = _getNode( rp );
+      if (node == NoIndex) continue;
+      uint32_t owner = _nodeNets[node];
+      if (owner == inet) continue;
+      if (owner != NoIndex) {
+        if (not steal) continue;
+        owners.push_back( owner );
+      }
+      NetData& data = _nets[inet];
+      if (_nodePins[node]->isOutput()) {
+        if (data._driver != NoIndex) { ++multiDrivers; continue; }
+        data._driver = node;
+      } else
+        data._sinks.push_back( node );
+      _nodeNets[node] = inet;
+    }
+
+    if (net->isExternal()) {
+      if (_nets[inet]._io == NoIndex) {
+        uint32_t io = _addNode( NoIndex, NULL );
+        _nets[inet]._io = io;
+      }
+      NetData& data = _nets[inet];
+      uint32_t io   = data._io;
+      _nodeNets [io]  = inet;
+      _nodeFlags[io] &= ~(PrimaryInput|PrimaryOutput);
+      if (data._driver == NoIndex) {
+        data._driver     = io;
+        _nodeFlags[io] |= PrimaryInput;
+      } else {
+        data._sinks.push_back( io );
+        _nodeFlags[io] |= PrimaryOutput;
+      }
+    } else if (_nets[inet]._io != NoIndex) {
+      _nodeFlags[ _nets[inet]._io ] |= Dead;
+      _nets[inet]._io = NoIndex;
+    }
+
+    for ( uint32_t owner : owners ) _reconnectNet( owner, false );
+    return multiDrivers;
+  }
+
+
+// Rebuild the connexions & the wire model of a net after an edit. The
+// nodes are touched both before (old fanins) and after (new fanins).
+  void  TimingGraph::_reconnectNet ( uint32_t inet, bool steal )
+  {
+    _touchNet( inet );
+    vector<uint32_t> members = _nets[inet]._sinks;
+    if (_nets[inet]._driver != NoIndex) members.push_back( _nets[inet]._driver );
+    for ( uint32_t node : members ) {
+      if (_nodeNets[node] == inet) _nodeNets[node] = NoIndex;
+    }
+    _nets[inet]._driver = NoIndex;
+    _nets[inet]._sinks.clear();
+
+    if (_nets[inet]._net) _connectNet( inet, steal );
+    _updateNet( inet );
+    _touchNet( inet );
+    for ( uint32_t node : members ) {
+      if (_nodeNets[node] != inet) _touch( node );
+    }
+  }
+
+
+// Wire model. The net capacitance is the routed length, or the half
+// perimeter of the pins bounding box when not routed yet. The delay
+// of each sink is the Elmore delay of a lumped RC line going straight
+// (Manhattan distance) from the driver.
+  void  TimingGraph::_updateNet ( uint32_t inet )
+  {
+    NetData&                      data        = _nets[inet];
+    double                        resistance  = _configuration->getWireResistance();
+    double                        capacitance = _configuration->getWireCapacitance();
+    vector< pair<uint32_t,Point> > positions;
+    Point                         driverPosition;
+    bool                          hasDriver   = false;
+    Box                           pinsBb;
+
+    if (not data._net) {
+      data._wireCapacitance = 0.0;
+      data._load            = 0.0;
+      return;
+    }
+
+    for ( RoutingPad* rp : data._net->getRoutingPads() ) {
+      uint32_t node = (dynamic_cast<Pin*>(rp->getOccurrence().getEntity())) ? data._io : _getNode( rp );
+      if (node == NoIndex) continue;
+      if (_nodeNets[node] != inet) continue;
+      Point position = rp->getCenter();
+      pinsBb.merge( position );
+      if (node == data._driver) {
+        driverPosition = position;
+        hasDriver      = true;
+      } else
+        positions.push_back( make_pair(node,position) );
+    }
+
+    DbU::Unit length = 0;
+    for ( Component* component : data._net->getComponents() ) {
+      Segment* segment = dynamic_cast<Segment*>( component );
+      if (segment) length += segment->getLength();
+    }
+    if (not length and not pinsBb.isEmpty()) length = pinsBb.getWidth() + pinsBb.getHeight();
+
+    data._wireCapacitance = capacitance * DbU::toMicrons( length );
+    data._load            = data._wireCapacitance;
+    for ( uint32_t sink : data._sinks ) {
+      _wireDelays[sink] = 0.0;
+      data._load += (_nodePins[sink]) ? _nodePins[sink]->getCapacitance() : _configuration->getOutputLoad();
+    }
+    if (not hasDriver) return;
+
+    for ( auto& item : positions ) {
+      uint32_t sink     = item.first;
+      double   distance = DbU::toMicrons( std::abs( item.second.getX() - driverPosition.getX() )
+                                        + std::abs( item.second.getY() - driverPosition.getY() ));
+      double   load     = (_nodePins[sink]) ? _nodePins[sink]->getCapacitance() : _configuration->getOutputLoad();
+      _wireDelays[sink] = resistance * distance * (capacitance * distance / 2.0 + load);
+    }
+  }
+
+
+  template< typename F >
+  void  TimingGraph::_forEachFanin ( uint32_t node, F f ) const
+  {
+    if (_nodeFlags[node] & (PrimaryInput|Dead)) return;
+    if (_isSink(node)) {
+      uint32_t driver = _nets[ _nodeNets[node] ]._driver;
+      if (driver != NoIndex) f( driver );
+    }
+    const LibPin* pin = _nodePins[node];
+    if (not pin or not pin->isOutput()) return;
+    uint32_t first = _getFirstNode( node );
+    for ( const LibArc* arc : pin->getArcs() ) {
+      if (arc->isDelay() and not arc->isEdge())
+        f( first + arc->getRelatedIndex() );
+    }
+  }
+
+
+  template< typename F >
+  void  TimingGraph::_forEachFanout ( uint32_t node, F f ) const
+  {
+    if (_nodeFlags[node] & Dead) return;
+    uint32_t inet = _nodeNets[node];
+    if ((inet != NoIndex) and (_nets[inet]._driver == node)) {
+      for ( uint32_t sink : _nets[inet]._sinks ) f( sink );
+    }
+    const LibPin* pin = _nodePins[node];
+    if (not pin) return;
+    uint32_t first = _getFirstNode( node );
+    for ( const LibArc* arc : pin->getFanouts() )
+      f( first + arc->getPinIndex() );
+  }
+
+
+// Call f( from, inEdge, outEdge, arrival, slew ) for every timed fanin
+// arc of node, arrival and slew being the ones the arc gives at node.
+  template< typename F >
+  void  TimingGraph::_forEachTimedFanin ( uint32_t node, F f ) const
+  {
+    if (_isSink(node)) {
+      uint32_t driver = _nets[ _nodeNets[node] ]._driver;
+      if (driver != NoIndex) {
+        double delay = _wireDelays[node];
+        for ( unsigned int edge=0 ; edge<2 ; ++edge ) {
+          double arrival = _arrivals[ 2*driver+edge ];
+          if (arrival == -Infinity) continue;
+          double slew = _slews[ 2*driver+edge ];
+          f( driver, edge, edge, arrival+delay, std::sqrt( slew*slew + (Ln9*delay)*(Ln9*delay) ));
+        }
+      }
+    }
+
+    const LibPin* pin = _nodePins[node];
+    if (not pin or not pin->isOutput()) return;
+    uint32_t inet      = _nodeNets[node];
+    double   load      = (inet != NoIndex) ? _nets[inet]._load : 0.0;
+    double   clockSlew = _configuration->getClockSlew();
+    uint32_t first     = _getFirstNode( node );
+    for ( const LibArc* arc : pin->getArcs() ) {
+      if (not arc->isDelay()) continue;
+      uint32_t from = first + arc->getRelatedIndex();
+      double   slew = 0.0;
+      if (arc->isEdge()) {
+        unsigned int inEdge = (arc->getType() == LibArc::RisingEdge) ? Rise : Fall;
+        for ( unsigned int outEdge=0 ; outEdge<2 ; ++outEdge ) {
+          if (getDelayTable(arc,outEdge).isEmpty()) continue;
+          double delay = arc->getDelay( (outEdge == Rise), clockSlew, load, slew );
+          f( from, inEdge, outEdge, delay, slew );
+        }
+        continue;
+      }
+      for ( unsigned int inEdge=0 ; inEdge<2 ; ++inEdge ) {
+        double arrival = _arrivals[ 2*from+inEdge ];
+        if (arrival == -Infinity) continue;
+        for ( unsigned int outEdge=0 ; outEdge<2 ; ++outEdge ) {
+          if (not propagates(arc->getSense(),inEdge,outEdge)) continue;
+          if (getDelayTable(arc,outEdge).isEmpty()) continue;
+          double delay = arc->getDelay( (outEdge == Rise), _slews[2*from+inEdge], load, slew );
+          f( from, inEdge, outEdge, arrival+delay, slew );
+        }
+      }
+    }
+  }
+
+
+// Call f( to, inEdge, outEdge, delay ) for every timed fanout arc of node.
+  template< typename F >
+  void  TimingGraph::_forEachTimedFanout ( uint32_t node, F f ) const
+  {
+    uint32_t inet = _nodeNets[node];
+    if ((inet != NoIndex) and (_nets[inet]._driver == node)) {
+      for ( uint32_t sink : _nets[inet]._sinks ) {
+        for ( unsigned int edge=0 ; edge<2 ; ++edge )
+          f( sink, edge, edge, _wireDelays[sink] );
+      }
+    }
+
+    const LibPin* pin = _nodePins[node];
+    if (not pin) return;
+    uint32_t first = _getFirstNode( node );
+    for ( const LibArc* arc : pin->getFanouts() ) {
+      uint32_t to    = first + arc->getPinIndex();
+      uint32_t toNet = _nodeNets[to];
+      double   load  = (toNet != NoIndex) ? _nets[toNet]._load : 0.0;
+      double   slew  = 0.0;
+      for ( unsigned int inEdge=0 ; inEdge<2 ; ++inEdge ) {
+        for ( unsigned int outEdge=0 ; outEdge<2 ; ++outEdge ) {
+          if (not propagates(arc->getSense(),inEdge,outEdge)) continue;
+          if (getDelayTable(arc,outEdge).isEmpty()) continue;
+          f( to, inEdge, outEdge, arc->getDelay( (outEdge == Rise), _slews[2*node+inEdge], load, slew ));
+        }
+      }
+    }
+  }
+
+
+  void  TimingGraph::_computeArrival ( uint32_t node )
+  {
+    double*  arrivals = &_arrivals[2*node];
+    double*  slews    = &_slews   [2*node];
+    uint32_t flags    = _nodeFlags[node];
+
+    arrivals[Rise] = arrivals[Fall] = -Infinity;
+    slews   [Rise] = slews   [Fall] = 0.0;
+    if (flags & (InLoop|Dead)) return;
+    if (flags & PrimaryInput) {
+      arrivals[Rise] = arrivals[Fall] = _configuration->getInputDelay();
+      slews   [Rise] = slews   [Fall] = _configuration->getInputSlew();
+      return;
+    }
+    _forEachTimedFanin( node, [&]( uint32_t, unsigned int, unsigned int outEdge, double arrival, double slew ) {
+                                if (arrival > arrivals[outEdge]) arrivals[outEdge] = arrival;
+                                if (slew    > slews   [outEdge]) slews   [outEdge] = slew;
+                              } );
+  }
+
+
+  void  TimingGraph::_computeRequired ( uint32_t node )
+  {
+    double*  requireds = &_requireds[2*node];
+    uint32_t flags     = _nodeFlags[node];
+    double   period    = _configuration->getClockPeriod();
+
+    requireds[Rise] = requireds[Fall] = Infinity;
+    if (flags & (InLoop|Dead)) return;
+    if (flags & PrimaryOutput)
+      requireds[Rise] = requireds[Fall] = period - _configuration->getOutputDelay();
+
+    const LibPin* pin = _nodePins[node];
+    if (pin and pin->isInput()) {
+      for ( const LibArc* arc : pin->getArcs() ) {
+        if (not arc->isSetup()) continue;
+        for ( unsigned int edge=0 ; edge<2 ; ++edge ) {
+          if (arc->getTable( (edge == Rise) ? LibArc::RiseConstraint : LibArc::FallConstraint ).isEmpty()) continue;
+          double setup = arc->getSetup( (edge == Rise), _slews[2*node+edge], _configuration->getClockSlew() );
+          requireds[edge] = min( requireds[edge], period - setup );
+        }
+      }
+    }
+
+    _forEachTimedFanout( node, [&]( uint32_t to, unsigned int inEdge, unsigned int outEdge, double delay ) {
+                                 double required = _requireds[2*to+outEdge] - delay;
+                                 if (required < requireds[inEdge]) requireds[inEdge] = required;
+                               } );
+  }
+
+
+// Kahn levelization. The nodes left with unprocessed fanins belong to
+// combinational loops, they are excluded from the propagation.
+  void  TimingGraph::_levelize ()
+  {
+    size_t           count   = getNodesCount();
+    vector<uint32_t> fanins  ( count, 0 );
+    vector<uint32_t> queue;
+
+    _nodeLevels.assign( count, 0 );
+    queue.reserve( count );
+    for ( uint32_t node=0 ; node<count ; ++node ) {
+      _nodeFlags[node] &= ~InLoop;
+      _forEachFanin( node, [&]( uint32_t ) { ++fanins[node]; } );
+      if (not fanins[node]) queue.push_back( node );
+    }
+    for ( size_t head=0 ; head<queue.size() ; ++head ) {
+      uint32_t node = queue[head];
+      _forEachFanout( node, [&]( uint32_t to ) {
+                              _nodeLevels[to] = max( _nodeLevels[to], _nodeLevels[node]+1 );
+                              if (not --fanins[to]) queue.push_back( to );
+                            } );
+    }
+
+    _loopsCount = 0;
+    for ( uint32_t node=0 ; node<count ; ++node ) {
+      if (fanins[node]) {
+        _nodeFlags [node] |= InLoop;
+        _nodeLevels[node]  = NoIndex;
+        ++_loopsCount;
+      }
+    }
+    _dirtyLevels.clear();
+    _fullUpdate = false;
+    _buildLevelBuckets();
+
+    if (_loopsCount)
+      cerr << Warning( "TimingGraph::_levelize(): %u pins of \"%s\" are in combinational loops and are not timed."
+                     , (unsigned int)_loopsCount, getString(_cell->getName()).c_str() ) << endl;
+  }
+
+
+  void  TimingGraph::_buildLevelBuckets ()
+  {
+    size_t   count  = getNodesCount();
+    size_t   timed  = 0;
+    uint32_t levels = 0;
+    for ( uint32_t node=0 ; node<count ; ++node ) {
+      if (_nodeLevels[node] == NoIndex) continue;
+      levels = max( levels, _nodeLevels[node]+1 );
+      ++timed;
+    }
+
+    _levelStarts.assign( levels+1, 0 );
+    for ( uint32_t node=0 ; node<count ; ++node ) {
+      if (_nodeLevels[node] != NoIndex) ++_levelStarts[ _nodeLevels[node]+1 ];
+    }
+    for ( uint32_t level=0 ; level<levels ; ++level )
+      _levelStarts[level+1] += _levelStarts[level];
+    vector<uint32_t> fills ( _levelStarts.begin(), _levelStarts.end()-1 );
+    _levelNodes.resize( timed );
+    for ( uint32_t node=0 ; node<count ; ++node ) {
+      if (_nodeLevels[node] != NoIndex) _levelNodes[ fills[_nodeLevels[node]]++ ] = node;
+    }
+    _levelBucketsValid = true;
+  }
+
+
+// Restore the levels after an edit: the level of a node is one more
+// than the highest of it's fanins, changes are pushed to the fanouts.
+// An edit closing a combinational loop would make the levels grow
+// without bound, so past a budget, or when a node in a loop is met,
+// the whole graph is levelized again.
+  void  TimingGraph::_updateLevels ()
+  {
+    if (_fullUpdate) return;
+    size_t budget = 4*getNodesCount() + 1024;
+    for ( size_t head=0 ; head<_dirtyLevels.size() ; ++head ) {
+      uint32_t node  = _dirtyLevels[head];
+      uint32_t level = 0;
+      bool     loop  = (head > budget) or (_nodeFlags[node] & InLoop);
+      if (not loop)
+        _forEachFanin( node, [&]( uint32_t from ) {
+                               if (_nodeFlags[from] & InLoop) loop = true;
+                               else level = max( level, _nodeLevels[from]+1 );
+                             } );
+      if (loop) { _fullUpdate = true; break; }
+      if (level == _nodeLevels[node]) continue;
+      _nodeLevels[node]  = level;
+      _levelBucketsValid = false;
+      _forEachFanout( node, [&]( uint32_t to ) { _dirtyLevels.push_back( to ); } );
+    }
+    _dirtyLevels.clear();
+  }
+
+
+  void  TimingGraph::build ( const Liberty* liberty )
+  {
+    const FlatOccurrenceTable& table = _cell->getFlatOccurrenceTable();
+    map<Name,size_t>           unknowns;
+
+    _instances.reserve( table.size() );
+    for ( const FlatOccurrenceTable::Entry& entry : table ) {
+      const Name&    master  = entry.getInstance()->getMasterCell()->getName();
+      const LibCell* libCell = liberty->getCell( master );
+      if (not libCell) {
+        ++unknowns[ master ];
+        ++_unknownsCount;
+      }
+      _addInstance( entry.getInstance(), entry.getSharedPath(), libCell );
+    }
+
+    size_t multiDrivers = 0;
+    for ( Net* net : _cell->getNets() ) {
+      if (net->isSupply() or net->isClock() or net->isBlockage()) continue;
+
+      uint32_t inet = _nets.size();
+      _nets.push_back( NetData(net) );
+      multiDrivers += _connectNet( inet, false );
+      if ((_nets[inet]._driver == NoIndex) and _nets[inet]._sinks.empty()) {
+        _nets.pop_back();
+        continue;
+      }
+      _netMap.insert( make_pair(net,inet) );
+    }
+
+    size_t count = getNodesCount();
+    for ( uint32_t inet=0 ; inet<_nets.size() ; ++inet ) _updateNet( inet );
+    for ( uint32_t node=0 ; node<count ; ++node ) _updateEndPoint( node );
+    _levelize();
+
+    if (multiDrivers)
+      cerr << Warning( "TimingGraph::build(): %u extra drivers on nets of \"%s\" have been ignored."
+                     , (unsigned int)multiDrivers, getString(_cell->getName()).c_str() ) << endl;
+    if (not unknowns.empty()) {
+      ostringstream masters;
+      size_t        shown = 0;
+      for ( auto item : unknowns ) {
+        if (shown++ == 10) { masters << "\n          ..."; break; }
+        masters << "\n          * \"" << item.first << "\" (" << item.second << " instances)";
+      }
+      cerr << Warning( "TimingGraph::build(): %u instances of \"%s\" have no Liberty model, they are not timed.%s"
+                     , (unsigned int)_unknownsCount, getString(_cell->getName()).c_str()
+                     , masters.str().c_str() ) << endl;
+    }
+  }
+
+
+  void  TimingGraph::_runLevels ( bool forward )
+  {
+    size_t levels = getLevelsCount();
+    for ( size_t i=0 ; i<levels ; ++i ) {
+      size_t   level = (forward) ? i : levels-1-i;
+      uint32_t begin = _levelStarts[level];
+      uint32_t end   = _levelStarts[level+1];
+      if ((_pool->size() > 1) and (end-begin >= 1024)) {
+        _pool->run( end-begin, [&]( size_t j, size_t ) {
+                                 if (forward) _computeArrival ( _levelNodes[begin+j] );
+                                 else         _computeRequired( _levelNodes[begin+j] );
+                               } );
+        continue;
+      }
+      for ( uint32_t j=begin ; j<end ; ++j ) {
+        if (forward) _computeArrival ( _levelNodes[j] );
+        else         _computeRequired( _levelNodes[j] );
+      }
+    }
+  }
+
+
+  void  TimingGraph::propagate ()
+  {
+    _updateLevels();
+    if (_fullUpdate) _levelize();
+    if (not _levelBucketsValid) _buildLevelBuckets();
+    _clearDirty();
+    _compactEndPoints();
+
+    std::fill( _arrivals .begin(), _arrivals .end(), -Infinity );
+    std::fill( _slews    .begin(), _slews    .end(), 0.0 );
+    std::fill( _requireds.begin(), _requireds.end(),  Infinity );
+    _runLevels( true  );
+    _runLevels( false );
+  }
+
+
+// Lazy propagation of the edits. The dirty nodes are recomputed by
+// increasing levels for the arrival times, then by decreasing levels
+// for the required ones. The fanouts (resp. fanins) of a node are
+// only scheduled when it's values did actually change.
+  void  TimingGraph::update ()
+  {
+    if (not isDirty()) return;
+    _updateLevels();
+    if (_fullUpdate) { propagate(); return; }
+    _compactEndPoints();
+
+    typedef  pair<uint32_t,uint32_t>  LevelNode;
+    vector<uint32_t>  seeds;
+
+    std::swap( seeds, _dirtyArrivals );
+    std::priority_queue< LevelNode, vector<LevelNode>, std::greater<LevelNode> >  forward;
+    for ( uint32_t node : seeds ) forward.push( make_pair(_nodeLevels[node],node) );
+    while (not forward.empty()) {
+      uint32_t node = forward.top().second;
+      forward.pop();
+      _nodeFlags[node] &= ~DirtyArrival;
+
+      double arrivals[2] = { _arrivals[2*node], _arrivals[2*node+1] };
+      double slews   [2] = { _slews   [2*node], _slews   [2*node+1] };
+      _computeArrival( node );
+      bool slewChanged = (slews[Rise] != _slews[2*node]) or (slews[Fall] != _slews[2*node+1]);
+      if (slewChanged) _markRequired( node );
+      if (not slewChanged and (arrivals[Rise] == _arrivals[2*node]) and (arrivals[Fall] == _arrivals[2*node+1]))
+        continue;
+      _forEachFanout( node, [&]( uint32_t to ) {
+                              if (_nodeFlags[to] & DirtyArrival) return;
+                              _nodeFlags[to] |= DirtyArrival;
+                              forward.push( make_pair(_nodeLevels[to],to) );
+                            } );
+    }
+
+    seeds.clear();
+    std::swap( seeds, _dirtyRequireds );
+    std::priority_queue< LevelNode >  backward;
+    for ( uint32_t node : seeds ) backward.push( make_pair(_nodeLevels[node],node) );
+    while (not backward.empty()) {
+      uint32_t node = backward.top().second;
+      backward.pop();
+      _nodeFlags[node] &= ~DirtyRequired;
+
+      double requireds[2] = { _requireds[2*node], _requireds[2*node+1] };
+      _computeRequired( node );
+      if ((requireds[Rise] == _requireds[2*node]) and (requireds[Fall] == _requireds[2*node+1])) continue;
+      _forEachFanin( node, [&]( uint32_t from ) {
+                             if (_nodeFlags[from] & DirtyRequired) return;
+                             _nodeFlags[from] |= DirtyRequired;
+                             backward.push( make_pair(_nodeLevels[from],from) );
+                           } );
+    }
+  }
+
+
+  void  TimingGraph::_clearDirty ()
+  {
+    for ( uint32_t node : _dirtyArrivals  ) _nodeFlags[node] &= ~DirtyArrival;
+    for ( uint32_t node : _dirtyRequireds ) _nodeFlags[node] &= ~DirtyRequired;
+    _dirtyArrivals .clear();
+    _dirtyRequireds.clear();
+  }
+
+
+// Drop the endpoints lost by the edits (and the duplicates of the ones
+// lost then found again).
+  void  TimingGraph::_compactEndPoints ()
+  {
+    if (_staleEndPoints) {
+      auto last = std::remove_if( _endPoints.begin(), _endPoints.end()
+                                , [&]( uint32_t node ) { return not (_nodeFlags[node] & EndPoint); } );
+      _endPoints.erase( last, _endPoints.end() );
+      std::sort( _endPoints.begin(), _endPoints.end() );
+      _endPoints.erase( std::unique(_endPoints.begin(),_endPoints.end()), _endPoints.end() );
+      _staleEndPoints = 0;
+    }
+  }
+
+
+  void  TimingGraph::_markArrival ( uint32_t node )
+  {
+    if (_nodeFlags[node] & DirtyArrival) return;
+    _nodeFlags[node] |= DirtyArrival;
+    _dirtyArrivals.push_back( node );
+  }
+
+
+  void  TimingGraph::_markRequired ( uint32_t node )
+  {
+    if (_nodeFlags[node] & DirtyRequired) return;
+    _nodeFlags[node] |= DirtyRequired;
+    _dirtyRequireds.push_back( node );
+  }
+
+
+// A node whose fanins, delays or load may have changed: it's arrival,
+// it's required and the required of it's fanins must be recomputed.
+  void  TimingGraph::_touch ( uint32_t node )
+  {
+    _markArrival ( node );
+    _markRequired( node );
+    _dirtyLevels.push_back( node );
+    _forEachFanin( node, [&]( uint32_t from ) { _markRequired( from ); } );
+    _updateEndPoint( node );
+  }
+
+
+  void  TimingGraph::_touchNet ( uint32_t inet )
+  {
+    const NetData& data = _nets[inet];
+    if (data._driver != NoIndex) _touch( data._driver );
+    for ( uint32_t sink : data._sinks ) _touch( sink );
+  }
+
+
+  void  TimingGraph::_updateEndPoint ( uint32_t node )
+  {
+    uint32_t& flags      = _nodeFlags[node];
+    bool      isEndPoint = false;
+    if (not (flags & Dead)) {
+      isEndPoint = (flags & PrimaryOutput);
+      if (_nodePins[node] and (_nodeNets[node] != NoIndex)) {
+        for ( const LibArc* arc : _nodePins[node]->getArcs() )
+          if (arc->isSetup()) isEndPoint = true;
+      }
+    }
+    if (isEndPoint == (bool)(flags & EndPoint)) return;
+    if (isEndPoint) {
+      flags |= EndPoint;
+      _endPoints.push_back( node );
+    } else {
+      flags &= ~EndPoint;
+      ++_staleEndPoints;
+    }
+  }
+
+
+// The master of the instance has changed, or it is a new instance of
+// the top cell. When the new model has the same pins, the nodes are
+// kept, otherwise new ones are allocated. The nets of the instance are
+// then reconnected, their loads having changed.
+  void  TimingGraph::updateInstance ( Instance* instance, const Liberty* liberty )
+  {
+    const LibCell*   libCell = liberty->getCell( instance->getMasterCell()->getName() );
+    vector<uint32_t> nets;
+    vector<Net*>     newNets;
+
+    auto range = _occurrences.equal_range( instance );
+    if (range.first == range.second) {
+      if (instance->getCell() != _cell) {
+        cerr << Warning( "TimingGraph::updateInstance(): \"%s\" is not an instance of \"%s\", the graph must be rebuilt."
+                       , getString(instance->getName()).c_str(), getString(_cell->getName()).c_str() ) << endl;
+        return;
+      }
+      if (not libCell) ++_unknownsCount;
+      uint32_t iinstance = _addInstance( instance, NULL, libCell );
+      if (libCell) {
+        for ( uint32_t ipin=0 ; ipin<libCell->getPinsCount() ; ++ipin )
+          _touch( _instances[iinstance]._firstNode + ipin );
+      }
+    } else {
+      for ( auto iocc=range.first ; iocc!=range.second ; ++iocc ) {
+        uint32_t      iinstance = iocc->second;
+        InstanceData& data      = _instances[iinstance];
+        if (data._libCell == libCell) continue;
+
+        if (data._libCell and libCell and hasSamePins(data._libCell,libCell)) {
+          for ( uint32_t ipin=0 ; ipin<libCell->getPinsCount() ; ++ipin ) {
+            uint32_t node = data._firstNode + ipin;
+            _touch( node );
+            _nodePins[node] = libCell->getPin( ipin );
+            if (_nodeNets[node] != NoIndex) nets.push_back( _nodeNets[node] );
+          }
+          data._libCell = libCell;
+        } else {
+          if (data._libCell) _retireNodes( iinstance, nets );
+          else               --_unknownsCount;
+          data._libCell   = libCell;
+          data._firstNode = NoIndex;
+          if (libCell) {
+            data._firstNode = _nodePins.size();
+            for ( uint32_t ipin=0 ; ipin<libCell->getPinsCount() ; ++ipin )
+              _addNode( iinstance, libCell->getPin(ipin) );
+          } else
+            ++_unknownsCount;
+        }
+        if (libCell) {
+          for ( uint32_t ipin=0 ; ipin<libCell->getPinsCount() ; ++ipin )
+            _touch( data._firstNode + ipin );
+        }
+      }
+    }
+
+    if (instance->getCell() == _cell) {
+      for ( Plug* plug : instance->getConnectedPlugs() ) {
+        uint32_t inet = getNetIndex( plug->getNet() );
+        if (inet != NoIndex) nets.push_back( inet );
+        else                 newNets.push_back( plug->getNet() );
+      }
+    }
+    std::sort( nets.begin(), nets.end() );
+    nets.erase( std::unique(nets.begin(),nets.end()), nets.end() );
+    for ( uint32_t inet : nets ) _reconnectNet( inet, true );
+    for ( Net* net : newNets ) updateNet( net );
+  }
+
+
+// To be called *before* the instance is destroyed.
+  void  TimingGraph::removeInstance ( Instance* instance )
+  {
+    vector<uint32_t> nets;
+    auto range = _occurrences.equal_range( instance );
+    for ( auto iocc=range.first ; iocc!=range.second ; ++iocc ) {
+      InstanceData& data = _instances[ iocc->second ];
+      if (data._libCell) _retireNodes( iocc->second, nets );
+      else               --_unknownsCount;
+      _instanceMap.erase( PathKey(data._path,data._instance) );
+      data._instance  = NULL;
+      data._libCell   = NULL;
+      data._firstNode = NoIndex;
+    }
+    _occurrences.erase( instance );
+
+    std::sort( nets.begin(), nets.end() );
+    nets.erase( std::unique(nets.begin(),nets.end()), nets.end() );
+    for ( uint32_t inet : nets ) _reconnectNet( inet, false );
+  }
+
+
+// The connexions or the wiring of the net have changed, or it is a
+// new net. The RoutingPads must be up to date.
+  void  TimingGraph::updateNet ( Net* net )
+  {
+    if (net->isSupply() or net->isClock() or net->isBlockage()) return;
+    uint32_t inet = getNetIndex( net );
+    if (inet == NoIndex) {
+      inet = _nets.size();
+      _nets.push_back( NetData(net) );
+      _netMap.insert( make_pair(net,inet) );
+    }
+    _reconnectNet( inet, true );
+  }
+
+
+// To be called *before* the net is destroyed.
+  void  TimingGraph::removeNet ( Net* net )
+  {
+    uint32_t inet = getNetIndex( net );
+    if (inet == NoIndex) return;
+    _netMap.erase( net );
+    _nets[inet]._net = NULL;
+    if (_nets[inet]._io != NoIndex) {
+      _nodeFlags[ _nets[inet]._io ] |= Dead;
+      _nets[inet]._io = NoIndex;
+    }
+    _reconnectNet( inet, false );
+  }
+
+
+// Walk back the fanins giving the arrival time, from node down to a
+// primary input or to the clock pin of a launching register.
+  void  TimingGraph::getCriticalPath ( uint32_t node, Edge edge, vector< pair<uint32_t,Edge> >& path ) const
+  {
+    path.clear();
+    path.push_back( make_pair(node,edge) );
+    while (_arrivals[2*node+edge] != -Infinity) {
+      uint32_t best        = NoIndex;
+      Edge     bestEdge    = Rise;
+      double   bestArrival = -Infinity;
+      _forEachTimedFanin( node, [&]( uint32_t from, unsigned int inEdge, unsigned int outEdge, double arrival, double ) {
+                                  if ((outEdge == (unsigned int)edge) and (arrival > bestArrival)) {
+                                    bestArrival = arrival;
+                                    best        = from;
+                                    bestEdge    = (Edge)inEdge;
+                                  }
+                                } );
+      if (best == NoIndex) break;
+      path.push_back( make_pair(best,bestEdge) );
+      node = best;
+      edge = bestEdge;
+    }
+    std::reverse( path.begin(), path.end() );
+  }
+
+
+  string  TimingGraph::_getTypeName () const
+  { return "Sirocco::TimingGraph"; }
+
+
+  string  TimingGraph::_getString () const
+  {
+    ostringstream  os;
+    os << "<TimingGraph " << _cell->getName()
+       << " nodes:" << getNodesCount()
+       << " nets:" << getNetsCount()
+       << " levels:" << getLevelsCount() << ">";
+    return os.str();
+  }
+
+
+  Record* TimingGraph::_getRecord () const
+  {
+    Record* record = new Record ( _getString() );
+    if (record) {
+      record->add( getSlot( "_cell"         , _cell          ) );
+      record->add( getSlot( "_configuration", _configuration ) );
+      record->add( getSlot( "_loopsCount"   , _loopsCount    ) );
+      record->add( getSlot( "_unknownsCount", _unknownsCount ) );
+    }
+    return record;
+  }
+
+
+}  // Sirocco namespace.
@@ -0,0 +1,95 @@
+// -*- mode: C++; explicit-buffer-name: "Configuration.h<sirocco>" -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024.
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |         S i r o c c o  -  Static Timing Analysis                |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./sirocco/Configuration.h"                     |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include <string>
+#include "hurricane/Commons.h"
+namespace Hurricane {
+  class Cell;
+}
+
+
+namespace Sirocco {
+
+  using  std::string;
+  using  Hurricane::Record;
+  using  Hurricane::Cell;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Sirocco::Configuration".
+//
+// Parameters are given in the usual designer units (ns, fF, Ohm/um
+// and fF/um) and stored in SI units.
+
+  class Configuration {
+    public:
+    // Constructor & Destructor.
+                              Configuration          ();
+                             ~Configuration          ();
+             Configuration*   clone                  () const;
+    // Methods.                                      
+      inline const string&    getLibertyFile         () const;
+      inline double           getClockPeriod         () const;
+      inline double           getClockSlew           () const;
+      inline double           getInputSlew           () const;
+      inline double           getInputDelay          () const;
+      inline double           getOutputDelay         () const;
+      inline double           getOutputLoad          () const;
+      inline double           getWireResistance      () const;
+      inline double           getWireCapacitance     () const;
+      inline uint32_t         getThreads             () const;
+      inline void             setLibertyFile         ( const string& );
+      inline void             setClockPeriod         ( double );
+             void             print                  ( Cell* ) const;
+             Record*          _getRecord             () const;
+             string           _getString             () const;
+             string           _getTypeName           () const;
+    protected:
+    // Attributes.
+      string    _libertyFile;
+      double    _clockPeriod;
+      double    _clockSlew;
+      double    _inputSlew;
+      double    _inputDelay;
+      double    _outputDelay;
+      double    _outputLoad;
+      double    _wireResistance;
+      double    _wireCapacitance;
+      uint32_t  _threads;
+    private:
+                             Configuration ( const Configuration& );
+      Configuration& operator=             ( const Configuration& );
+  };
+
+
+  inline const string&  Configuration::getLibertyFile     () const { return _libertyFile; }
+  inline double         Configuration::getClockPeriod     () const { return _clockPeriod; }
+  inline double         Configuration::getClockSlew       () const { return _clockSlew; }
+  inline double         Configuration::getInputSlew       () const { return _inputSlew; }
+  inline double         Configuration::getInputDelay      () const { return _inputDelay; }
+  inline double         Configuration::getOutputDelay     () const { return _outputDelay; }
+  inline double         Configuration::getOutputLoad      () const { return _outputLoad; }
+  inline double         Configuration::getWireResistance  () const { return _wireResistance; }
+  inline double         Configuration::getWireCapacitance () const { return _wireCapacitance; }
+  inline uint32_t       Configuration::getThreads         () const { return _threads; }
+  inline void           Configuration::setLibertyFile     ( const string& path ) { _libertyFile = path; }
+  inline void           Configuration::setClockPeriod     ( double period ) { _clockPeriod = period; }
+
+
+} // Sirocco namespace.
+
+INSPECTOR_P_SUPPORT(Sirocco::Configuration);
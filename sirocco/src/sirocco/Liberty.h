@@ -0,0 +1,285 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |         S i r o c c o  -  Static Timing Analysis                |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./sirocco/Liberty.h"                           |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include <string>
+#include <vector>
+#include <map>
+#include "hurricane/Name.h"
+#include "hurricane/Commons.h"
+
+
+namespace Sirocco {
+
+  using Hurricane::Name;
+  using Hurricane::Record;
+  class LibCell;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Sirocco::LuTable".
+//
+// NLDM lookup table. Indexes and values are converted in SI units
+// (seconds & farads) when the library is loaded. getValue() always
+// takes a transition as first argument and a second quantity which
+// is the output load for delay tables and the related (clock) pin
+// transition for constraint tables, whatever the order of the
+// variables in the table template. Outside of the indexes range,
+// the value is linearly extrapolated from the two nearest points,
+// as in CRL::CLuTable.
+
+  class LuTable {
+    public:
+      enum Variable { Constant              = 0
+                    , InputTransition       = 1
+                    , OutputLoad            = 2
+                    , ConstrainedTransition = 3
+                    , RelatedTransition     = 4
+                    };
+    public:
+                                  LuTable      ();
+      inline  bool                isEmpty      () const;
+      inline  Variable            getVariable  ( size_t ) const;
+      inline  const std::vector<double>&
+                                  getIndex     ( size_t ) const;
+      inline  const std::vector<double>&
+                                  getValues    () const;
+      inline  void                setVariable  ( size_t, Variable );
+              void                setIndex     ( size_t, const std::vector<double>& );
+              void                setValues    ( const std::vector<double>& );
+              bool                check        () const;
+              double              getValue     ( double transition, double other ) const;
+              std::string         _getTypeName () const;
+              std::string         _getString   () const;
+              Record*             _getRecord   () const;
+    private:
+      static  void                _bracket     ( const std::vector<double>&, double, size_t&, double& );
+    private:
+      Variable             _variables[2];
+      std::vector<double>  _indexes  [2];
+      std::vector<double>  _values;
+  };
+
+
+  inline bool               LuTable::isEmpty     () const { return _values.empty(); }
+  inline LuTable::Variable  LuTable::getVariable ( size_t i ) const { return _variables[i]; }
+  inline const std::vector<double>&
+                            LuTable::getIndex    ( size_t i ) const { return _indexes[i]; }
+  inline const std::vector<double>&
+                            LuTable::getValues   () const { return _values; }
+  inline void               LuTable::setVariable ( size_t i, Variable variable ) { _variables[i] = variable; }
+
+
+// -------------------------------------------------------------------
+// Class  :  "Sirocco::LibArc".
+//
+// One "timing()" group of a pin, that is, an arc from the related pin
+// to the pin owning it. A group with more than one related pin gives
+// as many arcs.
+
+  class LibArc {
+    public:
+      enum Sense { PositiveUnate  = 0
+                 , NegativeUnate  = 1
+                 , NonUnate       = 2
+                 };
+      enum Type  { Combinational  = 0
+                 , RisingEdge     = 1
+                 , FallingEdge    = 2
+                 , SetupRising    = 3
+                 , SetupFalling   = 4
+                 , Ignored        = 5
+                 };
+      enum Table { CellRise       = 0
+                 , CellFall       = 1
+                 , RiseTransition = 2
+                 , FallTransition = 3
+                 , RiseConstraint = 4
+                 , FallConstraint = 5
+                 , TableCount     = 6
+                 };
+    public:
+                                  LibArc          ();
+      inline  bool                isDelay         () const;
+      inline  bool                isEdge          () const;
+      inline  bool                isSetup         () const;
+      inline  Sense               getSense        () const;
+      inline  Type                getType         () const;
+      inline  uint32_t            getPinIndex     () const;
+      inline  uint32_t            getRelatedIndex () const;
+      inline  const std::string&  getRelatedName  () const;
+      inline  const LuTable&      getTable        ( Table ) const;
+              double              getDelay        ( bool outRise, double slew, double load, double& outSlew ) const;
+              double              getSetup        ( bool dataRise, double dataSlew, double clockSlew ) const;
+              std::string         _getTypeName    () const;
+              std::string         _getString      () const;
+              Record*             _getRecord      () const;
+    public:
+      std::string  _relatedName;
+      uint32_t     _pinIndex;
+      uint32_t     _relatedIndex;
+      Sense        _sense;
+      Type         _type;
+      LuTable      _tables[TableCount];
+  };
+
+
+  inline bool               LibArc::isDelay         () const { return (_type <= FallingEdge); }
+  inline bool               LibArc::isEdge          () const { return (_type == RisingEdge) or (_type == FallingEdge); }
+  inline bool               LibArc::isSetup         () const { return (_type == SetupRising) or (_type == SetupFalling); }
+  inline LibArc::Sense      LibArc::getSense        () const { return _sense; }
+  inline LibArc::Type       LibArc::getType         () const { return _type; }
+  inline uint32_t           LibArc::getPinIndex     () const { return _pinIndex; }
+  inline uint32_t           LibArc::getRelatedIndex () const { return _relatedIndex; }
+  inline const std::string& LibArc::getRelatedName  () const { return _relatedName; }
+  inline const LuTable&     LibArc::getTable        ( Table table ) const { return _tables[table]; }
+
+
+// -------------------------------------------------------------------
+// Class  :  "Sirocco::LibPin".
+
+  class LibPin {
+    public:
+      enum Direction { Input    = 0
+                     , Output   = 1
+                     , InOut    = 2
+                     , Internal = 3
+                     };
+    public:
+                                  LibPin          ( const Name&, uint32_t index );
+      inline  bool                isInput         () const;
+      inline  bool                isOutput        () const;
+      inline  bool                isClock         () const;
+      inline  const Name&         getName         () const;
+      inline  uint32_t            getIndex        () const;
+      inline  Direction           getDirection    () const;
+      inline  double              getCapacitance  () const;
+      inline  const std::vector<LibArc*>&
+                                  getArcs         () const;
+      inline  const std::vector<const LibArc*>&
+                                  getFanouts      () const;
+              std::string         _getTypeName    () const;
+              std::string         _getString      () const;
+              Record*             _getRecord      () const;
+    public:
+      Name                         _name;
+      uint32_t                     _index;
+      Direction                    _direction;
+      double                       _capacitance;
+      bool                         _isClock;
+      std::vector<LibArc*>         _arcs;
+      std::vector<const LibArc*>   _fanouts;
+  };
+
+
+  inline bool                LibPin::isInput        () const { return (_direction == Input) or (_direction == InOut); }
+  inline bool                LibPin::isOutput       () const { return (_direction == Output) or (_direction == InOut); }
+  inline bool                LibPin::isClock        () const { return _isClock; }
+  inline const Name&         LibPin::getName        () const { return _name; }
+  inline uint32_t            LibPin::getIndex       () const { return _index; }
+  inline LibPin::Direction   LibPin::getDirection   () const { return _direction; }
+  inline double              LibPin::getCapacitance () const { return _capacitance; }
+  inline const std::vector<LibArc*>&
+                             LibPin::getArcs        () const { return _arcs; }
+  inline const std::vector<const LibArc*>&
+                             LibPin::getFanouts     () const { return _fanouts; }
+
+
+// -------------------------------------------------------------------
+// Class  :  "Sirocco::LibCell".
+
+  class LibCell {
+    public:
+      static constexpr uint32_t  NoPin = (uint32_t)-1;
+    public:
+                                      LibCell         ( const Name& );
+                                     ~LibCell         ();
+      inline  bool                    isSequential    () const;
+      inline  const Name&             getName         () const;
+      inline  size_t                  getPinsCount    () const;
+      inline  const LibPin*           getPin          ( uint32_t ) const;
+              uint32_t                getPinIndex     ( const Name& ) const;
+              LibPin*                 addPin          ( const Name& );
+              void                    link            ();
+              std::string             _getTypeName    () const;
+              std::string             _getString      () const;
+              Record*                 _getRecord      () const;
+    private:
+                                      LibCell         ( const LibCell& ) = delete;
+              LibCell&                operator=       ( const LibCell& ) = delete;
+    public:
+      Name                      _name;
+      bool                      _isSequential;
+      std::vector<LibPin*>      _pins;
+      std::map<Name,uint32_t>   _pinIndexes;
+  };
+
+
+  inline bool           LibCell::isSequential () const { return _isSequential; }
+  inline const Name&    LibCell::getName      () const { return _name; }
+  inline size_t         LibCell::getPinsCount () const { return _pins.size(); }
+  inline const LibPin*  LibCell::getPin       ( uint32_t index ) const { return _pins[index]; }
+
+
+// -------------------------------------------------------------------
+// Class  :  "Sirocco::Liberty".
+//
+// The subset of a Liberty library needed by the timing analysis:
+// units, pins directions & capacitances, delay arcs and setup checks.
+// Buses, bundles, power and noise data are skipped.
+
+  class Liberty {
+    public:
+      static  Liberty*            load                ( const std::string& path );
+                                 ~Liberty             ();
+      inline  const std::string&  getName             () const;
+      inline  const std::string&  getPath             () const;
+      inline  double              getTimeUnit         () const;
+      inline  double              getCapacitanceUnit  () const;
+      inline  size_t              getCellsCount       () const;
+              const LibCell*      getCell             ( const Name& ) const;
+              std::string         _getTypeName        () const;
+              std::string         _getString          () const;
+              Record*             _getRecord          () const;
+    public:
+                                  Liberty             ( const std::string& path );
+    private:
+                                  Liberty             ( const Liberty& ) = delete;
+              Liberty&            operator=           ( const Liberty& ) = delete;
+    public:
+      std::string               _name;
+      std::string               _path;
+      double                    _timeUnit;
+      double                    _capacitanceUnit;
+      std::map<Name,LibCell*>   _cells;
+  };
+
+
+  inline const std::string&  Liberty::getName            () const { return _name; }
+  inline const std::string&  Liberty::getPath            () const { return _path; }
+  inline double              Liberty::getTimeUnit        () const { return _timeUnit; }
+  inline double              Liberty::getCapacitanceUnit () const { return _capacitanceUnit; }
+  inline size_t              Liberty::getCellsCount      () const { return _cells.size(); }
+
+
+}  // Sirocco namespace.
+
+
+INSPECTOR_PR_SUPPORT(Sirocco::LuTable);
+INSPECTOR_P_SUPPORT(Sirocco::LibArc);
+INSPECTOR_P_SUPPORT(Sirocco::LibPin);
+INSPECTOR_P_SUPPORT(Sirocco::LibCell);
+INSPECTOR_P_SUPPORT(Sirocco::Liberty);
@@ -0,0 +1,53 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |         S i r o c c o  -  Static Timing Analysis                |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./sirocco/PySiroccoEngine.h"                   |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include "hurricane/isobar/PyHurricane.h"
+#include "crlcore/PyToolEngine.h"
+#include "sirocco/SiroccoEngine.h"
+
+
+namespace  Sirocco {
+
+extern "C" {
+
+
+// -------------------------------------------------------------------
+// Python Object  :  "PySiroccoEngine".
+
+  typedef struct {
+      CRL::PyToolEngine  _baseObject;
+  } PySiroccoEngine;
+
+
+// -------------------------------------------------------------------
+// Functions & Types exported to "PySirocco.ccp".
+
+  extern  PyTypeObject  PyTypeSiroccoEngine;
+  extern  PyMethodDef   PySiroccoEngine_Methods[];
+
+  extern  PyObject* PySiroccoEngine_Link       ( Sirocco::SiroccoEngine* );
+  extern  void      PySiroccoEngine_LinkPyType ();
+
+
+#define IsPySiroccoEngine(v)  ( (v)->ob_type == &PyTypeSiroccoEngine )
+#define PYSIROCCOENGINE(v)    ( (PySiroccoEngine*)(v) )
+#define PYSIROCCOENGINE_O(v)  ( PYSIROCCOENGINE(v)->_baseObject._object )
+
+
+}  // extern "C".
+
+}  // Sirocco namespace.
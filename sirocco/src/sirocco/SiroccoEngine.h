@@ -0,0 +1,111 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |         S i r o c c o  -  Static Timing Analysis                |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./sirocco/SiroccoEngine.h"                     |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include <iostream>
+#include "hurricane/Name.h"
+namespace Hurricane {
+  class Net;
+  class Instance;
+  class Cell;
+}
+#include "crlcore/ToolEngine.h"
+#include "sirocco/Configuration.h"
+#include "sirocco/Liberty.h"
+#include "sirocco/TimingGraph.h"
+
+
+namespace Sirocco {
+
+  using Hurricane::Record;
+  using Hurricane::Name;
+  using Hurricane::Net;
+  using Hurricane::Instance;
+  using Hurricane::Cell;
+  using CRL::ToolEngine;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Sirocco::SiroccoEngine".
+//
+// Static timing analysis of the terminal netlist of a Cell. All the
+// times are in seconds.
+//
+// Once analyzed, the netlist edits of an optimization loop are told
+// to the engine through the update*() & remove*() methods (the remove
+// ones *before* the destruction), the times are then recomputed on
+// the next query, on the modified cones only.
+
+  class SiroccoEngine : public ToolEngine {
+    public:
+      typedef  ToolEngine  Super;
+    public:
+      static  const Name&        staticGetName         ();
+      static  SiroccoEngine*     create                ( Cell* );
+      static  SiroccoEngine*     get                   ( const Cell* );
+    public:
+      inline  Configuration*     getConfiguration      () const;
+      inline  const Liberty*     getLiberty            () const;
+      inline  TimingGraph*       getTimingGraph        () const;
+      virtual const Name&        getName               () const;
+              bool               loadLiberty           ( const std::string& path );
+              void               buildGraph            ();
+              void               analyze               ();
+              void               updateInstance        ( Instance* );
+              void               removeInstance        ( Instance* );
+              void               updateNet             ( Net* );
+              void               removeNet             ( Net* );
+              void               updateTiming          ();
+              double             getWorstSlack         () const;
+              double             getTotalNegativeSlack () const;
+              size_t             getViolationsCount    () const;
+              double             getNetSlack           ( const Net* ) const;
+              double             getNetArrival         ( const Net* ) const;
+              void               report                ( size_t paths=1 ) const;
+              void               printSummary          () const;
+      inline  void               printConfiguration    () const;
+      virtual Record*            _getRecord            () const;
+      virtual std::string        _getString            () const;
+      virtual std::string        _getTypeName          () const;
+    private:
+    // Attributes.
+      static  Name               _toolName;
+    private:
+              Configuration*     _configuration;
+              Liberty*           _liberty;
+              TimingGraph*       _timingGraph;
+    protected:
+    // Constructors & Destructors.
+                                 SiroccoEngine         ( Cell* );
+      virtual                   ~SiroccoEngine         ();
+      virtual void               _postCreate           ();
+      virtual void               _preDestroy           ();
+    private:
+                                 SiroccoEngine         ( const SiroccoEngine& ) = delete;
+              SiroccoEngine&     operator=             ( const SiroccoEngine& ) = delete;
+  };
+
+
+  inline Configuration* SiroccoEngine::getConfiguration   () const { return _configuration; }
+  inline const Liberty* SiroccoEngine::getLiberty         () const { return _liberty; }
+  inline TimingGraph*   SiroccoEngine::getTimingGraph     () const { return _timingGraph; }
+  inline void           SiroccoEngine::printConfiguration () const { _configuration->print( getCell() ); }
+
+
+}  // Sirocco namespace.
+
+
+INSPECTOR_P_SUPPORT(Sirocco::SiroccoEngine);
@@ -0,0 +1,274 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |         S i r o c c o  -  Static Timing Analysis                |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./sirocco/TimingGraph.h"                       |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include <limits>
+#include <vector>
+#include <unordered_map>
+#include "hurricane/Commons.h"
+namespace Hurricane {
+  class Net;
+  class Cell;
+  class Instance;
+  class SharedPath;
+  class RoutingPad;
+  class ThreadPool;
+}
+#include "sirocco/Liberty.h"
+
+
+namespace Sirocco {
+
+  using Hurricane::Record;
+  using Hurricane::Net;
+  using Hurricane::Cell;
+  using Hurricane::Instance;
+  using Hurricane::SharedPath;
+  using Hurricane::RoutingPad;
+  using Hurricane::ThreadPool;
+  class Configuration;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Sirocco::TimingGraph".
+//
+// Timing graph of the terminal netlist of a Cell, built from the
+// RoutingPads of the flattened nets. The nodes are the pins of the
+// terminal instances (all the pins of the matching Liberty cell) and
+// one pin per external net. The arcs are not stored: the fanins and
+// fanouts of a node are deduced from it's net (driver & sinks) and
+// from the arcs of it's Liberty pin. The node data are kept in flat
+// arrays (one entry per node, or two, rise & fall) to stay compact on
+// million instances designs.
+//
+// The clock is ideal: clock nets are not flattened and the sequential
+// arcs start at the clock edge (time zero, whatever the edge). Nodes
+// are levelized once, then propagated level by level, the nodes of a
+// level being independent.
+//
+// Incremental mode. After an edit of the netlist (master change, new
+// or removed instance, new connexions or new wiring of a net), the
+// update*() & remove*() methods patch the graph in place: the nodes
+// whose fanins or delays have changed are marked dirty (arrival and
+// required) and update() recomputes only the dirty cones, in level
+// order, stopping where the times are unchanged. As each node is
+// recomputed with the very same functions than the full propagate(),
+// the results are identical. Replaced nodes are not reused, they are
+// flagged Dead and left out of the graph.
+
+  class TimingGraph {
+    public:
+      static constexpr uint32_t  NoIndex = (uint32_t)-1;
+      enum Flags { PrimaryInput  = (1 << 0)
+                 , PrimaryOutput = (1 << 1)
+                 , EndPoint      = (1 << 2)
+                 , InLoop        = (1 << 3)
+                 , Dead          = (1 << 4)
+                 , DirtyArrival  = (1 << 5)
+                 , DirtyRequired = (1 << 6)
+                 };
+      enum Edge  { Rise = 0
+                 , Fall = 1
+                 };
+      class InstanceData {
+        public:
+          inline  InstanceData ( Instance*, SharedPath*, const LibCell*, uint32_t firstNode );
+        public:
+          Instance*       _instance;
+          SharedPath*     _path;
+          const LibCell*  _libCell;
+          uint32_t        _firstNode;
+      };
+      class NetData {
+        public:
+          inline  NetData ( Net* );
+        public:
+          Net*                   _net;
+          uint32_t               _driver;
+          uint32_t               _io;
+          std::vector<uint32_t>  _sinks;
+          double                 _wireCapacitance;
+          double                 _load;
+      };
+      class PathKey {
+        public:
+          inline        PathKey    ( SharedPath*, Instance* );
+          inline  bool  operator== ( const PathKey& ) const;
+        public:
+          SharedPath*  _path;
+          Instance*    _instance;
+      };
+      class PathKeyHash {
+        public:
+          inline  size_t  operator() ( const PathKey& ) const;
+      };
+      typedef  std::unordered_map<PathKey,uint32_t,PathKeyHash>  InstanceMap;
+      typedef  std::unordered_map<const Net*,uint32_t>           NetMap;
+      typedef  std::unordered_multimap<const Instance*,uint32_t> OccurrenceMap;
+    public:
+                                  TimingGraph           ( Cell*, const Configuration* );
+                                 ~TimingGraph           ();
+      inline  Cell*               getCell               () const;
+      inline  size_t              getNodesCount         () const;
+      inline  size_t              getInstancesCount     () const;
+      inline  size_t              getNetsCount          () const;
+      inline  size_t              getLevelsCount        () const;
+      inline  size_t              getLoopsCount         () const;
+      inline  size_t              getUnknownsCount      () const;
+      inline  const std::vector<uint32_t>&
+                                  getEndPoints          () const;
+      inline  uint32_t            getFlags              ( uint32_t node ) const;
+      inline  bool                isDirty               () const;
+      inline  double              getArrival            ( uint32_t node, Edge ) const;
+      inline  double              getSlew               ( uint32_t node, Edge ) const;
+      inline  double              getRequired           ( uint32_t node, Edge ) const;
+              double              getSlack              ( uint32_t node ) const;
+              double              getSlack              ( uint32_t node, Edge ) const;
+              uint32_t            getNetIndex           ( const Net* ) const;
+              uint32_t            getNetNode            ( uint32_t net ) const;
+              std::string         getNodeName           ( uint32_t node ) const;
+              void                getCriticalPath       ( uint32_t node, Edge, std::vector< std::pair<uint32_t,Edge> >& ) const;
+              void                build                 ( const Liberty* );
+              void                propagate             ();
+              void                update                ();
+              void                updateInstance        ( Instance*, const Liberty* );
+              void                removeInstance        ( Instance* );
+              void                updateNet             ( Net* );
+              void                removeNet             ( Net* );
+              std::string         _getTypeName          () const;
+              std::string         _getString            () const;
+              Record*             _getRecord            () const;
+    private:
+              uint32_t            _getNode              ( RoutingPad* ) const;
+              uint32_t            _getFirstNode         ( uint32_t node ) const;
+              bool                _isSink               ( uint32_t node ) const;
+              uint32_t            _addNode              ( uint32_t instance, const LibPin* );
+              uint32_t            _addInstance          ( Instance*, SharedPath*, const LibCell* );
+              void                _retireNodes          ( uint32_t instance, std::vector<uint32_t>& nets );
+              size_t              _connectNet           ( uint32_t net, bool steal );
+              void                _reconnectNet         ( uint32_t net, bool steal );
+              void                _updateNet            ( uint32_t net );
+              void                _updateEndPoint       ( uint32_t node );
+              void                _markArrival          ( uint32_t node );
+              void                _markRequired         ( uint32_t node );
+              void                _touch                ( uint32_t node );
+              void                _touchNet             ( uint32_t net );
+              void                _clearDirty           ();
+              void                _compactEndPoints     ();
+              void                _levelize             ();
+              void                _updateLevels         ();
+              void                _buildLevelBuckets    ();
+              void                _computeArrival       ( uint32_t node );
+              void                _computeRequired      ( uint32_t node );
+              void                _runLevels            ( bool forward );
+      template< typename F >
+              void                _forEachFanin         ( uint32_t node, F ) const;
+      template< typename F >
+              void                _forEachFanout        ( uint32_t node, F ) const;
+      template< typename F >
+              void                _forEachTimedFanin    ( uint32_t node, F ) const;
+      template< typename F >
+              void                _forEachTimedFanout   ( uint32_t node, F ) const;
+    private:
+                                  TimingGraph           ( const TimingGraph& ) = delete;
+              TimingGraph&        operator=             ( const TimingGraph& ) = delete;
+    private:
+      Cell*                         _cell;
+      const Configuration*          _configuration;
+      ThreadPool*                   _pool;
+      std::vector<InstanceData>     _instances;
+      InstanceMap                   _instanceMap;
+      OccurrenceMap                 _occurrences;
+      std::vector<NetData>          _nets;
+      NetMap                        _netMap;
+      std::vector<uint32_t>         _nodeInstances;
+      std::vector<const LibPin*>    _nodePins;
+      std::vector<uint32_t>         _nodeNets;
+      std::vector<uint32_t>         _nodeFlags;
+      std::vector<uint32_t>         _nodeLevels;
+      std::vector<double>           _wireDelays;
+      std::vector<double>           _arrivals;
+      std::vector<double>           _slews;
+      std::vector<double>           _requireds;
+      std::vector<uint32_t>         _levelStarts;
+      std::vector<uint32_t>         _levelNodes;
+      std::vector<uint32_t>         _endPoints;
+      std::vector<uint32_t>         _dirtyArrivals;
+      std::vector<uint32_t>         _dirtyRequireds;
+      std::vector<uint32_t>         _dirtyLevels;
+      size_t                        _staleEndPoints;
+      size_t                        _loopsCount;
+      size_t                        _unknownsCount;
+      bool                          _levelBucketsValid;
+      bool                          _fullUpdate;
+  };
+
+
+  inline TimingGraph::InstanceData::InstanceData ( Instance*      instance
+                                                 , SharedPath*    path
+                                                 , const LibCell* libCell
+                                                 , uint32_t       firstNode )
+    : _instance (instance)
+    , _path     (path)
+    , _libCell  (libCell)
+    , _firstNode(firstNode)
+  { }
+
+
+  inline TimingGraph::NetData::NetData ( Net* net )
+    : _net            (net)
+    , _driver         (NoIndex)
+    , _io             (NoIndex)
+    , _sinks          ()
+    , _wireCapacitance(0.0)
+    , _load           (0.0)
+  { }
+
+
+  inline TimingGraph::PathKey::PathKey ( SharedPath* path, Instance* instance )
+    : _path(path), _instance(instance)
+  { }
+
+
+  inline bool  TimingGraph::PathKey::operator== ( const PathKey& other ) const
+  { return (_path == other._path) and (_instance == other._instance); }
+
+
+  inline size_t  TimingGraph::PathKeyHash::operator() ( const PathKey& key ) const
+  { return std::hash<void*>()( key._path ) * 31 + std::hash<void*>()( key._instance ); }
+
+
+  inline Cell*     TimingGraph::getCell           () const { return _cell; }
+  inline size_t    TimingGraph::getNodesCount     () const { return _nodePins.size(); }
+  inline size_t    TimingGraph::getInstancesCount () const { return _instances.size(); }
+  inline size_t    TimingGraph::getNetsCount      () const { return _nets.size(); }
+  inline size_t    TimingGraph::getLevelsCount    () const { return (_levelStarts.empty()) ? 0 : _levelStarts.size()-1; }
+  inline size_t    TimingGraph::getLoopsCount     () const { return _loopsCount; }
+  inline size_t    TimingGraph::getUnknownsCount  () const { return _unknownsCount; }
+  inline const std::vector<uint32_t>&
+                   TimingGraph::getEndPoints      () const { return _endPoints; }
+  inline uint32_t  TimingGraph::getFlags          ( uint32_t node ) const { return _nodeFlags[node]; }
+  inline bool      TimingGraph::isDirty           () const
+  { return _fullUpdate or not _dirtyArrivals.empty() or not _dirtyRequireds.empty() or not _dirtyLevels.empty(); }
+  inline double    TimingGraph::getArrival        ( uint32_t node, Edge edge ) const { return _arrivals [2*node+edge]; }
+  inline double    TimingGraph::getSlew           ( uint32_t node, Edge edge ) const { return _slews    [2*node+edge]; }
+  inline double    TimingGraph::getRequired       ( uint32_t node, Edge edge ) const { return _requireds[2*node+edge]; }
+
+
+}  // Sirocco namespace.
+
+
+INSPECTOR_P_SUPPORT(Sirocco::TimingGraph);
@@ -0,0 +1,239 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |       T r a m o n t a n a  -  Extractor & LVX                   |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./DirtyTracker.cpp"                            |
+// +-----------------------------------------------------------------+
+
+
+#include <sstream>
+#include "hurricane/Net.h"
+#include "hurricane/Plug.h"
+#include "hurricane/Cell.h"
+#include "hurricane/Instance.h"
+#include "hurricane/Query.h"
+#include "tramontana/DirtyTracker.h"
+#include "tramontana/TramontanaEngine.h"
+
+
+namespace {
+
+  using Hurricane::Go;
+  using Hurricane::Rubber;
+  using Hurricane::Query;
+  using Hurricane::BasicLayer;
+  using Hurricane::Component;
+  using Hurricane::Occurrence;
+  using Tramontana::Equipotential;
+  using Tramontana::EquipotentialSet;
+
+
+// -------------------------------------------------------------------
+// Class  :  "QueryEquis".
+//
+// Collect the top level Equipotentials of all the extracted components
+// under an area, whatever their depth.
+
+  class QueryEquis : public Query {
+    public:
+                        QueryEquis          ( EquipotentialSet& );
+      virtual bool      hasGoCallback       () const;
+      virtual void      goCallback          ( Go*     );
+      virtual void      rubberCallback      ( Rubber* );
+      virtual void      extensionGoCallback ( Go*     );
+      virtual void      masterCellCallback  ();
+    private:
+      EquipotentialSet&  _equis;
+  };
+
+
+  QueryEquis::QueryEquis ( EquipotentialSet& equis )
+    : Query ()
+    , _equis(equis)
+  {
+    setFilter( Query::DoComponents|Query::DoTerminalCells );
+  }
+
+
+  void  QueryEquis::masterCellCallback  () { }
+  void  QueryEquis::rubberCallback      ( Rubber* ) { }
+  void  QueryEquis::extensionGoCallback ( Go* ) { }
+  bool  QueryEquis::hasGoCallback       () const { return true; }
+
+
+  void  QueryEquis::goCallback ( Go* go )
+  {
+    Component* component = dynamic_cast<Component*>( go );
+    if (not component) return;
+    if (component->getNet()->isBlockage()) return;
+
+    Equipotential* equi = nullptr;
+    if (getPath().isEmpty())
+      equi = Equipotential::get( component );
+    else
+      equi = Equipotential::get( Equipotential::getChildEqui( Occurrence(go,getPath()) ));
+    if (equi) _equis.insert( equi );
+  }
+
+
+}  // Anonymous namespace.
+
+
+namespace Tramontana {
+
+  using std::string;
+  using std::vector;
+  using std::make_pair;
+  using std::ostringstream;
+  using Hurricane::Plug;
+  using Hurricane::Instance;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Tramontana::DirtyTracker".
+
+
+  DirtyTracker::DirtyTracker ( TramontanaEngine* tramontana )
+    : _tramontana(tramontana)
+    , _components()
+    , _instances ()
+    , _areas     ()
+  { }
+
+
+  bool  DirtyTracker::isTracked ( const Component* component ) const
+  {
+    if (dynamic_cast<const Plug*>(component)) return false;
+    if (component->getNet()->isBlockage()) return false;
+    return component->getLayer()->getMask().intersect( _tramontana->getExtractedMask() );
+  }
+
+
+  void  DirtyTracker::capture ()
+  {
+    Cell* cell = _tramontana->getCell();
+
+    _components.clear();
+    _instances .clear();
+    _areas     .clear();
+    for ( Component* component : cell->getComponents() ) {
+      if (not isTracked(component)) continue;
+      _components.insert( make_pair( component->getId()
+                                   , ComponentState( component->getBoundingBox()
+                                                   , component->getLayer()
+                                                   , component->getNet()
+                                                   , Equipotential::get(component) )));
+    }
+    for ( Instance* instance : cell->getInstances() ) {
+      _instances.insert( make_pair( instance->getId()
+                                  , InstanceState( instance->getMasterCell()
+                                                 , instance->getTransformation() )));
+    }
+  }
+
+
+// Build the list of the dirty areas, the set of the Equipotentials that
+// must be rebuilt and the area enclosing all of them. Two components can
+// only be connected after an edit if one of them lies in a dirty area,
+// so the Equipotentials under the dirty areas, and the ones of the
+// removed or modified components, are closed: they cannot connect to
+// any other. Returns false if an instance has changed, in which case a
+// full re-extraction is required.
+  bool  DirtyTracker::collect ( Box& area, EquipotentialSet& replaceds )
+  {
+    Cell* cell = _tramontana->getCell();
+
+    size_t instancesCount = 0;
+    for ( Instance* instance : cell->getInstances() ) {
+      ++instancesCount;
+      auto istate = _instances.find( instance->getId() );
+      if (  (istate == _instances.end())
+         or (istate->second._masterCell     != instance->getMasterCell())
+         or (istate->second._transformation != instance->getTransformation()))
+        return false;
+    }
+    if (instancesCount != _instances.size()) return false;
+
+    for ( auto& istate : _components ) istate.second._found = false;
+    for ( Component* component : cell->getComponents() ) {
+      if (not isTracked(component)) continue;
+
+      Box  bb     = component->getBoundingBox();
+      auto istate = _components.find( component->getId() );
+      if (istate == _components.end()) {
+        _areas.push_back( bb );
+        continue;
+      }
+      ComponentState& state = istate->second;
+      state._found = true;
+      if (  (state._boundingBox == bb)
+         and (state._layer == component->getLayer())
+         and (state._net   == component->getNet())) continue;
+
+      _areas.push_back( state._boundingBox );
+      _areas.push_back( bb );
+      if (state._equipotential) replaceds.insert( state._equipotential );
+    }
+    for ( auto& istate : _components ) {
+      if (istate.second._found) continue;
+      _areas.push_back( istate.second._boundingBox );
+      if (istate.second._equipotential) replaceds.insert( istate.second._equipotential );
+    }
+
+    area = Box();
+    if (_areas.empty()) return true;
+
+    QueryEquis query ( replaceds );
+    query.setCell( cell );
+    for ( const Box& dirty : _areas ) {
+      area.merge( dirty );
+      query.setArea( dirty );
+      for ( const BasicLayer* layer : _tramontana->getExtracteds() ) {
+        query.setBasicLayer( layer );
+        query.doQuery();
+      }
+    }
+
+    for ( Equipotential* equi : replaceds ) area.merge( equi->getBoundingBox() );
+    for ( auto& istate : _components ) {
+      Equipotential* equi = istate.second._equipotential;
+      if (equi and (replaceds.find(equi) != replaceds.end()))
+        area.merge( istate.second._boundingBox );
+    }
+    return true;
+  }
+
+
+  string  DirtyTracker::_getTypeName () const
+  { return "Tramontana::DirtyTracker"; }
+
+
+  string  DirtyTracker::_getString () const
+  {
+    ostringstream  os;
+    os << "<DirtyTracker components:" << _components.size()
+       << " instances:" << _instances.size()
+       << " areas:" << _areas.size() << ">";
+    return os.str();
+  }
+
+
+  Record* DirtyTracker::_getRecord () const
+  {
+    Record* record = new Record ( _getString() );
+    if (record) {
+      record->add( getSlot( "_tramontana", _tramontana ) );
+    }
+    return record;
+  }
+
+
+}  // Tramontana namespace.
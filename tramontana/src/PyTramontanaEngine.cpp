@@ -18,6 +18,7 @@
 
 #include "hurricane/isobar/PyNet.h"
 #include "hurricane/isobar/PyCell.h"
+#include "hurricane/isobar/PyBox.h"
 #include "hurricane/viewer/PyCellViewer.h"
 #include "hurricane/viewer/ExceptionWidget.h"
 #include "hurricane/Cell.h"
@@ -158,7 +159,24 @@ extern "C" {
   }
 
 
+  static PyObject* PyTramontanaEngine_addDirtyArea ( PyTramontanaEngine* self, PyObject* args )
+  {
+    cdebug_log(40,0) << "PyTramontanaEngine_addDirtyArea()" << endl;
+    HTRY
+      METHOD_HEAD( "TramontanaEngine.addDirtyArea()" )
+      PyObject* pyBox = NULL;
+      if (not PyArg_ParseTuple(args,"O:TramontanaEngine.addDirtyArea()",&pyBox) or not IsPyBox(pyBox)) {
+        PyErr_SetString( ConstructorError, "TramontanaEngine.addDirtyArea(): Argument must be a Box." );
+        return NULL;
+      }
+      tramontana->addDirtyArea( *PYBOX_O(pyBox) );
+    HCATCH
+    Py_RETURN_NONE;
+  }
+
+
   // Standart Accessors (Attributes).
+  DirectVoidToolMethod(TramontanaEngine,tramontana,reextract)
   DirectVoidToolMethod(TramontanaEngine,tramontana,printConfiguration)
   DirectVoidToolMethod(TramontanaEngine,tramontana,printSummary)
   DirectGetBoolAttribute(PyTramontanaEngine_getSuccessState,getSuccessState,PyTramontanaEngine,TramontanaEngine)
@@ -178,6 +196,10 @@ extern "C" {
                                    , "Associate a Viewer to this TramontanaEngine." }
     , { "extract"                  , (PyCFunction)PyTramontanaEngine_extract                 , METH_NOARGS
                                    , "Perform the layout extraction." }
+    , { "reextract"                , (PyCFunction)PyTramontanaEngine_reextract               , METH_NOARGS
+                                   , "Update the extraction after local edits of the top level layout." }
+    , { "addDirtyArea"             , (PyCFunction)PyTramontanaEngine_addDirtyArea            , METH_VARARGS
+                                   , "Force the re-extraction of an area at the next reextract()." }
     , { "printConfiguration"       , (PyCFunction)PyTramontanaEngine_printConfiguration      , METH_NOARGS
                                    , "Display the extraction parameters." }
     , { "printSummary"             , (PyCFunction)PyTramontanaEngine_printSummary            , METH_NOARGS
@@ -35,6 +35,9 @@ namespace Tramontana {
     : _occurrenceA(occA)
     , _occurrenceB(occB)
     , _overlap    (nullptr)
+    , _cell       (occA.getOwnerCell())
+    , _shortingA  (nullptr)
+    , _shortingB  (nullptr)
   {
     if (       occB.getPath().isEmpty()
        and not occA.getPath().isEmpty()) {
@@ -42,13 +45,13 @@ namespace Tramontana {
       _occurrenceB = occA;
     }
 
-    Cell* cell = occA.getOwnerCell();
-    if (_shortsByCells.find(cell) == _shortsByCells.end())
-      _shortsByCells.insert( make_pair( cell, ShortingEquis() ) );
-    ShortingEquis& shortingEquis = _shortsByCells.find( cell )->second;
+    if (_shortsByCells.find(_cell) == _shortsByCells.end())
+      _shortsByCells.insert( make_pair( _cell, ShortingEquis() ) );
+    ShortingEquis& shortingEquis = _shortsByCells.find( _cell )->second;
     
     if (not isTopLevelA()) {
       Equipotential* equi = dynamic_cast<Equipotential*>( getEquiA().getEntity() );
+      _shortingA = equi;
       auto iequi = shortingEquis.find( equi );
       if (iequi == shortingEquis.end())
         shortingEquis[ equi ] = 1;
@@ -58,6 +61,7 @@ namespace Tramontana {
 
     if (not isTopLevelB()) {
       Equipotential* equi = dynamic_cast<Equipotential*>( getEquiB().getEntity() );
+      _shortingB = equi;
       auto iequi = shortingEquis.find( equi );
       if (iequi == shortingEquis.end())
         shortingEquis[ equi ] = 1;
@@ -76,6 +80,23 @@ namespace Tramontana {
   }
 
 
+// The occurrences may refer to components already destroyed (a short
+// removed by a layout edit), so only the recorded equis are used here.
+  ShortCircuit::~ShortCircuit ()
+  {
+    _overlap->destroy();
+
+    auto ishorts = _shortsByCells.find( _cell );
+    if (ishorts == _shortsByCells.end()) return;
+    for ( Equipotential* equi : { _shortingA, _shortingB } ) {
+      if (not equi) continue;
+      auto iequi = ishorts->second.find( equi );
+      if (iequi == ishorts->second.end()) continue;
+      if (--(iequi->second) == 0) ishorts->second.erase( iequi );
+    }
+  }
+
+
   string  ShortCircuit::_getString () const
   {
     string s = "<Short " + getString(_occurrenceA) + "+" + getString(_occurrenceB) + ">";
@@ -39,8 +39,14 @@
 #include "hurricane/RoutingPad.h"
 #include "crlcore/Utilities.h"
 #include "crlcore/ToolBox.h"
+#include "hurricane/ThreadPool.h"
+#include "hurricane/ParallelQuery.h"
 #include "tramontana/SweepLine.h"
+#include "tramontana/SweepWindow.h"
+#include "tramontana/UnionFind.h"
 #include "tramontana/QueryTiles.h"
+#include "tramontana/Equipotential.h"
+#include "tramontana/ShortCircuit.h"
 
 
 namespace Tramontana {
@@ -80,6 +86,7 @@ namespace Tramontana {
   using Hurricane::RoutingPad;
   using Hurricane::Cell;
   using Hurricane::Instance;
+  using Hurricane::ThreadPool;
 
 
 // -------------------------------------------------------------------
@@ -94,6 +101,14 @@ namespace Tramontana {
     , _lastLeftEdge (nullptr)
     , _splitCount   (0)
     , _flags        (0)
+    , _windowsBox   ()
+    , _windowWidth  (0)
+    , _threads      (tramontana->getThreads())
+    , _tilesCount   (0)
+    , _windows      ()
+    , _unionFind    (nullptr)
+    , _area         ()
+    , _replaceds    (nullptr)
   {
     for ( const BasicLayer* layer : getExtracteds() ) {
       _intervalTrees.insert( make_pair( layer->getMask(), TileIntvTree() ));
@@ -104,11 +119,20 @@ namespace Tramontana {
 
 
   SweepLine::~SweepLine ()
-  { }
+  { _clearWindows(); }
   
 
   void  SweepLine::run ( bool isTopLevel )
   {
+    if ((_threads > 1) and (_splitCount > 0)) {
+      _windowsBox  = getCell()->getBoundingBox();
+      _windowWidth = _windowsBox.getWidth() / (_splitCount + 1);
+      if (_windowWidth > 0) {
+        _runParallel( isTopLevel );
+        return;
+      }
+    }
+
     UpdateSession::open();
     // if (getCell()->getName() == "arlet6502_cts_r")
     //   DebugSession::open( 160, 169 );
@@ -197,6 +221,159 @@ namespace Tramontana {
   }
 
 
+// Parallel extraction. Same result as the serial sweep, in four steps:
+// 1. [parallel] Each window loads & sweeps it's own tiles (SweepWindow).
+// 2. [serial]   Global numbering of the owned tiles, window by window.
+// 3. [parallel] Each window reports it's local connexity, ghosts being
+//               replaced by their owner tile, in a global union-find.
+// 4. [serial]   One Equipotential per connected set, built in the tiles
+//               global order. The root of a set is it's first tile.
+//
+// The steps are also run separately by TramontanaEngine, to process
+// the windows of several independent masters in the same ThreadPool.
+  void  SweepLine::_runParallel ( bool isTopLevel )
+  {
+    cdebug_log(160,1) << "SweepLine::_runParallel()" << endl;
+    UpdateSession::open();
+
+    openWindows();
+    try {
+      ThreadPool pool ( _threads );
+      Hurricane::ParallelQuery::freeze( getCell() );
+      {
+        Hurricane::ParallelQuery::ReadOnlyScope readOnly;
+        pool.run( _windows.size(), [&]( size_t iwindow, size_t ) { sweepWindow( iwindow ); } );
+      }
+      stitchWindows();
+      pool.run( _windows.size(), [&]( size_t iwindow, size_t ) { linkWindow( iwindow ); } );
+      if (_replaceds) {
+        for ( Equipotential* equi : *_replaceds ) equi->destroy();
+      }
+      buildEquipotentials();
+    } catch ( ... ) {
+      _clearWindows();
+      UpdateSession::close();
+      cdebug_tabw(160,-1);
+      throw;
+    }
+
+    if (isTopLevel) printSummary();
+    UpdateSession::close();
+    cdebug_tabw(160,-1);
+  }
+
+
+// Re-extraction of an area only, after a layout edit. The Equipotentials
+// in replaceds are destroyed and rebuilt from their components and the
+// new ones, found in area. The caller must ensure that the area contains
+// all their tiles and that no other Equipotential may connect to them.
+  void  SweepLine::runArea ( const Box& area, const EquipotentialSet& replaceds )
+  {
+    Box cellBox = getCell()->getBoundingBox();
+    _area      = area.getIntersection( cellBox );
+    _replaceds = &replaceds;
+    if (cellBox.getWidth() > 0)
+      _splitCount = (uint32_t)( ((double)_splitCount * _area.getWidth()) / cellBox.getWidth() );
+
+    _runParallel( false );
+
+    _area      = Box();
+    _replaceds = nullptr;
+  }
+
+
+  void  SweepLine::openWindows ()
+  {
+    _clearWindows();
+
+    _windowsBox = (_area.isEmpty()) ? getCell()->getBoundingBox() : _area;
+    if (_windowsBox.isEmpty()) return;
+
+    _windowWidth = _windowsBox.getWidth() / (_splitCount + 1);
+    if (_windowWidth <= 0) {
+      _splitCount  = 0;
+      _windowWidth = std::max( _windowsBox.getWidth(), (DbU::Unit)1 );
+    }
+
+    for ( uint32_t i=0 ; i<=_splitCount ; ++i ) {
+      uint32_t  flags = 0;
+      DbU::Unit xmin  = _windowsBox.getXMin() + i*_windowWidth;
+      DbU::Unit xmax  = xmin + _windowWidth;
+      if (i == 0          ) flags |= SweepWindow::IsLeftMost;
+      if (i == _splitCount) { flags |= SweepWindow::IsRightMost; xmax = _windowsBox.getXMax(); }
+      _windows.push_back( new SweepWindow( this
+                                         , i
+                                         , Box( xmin, _windowsBox.getYMin(), xmax, _windowsBox.getYMax() )
+                                         , flags ));
+    }
+  }
+
+
+// Must be run under a ParallelQuery::ReadOnlyScope, on a frozen Cell.
+  void  SweepLine::sweepWindow ( size_t iwindow )
+  {
+    _windows[iwindow]->load ();
+    _windows[iwindow]->sweep();
+  }
+
+
+  void  SweepLine::stitchWindows ()
+  {
+    uint32_t offset = 0;
+    for ( SweepWindow* window : _windows ) offset = window->setGlobalOffset( offset );
+    _tilesCount = offset;
+
+    if (_unionFind) delete _unionFind;
+    _unionFind = new UnionFind ( _tilesCount );
+  }
+
+
+  void  SweepLine::linkWindow ( size_t iwindow )
+  {
+    _windows[iwindow]->link( _windows, *_unionFind );
+  }
+
+
+  void  SweepLine::buildEquipotentials ()
+  {
+    std::unordered_map< uint32_t, std::pair<Equipotential*,Occurrence> >  equis;
+    for ( SweepWindow* window : _windows ) {
+      for ( uint32_t i=0 ; i<window->getTilesCount() ; ++i ) {
+        const SweepWindow::WindowTile& tile = window->getTile( i );
+        if (not tile.isOwned()) continue;
+        if (not tile._occurrence.isValid()) continue;
+
+        uint32_t root  = _unionFind->find( window->getGlobal(i) );
+        auto     iequi = equis.find( root );
+        if (iequi == equis.end()) {
+          Equipotential* equi = Equipotential::create( tile._occurrence.getOwnerCell() );
+          equi->add( tile._occurrence, tile._boundingBox );
+          equis.insert( make_pair( root, make_pair(equi,tile._deepOccurrence) ));
+          continue;
+        }
+        if (iequi->second.first->add( tile._occurrence, tile._boundingBox )) {
+          uint32_t partner = window->getLink( i );
+          if (partner == i) partner = window->getRoot( i );
+          Occurrence partnerOcc = (partner != i) ? window->getTile(partner)._deepOccurrence
+                                                 : iequi->second.second;
+          iequi->second.first->add( new ShortCircuit( partnerOcc, tile._deepOccurrence ) );
+        }
+      }
+      window->clear();
+    }
+    _clearWindows();
+  }
+
+
+  void  SweepLine::_clearWindows ()
+  {
+    for ( SweepWindow* window : _windows ) delete window;
+    _windows.clear();
+    if (_unionFind) delete _unionFind;
+    _unionFind = nullptr;
+  }
+
+
   bool  SweepLine::loadNextWindow ()
   {
     cdebug_log(160,1) << "SweepLine::loadNextWindow()" << endl;
@@ -257,6 +434,11 @@ namespace Tramontana {
   void  SweepLine::printSummary () const
   {
     cmess2 << Dots::asUInt("        - Windows"    , _splitCount+1          ) << endl;
+    if (_tilesCount) {
+      cmess2 << Dots::asUInt("        - Threads"    , _threads   ) << endl;
+      cmess2 << Dots::asUInt("        - Total tiles", _tilesCount) << endl;
+      return;
+    }
     cmess2 << Dots::asUInt("        - Peak tiles" , Tile::peakTilesCount ()) << endl;
     cmess2 << Dots::asUInt("        - Total tiles", Tile::totalTilesCount()) << endl;
   }
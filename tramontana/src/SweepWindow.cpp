@@ -0,0 +1,424 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |       T r a m o n t a n a  -  Extractor & LVX                   |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./SweepWindow.cpp"                             |
+// +-----------------------------------------------------------------+
+
+
+#include <algorithm>
+#include <functional>
+#include "hurricane/Error.h"
+#include "hurricane/Bug.h"
+#include "hurricane/Net.h"
+#include "hurricane/Cell.h"
+#include "hurricane/Query.h"
+#include "hurricane/Diagonal.h"
+#include "hurricane/Rectilinear.h"
+#include "hurricane/Polygon.h"
+#include "tramontana/SweepWindow.h"
+#include "tramontana/SweepLine.h"
+#include "tramontana/Equipotential.h"
+#include "tramontana/UnionFind.h"
+
+
+namespace {
+
+  using std::string;
+  using Hurricane::Go;
+  using Hurricane::Rubber;
+  using Hurricane::Query;
+  using Hurricane::Layer;
+  using Hurricane::BasicLayer;
+  using Hurricane::Component;
+  using Hurricane::Occurrence;
+  using Tramontana::SweepWindow;
+
+
+// -------------------------------------------------------------------
+// Class  :  "QueryWindow".
+//
+// Same component selection as QueryTiles, but feeding a SweepWindow.
+
+  class QueryWindow : public Query {
+    public:
+                        QueryWindow         ( SweepWindow* );
+      virtual void      setBasicLayer       ( const BasicLayer* );
+      virtual bool      hasGoCallback       () const;
+      virtual void      goCallback          ( Go*     );
+      virtual void      rubberCallback      ( Rubber* );
+      virtual void      extensionGoCallback ( Go*     );
+      virtual void      masterCellCallback  ();
+    private:
+      SweepWindow* _window;
+      Layer::Mask  _processedLayers;
+  };
+
+
+  QueryWindow::QueryWindow ( SweepWindow* window )
+    : Query           ()
+    , _window         (window)
+    , _processedLayers(0)
+  {
+    setFilter( Query::DoComponents|Query::DoTerminalCells );
+  }
+
+
+  void  QueryWindow::setBasicLayer ( const BasicLayer* basicLayer )
+  {
+    _processedLayers |= basicLayer->getMask();
+    Query::setBasicLayer ( basicLayer );
+  }
+
+
+  void  QueryWindow::masterCellCallback  () { }
+  void  QueryWindow::rubberCallback      ( Rubber* ) { }
+  void  QueryWindow::extensionGoCallback ( Go* ) { }
+  bool  QueryWindow::hasGoCallback       () const { return true; }
+
+
+  void  QueryWindow::goCallback ( Go* go )
+  {
+    Component* component = dynamic_cast<Component*>( go );
+    if (not component) return;
+    if (component->getNet()->isBlockage()) return;
+
+    Layer::Mask fullyProcesseds = _processedLayers & ~getBasicLayer()->getMask();
+    if (component->getLayer()->getMask().intersect(fullyProcesseds)) return;
+
+    _window->addComponent( component, Occurrence(go,getPath()), getTransformation() );
+  }
+
+
+}  // Anonymous namespace.
+
+
+namespace Tramontana {
+
+  using std::cerr;
+  using std::endl;
+  using std::string;
+  using std::vector;
+  using std::ostringstream;
+  using Hurricane::Error;
+  using Hurricane::Bug;
+  using Hurricane::Diagonal;
+  using Hurricane::Rectilinear;
+  using Hurricane::Polygon;
+  using Hurricane::Interval;
+  using Hurricane::IntervalData;
+  using Hurricane::IntervalTree;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Tramontana::SweepWindow::TileKeyHash".
+
+
+  size_t  SweepWindow::TileKeyHash::operator() ( const TileKey& key ) const
+  {
+    size_t h = std::hash<const void*>()( key._entity );
+    h ^= std::hash<const void*>()( key._sharedPath         ) + 0x9e3779b9 + (h<<6) + (h>>2);
+    h ^= std::hash<const void*>()( key._layer              ) + 0x9e3779b9 + (h<<6) + (h>>2);
+    h ^= std::hash<int64_t    >()( key._boundingBox.getXMin() ) + 0x9e3779b9 + (h<<6) + (h>>2);
+    h ^= std::hash<int64_t    >()( key._boundingBox.getYMin() ) + 0x9e3779b9 + (h<<6) + (h>>2);
+    return h;
+  }
+
+
+// -------------------------------------------------------------------
+// Class  :  "Tramontana::SweepWindow".
+
+
+  SweepWindow::SweepWindow ( SweepLine* sweepLine, uint32_t index, const Box& area, uint32_t flags )
+    : _sweepLine (sweepLine)
+    , _index     (index)
+    , _area      (area)
+    , _flags     (flags)
+    , _ownedCount(0)
+    , _tiles     ()
+    , _parents   ()
+    , _links     ()
+    , _globals   ()
+    , _exports   ()
+  { }
+
+
+  void  SweepWindow::load ()
+  {
+    QueryWindow query ( this );
+    query.setCell( _sweepLine->getCell() );
+    query.setArea( _area );
+    for ( const BasicLayer* layer : _sweepLine->getExtracteds() ) {
+      query.setBasicLayer( layer );
+      query.doQuery();
+    }
+  }
+
+
+  void  SweepWindow::addComponent ( Component* component, const Occurrence& occurrence, const Transformation& transf )
+  {
+    Occurrence childEqui    = occurrence;
+    bool       hasChildEqui = occurrence.getPath().isEmpty();
+    if (_sweepLine->isAreaMode()) {
+      if (not hasChildEqui) {
+        childEqui    = Equipotential::getChildEqui( occurrence );
+        hasChildEqui = true;
+      }
+      Equipotential* equi = (childEqui.getPath().isEmpty()) ? Equipotential::get( component )
+                                                            : Equipotential::get( childEqui );
+      if (not _sweepLine->isSelected(equi)) return;
+    }
+
+    uint32_t group     = _tiles.size();
+    Box      ab        = transf.getBox( component->getBoundingBox() );
+    uint32_t flags     = NoFlags;
+    if (   (not isLeftMost () and (ab.getXMin() <= _area.getXMin()))
+        or (not isRightMost() and (ab.getXMax() >= _area.getXMax())) )
+      flags |= Exported;
+
+    for ( const BasicLayer* layer : _sweepLine->getExtracteds() ) {
+      if (not component->getLayer()->getMask().intersect(layer->getMask())) continue;
+      _addTiles( occurrence, transf, layer, flags );
+    }
+
+    BasicLayer* cutLayer = component->getLayer()->getBasicLayers().getFirst();
+    if (cutLayer->getMaterial() == BasicLayer::Material::cut) {
+      for ( const BasicLayer* connexLayer : _sweepLine->getCutConnexLayers(cutLayer) )
+        _addTiles( occurrence, transf, connexLayer, flags|ForceLayer );
+    }
+    if (group == _tiles.size()) return;
+
+  // All the tiles of a component are connected, and the first one is
+  // their representative.
+    for ( uint32_t i=group ; i<_tiles.size() ; ++i ) {
+      _parents.push_back( group );
+      _links  .push_back( i );
+      if (not _tiles[i].isOwned()) continue;
+      if (not hasChildEqui) {
+        childEqui    = Equipotential::getChildEqui( occurrence );
+        hasChildEqui = true;
+      }
+      _tiles[i]._occurrence = childEqui;
+      ++_ownedCount;
+    }
+  }
+
+
+  bool  SweepWindow::_addTiles ( const Occurrence&     occurrence
+                               , const Transformation& transf
+                               , const BasicLayer*     layer
+                               ,       uint32_t        flags )
+  {
+    Component* component = static_cast<Component*>( occurrence.getEntity() );
+    if (not (flags & ForceLayer) and not component->getLayer()->contains(layer)) {
+      cerr << Error( "SweepWindow::_addTiles(): Component layer \"%s\" does not contains \"%s\".\n"
+                     "        (%s)"
+                   , getString(component->getLayer()->getName()).c_str()
+                   , getString(layer->getName()).c_str()
+                   , getString(occurrence).c_str()
+                   ) << endl;
+      return false;
+    }
+    if (dynamic_cast<Polygon*>(component)) {
+      cerr << Error( "SweepWindow::_addTiles(): Polygon are not supported for extraction.\n"
+                     "        (%s)"
+                   , getString(occurrence).c_str()
+                   ) << endl;
+      return false;
+    }
+    if (dynamic_cast<Diagonal*>(component)) {
+      cerr << Error( "SweepWindow::_addTiles(): Diagonal are not supported for extraction.\n"
+                     "        (%s)"
+                   , getString(occurrence).c_str()
+                   ) << endl;
+      return false;
+    }
+
+    vector<Box>  boxes;
+    Rectilinear* rectilinear = dynamic_cast<Rectilinear*>( component );
+    if (rectilinear) {
+      if (not rectilinear->isRectilinear()) {
+        cerr << Error( "SweepWindow::_addTiles(): Rectilinear with 45/135 edges are not supported for extraction.\n"
+                       "        (%s)"
+                     , getString(occurrence).c_str()
+                     ) << endl;
+        return false;
+      }
+      rectilinear->getAsRectangles( boxes );
+    } else {
+      if (flags & ForceLayer) boxes.push_back( component->getBoundingBox() );
+      else                    boxes.push_back( component->getBoundingBox(layer) );
+    }
+
+    for ( Box bb : boxes ) {
+      transf.applyOn( bb );
+      if (bb.isEmpty()) {
+        throw Error( "SweepWindow::_addTiles(): Empty tile box when processing Component.\n"
+                     "        On: %s"
+                   , getString(occurrence).c_str() );
+      }
+      _tiles.push_back( WindowTile( occurrence, layer, bb, (flags & Exported) | (isOwned(bb) ? Owned : NoFlags) ) );
+    }
+    return true;
+  }
+
+
+  void  SweepWindow::sweep ()
+  {
+    typedef  IntervalTree<uint32_t>  TileIntvTree;
+
+    struct Edge {
+      uint32_t  _tile;
+      bool      _isLeft;
+    };
+
+    const vector<WindowTile>& tiles = _tiles;
+    auto  getX     = [&]( const Edge& edge ) -> DbU::Unit
+                       { const Box& bb = tiles[edge._tile]._boundingBox;
+                         return (edge._isLeft) ? bb.getXMin() : bb.getXMax(); };
+    auto  lessEdge = [&]( const Edge& lhs, const Edge& rhs ) -> bool
+                       { DbU::Unit lx = getX( lhs );
+                         DbU::Unit rx = getX( rhs );
+                         if (lx != rx) return lx < rx;
+                         if (lhs._isLeft xor rhs._isLeft) return lhs._isLeft;
+                         const WindowTile& lt = tiles[lhs._tile];
+                         const WindowTile& rt = tiles[rhs._tile];
+                         if (lt._boundingBox.getYMin() != rt._boundingBox.getYMin())
+                           return lt._boundingBox.getYMin() < rt._boundingBox.getYMin();
+                         if (lt._layer->getMask() != rt._layer->getMask())
+                           return lt._layer->getMask() < rt._layer->getMask();
+                         return lhs._tile < rhs._tile; };
+
+    vector<Edge> edges;
+    edges.reserve( 2*_tiles.size() );
+    for ( uint32_t i=0 ; i<_tiles.size() ; ++i ) {
+      edges.push_back( Edge { i, true  } );
+      edges.push_back( Edge { i, false } );
+    }
+    std::sort( edges.begin(), edges.end(), lessEdge );
+
+    std::map<Layer::Mask,TileIntvTree> intervalTrees;
+    for ( const BasicLayer* layer : _sweepLine->getExtracteds() )
+      intervalTrees.insert( std::make_pair( layer->getMask(), TileIntvTree() ));
+
+    for ( const Edge& edge : edges ) {
+      const WindowTile&      tile     = _tiles[ edge._tile ];
+      IntervalData<uint32_t> tileIntv ( edge._tile, tile._boundingBox.getYMin(), tile._boundingBox.getYMax() );
+
+      auto intvTree = intervalTrees.find( tile._layer->getMask() );
+      if (intvTree == intervalTrees.end()) {
+        cerr << Error( "SweepWindow::sweep(): Missing interval tree for layer(mask) %s."
+                       "        (for tile: %s)"
+                     , getString(tile._layer->getMask()).c_str()
+                     , getString(tile._deepOccurrence).c_str()
+                     ) << endl;
+        continue;
+      }
+      if (edge._isLeft) {
+        for ( const IntervalData<uint32_t>& overlap : intvTree->second.getOverlaps(
+                                                        Interval(tile._boundingBox.getYMin()
+                                                                ,tile._boundingBox.getYMax()) )) {
+          if (_links[edge._tile] == edge._tile)
+            _links[edge._tile] = overlap.getData();
+          _unite( edge._tile, overlap.getData() );
+        }
+        intvTree->second.insert( tileIntv );
+      } else
+        intvTree->second.remove( tileIntv );
+    }
+
+    for ( uint32_t i=0 ; i<_tiles.size() ; ++i ) _parents[i] = _find( i );
+
+    for ( uint32_t i=0 ; i<_tiles.size() ; ++i ) {
+      if (_tiles[i].isOwned() and _tiles[i].isExported())
+        _exports.insert( std::make_pair( TileKey(_tiles[i]), i ));
+    }
+  }
+
+
+  uint32_t  SweepWindow::setGlobalOffset ( uint32_t offset )
+  {
+    _globals.resize( _tiles.size(), 0 );
+    for ( uint32_t i=0 ; i<_tiles.size() ; ++i ) {
+      if (_tiles[i].isOwned()) _globals[i] = offset++;
+    }
+    return offset;
+  }
+
+
+// Must only be called once the global offsets of *all* the windows are
+// set. Do not modify any window, so all of them can be linked at once.
+  void  SweepWindow::link ( const vector<SweepWindow*>& windows, UnionFind& unionFind ) const
+  {
+    vector<uint32_t> globals ( _globals );
+    vector<uint8_t>  resolveds ( _tiles.size(), 1 );
+
+    for ( uint32_t i=0 ; i<_tiles.size() ; ++i ) {
+      if (_tiles[i].isOwned()) continue;
+
+      const SweepWindow* owner  = windows[ _sweepLine->getWindowIndex(_tiles[i]._boundingBox.getXMin()) ];
+      auto               iowned = owner->_exports.find( TileKey(_tiles[i]) );
+      if (iowned == owner->_exports.end()) {
+        cerr << Bug( "SweepWindow::link(): Ghost tile not exported by window %u.\n"
+                     "        (%s)"
+                   , owner->getIndex()
+                   , getString(_tiles[i]._deepOccurrence).c_str()
+                   ) << endl;
+        resolveds[i] = 0;
+        continue;
+      }
+      globals[i] = owner->_globals[ iowned->second ];
+    }
+
+    for ( uint32_t i=0 ; i<_tiles.size() ; ++i ) {
+      uint32_t root = _parents[i];
+      if ((root == i) or not resolveds[i] or not resolveds[root]) continue;
+      unionFind.unite( globals[i], globals[root] );
+    }
+  }
+
+
+  void  SweepWindow::clear ()
+  {
+    vector<WindowTile>().swap( _tiles );
+    vector<uint32_t>  ().swap( _parents );
+    vector<uint32_t>  ().swap( _links );
+    vector<uint32_t>  ().swap( _globals );
+    ExportMap         ().swap( _exports );
+  }
+
+
+  string  SweepWindow::_getTypeName () const
+  { return "Tramontana::SweepWindow"; }
+
+
+  string  SweepWindow::_getString () const
+  {
+    ostringstream  os;
+    os << "<SweepWindow " << _index << " " << _area
+       << " tiles:" << _tiles.size() << " owned:" << _ownedCount << ">";
+    return os.str();
+  }
+
+
+  Record* SweepWindow::_getRecord () const
+  {
+    Record* record = new Record ( _getString() );
+    if (record) {
+      record->add( getSlot( "_index"     , _index      ) );
+      record->add( getSlot( "_area"      , &_area      ) );
+      record->add( getSlot( "_ownedCount", _ownedCount ) );
+    }
+    return record;
+  }
+
+
+} // Tramontana namespace.
@@ -17,6 +17,9 @@
 
 
 #include <Python.h>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
 #include <sstream>
 #include <fstream>
 #include <iomanip>
@@ -41,11 +44,14 @@
 #include "hurricane/Vertical.h"
 #include "hurricane/Horizontal.h"
 #include "hurricane/RoutingPad.h"
+#include "hurricane/ThreadPool.h"
+#include "hurricane/ParallelQuery.h"
 #include "hurricane/isobar/Script.h"
 #include "crlcore/Measures.h"
 #include "crlcore/Utilities.h"
 #include "crlcore/AllianceFramework.h"
 #include "tramontana/ShortCircuit.h"
+#include "tramontana/DirtyTracker.h"
 #include "tramontana/SweepLine.h"
 #include "tramontana/TramontanaEngine.h"
 
@@ -88,6 +94,8 @@ namespace Tramontana {
   using Hurricane::RoutingPad;
   using Hurricane::Cell;
   using Hurricane::Instance;
+  using Hurricane::ThreadPool;
+  using Hurricane::ParallelQuery;
   using CRL::Catalog;
   using CRL::AllianceFramework;
   using CRL::addMeasure;
@@ -123,6 +131,7 @@ namespace Tramontana {
     , _shortedNets   ()
     , _powerNets     ()
     , _groundNets    ()
+    , _dirtyTracker  (nullptr)
   {
     for ( const BasicLayer* bl : DataBase::getDB()->getTechnology()->getBasicLayers() ) {
     // HARDCODED. Should read the gauge.
@@ -181,7 +190,9 @@ namespace Tramontana {
 
 
   TramontanaEngine::~TramontanaEngine ()
-  { }
+  {
+    if (_dirtyTracker) delete _dirtyTracker;
+  }
 
 
   const Name& TramontanaEngine::getName () const
@@ -268,17 +279,25 @@ namespace Tramontana {
     }
 
     cdebug_log(160,0) << "EXTRACTING " << getCell() << endl;
-    for ( Instance* instance : getCell()->getInstances() ) {
-      Cell*             master    = instance->getMasterCell();
-      TramontanaEngine* extractor = TramontanaEngine::get( master );
-      if (not extractor) {
-        extractor = TramontanaEngine::create( master, getDepth()+1 );
-        extractor->extract( false );
-        extractor->printSummary();
+    if ((getDepth() == 0) and (getThreads() > 1)) {
+      _extractMasters();
+    } else {
+      for ( Instance* instance : getCell()->getInstances() ) {
+        Cell*             master    = instance->getMasterCell();
+        TramontanaEngine* extractor = TramontanaEngine::get( master );
+        if (not extractor) {
+          extractor = TramontanaEngine::create( master, getDepth()+1 );
+          extractor->extract( false );
+          extractor->printSummary();
+        }
       }
     }
     _extract();
 
+    if (getDepth() == 0) {
+      if (not _dirtyTracker) _dirtyTracker = new DirtyTracker ( this );
+      _dirtyTracker->capture();
+    }
     if ((getDepth() == 0) and isTopLevel) {
       printSummary();
       stopMeasures();
@@ -287,6 +306,188 @@ namespace Tramontana {
   }
 
 
+// Bottom-up extraction of all the not yet extracted masters below the
+// top Cell, independent masters being processed concurrently.
+//
+// The master DAG is built in the order of the serial recursion (depth
+// first, children before their parents), which is also the order of the
+// masters list. It is then processed by waves: a wave holds all the
+// masters whose children are done. The windows of all the masters of a
+// wave are loaded, swept and linked in one ThreadPool, the database
+// being read-only meanwhile. The Equipotentials, which are database
+// objects, are then built serially, wave after wave and, inside a wave,
+// in list order. This is *not* the order of the serial recursion (a
+// leaf of a later branch is built before the parent of an earlier one),
+// but it only depends on the hierarchy, not on the number of threads.
+// The summaries are printed in list order once all the waves are done.
+  void  TramontanaEngine::_extractMasters ()
+  {
+    struct MasterNode {
+      TramontanaEngine*  _extractor;
+      vector<size_t>     _parents;
+      size_t             _pendings;
+    };
+
+    vector<MasterNode>                        masters;
+    std::unordered_map<const Cell*,size_t>    indexes;
+    std::function<size_t(TramontanaEngine*)>  collect = [&]( TramontanaEngine* parent ) -> size_t
+      {
+        vector<size_t> children;
+        for ( Instance* instance : parent->getCell()->getInstances() ) {
+          Cell* master  = instance->getMasterCell();
+          auto  imaster = indexes.find( master );
+          if (imaster == indexes.end()) {
+            if (TramontanaEngine::get(master)) continue;
+            collect( TramontanaEngine::create( master, parent->getDepth()+1 ));
+            imaster = indexes.find( master );
+          }
+          children.push_back( imaster->second );
+        }
+        std::sort( children.begin(), children.end() );
+        children.erase( std::unique( children.begin(), children.end() ), children.end() );
+
+        size_t index = masters.size();
+        masters.push_back( MasterNode { parent, vector<size_t>(), children.size() } );
+        indexes.insert( make_pair( parent->getCell(), index ));
+        for ( size_t child : children ) masters[ child ]._parents.push_back( index );
+        return index;
+      };
+
+    size_t top = collect( this );
+
+    vector<size_t> wave;
+    for ( size_t i=0 ; i<top ; ++i ) {
+      if (not masters[i]._pendings) wave.push_back( i );
+    }
+
+    ThreadPool pool  ( getThreads() );
+    size_t     waves = 0;
+    while ( not wave.empty() ) {
+      ++waves;
+
+      vector<SweepLine*>                   sweeps;
+      vector< std::pair<size_t,size_t> >   tasks;
+      for ( size_t imaster : wave ) {
+        SweepLine* sweep = new SweepLine ( masters[imaster]._extractor );
+        sweep->openWindows();
+        ParallelQuery::freeze( sweep->getCell() );
+        for ( size_t iwindow=0 ; iwindow<sweep->getWindowsCount() ; ++iwindow )
+          tasks.push_back( make_pair( sweeps.size(), iwindow ));
+        sweeps.push_back( sweep );
+      }
+
+      bool inSession = false;
+      try {
+        {
+          ParallelQuery::ReadOnlyScope readOnly;
+          pool.run( tasks.size(), [&]( size_t itask, size_t ) {
+                                    sweeps[ tasks[itask].first ]->sweepWindow( tasks[itask].second );
+                                  } );
+        }
+        for ( SweepLine* sweep : sweeps ) sweep->stitchWindows();
+        pool.run( tasks.size(), [&]( size_t itask, size_t ) {
+                                  sweeps[ tasks[itask].first ]->linkWindow( tasks[itask].second );
+                                } );
+
+        UpdateSession::open();
+        inSession = true;
+        for ( SweepLine* sweep : sweeps ) sweep->buildEquipotentials();
+        inSession = false;
+        UpdateSession::close();
+      } catch ( ... ) {
+        if (inSession) UpdateSession::close();
+        for ( SweepLine* sweep : sweeps ) delete sweep;
+        throw;
+      }
+      for ( SweepLine* sweep : sweeps ) delete sweep;
+
+      vector<size_t> nextWave;
+      for ( size_t imaster : wave ) {
+        masters[imaster]._extractor->consolidate();
+        for ( size_t iparent : masters[imaster]._parents ) {
+          if ((--masters[iparent]._pendings == 0) and (iparent != top))
+            nextWave.push_back( iparent );
+        }
+      }
+      std::sort( nextWave.begin(), nextWave.end() );
+      wave.swap( nextWave );
+    }
+
+    for ( size_t i=0 ; i<top ; ++i ) masters[i]._extractor->printSummary();
+    if (top) {
+      cmess2 << Dots::asUInt( "     - Extracted masters", top   ) << endl;
+      cmess2 << Dots::asUInt( "     - Extraction waves" , waves ) << endl;
+    }
+  }
+
+
+// Update the extraction after local edits of the top level layout
+// (ECO, routing repair). Only the Equipotentials touching the edited
+// areas are destroyed and rebuilt, by a sweep restricted to the area
+// they span. Changes in the instances fall back to a full extraction.
+  void  TramontanaEngine::reextract ()
+  {
+    if ((getDepth() != 0) or not _dirtyTracker) {
+      cerr << Error( "TramontanaEngine::reextract(): %s has not been extracted yet."
+                   , getString(getCell()).c_str() ) << endl;
+      return;
+    }
+
+    Box              area;
+    EquipotentialSet replaceds;
+    if (not _dirtyTracker->collect(area,replaceds)) {
+      cmess1 << "  o  Instances of " << getCell() << " have changed, full re-extraction." << endl;
+      _clearExtraction();
+      extract();
+      return;
+    }
+    if (_dirtyTracker->getAreas().empty()) {
+      cmess2 << "  o  No change in " << getCell() << " since the last extraction." << endl;
+      return;
+    }
+
+    cmess1 << "  o  Re-extracting " << getCell() << endl;
+    startMeasures();
+    cmess2 << Dots::asUInt  ( "     - Dirty areas"             , _dirtyTracker->getAreas().size() ) << endl;
+    cmess2 << Dots::asUInt  ( "     - Replaced equipotentials" , replaceds.size() ) << endl;
+    cmess2 << Dots::asString( "     - Re-extracted area"       , getString(area) ) << endl;
+
+    uint32_t lastId = (_equipotentials.empty()) ? 0 : (*_equipotentials.rbegin())->getId();
+    SweepLine sweepLine ( this );
+    sweepLine.runArea( area, replaceds );
+    for ( auto iequi = _equipotentials.rbegin() ; iequi != _equipotentials.rend() ; ++iequi ) {
+      if ((*iequi)->getId() <= lastId) break;
+      (*iequi)->consolidate();
+    }
+    _classify();
+    _dirtyTracker->capture();
+
+    printSummary();
+    stopMeasures();
+    printMeasures();
+  }
+
+
+  void  TramontanaEngine::addDirtyArea ( const Box& area )
+  {
+    if (_dirtyTracker) _dirtyTracker->addArea( area );
+  }
+
+
+  void  TramontanaEngine::_clearExtraction ()
+  {
+    UpdateSession::open();
+    ShortCircuit::removeShortingEquis( getCell() );
+    EquipotentialSet equis = _equipotentials;
+    for ( Equipotential* equi : equis ) equi->destroy();
+    _openNets   .clear();
+    _shortedNets.clear();
+    _powerNets  .clear();
+    _groundNets .clear();
+    UpdateSession::close();
+  }
+
+
   void  TramontanaEngine::_extract ()
   {
     SweepLine sweepLine ( this );
@@ -381,6 +582,16 @@ namespace Tramontana {
   //cerr << "Tramontana::consolidate()" << endl;
     for ( Equipotential* equi : _equipotentials )
       equi->consolidate();
+    _classify();
+  }
+
+
+  void  TramontanaEngine::_classify ()
+  {
+    _openNets   .clear();
+    _shortedNets.clear();
+    _powerNets  .clear();
+    _groundNets .clear();
 
     for ( Net* net : getCell()->getNets() ) {
       if (net->isSupply() or net->isFused() or net->isBlockage()) continue;
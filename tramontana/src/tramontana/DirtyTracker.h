@@ -0,0 +1,122 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |       T r a m o n t a n a  -  Extractor & LVX                   |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./tramontana/DirtyTracker.h"                   |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include <vector>
+#include <unordered_map>
+#include "hurricane/Box.h"
+#include "hurricane/Transformation.h"
+namespace Hurricane {
+  class Layer;
+  class Net;
+  class Cell;
+  class Component;
+}
+#include "tramontana/Equipotential.h"
+
+
+namespace Tramontana {
+
+  using Hurricane::Box;
+  using Hurricane::Transformation;
+  using Hurricane::Layer;
+  using Hurricane::Net;
+  using Hurricane::Cell;
+  using Hurricane::Component;
+  class TramontanaEngine;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Tramontana::DirtyTracker".
+//
+// State of the top level layout of a Cell at it's last extraction.
+// The edits made since (added, modified or removed components) are
+// found back by comparison with the current layout. Destroyed Gos are
+// not signaled to the UpdateSession, and the invalidated ones only
+// give their new position, so observing the invalidations is not
+// enough to find the areas to re-extract.
+//
+// The instances are only checked: any change in them requires a full
+// re-extraction.
+
+  class DirtyTracker {
+    public:
+      class ComponentState {
+        public:
+          inline  ComponentState ( const Box&, const Layer*, const Net*, Equipotential* );
+        public:
+          Box             _boundingBox;
+          const Layer*    _layer;
+          const Net*      _net;
+          Equipotential*  _equipotential;
+          bool            _found;
+      };
+      class InstanceState {
+        public:
+          inline  InstanceState ( const Cell*, const Transformation& );
+        public:
+          const Cell*     _masterCell;
+          Transformation  _transformation;
+      };
+      typedef  std::unordered_map<unsigned int,ComponentState>  ComponentStates;
+      typedef  std::unordered_map<unsigned int,InstanceState>   InstanceStates;
+    public:
+                                      DirtyTracker ( TramontanaEngine* );
+      inline  const std::vector<Box>& getAreas     () const;
+      inline  void                    addArea      ( const Box& );
+              bool                    isTracked    ( const Component* ) const;
+              void                    capture      ();
+              bool                    collect      ( Box& area, EquipotentialSet& replaceds );
+              std::string             _getTypeName () const;
+              std::string             _getString   () const;
+              Record*                 _getRecord   () const;
+    private:
+                                      DirtyTracker ( const DirtyTracker& ) = delete;
+              DirtyTracker&           operator=    ( const DirtyTracker& ) = delete;
+    private:
+      TramontanaEngine*  _tramontana;
+      ComponentStates    _components;
+      InstanceStates     _instances;
+      std::vector<Box>   _areas;
+  };
+
+
+  inline DirtyTracker::ComponentState::ComponentState ( const Box&     bb
+                                                      , const Layer*   layer
+                                                      , const Net*     net
+                                                      , Equipotential* equi )
+    : _boundingBox  (bb)
+    , _layer        (layer)
+    , _net          (net)
+    , _equipotential(equi)
+    , _found        (false)
+  { }
+
+
+  inline DirtyTracker::InstanceState::InstanceState ( const Cell* masterCell, const Transformation& transf )
+    : _masterCell    (masterCell)
+    , _transformation(transf)
+  { }
+
+
+  inline const std::vector<Box>& DirtyTracker::getAreas () const { return _areas; }
+  inline void                    DirtyTracker::addArea  ( const Box& area ) { if (not area.isEmpty()) _areas.push_back( area ); }
+
+
+}  // Tramontana namespace.
+
+
+INSPECTOR_P_SUPPORT(Tramontana::DirtyTracker);
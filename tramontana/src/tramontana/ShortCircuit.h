@@ -50,7 +50,7 @@ namespace Tramontana {
       static inline const void           removeShortingEquis ( const Cell* );
     public:
                             ShortCircuit    ( Occurrence, Occurrence );
-      inline               ~ShortCircuit    ();
+                           ~ShortCircuit    ();
       inline bool           isTopLevelA     () const;
       inline bool           isTopLevelB     () const;
       inline bool           isTopLevel      () const;
@@ -72,14 +72,14 @@ namespace Tramontana {
     private:
       static ShortsByCells  _shortsByCells;
     private:
-      Occurrence _occurrenceA;
-      Occurrence _occurrenceB;
-      DRCError*  _overlap;
+      Occurrence      _occurrenceA;
+      Occurrence      _occurrenceB;
+      DRCError*       _overlap;
+      const Cell*     _cell;
+      Equipotential*  _shortingA;
+      Equipotential*  _shortingB;
   };
 
-  inline ShortCircuit::~ShortCircuit ()
-  { _overlap->destroy(); }
-
   inline const ShortCircuit::ShortingEquis& ShortCircuit::getShortingEquis ( const Cell* cell )
   {
     static ShortingEquis nullShorts;
@@ -26,11 +26,14 @@ namespace Hurricane {
   class Net;
 }
 #include "tramontana/Tile.h"
+#include "tramontana/Equipotential.h"
 #include "tramontana/TramontanaEngine.h"
 
 
 namespace Tramontana {
 
+  class SweepWindow;
+  class UnionFind;
   using Hurricane::Record;
   using Hurricane::Box;
   using Hurricane::DbU;
@@ -76,7 +79,17 @@ namespace Tramontana {
       inline  Layer::Mask       getExtractedMask    () const;
       inline  const TramontanaEngine::LayerSet&
                                 getCutConnexLayers  ( const BasicLayer* ) const;
+      inline  uint32_t          getWindowIndex      ( DbU::Unit x ) const;
+      inline  bool              isAreaMode          () const;
+      inline  bool              isSelected          ( Equipotential* ) const;
               void              run                 ( bool isTopLevel );
+              void              runArea             ( const Box&, const EquipotentialSet& replaceds );
+              void              openWindows         ();
+      inline  size_t            getWindowsCount     () const;
+              void              sweepWindow         ( size_t );
+              void              stitchWindows       ();
+              void              linkWindow          ( size_t );
+              void              buildEquipotentials ();
               bool              loadNextWindow      ();
       inline  void              add                 ( Tile* );
               void              mergeEquipotentials ( uint32_t flags=0 );
@@ -84,6 +97,9 @@ namespace Tramontana {
               Record*           _getRecord          () const;
               std::string       _getString          () const;
               std::string       _getTypeName        () const;
+    private:
+              void              _runParallel        ( bool isTopLevel );
+              void              _clearWindows       ();
     private:                                        
                                 SweepLine           ( const SweepLine& ) = delete;
               SweepLine&        operator=           ( const SweepLine& ) = delete;
@@ -95,6 +111,14 @@ namespace Tramontana {
       Tile*                           _lastLeftEdge;
       uint32_t                        _splitCount;
       uint32_t                        _flags;
+      Box                             _windowsBox;
+      DbU::Unit                       _windowWidth;
+      uint32_t                        _threads;
+      size_t                          _tilesCount;
+      std::vector<SweepWindow*>       _windows;
+      UnionFind*                      _unionFind;
+      Box                             _area;
+      const EquipotentialSet*         _replaceds;
   };
 
 
@@ -124,13 +148,30 @@ namespace Tramontana {
 // SweepLine.  
   inline        bool                            SweepLine::isLeftMostWindow    () const { return _flags & IsLeftMostWindow; }
   inline        bool                            SweepLine::isRightMostWindow   () const { return _flags & IsRightMostWindow; }
+  inline        bool                            SweepLine::isAreaMode          () const { return (_replaceds != nullptr); }
   inline        Cell*                           SweepLine::getCell             () { return _tramontana->getCell(); }
+  inline        size_t                          SweepLine::getWindowsCount     () const { return _windows.size(); }
   inline        Layer::Mask                     SweepLine::getExtractedMask    () const { return _tramontana->getExtractedMask(); }
   inline  const std::vector<const BasicLayer*>& SweepLine::getExtracteds       () const { return _tramontana->getExtracteds(); }
 
   inline  const TramontanaEngine::LayerSet& SweepLine::getCutConnexLayers ( const BasicLayer* cutLayer ) const
   { return _tramontana->getCutConnexLayers( cutLayer ); }
 
+  inline  uint32_t  SweepLine::getWindowIndex ( DbU::Unit x ) const
+  {
+    if (x <= _windowsBox.getXMin()) return 0;
+    DbU::Unit index = (x - _windowsBox.getXMin()) / _windowWidth;
+    return (index > (DbU::Unit)_splitCount) ? _splitCount : (uint32_t)index;
+  }
+
+// In area mode, only the components of the replaced Equipotentials and
+// the ones not belonging to any Equipotential yet are extracted.
+  inline  bool  SweepLine::isSelected ( Equipotential* equi ) const
+  {
+    if (not _replaceds or not equi) return true;
+    return (_replaceds->find(equi) != _replaceds->end());
+  }
+
   inline  void  SweepLine::add ( Tile* tile )
   {
     tile->incRefCount( 2 );
@@ -0,0 +1,211 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |       T r a m o n t a n a  -  Extractor & LVX                   |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./tramontana/SweepWindow.h"                    |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include <cstdint>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include "hurricane/Box.h"
+#include "hurricane/BasicLayer.h"
+#include "hurricane/Occurrence.h"
+#include "hurricane/IntervalTree.h"
+namespace Hurricane {
+  class Component;
+  class SharedPath;
+  class Entity;
+}
+
+
+namespace Tramontana {
+
+  using Hurricane::Record;
+  using Hurricane::Box;
+  using Hurricane::DbU;
+  using Hurricane::Layer;
+  using Hurricane::BasicLayer;
+  using Hurricane::Component;
+  using Hurricane::Occurrence;
+  using Hurricane::Transformation;
+  class SweepLine;
+  class UnionFind;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Tramontana::SweepWindow".
+//
+// One vertical slice of the Cell, extracted independently of the
+// others, possibly in a separate thread. A window builds it's own light
+// tiles in a private arena, sweeps them with it's own interval trees
+// and connects the overlapping ones in a local union-find. No object
+// of the database is created or modified.
+//
+// Each tile is *owned* by the window holding the left edge of it's box.
+// The tiles of the components crossing the window boundaries are also
+// loaded as *ghosts*, so all the overlaps involving an owned tile are
+// seen by it's window. The ghosts are then stitched to their owner
+// (link()), through the tiles exported by the owner window, in one
+// global union-find.
+
+  class SweepWindow {
+    public:
+      static const uint32_t  NoFlags    =  0;
+      static const uint32_t  Owned      = (1<<0);
+      static const uint32_t  Exported   = (1<<1);
+      static const uint32_t  ForceLayer = (1<<2);
+    public:
+      class WindowTile {
+        public:
+          inline  WindowTile ( Occurrence deepOccurrence, const BasicLayer*, const Box&, uint32_t flags );
+          inline  bool  isOwned    () const;
+          inline  bool  isExported () const;
+        public:
+          Occurrence         _occurrence;
+          Occurrence         _deepOccurrence;
+          const BasicLayer*  _layer;
+          Box                _boundingBox;
+          uint32_t           _flags;
+      };
+      class TileKey {
+        public:
+          inline       TileKey    ( const WindowTile& );
+          inline bool  operator== ( const TileKey& ) const;
+        public:
+          const Hurricane::Entity*      _entity;
+          const Hurricane::SharedPath*  _sharedPath;
+          const BasicLayer*             _layer;
+          Box                           _boundingBox;
+      };
+      class TileKeyHash {
+        public:
+          size_t  operator() ( const TileKey& ) const;
+      };
+      typedef  std::unordered_map<TileKey,uint32_t,TileKeyHash>  ExportMap;
+    public:
+                                      SweepWindow     ( SweepLine*, uint32_t index, const Box& area, uint32_t flags );
+      inline  uint32_t                getIndex        () const;
+      inline  const Box&              getArea         () const;
+      inline  bool                    isLeftMost      () const;
+      inline  bool                    isRightMost     () const;
+      inline  bool                    isOwned         ( const Box& ) const;
+      inline  size_t                  getTilesCount   () const;
+      inline  size_t                  getOwnedCount   () const;
+      inline  const WindowTile&       getTile         ( uint32_t ) const;
+      inline  uint32_t                getGlobal       ( uint32_t ) const;
+      inline  uint32_t                getRoot         ( uint32_t ) const;
+      inline  uint32_t                getLink         ( uint32_t ) const;
+              void                    addComponent    ( Component*, const Occurrence&, const Transformation& );
+              void                    load            ();
+              void                    sweep           ();
+              uint32_t                setGlobalOffset ( uint32_t offset );
+              void                    link            ( const std::vector<SweepWindow*>&, UnionFind& ) const;
+              void                    clear           ();
+              std::string             _getTypeName    () const;
+              std::string             _getString      () const;
+              Record*                 _getRecord      () const;
+    public:
+      static const uint32_t  IsLeftMost  = (1<<0);
+      static const uint32_t  IsRightMost = (1<<1);
+    private:
+              bool                    _addTiles       ( const Occurrence&, const Transformation&, const BasicLayer*, uint32_t flags );
+      inline  uint32_t                _find           ( uint32_t );
+      inline  void                    _unite          ( uint32_t, uint32_t );
+    private:
+                                      SweepWindow     ( const SweepWindow& ) = delete;
+              SweepWindow&            operator=       ( const SweepWindow& ) = delete;
+    private:
+      SweepLine*               _sweepLine;
+      uint32_t                 _index;
+      Box                      _area;
+      uint32_t                 _flags;
+      size_t                   _ownedCount;
+      std::vector<WindowTile>  _tiles;
+      std::vector<uint32_t>    _parents;
+      std::vector<uint32_t>    _links;
+      std::vector<uint32_t>    _globals;
+      ExportMap                _exports;
+  };
+
+
+  inline SweepWindow::WindowTile::WindowTile ( Occurrence deepOccurrence, const BasicLayer* layer, const Box& bb, uint32_t flags )
+    : _occurrence    ()
+    , _deepOccurrence(deepOccurrence)
+    , _layer         (layer)
+    , _boundingBox   (bb)
+    , _flags         (flags)
+  { }
+
+  inline bool  SweepWindow::WindowTile::isOwned    () const { return _flags & Owned; }
+  inline bool  SweepWindow::WindowTile::isExported () const { return _flags & Exported; }
+
+
+  inline SweepWindow::TileKey::TileKey ( const WindowTile& tile )
+    : _entity     (tile._deepOccurrence.getEntity())
+    , _sharedPath (tile._deepOccurrence._getSharedPath())
+    , _layer      (tile._layer)
+    , _boundingBox(tile._boundingBox)
+  { }
+
+  inline bool  SweepWindow::TileKey::operator== ( const TileKey& other ) const
+  {
+    return (_entity      == other._entity)
+       and (_sharedPath  == other._sharedPath)
+       and (_layer       == other._layer)
+       and (_boundingBox == other._boundingBox);
+  }
+
+
+  inline uint32_t                            SweepWindow::getIndex      () const { return _index; }
+  inline const Box&                          SweepWindow::getArea       () const { return _area; }
+  inline bool                                SweepWindow::isLeftMost    () const { return _flags & IsLeftMost; }
+  inline bool                                SweepWindow::isRightMost   () const { return _flags & IsRightMost; }
+  inline size_t                              SweepWindow::getTilesCount () const { return _tiles.size(); }
+  inline size_t                              SweepWindow::getOwnedCount () const { return _ownedCount; }
+  inline const SweepWindow::WindowTile&      SweepWindow::getTile       ( uint32_t i ) const { return _tiles[i]; }
+  inline uint32_t                            SweepWindow::getGlobal     ( uint32_t i ) const { return _globals[i]; }
+  inline uint32_t                            SweepWindow::getRoot       ( uint32_t i ) const { return _parents[i]; }
+  inline uint32_t                            SweepWindow::getLink       ( uint32_t i ) const { return _links[i]; }
+
+  inline bool  SweepWindow::isOwned ( const Box& bb ) const
+  {
+    if (not isLeftMost () and (bb.getXMin() <  _area.getXMin())) return false;
+    if (not isRightMost() and (bb.getXMin() >= _area.getXMax())) return false;
+    return true;
+  }
+
+  inline uint32_t  SweepWindow::_find ( uint32_t i )
+  {
+    while ( _parents[i] != i ) {
+      _parents[i] = _parents[ _parents[i] ];
+      i = _parents[i];
+    }
+    return i;
+  }
+
+  inline void  SweepWindow::_unite ( uint32_t i, uint32_t j )
+  {
+    i = _find( i );
+    j = _find( j );
+    if (i == j) return;
+    if (i < j) std::swap( i, j );
+    _parents[i] = j;
+  }
+
+
+}  // Tramontana namespace.
+
+
+INSPECTOR_P_SUPPORT(Tramontana::SweepWindow);
@@ -33,6 +33,7 @@ namespace Hurricane {
 
 namespace Tramontana {
 
+  class DirtyTracker;
   using Hurricane::Record;
   using Hurricane::Name;
   using Hurricane::Layer;
@@ -62,6 +63,7 @@ namespace Tramontana {
       inline        bool               inDestroyStage         () const;
       inline        bool               doMergeSupplies        () const;
       inline        uint32_t           getInstancesPerWindows () const;
+      inline        uint32_t           getThreads             () const;
       inline        Configuration*     getConfiguration       () const;
               const Name&              getName                () const;
       inline        uint32_t           getDepth               () const;
@@ -78,6 +80,8 @@ namespace Tramontana {
                     bool               isExtractable          ( const Layer* ) const;
                     bool               isExtractable          ( const Net* ) const;
                     void               extract                ( bool isTopLevel=true );
+                    void               reextract              ();
+                    void               addDirtyArea           ( const Box& );
                     void               _extract               ();
                     void               consolidate            ();
                     void               showEquipotentials     () const;
@@ -90,6 +94,9 @@ namespace Tramontana {
       virtual       std::string        _getTypeName           () const;
     private:                                                  
                     void               _buildCutConnexMap     ();
+                    void               _extractMasters        ();
+                    void               _classify              ();
+                    void               _clearExtraction       ();
     private:                          
     // Attributes.                    
       static  Name                     _toolName;
@@ -106,6 +113,7 @@ namespace Tramontana {
               ShortedSet                      _shortedNets;
               std::vector<Equipotential*>     _powerNets;
               std::vector<Equipotential*>     _groundNets;
+              DirtyTracker*                   _dirtyTracker;
     protected:
     // Constructors & Destructors.
                                 TramontanaEngine ( Cell*, uint32_t depth );
@@ -121,6 +129,7 @@ namespace Tramontana {
   inline bool           TramontanaEngine::inDestroyStage         () const { return (_flags & DestroyStage); }
   inline bool           TramontanaEngine::doMergeSupplies        () const { return _configuration->doMergeSupplies(); }
   inline uint32_t       TramontanaEngine::getInstancesPerWindows () const { return _configuration->getInstancesPerWindows(); }
+  inline uint32_t       TramontanaEngine::getThreads             () const { return _configuration->getThreads(); }
   inline Configuration* TramontanaEngine::getConfiguration       () const { return _configuration; }
   inline void           TramontanaEngine::setViewer              ( CellViewer* viewer ) { _viewer=viewer; }
   inline CellViewer*    TramontanaEngine::getViewer              () { return _viewer; }
@@ -0,0 +1,87 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2024-2024, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |       T r a m o n t a n a  -  Extractor & LVX                   |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./tramontana/UnionFind.h"                      |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include <cstdint>
+#include <vector>
+#include <atomic>
+#include <utility>
+
+
+namespace Tramontana {
+
+
+// -------------------------------------------------------------------
+// Class  :  "Tramontana::UnionFind".
+//
+// Lock-free disjoint sets over the indexes [0:size[, usable from any
+// number of threads at once. A root is always linked under a root of
+// smaller index, so whatever the order of the unite() calls, the root
+// of a set is it's smallest index.
+
+  class UnionFind {
+    public:
+      inline           UnionFind ( size_t size );
+      inline  size_t   size      () const;
+      inline  uint32_t find      ( uint32_t );
+      inline  void     unite     ( uint32_t, uint32_t );
+    private:
+                       UnionFind ( const UnionFind& ) = delete;
+              UnionFind& operator= ( const UnionFind& ) = delete;
+    private:
+      std::vector< std::atomic<uint32_t> >  _parents;
+  };
+
+
+  inline UnionFind::UnionFind ( size_t size )
+    : _parents(size)
+  {
+    for ( size_t i=0 ; i<size ; ++i ) _parents[i].store( i, std::memory_order_relaxed );
+  }
+
+
+  inline size_t  UnionFind::size () const { return _parents.size(); }
+
+
+  inline uint32_t  UnionFind::find ( uint32_t i )
+  {
+    while ( true ) {
+      uint32_t parent = _parents[i].load( std::memory_order_acquire );
+      if (parent == i) return i;
+      uint32_t grand = _parents[parent].load( std::memory_order_acquire );
+      if (grand == parent) return parent;
+    // Path halving, losing the race is harmless.
+      _parents[i].compare_exchange_weak( parent, grand, std::memory_order_acq_rel );
+      i = grand;
+    }
+  }
+
+
+  inline void  UnionFind::unite ( uint32_t i, uint32_t j )
+  {
+    while ( true ) {
+      i = find( i );
+      j = find( j );
+      if (i == j) return;
+      if (i < j) std::swap( i, j );
+      uint32_t expected = i;
+      if (_parents[i].compare_exchange_strong( expected, j, std::memory_order_acq_rel ))
+        return;
+    }
+  }
+
+
+}  // Tramontana namespace.
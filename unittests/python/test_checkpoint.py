@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+
+import sys
+import os
+import tempfile
+from coriolis.Hurricane import Box, DataBase, Technology, Library, \
+                               Cell, Net, Instance, Transformation, \
+                               Horizontal, Vertical, Contact, Pad, \
+                               BasicLayer, ViaLayer, RegularLayer, \
+                               UpdateSession, Checkpoint
+from coriolis.helpers.technology import createBL
+
+
+def flush ():
+    sys.stdout.flush()
+    sys.stderr.flush()
+
+
+def setupTechnology ():
+    db     = DataBase.create()
+    tech   = Technology.create( db, 'checkpoint_techno' )
+    cut1   = createBL( tech, 'cut1'  , BasicLayer.Material.cut )
+    metal1 = createBL( tech, 'metal1', BasicLayer.Material.metal )
+    metal2 = createBL( tech, 'metal2', BasicLayer.Material.metal )
+    RegularLayer.create( tech, 'METAL1', metal1 )
+    RegularLayer.create( tech, 'METAL2', metal2 )
+    ViaLayer    .create( tech, 'VIA12' , metal1, cut1, metal2  )
+    rootLib = Library.create( db, 'RootLibrary' )
+    return Library.create( rootLib, 'work' )
+
+
+def buildHierarchy ( library ):
+    """Build a three levels hierarchy: top -> mid (x2) -> leaf (x2)."""
+    tech   = DataBase.getDB().getTechnology()
+    metal1 = tech.getLayer( 'METAL1' )
+    metal2 = tech.getLayer( 'METAL2' )
+    via12  = tech.getLayer( 'VIA12'  )
+
+    UpdateSession.open()
+    leaf = Cell.create( library, 'leaf' )
+    leaf.setAbutmentBox( Box( 0, 0, 1000, 2000 ) )
+    for name, y in (('i', 500), ('q', 1500)):
+        net = Net.create( leaf, name )
+        net.setExternal( True )
+        Horizontal.create( net, metal1, y, 100, 0, 1000 )
+    Pad.create( leaf.getNet('i'), metal2, Box( 400, 400, 600, 600 ) )
+
+    mid = Cell.create( library, 'mid' )
+    mid.setAbutmentBox( Box( 0, 0, 2000, 2000 ) )
+    nets = {}
+    for name in ('a', 'b', 'c'):
+        nets[name] = Net.create( mid, name )
+    nets['a'].setExternal( True )
+    nets['c'].setExternal( True )
+    for i, (netIn, netOut) in enumerate( (('a','b'), ('b','c')) ):
+        inst = Instance.create( mid, 'leaf_{}'.format(i), leaf
+                              , Transformation( 1000*i, 0, Transformation.Orientation.ID )
+                              , Instance.PlacementStatus.PLACED )
+        inst.getPlug( leaf.getNet('i') ).setNet( nets[netIn ] )
+        inst.getPlug( leaf.getNet('q') ).setNet( nets[netOut] )
+    Contact .create( nets['b'], via12 , 1000, 1000, 100, 100 )
+    Vertical.create( nets['b'], metal2, 1000, 100, 500, 1500 )
+
+    top = Cell.create( library, 'top' )
+    top.setAbutmentBox( Box( 0, 0, 2000, 4000 ) )
+    netIn  = Net.create( top, 'in'  )
+    netMid = Net.create( top, 'mid' )
+    netOut = Net.create( top, 'out' )
+    placements = ( Transformation( 0,    0, Transformation.Orientation.ID )
+                 , Transformation( 0, 4000, Transformation.Orientation.MY ) )
+    for i, (netA, netC) in enumerate( ((netIn,netMid), (netMid,netOut)) ):
+        inst = Instance.create( top, 'mid_{}'.format(i), mid, placements[i]
+                              , Instance.PlacementStatus.FIXED )
+        inst.getPlug( mid.getNet('a') ).setNet( netA )
+        inst.getPlug( mid.getNet('c') ).setNet( netC )
+    Vertical.create( netMid, metal2, 1500, 200, 1000, 3000 )
+    UpdateSession.close()
+    return top
+
+
+def describe ( cell, lines=None, seens=None ):
+    """Flat textual description of a Cell and it's masters, ids excluded."""
+    if lines is None: lines = []
+    if seens is None: seens = set()
+    if cell.getName() in seens: return lines
+    seens.add( cell.getName() )
+    lines.append( 'cell {} ab={}'.format( cell.getName(), cell.getAbutmentBox() ))
+    for inst in sorted( cell.getInstances(), key=lambda i: i.getName() ):
+        lines.append( '  inst {} master={} {} status={}'
+                      .format( inst.getName()
+                             , inst.getMasterCell().getName()
+                             , inst.getTransformation()
+                             , inst.getPlacementStatus() ))
+    for net in sorted( cell.getNets(), key=lambda n: n.getName() ):
+        lines.append( '  net {} external={}'.format( net.getName(), net.isExternal() ))
+        components = []
+        for component in net.getComponents():
+            layer = component.getLayer()
+            components.append( '    {} {} {}'.format( type(component).__name__
+                                                    , layer.getName() if layer else None
+                                                    , component.getBoundingBox() ))
+        lines += sorted( components )
+    for inst in cell.getInstances():
+        describe( inst.getMasterCell(), lines, seens )
+    return lines
+
+
+def testRoundTrip ( library ):
+    print( "" )
+    print( "Test Hurricane::Checkpoint save/load" )
+    print( "========================================" )
+    top    = buildHierarchy( library )
+    before = describe( top )
+    fd, path = tempfile.mkstemp( suffix='.ckp' )
+    os.close( fd )
+    try:
+        Checkpoint.save( path, top )
+       # Cells already in the DataBase are not rebuilt, remove them first.
+        UpdateSession.open()
+        for name in ('top', 'mid', 'leaf'):
+            library.getCell( name ).destroy()
+        UpdateSession.close()
+        loaded = Checkpoint.load( path )
+        after  = describe( loaded )
+        Checkpoint.close()
+    finally:
+        os.unlink( path )
+    flush()
+    if before != after:
+        print( '[ERROR] Loaded hierarchy differs from the saved one.' )
+        for i in range( max(len(before),len(after)) ):
+            saved = before[i] if i < len(before) else ''
+            read  = after [i] if i < len(after ) else ''
+            print( '{} {}'.format( ' ' if saved == read else '!', saved ))
+            if saved != read: print( '  {}'.format( read ))
+        return False
+    print( 'Round trip of {} lines: OK.'.format( len(before) ))
+    return True
+
+
+if __name__ == '__main__':
+    library = setupTechnology()
+    if not testRoundTrip( library ):
+        sys.exit( 1 )
+    sys.exit( 0 )